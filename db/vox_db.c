@@ -38,6 +38,7 @@ typedef struct vox_db_req {
 } vox_db_req_t;
 
 typedef struct {
+    vox_loop_work_t work;    /* 切回 loop 的侵入式工作项，入队不再额外分配 */
     vox_db_conn_t* conn;
     vox_db_exec_cb cb;
     void* user_data;
@@ -46,6 +47,7 @@ typedef struct {
 } vox_db_exec_call_t;
 
 typedef struct {
+    vox_loop_work_t work;
     vox_db_conn_t* conn;
     vox_db_done_cb cb;
     void* user_data;
@@ -54,6 +56,7 @@ typedef struct {
 } vox_db_done_call_t;
 
 typedef struct {
+    vox_loop_work_t work;
     vox_db_conn_t* conn;
     vox_db_row_cb cb;
     void* user_data;
@@ -455,7 +458,7 @@ static void db_row_dispatch(vox_db_conn_t* conn, const vox_db_row_t* row, void*
     call->cb = req->u.query.row_cb;
     call->user_data = req->u.query.user_data;
 
-    if (vox_loop_queue_work(conn->loop, db_loop_invoke_row, call) != 0) {
+    if (vox_loop_queue_work_node(conn->loop, &call->work, db_loop_invoke_row, call) != 0) {
         /* 入队失败：退化为工作线程直接回调 */
         db_free_row_call(call);
         req->u.query.row_cb(conn, row, req->u.query.user_data);
@@ -482,7 +485,7 @@ static void db_exec_task(void* user_data) {
                     call->user_data = req->u.exec.user_data;
                     call->status = -1;
                     call->affected = 0;
-                    if (vox_loop_queue_work(conn->loop, db_loop_invoke_exec, call) != 0) {
+                    if (vox_loop_queue_work_node(conn->loop, &call->work, db_loop_invoke_exec, call) != 0) {
                         vox_mpool_free(conn->mpool, call);
                         req->u.exec.cb(conn, -1, 0, req->u.exec.user_data);
                         vox_db_conn_end(conn);
@@ -529,7 +532,7 @@ static void db_exec_task(void* user_data) {
                 call->user_data = req->u.exec.user_data;
                 call->status = status;
                 call->affected = affected;
-                if (vox_loop_queue_work(conn->loop, db_loop_invoke_exec, call) != 0) {
+                if (vox_loop_queue_work_node(conn->loop, &call->work, db_loop_invoke_exec, call) != 0) {
                     vox_mpool_free(conn->mpool, call);
                     req->u.exec.cb(conn, status, affected, req->u.exec.user_data);
                     vox_db_conn_end(conn);  /* 入队失败时释放 */
@@ -569,7 +572,7 @@ static void db_query_task(void* user_data) {
                     call->user_data = req->u.query.user_data;
                     call->status = -1;
                     call->row_count = 0;
-                    if (vox_loop_queue_work(conn->loop, db_loop_invoke_done, call) != 0) {
+                    if (vox_loop_queue_work_node(conn->loop, &call->work, db_loop_invoke_done, call) != 0) {
                         vox_mpool_free(conn->mpool, call);
                         req->u.query.done_cb(conn, -1, 0, req->u.query.user_data);
                         vox_db_conn_end(conn);
@@ -618,7 +621,7 @@ static void db_query_task(void* user_data) {
                 call->user_data = req->u.query.user_data;
                 call->status = status;
                 call->row_count = rows;
-                if (vox_loop_queue_work(conn->loop, db_loop_invoke_done, call) != 0) {
+                if (vox_loop_queue_work_node(conn->loop, &call->work, db_loop_invoke_done, call) != 0) {
                     vox_mpool_free(conn->mpool, call);
                     req->u.query.done_cb(conn, status, rows, req->u.query.user_data);
                     vox_db_conn_end(conn);  /* 入队失败时释放 */
@@ -837,7 +840,7 @@ static void db_tx_task(void* user_data) {
                 call->user_data = req->user_data;
                 call->status = status;
                 call->affected = 0;
-                if (vox_loop_queue_work(conn->loop, db_loop_invoke_exec, call) != 0) {
+                if (vox_loop_queue_work_node(conn->loop, &call->work, db_loop_invoke_exec, call) != 0) {
                     vox_mpool_free(conn->mpool, call);
                     req->cb(conn, status, 0, req->user_data);
                 }
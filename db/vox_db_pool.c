@@ -135,6 +135,7 @@ static void pool_serve_one_waiter_locked(vox_db_pool_t* pool);
 
 /* 在 worker 线程中创建临时连接时使用的上下文（需在 pool_temp_fail_cb 前定义） */
 typedef struct temp_connect_ctx {
+    vox_loop_work_t work;    /* 侵入式工作项，投递到 loop 不再额外分配 */
     vox_db_pool_t* pool;
     vox_db_pool_acquire_cb cb;
     void* user_data;
@@ -165,6 +166,7 @@ static void pool_temp_fail_cb(vox_loop_t* loop, void* user_data) {
 
 /* 临时连接在 worker 中创建完成，切回 loop 线程后调用 */
 typedef struct temp_done_ctx {
+    vox_loop_work_t work;
     vox_db_pool_t* pool;
     vox_db_conn_t* conn;
     int status;
@@ -242,7 +244,7 @@ static void pool_temp_worker_cb(vox_loop_t* loop, void* user_data) {
     temp_done_ctx_t* done = (temp_done_ctx_t*)vox_mpool_alloc(pool->mpool, sizeof(temp_done_ctx_t));
     if (!done) {
         if (conn) vox_db_disconnect(conn);
-        vox_loop_queue_work(pool->loop, pool_temp_fail_cb, ctx);
+        vox_loop_queue_work_node(pool->loop, &ctx->work, pool_temp_fail_cb, ctx);
         return;
     }
     memset(done, 0, sizeof(*done));
@@ -253,7 +255,7 @@ static void pool_temp_worker_cb(vox_loop_t* loop, void* user_data) {
     done->user_data = ctx->user_data;
     vox_mpool_free(pool->mpool, ctx);
 
-    vox_loop_queue_work(pool->loop, pool_temp_done_cb, done);
+    vox_loop_queue_work_node(pool->loop, &done->work, pool_temp_done_cb, done);
 }
 
 static void pool_serve_one_waiter_locked(vox_db_pool_t* pool) {
@@ -293,7 +295,7 @@ static void pool_serve_one_waiter_locked(vox_db_pool_t* pool) {
         vox_mpool_free(pool->mpool, w);
 
         vox_mutex_unlock(&pool->mu);
-        if (vox_loop_queue_work(pool->loop, pool_temp_worker_cb, ctx) != 0) {
+        if (vox_loop_queue_work_node(pool->loop, &ctx->work, pool_temp_worker_cb, ctx) != 0) {
             vox_mutex_lock(&pool->mu);
             pool->pending_temp--;
             vox_mutex_unlock(&pool->mu);
@@ -0,0 +1,138 @@
+/*
+ * chtable_benchmark.c - 并发哈希表性能基准测试
+ * 对比 vox_chtable（无锁读 + 分段写锁）与 vox_htable + 读写锁
+ * 在 1-32 个线程、读多写少（默认 90% 读）负载下的吞吐
+ *
+ * 用法: chtable_benchmark [每线程操作数] [写入百分比]
+ */
+
+#include "../vox_chtable.h"
+#include "../vox_htable.h"
+#include "../vox_mutex.h"
+#include "../vox_thread.h"
+#include "../vox_time.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KEY_COUNT 4096
+#define KEY_LEN 16
+
+static char g_keys[KEY_COUNT][KEY_LEN];
+static int g_ops = 200000;
+static int g_write_pct = 10;
+
+typedef struct {
+    vox_chtable_t* chtable;
+    vox_htable_t* htable;
+    vox_rwlock_t* rwlock;
+    unsigned seed;
+    long hits;
+} bench_ctx_t;
+
+static unsigned next_rand(unsigned* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 8;
+}
+
+static int chtable_worker(void* user_data) {
+    bench_ctx_t* ctx = (bench_ctx_t*)user_data;
+    for (int i = 0; i < g_ops; i++) {
+        unsigned r = next_rand(&ctx->seed);
+        const char* key = g_keys[r % KEY_COUNT];
+        if ((int)((r >> 12) % 100) < g_write_pct) {
+            vox_chtable_set(ctx->chtable, key, KEY_LEN, (void*)(intptr_t)(i + 1));
+        } else if (vox_chtable_get(ctx->chtable, key, KEY_LEN)) {
+            ctx->hits++;
+        }
+    }
+    return 0;
+}
+
+static int htable_worker(void* user_data) {
+    bench_ctx_t* ctx = (bench_ctx_t*)user_data;
+    for (int i = 0; i < g_ops; i++) {
+        unsigned r = next_rand(&ctx->seed);
+        const char* key = g_keys[r % KEY_COUNT];
+        if ((int)((r >> 12) % 100) < g_write_pct) {
+            vox_rwlock_wrlock(ctx->rwlock);
+            vox_htable_set(ctx->htable, key, KEY_LEN, (void*)(intptr_t)(i + 1));
+            vox_rwlock_unlock(ctx->rwlock);
+        } else {
+            vox_rwlock_rdlock(ctx->rwlock);
+            if (vox_htable_get(ctx->htable, key, KEY_LEN)) ctx->hits++;
+            vox_rwlock_unlock(ctx->rwlock);
+        }
+    }
+    return 0;
+}
+
+/* 运行一轮，返回每秒操作数 */
+static double run_round(vox_mpool_t* mpool, int nthreads, vox_thread_func_t func, bench_ctx_t* proto) {
+    vox_thread_t* threads[32];
+    bench_ctx_t ctx[32];
+    vox_time_t start = vox_time_monotonic();
+    for (int i = 0; i < nthreads; i++) {
+        ctx[i] = *proto;
+        ctx[i].seed = (unsigned)(i * 7919 + 1);
+        ctx[i].hits = 0;
+        threads[i] = vox_thread_create(mpool, func, &ctx[i]);
+        if (!threads[i]) {
+            fprintf(stderr, "创建线程失败\n");
+            exit(1);
+        }
+    }
+    for (int i = 0; i < nthreads; i++) {
+        vox_thread_join(threads[i], NULL);
+    }
+    int64_t elapsed_us = vox_time_diff_us(vox_time_monotonic(), start);
+    return elapsed_us > 0 ? (double)nthreads * g_ops * 1000000.0 / elapsed_us : 0.0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) g_ops = atoi(argv[1]);
+    if (argc > 2) g_write_pct = atoi(argv[2]);
+    if (g_ops <= 0) g_ops = 200000;
+    if (g_write_pct < 0 || g_write_pct > 100) g_write_pct = 10;
+
+    vox_mpool_t* mpool = vox_mpool_create();
+    if (!mpool) return 1;
+    for (int i = 0; i < KEY_COUNT; i++) {
+        snprintf(g_keys[i], KEY_LEN, "key-%011d", i);
+    }
+
+    vox_chtable_t* chtable = vox_chtable_create(mpool);
+    vox_htable_t* htable = vox_htable_create(mpool);
+    vox_rwlock_t rwlock;
+    if (!chtable || !htable || vox_rwlock_create(&rwlock) != 0) {
+        fprintf(stderr, "初始化失败\n");
+        return 1;
+    }
+    for (int i = 0; i < KEY_COUNT; i++) {
+        vox_chtable_set(chtable, g_keys[i], KEY_LEN, (void*)(intptr_t)(i + 1));
+        vox_htable_set(htable, g_keys[i], KEY_LEN, (void*)(intptr_t)(i + 1));
+    }
+
+    bench_ctx_t proto;
+    memset(&proto, 0, sizeof(proto));
+    proto.chtable = chtable;
+    proto.htable = htable;
+    proto.rwlock = &rwlock;
+
+    printf("=== vox_chtable vs vox_htable + rwlock ===\n");
+    printf("键数量: %d, 每线程操作数: %d, 写入比例: %d%%\n\n", KEY_COUNT, g_ops, g_write_pct);
+    printf("%8s %18s %18s %8s\n", "线程数", "chtable (次/秒)", "htable+rwlock", "加速比");
+    static const int thread_counts[] = {1, 2, 4, 8, 16, 32};
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+        int n = thread_counts[i];
+        double c = run_round(mpool, n, chtable_worker, &proto);
+        double h = run_round(mpool, n, htable_worker, &proto);
+        printf("%8d %18.0f %18.0f %7.2fx\n", n, c, h, h > 0 ? c / h : 0.0);
+    }
+
+    vox_rwlock_destroy(&rwlock);
+    vox_htable_destroy(htable);
+    vox_chtable_destroy(chtable);
+    vox_mpool_destroy(mpool);
+    return 0;
+}
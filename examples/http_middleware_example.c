@@ -114,7 +114,7 @@ int main(void) {
         .window_ms = 1000,  /* 1秒 */
         .message = "Rate limit exceeded. Please try again later."
     };
-    vox_http_handler_cb rate_limit_mw = vox_http_middleware_rate_limit_create(mpool, &rate_limit_config);
+    vox_http_handler_cb rate_limit_mw = vox_http_middleware_rate_limit_engine_create(engine, &rate_limit_config);
     if (rate_limit_mw) {
         vox_http_handler_cb hs[] = { rate_limit_mw, hello_handler };
         vox_http_engine_get(engine, "/rate-limited", hs, sizeof(hs) / sizeof(hs[0]));
@@ -49,6 +49,7 @@ int main(int argc, char** argv) {
     memset(&cfg, 0, sizeof(cfg));
     cfg.cert_file = cert_file;
     cfg.key_file = key_file;
+    cfg.alpn_protocols = "h2,http/1.1";
     if (vox_ssl_context_configure(ssl_ctx, &cfg) != 0) {
         fprintf(stderr, "vox_ssl_context_configure failed\n");
         return 1;
@@ -1074,6 +1074,22 @@ int main(void) {
     }
     printf("\n");
     
+    /* 示例52: 正则表达式集合（一次扫描匹配多个模式） */
+    printf("示例52: 正则表达式集合\n");
+    const char* text52 = "GET /search?q=1 union select password from users";
+    const char* patterns52[] = { "union\\s+select", "<script", "password\\s+from", "\\.\\./" };
+    vox_regex_set_t* set52 = vox_regex_set_compile(mpool, patterns52, 4, VOX_REGEX_IGNORE_CASE);
+    if (set52) {
+        size_t ids[4];
+        size_t count = vox_regex_set_match(set52, text52, strlen(text52), ids, 4);
+        printf("文本: %s\n", text52);
+        for (size_t i = 0; i < count && i < 4; i++) {
+            printf("  命中模式 %zu: %s\n", ids[i], patterns52[ids[i]]);
+        }
+        vox_regex_set_destroy(set52);
+    }
+    printf("\n");
+    
     /* 清理 */
     vox_mpool_destroy(mpool);
     
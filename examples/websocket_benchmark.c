@@ -0,0 +1,133 @@
+/*
+ * websocket_benchmark.c - WebSocket 掩码与 UTF-8 验证吞吐基准测试
+ * 对比 vox_ws_mask_payload / vox_ws_validate_utf8 与逐字节实现，
+ * 负载为 ASCII 文本、中文文本（3 字节序列）与混合文本，按帧大小分别统计 MB/s
+ *
+ * 用法: websocket_benchmark [每种帧大小处理的总 MB 数]
+ * 向量化路径由编译目标决定，建议 Release 构建（-march=native）
+ */
+
+#include "../websocket/vox_websocket.h"
+#include "../vox_time.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t g_total_mb = 256;
+static volatile unsigned g_sink;
+
+/* 原逐字节掩码 */
+static void mask_bytewise(uint8_t* payload, size_t len, const uint8_t mask_key[4]) {
+    for (size_t i = 0; i < len; i++) {
+        payload[i] ^= mask_key[i & 3];
+    }
+}
+
+/* 原逐字符 UTF-8 验证（只检查首字节与续字节形式） */
+static bool utf8_bytewise(const uint8_t* data, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        uint8_t b = data[i];
+        size_t n;
+        if ((b & 0x80) == 0) n = 1;
+        else if ((b & 0xE0) == 0xC0) n = 2;
+        else if ((b & 0xF0) == 0xE0) n = 3;
+        else if ((b & 0xF8) == 0xF0) n = 4;
+        else return false;
+        if (i + n > len) return false;
+        for (size_t j = 1; j < n; j++) {
+            if ((data[i + j] & 0xC0) != 0x80) return false;
+        }
+        i += n;
+    }
+    return true;
+}
+
+/* 生成 len 字节的合法 UTF-8 文本：cjk_pct 为中文字符比例（其余为 ASCII） */
+static void fill_text(uint8_t* buf, size_t len, int cjk_pct) {
+    unsigned seed = 12345;
+    size_t i = 0;
+    while (i < len) {
+        seed = seed * 1103515245u + 12345u;
+        if ((int)((seed >> 8) % 100) < cjk_pct && i + 3 <= len) {
+            unsigned cp = 0x4E00 + (seed >> 16) % 0x5000;
+            buf[i++] = (uint8_t)(0xE0 | (cp >> 12));
+            buf[i++] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+            buf[i++] = (uint8_t)(0x80 | (cp & 0x3F));
+        } else {
+            buf[i++] = (uint8_t)('a' + (seed >> 16) % 26);
+        }
+    }
+}
+
+/* 返回 MB/s */
+static double bench_mask(void (*fn)(uint8_t*, size_t, const uint8_t*), uint8_t* buf, size_t len) {
+    static const uint8_t key[4] = {0x12, 0x34, 0x56, 0x78};
+    size_t rounds = g_total_mb * 1024 * 1024 / len;
+    if (rounds == 0) rounds = 1;
+    vox_time_t start = vox_time_monotonic();
+    for (size_t r = 0; r < rounds; r++) {
+        fn(buf + (r & 1), len, key); /* 交替起始对齐：客户端帧负载通常不对齐 */
+    }
+    int64_t us = vox_time_diff_us(vox_time_monotonic(), start);
+    g_sink += buf[0];
+    return us > 0 ? (double)rounds * len / us : 0.0;
+}
+
+static double bench_utf8(bool (*fn)(const uint8_t*, size_t), const uint8_t* buf, size_t len) {
+    size_t rounds = g_total_mb * 1024 * 1024 / len;
+    if (rounds == 0) rounds = 1;
+    unsigned ok = 0;
+    vox_time_t start = vox_time_monotonic();
+    for (size_t r = 0; r < rounds; r++) {
+        ok += fn(buf, len) ? 1u : 0u;
+    }
+    int64_t us = vox_time_diff_us(vox_time_monotonic(), start);
+    if (ok != rounds) {
+        fprintf(stderr, "验证结果不正确\n");
+        exit(1);
+    }
+    g_sink += ok;
+    return us > 0 ? (double)rounds * len / us : 0.0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) g_total_mb = (size_t)atoi(argv[1]);
+    if (g_total_mb == 0) g_total_mb = 256;
+
+    static const size_t sizes[] = {64, 1024, 16 * 1024, 1024 * 1024};
+    size_t max_len = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+    uint8_t* buf = (uint8_t*)malloc(max_len + 1);
+    if (!buf) return 1;
+
+    printf("=== vox_ws_mask_payload vs 逐字节 (MB/s) ===\n");
+    printf("%10s %14s %14s %8s\n", "帧大小", "vox", "逐字节", "加速比");
+    fill_text(buf, max_len + 1, 0);
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        double v = bench_mask(vox_ws_mask_payload, buf, sizes[i]);
+        double b = bench_mask(mask_bytewise, buf, sizes[i]);
+        printf("%10zu %14.0f %14.0f %7.2fx\n", sizes[i], v, b, b > 0 ? v / b : 0.0);
+    }
+
+    static const struct {
+        const char* name;
+        int cjk_pct;
+    } texts[] = {
+        {"ASCII", 0},
+        {"混合 10% 中文", 10},
+        {"中文", 100},
+    };
+    for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+        printf("\n=== vox_ws_validate_utf8 vs 逐字符，%s (MB/s) ===\n", texts[t].name);
+        printf("%10s %14s %14s %8s\n", "帧大小", "vox", "逐字符", "加速比");
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            fill_text(buf, sizes[i], texts[t].cjk_pct);
+            double v = bench_utf8(vox_ws_validate_utf8, buf, sizes[i]);
+            double b = bench_utf8(utf8_bytewise, buf, sizes[i]);
+            printf("%10zu %14.0f %14.0f %7.2fx\n", sizes[i], v, b, b > 0 ? v / b : 0.0);
+        }
+    }
+
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,1124 @@
+/*
+ * vox_http2.c - HTTP/2 服务端连接实现
+ */
+
+#include "vox_http2.h"
+#include "vox_http_hpack.h"
+#include "vox_http_internal.h"
+#include "../vox_htable.h"
+#include "../vox_log.h"
+#include <string.h>
+
+#define VOX_HTTP2_FRAME_HEADER_LEN 9
+#define VOX_HTTP2_DEFAULT_FRAME_SIZE 16384
+#define VOX_HTTP2_MAX_FRAME_SIZE_LIMIT 16777215u
+#define VOX_HTTP2_MAX_WINDOW 0x7fffffff
+#define VOX_HTTP2_DEFAULT_WINDOW 65535
+
+typedef struct vox_http2_stream vox_http2_stream_t;
+
+struct vox_http2_stream {
+    vox_http2_session_t* session;   /* 会话销毁后为 NULL（defer 中的孤儿流） */
+    uint32_t id;
+
+    /* 状态 */
+    bool headers_done;      /* 请求头部块已解码 */
+    bool remote_closed;     /* 已收到 END_STREAM */
+    bool pinned;            /* 调用栈上仍在使用（handler 链执行、发送响应）：期间不释放流 */
+    bool responding;        /* 响应头已发出 */
+    bool local_closed;      /* 已发出 END_STREAM */
+    bool reset;             /* 已收到或发出 RST_STREAM */
+    bool queued;            /* 在 DATA 发送队列中 */
+    bool head_request;
+
+    /* 解码请求头部时的校验状态 */
+    bool has_method;
+    bool has_scheme;
+    bool has_path;
+    bool regular_seen;
+    bool malformed;
+    size_t header_list_size;
+
+    int64_t send_window;
+    int64_t recv_window;
+    uint32_t recv_consumed;  /* 已接收但尚未用 WINDOW_UPDATE 归还的字节 */
+
+    vox_vector_t* headers;   /* 请求头部（vox_http_header_t*） */
+    vox_string_t* url;       /* :path */
+    vox_string_t* cookie;    /* 多个 cookie 头合并为一个 */
+    vox_string_t* body;
+
+    /* 响应体：res.body 从 body_off 开始，或 ctx.sendfile_* */
+    size_t body_off;
+
+    vox_http_context_t ctx;
+    vox_http_route_match_t route_match;
+
+    vox_http2_stream_t* all_prev;
+    vox_http2_stream_t* all_next;
+    vox_http2_stream_t* send_next;
+};
+
+struct vox_http2_session {
+    vox_mpool_t* mpool;
+    vox_http_engine_t* engine;
+    void* conn;
+    vox_http2_send_cb send_cb;
+    void* send_data;
+    vox_http2_config_t config;
+
+    vox_http_hpack_t* decoder;
+    vox_http_hpack_t* encoder;
+
+    vox_string_t* in;     /* 未凑成完整帧的输入 */
+    vox_string_t* out;    /* 待交给 send_cb 的输出 */
+    vox_string_t* sending; /* 正在交给 send_cb 的输出（与 out 交替使用） */
+    vox_string_t* block;  /* HEADERS + CONTINUATION 拼接的头部块 / 编码响应头部的缓冲 */
+
+    vox_htable_t* streams;            /* stream id -> vox_http2_stream_t* */
+    vox_http2_stream_t* all_streams;  /* 所有活动流（销毁时遍历） */
+    vox_http2_stream_t* send_head;    /* 待发送 DATA 的流（轮转） */
+    vox_http2_stream_t* send_tail;
+
+    uint32_t last_stream_id;          /* 已处理的最大客户端流 */
+    uint32_t continuation_stream;     /* 非0：等待该流的 CONTINUATION */
+    bool continuation_end_stream;
+    bool continuation_trailers;
+
+    /* 对端设置 */
+    uint32_t peer_max_frame_size;
+    int64_t peer_initial_window;
+
+    int64_t send_window;              /* 连接级发送窗口 */
+    int64_t recv_window;              /* 连接级接收窗口剩余 */
+    uint32_t recv_consumed;
+
+    int busy;                         /* >0 时输出只累积，由最外层统一 flush */
+    bool flushing;
+    bool preface_done;
+    bool settings_received;
+    bool goaway_sent;
+    bool goaway_received;
+    bool failed;
+};
+
+/* ===== 小工具 ===== */
+
+static uint32_t vox_http2_get_u32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static int vox_http2_write_frame_header(vox_string_t* out, size_t len, uint8_t type, uint8_t flags, uint32_t sid) {
+    uint8_t h[VOX_HTTP2_FRAME_HEADER_LEN];
+    h[0] = (uint8_t)(len >> 16);
+    h[1] = (uint8_t)(len >> 8);
+    h[2] = (uint8_t)len;
+    h[3] = type;
+    h[4] = flags;
+    h[5] = (uint8_t)((sid >> 24) & 0x7f);
+    h[6] = (uint8_t)(sid >> 16);
+    h[7] = (uint8_t)(sid >> 8);
+    h[8] = (uint8_t)sid;
+    return vox_string_append_data(out, h, sizeof(h));
+}
+
+static int vox_http2_write_frame(vox_http2_session_t* s, uint8_t type, uint8_t flags, uint32_t sid,
+                                 const void* payload, size_t len) {
+    if (vox_http2_write_frame_header(s->out, len, type, flags, sid) != 0) return -1;
+    if (len > 0 && vox_string_append_data(s->out, payload, len) != 0) return -1;
+    return 0;
+}
+
+static int vox_http2_write_u32_frame(vox_http2_session_t* s, uint8_t type, uint32_t sid, uint32_t v) {
+    uint8_t p[4] = { (uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v };
+    return vox_http2_write_frame(s, type, 0, sid, p, sizeof(p));
+}
+
+/* 把 out 交给 send_cb；回调期间可能重入会话（如上层写完后调用 on_writable），
+ * 新输出写入换下来的 out，本次回调返回后继续交出 */
+static void vox_http2_flush(vox_http2_session_t* s) {
+    if (s->busy > 0 || s->flushing) return;
+    s->flushing = true;
+    while (vox_string_length(s->out) > 0) {
+        vox_string_t* data = s->out;
+        s->out = s->sending;
+        s->sending = data;
+        if (s->send_cb(s->send_data, vox_string_data(data), vox_string_length(data)) != 0) s->failed = true;
+        vox_string_clear(data);
+        if (s->failed) {
+            vox_string_clear(s->out);
+            break;
+        }
+    }
+    s->flushing = false;
+}
+
+/* 连接错误：发出 GOAWAY，之后不再处理输入 */
+static int vox_http2_connection_error(vox_http2_session_t* s, uint32_t code) {
+    if (!s->goaway_sent) {
+        uint8_t p[8];
+        uint32_t last = s->last_stream_id;
+        p[0] = (uint8_t)((last >> 24) & 0x7f); p[1] = (uint8_t)(last >> 16);
+        p[2] = (uint8_t)(last >> 8); p[3] = (uint8_t)last;
+        p[4] = (uint8_t)(code >> 24); p[5] = (uint8_t)(code >> 16);
+        p[6] = (uint8_t)(code >> 8); p[7] = (uint8_t)code;
+        vox_http2_write_frame(s, VOX_HTTP2_FRAME_GOAWAY, 0, 0, p, sizeof(p));
+        s->goaway_sent = true;
+    }
+    s->failed = true;
+    return -1;
+}
+
+/* ===== 流 ===== */
+
+static vox_http2_stream_t* vox_http2_find_stream(vox_http2_session_t* s, uint32_t sid) {
+    return (vox_http2_stream_t*)vox_htable_get(s->streams, &sid, sizeof(sid));
+}
+
+static vox_http2_stream_t* vox_http2_stream_create(vox_http2_session_t* s, uint32_t sid) {
+    vox_http2_stream_t* st = (vox_http2_stream_t*)vox_mpool_alloc(s->mpool, sizeof(vox_http2_stream_t));
+    if (!st) return NULL;
+    memset(st, 0, sizeof(*st));
+    st->session = s;
+    st->id = sid;
+    st->send_window = s->peer_initial_window;
+    st->recv_window = s->config.initial_window_size;
+    st->headers = vox_vector_create(s->mpool);
+    st->url = vox_string_create(s->mpool);
+    st->body = vox_string_create(s->mpool);
+    if (!st->headers || !st->url || !st->body ||
+        vox_htable_set(s->streams, &st->id, sizeof(st->id), st) != 0) {
+        if (st->headers) vox_vector_destroy(st->headers);
+        if (st->url) vox_string_destroy(st->url);
+        if (st->body) vox_string_destroy(st->body);
+        vox_mpool_free(s->mpool, st);
+        return NULL;
+    }
+    st->all_next = s->all_streams;
+    if (s->all_streams) s->all_streams->all_prev = st;
+    s->all_streams = st;
+    return st;
+}
+
+static void vox_http2_stream_release_sendfile(vox_http2_stream_t* st) {
+    vox_http_context_t* ctx = &st->ctx;
+    if (!ctx->sendfile_file) return;
+    vox_http_sendfile_release(ctx->sendfile_file, ctx->sendfile_release, ctx->sendfile_release_data);
+    ctx->sendfile_file = NULL;
+    ctx->sendfile_release = NULL;
+    ctx->sendfile_release_data = NULL;
+    ctx->sendfile_count = 0;
+}
+
+/* 从会话摘除并释放流占用的资源（res.body 与 HTTP/1.1 一致，随连接 mpool 回收） */
+static void vox_http2_stream_free(vox_mpool_t* mpool, vox_http2_stream_t* st) {
+    size_t cnt = vox_vector_size(st->headers);
+    for (size_t i = 0; i < cnt; i++) {
+        void* kv = vox_vector_get(st->headers, i);
+        if (kv) vox_mpool_free(mpool, kv);
+    }
+    vox_vector_destroy(st->headers);
+    vox_string_destroy(st->url);
+    vox_string_destroy(st->body);
+    if (st->cookie) vox_string_destroy(st->cookie);
+    if (st->ctx.res.headers) {
+        vox_vector_t* rh = (vox_vector_t*)st->ctx.res.headers;
+        cnt = vox_vector_size(rh);
+        for (size_t i = 0; i < cnt; i++) {
+            void* kv = vox_vector_get(rh, i);
+            if (kv) vox_mpool_free(mpool, kv);
+        }
+        vox_vector_destroy(rh);
+    }
+    vox_http2_stream_release_sendfile(st);
+    vox_http_engine_release_chain(&st->ctx);
+    vox_mpool_free(mpool, st);
+}
+
+static void vox_http2_stream_unlink(vox_http2_session_t* s, vox_http2_stream_t* st) {
+    vox_htable_delete(s->streams, &st->id, sizeof(st->id));
+    if (st->all_prev) st->all_prev->all_next = st->all_next;
+    else s->all_streams = st->all_next;
+    if (st->all_next) st->all_next->all_prev = st->all_prev;
+    if (st->queued) {
+        vox_http2_stream_t** pp = &s->send_head;
+        s->send_tail = NULL;
+        while (*pp) {
+            if (*pp == st) {
+                *pp = st->send_next;
+                continue;
+            }
+            s->send_tail = *pp;
+            pp = &(*pp)->send_next;
+        }
+        st->queued = false;
+    }
+}
+
+/* 两个方向都结束（或已重置）且不在 handler/defer 中时释放流 */
+static void vox_http2_stream_maybe_release(vox_http2_stream_t* st) {
+    vox_http2_session_t* s = st->session;
+    if (!s || st->pinned || st->ctx.deferred) return;
+    if (!st->reset && !(st->local_closed && st->remote_closed)) return;
+    vox_http2_stream_unlink(s, st);
+    vox_http2_stream_free(s->mpool, st);
+}
+
+static void vox_http2_stream_reset(vox_http2_session_t* s, vox_http2_stream_t* st, uint32_t sid, uint32_t code) {
+    vox_http2_write_u32_frame(s, VOX_HTTP2_FRAME_RST_STREAM, sid, code);
+    if (st) {
+        st->reset = true;
+        vox_http2_stream_maybe_release(st);
+    }
+}
+
+static void vox_http2_enqueue(vox_http2_session_t* s, vox_http2_stream_t* st) {
+    if (st->queued) return;
+    st->queued = true;
+    st->send_next = NULL;
+    if (s->send_tail) s->send_tail->send_next = st;
+    else s->send_head = st;
+    s->send_tail = st;
+}
+
+static size_t vox_http2_stream_pending(const vox_http2_stream_t* st) {
+    if (st->ctx.sendfile_file) return st->ctx.sendfile_count;
+    size_t blen = st->ctx.res.body ? vox_string_length(st->ctx.res.body) : 0;
+    return blen > st->body_off ? blen - st->body_off : 0;
+}
+
+/* 按窗口与预算输出 DATA：各流轮转，每轮最多一帧 */
+static void vox_http2_pump(vox_http2_session_t* s) {
+    while (s->send_head && s->send_window > 0 && !s->failed &&
+           vox_string_length(s->out) < VOX_HTTP2_SEND_BUDGET) {
+        vox_http2_stream_t* st = s->send_head;
+        s->send_head = st->send_next;
+        if (!s->send_head) s->send_tail = NULL;
+        st->queued = false;
+        if (st->reset) {
+            vox_http2_stream_maybe_release(st);
+            continue;
+        }
+        /* 流窗口耗尽：等待该流的 WINDOW_UPDATE 重新入队 */
+        if (st->send_window <= 0) continue;
+
+        size_t remaining = vox_http2_stream_pending(st);
+        size_t n = remaining;
+        if ((int64_t)n > st->send_window) n = (size_t)st->send_window;
+        if ((int64_t)n > s->send_window) n = (size_t)s->send_window;
+        if (n > s->peer_max_frame_size) n = s->peer_max_frame_size;
+        bool end = (n == remaining);
+
+        size_t base = vox_string_length(s->out);
+        if (vox_http2_write_frame_header(s->out, n, VOX_HTTP2_FRAME_DATA,
+                                         end ? VOX_HTTP2_FLAG_END_STREAM : 0, st->id) != 0 ||
+            vox_string_resize(s->out, base + VOX_HTTP2_FRAME_HEADER_LEN + n) != 0) {
+            vox_string_resize(s->out, base);
+            vox_http2_connection_error(s, VOX_HTTP2_INTERNAL_ERROR);
+            return;
+        }
+        char* dst = (char*)vox_string_data(s->out) + base + VOX_HTTP2_FRAME_HEADER_LEN;
+        if (st->ctx.sendfile_file) {
+            size_t done = 0;
+            int64_t r;
+            while (done < n &&
+                   (r = vox_file_read_at(st->ctx.sendfile_file, dst + done, n - done,
+                                         st->ctx.sendfile_offset + (int64_t)done)) > 0) {
+                done += (size_t)r;
+            }
+            if (done < n) {
+                /* 文件被截断或读取失败：响应头已发出，只能重置流 */
+                vox_string_resize(s->out, base);
+                VOX_LOG_ERROR("http2: sendfile read failed on stream %u", (unsigned)st->id);
+                vox_http2_stream_reset(s, st, st->id, VOX_HTTP2_INTERNAL_ERROR);
+                continue;
+            }
+            st->ctx.sendfile_offset += (int64_t)n;
+            st->ctx.sendfile_count -= n;
+        } else {
+            memcpy(dst, (const char*)vox_string_data(st->ctx.res.body) + st->body_off, n);
+            st->body_off += n;
+        }
+        st->send_window -= (int64_t)n;
+        s->send_window -= (int64_t)n;
+
+        if (end) {
+            st->local_closed = true;
+            vox_http2_stream_release_sendfile(st);
+            vox_http2_stream_maybe_release(st);
+        } else if (st->send_window > 0) {
+            vox_http2_enqueue(s, st);
+        }
+    }
+}
+
+/* ===== 响应 ===== */
+
+/* 连接相关头部在 HTTP/2 中非法（RFC 9113 8.2.2） */
+static bool vox_http2_is_connection_header(const char* name, size_t len) {
+    return vox_http_strieq(name, len, "connection", 10) ||
+           vox_http_strieq(name, len, "keep-alive", 10) ||
+           vox_http_strieq(name, len, "proxy-connection", 16) ||
+           vox_http_strieq(name, len, "transfer-encoding", 17) ||
+           vox_http_strieq(name, len, "upgrade", 7);
+}
+
+/* 取值每次都不同的头部不进入动态表，避免挤掉可复用的条目 */
+static int vox_http2_header_index_flags(const char* name, size_t len) {
+    if (vox_http_strieq(name, len, "set-cookie", 10)) return VOX_HTTP_HPACK_NEVER_INDEX;
+    if (vox_http_strieq(name, len, "content-length", 14) ||
+        vox_http_strieq(name, len, "date", 4) ||
+        vox_http_strieq(name, len, "etag", 4) ||
+        vox_http_strieq(name, len, "last-modified", 13) ||
+        vox_http_strieq(name, len, "content-range", 13)) {
+        return VOX_HTTP_HPACK_NO_INDEX;
+    }
+    return 0;
+}
+
+static int vox_http2_encode_response_headers(vox_http2_session_t* s, vox_http2_stream_t* st, size_t body_len) {
+    vox_http_context_t* ctx = &st->ctx;
+    vox_string_t* blk = s->block;
+    vox_string_clear(blk);
+    if (vox_http_hpack_encode_begin(s->encoder, blk) != 0) return -1;
+
+    int status = ctx->res.status ? ctx->res.status : 200;
+    char sbuf[16];
+    int slen = snprintf(sbuf, sizeof(sbuf), "%d", status);
+    if (vox_http_hpack_encode(s->encoder, blk, ":status", 7, sbuf, (size_t)slen, 0) != 0) return -1;
+
+    bool has_type = false;
+    bool has_length = false;
+    char lname[256];
+    if (ctx->res.headers) {
+        const vox_vector_t* rh = (const vox_vector_t*)ctx->res.headers;
+        size_t cnt = vox_vector_size(rh);
+        for (size_t i = 0; i < cnt; i++) {
+            const vox_http_header_t* kv = (const vox_http_header_t*)vox_vector_get(rh, i);
+            if (!kv || !kv->name.ptr || kv->name.len == 0 || kv->name.len > sizeof(lname)) continue;
+            if (vox_http2_is_connection_header(kv->name.ptr, kv->name.len)) continue;
+            for (size_t j = 0; j < kv->name.len; j++) {
+                char c = kv->name.ptr[j];
+                lname[j] = (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+            }
+            if (kv->name.len == 12 && memcmp(lname, "content-type", 12) == 0) has_type = true;
+            if (kv->name.len == 14 && memcmp(lname, "content-length", 14) == 0) has_length = true;
+            if (vox_http_hpack_encode(s->encoder, blk, lname, kv->name.len,
+                                      kv->value.ptr ? kv->value.ptr : "", kv->value.len,
+                                      vox_http2_header_index_flags(lname, kv->name.len)) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    bool no_body_status = (status >= 100 && status < 200) || status == 204 || status == 304;
+    if (!no_body_status) {
+        if (!has_length) {
+            char lbuf[32];
+            int llen = snprintf(lbuf, sizeof(lbuf), "%zu", body_len);
+            if (vox_http_hpack_encode(s->encoder, blk, "content-length", 14, lbuf, (size_t)llen,
+                                      VOX_HTTP_HPACK_NO_INDEX) != 0) {
+                return -1;
+            }
+        }
+        if (!has_type && body_len > 0) {
+            static const char kType[] = "text/plain; charset=utf-8";
+            if (vox_http_hpack_encode(s->encoder, blk, "content-type", 12, kType, sizeof(kType) - 1, 0) != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* 把 block 中的头部块按对端最大帧长切分为 HEADERS + CONTINUATION */
+static int vox_http2_write_header_block(vox_http2_session_t* s, uint32_t sid, bool end_stream) {
+    const char* p = (const char*)vox_string_data(s->block);
+    size_t left = vox_string_length(s->block);
+    bool first = true;
+    do {
+        size_t n = left > s->peer_max_frame_size ? s->peer_max_frame_size : left;
+        uint8_t flags = (n == left) ? VOX_HTTP2_FLAG_END_HEADERS : 0;
+        uint8_t type = VOX_HTTP2_FRAME_CONTINUATION;
+        if (first) {
+            type = VOX_HTTP2_FRAME_HEADERS;
+            if (end_stream) flags |= VOX_HTTP2_FLAG_END_STREAM;
+        }
+        if (vox_http2_write_frame(s, type, flags, sid, p, n) != 0) return -1;
+        p += n;
+        left -= n;
+        first = false;
+    } while (left > 0);
+    return 0;
+}
+
+static int vox_http2_stream_respond(vox_http2_stream_t* st) {
+    vox_http2_session_t* s = st->session;
+    if (!s || st->responding) return -1;
+    st->responding = true;
+    if (st->reset) {
+        vox_http2_stream_release_sendfile(st);
+        return 0;
+    }
+
+    vox_http_context_t* ctx = &st->ctx;
+    int status = ctx->res.status ? ctx->res.status : 200;
+    size_t body_len = ctx->sendfile_file ? ctx->sendfile_count
+                                         : (ctx->res.body ? vox_string_length(ctx->res.body) : 0);
+    if (vox_http2_encode_response_headers(s, st, body_len) != 0) {
+        /* 编码器状态可能已与对端不同步，只能终止连接 */
+        return vox_http2_connection_error(s, VOX_HTTP2_INTERNAL_ERROR);
+    }
+
+    bool no_body = st->head_request || body_len == 0 ||
+                   (status >= 100 && status < 200) || status == 204 || status == 304;
+    if (vox_http2_write_header_block(s, st->id, no_body) != 0) {
+        return vox_http2_connection_error(s, VOX_HTTP2_INTERNAL_ERROR);
+    }
+    if (no_body) {
+        st->local_closed = true;
+        vox_http2_stream_release_sendfile(st);
+    } else {
+        st->body_off = 0;
+        vox_http2_enqueue(s, st);
+        vox_http2_pump(s);
+    }
+    return 0;
+}
+
+int vox_http2_stream_send_response(void* stream) {
+    vox_http2_stream_t* st = (vox_http2_stream_t*)stream;
+    if (!st) return -1;
+    vox_http2_session_t* s = st->session;
+    if (!s) {
+        /* 会话已销毁：流及其内存随连接 mpool 回收，这里只归还 sendfile */
+        vox_http2_stream_release_sendfile(st);
+        return -1;
+    }
+    s->busy++;
+    st->pinned = true;
+    int rc = vox_http2_stream_respond(st);
+    st->pinned = false;
+    vox_http2_stream_maybe_release(st);
+    s->busy--;
+    vox_http2_flush(s);
+    return rc;
+}
+
+/* ===== 请求 ===== */
+
+static int vox_http2_add_header(vox_http2_session_t* s, vox_http2_stream_t* st,
+                                const char* name, size_t nlen, const char* value, size_t vlen) {
+    vox_http_header_t* kv = vox_http_header_alloc(s->mpool, name, nlen, value, vlen);
+    if (!kv) return -1;
+    if (vox_vector_push(st->headers, kv) != 0) {
+        vox_mpool_free(s->mpool, kv);
+        return -1;
+    }
+    return 0;
+}
+
+static int vox_http2_parse_method(const char* m, size_t len, vox_http_method_t* out) {
+    static const struct { const char* name; size_t len; vox_http_method_t method; } kMethods[] = {
+        { "GET", 3, VOX_HTTP_METHOD_GET },         { "HEAD", 4, VOX_HTTP_METHOD_HEAD },
+        { "POST", 4, VOX_HTTP_METHOD_POST },       { "PUT", 3, VOX_HTTP_METHOD_PUT },
+        { "DELETE", 6, VOX_HTTP_METHOD_DELETE },   { "CONNECT", 7, VOX_HTTP_METHOD_CONNECT },
+        { "OPTIONS", 7, VOX_HTTP_METHOD_OPTIONS }, { "TRACE", 5, VOX_HTTP_METHOD_TRACE },
+        { "PATCH", 5, VOX_HTTP_METHOD_PATCH },
+    };
+    for (size_t i = 0; i < sizeof(kMethods) / sizeof(kMethods[0]); i++) {
+        if (kMethods[i].len == len && memcmp(kMethods[i].name, m, len) == 0) {
+            *out = kMethods[i].method;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+typedef struct {
+    vox_http2_session_t* session;
+    vox_http2_stream_t* stream;   /* NULL：被拒绝的流，只为保持 HPACK 状态而解码 */
+    bool trailers;
+} vox_http2_decode_state_t;
+
+static int vox_http2_on_request_header(void* user_data, const char* name, size_t nlen,
+                                       const char* value, size_t vlen) {
+    vox_http2_decode_state_t* ds = (vox_http2_decode_state_t*)user_data;
+    vox_http2_stream_t* st = ds->stream;
+    if (!st || st->malformed) return 0;
+
+    st->header_list_size += nlen + vlen + 32;
+    if (st->header_list_size > ds->session->config.max_header_list_size) {
+        st->malformed = true;
+        return 0;
+    }
+
+    if (nlen > 0 && name[0] == ':') {
+        if (st->regular_seen || ds->trailers) {
+            st->malformed = true;
+        } else if (nlen == 7 && memcmp(name, ":method", 7) == 0 && !st->has_method) {
+            st->has_method = true;
+            if (vox_http2_parse_method(value, vlen, &st->ctx.req.method) != 0) st->malformed = true;
+        } else if (nlen == 5 && memcmp(name, ":path", 5) == 0 && !st->has_path) {
+            st->has_path = true;
+            if (vlen == 0 || vox_string_set_data(st->url, value, vlen) != 0) st->malformed = true;
+        } else if (nlen == 7 && memcmp(name, ":scheme", 7) == 0 && !st->has_scheme) {
+            st->has_scheme = true;
+        } else if (nlen == 10 && memcmp(name, ":authority", 10) == 0) {
+            /* handler 按 HTTP/1.1 习惯读取 Host */
+            if (vox_http2_add_header(ds->session, st, "host", 4, value, vlen) != 0) return -1;
+        } else {
+            st->malformed = true;
+        }
+        return 0;
+    }
+
+    st->regular_seen = true;
+    for (size_t i = 0; i < nlen; i++) {
+        if (name[i] >= 'A' && name[i] <= 'Z') {
+            st->malformed = true;
+            return 0;
+        }
+    }
+    if (vox_http2_is_connection_header(name, nlen) ||
+        (nlen == 2 && memcmp(name, "te", 2) == 0 && !(vlen == 8 && memcmp(value, "trailers", 8) == 0))) {
+        st->malformed = true;
+        return 0;
+    }
+    /* 尾部头部不影响请求（与 HTTP/1.1 chunked trailer 的处理一致） */
+    if (ds->trailers) return 0;
+
+    if (nlen == 6 && memcmp(name, "cookie", 6) == 0) {
+        /* 拆分的 cookie 头合并为一个（RFC 9113 8.2.3） */
+        if (!st->cookie) {
+            st->cookie = vox_string_create(ds->session->mpool);
+            if (!st->cookie) return -1;
+        } else if (vox_string_append_data(st->cookie, "; ", 2) != 0) {
+            return -1;
+        }
+        return vox_string_append_data(st->cookie, value, vlen);
+    }
+    return vox_http2_add_header(ds->session, st, name, nlen, value, vlen);
+}
+
+static void vox_http2_stream_dispatch(vox_http2_stream_t* st) {
+    vox_http2_session_t* s = st->session;
+    vox_http_context_t* ctx = &st->ctx;
+    vox_http_request_t* req = &ctx->req;
+
+    req->http_major = 2;
+    req->http_minor = 0;
+    req->headers = st->headers;
+    req->body = st->body;
+    const char* url = vox_string_cstr(st->url);
+    size_t url_len = vox_string_length(st->url);
+    req->raw_url.ptr = url;
+    req->raw_url.len = url_len;
+    const char* q = (const char*)memchr(url, '?', url_len);
+    req->path.ptr = url;
+    req->path.len = q ? (size_t)(q - url) : url_len;
+    req->query.ptr = q ? q + 1 : NULL;
+    req->query.len = q ? url_len - req->path.len - 1 : 0;
+
+    ctx->mpool = s->mpool;
+    ctx->loop = vox_http_engine_get_loop(s->engine);
+    ctx->engine = s->engine;
+    ctx->conn = s->conn;
+    ctx->h2_stream = st;
+
+    st->pinned = true;
+    vox_http_engine_dispatch(s->engine, ctx, &st->route_match);
+    if (!ctx->deferred && !st->responding) vox_http2_stream_respond(st);
+    st->pinned = false;
+    vox_http2_stream_maybe_release(st);
+}
+
+static int vox_http2_finish_header_block(vox_http2_session_t* s, uint32_t sid, bool end_stream, bool trailers) {
+    vox_http2_stream_t* st = vox_http2_find_stream(s, sid);
+    if (st && st->reset) st = NULL;
+    vox_http2_decode_state_t ds = { s, st, trailers };
+    int rc = vox_http_hpack_decode(s->decoder, vox_string_data(s->block), vox_string_length(s->block),
+                                   vox_http2_on_request_header, &ds);
+    vox_string_clear(s->block);
+    if (rc == -1) return vox_http2_connection_error(s, VOX_HTTP2_COMPRESSION_ERROR);
+    if (rc != 0) return vox_http2_connection_error(s, VOX_HTTP2_INTERNAL_ERROR);
+    if (!st) return 0;
+
+    if (!trailers) {
+        st->headers_done = true;
+        if (!st->malformed && (!st->has_method || !st->has_scheme || !st->has_path) &&
+            !(st->has_method && st->ctx.req.method == VOX_HTTP_METHOD_CONNECT)) {
+            st->malformed = true;
+        }
+        if (!st->malformed && st->cookie) {
+            if (vox_http2_add_header(s, st, "cookie", 6, vox_string_cstr(st->cookie),
+                                     vox_string_length(st->cookie)) != 0) {
+                st->malformed = true;
+            }
+        }
+        st->head_request = (st->ctx.req.method == VOX_HTTP_METHOD_HEAD);
+    }
+    if (st->malformed) {
+        vox_http2_stream_reset(s, st, sid, VOX_HTTP2_PROTOCOL_ERROR);
+        return 0;
+    }
+    if (end_stream) {
+        st->remote_closed = true;
+        vox_http2_stream_dispatch(st);
+    }
+    return 0;
+}
+
+/* ===== 帧处理 ===== */
+
+/* 去掉 PADDED 填充（以及 HEADERS 的 PRIORITY 字段）；格式错误返回-1 */
+static int vox_http2_strip_padding(const uint8_t** payload, size_t* len, uint8_t flags, bool priority) {
+    const uint8_t* p = *payload;
+    size_t n = *len;
+    size_t pad = 0;
+    if (flags & VOX_HTTP2_FLAG_PADDED) {
+        if (n < 1) return -1;
+        pad = p[0];
+        p++;
+        n--;
+    }
+    if (priority && (flags & VOX_HTTP2_FLAG_PRIORITY)) {
+        if (n < 5) return -1;
+        p += 5;
+        n -= 5;
+    }
+    if (pad > n) return -1;
+    *payload = p;
+    *len = n - pad;
+    return 0;
+}
+
+static void vox_http2_replenish(vox_http2_session_t* s, vox_http2_stream_t* st, size_t n) {
+    s->recv_window -= (int64_t)n;
+    s->recv_consumed += (uint32_t)n;
+    if (s->recv_consumed >= s->config.connection_window_size / 2) {
+        vox_http2_write_u32_frame(s, VOX_HTTP2_FRAME_WINDOW_UPDATE, 0, s->recv_consumed);
+        s->recv_window += s->recv_consumed;
+        s->recv_consumed = 0;
+    }
+    if (!st) return;
+    st->recv_window -= (int64_t)n;
+    st->recv_consumed += (uint32_t)n;
+    if (!st->remote_closed && st->recv_consumed >= s->config.initial_window_size / 2) {
+        vox_http2_write_u32_frame(s, VOX_HTTP2_FRAME_WINDOW_UPDATE, st->id, st->recv_consumed);
+        st->recv_window += st->recv_consumed;
+        st->recv_consumed = 0;
+    }
+}
+
+static int vox_http2_on_data(vox_http2_session_t* s, uint8_t flags, uint32_t sid,
+                             const uint8_t* payload, size_t len) {
+    if (sid == 0) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+    /* 流量控制按整个帧负载（含填充）计算 */
+    if ((int64_t)len > s->recv_window) return vox_http2_connection_error(s, VOX_HTTP2_FLOW_CONTROL_ERROR);
+    size_t frame_len = len;
+    if (vox_http2_strip_padding(&payload, &len, flags, false) != 0) {
+        return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+    }
+
+    vox_http2_stream_t* st = vox_http2_find_stream(s, sid);
+    if (!st) {
+        if (sid > s->last_stream_id) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+        /* 已关闭的流：仍计入连接窗口 */
+        vox_http2_replenish(s, NULL, frame_len);
+        vox_http2_stream_reset(s, NULL, sid, VOX_HTTP2_STREAM_CLOSED);
+        return 0;
+    }
+    if (st->reset) {
+        /* 已重置但仍在 defer 中的流：丢弃数据 */
+        vox_http2_replenish(s, NULL, frame_len);
+        return 0;
+    }
+    if (st->remote_closed || !st->headers_done) {
+        vox_http2_replenish(s, NULL, frame_len);
+        vox_http2_stream_reset(s, st, sid, VOX_HTTP2_STREAM_CLOSED);
+        return 0;
+    }
+    if ((int64_t)frame_len > st->recv_window) {
+        vox_http2_replenish(s, NULL, frame_len);
+        vox_http2_stream_reset(s, st, sid, VOX_HTTP2_FLOW_CONTROL_ERROR);
+        return 0;
+    }
+    if (len > 0 && vox_string_append_data(st->body, payload, len) != 0) {
+        return vox_http2_connection_error(s, VOX_HTTP2_INTERNAL_ERROR);
+    }
+    if (flags & VOX_HTTP2_FLAG_END_STREAM) st->remote_closed = true;
+    vox_http2_replenish(s, st, frame_len);
+    if (st->remote_closed) vox_http2_stream_dispatch(st);
+    return 0;
+}
+
+static int vox_http2_on_headers(vox_http2_session_t* s, uint8_t flags, uint32_t sid,
+                                const uint8_t* payload, size_t len) {
+    if (sid == 0 || (sid & 1) == 0) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+    if (vox_http2_strip_padding(&payload, &len, flags, true) != 0) {
+        return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+    }
+
+    bool end_stream = (flags & VOX_HTTP2_FLAG_END_STREAM) != 0;
+    bool trailers = false;
+    vox_http2_stream_t* st = vox_http2_find_stream(s, sid);
+    if (st) {
+        /* 已有流上的 HEADERS 只能是携带 END_STREAM 的尾部 */
+        /* 头部块无法跳过解码（HPACK 状态会失步），按连接错误处理 */
+        if (st->remote_closed) return vox_http2_connection_error(s, VOX_HTTP2_STREAM_CLOSED);
+        if (!end_stream) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+        trailers = true;
+    } else {
+        if (sid <= s->last_stream_id) return vox_http2_connection_error(s, VOX_HTTP2_STREAM_CLOSED);
+        s->last_stream_id = sid;
+        if (!s->goaway_sent) {
+            if (vox_htable_size(s->streams) >= s->config.max_concurrent_streams) {
+                vox_http2_stream_reset(s, NULL, sid, VOX_HTTP2_REFUSED_STREAM);
+            } else if (!vox_http2_stream_create(s, sid)) {
+                vox_http2_stream_reset(s, NULL, sid, VOX_HTTP2_INTERNAL_ERROR);
+            }
+        }
+    }
+
+    vox_string_clear(s->block);
+    if (vox_string_append_data(s->block, payload, len) != 0) {
+        return vox_http2_connection_error(s, VOX_HTTP2_INTERNAL_ERROR);
+    }
+    if (flags & VOX_HTTP2_FLAG_END_HEADERS) {
+        return vox_http2_finish_header_block(s, sid, end_stream, trailers);
+    }
+    s->continuation_stream = sid;
+    s->continuation_end_stream = end_stream;
+    s->continuation_trailers = trailers;
+    return 0;
+}
+
+static int vox_http2_on_continuation(vox_http2_session_t* s, uint8_t flags, uint32_t sid,
+                                     const uint8_t* payload, size_t len) {
+    if (sid != s->continuation_stream) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+    /* 压缩后的头部块已超过解压后的上限，不可能是合法请求 */
+    if (vox_string_length(s->block) + len > s->config.max_header_list_size) {
+        return vox_http2_connection_error(s, VOX_HTTP2_ENHANCE_YOUR_CALM);
+    }
+    if (vox_string_append_data(s->block, payload, len) != 0) {
+        return vox_http2_connection_error(s, VOX_HTTP2_INTERNAL_ERROR);
+    }
+    if (!(flags & VOX_HTTP2_FLAG_END_HEADERS)) return 0;
+    s->continuation_stream = 0;
+    return vox_http2_finish_header_block(s, sid, s->continuation_end_stream, s->continuation_trailers);
+}
+
+static int vox_http2_on_settings(vox_http2_session_t* s, uint8_t flags, uint32_t sid,
+                                 const uint8_t* payload, size_t len) {
+    if (sid != 0) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+    if (flags & VOX_HTTP2_FLAG_ACK) {
+        if (len != 0) return vox_http2_connection_error(s, VOX_HTTP2_FRAME_SIZE_ERROR);
+        return 0;
+    }
+    if (len % 6 != 0) return vox_http2_connection_error(s, VOX_HTTP2_FRAME_SIZE_ERROR);
+
+    for (size_t off = 0; off < len; off += 6) {
+        uint16_t id = (uint16_t)((payload[off] << 8) | payload[off + 1]);
+        uint32_t v = vox_http2_get_u32(payload + off + 2);
+        switch (id) {
+            case VOX_HTTP2_SETTINGS_HEADER_TABLE_SIZE:
+                /* 编码器动态表不超过默认大小，限制每连接内存 */
+                vox_http_hpack_set_max_table_size(s->encoder,
+                    v < VOX_HTTP_HPACK_DEFAULT_TABLE_SIZE ? v : VOX_HTTP_HPACK_DEFAULT_TABLE_SIZE);
+                break;
+            case VOX_HTTP2_SETTINGS_ENABLE_PUSH:
+                if (v > 1) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+                break;
+            case VOX_HTTP2_SETTINGS_INITIAL_WINDOW_SIZE: {
+                if (v > VOX_HTTP2_MAX_WINDOW) return vox_http2_connection_error(s, VOX_HTTP2_FLOW_CONTROL_ERROR);
+                int64_t delta = (int64_t)v - s->peer_initial_window;
+                s->peer_initial_window = v;
+                for (vox_http2_stream_t* st = s->all_streams; st; st = st->all_next) {
+                    st->send_window += delta;
+                    if (st->send_window > VOX_HTTP2_MAX_WINDOW) {
+                        return vox_http2_connection_error(s, VOX_HTTP2_FLOW_CONTROL_ERROR);
+                    }
+                    if (delta > 0 && st->responding && !st->local_closed && st->send_window > 0) {
+                        vox_http2_enqueue(s, st);
+                    }
+                }
+                break;
+            }
+            case VOX_HTTP2_SETTINGS_MAX_FRAME_SIZE:
+                if (v < VOX_HTTP2_DEFAULT_FRAME_SIZE || v > VOX_HTTP2_MAX_FRAME_SIZE_LIMIT) {
+                    return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+                }
+                s->peer_max_frame_size = v;
+                break;
+            default:
+                /* 未知或不影响服务端行为的设置：忽略 */
+                break;
+        }
+    }
+    s->settings_received = true;
+    if (vox_http2_write_frame(s, VOX_HTTP2_FRAME_SETTINGS, VOX_HTTP2_FLAG_ACK, 0, NULL, 0) != 0) {
+        return vox_http2_connection_error(s, VOX_HTTP2_INTERNAL_ERROR);
+    }
+    vox_http2_pump(s);
+    return 0;
+}
+
+static int vox_http2_on_window_update(vox_http2_session_t* s, uint32_t sid, const uint8_t* payload, size_t len) {
+    if (len != 4) return vox_http2_connection_error(s, VOX_HTTP2_FRAME_SIZE_ERROR);
+    uint32_t inc = vox_http2_get_u32(payload) & 0x7fffffffu;
+    if (sid == 0) {
+        if (inc == 0) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+        s->send_window += inc;
+        if (s->send_window > VOX_HTTP2_MAX_WINDOW) {
+            return vox_http2_connection_error(s, VOX_HTTP2_FLOW_CONTROL_ERROR);
+        }
+        vox_http2_pump(s);
+        return 0;
+    }
+
+    vox_http2_stream_t* st = vox_http2_find_stream(s, sid);
+    if (!st) {
+        if (sid > s->last_stream_id) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+        return 0;
+    }
+    if (inc == 0) {
+        vox_http2_stream_reset(s, st, sid, VOX_HTTP2_PROTOCOL_ERROR);
+        return 0;
+    }
+    st->send_window += inc;
+    if (st->send_window > VOX_HTTP2_MAX_WINDOW) {
+        vox_http2_stream_reset(s, st, sid, VOX_HTTP2_FLOW_CONTROL_ERROR);
+        return 0;
+    }
+    if (st->responding && !st->local_closed && !st->reset && st->send_window > 0) {
+        vox_http2_enqueue(s, st);
+        vox_http2_pump(s);
+    }
+    return 0;
+}
+
+static int vox_http2_process_frame(vox_http2_session_t* s, uint8_t type, uint8_t flags, uint32_t sid,
+                                   const uint8_t* payload, size_t len) {
+    /* 前言之后的第一个帧必须是 SETTINGS */
+    if (!s->settings_received && type != VOX_HTTP2_FRAME_SETTINGS) {
+        return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+    }
+    /* 头部块未结束时只允许同一流的 CONTINUATION */
+    if (s->continuation_stream != 0 && type != VOX_HTTP2_FRAME_CONTINUATION) {
+        return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+    }
+
+    switch (type) {
+        case VOX_HTTP2_FRAME_DATA:
+            return vox_http2_on_data(s, flags, sid, payload, len);
+        case VOX_HTTP2_FRAME_HEADERS:
+            return vox_http2_on_headers(s, flags, sid, payload, len);
+        case VOX_HTTP2_FRAME_CONTINUATION:
+            return vox_http2_on_continuation(s, flags, sid, payload, len);
+        case VOX_HTTP2_FRAME_PRIORITY:
+            if (sid == 0) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+            if (len != 5) vox_http2_stream_reset(s, vox_http2_find_stream(s, sid), sid, VOX_HTTP2_FRAME_SIZE_ERROR);
+            return 0;
+        case VOX_HTTP2_FRAME_RST_STREAM: {
+            if (len != 4) return vox_http2_connection_error(s, VOX_HTTP2_FRAME_SIZE_ERROR);
+            if (sid == 0 || sid > s->last_stream_id) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+            vox_http2_stream_t* st = vox_http2_find_stream(s, sid);
+            if (st) {
+                st->reset = true;
+                vox_http2_stream_maybe_release(st);
+            }
+            return 0;
+        }
+        case VOX_HTTP2_FRAME_SETTINGS:
+            return vox_http2_on_settings(s, flags, sid, payload, len);
+        case VOX_HTTP2_FRAME_PUSH_PROMISE:
+            /* 客户端不得发送 PUSH_PROMISE */
+            return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+        case VOX_HTTP2_FRAME_PING:
+            if (sid != 0) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+            if (len != 8) return vox_http2_connection_error(s, VOX_HTTP2_FRAME_SIZE_ERROR);
+            if (!(flags & VOX_HTTP2_FLAG_ACK)) {
+                vox_http2_write_frame(s, VOX_HTTP2_FRAME_PING, VOX_HTTP2_FLAG_ACK, 0, payload, len);
+            }
+            return 0;
+        case VOX_HTTP2_FRAME_GOAWAY:
+            if (sid != 0) return vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+            if (len < 8) return vox_http2_connection_error(s, VOX_HTTP2_FRAME_SIZE_ERROR);
+            s->goaway_received = true;
+            return 0;
+        case VOX_HTTP2_FRAME_WINDOW_UPDATE:
+            return vox_http2_on_window_update(s, sid, payload, len);
+        default:
+            /* 未知帧类型必须忽略 */
+            return 0;
+    }
+}
+
+/* 处理 data 中的完整帧，返回已消费的字节数；出错时 s->failed 置位 */
+static size_t vox_http2_process(vox_http2_session_t* s, const uint8_t* data, size_t len) {
+    size_t off = 0;
+    if (!s->preface_done) {
+        size_t n = len < VOX_HTTP2_PREFACE_LEN ? len : VOX_HTTP2_PREFACE_LEN;
+        if (memcmp(data, VOX_HTTP2_PREFACE, n) != 0) {
+            vox_http2_connection_error(s, VOX_HTTP2_PROTOCOL_ERROR);
+            return len;
+        }
+        if (len < VOX_HTTP2_PREFACE_LEN) return 0;
+        s->preface_done = true;
+        off = VOX_HTTP2_PREFACE_LEN;
+    }
+    while (!s->failed && len - off >= VOX_HTTP2_FRAME_HEADER_LEN) {
+        const uint8_t* h = data + off;
+        size_t flen = ((size_t)h[0] << 16) | ((size_t)h[1] << 8) | (size_t)h[2];
+        if (flen > s->config.max_frame_size) {
+            vox_http2_connection_error(s, VOX_HTTP2_FRAME_SIZE_ERROR);
+            return len;
+        }
+        if (len - off < VOX_HTTP2_FRAME_HEADER_LEN + flen) break;
+        uint32_t sid = vox_http2_get_u32(h + 5) & 0x7fffffffu;
+        vox_http2_process_frame(s, h[3], h[4], sid, h + VOX_HTTP2_FRAME_HEADER_LEN, flen);
+        off += VOX_HTTP2_FRAME_HEADER_LEN + flen;
+    }
+    return s->failed ? len : off;
+}
+
+/* ===== 公共 API ===== */
+
+vox_http2_session_t* vox_http2_session_create(vox_mpool_t* mpool, vox_http_engine_t* engine,
+                                              const vox_http2_config_t* config,
+                                              vox_http2_send_cb send_cb, void* user_data) {
+    if (!mpool || !engine || !send_cb) return NULL;
+    vox_http2_session_t* s = (vox_http2_session_t*)vox_mpool_alloc(mpool, sizeof(vox_http2_session_t));
+    if (!s) return NULL;
+    memset(s, 0, sizeof(*s));
+    s->mpool = mpool;
+    s->engine = engine;
+    s->send_cb = send_cb;
+    s->send_data = user_data;
+    if (config) s->config = *config;
+    if (s->config.max_concurrent_streams == 0) s->config.max_concurrent_streams = 128;
+    if (s->config.initial_window_size == 0) s->config.initial_window_size = 1024 * 1024;
+    if (s->config.connection_window_size == 0) s->config.connection_window_size = 16 * 1024 * 1024;
+    if (s->config.max_frame_size == 0) s->config.max_frame_size = VOX_HTTP2_DEFAULT_FRAME_SIZE;
+    if (s->config.header_table_size == 0) s->config.header_table_size = VOX_HTTP_HPACK_DEFAULT_TABLE_SIZE;
+    if (s->config.max_header_list_size == 0) s->config.max_header_list_size = 64 * 1024;
+    if (s->config.initial_window_size > VOX_HTTP2_MAX_WINDOW) s->config.initial_window_size = VOX_HTTP2_MAX_WINDOW;
+    if (s->config.connection_window_size > VOX_HTTP2_MAX_WINDOW) s->config.connection_window_size = VOX_HTTP2_MAX_WINDOW;
+    if (s->config.max_frame_size < VOX_HTTP2_DEFAULT_FRAME_SIZE) s->config.max_frame_size = VOX_HTTP2_DEFAULT_FRAME_SIZE;
+    if (s->config.max_frame_size > VOX_HTTP2_MAX_FRAME_SIZE_LIMIT) s->config.max_frame_size = VOX_HTTP2_MAX_FRAME_SIZE_LIMIT;
+
+    s->peer_max_frame_size = VOX_HTTP2_DEFAULT_FRAME_SIZE;
+    s->peer_initial_window = VOX_HTTP2_DEFAULT_WINDOW;
+    s->send_window = VOX_HTTP2_DEFAULT_WINDOW;
+    s->recv_window = VOX_HTTP2_DEFAULT_WINDOW;
+
+    s->decoder = vox_http_hpack_create(mpool, s->config.header_table_size);
+    s->encoder = vox_http_hpack_create(mpool, VOX_HTTP_HPACK_DEFAULT_TABLE_SIZE);
+    s->in = vox_string_create(mpool);
+    s->out = vox_string_create(mpool);
+    s->sending = vox_string_create(mpool);
+    s->block = vox_string_create(mpool);
+    s->streams = vox_htable_create(mpool);
+    if (!s->decoder || !s->encoder || !s->in || !s->out || !s->sending || !s->block || !s->streams) {
+        vox_http2_session_destroy(s);
+        return NULL;
+    }
+
+    /* 服务端连接前言：SETTINGS，随后把连接窗口扩大到配置值 */
+    uint8_t settings[6 * 5];
+    size_t n = 0;
+    const struct { uint16_t id; uint32_t v; } kv[] = {
+        { VOX_HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, s->config.max_concurrent_streams },
+        { VOX_HTTP2_SETTINGS_INITIAL_WINDOW_SIZE, s->config.initial_window_size },
+        { VOX_HTTP2_SETTINGS_MAX_FRAME_SIZE, s->config.max_frame_size },
+        { VOX_HTTP2_SETTINGS_HEADER_TABLE_SIZE, s->config.header_table_size },
+        { VOX_HTTP2_SETTINGS_MAX_HEADER_LIST_SIZE, s->config.max_header_list_size },
+    };
+    for (size_t i = 0; i < sizeof(kv) / sizeof(kv[0]); i++) {
+        settings[n++] = (uint8_t)(kv[i].id >> 8);
+        settings[n++] = (uint8_t)kv[i].id;
+        settings[n++] = (uint8_t)(kv[i].v >> 24);
+        settings[n++] = (uint8_t)(kv[i].v >> 16);
+        settings[n++] = (uint8_t)(kv[i].v >> 8);
+        settings[n++] = (uint8_t)kv[i].v;
+    }
+    vox_http2_write_frame(s, VOX_HTTP2_FRAME_SETTINGS, 0, 0, settings, n);
+    if (s->config.connection_window_size > VOX_HTTP2_DEFAULT_WINDOW) {
+        vox_http2_write_u32_frame(s, VOX_HTTP2_FRAME_WINDOW_UPDATE, 0,
+                                  s->config.connection_window_size - VOX_HTTP2_DEFAULT_WINDOW);
+        s->recv_window = s->config.connection_window_size;
+    }
+    vox_http2_flush(s);
+    return s;
+}
+
+void vox_http2_session_bind_conn(vox_http2_session_t* session, void* conn) {
+    if (session) session->conn = conn;
+}
+
+void vox_http2_session_destroy(vox_http2_session_t* session) {
+    if (!session) return;
+    vox_mpool_t* mpool = session->mpool;
+    vox_http2_stream_t* st = session->all_streams;
+    while (st) {
+        vox_http2_stream_t* next = st->all_next;
+        if (st->ctx.deferred) {
+            /* 孤儿流：finish 时发现会话已销毁，内存随连接 mpool 回收 */
+            st->session = NULL;
+        } else {
+            vox_http2_stream_free(mpool, st);
+        }
+        st = next;
+    }
+    session->all_streams = NULL;
+    if (session->streams) vox_htable_destroy(session->streams);
+    if (session->decoder) vox_http_hpack_destroy(session->decoder);
+    if (session->encoder) vox_http_hpack_destroy(session->encoder);
+    if (session->in) vox_string_destroy(session->in);
+    if (session->out) vox_string_destroy(session->out);
+    if (session->sending) vox_string_destroy(session->sending);
+    if (session->block) vox_string_destroy(session->block);
+    vox_mpool_free(mpool, session);
+}
+
+int vox_http2_session_feed(vox_http2_session_t* session, const void* data, size_t len) {
+    if (!session) return -1;
+    if (session->failed) return -1;
+    session->busy++;
+    if (vox_string_length(session->in) == 0) {
+        /* 常见情况：直接在读缓冲上解析，只保存不完整的尾部 */
+        size_t used = vox_http2_process(session, (const uint8_t*)data, len);
+        if (used < len && vox_string_append_data(session->in, (const char*)data + used, len - used) != 0) {
+            vox_http2_connection_error(session, VOX_HTTP2_INTERNAL_ERROR);
+        }
+    } else if (vox_string_append_data(session->in, data, len) != 0) {
+        vox_http2_connection_error(session, VOX_HTTP2_INTERNAL_ERROR);
+    } else {
+        size_t used = vox_http2_process(session, (const uint8_t*)vox_string_data(session->in),
+                                        vox_string_length(session->in));
+        vox_string_remove(session->in, 0, used);
+    }
+    if (session->failed) vox_string_clear(session->in);
+    session->busy--;
+    vox_http2_flush(session);
+    return session->failed ? -1 : 0;
+}
+
+void vox_http2_session_on_writable(vox_http2_session_t* session) {
+    if (!session || session->failed) return;
+    session->busy++;
+    vox_http2_pump(session);
+    session->busy--;
+    vox_http2_flush(session);
+}
+
+bool vox_http2_session_want_close(const vox_http2_session_t* session) {
+    if (!session) return true;
+    if (session->failed) return true;
+    return (session->goaway_sent || session->goaway_received) && vox_htable_size(session->streams) == 0;
+}
+
+size_t vox_http2_session_stream_count(const vox_http2_session_t* session) {
+    return session ? vox_htable_size(session->streams) : 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * vox_http2.h - HTTP/2 服务端连接（RFC 9113）
+ *
+ * 会话与传输无关：上层把 socket 读到的字节交给 feed，会话产生的帧通过 send 回调写出。
+ * vox_http_server 在 TLS 协商出 ALPN "h2"，或明文连接以 HTTP/2 连接前言开头（prior-knowledge h2c）时使用它。
+ *
+ * - 每个流拥有独立的 vox_http_context_t，请求完整（END_STREAM）后交给 engine 的路由/挂载/中间件，
+ *   与 HTTP/1.1 共享 handler 模型（含 defer/finish），多个流可同时处于 defer 状态
+ * - HPACK 使用静态表与动态表（见 vox_http_hpack.h）
+ * - 流量控制：接收窗口在请求体被缓冲后及时补充；发送按连接/流窗口与对端 SETTINGS_MAX_FRAME_SIZE 切分 DATA，
+ *   多个流轮转发送，每次输出不超过 VOX_HTTP2_SEND_BUDGET，写完后由上层调用 on_writable 继续
+ * - 不支持服务端推送（SETTINGS_ENABLE_PUSH 始终按 0 处理），忽略优先级
+ */
+
+#ifndef VOX_HTTP2_H
+#define VOX_HTTP2_H
+
+#include "../vox_os.h"
+#include "../vox_mpool.h"
+#include "vox_http_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 连接前言（客户端首先发送） */
+#define VOX_HTTP2_PREFACE "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+#define VOX_HTTP2_PREFACE_LEN 24
+
+/* 一次 feed / on_writable 最多产生的 DATA 字节数（之后等待上层写完） */
+#define VOX_HTTP2_SEND_BUDGET (256 * 1024)
+
+/* 帧类型 */
+typedef enum {
+    VOX_HTTP2_FRAME_DATA = 0x0,
+    VOX_HTTP2_FRAME_HEADERS = 0x1,
+    VOX_HTTP2_FRAME_PRIORITY = 0x2,
+    VOX_HTTP2_FRAME_RST_STREAM = 0x3,
+    VOX_HTTP2_FRAME_SETTINGS = 0x4,
+    VOX_HTTP2_FRAME_PUSH_PROMISE = 0x5,
+    VOX_HTTP2_FRAME_PING = 0x6,
+    VOX_HTTP2_FRAME_GOAWAY = 0x7,
+    VOX_HTTP2_FRAME_WINDOW_UPDATE = 0x8,
+    VOX_HTTP2_FRAME_CONTINUATION = 0x9
+} vox_http2_frame_type_t;
+
+/* 帧标志 */
+#define VOX_HTTP2_FLAG_END_STREAM 0x01
+#define VOX_HTTP2_FLAG_ACK 0x01
+#define VOX_HTTP2_FLAG_END_HEADERS 0x04
+#define VOX_HTTP2_FLAG_PADDED 0x08
+#define VOX_HTTP2_FLAG_PRIORITY 0x20
+
+/* SETTINGS 参数 */
+typedef enum {
+    VOX_HTTP2_SETTINGS_HEADER_TABLE_SIZE = 0x1,
+    VOX_HTTP2_SETTINGS_ENABLE_PUSH = 0x2,
+    VOX_HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS = 0x3,
+    VOX_HTTP2_SETTINGS_INITIAL_WINDOW_SIZE = 0x4,
+    VOX_HTTP2_SETTINGS_MAX_FRAME_SIZE = 0x5,
+    VOX_HTTP2_SETTINGS_MAX_HEADER_LIST_SIZE = 0x6
+} vox_http2_settings_id_t;
+
+/* 错误码 */
+typedef enum {
+    VOX_HTTP2_NO_ERROR = 0x0,
+    VOX_HTTP2_PROTOCOL_ERROR = 0x1,
+    VOX_HTTP2_INTERNAL_ERROR = 0x2,
+    VOX_HTTP2_FLOW_CONTROL_ERROR = 0x3,
+    VOX_HTTP2_SETTINGS_TIMEOUT = 0x4,
+    VOX_HTTP2_STREAM_CLOSED = 0x5,
+    VOX_HTTP2_FRAME_SIZE_ERROR = 0x6,
+    VOX_HTTP2_REFUSED_STREAM = 0x7,
+    VOX_HTTP2_CANCEL = 0x8,
+    VOX_HTTP2_COMPRESSION_ERROR = 0x9,
+    VOX_HTTP2_CONNECT_ERROR = 0xa,
+    VOX_HTTP2_ENHANCE_YOUR_CALM = 0xb,
+    VOX_HTTP2_INADEQUATE_SECURITY = 0xc,
+    VOX_HTTP2_HTTP_1_1_REQUIRED = 0xd
+} vox_http2_error_t;
+
+/* 会话配置（0 表示使用默认值） */
+typedef struct {
+    uint32_t max_concurrent_streams;   /* 默认 128 */
+    uint32_t initial_window_size;      /* 每个流的接收窗口，默认 1MB */
+    uint32_t connection_window_size;   /* 连接级接收窗口，默认 16MB */
+    uint32_t max_frame_size;           /* 可接收的最大帧负载，默认 16384 */
+    uint32_t header_table_size;        /* HPACK 解码动态表上限，默认 4096 */
+    uint32_t max_header_list_size;     /* 请求头部列表上限（解压后），默认 64KB */
+} vox_http2_config_t;
+
+typedef struct vox_http2_session vox_http2_session_t;
+
+/* 输出回调：data 仅在回调期间有效；返回非0表示写出失败（会话进入关闭状态） */
+typedef int (*vox_http2_send_cb)(void* user_data, const void* data, size_t len);
+
+/* 创建会话并输出本端 SETTINGS（服务端连接前言）
+ * @param mpool 连接级内存池（流与 ctx 从中分配）
+ * @param engine 处理请求的 engine
+ * @param config 配置，可为 NULL */
+vox_http2_session_t* vox_http2_session_create(vox_mpool_t* mpool, vox_http_engine_t* engine,
+                                              const vox_http2_config_t* config,
+                                              vox_http2_send_cb send_cb, void* user_data);
+
+/* 销毁会话：释放所有流（defer 中的流转为孤儿，由其 finish 释放） */
+void vox_http2_session_destroy(vox_http2_session_t* session);
+
+/* 喂入从连接读到的字节（从连接前言开始）
+ * @return 0 成功；-1 连接级错误，已输出 GOAWAY，上层应在写完后关闭连接 */
+int vox_http2_session_feed(vox_http2_session_t* session, const void* data, size_t len);
+
+/* 上层把此前的输出写完后调用：继续发送被预算或流量控制暂停的 DATA */
+void vox_http2_session_on_writable(vox_http2_session_t* session);
+
+/* 会话是否应关闭：已收到/发出 GOAWAY 且没有活动流 */
+bool vox_http2_session_want_close(const vox_http2_session_t* session);
+
+/* 当前活动流数量 */
+size_t vox_http2_session_stream_count(const vox_http2_session_t* session);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_HTTP2_H */
@@ -6,6 +6,7 @@
 #include "vox_http_gzip.h"
 #include "../vox_handle.h"
 #include "../vox_timer.h"
+#include "../vox_list.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -21,11 +22,43 @@ typedef struct {
     char* path;     /* NUL 结尾，必须以 '/' 开头，包含 query */
 } vox_http_client_url_t;
 
+#define VOX_HTTP_CLIENT_DEFAULT_MAX_IDLE_PER_HOST 4
+#define VOX_HTTP_CLIENT_DEFAULT_IDLE_TIMEOUT_MS 30000
+
+/* 连接池：每个 loop 一个（loop 扩展数据），同一 loop 上的 client 共享，随 loop 销毁 */
+typedef struct {
+    vox_loop_t* loop;
+    vox_mpool_t* mpool;
+    vox_list_t idle;         /* 空闲连接（队首最旧，队尾最新） */
+    vox_timer_t idle_timer;  /* 弱定时器：在最早到期的空闲连接到期时清理，不阻止 loop 退出 */
+} vox_http_client_pool_t;
+
 struct vox_http_client {
     vox_loop_t* loop;
     vox_mpool_t* mpool;
+    vox_http_client_pool_t* pool;
+
+    bool keep_alive;
+    uint32_t max_idle_per_host;
+    uint64_t idle_timeout_us;
 };
 
+/* 连接池中的空闲连接，按 (scheme, host, port, ssl_ctx) 匹配 */
+typedef struct {
+    vox_list_node_t node;
+    vox_http_client_pool_t* pool;
+    vox_http_client_scheme_t scheme;
+    char* host;
+    uint16_t port;
+    vox_ssl_context_t* ssl_ctx;
+    vox_tcp_t* tcp;
+    vox_tls_t* tls;
+    uint64_t idle_since;     /* 放回连接池的时间（vox_loop_now，微秒） */
+    uint64_t idle_timeout_us; /* 放回该连接的 client 的 idle_timeout */
+} vox_http_client_conn_t;
+
+static const char client_pool_key = 0;
+
 struct vox_http_client_req {
     vox_http_client_t* client;
     vox_loop_t* loop;
@@ -56,6 +89,9 @@ struct vox_http_client_req {
     vox_string_t* compressed_body; /* 收集压缩的响应体（用于解压缩） */
 
     bool response_connection_close; /* 响应头 Connection: close 时置为 true，用于决定是否关闭连接 */
+    bool response_started;          /* 已收到响应数据（on_message_begin） */
+    bool reused;                    /* 连接来自连接池 */
+    bool reusable;                  /* 响应完成且连接可放回连接池 */
 
     vox_timer_t connect_timer;     /* 连接超时定时器（仅 connection_timeout_ms > 0 时使用） */
 
@@ -97,17 +133,275 @@ static int value_is_close(const char* v, size_t vlen) {
 
 static void req_fail(vox_http_client_req_t* req, const char* msg);
 
+/* vox_handle_close 只标记关闭；关闭回调中销毁句柄才会释放 socket */
+static void transport_on_closed(vox_handle_t* handle) {
+    /* 仍归属请求时清空请求的引用，之后的 close/cancel 不会再触碰已销毁的句柄 */
+    vox_http_client_req_t* req = (vox_http_client_req_t*)vox_handle_get_data(handle);
+    if (req) {
+        if ((vox_handle_t*)req->tls == handle) req->tls = NULL;
+        if ((vox_handle_t*)req->tcp == handle) req->tcp = NULL;
+    }
+    vox_handle_set_data(handle, NULL);
+    if (vox_handle_get_type(handle) == VOX_HANDLE_TLS) {
+        vox_tls_destroy((vox_tls_t*)handle);
+    } else {
+        vox_tcp_destroy((vox_tcp_t*)handle);
+    }
+}
+
 static void req_close_transport(vox_http_client_req_t* req) {
     if (!req) return;
     if (req->is_tls) {
         if (req->tls && !vox_handle_is_closing((vox_handle_t*)req->tls)) {
-            vox_handle_close((vox_handle_t*)req->tls, NULL);
+            vox_handle_close((vox_handle_t*)req->tls, transport_on_closed);
         }
     } else {
         if (req->tcp && !vox_handle_is_closing((vox_handle_t*)req->tcp)) {
-            vox_handle_close((vox_handle_t*)req->tcp, NULL);
+            vox_handle_close((vox_handle_t*)req->tcp, transport_on_closed);
+        }
+    }
+}
+
+/* ===== 连接池 ===== */
+
+static void conn_set_idle(vox_tcp_t* tcp, vox_tls_t* tls, bool idle) {
+    /* 空闲连接不计入 loop 活跃句柄，避免连接池阻止 loop 退出 */
+    vox_handle_t* handles[2] = { (vox_handle_t*)tls, tls ? (vox_handle_t*)tls->tcp : (vox_handle_t*)tcp };
+    for (int i = 0; i < 2; i++) {
+        if (!handles[i]) continue;
+        if (idle) {
+            vox_handle_deactivate(handles[i]);
+        } else {
+            vox_handle_activate(handles[i]);
+        }
+    }
+}
+
+static void conn_free(vox_http_client_conn_t* conn) {
+    vox_http_client_pool_t* pool = conn->pool;
+    vox_list_remove(&pool->idle, &conn->node);
+    if (conn->tls) {
+        vox_handle_set_data((vox_handle_t*)conn->tls, NULL);
+        if (!vox_handle_is_closing((vox_handle_t*)conn->tls)) {
+            vox_handle_close((vox_handle_t*)conn->tls, transport_on_closed);
+        }
+    } else if (conn->tcp) {
+        vox_handle_set_data((vox_handle_t*)conn->tcp, NULL);
+        if (!vox_handle_is_closing((vox_handle_t*)conn->tcp)) {
+            vox_handle_close((vox_handle_t*)conn->tcp, transport_on_closed);
+        }
+    }
+    vox_mpool_free(pool->mpool, conn->host);
+    vox_mpool_free(pool->mpool, conn);
+}
+
+/* 空闲期间收到任何数据或 EOF/错误都说明连接不可再用（服务端关闭或协议错乱） */
+static void conn_idle_tcp_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void* user_data) {
+    (void)tcp;
+    (void)nread;
+    (void)buf;
+    vox_http_client_conn_t* conn = (vox_http_client_conn_t*)user_data;
+    if (conn) conn_free(conn);
+}
+
+static void conn_idle_tls_read_cb(vox_tls_t* tls, ssize_t nread, const void* buf, void* user_data) {
+    (void)tls;
+    (void)nread;
+    (void)buf;
+    vox_http_client_conn_t* conn = (vox_http_client_conn_t*)user_data;
+    if (conn) conn_free(conn);
+}
+
+static bool conn_is_expired(const vox_http_client_conn_t* conn, uint64_t now) {
+    vox_handle_t* h = conn->tls ? (vox_handle_t*)conn->tls : (vox_handle_t*)conn->tcp;
+    if (!h || vox_handle_is_closing(h)) return true;
+    return now - conn->idle_since >= conn->idle_timeout_us;
+}
+
+static bool conn_matches(const vox_http_client_conn_t* conn, const vox_http_client_url_t* url, vox_ssl_context_t* ssl_ctx) {
+    if (conn->scheme != url->scheme || conn->port != url->port) return false;
+    if (url->scheme == VOX_HTTP_CLIENT_SCHEME_HTTPS && conn->ssl_ctx != ssl_ctx) return false;
+    return strcasecmp(conn->host, url->host) == 0;
+}
+
+static void pool_evict_expired(vox_http_client_pool_t* pool) {
+    uint64_t now = vox_loop_now(pool->loop);
+    vox_list_node_t* pos;
+    vox_list_node_t* n;
+    vox_list_for_each_safe(pos, n, &pool->idle) {
+        vox_http_client_conn_t* conn = vox_container_of(pos, vox_http_client_conn_t, node);
+        if (conn_is_expired(conn, now)) conn_free(conn);
+    }
+}
+
+static void pool_idle_timer_cb(vox_timer_t* timer, void* user_data);
+
+/* 按最早到期的空闲连接重新安排清理定时器，连接池为空时停止。
+ * 各 client 的 idle_timeout 可能不同，放回顺序不等于到期顺序，需遍历 */
+static void pool_schedule_evict(vox_http_client_pool_t* pool) {
+    if (vox_list_empty(&pool->idle)) {
+        if (vox_timer_is_active(&pool->idle_timer)) vox_timer_stop(&pool->idle_timer);
+        return;
+    }
+    uint64_t now = vox_loop_now(pool->loop);
+    uint64_t left_us = UINT64_MAX;
+    vox_list_node_t* pos;
+    vox_list_for_each(pos, &pool->idle) {
+        vox_http_client_conn_t* conn = vox_container_of(pos, vox_http_client_conn_t, node);
+        uint64_t idle = now - conn->idle_since;
+        uint64_t left = idle < conn->idle_timeout_us ? conn->idle_timeout_us - idle : 0;
+        if (left < left_us) left_us = left;
+    }
+    vox_timer_start(&pool->idle_timer, (left_us + 999) / 1000, 0, pool_idle_timer_cb, pool);
+}
+
+static void pool_idle_timer_cb(vox_timer_t* timer, void* user_data) {
+    (void)timer;
+    vox_http_client_pool_t* pool = (vox_http_client_pool_t*)user_data;
+    pool_evict_expired(pool);
+    pool_schedule_evict(pool);
+}
+
+/* 销毁连接池（loop 扩展数据的 cleanup）：loop 不会再运行，直接销毁句柄而不经关闭回调 */
+static void pool_cleanup(vox_loop_t* loop, void* data) {
+    (void)loop;
+    vox_http_client_pool_t* pool = (vox_http_client_pool_t*)data;
+    while (!vox_list_empty(&pool->idle)) {
+        vox_http_client_conn_t* conn = vox_container_of(vox_list_pop_front(&pool->idle), vox_http_client_conn_t, node);
+        if (conn->tls) {
+            vox_handle_set_data((vox_handle_t*)conn->tls, NULL);
+            vox_tls_destroy(conn->tls);
+        } else if (conn->tcp) {
+            vox_handle_set_data((vox_handle_t*)conn->tcp, NULL);
+            vox_tcp_destroy(conn->tcp);
         }
+        vox_mpool_free(pool->mpool, conn->host);
+        vox_mpool_free(pool->mpool, conn);
     }
+    vox_timer_destroy(&pool->idle_timer);
+    vox_mpool_free(pool->mpool, pool);
+}
+
+static vox_http_client_pool_t* pool_get(vox_loop_t* loop) {
+    vox_http_client_pool_t* pool = (vox_http_client_pool_t*)vox_loop_get_ext(loop, &client_pool_key);
+    if (pool) return pool;
+
+    vox_mpool_t* mpool = vox_loop_get_mpool(loop);
+    pool = (vox_http_client_pool_t*)vox_mpool_alloc(mpool, sizeof(*pool));
+    if (!pool) return NULL;
+    memset(pool, 0, sizeof(*pool));
+    pool->loop = loop;
+    pool->mpool = mpool;
+    vox_list_init(&pool->idle);
+    if (vox_timer_init(&pool->idle_timer, loop) != 0 || vox_timer_set_weak(&pool->idle_timer, true) != 0) {
+        vox_mpool_free(mpool, pool);
+        return NULL;
+    }
+    if (vox_loop_set_ext(loop, &client_pool_key, pool, pool_cleanup) != 0) {
+        vox_timer_destroy(&pool->idle_timer);
+        vox_mpool_free(mpool, pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/* 取出一个可用的空闲连接（优先最近放回的），成功后 req->tcp/tls 指向该连接 */
+static bool pool_checkout(vox_http_client_req_t* req) {
+    vox_http_client_pool_t* pool = req->client->pool;
+    if (!req->client->keep_alive || vox_list_empty(&pool->idle)) return false;
+    pool_evict_expired(pool);
+
+    vox_list_node_t* pos = pool->idle.head.prev;
+    while (pos != &pool->idle.head) {
+        vox_http_client_conn_t* conn = vox_container_of(pos, vox_http_client_conn_t, node);
+        pos = pos->prev;
+        if (!conn_matches(conn, &req->url, req->request.ssl_ctx)) continue;
+
+        vox_list_remove(&pool->idle, &conn->node);
+        if (conn->tls) {
+            vox_tls_read_stop(conn->tls);
+            vox_handle_set_data((vox_handle_t*)conn->tls, req);
+        } else {
+            vox_tcp_read_stop(conn->tcp);
+            vox_handle_set_data((vox_handle_t*)conn->tcp, req);
+        }
+        conn_set_idle(conn->tcp, conn->tls, false);
+        req->tcp = conn->tcp;
+        req->tls = conn->tls;
+        req->reused = true;
+        vox_mpool_free(pool->mpool, conn->host);
+        vox_mpool_free(pool->mpool, conn);
+        pool_schedule_evict(pool);
+        return true;
+    }
+    return false;
+}
+
+/* 将请求的连接放回连接池；失败时关闭连接 */
+static void pool_checkin(vox_http_client_req_t* req) {
+    vox_http_client_t* client = req->client;
+    vox_http_client_pool_t* pool = client->pool;
+    vox_handle_t* h = req->is_tls ? (vox_handle_t*)req->tls : (vox_handle_t*)req->tcp;
+    if (!h || vox_handle_is_closing(h)) return;
+
+    pool_evict_expired(pool);
+
+    /* 同一目标超过上限时淘汰最旧的空闲连接 */
+    size_t same = 0;
+    vox_http_client_conn_t* oldest = NULL;
+    vox_list_node_t* pos;
+    vox_list_for_each(pos, &pool->idle) {
+        vox_http_client_conn_t* c = vox_container_of(pos, vox_http_client_conn_t, node);
+        if (conn_matches(c, &req->url, req->request.ssl_ctx)) {
+            if (!oldest) oldest = c;
+            same++;
+        }
+    }
+    if (same >= client->max_idle_per_host && oldest) {
+        conn_free(oldest);
+    }
+
+    vox_http_client_conn_t* conn = (vox_http_client_conn_t*)vox_mpool_alloc(pool->mpool, sizeof(*conn));
+    size_t host_len = strlen(req->url.host);
+    char* host = conn ? (char*)vox_mpool_alloc(pool->mpool, host_len + 1) : NULL;
+    if (!conn || !host) {
+        if (conn) vox_mpool_free(pool->mpool, conn);
+        req_close_transport(req);
+        return;
+    }
+    memset(conn, 0, sizeof(*conn));
+    memcpy(host, req->url.host, host_len + 1);
+    conn->pool = pool;
+    conn->scheme = req->url.scheme;
+    conn->host = host;
+    conn->port = req->url.port;
+    conn->ssl_ctx = req->request.ssl_ctx;
+    conn->tcp = req->tcp;
+    conn->tls = req->tls;
+    conn->idle_since = vox_loop_now(pool->loop);
+    conn->idle_timeout_us = client->idle_timeout_us;
+
+    int rc;
+    if (req->is_tls) {
+        vox_tls_read_stop(req->tls);
+        vox_handle_set_data((vox_handle_t*)req->tls, conn);
+        rc = vox_tls_read_start(req->tls, NULL, conn_idle_tls_read_cb);
+    } else {
+        vox_tcp_read_stop(req->tcp);
+        vox_handle_set_data((vox_handle_t*)req->tcp, conn);
+        rc = vox_tcp_read_start(req->tcp, NULL, conn_idle_tcp_read_cb);
+    }
+    req->tcp = NULL;
+    req->tls = NULL;
+
+    vox_list_push_back(&pool->idle, &conn->node);
+    if (rc != 0) {
+        conn_free(conn);
+        return;
+    }
+    conn_set_idle(conn->tcp, conn->tls, true);
+    /* 新连接可能比当前定时的连接更早到期（idle_timeout 更短） */
+    pool_schedule_evict(pool);
 }
 
 static int url_copy_part(vox_mpool_t* mpool, const char* src, size_t len, char** out_cstr) {
@@ -271,7 +565,8 @@ static int build_request_bytes(vox_http_client_req_t* req) {
         if (vox_string_append_format(req->out, "Host: %s\r\n", req->url.host) < 0) return -1;
     }
     if (!has_conn) {
-        if (vox_string_append(req->out, "Connection: close\r\n") != 0) return -1;
+        const char* conn_hdr = req->client->keep_alive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+        if (vox_string_append(req->out, conn_hdr) != 0) return -1;
     }
     if (vox_string_append(req->out, "User-Agent: voxlib\r\n") != 0) return -1;
     if (vox_string_append(req->out, "Accept: */*\r\n") != 0) return -1;
@@ -310,6 +605,7 @@ static int on_message_begin(void* p) {
     req->headers_notified = false;
     req->is_gzip_encoded = false;
     req->response_connection_close = false;
+    req->response_started = true;
     vox_string_clear(req->cur_h_name);
     vox_string_clear(req->cur_h_value);
     if (req->compressed_body) {
@@ -487,11 +783,26 @@ static int on_message_complete(void* p) {
         vox_dns_getaddrinfo_destroy(req->dns_req);
         req->dns_req = NULL;
     }
+    /* HTTP/1.1 且双方都未要求 close 时连接可复用；是否放回连接池在 feed_parser 中决定（需确认无多余数据） */
+    req->reusable = req->client->keep_alive &&
+                    !req->response_connection_close &&
+                    !vox_http_parser_is_upgrade(parser) &&
+                    vox_http_parser_get_http_major(parser) == 1 &&
+                    vox_http_parser_get_http_minor(parser) >= 1;
+    if (req->reusable && req->request.headers) {
+        for (size_t i = 0; i < req->request.header_count; i++) {
+            const vox_http_client_header_t* h = &req->request.headers[i];
+            if (h->name && h->value && ci_eq(h->name, "Connection") && value_is_close(h->value, strlen(h->value))) {
+                req->reusable = false;
+                break;
+            }
+        }
+    }
     if (req->cbs.on_complete) {
         req->cbs.on_complete(req, 0, req->user_data);
     }
-    /* 仅当响应头 Connection 等于 close 时关闭连接 */
-    if (req->response_connection_close) {
+    /* 响应头 Connection: close 时关闭连接 */
+    if (!req->reusable) {
         req_close_transport(req);
     }
     return 0;
@@ -543,22 +854,64 @@ static void tls_read_cb(vox_tls_t* tls, ssize_t nread, const void* buf, void* us
 static void tls_connect_cb(vox_tls_t* tls, int status, void* user_data);
 
 static int feed_parser(vox_http_client_req_t* req, const char* data, size_t len) {
-    size_t off = 0;
-    while (off < len && !req->done) {
-        ssize_t n = vox_http_parser_execute(req->parser, data + off, len - off);
-        if (n < 0) {
-            req_fail(req, vox_http_parser_get_error(req->parser));
-            return -1;
-        }
-        if (n == 0) break;
-        off += (size_t)n;
-        if (vox_http_parser_is_complete(req->parser)) {
-            break;
+    /* 解析器缓存全部输入；返回值包含之前缓存的字节（响应跨多次读取时），只有超出部分来自本次 data */
+    size_t buffered = vox_http_parser_get_buffered(req->parser);
+    ssize_t n = vox_http_parser_execute(req->parser, data, len);
+    if (n < 0) {
+        req_fail(req, vox_http_parser_get_error(req->parser));
+        return -1;
+    }
+    if (req->reusable) {
+        size_t used = (size_t)n > buffered ? (size_t)n - buffered : 0;
+        req->reusable = false;
+        /* 响应之后还有多余数据时连接状态不可信，直接关闭 */
+        if (used == len) {
+            pool_checkin(req);
+        } else {
+            req_close_transport(req);
         }
     }
     return 0;
 }
 
+/* 读到 EOF：以 EOF 结束的响应体在此完成，连接已被对端关闭，不能放回连接池 */
+static void feed_eof(vox_http_client_req_t* req) {
+    if (!req->done && vox_http_parser_finish(req->parser) != 0) {
+        req_fail(req, "connection closed");
+        return;
+    }
+    if (!req->done) {
+        req_fail(req, "connection closed");
+        return;
+    }
+    req->reusable = false;
+    req_close_transport(req);
+}
+
+static bool method_is_idempotent(vox_http_method_t m) {
+    return m == VOX_HTTP_METHOD_GET || m == VOX_HTTP_METHOD_HEAD || m == VOX_HTTP_METHOD_PUT ||
+           m == VOX_HTTP_METHOD_DELETE || m == VOX_HTTP_METHOD_OPTIONS || m == VOX_HTTP_METHOD_TRACE;
+}
+
+static int req_start_connect(vox_http_client_req_t* req);
+
+/* 复用的空闲连接可能已被服务端关闭：尚未收到任何响应数据时，幂等请求改用新连接重试一次 */
+static bool req_retry_if_stale(vox_http_client_req_t* req) {
+    if (!req->reused || req->response_started || !method_is_idempotent(req->request.method)) {
+        return false;
+    }
+    vox_handle_t* h = req->is_tls ? (vox_handle_t*)req->tls : (vox_handle_t*)req->tcp;
+    if (h) vox_handle_set_data(h, NULL);
+    req_close_transport(req);
+    req->reused = false;
+    req->tcp = NULL;
+    req->tls = NULL;
+    if (req_start_connect(req) != 0) {
+        req_fail(req, "reconnect failed");
+    }
+    return true;
+}
+
 static void tcp_connect_cb(vox_tcp_t* tcp, int status, void* user_data) {
     (void)tcp;
     vox_http_client_req_t* req = (vox_http_client_req_t*)user_data;
@@ -580,11 +933,24 @@ static void tcp_connect_cb(vox_tcp_t* tcp, int status, void* user_data) {
     }
 }
 
+/* 复用连接：在下一轮 loop 迭代中直接发送请求（保证回调不在 vox_http_client_request 内同步触发） */
+static void reused_send_cb(vox_loop_t* loop, void* user_data) {
+    (void)loop;
+    vox_http_client_req_t* req = (vox_http_client_req_t*)user_data;
+    if (!req || req->done || req->cancelled) return;
+    if (req->is_tls) {
+        tls_connect_cb(req->tls, 0, req);
+    } else {
+        tcp_connect_cb(req->tcp, 0, req);
+    }
+}
+
 static void tcp_write_cb(vox_tcp_t* tcp, int status, void* user_data) {
     (void)tcp;
     vox_http_client_req_t* req = (vox_http_client_req_t*)user_data;
     if (!req || req->done || req->cancelled) return;
     if (status != 0) {
+        if (req_retry_if_stale(req)) return;
         req_fail(req, "tcp write callback error");
         return;
     }
@@ -599,16 +965,15 @@ static void tcp_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void* us
     vox_http_client_req_t* req = (vox_http_client_req_t*)user_data;
     if (!req || req->done || req->cancelled) return;
 
+    if (nread <= 0 && req_retry_if_stale(req)) {
+        return;
+    }
     if (nread < 0) {
         req_fail(req, "tcp read error");
         return;
     }
     if (nread == 0) {
-        /* EOF：用于响应体 identity-eof */
-        (void)vox_http_parser_execute(req->parser, NULL, 0);
-        if (!req->done) {
-            req_fail(req, "connection closed");
-        }
+        feed_eof(req);
         return;
     }
     feed_parser(req, (const char*)buf, (size_t)nread);
@@ -640,6 +1005,7 @@ static void tls_write_cb(vox_tls_t* tls, int status, void* user_data) {
     vox_http_client_req_t* req = (vox_http_client_req_t*)user_data;
     if (!req || req->done || req->cancelled) return;
     if (status != 0) {
+        if (req_retry_if_stale(req)) return;
         req_fail(req, "tls write callback error");
         return;
     }
@@ -654,15 +1020,15 @@ static void tls_read_cb(vox_tls_t* tls, ssize_t nread, const void* buf, void* us
     vox_http_client_req_t* req = (vox_http_client_req_t*)user_data;
     if (!req || req->done || req->cancelled) return;
 
+    if (nread <= 0 && req_retry_if_stale(req)) {
+        return;
+    }
     if (nread < 0) {
         req_fail(req, "tls read error");
         return;
     }
     if (nread == 0) {
-        (void)vox_http_parser_execute(req->parser, NULL, 0);
-        if (!req->done) {
-            req_fail(req, "connection closed");
-        }
+        feed_eof(req);
         return;
     }
     feed_parser(req, (const char*)buf, (size_t)nread);
@@ -701,6 +1067,10 @@ static void dns_cb(vox_dns_getaddrinfo_t* dns, int status, const vox_dns_addrinf
 }
 
 vox_http_client_t* vox_http_client_create(vox_loop_t* loop) {
+    return vox_http_client_create_with_config(loop, NULL);
+}
+
+vox_http_client_t* vox_http_client_create_with_config(vox_loop_t* loop, const vox_http_client_config_t* config) {
     if (!loop) return NULL;
     vox_mpool_t* mpool = vox_loop_get_mpool(loop);
     vox_http_client_t* c = (vox_http_client_t*)vox_mpool_alloc(mpool, sizeof(*c));
@@ -708,12 +1078,37 @@ vox_http_client_t* vox_http_client_create(vox_loop_t* loop) {
     memset(c, 0, sizeof(*c));
     c->loop = loop;
     c->mpool = mpool;
+    c->keep_alive = !(config && config->disable_keep_alive);
+    c->max_idle_per_host = (config && config->max_idle_per_host > 0)
+                               ? config->max_idle_per_host : VOX_HTTP_CLIENT_DEFAULT_MAX_IDLE_PER_HOST;
+    c->idle_timeout_us = (uint64_t)((config && config->idle_timeout_ms > 0)
+                               ? config->idle_timeout_ms : VOX_HTTP_CLIENT_DEFAULT_IDLE_TIMEOUT_MS) * 1000u;
+    c->pool = pool_get(loop);
+    if (!c->pool) {
+        vox_mpool_free(mpool, c);
+        return NULL;
+    }
     return c;
 }
 
 void vox_http_client_destroy(vox_http_client_t* client) {
-    (void)client;
-    /* client 自身来自 loop mpool：无需显式 free；调用者通常随 loop 一起回收 */
+    if (!client) return;
+    /* client 自身来自 loop mpool：无需显式 free；调用者通常随 loop 一起回收。
+     * 空闲连接属于 loop 的连接池，可能被同一 loop 上的其他 client 复用，不在这里关闭 */
+}
+
+size_t vox_http_client_idle_count(const vox_http_client_t* client) {
+    return client ? vox_list_size(&client->pool->idle) : 0;
+}
+
+void vox_http_client_close_idle(vox_http_client_t* client) {
+    if (!client) return;
+    vox_http_client_pool_t* pool = client->pool;
+    while (!vox_list_empty(&pool->idle)) {
+        vox_http_client_conn_t* conn = vox_container_of(vox_list_first(&pool->idle), vox_http_client_conn_t, node);
+        conn_free(conn);
+    }
+    pool_schedule_evict(pool);
 }
 
 static vox_http_client_req_t* req_create(vox_http_client_t* client) {
@@ -792,6 +1187,8 @@ int vox_http_client_request(vox_http_client_t* client,
 
     /* copy request struct */
     req->request = *request;
+    /* HEAD 的响应不带消息体，即使声明了 Content-Length */
+    vox_http_parser_set_skip_body(req->parser, request->method == VOX_HTTP_METHOD_HEAD);
 
     if (parse_url(req->mpool, request->url, &req->url) != 0) {
         req_fail(req, "invalid url");
@@ -804,6 +1201,28 @@ int vox_http_client_request(vox_http_client_t* client,
         return -1;
     }
 
+    /* 优先复用连接池中的空闲连接 */
+    if (pool_checkout(req)) {
+        if (vox_loop_queue_work(req->loop, reused_send_cb, req) != 0) {
+            req_fail(req, "queue work failed");
+            return -1;
+        }
+        if (out_req) *out_req = req;
+        return 0;
+    }
+
+    if (req_start_connect(req) != 0) {
+        return -1;
+    }
+
+    if (out_req) *out_req = req;
+    return 0;
+}
+
+/* 新建连接：创建 transport、解析 DNS 并启动连接超时 */
+static int req_start_connect(vox_http_client_req_t* req) {
+    const vox_http_client_request_t* request = &req->request;
+
     /* init transport */
     if (req->is_tls) {
         req->tls = vox_tls_create(req->loop, request->ssl_ctx);
@@ -811,6 +1230,8 @@ int vox_http_client_request(vox_http_client_t* client,
             req_fail(req, "tls create failed");
             return -1;
         }
+        /* SNI 与按主机的会话恢复 */
+        vox_tls_set_hostname(req->tls, req->url.host);
         vox_handle_set_data((vox_handle_t*)req->tls, req);
     } else {
         req->tcp = vox_tcp_create(req->loop);
@@ -844,8 +1265,6 @@ int vox_http_client_request(vox_http_client_t* client,
             return -1;
         }
     }
-
-    if (out_req) *out_req = req;
     return 0;
 }
 
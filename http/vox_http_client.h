@@ -6,7 +6,9 @@
  * - 解析响应复用 vox_http_parser（VOX_HTTP_PARSER_TYPE_RESPONSE）
  *
  * 说明：
- * - 当前实现面向 HTTP/1.1 单次请求（默认 Connection: close）
+ * - HTTP/1.1 keep-alive：响应完成后连接按 (scheme, host, port, ssl_ctx) 放回 client 的空闲连接池，
+ *   后续同目标请求直接复用，省去 DNS 与 TCP/TLS 握手
+ * - client 与 loop 一一绑定，同一 client 上的所有请求（包括 vox_coroutine_http_*_await）共享该连接池
  * - HTTPS 依赖 vox_tls（当前后端为 OpenSSL Memory BIO）
  */
  
@@ -75,9 +77,37 @@ typedef struct {
     void (*on_error)(vox_http_client_req_t* req, const char* message, void* user_data);
 } vox_http_client_callbacks_t;
 
+/* client 配置（连接池：每个 loop 一个，同一 loop 上的 client 共享，按 (scheme, host, port, ssl_ctx) 复用） */
+typedef struct {
+    bool disable_keep_alive;           /* true 时每个请求发送 Connection: close 且不复用连接 */
+    uint32_t max_idle_per_host;        /* 本 client 放回连接时每个目标最多保留的空闲连接数；0 表示默认 4 */
+    uint32_t idle_timeout_ms;          /* 本 client 放回的空闲连接最长保留时间（毫秒）；0 表示默认 30000 */
+} vox_http_client_config_t;
+
 vox_http_client_t* vox_http_client_create(vox_loop_t* loop);
+
+/**
+ * 使用配置创建 client
+ * @param config 配置，NULL 表示使用默认配置（启用 keep-alive 连接池）
+ */
+vox_http_client_t* vox_http_client_create_with_config(vox_loop_t* loop, const vox_http_client_config_t* config);
+
+/**
+ * 销毁 client
+ * 空闲连接属于 loop 的连接池，留给同一 loop 上的其他 client 复用，随 loop 销毁关闭
+ */
 void vox_http_client_destroy(vox_http_client_t* client);
 
+/**
+ * 获取 client 所在 loop 的连接池中的空闲连接数
+ */
+size_t vox_http_client_idle_count(const vox_http_client_t* client);
+
+/**
+ * 关闭 client 所在 loop 的连接池中的所有空闲连接（不影响进行中的请求）
+ */
+void vox_http_client_close_idle(vox_http_client_t* client);
+
 /**
  * 发起一个请求
  * @return 成功返回0，失败返回-1
@@ -95,7 +125,8 @@ void vox_http_client_cancel(vox_http_client_req_t* req);
 
 /**
  * 关闭当前请求的底层连接（不触发 on_error）。
- * 响应完成后若服务端未送 Connection: close，可调用此接口主动关连接以便 loop 能退出（VOX_RUN_DEFAULT 需无活跃句柄）。
+ * 在 on_complete 中调用时，该连接不会放回连接池。
+ * 放回连接池的空闲连接不计入 loop 的活跃句柄，不会阻止 VOX_RUN_DEFAULT 退出。
  */
 void vox_http_client_close(vox_http_client_req_t* req);
 
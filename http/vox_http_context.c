@@ -13,13 +13,16 @@ static const char* vox_http_reason_phrase(int status) {
         case 200: return "OK";
         case 201: return "Created";
         case 204: return "No Content";
+        case 206: return "Partial Content";
         case 301: return "Moved Permanently";
         case 302: return "Found";
+        case 304: return "Not Modified";
         case 400: return "Bad Request";
         case 401: return "Unauthorized";
         case 403: return "Forbidden";
         case 404: return "Not Found";
         case 405: return "Method Not Allowed";
+        case 416: return "Range Not Satisfiable";
         case 500: return "Internal Server Error";
         default: return "OK";
     }
@@ -58,7 +61,8 @@ size_t vox_http_context_get_handler_count(const vox_http_context_t* ctx) {
 }
 
 void vox_http_context_resume_at(vox_http_context_t* ctx, size_t at_index) {
-    if (!ctx) return;
+    /* 只有 defer 中的请求可以恢复：finish 之后请求已结束，处理链的引用已释放 */
+    if (!ctx || !ctx->deferred || at_index > ctx->handler_count) return;
     ctx->aborted = false;
     ctx->index = at_index;
 }
@@ -95,29 +99,44 @@ bool vox_http_context_is_deferred(const vox_http_context_t* ctx) {
 }
 
 int vox_http_context_finish(vox_http_context_t* ctx) {
-    if (!ctx || !ctx->conn) return -1;
+    if (!ctx || (!ctx->conn && !ctx->h2_stream)) return -1;
     /* 仅在 defer 模式下允许 finish；避免重复发送 */
     if (!ctx->deferred) return -1;
 
+    if (ctx->h2_stream) {
+        /* HTTP/2：流发送响应后可能立即被释放（ctx 随之失效），先取出 conn 并清除 deferred */
+        void* conn = ctx->conn;
+        if (conn && vox_http_conn_is_closing_or_closed(conn)) {
+            ctx->deferred = false;
+            vox_http_conn_defer_release(conn);
+            return -1;
+        }
+        ctx->deferred = false;
+        int h2_rc = vox_http2_stream_send_response(ctx->h2_stream);
+        if (conn) vox_http_conn_defer_release(conn);
+        return h2_rc;
+    }
+
     /* HTTP 场景：若连接已关闭/正在关闭，直接视为取消并释放 defer hold，避免 UAF/泄漏 */
-    if (vox_http_conn_is_closing_or_closed(ctx->conn)) {
+    void* conn = ctx->conn;
+    if (vox_http_conn_is_closing_or_closed(conn)) {
         ctx->deferred = false;
-        vox_http_conn_defer_release(ctx->conn);
+        vox_http_conn_defer_release(conn);
         return -1;
     }
 
-    /* 只有当真正进入发送流程后才清除 deferred，避免发送失败后无法重试 */
-    int rc = vox_http_conn_send_response(ctx->conn);
+    /* 只有当真正进入发送流程后才清除 deferred（由 send_response 完成），避免发送失败后无法重试；
+     * 成功后 ctx 所属的请求可能已写出并被复用，不再访问 ctx */
+    int rc = vox_http_conn_send_response(conn, ctx);
     if (rc == 0) {
-        ctx->deferred = false;
-        vox_http_conn_defer_release(ctx->conn);
+        vox_http_conn_defer_release(conn);
         return 0;
     }
 
     /* 发送失败但连接已关闭：同样按取消处理，释放 defer hold */
-    if (vox_http_conn_is_closing_or_closed(ctx->conn)) {
+    if (vox_http_conn_is_closing_or_closed(conn)) {
         ctx->deferred = false;
-        vox_http_conn_defer_release(ctx->conn);
+        vox_http_conn_defer_release(conn);
     }
     return rc;
 }
@@ -210,24 +229,10 @@ static int vox_http_kv_push(vox_mpool_t* mpool, vox_vector_t* vec, const char* k
     if (!vec || !k || !v) return -1;
     size_t nlen = strlen(k);
     size_t vlen = strlen(v);
-    vox_http_header_t* kv = (vox_http_header_t*)vox_mpool_alloc(mpool, sizeof(vox_http_header_t));
+    vox_http_header_t* kv = vox_http_header_alloc(mpool, k, nlen, v, vlen);
     if (!kv) return -1;
-    char* ncopy = (char*)vox_mpool_alloc(mpool, nlen + 1);
-    char* vcopy = (char*)vox_mpool_alloc(mpool, vlen + 1);
-    if (!ncopy || !vcopy) {
-        vox_mpool_free(mpool, kv);
-        if (ncopy) vox_mpool_free(mpool, ncopy);
-        if (vcopy) vox_mpool_free(mpool, vcopy);
-        return -1;
-    }
-    memcpy(ncopy, k, nlen + 1);
-    memcpy(vcopy, v, vlen + 1);
-    kv->name = (vox_strview_t){ ncopy, nlen };
-    kv->value = (vox_strview_t){ vcopy, vlen };
     if (vox_vector_push(vec, kv) != 0) {
         vox_mpool_free(mpool, kv);
-        vox_mpool_free(mpool, ncopy);
-        vox_mpool_free(mpool, vcopy);
         return -1;
     }
     return 0;
@@ -264,6 +269,19 @@ int vox_http_context_send_file(vox_http_context_t* ctx, void* file, int64_t offs
     ctx->sendfile_file = (vox_file_t*)file;
     ctx->sendfile_offset = offset;
     ctx->sendfile_count = count;
+    ctx->sendfile_release = NULL;
+    ctx->sendfile_release_data = NULL;
+    return 0;
+}
+
+int vox_http_context_send_file_shared(vox_http_context_t* ctx, vox_file_t* file, int64_t offset, size_t count,
+                                      void (*release)(void* data), void* data) {
+    if (!ctx || !file || !release) return -1;
+    ctx->sendfile_file = file;
+    ctx->sendfile_offset = offset;
+    ctx->sendfile_count = count;
+    ctx->sendfile_release = release;
+    ctx->sendfile_release_data = data;
     return 0;
 }
 
@@ -284,6 +302,65 @@ static int vox_http_has_header(const vox_vector_t* headers, const char* name) {
     return 0;
 }
 
+#ifdef VOX_USE_ZLIB
+/* 已压缩格式不再 gzip */
+static bool vox_http_gzip_type_compressible(const vox_vector_t* headers) {
+    if (!headers) return true;
+    size_t cnt = vox_vector_size((vox_vector_t*)headers);
+    for (size_t i = 0; i < cnt; i++) {
+        vox_http_header_t* kv = (vox_http_header_t*)vox_vector_get((vox_vector_t*)headers, i);
+        if (!kv || !vox_http_strieq(kv->name.ptr, kv->name.len, "Content-Type", 12)) continue;
+        const char* v = kv->value.ptr;
+        size_t n = kv->value.len;
+        if ((n >= 6 && strncasecmp(v, "image/", 6) == 0 && !(n >= 13 && strncasecmp(v, "image/svg+xml", 13) == 0)) ||
+            (n >= 6 && strncasecmp(v, "video/", 6) == 0) ||
+            (n >= 6 && strncasecmp(v, "audio/", 6) == 0) ||
+            (n >= 15 && strncasecmp(v, "application/zip", 15) == 0) ||
+            (n >= 16 && strncasecmp(v, "application/gzip", 16) == 0) ||
+            (n >= 24 && strncasecmp(v, "application/octet-stream", 24) == 0)) {
+            return false;
+        }
+        return true;
+    }
+    return true;
+}
+
+static const vox_http_header_t* vox_http_find_header(const vox_vector_t* headers, const char* name) {
+    if (!headers) return NULL;
+    size_t nlen = strlen(name);
+    size_t cnt = vox_vector_size((vox_vector_t*)headers);
+    for (size_t i = 0; i < cnt; i++) {
+        vox_http_header_t* kv = (vox_http_header_t*)vox_vector_get((vox_vector_t*)headers, i);
+        if (kv && vox_http_strieq(kv->name.ptr, kv->name.len, name, nlen)) return kv;
+    }
+    return NULL;
+}
+
+/* gzip sink：追加到字符串 */
+static int vox_http_gzip_sink_string(const void* data, size_t len, void* user_data) {
+    return vox_string_append_data((vox_string_t*)user_data, data, len);
+}
+
+/* gzip sink：写成一个 chunked 帧 */
+static int vox_http_gzip_sink_chunk(const void* data, size_t len, void* user_data) {
+    vox_string_t* out = (vox_string_t*)user_data;
+    if (vox_string_append_format(out, "%zx\r\n", len) < 0) return -1;
+    if (vox_string_append_data(out, data, len) != 0) return -1;
+    return vox_string_append(out, "\r\n");
+}
+
+/* 压缩整个 body 到 sink（使用 loop 的 z_stream 池） */
+static int vox_http_gzip_body(vox_loop_t* loop, const void* data, size_t len,
+                              vox_http_gzip_sink_cb sink, void* user_data) {
+    vox_http_gzip_stream_t* zs = vox_http_gzip_stream_acquire(loop);
+    if (!zs) return -1;
+    int rc = vox_http_gzip_stream_write(zs, data, len, sink, user_data);
+    if (rc == 0) rc = vox_http_gzip_stream_finish(zs, sink, user_data);
+    vox_http_gzip_stream_release(zs);
+    return rc;
+}
+#endif /* VOX_USE_ZLIB */
+
 int vox_http_context_build_response(const vox_http_context_t* ctx, vox_string_t* out) {
     if (!ctx || !out) return -1;
 
@@ -294,50 +371,82 @@ int vox_http_context_build_response(const vox_http_context_t* ctx, vox_string_t*
     int minor = ctx->req.http_minor; /* 默认 1.0/1.1 按请求版本 */
     
 #ifdef VOX_USE_ZLIB
-    /* 用于 gzip 压缩的变量（需要在函数作用域内） */
+    /* gzip 方式：
+     * - 带 ETag：按 (ETag, 路径) 查压缩缓存，未命中则压缩一次并写入缓存，以 Content-Length 发送
+     * - HTTP/1.1 无 ETag：流式压缩，直接写成 chunked 帧（不保留整份压缩副本）
+     * - HTTP/1.0 无 ETag：压缩到临时缓冲，以 Content-Length 发送 */
     bool use_gzip = false;
+    bool gzip_chunked = false;
+    const void* gzip_data = NULL;
+    size_t gzip_len = 0;
     vox_string_t* compressed_body = NULL;
+    const vox_http_header_t* etag = NULL;
 #endif /* VOX_USE_ZLIB */
 
     vox_http_append_status_line(out, major, minor, status);
 
-    /* 101 Switching Protocols：不应附带 Content-Length/Content-Type/body */
-    if (status != 101) {
+    /* 101 Switching Protocols：不应附带 Content-Length/Content-Type/body；
+     * 304 Not Modified：不带 body，也不自动补 Content-Length/Content-Type（保留用户显式设置的头） */
+    if (status != 101 && status != 304) {
         size_t body_len = ctx->res.body ? vox_string_length(ctx->res.body) : 0;
         if (ctx->sendfile_file && ctx->sendfile_count > 0)
             body_len = ctx->sendfile_count;
 
 #ifdef VOX_USE_ZLIB
-        /* 仅当响应体在 res.body 中时才压缩（sendfile 时内容不在内存，无法压缩） */
-        if (body_len > 0 && !(ctx->sendfile_file && ctx->sendfile_count > 0) &&
-            ctx->res.body && !vox_http_has_header((const vox_vector_t*)ctx->res.headers, "Content-Encoding")) {
-            size_t actual_len = vox_string_length(ctx->res.body);
-            if (actual_len == body_len) {
-                /* 检查客户端是否支持 gzip */
-                if (vox_http_supports_gzip(ctx->req.headers)) {
-                    /* 只压缩较大的响应体（通常 > 256 字节才有意义） */
-                    if (body_len >= 1024) {
+        /* 仅当响应体在 res.body 中时才压缩（sendfile 时内容不在内存，无法压缩）；
+         * 只压缩较大的响应体（>= 1024 字节才有意义） */
+        const vox_vector_t* rh = (const vox_vector_t*)ctx->res.headers;
+        if (body_len >= 1024 && !(ctx->sendfile_file && ctx->sendfile_count > 0) &&
+            ctx->res.body && vox_string_length(ctx->res.body) == body_len &&
+            !vox_http_has_header(rh, "Content-Encoding") &&
+            !vox_http_has_header(rh, "Content-Length") &&
+            vox_http_gzip_type_compressible(rh) &&
+            ctx->loop && vox_http_supports_gzip(ctx->req.headers)) {
+            const void* body = vox_string_data(ctx->res.body);
+            etag = vox_http_find_header(rh, "ETag");
+            /* 超过 cache_max_entry_bytes 的响应体不进缓存，按无 ETag 的方式压缩 */
+            if (etag && etag->value.len > 0 && vox_http_gzip_cache_accepts(ctx->loop, body_len)) {
+                /* 缓存键：ETag + '\0' + 路径 */
+                char key[512];
+                size_t klen = etag->value.len + 1 + ctx->req.path.len;
+                if (klen <= sizeof(key)) {
+                    memcpy(key, etag->value.ptr, etag->value.len);
+                    key[etag->value.len] = '\0';
+                    if (ctx->req.path.len > 0)
+                        memcpy(key + etag->value.len + 1, ctx->req.path.ptr, ctx->req.path.len);
+                    if (vox_http_gzip_cache_get(ctx->loop, key, klen, &gzip_data, &gzip_len) != 0) {
                         compressed_body = vox_string_create(ctx->mpool);
-                        if (compressed_body) {
-                            int compress_result = vox_http_gzip_compress(ctx->mpool,
-                                                                        vox_string_data(ctx->res.body),
-                                                                        body_len,
-                                                                        compressed_body);
-                            if (compress_result == 0) {
-                                size_t compressed_len = vox_string_length(compressed_body);
-                                /* 只有当压缩后确实更小才使用 */
-                                if (compressed_len < body_len) {
-                                    use_gzip = true;
-                                    body_len = compressed_len;
-                                }
-                            }
+                        if (compressed_body &&
+                            vox_http_gzip_body(ctx->loop, body, body_len, vox_http_gzip_sink_string, compressed_body) == 0) {
+                            gzip_data = vox_string_data(compressed_body);
+                            gzip_len = vox_string_length(compressed_body);
+                            (void)vox_http_gzip_cache_put(ctx->loop, key, klen, gzip_data, gzip_len);
+                        } else {
+                            gzip_data = NULL;
                         }
                     }
                 }
+            } else if (major == 1 && minor >= 1) {
+                gzip_chunked = true;
+            } else {
+                compressed_body = vox_string_create(ctx->mpool);
+                if (compressed_body &&
+                    vox_http_gzip_body(ctx->loop, body, body_len, vox_http_gzip_sink_string, compressed_body) == 0) {
+                    gzip_data = vox_string_data(compressed_body);
+                    gzip_len = vox_string_length(compressed_body);
+                }
+            }
+            /* 只有当压缩后确实更小才使用（流式压缩无法预知大小） */
+            if (gzip_chunked || (gzip_data && gzip_len < body_len)) {
+                use_gzip = true;
+                body_len = gzip_len;
             }
         }
-#endif /* VOX_USE_ZLIB */
 
+        if (gzip_chunked) {
+            vox_string_append(out, "Transfer-Encoding: chunked\r\n");
+        } else
+#endif /* VOX_USE_ZLIB */
         /* 自动添加 Content-Length（若未显式设置） */
         if (!vox_http_has_header((const vox_vector_t*)ctx->res.headers, "Content-Length")) {
             vox_string_append_format(out, "Content-Length: %zu\r\n", body_len);
@@ -348,9 +457,12 @@ int vox_http_context_build_response(const vox_http_context_t* ctx, vox_string_t*
         }
 
 #ifdef VOX_USE_ZLIB
-        /* 如果使用了 gzip 压缩，添加 Content-Encoding 头 */
+        /* 如果使用了 gzip 压缩，添加 Content-Encoding/Vary 头 */
         if (use_gzip) {
             vox_string_append(out, "Content-Encoding: gzip\r\n");
+            if (!vox_http_has_header((const vox_vector_t*)ctx->res.headers, "Vary")) {
+                vox_string_append(out, "Vary: Accept-Encoding\r\n");
+            }
         }
 #endif /* VOX_USE_ZLIB */
     }
@@ -361,6 +473,15 @@ int vox_http_context_build_response(const vox_http_context_t* ctx, vox_string_t*
         for (size_t i = 0; i < cnt; i++) {
             vox_http_header_t* kv = (vox_http_header_t*)vox_vector_get((vox_vector_t*)ctx->res.headers, i);
             if (!kv || !kv->name.ptr || !kv->value.ptr) continue;
+#ifdef VOX_USE_ZLIB
+            /* 压缩后的表示与原始字节不同，强 ETag 降为弱 ETag */
+            if (use_gzip && kv == etag && !(kv->value.len >= 2 && kv->value.ptr[0] == 'W' && kv->value.ptr[1] == '/')) {
+                vox_string_append_format(out, "%.*s: W/%.*s\r\n",
+                                         (int)kv->name.len, kv->name.ptr,
+                                         (int)kv->value.len, kv->value.ptr);
+                continue;
+            }
+#endif /* VOX_USE_ZLIB */
             vox_string_append_format(out, "%.*s: %.*s\r\n",
                                      (int)kv->name.len, kv->name.ptr,
                                      (int)kv->value.len, kv->value.ptr);
@@ -368,20 +489,26 @@ int vox_http_context_build_response(const vox_http_context_t* ctx, vox_string_t*
     }
 
     vox_string_append(out, "\r\n");
-    if (status != 101) {
+    if (status != 101 && status != 304) {
         size_t body_len = ctx->res.body ? vox_string_length(ctx->res.body) : 0;
         if (ctx->sendfile_file && ctx->sendfile_count > 0)
             body_len = 0;
         if (body_len > 0) {
 #ifdef VOX_USE_ZLIB
-            /* 如果使用了压缩，写入压缩后的数据 */
-            if (use_gzip && compressed_body) {
-                size_t compressed_len = vox_string_length(compressed_body);
-                vox_string_append_data(out, vox_string_data(compressed_body), compressed_len);
-                /* compressed_body 由 mpool 管理，无需手动释放 */
+            if (gzip_chunked) {
+                /* 分片压缩，每段输出直接写成一个 chunk */
+                if (vox_http_gzip_body(ctx->loop, vox_string_data(ctx->res.body), body_len,
+                                       vox_http_gzip_sink_chunk, out) != 0) {
+                    return -1;
+                }
+                vox_string_append(out, "0\r\n\r\n");
+            } else if (use_gzip) {
+                vox_string_append_data(out, gzip_data, gzip_len);
             } else {
                 vox_string_append_data(out, vox_string_data(ctx->res.body), body_len);
             }
+            /* compressed_body 由 mpool 管理，这里提前归还 */
+            if (compressed_body) vox_string_destroy(compressed_body);
 #else
             vox_string_append_data(out, vox_string_data(ctx->res.body), body_len);
 #endif /* VOX_USE_ZLIB */
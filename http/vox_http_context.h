@@ -74,7 +74,9 @@ bool vox_http_context_is_aborted(const vox_http_context_t* ctx);
 size_t vox_http_context_get_index(const vox_http_context_t* ctx);
 /** handler 链长度（用于校验 resume_at 的 at_index 合法性） */
 size_t vox_http_context_get_handler_count(const vox_http_context_t* ctx);
-/** 恢复执行链：置 aborted=false 并设 index，之后可调用 next() 继续执行后续 handler */
+/** 恢复执行链：置 aborted=false 并设 index，之后可调用 next() 继续执行后续 handler
+ * 仅对 defer 中的请求有效（finish 之后或 at_index 越界时忽略）；defer 期间 engine 保留该请求的
+ * 路由处理链，路由被热更新替换后仍按原链执行 */
 void vox_http_context_resume_at(vox_http_context_t* ctx, size_t at_index);
 
 /**
@@ -140,7 +142,7 @@ int vox_http_context_write(vox_http_context_t* ctx, const void* data, size_t len
 int vox_http_context_write_cstr(vox_http_context_t* ctx, const char* cstr);
 
 /**
- * 使用 sendfile 发送文件体（仅非 TLS 连接；TLS 时回退为读入 body）
+ * 使用 sendfile 发送文件体（明文连接，或发送方向已卸载到内核 TLS 的连接；其余 TLS 连接回退为读入 body）
  * 调用后不得关闭 file，由框架在发送完成后关闭。
  * @param ctx HTTP 上下文
  * @param file vox_file_open 打开的文件（只读），可为 NULL 表示不使用 sendfile
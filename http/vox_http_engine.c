@@ -5,6 +5,8 @@
 #include "vox_http_engine.h"
 #include "vox_http_internal.h"
 #include "../vox_log.h"
+#include "../vox_atomic.h"
+#include <stddef.h>
 #include <string.h>
 
 struct vox_http_group {
@@ -16,11 +18,52 @@ struct vox_http_group {
 struct vox_http_engine {
     vox_loop_t* loop;
     vox_mpool_t* mpool;
+    vox_mpool_t* chain_pool;         /* 路由处理链（线程安全：可能在其他线程经 vox_ebr 回收） */
     vox_http_router_t* router;
     vox_vector_t* global_middleware; /* element: vox_http_handler_cb* */
+    vox_vector_t* mounts;            /* element: vox_http_mount_t*，按前缀长度降序 */
+    vox_vector_t* middleware_data;   /* element: vox_http_middleware_data_t* */
     void* user_data;
 };
 
+/* 中间件绑定到 engine 的状态（handler 本身无法携带状态） */
+typedef struct {
+    vox_http_handler_cb middleware;
+    void* data;
+} vox_http_middleware_data_t;
+
+/* 前缀挂载点 */
+typedef struct {
+    char* prefix;        /* 不含末尾 '/'，"/" 挂载记为空串 */
+    size_t prefix_len;
+    vox_http_handler_cb* handlers; /* 全局中间件 + handler */
+    size_t handler_count;
+    void* user_data;
+} vox_http_mount_t;
+
+/* 路由处理链：router 持有一个引用，defer 中的请求各持有一个，最后一个引用释放时归还 chain_pool */
+typedef struct {
+    vox_mpool_t* pool;
+    vox_atomic_int_t refs;
+    vox_http_handler_cb handlers[];
+} vox_http_chain_t;
+
+static vox_http_chain_t* vox_http_chain_of(vox_http_handler_cb* handlers) {
+    return (vox_http_chain_t*)((char*)handlers - offsetof(vox_http_chain_t, handlers));
+}
+
+static void vox_http_chain_unref(vox_http_chain_t* chain) {
+    if (vox_atomic_int_decrement(&chain->refs) == 0) {
+        vox_mpool_free(chain->pool, chain);
+    }
+}
+
+/* router 经 vox_ebr 退休被替换的链时调用：放掉 router 的引用 */
+static void vox_http_chain_free(void* ptr, void* user_data) {
+    VOX_UNUSED(user_data);
+    vox_http_chain_unref(vox_http_chain_of((vox_http_handler_cb*)ptr));
+}
+
 static int vox_http_vec_push_handler(vox_mpool_t* mpool, vox_vector_t* vec, vox_http_handler_cb cb) {
     if (!mpool || !vec || !cb) return -1;
     vox_http_handler_cb* slot = (vox_http_handler_cb*)vox_mpool_alloc(mpool, sizeof(vox_http_handler_cb));
@@ -43,18 +86,29 @@ vox_http_engine_t* vox_http_engine_create(vox_loop_t* loop) {
     memset(e, 0, sizeof(*e));
     e->loop = loop;
     e->mpool = mpool;
+    vox_mpool_config_t pool_config = {0};
+    pool_config.thread_safe = 1;
+    e->chain_pool = vox_mpool_create_with_config(&pool_config);
     e->router = vox_http_router_create(mpool);
     e->global_middleware = vox_vector_create(mpool);
-    if (!e->router || !e->global_middleware) {
+    if (!e->chain_pool || !e->router || !e->global_middleware) {
         /* mpool 分配的对象不做深度释放 */
+        vox_http_router_destroy(e->router);
+        if (e->chain_pool) vox_mpool_destroy(e->chain_pool);
         return NULL;
     }
+    /* 热更新替换下来的处理链由 router 在发布后经 vox_ebr 回收 */
+    vox_http_router_set_handlers_free(e->router, vox_http_chain_free, e->chain_pool);
     return e;
 }
 
 void vox_http_engine_destroy(vox_http_engine_t* engine) {
-    VOX_UNUSED(engine);
-    /* engine 使用 mpool 分配；此处不做深度释放 */
+    if (!engine) return;
+    /* engine 其余对象使用 mpool 分配，不做深度释放；router 持有私有内存池与快照 */
+    vox_http_router_destroy(engine->router);
+    engine->router = NULL;
+    vox_mpool_destroy(engine->chain_pool);
+    engine->chain_pool = NULL;
 }
 
 int vox_http_engine_use(vox_http_engine_t* engine, vox_http_handler_cb handler) {
@@ -147,8 +201,12 @@ static int vox_http_build_chain(vox_mpool_t* mpool,
     size_t total = gcnt + gcnt2 + handler_count;
     if (total == 0) return -1;
 
-    vox_http_handler_cb* chain = (vox_http_handler_cb*)vox_mpool_alloc(mpool, total * sizeof(vox_http_handler_cb));
-    if (!chain) return -1;
+    vox_http_chain_t* c = (vox_http_chain_t*)vox_mpool_alloc(mpool, sizeof(vox_http_chain_t) +
+                                                                     total * sizeof(vox_http_handler_cb));
+    if (!c) return -1;
+    c->pool = mpool;
+    vox_atomic_int_init(&c->refs, 1);
+    vox_http_handler_cb* chain = c->handlers;
 
     size_t idx = 0;
     for (size_t i = 0; i < gcnt; i++) chain[idx++] = *(vox_http_handler_cb*)vox_vector_get(global_mw, i);
@@ -168,10 +226,15 @@ int vox_http_engine_add_route(vox_http_engine_t* engine,
     if (!engine || !path || !handlers || handler_count == 0) return -1;
     vox_http_handler_cb* chain = NULL;
     size_t chain_count = 0;
-    if (vox_http_build_chain(engine->mpool, engine->global_middleware, NULL, handlers, handler_count, &chain, &chain_count) != 0) {
+    if (vox_http_build_chain(engine->chain_pool, engine->global_middleware, NULL, handlers, handler_count, &chain, &chain_count) != 0) {
+        return -1;
+    }
+    if (vox_http_router_add(engine->router, method, path, chain, chain_count) != 0) {
+        /* router 未接管，放掉构建时的引用 */
+        vox_http_chain_unref(vox_http_chain_of(chain));
         return -1;
     }
-    return vox_http_router_add(engine->router, method, path, chain, chain_count);
+    return 0;
 }
 
 int vox_http_group_add_route(vox_http_group_t* group,
@@ -188,10 +251,152 @@ int vox_http_group_add_route(vox_http_group_t* group,
 
     vox_http_handler_cb* chain = NULL;
     size_t chain_count = 0;
-    if (vox_http_build_chain(engine->mpool, engine->global_middleware, group->middleware, handlers, handler_count, &chain, &chain_count) != 0) {
+    if (vox_http_build_chain(engine->chain_pool, engine->global_middleware, group->middleware, handlers, handler_count, &chain, &chain_count) != 0) {
+        vox_mpool_free(engine->mpool, full);
         return -1;
     }
-    return vox_http_router_add(engine->router, method, full, chain, chain_count);
+    /* router 复制路径，拼接结果用完即释放 */
+    int rc = vox_http_router_add(engine->router, method, full, chain, chain_count);
+    vox_mpool_free(engine->mpool, full);
+    if (rc != 0) vox_http_chain_unref(vox_http_chain_of(chain));
+    return rc;
+}
+
+int vox_http_engine_mount(vox_http_engine_t* engine, const char* prefix, vox_http_handler_cb handler, void* user_data) {
+    if (!engine || !prefix || prefix[0] != '/' || !handler) return -1;
+    if (!engine->mounts) {
+        engine->mounts = vox_vector_create(engine->mpool);
+        if (!engine->mounts) return -1;
+    }
+
+    size_t plen = strlen(prefix);
+    while (plen > 0 && prefix[plen - 1] == '/') plen--;
+
+    vox_http_mount_t* m = (vox_http_mount_t*)vox_mpool_alloc(engine->mpool, sizeof(vox_http_mount_t));
+    if (!m) return -1;
+    memset(m, 0, sizeof(*m));
+    m->prefix = (char*)vox_mpool_alloc(engine->mpool, plen + 1);
+    if (!m->prefix) {
+        vox_mpool_free(engine->mpool, m);
+        return -1;
+    }
+    memcpy(m->prefix, prefix, plen);
+    m->prefix[plen] = '\0';
+    m->prefix_len = plen;
+    m->user_data = user_data;
+    if (vox_http_build_chain(engine->mpool, engine->global_middleware, NULL, &handler, 1,
+                             &m->handlers, &m->handler_count) != 0) {
+        vox_mpool_free(engine->mpool, m->prefix);
+        vox_mpool_free(engine->mpool, m);
+        return -1;
+    }
+
+    /* 按前缀长度降序插入，匹配时第一个命中即为最长前缀 */
+    size_t cnt = vox_vector_size(engine->mounts);
+    size_t pos = cnt;
+    for (size_t i = 0; i < cnt; i++) {
+        vox_http_mount_t* other = (vox_http_mount_t*)vox_vector_get(engine->mounts, i);
+        if (other->prefix_len < plen) {
+            pos = i;
+            break;
+        }
+    }
+    if (vox_vector_insert(engine->mounts, pos, m) != 0) {
+        vox_http_chain_unref(vox_http_chain_of(m->handlers));
+        vox_mpool_free(engine->mpool, m->prefix);
+        vox_mpool_free(engine->mpool, m);
+        return -1;
+    }
+    return 0;
+}
+
+int vox_http_engine_match_mount(vox_http_engine_t* engine, const char* path, size_t path_len,
+                                vox_http_handler_cb** handlers, size_t* handler_count,
+                                void** user_data, size_t* prefix_len) {
+    if (!engine || !engine->mounts || !path) return -1;
+    size_t cnt = vox_vector_size(engine->mounts);
+    for (size_t i = 0; i < cnt; i++) {
+        vox_http_mount_t* m = (vox_http_mount_t*)vox_vector_get(engine->mounts, i);
+        if (path_len < m->prefix_len || memcmp(path, m->prefix, m->prefix_len) != 0) continue;
+        /* 前缀须落在路径段边界：/static 匹配 /static 与 /static/x，不匹配 /staticx */
+        if (path_len > m->prefix_len && path[m->prefix_len] != '/') continue;
+        if (handlers) *handlers = m->handlers;
+        if (handler_count) *handler_count = m->handler_count;
+        if (user_data) *user_data = m->user_data;
+        if (prefix_len) *prefix_len = m->prefix_len;
+        return 0;
+    }
+    return -1;
+}
+
+/* 返回 true 表示执行的是路由处理链（可被热更新替换） */
+static bool vox_http_engine_run(vox_http_engine_t* engine, vox_http_context_t* ctx,
+                                vox_http_route_match_t* match) {
+    vox_http_request_t* req = &ctx->req;
+    int match_rc = -1;
+    if (engine->router) {
+        match_rc = vox_http_router_match(engine->router, req->method, req->path.ptr, req->path.len,
+                                         ctx->mpool, match);
+    }
+
+    vox_http_handler_cb* mount_handlers = NULL;
+    size_t mount_count = 0;
+    void* mount_data = NULL;
+    size_t mount_prefix = 0;
+    if (match_rc != 0 && req->path.ptr &&
+        vox_http_engine_match_mount(engine, req->path.ptr, req->path.len,
+                                    &mount_handlers, &mount_count, &mount_data, &mount_prefix) == 0) {
+        /* 前缀挂载（如静态目录）：handler 通过 user_data 取得挂载对象 */
+        ctx->handlers = mount_handlers;
+        ctx->handler_count = mount_count;
+        ctx->params = NULL;
+        ctx->param_count = 0;
+        ctx->user_data = mount_data;
+        ctx->mount_path.ptr = req->path.ptr + mount_prefix;
+        ctx->mount_path.len = req->path.len - mount_prefix;
+    } else if (match_rc != 0) {
+        /* 404 */
+        ctx->handlers = NULL;
+        ctx->handler_count = 0;
+        ctx->params = NULL;
+        ctx->param_count = 0;
+        vox_http_context_status(ctx, 404);
+        vox_http_context_write_cstr(ctx, "404 Not Found");
+        return false;
+    } else {
+        ctx->handlers = match->handlers;
+        ctx->handler_count = match->handler_count;
+        ctx->params = match->params;
+        ctx->param_count = match->param_count;
+    }
+
+    /* 执行 middleware chain */
+    vox_http_context_next(ctx);
+    if (!ctx->deferred && !ctx->res.status) {
+        /* 若 handler 未设置状态，默认 200 */
+        ctx->res.status = 200;
+    }
+    return match_rc == 0;
+}
+
+void vox_http_engine_dispatch(vox_http_engine_t* engine, vox_http_context_t* ctx,
+                              vox_http_route_match_t* match) {
+    /* 处理链在临界区内执行完（defer 会中止后续 handler），热更新替换的链不会在执行中被回收；
+     * defer 的请求之后还可能 resume_at/next，离开临界区前为它保留一个引用 */
+    vox_http_router_enter(engine->router);
+    bool routed = vox_http_engine_run(engine, ctx, match);
+    if (routed && ctx->deferred && !ctx->chain_pin && ctx->handlers && ctx->handlers == match->handlers) {
+        vox_http_chain_t* chain = vox_http_chain_of(ctx->handlers);
+        vox_atomic_int_increment(&chain->refs);
+        ctx->chain_pin = chain;
+    }
+    vox_http_router_exit(engine->router);
+}
+
+void vox_http_engine_release_chain(vox_http_context_t* ctx) {
+    if (!ctx || !ctx->chain_pin) return;
+    vox_http_chain_unref((vox_http_chain_t*)ctx->chain_pin);
+    ctx->chain_pin = NULL;
 }
 
 int vox_http_engine_get(vox_http_engine_t* engine, const char* path, vox_http_handler_cb* handlers, size_t handler_count) {
@@ -207,6 +412,24 @@ int vox_http_group_post(vox_http_group_t* group, const char* path, vox_http_hand
     return vox_http_group_add_route(group, VOX_HTTP_METHOD_POST, path, handlers, handler_count);
 }
 
+void vox_http_engine_begin_update(vox_http_engine_t* engine) {
+    if (engine) vox_http_router_begin(engine->router);
+}
+
+int vox_http_engine_commit_update(vox_http_engine_t* engine) {
+    return engine ? vox_http_router_commit(engine->router) : -1;
+}
+
+void vox_http_engine_reset(vox_http_engine_t* engine) {
+    if (!engine) return;
+    vox_http_router_clear(engine->router);
+    size_t cnt = vox_vector_size(engine->global_middleware);
+    for (size_t i = 0; i < cnt; i++) {
+        vox_mpool_free(engine->mpool, vox_vector_get(engine->global_middleware, i));
+    }
+    vox_vector_clear(engine->global_middleware);
+}
+
 vox_http_router_t* vox_http_engine_get_router(vox_http_engine_t* engine) {
     return engine ? engine->router : NULL;
 }
@@ -231,3 +454,38 @@ void* vox_http_engine_get_user_data(const vox_http_engine_t* engine) {
     return engine ? engine->user_data : NULL;
 }
 
+int vox_http_engine_set_middleware_data(vox_http_engine_t* engine, vox_http_handler_cb middleware, void* data) {
+    if (!engine || !middleware) return -1;
+    if (!engine->middleware_data) {
+        engine->middleware_data = vox_vector_create(engine->mpool);
+        if (!engine->middleware_data) return -1;
+    }
+    size_t n = vox_vector_size(engine->middleware_data);
+    for (size_t i = 0; i < n; i++) {
+        vox_http_middleware_data_t* d = (vox_http_middleware_data_t*)vox_vector_get(engine->middleware_data, i);
+        if (d && d->middleware == middleware) {
+            d->data = data;
+            return 0;
+        }
+    }
+    vox_http_middleware_data_t* d = (vox_http_middleware_data_t*)vox_mpool_alloc(engine->mpool, sizeof(*d));
+    if (!d) return -1;
+    d->middleware = middleware;
+    d->data = data;
+    if (vox_vector_push(engine->middleware_data, d) != 0) {
+        vox_mpool_free(engine->mpool, d);
+        return -1;
+    }
+    return 0;
+}
+
+void* vox_http_engine_get_middleware_data(const vox_http_engine_t* engine, vox_http_handler_cb middleware) {
+    if (!engine || !engine->middleware_data) return NULL;
+    size_t n = vox_vector_size(engine->middleware_data);
+    for (size_t i = 0; i < n; i++) {
+        const vox_http_middleware_data_t* d = (const vox_http_middleware_data_t*)vox_vector_get(engine->middleware_data, i);
+        if (d && d->middleware == middleware) return d->data;
+    }
+    return NULL;
+}
+
@@ -50,6 +50,27 @@ int vox_http_engine_post(vox_http_engine_t* engine, const char* path, vox_http_h
 int vox_http_group_get(vox_http_group_t* group, const char* path, vox_http_handler_cb* handlers, size_t handler_count);
 int vox_http_group_post(vox_http_group_t* group, const char* path, vox_http_handler_cb* handlers, size_t handler_count);
 
+/**
+ * 前缀挂载：路由未命中时按最长前缀匹配挂载点（如静态文件目录）
+ * - prefix 必须以 '/' 开头，按路径段匹配（"/static" 匹配 "/static/a.js"，不匹配 "/staticx"）
+ * - 执行链为注册时的全局中间件 + handler；handler 内通过 vox_http_context_get_user_data 取得 user_data
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_engine_mount(vox_http_engine_t* engine, const char* prefix, vox_http_handler_cb handler, void* user_data);
+
+/**
+ * 热更新：begin/commit 之间的路由修改对正在处理的请求不可见，commit 时整体发布
+ * - 典型用法：begin -> reset -> use/add_route ... -> commit，在线替换全部路由与中间件
+ * - engine 的中间件与处理链从 loop 内存池分配，须在 engine 所属 loop 线程调用；
+ *   其他线程可直接对 vox_http_engine_get_router 返回的 router 使用 add/remove/begin/commit
+ * - 被替换的处理链在新路由发布后经 vox_ebr 延迟回收，正在执行它的请求不受影响
+ */
+void vox_http_engine_begin_update(vox_http_engine_t* engine);
+int vox_http_engine_commit_update(vox_http_engine_t* engine);
+
+/* 清空所有路由与全局中间件（已创建的 group 保留其前缀与组内中间件） */
+void vox_http_engine_reset(vox_http_engine_t* engine);
+
 /* 内部：访问 router 与全局 middleware（server 模块会用到） */
 vox_http_router_t* vox_http_engine_get_router(vox_http_engine_t* engine);
 vox_vector_t* vox_http_engine_get_global_middleware(vox_http_engine_t* engine);
@@ -60,6 +81,14 @@ vox_loop_t* vox_http_engine_get_loop(vox_http_engine_t* engine);
 void vox_http_engine_set_user_data(vox_http_engine_t* engine, void* user_data);
 void* vox_http_engine_get_user_data(const vox_http_engine_t* engine);
 
+/**
+ * 中间件的 engine 级状态：以中间件函数为键，重复设置覆盖（不释放旧值）
+ * 中间件内通过 vox_http_context_get_engine 取得 engine 后查询；不受 reset/热更新影响
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_engine_set_middleware_data(vox_http_engine_t* engine, vox_http_handler_cb middleware, void* data);
+void* vox_http_engine_get_middleware_data(const vox_http_engine_t* engine, vox_http_handler_cb middleware);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,11 +1,15 @@
 /*
  * vox_http_gzip.c - HTTP gzip 压缩实现
+ * 流式压缩使用 loop 级 z_stream 池（通过 vox_loop 扩展数据挂载）与 ETag 压缩缓存
  */
 
 #include "vox_http_gzip.h"
 #include "vox_http_internal.h"
 #include "../vox_log.h"
+#include "../vox_list.h"
+#include "../vox_htable.h"
 #include <string.h>
+#include <stddef.h>
 
 #ifdef VOX_USE_ZLIB
 
@@ -228,6 +232,282 @@ int vox_http_is_gzip_encoded(const char* header_name, size_t header_name_len,
     return 0;
 }
 
+/* ===== 流式压缩 ===== */
+
+#define VOX_HTTP_GZIP_DEFAULT_LEVEL          6
+#define VOX_HTTP_GZIP_DEFAULT_IDLE_STREAMS   8
+#define VOX_HTTP_GZIP_DEFAULT_CACHE_BYTES    (8u * 1024 * 1024)
+#define VOX_HTTP_GZIP_DEFAULT_ENTRY_BYTES    (1024u * 1024)
+#define VOX_HTTP_GZIP_OUT_SIZE               16384
+
+typedef struct {
+    vox_loop_t* loop;
+    vox_mpool_t* mpool;
+    vox_http_gzip_config_t config;
+    vox_list_t idle;                 /* 空闲 vox_http_gzip_stream_t */
+    vox_htable_t* cache;             /* key -> gzip_cache_entry_t* */
+    vox_list_t lru;                  /* 表头为最近使用 */
+    size_t cache_bytes;
+    vox_http_gzip_stats_t stats;
+} gzip_pool_t;
+
+typedef struct {
+    vox_list_node_t node;
+    char* key;
+    size_t key_len;
+    void* data;
+    size_t len;
+} gzip_cache_entry_t;
+
+struct vox_http_gzip_stream {
+    vox_list_node_t node;
+    gzip_pool_t* pool;
+    z_stream zs;
+    bool failed;
+    size_t out_len;
+    uint8_t out[VOX_HTTP_GZIP_OUT_SIZE];
+};
+
+/* vox_loop 扩展数据 key */
+static const char gzip_pool_key = 0;
+
+/* zlib 内部状态分配走 loop 的内存池 */
+static voidpf gzip_zalloc(voidpf opaque, uInt items, uInt size) {
+    return vox_mpool_alloc((vox_mpool_t*)opaque, (size_t)items * size);
+}
+
+static void gzip_zfree(voidpf opaque, voidpf address) {
+    vox_mpool_free((vox_mpool_t*)opaque, address);
+}
+
+static void gzip_config_apply_defaults(vox_http_gzip_config_t* c) {
+    if (c->level <= 0 || c->level > 9) c->level = VOX_HTTP_GZIP_DEFAULT_LEVEL;
+    if (c->max_idle_streams == 0) c->max_idle_streams = VOX_HTTP_GZIP_DEFAULT_IDLE_STREAMS;
+    if (c->cache_max_bytes == 0) c->cache_max_bytes = VOX_HTTP_GZIP_DEFAULT_CACHE_BYTES;
+    if (c->cache_max_entry_bytes == 0) c->cache_max_entry_bytes = VOX_HTTP_GZIP_DEFAULT_ENTRY_BYTES;
+}
+
+static void gzip_stream_free(vox_http_gzip_stream_t* s) {
+    deflateEnd(&s->zs);
+    vox_mpool_free(s->pool->mpool, s);
+}
+
+static void gzip_cache_entry_free(gzip_pool_t* pool, gzip_cache_entry_t* e) {
+    vox_htable_delete(pool->cache, e->key, e->key_len);
+    vox_list_remove(&pool->lru, &e->node);
+    pool->cache_bytes -= e->len;
+    vox_mpool_free(pool->mpool, e->data);
+    vox_mpool_free(pool->mpool, e->key);
+    vox_mpool_free(pool->mpool, e);
+}
+
+static void gzip_pool_clear(gzip_pool_t* pool) {
+    while (!vox_list_empty(&pool->idle)) {
+        gzip_stream_free(vox_container_of(vox_list_pop_front(&pool->idle), vox_http_gzip_stream_t, node));
+    }
+    while (!vox_list_empty(&pool->lru)) {
+        gzip_cache_entry_free(pool, vox_container_of(vox_list_first(&pool->lru), gzip_cache_entry_t, node));
+    }
+}
+
+static void gzip_pool_cleanup(vox_loop_t* loop, void* data) {
+    VOX_UNUSED(loop);
+    gzip_pool_t* pool = (gzip_pool_t*)data;
+    gzip_pool_clear(pool);
+    vox_htable_destroy(pool->cache);
+    vox_mpool_free(pool->mpool, pool);
+}
+
+static gzip_pool_t* gzip_pool_get(vox_loop_t* loop) {
+    if (!loop) return NULL;
+    gzip_pool_t* pool = (gzip_pool_t*)vox_loop_get_ext(loop, &gzip_pool_key);
+    if (pool) return pool;
+
+    vox_mpool_t* mpool = vox_loop_get_mpool(loop);
+    pool = (gzip_pool_t*)vox_mpool_alloc(mpool, sizeof(gzip_pool_t));
+    if (!pool) return NULL;
+    memset(pool, 0, sizeof(*pool));
+    pool->loop = loop;
+    pool->mpool = mpool;
+    gzip_config_apply_defaults(&pool->config);
+    vox_list_init(&pool->idle);
+    vox_list_init(&pool->lru);
+    pool->cache = vox_htable_create(mpool);
+    if (!pool->cache || vox_loop_set_ext(loop, &gzip_pool_key, pool, gzip_pool_cleanup) != 0) {
+        if (pool->cache) vox_htable_destroy(pool->cache);
+        vox_mpool_free(mpool, pool);
+        return NULL;
+    }
+    return pool;
+}
+
+int vox_http_gzip_configure(vox_loop_t* loop, const vox_http_gzip_config_t* config) {
+    gzip_pool_t* pool = gzip_pool_get(loop);
+    if (!pool) return -1;
+    gzip_pool_clear(pool);
+    memset(&pool->config, 0, sizeof(pool->config));
+    if (config) pool->config = *config;
+    gzip_config_apply_defaults(&pool->config);
+    return 0;
+}
+
+int vox_http_gzip_get_stats(vox_loop_t* loop, vox_http_gzip_stats_t* stats) {
+    if (!stats) return -1;
+    gzip_pool_t* pool = gzip_pool_get(loop);
+    if (!pool) return -1;
+    *stats = pool->stats;
+    stats->cache_entries = vox_list_size(&pool->lru);
+    stats->cache_bytes = pool->cache_bytes;
+    return 0;
+}
+
+vox_http_gzip_stream_t* vox_http_gzip_stream_acquire(vox_loop_t* loop) {
+    gzip_pool_t* pool = gzip_pool_get(loop);
+    if (!pool) return NULL;
+
+    if (!vox_list_empty(&pool->idle)) {
+        pool->stats.streams_reused++;
+        return vox_container_of(vox_list_pop_front(&pool->idle), vox_http_gzip_stream_t, node);
+    }
+
+    vox_http_gzip_stream_t* s = (vox_http_gzip_stream_t*)vox_mpool_alloc(pool->mpool, sizeof(vox_http_gzip_stream_t));
+    if (!s) return NULL;
+    memset(s, 0, offsetof(vox_http_gzip_stream_t, out));
+    s->pool = pool;
+    vox_list_node_init(&s->node);
+    s->zs.zalloc = gzip_zalloc;
+    s->zs.zfree = gzip_zfree;
+    s->zs.opaque = pool->mpool;
+    int ret = deflateInit2(&s->zs, pool->config.level, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK) {
+        VOX_LOG_ERROR("gzip deflateInit2 failed: %d", ret);
+        vox_mpool_free(pool->mpool, s);
+        return NULL;
+    }
+    pool->stats.streams_created++;
+    return s;
+}
+
+/* 执行 deflate，输出缓冲区写满时交给 sink */
+static int gzip_stream_run(vox_http_gzip_stream_t* s, int flush, vox_http_gzip_sink_cb sink, void* user_data) {
+    for (;;) {
+        s->zs.next_out = s->out + s->out_len;
+        s->zs.avail_out = (uInt)(sizeof(s->out) - s->out_len);
+        int ret = deflate(&s->zs, flush);
+        s->out_len = sizeof(s->out) - s->zs.avail_out;
+        if (ret == Z_STREAM_ERROR) {
+            VOX_LOG_ERROR("gzip deflate failed: %d", ret);
+            s->failed = true;
+            return -1;
+        }
+        if (s->out_len == sizeof(s->out) || (ret == Z_STREAM_END && s->out_len > 0)) {
+            if (sink(s->out, s->out_len, user_data) != 0) {
+                s->failed = true;
+                return -1;
+            }
+            s->out_len = 0;
+        }
+        if (ret == Z_STREAM_END) return 0;
+        if (flush == Z_NO_FLUSH && s->zs.avail_in == 0 && s->zs.avail_out > 0) return 0;
+    }
+}
+
+int vox_http_gzip_stream_write(vox_http_gzip_stream_t* zs, const void* data, size_t len,
+                               vox_http_gzip_sink_cb sink, void* user_data) {
+    if (!zs || !sink || zs->failed) return -1;
+    const uint8_t* p = (const uint8_t*)data;
+    while (len > 0) {
+        /* avail_in 为 uInt，按 1GB 分片喂入 */
+        size_t n = len > (1u << 30) ? (1u << 30) : len;
+        zs->zs.next_in = (Bytef*)p;
+        zs->zs.avail_in = (uInt)n;
+        if (gzip_stream_run(zs, Z_NO_FLUSH, sink, user_data) != 0) return -1;
+        p += n;
+        len -= n;
+    }
+    return 0;
+}
+
+int vox_http_gzip_stream_finish(vox_http_gzip_stream_t* zs, vox_http_gzip_sink_cb sink, void* user_data) {
+    if (!zs || !sink || zs->failed) return -1;
+    zs->zs.next_in = NULL;
+    zs->zs.avail_in = 0;
+    return gzip_stream_run(zs, Z_FINISH, sink, user_data);
+}
+
+void vox_http_gzip_stream_release(vox_http_gzip_stream_t* zs) {
+    if (!zs) return;
+    gzip_pool_t* pool = zs->pool;
+    zs->out_len = 0;
+    if (zs->failed || deflateReset(&zs->zs) != Z_OK ||
+        vox_list_size(&pool->idle) >= pool->config.max_idle_streams) {
+        gzip_stream_free(zs);
+        return;
+    }
+    vox_list_push_front(&pool->idle, &zs->node);
+}
+
+int vox_http_gzip_cache_get(vox_loop_t* loop, const char* key, size_t key_len,
+                            const void** data, size_t* len) {
+    gzip_pool_t* pool = gzip_pool_get(loop);
+    if (!pool || !key || !data || !len || pool->config.disable_cache) return -1;
+    gzip_cache_entry_t* e = (gzip_cache_entry_t*)vox_htable_get(pool->cache, key, key_len);
+    if (!e) {
+        pool->stats.cache_misses++;
+        return -1;
+    }
+    pool->stats.cache_hits++;
+    vox_list_remove(&pool->lru, &e->node);
+    vox_list_push_front(&pool->lru, &e->node);
+    *data = e->data;
+    *len = e->len;
+    return 0;
+}
+
+bool vox_http_gzip_cache_accepts(vox_loop_t* loop, size_t body_len) {
+    gzip_pool_t* pool = gzip_pool_get(loop);
+    return pool && !pool->config.disable_cache && body_len <= pool->config.cache_max_entry_bytes;
+}
+
+int vox_http_gzip_cache_put(vox_loop_t* loop, const char* key, size_t key_len,
+                            const void* data, size_t len) {
+    gzip_pool_t* pool = gzip_pool_get(loop);
+    if (!pool || !key || !data || len == 0 || pool->config.disable_cache) return -1;
+    /* 压缩数据不会大于可缓存的原始响应体上限，超出说明不可压缩，不占用缓存 */
+    if (len > pool->config.cache_max_bytes || len > pool->config.cache_max_entry_bytes) return -1;
+
+    gzip_cache_entry_t* old = (gzip_cache_entry_t*)vox_htable_get(pool->cache, key, key_len);
+    if (old) gzip_cache_entry_free(pool, old);
+    while (pool->cache_bytes + len > pool->config.cache_max_bytes && !vox_list_empty(&pool->lru)) {
+        gzip_cache_entry_free(pool, vox_container_of(vox_list_last(&pool->lru), gzip_cache_entry_t, node));
+    }
+
+    gzip_cache_entry_t* e = (gzip_cache_entry_t*)vox_mpool_alloc(pool->mpool, sizeof(gzip_cache_entry_t));
+    char* kcopy = (char*)vox_mpool_alloc(pool->mpool, key_len ? key_len : 1);
+    void* dcopy = vox_mpool_alloc(pool->mpool, len);
+    if (!e || !kcopy || !dcopy) {
+        if (e) vox_mpool_free(pool->mpool, e);
+        if (kcopy) vox_mpool_free(pool->mpool, kcopy);
+        if (dcopy) vox_mpool_free(pool->mpool, dcopy);
+        return -1;
+    }
+    memcpy(kcopy, key, key_len);
+    memcpy(dcopy, data, len);
+    e->key = kcopy;
+    e->key_len = key_len;
+    e->data = dcopy;
+    e->len = len;
+    if (vox_htable_set(pool->cache, kcopy, key_len, e) != 0) {
+        vox_mpool_free(pool->mpool, dcopy);
+        vox_mpool_free(pool->mpool, kcopy);
+        vox_mpool_free(pool->mpool, e);
+        return -1;
+    }
+    vox_list_push_front(&pool->lru, &e->node);
+    pool->cache_bytes += len;
+    return 0;
+}
+
 #else /* VOX_USE_ZLIB */
 
 int vox_http_gzip_compress(vox_mpool_t* mpool, const void* input, size_t input_len, vox_string_t* output) {
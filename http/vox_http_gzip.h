@@ -1,5 +1,10 @@
 /*
  * vox_http_gzip.h - HTTP gzip 压缩支持
+ *
+ * 流式压缩：
+ * - 每个 loop 维护一个已 deflateReset 的 z_stream 池，避免每个响应 deflateInit2/deflateEnd（约 256KB 状态分配）
+ * - 输入按分片压缩，输出经 sink 回调逐段交给调用方（响应路径直接写成 chunked 帧，不再保留整份压缩副本）
+ * - 带 ETag 的响应按 (ETag, 路径) 缓存压缩结果，命中时跳过压缩
  */
 
 #ifndef VOX_HTTP_GZIP_H
@@ -8,6 +13,9 @@
 #include "../vox_os.h"
 #include "../vox_string.h"
 #include "../vox_mpool.h"
+#include "../vox_loop.h"
+#include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +62,93 @@ int vox_http_gzip_decompress(vox_mpool_t* mpool, const void* input, size_t input
 int vox_http_is_gzip_encoded(const char* header_name, size_t header_name_len,
                               const char* header_value, size_t header_value_len);
 
+/* ===== 流式压缩（loop 级 z_stream 池 + ETag 压缩缓存） ===== */
+
+typedef struct vox_http_gzip_stream vox_http_gzip_stream_t;
+
+/* 压缩输出回调：返回0继续，返回-1中止压缩 */
+typedef int (*vox_http_gzip_sink_cb)(const void* data, size_t len, void* user_data);
+
+/* 配置（数值字段 0 表示使用默认值） */
+typedef struct {
+    int level;                      /* 压缩级别 1-9，默认 6 */
+    uint32_t max_idle_streams;      /* 每个 loop 保留的空闲 z_stream 数，默认 8 */
+    size_t cache_max_bytes;         /* ETag 压缩缓存总字节上限，默认 8MB */
+    size_t cache_max_entry_bytes;   /* 可缓存响应体（压缩前）大小上限，默认 1MB */
+    bool disable_cache;             /* true 时不缓存压缩结果 */
+} vox_http_gzip_config_t;
+
+/* 统计 */
+typedef struct {
+    uint64_t streams_created;       /* deflateInit2 次数 */
+    uint64_t streams_reused;        /* 从池中复用次数 */
+    uint64_t cache_hits;
+    uint64_t cache_misses;
+    size_t cache_entries;
+    size_t cache_bytes;
+} vox_http_gzip_stats_t;
+
+/**
+ * 配置 loop 的压缩池与缓存（会清空已有空闲流与缓存）
+ * @param loop 事件循环
+ * @param config 配置，NULL 表示默认配置
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_gzip_configure(vox_loop_t* loop, const vox_http_gzip_config_t* config);
+
+/**
+ * 获取 loop 的压缩统计
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_gzip_get_stats(vox_loop_t* loop, vox_http_gzip_stats_t* stats);
+
+/**
+ * 从 loop 的池中取一个 gzip 压缩流（池为空时新建）
+ * @return 成功返回压缩流，失败返回 NULL
+ */
+vox_http_gzip_stream_t* vox_http_gzip_stream_acquire(vox_loop_t* loop);
+
+/**
+ * 压缩一段输入，产生的输出（按内部缓冲区大小成段）交给 sink
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_gzip_stream_write(vox_http_gzip_stream_t* zs, const void* data, size_t len,
+                               vox_http_gzip_sink_cb sink, void* user_data);
+
+/**
+ * 结束压缩（写出 gzip 尾部），剩余输出交给 sink
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_gzip_stream_finish(vox_http_gzip_stream_t* zs, vox_http_gzip_sink_cb sink, void* user_data);
+
+/**
+ * 归还压缩流（重置后放回池，超出上限则释放）
+ */
+void vox_http_gzip_stream_release(vox_http_gzip_stream_t* zs);
+
+/**
+ * 查询 ETag 压缩缓存
+ * @param key 缓存键（通常为 ETag + 路径）
+ * @param data 输出：压缩数据（在下一次 put/configure 之前有效）
+ * @param len 输出：压缩数据长度
+ * @return 命中返回0，未命中返回-1
+ */
+int vox_http_gzip_cache_get(vox_loop_t* loop, const char* key, size_t key_len,
+                            const void** data, size_t* len);
+
+/**
+ * 响应体（压缩前）是否可进入 ETag 压缩缓存：缓存未禁用且不超过 cache_max_entry_bytes
+ * 不可缓存时调用方应直接流式压缩，避免大响应体挤出缓存
+ */
+bool vox_http_gzip_cache_accepts(vox_loop_t* loop, size_t body_len);
+
+/**
+ * 写入 ETag 压缩缓存（按 LRU 淘汰到总字节上限以内）
+ * @return 成功返回0，失败或超出上限（总上限或单项 cache_max_entry_bytes）返回-1
+ */
+int vox_http_gzip_cache_put(vox_loop_t* loop, const char* key, size_t key_len,
+                            const void* data, size_t len);
+
 #endif /* VOX_USE_ZLIB */
 
 #ifdef __cplusplus
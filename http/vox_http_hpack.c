@@ -0,0 +1,603 @@
+/*
+ * vox_http_hpack.c - HPACK 头部压缩实现
+ * 动态表为条目指针环形数组（最新条目索引 62），每个条目 name/value 一次分配；
+ * Huffman 解码按规范码的码长分组查找，每次取出一个完整符号
+ */
+
+#include "vox_http_hpack.h"
+#include <string.h>
+
+#define VOX_HPACK_STATIC_COUNT 61
+#define VOX_HPACK_ENTRY_OVERHEAD 32
+
+typedef struct {
+    const char* name;
+    const char* value;
+} vox_hpack_static_entry_t;
+
+/* RFC 7541 附录 A 静态表（索引 1..61） */
+static const vox_hpack_static_entry_t vox_hpack_static_table[VOX_HPACK_STATIC_COUNT] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+/* RFC 7541 附录 B：符号 0..256 的 Huffman 码（右对齐）与码长，256 为 EOS */
+static const uint32_t vox_hpack_huff_code[257] = {
+    0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5, 0xfffffe6, 0xfffffe7,
+    0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9, 0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec,
+    0xfffffed, 0xfffffee, 0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3,
+    0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9, 0xffffffa, 0xffffffb,
+    0x14, 0x3f8, 0x3f9, 0xffa, 0x1ff9, 0x15, 0xf8, 0x7fa,
+    0x3fa, 0x3fb, 0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18,
+    0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+    0x1e, 0x1f, 0x5c, 0xfb, 0x7ffc, 0x20, 0xffb, 0x3fc,
+    0x1ffa, 0x21, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a,
+    0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72,
+    0xfc, 0x73, 0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22,
+    0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5, 0x25, 0x26,
+    0x27, 0x6, 0x74, 0x75, 0x28, 0x29, 0x2a, 0x7,
+    0x2b, 0x76, 0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78,
+    0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd, 0x1ffd, 0xffffffc,
+    0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8, 0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9,
+    0x3fffd6, 0x7fffda, 0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf,
+    0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1, 0x7fffe2, 0x7fffe3,
+    0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5, 0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef,
+    0x3fffda, 0x1fffdd, 0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde,
+    0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf, 0x7fffeb, 0x7fffec,
+    0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2, 0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef,
+    0xfffea, 0x3fffe2, 0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1,
+    0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2, 0x3fffe8, 0x1ffffec,
+    0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde, 0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed,
+    0x7fff2, 0x1fffe3, 0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2,
+    0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3, 0x7ffffe4, 0x7ffffe5,
+    0xfffec, 0xfffff3, 0xfffed, 0x1fffe6, 0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3,
+    0x3fffea, 0x3fffeb, 0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4,
+    0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8, 0x7ffffe9, 0x7ffffea,
+    0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed, 0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee,
+    0x3fffffff,
+};
+
+static const uint8_t vox_hpack_huff_len[257] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+    30,
+};
+
+/* 规范 Huffman 解码：按码长分组，limit 为该码长最后一个码的下一个值左对齐到 32 位 */
+#define VOX_HPACK_HUFF_GROUPS 21
+static const struct {
+    uint8_t len;
+    uint16_t offset;   /* 该码长第一个符号在 vox_hpack_huff_sym 中的位置 */
+    uint32_t first;    /* 该码长第一个码（右对齐） */
+    uint64_t limit;    /* (first + count) << (32 - len) */
+} vox_hpack_huff_group[VOX_HPACK_HUFF_GROUPS] = {
+    {5, 0, 0x0, 0x50000000ULL},
+    {6, 10, 0x14, 0xb8000000ULL},
+    {7, 36, 0x5c, 0xf8000000ULL},
+    {8, 68, 0xf8, 0xfe000000ULL},
+    {10, 74, 0x3f8, 0xff400000ULL},
+    {11, 79, 0x7fa, 0xffa00000ULL},
+    {12, 82, 0xffa, 0xffc00000ULL},
+    {13, 84, 0x1ff8, 0xfff00000ULL},
+    {14, 90, 0x3ffc, 0xfff80000ULL},
+    {15, 92, 0x7ffc, 0xfffe0000ULL},
+    {19, 95, 0x7fff0, 0xfffe6000ULL},
+    {20, 98, 0xfffe6, 0xfffee000ULL},
+    {21, 106, 0x1fffdc, 0xffff4800ULL},
+    {22, 119, 0x3fffd2, 0xffffb000ULL},
+    {23, 145, 0x7fffd8, 0xffffea00ULL},
+    {24, 174, 0xffffea, 0xfffff600ULL},
+    {25, 186, 0x1ffffec, 0xfffff800ULL},
+    {26, 190, 0x3ffffe0, 0xfffffbc0ULL},
+    {27, 205, 0x7ffffde, 0xfffffe20ULL},
+    {28, 224, 0xfffffe2, 0xfffffff0ULL},
+    {30, 253, 0x3ffffffc, 0x100000000ULL},
+};
+
+static const uint16_t vox_hpack_huff_sym[257] = {
+    48, 49, 50, 97, 99, 101, 105, 111, 115, 116, 32, 37, 45, 46, 47, 51,
+    52, 53, 54, 55, 56, 57, 61, 65, 95, 98, 100, 102, 103, 104, 108, 109,
+    110, 112, 114, 117, 58, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76,
+    77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 89, 106, 107, 113, 118,
+    119, 120, 121, 122, 38, 42, 44, 59, 88, 90, 33, 34, 40, 41, 63, 39,
+    43, 124, 35, 62, 0, 36, 64, 91, 93, 126, 94, 125, 60, 96, 123, 92,
+    195, 208, 128, 130, 131, 162, 184, 194, 224, 226, 153, 161, 167, 172, 176, 177,
+    179, 209, 216, 217, 227, 229, 230, 129, 132, 133, 134, 136, 146, 154, 156, 160,
+    163, 164, 169, 170, 173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228, 232,
+    233, 1, 135, 137, 138, 139, 140, 141, 143, 147, 149, 150, 151, 152, 155, 157,
+    158, 165, 166, 168, 174, 175, 180, 182, 183, 188, 191, 197, 231, 239, 9, 142,
+    144, 145, 148, 159, 171, 206, 215, 225, 236, 237, 199, 207, 234, 235, 192, 193,
+    200, 201, 202, 205, 210, 213, 218, 219, 238, 240, 242, 243, 255, 203, 204, 211,
+    212, 214, 221, 222, 223, 241, 244, 245, 246, 247, 248, 250, 251, 252, 253, 254,
+    2, 3, 4, 5, 6, 7, 8, 11, 12, 14, 15, 16, 17, 18, 19, 20,
+    21, 23, 24, 25, 26, 27, 28, 29, 30, 31, 127, 220, 249, 10, 13, 22,
+    256,
+};
+
+/* 动态表条目：name 与 value 紧跟在结构体之后 */
+typedef struct {
+    size_t name_len;
+    size_t value_len;
+} vox_hpack_entry_t;
+
+#define VOX_HPACK_ENTRY_NAME(e) ((const char*)((e) + 1))
+#define VOX_HPACK_ENTRY_VALUE(e) ((const char*)((e) + 1) + (e)->name_len)
+
+struct vox_http_hpack {
+    vox_mpool_t* mpool;
+    vox_hpack_entry_t** entries; /* 环形数组，容量为2的幂 */
+    size_t capacity;
+    size_t head;                 /* 最新条目位置 */
+    size_t count;
+    size_t size;                 /* 当前占用 */
+    size_t max_size;             /* 当前生效的上限（由表大小更新设置） */
+    size_t settings_size;        /* 协议层允许的上限 */
+    bool pending_update;         /* 编码器：下一个头部块需发出表大小更新 */
+    size_t pending_min;          /* 两次编码之间出现过的最小上限（需要先更新到它） */
+    vox_string_t* name_buf;      /* 解码时 Huffman/拼接缓冲 */
+    vox_string_t* value_buf;
+};
+
+/* ===== 动态表 ===== */
+
+/* 第 i 个动态表条目（0 为最新） */
+static vox_hpack_entry_t* vox_hpack_dyn_get(const vox_http_hpack_t* hp, size_t i) {
+    return hp->entries[(hp->head - i) & (hp->capacity - 1)];
+}
+
+static void vox_hpack_evict_to(vox_http_hpack_t* hp, size_t limit) {
+    while (hp->size > limit && hp->count > 0) {
+        vox_hpack_entry_t* e = vox_hpack_dyn_get(hp, hp->count - 1);
+        hp->size -= e->name_len + e->value_len + VOX_HPACK_ENTRY_OVERHEAD;
+        hp->count--;
+        vox_mpool_free(hp->mpool, e);
+    }
+}
+
+static int vox_hpack_dyn_add(vox_http_hpack_t* hp, const char* name, size_t nlen, const char* value, size_t vlen) {
+    size_t esize = nlen + vlen + VOX_HPACK_ENTRY_OVERHEAD;
+    if (esize > hp->max_size) {
+        /* 超过整个表：清空动态表，条目不加入（RFC 7541 4.4） */
+        vox_hpack_evict_to(hp, 0);
+        return 0;
+    }
+    vox_hpack_evict_to(hp, hp->max_size - esize);
+
+    if (hp->count == hp->capacity) {
+        size_t ncap = hp->capacity ? hp->capacity * 2 : 16;
+        vox_hpack_entry_t** arr = (vox_hpack_entry_t**)vox_mpool_alloc(hp->mpool, ncap * sizeof(*arr));
+        if (!arr) return -1;
+        for (size_t i = 0; i < hp->count; i++) {
+            /* 按从旧到新重排，最新条目放在 count-1 */
+            arr[i] = vox_hpack_dyn_get(hp, hp->count - 1 - i);
+        }
+        if (hp->entries) vox_mpool_free(hp->mpool, hp->entries);
+        hp->entries = arr;
+        hp->capacity = ncap;
+        hp->head = hp->count ? hp->count - 1 : ncap - 1;
+    }
+
+    vox_hpack_entry_t* e = (vox_hpack_entry_t*)vox_mpool_alloc(hp->mpool, sizeof(*e) + nlen + vlen);
+    if (!e) return -1;
+    e->name_len = nlen;
+    e->value_len = vlen;
+    if (nlen) memcpy((char*)(e + 1), name, nlen);
+    if (vlen) memcpy((char*)(e + 1) + nlen, value, vlen);
+    hp->head = (hp->head + 1) & (hp->capacity - 1);
+    hp->entries[hp->head] = e;
+    hp->count++;
+    hp->size += esize;
+    return 0;
+}
+
+/* 按 HPACK 索引取条目（1..61 静态，62.. 动态） */
+static int vox_hpack_lookup(const vox_http_hpack_t* hp, uint64_t index,
+                            const char** name, size_t* nlen, const char** value, size_t* vlen) {
+    if (index == 0) return -1;
+    if (index <= VOX_HPACK_STATIC_COUNT) {
+        const vox_hpack_static_entry_t* s = &vox_hpack_static_table[index - 1];
+        *name = s->name;
+        *nlen = strlen(s->name);
+        *value = s->value;
+        *vlen = strlen(s->value);
+        return 0;
+    }
+    index -= VOX_HPACK_STATIC_COUNT + 1;
+    if (index >= hp->count) return -1;
+    const vox_hpack_entry_t* e = vox_hpack_dyn_get(hp, (size_t)index);
+    *name = VOX_HPACK_ENTRY_NAME(e);
+    *nlen = e->name_len;
+    *value = VOX_HPACK_ENTRY_VALUE(e);
+    *vlen = e->value_len;
+    return 0;
+}
+
+vox_http_hpack_t* vox_http_hpack_create(vox_mpool_t* mpool, size_t max_table_size) {
+    if (!mpool) return NULL;
+    vox_http_hpack_t* hp = (vox_http_hpack_t*)vox_mpool_alloc(mpool, sizeof(vox_http_hpack_t));
+    if (!hp) return NULL;
+    memset(hp, 0, sizeof(*hp));
+    hp->mpool = mpool;
+    hp->max_size = max_table_size;
+    hp->settings_size = max_table_size;
+    hp->pending_min = max_table_size;
+    hp->name_buf = vox_string_create(mpool);
+    hp->value_buf = vox_string_create(mpool);
+    if (!hp->name_buf || !hp->value_buf) {
+        vox_http_hpack_destroy(hp);
+        return NULL;
+    }
+    return hp;
+}
+
+void vox_http_hpack_destroy(vox_http_hpack_t* hp) {
+    if (!hp) return;
+    vox_hpack_evict_to(hp, 0);
+    if (hp->entries) vox_mpool_free(hp->mpool, hp->entries);
+    if (hp->name_buf) vox_string_destroy(hp->name_buf);
+    if (hp->value_buf) vox_string_destroy(hp->value_buf);
+    vox_mpool_free(hp->mpool, hp);
+}
+
+size_t vox_http_hpack_table_size(const vox_http_hpack_t* hp) {
+    return hp ? hp->size : 0;
+}
+
+size_t vox_http_hpack_table_count(const vox_http_hpack_t* hp) {
+    return hp ? hp->count : 0;
+}
+
+/* ===== Huffman ===== */
+
+size_t vox_http_hpack_huffman_encoded_len(const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    uint64_t bits = 0;
+    for (size_t i = 0; i < len; i++) {
+        bits += vox_hpack_huff_len[p[i]];
+    }
+    return (size_t)((bits + 7) / 8);
+}
+
+int vox_http_hpack_huffman_encode(const void* data, size_t len, vox_string_t* out) {
+    const uint8_t* p = (const uint8_t*)data;
+    size_t base = vox_string_length(out);
+    size_t enc_len = vox_http_hpack_huffman_encoded_len(data, len);
+    if (vox_string_resize(out, base + enc_len) != 0) return -1;
+    uint8_t* dst = (uint8_t*)vox_string_data(out) + base;
+    uint64_t acc = 0;
+    unsigned nbits = 0;
+    for (size_t i = 0; i < len; i++) {
+        acc = (acc << vox_hpack_huff_len[p[i]]) | vox_hpack_huff_code[p[i]];
+        nbits += vox_hpack_huff_len[p[i]];
+        while (nbits >= 8) {
+            nbits -= 8;
+            *dst++ = (uint8_t)(acc >> nbits);
+        }
+    }
+    if (nbits > 0) {
+        /* 用 EOS 的高位（全1）填充 */
+        *dst++ = (uint8_t)((acc << (8 - nbits)) | (0xffu >> nbits));
+    }
+    return 0;
+}
+
+int vox_http_hpack_huffman_decode(const void* data, size_t len, vox_string_t* out) {
+    const uint8_t* p = (const uint8_t*)data;
+    const uint8_t* end = p + len;
+    uint64_t acc = 0;   /* 低 nbits 位有效 */
+    unsigned nbits = 0;
+    for (;;) {
+        while (nbits <= 56 && p < end) {
+            acc = (acc << 8) | *p++;
+            nbits += 8;
+        }
+        if (nbits == 0) return 0;
+        /* 取高 32 位（不足部分补1，与填充一致） */
+        uint32_t v;
+        if (nbits >= 32) {
+            v = (uint32_t)(acc >> (nbits - 32));
+        } else {
+            v = (uint32_t)((acc << (32 - nbits)) | ((1ULL << (32 - nbits)) - 1));
+        }
+        int g = 0;
+        while (g < VOX_HPACK_HUFF_GROUPS - 1 && (uint64_t)v >= vox_hpack_huff_group[g].limit) {
+            g++;
+        }
+        unsigned clen = vox_hpack_huff_group[g].len;
+        if (clen > nbits) {
+            /* 剩余位是填充：不超过7位且全为1 */
+            if (nbits > 7 || (acc & ((1ULL << nbits) - 1)) != (1ULL << nbits) - 1) return -1;
+            return 0;
+        }
+        uint32_t code = v >> (32 - clen);
+        uint16_t sym = vox_hpack_huff_sym[vox_hpack_huff_group[g].offset + (code - vox_hpack_huff_group[g].first)];
+        if (sym == 256) return -1;  /* 不得出现 EOS */
+        if (vox_string_append_char(out, (char)sym) != 0) return -1;
+        nbits -= clen;
+        acc &= (nbits == 64) ? ~0ULL : ((1ULL << nbits) - 1);
+    }
+}
+
+/* ===== 整数与字符串原语 ===== */
+
+/* 解码 N 位前缀整数（RFC 7541 5.1） */
+static int vox_hpack_decode_int(const uint8_t** pp, const uint8_t* end, unsigned prefix_bits, uint64_t* out) {
+    const uint8_t* p = *pp;
+    if (p >= end) return -1;
+    uint64_t mask = (1u << prefix_bits) - 1;
+    uint64_t v = *p++ & mask;
+    if (v == mask) {
+        unsigned shift = 0;
+        for (;;) {
+            if (p >= end || shift > 56) return -1;
+            uint8_t b = *p++;
+            v += (uint64_t)(b & 0x7f) << shift;
+            shift += 7;
+            if (!(b & 0x80)) break;
+        }
+    }
+    *pp = p;
+    *out = v;
+    return 0;
+}
+
+static int vox_hpack_encode_int(vox_string_t* out, uint8_t first, unsigned prefix_bits, uint64_t v) {
+    uint8_t buf[16];
+    size_t n = 0;
+    uint64_t mask = (1u << prefix_bits) - 1;
+    if (v < mask) {
+        buf[n++] = (uint8_t)(first | v);
+    } else {
+        buf[n++] = (uint8_t)(first | mask);
+        v -= mask;
+        while (v >= 0x80) {
+            buf[n++] = (uint8_t)((v & 0x7f) | 0x80);
+            v >>= 7;
+        }
+        buf[n++] = (uint8_t)v;
+    }
+    return vox_string_append_data(out, buf, n);
+}
+
+/* 解码字符串字面量；结果指向输入或 buf（Huffman） */
+static int vox_hpack_decode_str(const uint8_t** pp, const uint8_t* end, vox_string_t* buf,
+                                const char** str, size_t* len) {
+    if (*pp >= end) return -1;
+    bool huff = (**pp & 0x80) != 0;
+    uint64_t n;
+    if (vox_hpack_decode_int(pp, end, 7, &n) != 0) return -1;
+    if (n > (uint64_t)(end - *pp)) return -1;
+    if (huff) {
+        vox_string_clear(buf);
+        if (vox_http_hpack_huffman_decode(*pp, (size_t)n, buf) != 0) return -1;
+        *str = (const char*)vox_string_data(buf);
+        *len = vox_string_length(buf);
+    } else {
+        *str = (const char*)*pp;
+        *len = (size_t)n;
+    }
+    *pp += n;
+    return 0;
+}
+
+static int vox_hpack_encode_str(vox_string_t* out, const char* s, size_t len) {
+    size_t hlen = vox_http_hpack_huffman_encoded_len(s, len);
+    if (hlen < len) {
+        if (vox_hpack_encode_int(out, 0x80, 7, hlen) != 0) return -1;
+        return vox_http_hpack_huffman_encode(s, len, out);
+    }
+    if (vox_hpack_encode_int(out, 0x00, 7, len) != 0) return -1;
+    return len ? vox_string_append_data(out, s, len) : 0;
+}
+
+/* ===== 解码 ===== */
+
+int vox_http_hpack_decode(vox_http_hpack_t* hp, const void* data, size_t len,
+                          vox_http_hpack_header_cb cb, void* user_data) {
+    if (!hp || (!data && len > 0)) return -1;
+    const uint8_t* p = (const uint8_t*)data;
+    const uint8_t* end = p + len;
+    bool header_seen = false;
+
+    while (p < end) {
+        uint8_t b = *p;
+        const char* name;
+        const char* value;
+        size_t nlen;
+        size_t vlen;
+        uint64_t index;
+
+        if (b & 0x80) {
+            /* 索引头部字段 */
+            if (vox_hpack_decode_int(&p, end, 7, &index) != 0) return -1;
+            if (vox_hpack_lookup(hp, index, &name, &nlen, &value, &vlen) != 0) return -1;
+            header_seen = true;
+            if (cb && cb(user_data, name, nlen, value, vlen) != 0) return -2;
+            continue;
+        }
+
+        if ((b & 0xe0) == 0x20) {
+            /* 动态表大小更新：只能出现在头部块开头，且不超过协议上限 */
+            if (header_seen) return -1;
+            uint64_t size;
+            if (vox_hpack_decode_int(&p, end, 5, &size) != 0) return -1;
+            if (size > hp->settings_size) return -1;
+            hp->max_size = (size_t)size;
+            vox_hpack_evict_to(hp, hp->max_size);
+            continue;
+        }
+
+        /* 字面量：01 增量索引（6位前缀），0000 不索引、0001 永不索引（4位前缀） */
+        bool incremental = (b & 0xc0) == 0x40;
+        unsigned prefix = incremental ? 6 : 4;
+        if (vox_hpack_decode_int(&p, end, prefix, &index) != 0) return -1;
+        if (index) {
+            const char* ignored;
+            size_t ignored_len;
+            if (vox_hpack_lookup(hp, index, &name, &nlen, &ignored, &ignored_len) != 0) return -1;
+            if (incremental && index > VOX_HPACK_STATIC_COUNT) {
+                /* 名称可能随本条目加入动态表而被逐出，先复制 */
+                if (vox_string_set_data(hp->name_buf, name, nlen) != 0) return -1;
+                name = (const char*)vox_string_data(hp->name_buf);
+            }
+        } else {
+            if (vox_hpack_decode_str(&p, end, hp->name_buf, &name, &nlen) != 0) return -1;
+        }
+        if (vox_hpack_decode_str(&p, end, hp->value_buf, &value, &vlen) != 0) return -1;
+        if (incremental && vox_hpack_dyn_add(hp, name, nlen, value, vlen) != 0) return -1;
+        header_seen = true;
+        if (cb && cb(user_data, name, nlen, value, vlen) != 0) return -2;
+    }
+    return 0;
+}
+
+/* ===== 编码 ===== */
+
+void vox_http_hpack_set_max_table_size(vox_http_hpack_t* hp, size_t max_table_size) {
+    if (!hp) return;
+    hp->settings_size = max_table_size;
+    if (max_table_size < hp->pending_min) hp->pending_min = max_table_size;
+    if (max_table_size != hp->max_size) hp->pending_update = true;
+}
+
+int vox_http_hpack_encode_begin(vox_http_hpack_t* hp, vox_string_t* out) {
+    if (!hp || !out) return -1;
+    if (!hp->pending_update) return 0;
+    /* 期间上限曾降到更小值时，先更新到最小值再更新到最终值（RFC 7541 4.2） */
+    if (hp->pending_min < hp->settings_size) {
+        if (vox_hpack_encode_int(out, 0x20, 5, hp->pending_min) != 0) return -1;
+        vox_hpack_evict_to(hp, hp->pending_min);
+    }
+    if (vox_hpack_encode_int(out, 0x20, 5, hp->settings_size) != 0) return -1;
+    hp->max_size = hp->settings_size;
+    vox_hpack_evict_to(hp, hp->max_size);
+    hp->pending_min = hp->settings_size;
+    hp->pending_update = false;
+    return 0;
+}
+
+/* 查找匹配：返回完全匹配的索引（>0），否则在 name_index 中给出同名索引（0 表示没有） */
+static uint64_t vox_hpack_find(const vox_http_hpack_t* hp, const char* name, size_t nlen,
+                               const char* value, size_t vlen, uint64_t* name_index) {
+    *name_index = 0;
+    for (size_t i = 0; i < VOX_HPACK_STATIC_COUNT; i++) {
+        const vox_hpack_static_entry_t* s = &vox_hpack_static_table[i];
+        if (s->name[0] != name[0] || strlen(s->name) != nlen || memcmp(s->name, name, nlen) != 0) continue;
+        if (strlen(s->value) == vlen && memcmp(s->value, value, vlen) == 0) return i + 1;
+        if (!*name_index) *name_index = i + 1;
+    }
+    for (size_t i = 0; i < hp->count; i++) {
+        const vox_hpack_entry_t* e = vox_hpack_dyn_get(hp, i);
+        if (e->name_len != nlen || memcmp(VOX_HPACK_ENTRY_NAME(e), name, nlen) != 0) continue;
+        uint64_t index = VOX_HPACK_STATIC_COUNT + 1 + i;
+        if (e->value_len == vlen && memcmp(VOX_HPACK_ENTRY_VALUE(e), value, vlen) == 0) return index;
+        if (!*name_index) *name_index = index;
+    }
+    return 0;
+}
+
+int vox_http_hpack_encode(vox_http_hpack_t* hp, vox_string_t* out,
+                          const char* name, size_t nlen,
+                          const char* value, size_t vlen, int flags) {
+    if (!hp || !out || !name || nlen == 0 || (!value && vlen > 0)) return -1;
+    if (!value) value = "";
+
+    uint64_t name_index;
+    uint64_t index = vox_hpack_find(hp, name, nlen, value, vlen, &name_index);
+    if (index && !(flags & VOX_HTTP_HPACK_NEVER_INDEX)) {
+        return vox_hpack_encode_int(out, 0x80, 7, index);
+    }
+    if (index && !name_index) {
+        /* 敏感头部只引用名称 */
+        name_index = index;
+    }
+
+    /* 只索引不超过表一半的条目，避免一个大头部把表冲空 */
+    bool incremental = !(flags & (VOX_HTTP_HPACK_NO_INDEX | VOX_HTTP_HPACK_NEVER_INDEX)) &&
+                       nlen + vlen + VOX_HPACK_ENTRY_OVERHEAD <= hp->max_size / 2;
+    int rc;
+    if (incremental) {
+        rc = vox_hpack_encode_int(out, 0x40, 6, name_index);
+    } else {
+        rc = vox_hpack_encode_int(out, (flags & VOX_HTTP_HPACK_NEVER_INDEX) ? 0x10 : 0x00, 4, name_index);
+    }
+    if (rc != 0) return -1;
+    if (!name_index && vox_hpack_encode_str(out, name, nlen) != 0) return -1;
+    if (vox_hpack_encode_str(out, value, vlen) != 0) return -1;
+    if (incremental) return vox_hpack_dyn_add(hp, name, nlen, value, vlen);
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * vox_http_hpack.h - HPACK 头部压缩（RFC 7541）
+ *
+ * 一个 vox_http_hpack_t 对应一个方向的压缩上下文：
+ * - 解码器：解析对端的头部块，维护对端编码器同步的动态表
+ * - 编码器：把头部编码为头部块，完全匹配的头部编码为索引，其余按需加入动态表
+ * 支持静态表、动态表（含大小更新）与 Huffman 编解码
+ */
+
+#ifndef VOX_HTTP_HPACK_H
+#define VOX_HTTP_HPACK_H
+
+#include "../vox_os.h"
+#include "../vox_mpool.h"
+#include "../vox_string.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* SETTINGS_HEADER_TABLE_SIZE 的协议默认值 */
+#define VOX_HTTP_HPACK_DEFAULT_TABLE_SIZE 4096
+
+/* 编码标志 */
+#define VOX_HTTP_HPACK_NO_INDEX    0x01  /* 不加入动态表 */
+#define VOX_HTTP_HPACK_NEVER_INDEX 0x02  /* 敏感头部：中间节点也不得索引（如 authorization、set-cookie） */
+
+typedef struct vox_http_hpack vox_http_hpack_t;
+
+/* 解码出的头部回调；name/value 仅在回调期间有效，返回非0中止解码 */
+typedef int (*vox_http_hpack_header_cb)(void* user_data, const char* name, size_t name_len,
+                                        const char* value, size_t value_len);
+
+/* 创建压缩上下文：max_table_size 为动态表上限（解码器为本端通告的 SETTINGS_HEADER_TABLE_SIZE） */
+vox_http_hpack_t* vox_http_hpack_create(vox_mpool_t* mpool, size_t max_table_size);
+
+/* 销毁压缩上下文 */
+void vox_http_hpack_destroy(vox_http_hpack_t* hpack);
+
+/* 解码一个完整的头部块（HEADERS + CONTINUATION 拼接后）
+ * 返回0成功；格式错误、索引越界、表大小更新超限等返回-1（对应 COMPRESSION_ERROR），回调中止返回-2 */
+int vox_http_hpack_decode(vox_http_hpack_t* hpack, const void* data, size_t len,
+                          vox_http_hpack_header_cb cb, void* user_data);
+
+/* 编码器：对端通告了新的 SETTINGS_HEADER_TABLE_SIZE；下一个头部块开头会发出表大小更新 */
+void vox_http_hpack_set_max_table_size(vox_http_hpack_t* hpack, size_t max_table_size);
+
+/* 编码器：开始一个头部块（写出待发送的动态表大小更新） */
+int vox_http_hpack_encode_begin(vox_http_hpack_t* hpack, vox_string_t* out);
+
+/* 编码器：追加一个头部到 out；name 必须为小写，flags 为 VOX_HTTP_HPACK_* 组合 */
+int vox_http_hpack_encode(vox_http_hpack_t* hpack, vox_string_t* out,
+                          const char* name, size_t name_len,
+                          const char* value, size_t value_len, int flags);
+
+/* 当前动态表占用（按 RFC 计算：每个条目 name + value + 32） */
+size_t vox_http_hpack_table_size(const vox_http_hpack_t* hpack);
+
+/* 当前动态表条目数 */
+size_t vox_http_hpack_table_count(const vox_http_hpack_t* hpack);
+
+/* Huffman 编码后的长度（字节） */
+size_t vox_http_hpack_huffman_encoded_len(const void* data, size_t len);
+
+/* Huffman 编码，追加到 out */
+int vox_http_hpack_huffman_encode(const void* data, size_t len, vox_string_t* out);
+
+/* Huffman 解码，追加到 out；非法填充或出现 EOS 返回-1 */
+int vox_http_hpack_huffman_decode(const void* data, size_t len, vox_string_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_HTTP_HPACK_H */
@@ -17,6 +17,7 @@
 #include "vox_http_middleware.h"
 #include "vox_http_context.h"
 #include "vox_http_ws.h"
+#include "vox_http_router.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -49,12 +50,22 @@ struct vox_http_context {
 
     /* 由 server 注入：用于写回/升级等 */
     void* conn;            /* vox_http_conn_t*（在 server.c 内定义） */
+    void* h2_stream;       /* HTTP/2 请求：所属流（vox_http2.c 内定义），HTTP/1.x 为 NULL */
     void* user_data;
 
     /* sendfile：非 NULL 时响应体由 sendfile 发送，调用方不得关闭 file */
     vox_file_t* sendfile_file;
     int64_t sendfile_offset;
     size_t sendfile_count;
+    /* 非 NULL 时发送完成后调用 release 归还 file（共享/缓存的 fd），而不是 vox_file_close */
+    void (*sendfile_release)(void* data);
+    void* sendfile_release_data;
+
+    /* 前缀挂载（vox_http_engine_mount）命中时：去掉挂载前缀后的剩余路径 */
+    vox_strview_t mount_path;
+
+    /* defer 的请求持有其路由处理链的引用，热更新替换后仍可 resume_at/next，请求结束时释放 */
+    void* chain_pin;
 
     /* 快速路径：handler 已通过 vox_http_context_header 设置过 Connection 头则置 true，避免 send_response 时线性扫描 res.headers */
     bool res_has_connection_header;
@@ -65,8 +76,42 @@ int vox_http_conn_mark_ws_upgrade(void* conn, vox_http_ws_conn_t* ws);
 int vox_http_conn_ws_write(void* conn, const void* data, size_t len);
 void vox_http_conn_ws_close(void* conn);
 
-/* defer response：由 context_finish 调用（仅供 http/ 模块使用） */
-int vox_http_conn_send_response(void* conn);
+/* sendfile 共享文件：发送完成（或放弃发送）后调用 release(data) 归还 file，框架不会关闭它 */
+int vox_http_context_send_file_shared(vox_http_context_t* ctx, vox_file_t* file, int64_t offset, size_t count,
+                                      void (*release)(void* data), void* data);
+
+/* 释放 sendfile 文件：有 release 回调时归还，否则关闭 */
+static VOX_UNUSED_FUNC void vox_http_sendfile_release(vox_file_t* file, void (*release)(void* data), void* data) {
+    if (release) {
+        release(data);
+    } else if (file) {
+        vox_file_close(file);
+    }
+}
+
+/* 按最长前缀匹配挂载点（路由未命中时由 server 调用）
+ * @return 命中返回0并填充 handlers/count/user_data/prefix_len，未命中返回-1 */
+int vox_http_engine_match_mount(struct vox_http_engine* engine, const char* path, size_t path_len,
+                                vox_http_handler_cb** handlers, size_t* handler_count,
+                                void** user_data, size_t* prefix_len);
+
+/* 分发一个完整请求：路由匹配，未命中时挂载点，都未命中为 404；随后执行 handler 链
+ * ctx 的 req/mpool/loop/engine/conn 须已填好；match 由调用方提供存储（ctx->params 可能指向其中）
+ * 返回后若未 defer 且 handler 未设置状态码，则状态码为 200 */
+void vox_http_engine_dispatch(struct vox_http_engine* engine, vox_http_context_t* ctx,
+                              vox_http_route_match_t* match);
+
+/* 释放 dispatch 为 defer 请求保留的处理链引用（请求结束、ctx 复用或释放前调用） */
+void vox_http_engine_release_chain(vox_http_context_t* ctx);
+
+/* 生成 ctx 的响应并按请求顺序写回：由 context_finish 调用（仅供 http/ 模块使用）
+ * 成功后 ctx 所属的请求可能已写出并被复用，调用方不得再访问 ctx */
+int vox_http_conn_send_response(void* conn, vox_http_context_t* ctx);
+/* HTTP/2：发送流的响应（defer 的流由 context_finish 调用）；可能在返回前释放流及其 ctx */
+int vox_http2_stream_send_response(void* stream);
+/* HTTP/2：绑定会话所属的 vox_http_conn_t（写入各流 ctx->conn，用于 defer 保护与客户端地址） */
+struct vox_http2_session;
+void vox_http2_session_bind_conn(struct vox_http2_session* session, void* conn);
 /* defer 生命周期保护：HTTP 场景下避免“客户端提前断开 + 异步回调”导致 ctx/mpool UAF */
 void vox_http_conn_defer_acquire(void* conn);
 void vox_http_conn_defer_release(void* conn);
@@ -77,8 +122,26 @@ vox_http_ws_conn_t* vox_http_ws_internal_create(vox_mpool_t* mpool, void* conn,
 int vox_http_ws_internal_feed(vox_http_ws_conn_t* ws, const void* data, size_t len);
 void vox_http_ws_internal_on_open(vox_http_ws_conn_t* ws);
 
-/* 获取客户端IP地址（仅供 http/ 模块使用） */
-int vox_http_conn_get_client_ip(void* conn, char* ip_buf, size_t ip_buf_size);
+/* 获取客户端IP地址（代理头取自 ctx 的请求，对端地址取自 ctx->conn；仅供 http/ 模块使用） */
+int vox_http_conn_get_client_ip(const vox_http_context_t* ctx, char* ip_buf, size_t ip_buf_size);
+/* 获取客户端二进制地址（代理头优先，其次为连接建立时缓存的对端地址；仅供 http/ 模块使用） */
+int vox_http_conn_get_client_addr(const vox_http_context_t* ctx, vox_socket_addr_t* addr);
+
+/* 分配 header：结构体、name、value 放在同一块内存中（各自以 '\0' 结尾），释放时 free(kv) 一次即可 */
+static VOX_UNUSED_FUNC vox_http_header_t* vox_http_header_alloc(vox_mpool_t* mpool, const char* name, size_t nlen,
+                                                                 const char* value, size_t vlen) {
+    vox_http_header_t* kv = (vox_http_header_t*)vox_mpool_alloc(mpool, sizeof(vox_http_header_t) + nlen + vlen + 2);
+    if (!kv) return NULL;
+    char* ncopy = (char*)(kv + 1);
+    char* vcopy = ncopy + nlen + 1;
+    if (nlen > 0) memcpy(ncopy, name, nlen);
+    ncopy[nlen] = '\0';
+    if (vlen > 0) memcpy(vcopy, value, vlen);
+    vcopy[vlen] = '\0';
+    kv->name = (vox_strview_t){ ncopy, nlen };
+    kv->value = (vox_strview_t){ vcopy, vlen };
+    return kv;
+}
 
 /* ===== 小工具：大小写不敏感比较 ===== */
 static VOX_UNUSED_FUNC int vox_http_strieq(const char* a, size_t alen, const char* b, size_t blen) {
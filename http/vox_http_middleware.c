@@ -4,13 +4,12 @@
 
 #include "vox_http_middleware.h"
 #include "vox_http_context.h"
+#include "vox_http_engine.h"
 #include "vox_http_internal.h"
 #include "../vox_log.h"
 #include "../vox_time.h"
 #include "../vox_mpool.h"
 #include "../vox_crypto.h"
-#include "../vox_htable.h"
-#include "../vox_mutex.h"
 #include "../vox_atomic.h"
 #include "../vox_os.h"
 #include <string.h>
@@ -77,7 +76,7 @@ void vox_http_middleware_logger(vox_http_context_t* ctx) {
     
     /* 获取客户端IP（使用缓存，避免系统调用） */
     char client_ip[64] = {0};
-    if (vox_http_conn_get_client_ip(ctx->conn, client_ip, sizeof(client_ip)) != 0) {
+    if (vox_http_conn_get_client_ip(ctx, client_ip, sizeof(client_ip)) != 0) {
         strncpy(client_ip, "-", sizeof(client_ip) - 1);
     }
     
@@ -577,237 +576,379 @@ vox_http_handler_cb vox_http_middleware_body_limit_create(vox_mpool_t* mpool, si
 
 /* ===== 限流中间件 ===== */
 
-/* 滑动窗口限流记录（每个IP的限流信息） */
-#define VOX_HTTP_RATE_LIMIT_MAX_TIMESTAMPS 100  /* 最多存储100个时间戳 */
+/*
+ * 固定内存的 GCRA 限流：
+ * - 状态表为 2^k 个组，每组 8 个 64 位槽加 8 个完整键哈希，占两个相邻缓存行；
+ *   键哈希的低位选组、高 16 位作指纹
+ * - 槽位打包 [指纹:16 | TAT:48]，TAT（理论到达时间）为相对创建时刻的微秒数（约 8.9 年不溢出）；
+ *   指纹相同时再比较完整哈希，指纹冲突的不同客户端不会共用同一个计数
+ * - 判定只需一次组内扫描 + 一次 CAS，无锁、无分配，可被多个 loop 线程共享
+ */
+#define VOX_HTTP_RATE_LIMIT_WAYS 8
+#define VOX_HTTP_RATE_LIMIT_DEFAULT_SLOTS 16384
+#define VOX_HTTP_RATE_LIMIT_TAT_BITS 48
+#define VOX_HTTP_RATE_LIMIT_TAT_MASK ((UINT64_C(1) << VOX_HTTP_RATE_LIMIT_TAT_BITS) - 1)
+#define VOX_HTTP_RATE_LIMIT_CAS_RETRIES 8
 
 typedef struct {
-    int64_t timestamps[VOX_HTTP_RATE_LIMIT_MAX_TIMESTAMPS];  /* 请求时间戳数组（循环使用） */
-    size_t count;          /* 当前时间戳数量 */
-    size_t head;           /* 循环数组头部索引 */
-    vox_mutex_t mutex;     /* 保护时间戳数组的互斥锁（每个IP独立锁） */
-} vox_http_rate_limit_record_t;
+    vox_atomic_long_t slots[VOX_HTTP_RATE_LIMIT_WAYS];
+    vox_atomic_long_t keys[VOX_HTTP_RATE_LIMIT_WAYS];   /* 槽位所属键的完整哈希 */
+} vox_http_rl_set_t;
+
+struct vox_http_rate_limiter {
+    vox_mpool_t* mpool;
+    void* table_mem;            /* 未对齐的原始分配 */
+    vox_http_rl_set_t* sets;    /* 按 64 字节对齐 */
+    uint64_t set_mask;
+    uint64_t seed;              /* 每实例随机种子，避免可预测的组冲突 */
+    int64_t base_us;            /* TAT 基准时间 */
+    int64_t interval_us;        /* 放行间隔 T = window / max_requests */
+    int64_t burst_us;           /* 容忍度 tau = window - T（允许突发 max_requests 个） */
+    uint8_t ipv6_prefix_len;
+    char* message;
+    vox_atomic_long_padded_t allowed;
+    vox_atomic_long_padded_t limited;
+    vox_atomic_long_padded_t evictions;
+};
 
-/* 限流器结构（每个中间件实例独立） */
-typedef struct {
-    vox_http_rate_limit_config_t config;
-    vox_htable_t* ip_records;  /* key: IP字符串, value: vox_http_rate_limit_record_t* */
-    vox_mutex_t mutex;         /* 保护哈希表的互斥锁 */
-    vox_mpool_t* mpool;        /* 内存池 */
-    int64_t last_cleanup;      /* 上次清理时间 */
-    char* message_copy;        /* 错误消息副本 */
-} vox_http_rate_limiter_t;
-
-/* 清理过期的限流记录 */
-/* 注意：此函数当前未使用，保留用于将来实现定时清理功能 */
-VOX_UNUSED_FUNC static void cleanup_expired_records(vox_http_rate_limiter_t* limiter) {
-    if (!limiter || !limiter->ip_records) return;
-    
-    int64_t now = vox_time_now_ms();
-    /* 每5秒清理一次 */
-    if (now - limiter->last_cleanup < 5000) {
-        return;
+static uint64_t rl_mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= UINT64_C(0xbf58476d1ce4e5b9);
+    x ^= x >> 27;
+    x *= UINT64_C(0x94d049bb133111eb);
+    x ^= x >> 31;
+    return x;
+}
+
+static uint64_t rl_hash(const vox_http_rate_limiter_t* rl, const void* key, size_t key_len) {
+    const uint8_t* p = (const uint8_t*)key;
+    uint64_t h = rl->seed ^ (uint64_t)key_len;
+    while (key_len >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = rl_mix64(h ^ w);
+        p += 8;
+        key_len -= 8;
+    }
+    if (key_len > 0) {
+        uint64_t w = 0;
+        memcpy(&w, p, key_len);
+        h = rl_mix64(h ^ w ^ UINT64_C(0x9e3779b97f4a7c15));
+    }
+    return h;
+}
+
+vox_http_rate_limiter_t* vox_http_rate_limiter_create(vox_mpool_t* mpool, const vox_http_rate_limit_config_t* config) {
+    if (!mpool || !config || config->max_requests == 0 || config->window_ms <= 0) {
+        return NULL;
     }
-    limiter->last_cleanup = now;
-    
-    /* 遍历哈希表，删除过期的记录 */
-    /* 注意：vox_htable 没有提供迭代器，这里简化处理，只清理明显过期的 */
-    /* 实际生产环境应该使用定时器定期清理 */
+
+    vox_http_rate_limiter_t* rl = (vox_http_rate_limiter_t*)vox_mpool_alloc(mpool, sizeof(*rl));
+    if (!rl) return NULL;
+    memset(rl, 0, sizeof(*rl));
+    rl->mpool = mpool;
+
+    size_t slots = config->table_slots ? config->table_slots : VOX_HTTP_RATE_LIMIT_DEFAULT_SLOTS;
+    size_t nsets = 1;
+    while (nsets * VOX_HTTP_RATE_LIMIT_WAYS < slots) nsets <<= 1;
+    rl->table_mem = vox_mpool_alloc(mpool, nsets * sizeof(vox_http_rl_set_t) + 63);
+    if (!rl->table_mem) {
+        vox_mpool_free(mpool, rl);
+        return NULL;
+    }
+    rl->sets = (vox_http_rl_set_t*)(((uintptr_t)rl->table_mem + 63) & ~(uintptr_t)63);
+    memset(rl->sets, 0, nsets * sizeof(vox_http_rl_set_t));
+    rl->set_mask = (uint64_t)(nsets - 1);
+
+    int64_t window_us = config->window_ms * 1000;
+    rl->interval_us = window_us / (int64_t)config->max_requests;
+    if (rl->interval_us < 1) rl->interval_us = 1;
+    rl->burst_us = window_us - rl->interval_us;
+    rl->ipv6_prefix_len = config->ipv6_prefix_len ? config->ipv6_prefix_len : 64;
+    if (rl->ipv6_prefix_len > 128) rl->ipv6_prefix_len = 128;
+    /* 基准时间前移一个窗口，保证 TAT 始终为正且空槽（0）等价于“早已过期” */
+    rl->base_us = (int64_t)vox_time_monotonic() - window_us;
+    rl->seed = rl_mix64((uint64_t)vox_time_now() ^ (uint64_t)(uintptr_t)rl);
+
+    if (config->message) {
+        size_t msg_len = strlen(config->message);
+        rl->message = (char*)vox_mpool_alloc(mpool, msg_len + 1);
+        if (!rl->message) {
+            vox_mpool_free(mpool, rl->table_mem);
+            vox_mpool_free(mpool, rl);
+            return NULL;
+        }
+        memcpy(rl->message, config->message, msg_len + 1);
+    }
+    return rl;
+}
+
+void vox_http_rate_limiter_destroy(vox_http_rate_limiter_t* limiter) {
+    if (!limiter) return;
+    vox_mpool_t* mpool = limiter->mpool;
+    if (limiter->message) vox_mpool_free(mpool, limiter->message);
+    vox_mpool_free(mpool, limiter->table_mem);
+    vox_mpool_free(mpool, limiter);
 }
 
-/* 获取或创建限流记录 */
-static vox_http_rate_limit_record_t* get_or_create_record(vox_http_rate_limiter_t* limiter, const char* ip) {
-    if (!limiter || !ip) return NULL;
-    
-    vox_mutex_lock(&limiter->mutex);
-    
-    vox_http_rate_limit_record_t* record = (vox_http_rate_limit_record_t*)vox_htable_get(
-        limiter->ip_records, ip, strlen(ip));
-    
-    if (!record) {
-        /* 创建新记录 */
-        record = (vox_http_rate_limit_record_t*)vox_mpool_alloc(limiter->mpool, sizeof(*record));
-        if (record) {
-            memset(record, 0, sizeof(*record));
-            if (vox_mutex_create(&record->mutex) != 0) {
-                vox_mpool_free(limiter->mpool, record);
-                record = NULL;
-            } else {
-                /* 存储到哈希表 */
-                if (vox_htable_set(limiter->ip_records, ip, strlen(ip), record) != 0) {
-                    vox_mutex_destroy(&record->mutex);
-                    vox_mpool_free(limiter->mpool, record);
-                    record = NULL;
+bool vox_http_rate_limiter_allow(vox_http_rate_limiter_t* limiter, const void* key, size_t key_len,
+                                 int64_t now_us, int64_t* retry_after_us) {
+    if (!limiter || !key) return true;
+    vox_http_rate_limiter_t* rl = limiter;
+
+    uint64_t h = rl_hash(rl, key, key_len);
+    uint64_t fp = h >> 48;
+    if (fp == 0) fp = 1;                     /* 0 保留给空槽 */
+    vox_http_rl_set_t* set = &rl->sets[h & rl->set_mask];
+    int64_t now = now_us - rl->base_us;
+    if (now < 0) now = 0;
+
+    for (int attempt = 0; attempt < VOX_HTTP_RATE_LIMIT_CAS_RETRIES; attempt++) {
+        /* 组内查找指纹；同时记录 TAT 最小的槽作为替换候选 */
+        int hit = -1;
+        int victim = 0;
+        uint64_t victim_tat = UINT64_MAX;
+        uint64_t cur = 0;
+        for (int i = 0; i < VOX_HTTP_RATE_LIMIT_WAYS; i++) {
+            uint64_t v = (uint64_t)vox_atomic_long_load(&set->slots[i]);
+            if ((v >> VOX_HTTP_RATE_LIMIT_TAT_BITS) == fp &&
+                (uint64_t)vox_atomic_long_load(&set->keys[i]) == h) {
+                hit = i;
+                cur = v;
+                break;
+            }
+            uint64_t t = v & VOX_HTTP_RATE_LIMIT_TAT_MASK;
+            if (t < victim_tat) {
+                victim_tat = t;
+                victim = i;
+                cur = v;
+            }
+        }
+        int idx = hit >= 0 ? hit : victim;
+        if (hit < 0) cur = (uint64_t)vox_atomic_long_load(&set->slots[victim]);
+
+        int64_t tat = hit >= 0 ? (int64_t)(cur & VOX_HTTP_RATE_LIMIT_TAT_MASK) : 0;
+        if (tat < now) tat = now;
+        if (tat - now > rl->burst_us) {
+            if (retry_after_us) *retry_after_us = tat - rl->burst_us - now;
+            vox_atomic_long_increment(&rl->limited.value);
+            return false;
+        }
+        uint64_t next = (fp << VOX_HTTP_RATE_LIMIT_TAT_BITS) |
+                        ((uint64_t)(tat + rl->interval_us) & VOX_HTTP_RATE_LIMIT_TAT_MASK);
+        int64_t expected = (int64_t)cur;
+        if (vox_atomic_long_compare_exchange(&set->slots[idx], &expected, (int64_t)next)) {
+            if (hit < 0) {
+                /* 新占用的槽：CAS 之后才写入键哈希，期间同一键的并发请求最多再占一个槽（失败开放） */
+                vox_atomic_long_store(&set->keys[idx], (int64_t)h);
+                if ((int64_t)(cur & VOX_HTTP_RATE_LIMIT_TAT_MASK) > now) {
+                    vox_atomic_long_increment(&rl->evictions.value);
                 }
             }
+            vox_atomic_long_increment(&rl->allowed.value);
+            return true;
         }
     }
-    
-    vox_mutex_unlock(&limiter->mutex);
-    
-    return record;
+    /* 竞争过于激烈时放行（失败开放，不阻塞请求） */
+    vox_atomic_long_increment(&rl->allowed.value);
+    return true;
 }
 
-/* 滑动窗口：移除过期的时间戳并添加新时间戳 */
-static size_t sliding_window_update(vox_http_rate_limit_record_t* record, int64_t now, int64_t window_ms) {
-    if (!record) return 0;
-    
-    vox_mutex_lock(&record->mutex);
-    
-    /* 移除过期的时间戳（时间戳 < now - window_ms） */
-    int64_t window_start = now - window_ms;
-    size_t valid_count = 0;
-    size_t first_valid_idx = 0;
-    bool found_valid = false;
-    
-    /* 找到第一个未过期的时间戳位置 */
-    for (size_t i = 0; i < record->count; i++) {
-        size_t idx = (record->head + i) % VOX_HTTP_RATE_LIMIT_MAX_TIMESTAMPS;
-        if (record->timestamps[idx] >= window_start) {
-            if (!found_valid) {
-                first_valid_idx = i;
-                found_valid = true;
-            }
-            valid_count++;
+void vox_http_rate_limiter_get_stats(const vox_http_rate_limiter_t* limiter, vox_http_rate_limit_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!limiter) return;
+    vox_http_rate_limiter_t* rl = (vox_http_rate_limiter_t*)limiter;
+    stats->allowed = (uint64_t)vox_atomic_long_load(&rl->allowed.value);
+    stats->limited = (uint64_t)vox_atomic_long_load(&rl->limited.value);
+    stats->evictions = (uint64_t)vox_atomic_long_load(&rl->evictions.value);
+}
+
+/* 限流器与 engine 的绑定（存放在 engine 的中间件状态中） */
+typedef struct {
+    vox_http_rate_limiter_t* limiter;
+    bool owned;               /* 由 vox_http_middleware_rate_limit_engine_create 创建，替换时销毁 */
+} vox_http_rate_limit_binding_t;
+
+/* 客户端地址 -> 二进制键（IPv6 按前缀截断） */
+static size_t rate_limit_make_key(const vox_http_rate_limiter_t* rl, const vox_socket_addr_t* addr, uint8_t key[17]) {
+    if (addr->family == VOX_AF_INET6) {
+        size_t nbytes = (rl->ipv6_prefix_len + 7) / 8;
+        memcpy(key + 1, addr->u.ipv6.addr, nbytes);
+        if (rl->ipv6_prefix_len % 8) {
+            key[nbytes] &= (uint8_t)(0xFF << (8 - rl->ipv6_prefix_len % 8));
         }
+        key[0] = 6;
+        return nbytes + 1;
     }
-    
-    /* 更新头部（指向第一个有效时间戳） */
-    if (valid_count > 0) {
-        record->head = (record->head + first_valid_idx) % VOX_HTTP_RATE_LIMIT_MAX_TIMESTAMPS;
-    } else {
-        record->head = 0;
-    }
-    
-    /* 添加当前时间戳 */
-    if (valid_count < VOX_HTTP_RATE_LIMIT_MAX_TIMESTAMPS) {
-        /* 数组未满，追加到末尾 */
-        size_t tail = (record->head + valid_count) % VOX_HTTP_RATE_LIMIT_MAX_TIMESTAMPS;
-        record->timestamps[tail] = now;
-        valid_count++;
-    } else {
-        /* 数组已满，覆盖最旧的时间戳（循环使用） */
-        record->timestamps[record->head] = now;
-        record->head = (record->head + 1) % VOX_HTTP_RATE_LIMIT_MAX_TIMESTAMPS;
-        /* count 保持不变（仍然是 MAX_TIMESTAMPS） */
-    }
-    
-    record->count = valid_count;
-    
-    size_t result = record->count;
-    vox_mutex_unlock(&record->mutex);
-    
-    return result;
+    key[0] = 4;
+    memcpy(key + 1, &addr->u.ipv4.addr, 4);
+    return 5;
 }
 
-/* 限流中间件实现（滑动窗口算法） */
-static void vox_http_middleware_rate_limit_impl(vox_http_context_t* ctx, vox_http_rate_limiter_t* limiter) {
-    if (!ctx || !limiter || limiter->config.max_requests == 0 || limiter->config.window_ms <= 0) {
+static void rate_limit_apply(vox_http_context_t* ctx, vox_http_rate_limiter_t* limiter) {
+    vox_socket_addr_t addr;
+    if (!limiter || vox_http_conn_get_client_addr(ctx, &addr) != 0) {
+        /* 未绑定限流器或无法获取地址，允许通过 */
         vox_http_context_next(ctx);
         return;
     }
-    
-    /* 获取客户端IP（使用缓存，避免系统调用） */
-    char client_ip[64] = {0};
-    if (vox_http_conn_get_client_ip(ctx->conn, client_ip, sizeof(client_ip)) != 0) {
-        /* 无法获取IP，允许通过（或可以选择拒绝） */
+
+    uint8_t key[17];
+    size_t key_len = rate_limit_make_key(limiter, &addr, key);
+    int64_t retry_after_us = 0;
+    if (vox_http_rate_limiter_allow(limiter, key, key_len, (int64_t)vox_time_monotonic(), &retry_after_us)) {
         vox_http_context_next(ctx);
         return;
     }
-    
-    /* 获取限流记录 */
-    vox_http_rate_limit_record_t* record = get_or_create_record(limiter, client_ip);
-    if (!record) {
-        /* 内存不足，允许通过 */
-        vox_http_context_next(ctx);
-        return;
+
+    /* 超过限制，返回 429 Too Many Requests */
+    vox_http_context_status(ctx, 429);
+    vox_http_context_write_cstr(ctx, limiter->message ? limiter->message : "Too Many Requests");
+    /* 向上取整到秒 */
+    char retry_str[32];
+    int64_t retry_after_s = (retry_after_us + 999999) / 1000000;
+    if (retry_after_s < 1) retry_after_s = 1;
+    snprintf(retry_str, sizeof(retry_str), "%lld", (long long)retry_after_s);
+    vox_http_context_header(ctx, "Retry-After", retry_str);
+    vox_http_context_abort(ctx);
+}
+
+/* 限流中间件（GCRA） */
+void vox_http_middleware_rate_limit(vox_http_context_t* ctx) {
+    const vox_http_rate_limit_binding_t* binding = (const vox_http_rate_limit_binding_t*)
+        vox_http_engine_get_middleware_data(vox_http_context_get_engine(ctx), vox_http_middleware_rate_limit);
+    rate_limit_apply(ctx, binding ? binding->limiter : NULL);
+}
+
+/* 绑定更新：engine 属于单个 loop，中间件与绑定都在该 loop 线程访问，替换时可直接销毁旧的限流器；
+ * key 为使用该绑定的处理函数 */
+static int rate_limit_bind(vox_http_engine_t* engine, vox_http_handler_cb key,
+                           vox_http_rate_limiter_t* limiter, bool owned) {
+    vox_http_rate_limit_binding_t* binding = (vox_http_rate_limit_binding_t*)
+        vox_http_engine_get_middleware_data(engine, key);
+    if (!binding) {
+        binding = (vox_http_rate_limit_binding_t*)vox_mpool_alloc(vox_http_engine_get_mpool(engine), sizeof(*binding));
+        if (!binding) return -1;
+        memset(binding, 0, sizeof(*binding));
+        if (vox_http_engine_set_middleware_data(engine, key, binding) != 0) {
+            vox_mpool_free(vox_http_engine_get_mpool(engine), binding);
+            return -1;
+        }
     }
-    
-    /* 滑动窗口：移除过期时间戳并添加当前时间戳 */
-    int64_t now = vox_time_now_ms();
-    size_t current_count = sliding_window_update(record, now, limiter->config.window_ms);
-    
-    /* 检查是否超过限制 */
-    bool exceeded = (current_count > limiter->config.max_requests);
-    
-    if (exceeded) {
-        /* 超过限制，返回 429 Too Many Requests */
-        vox_http_context_status(ctx, 429);
-        const char* message = limiter->message_copy ? limiter->message_copy : "Too Many Requests";
-        vox_http_context_write_cstr(ctx, message);
-        
-        /* 计算重试时间（窗口剩余时间） */
-        int64_t retry_after_ms = 1;
-        vox_mutex_lock(&record->mutex);
-        if (record->count > 0) {
-            int64_t oldest_timestamp = record->timestamps[record->head];
-            int64_t window_end = oldest_timestamp + limiter->config.window_ms;
-            retry_after_ms = (window_end - now + 999) / 1000; /* 向上取整到秒 */
-            if (retry_after_ms < 1) retry_after_ms = 1;
+    if (binding->owned && binding->limiter && binding->limiter != limiter) {
+        vox_http_rate_limiter_destroy(binding->limiter);
+    }
+    binding->limiter = limiter;
+    binding->owned = owned;
+    return 0;
+}
+
+int vox_http_middleware_rate_limit_bind(vox_http_engine_t* engine, vox_http_rate_limiter_t* limiter) {
+    if (!engine || !limiter) return -1;
+    return rate_limit_bind(engine, vox_http_middleware_rate_limit, limiter, false);
+}
+
+/* 旧接口的入口槽位：处理函数无法携带状态，每个不同配置占用一个静态入口。
+ * 槽位只保存配置副本（消息存于槽内缓冲区），限流器在各 engine 首次请求时
+ * 从 engine 内存池创建并以入口函数为 key 绑定，随 engine 释放，不存在进程级限流器 */
+#define VOX_HTTP_RATE_LIMIT_LEGACY_SLOTS 8
+#define VOX_HTTP_RATE_LIMIT_MESSAGE_MAX 256
+
+enum {
+    RATE_LIMIT_SLOT_FREE = 0,
+    RATE_LIMIT_SLOT_FILLING,
+    RATE_LIMIT_SLOT_READY
+};
+
+typedef struct {
+    vox_atomic_int_t state;
+    vox_http_rate_limit_config_t config;
+    char message[VOX_HTTP_RATE_LIMIT_MESSAGE_MAX];
+} vox_http_rate_limit_legacy_t;
+
+static vox_http_rate_limit_legacy_t g_rate_limit_legacy[VOX_HTTP_RATE_LIMIT_LEGACY_SLOTS];
+
+static void rate_limit_legacy_run(vox_http_context_t* ctx, size_t slot, vox_http_handler_cb self) {
+    vox_http_engine_t* engine = vox_http_context_get_engine(ctx);
+    const vox_http_rate_limit_binding_t* binding = (const vox_http_rate_limit_binding_t*)
+        vox_http_engine_get_middleware_data(engine, self);
+    vox_http_rate_limiter_t* limiter = binding ? binding->limiter : NULL;
+    if (!limiter && engine) {
+        limiter = vox_http_rate_limiter_create(vox_http_engine_get_mpool(engine), &g_rate_limit_legacy[slot].config);
+        if (limiter && rate_limit_bind(engine, self, limiter, true) != 0) {
+            vox_http_rate_limiter_destroy(limiter);
+            limiter = NULL;
         }
-        vox_mutex_unlock(&record->mutex);
-        
-        /* 缓冲区足够大以容纳 int64_t 的最大值（19位数字 + 负号 + 空字符） */
-        char retry_str[32];
-        snprintf(retry_str, sizeof(retry_str), "%lld", (long long)retry_after_ms);
-        vox_http_context_header(ctx, "Retry-After", retry_str);
-        return;
     }
-    
-    /* 继续执行 */
-    vox_http_context_next(ctx);
+    rate_limit_apply(ctx, limiter);
 }
 
-/* 限流中间件包装器 */
-VOX_UNUSED_FUNC static void vox_http_middleware_rate_limit_wrapper(vox_http_context_t* ctx) {
-    vox_http_rate_limiter_t* limiter = (vox_http_rate_limiter_t*)vox_http_context_get_user_data(ctx);
-    if (limiter) {
-        void* original_user_data = vox_http_context_get_user_data(ctx);
-        vox_http_context_set_user_data(ctx, NULL);
-        vox_http_middleware_rate_limit_impl(ctx, limiter);
-        vox_http_context_set_user_data(ctx, original_user_data);
-    } else {
-        vox_http_context_next(ctx);
+#define VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(n) \
+    static void rate_limit_legacy_##n(vox_http_context_t* ctx) { \
+        rate_limit_legacy_run(ctx, n, rate_limit_legacy_##n); \
     }
+
+VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(0)
+VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(1)
+VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(2)
+VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(3)
+VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(4)
+VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(5)
+VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(6)
+VOX_HTTP_RATE_LIMIT_LEGACY_ENTRY(7)
+
+static const vox_http_handler_cb g_rate_limit_legacy_entries[VOX_HTTP_RATE_LIMIT_LEGACY_SLOTS] = {
+    rate_limit_legacy_0, rate_limit_legacy_1, rate_limit_legacy_2, rate_limit_legacy_3,
+    rate_limit_legacy_4, rate_limit_legacy_5, rate_limit_legacy_6, rate_limit_legacy_7
+};
+
+static bool rate_limit_config_equal(const vox_http_rate_limit_config_t* a, const vox_http_rate_limit_config_t* b) {
+    if (a->max_requests != b->max_requests || a->window_ms != b->window_ms ||
+        a->table_slots != b->table_slots || a->ipv6_prefix_len != b->ipv6_prefix_len) {
+        return false;
+    }
+    if (!a->message || !b->message) return a->message == b->message;
+    return strcmp(a->message, b->message) == 0;
 }
 
 vox_http_handler_cb vox_http_middleware_rate_limit_create(vox_mpool_t* mpool, const vox_http_rate_limit_config_t* config) {
-    if (!mpool || !config || config->max_requests == 0 || config->window_ms <= 0) {
+    if (!mpool || !config || config->max_requests == 0 || config->window_ms <= 0) return NULL;
+    if (config->message && strlen(config->message) >= VOX_HTTP_RATE_LIMIT_MESSAGE_MAX) {
+        VOX_LOG_ERROR("rate limit message too long");
         return NULL;
     }
-    
-    /* 创建限流器实例 */
-    vox_http_rate_limiter_t* limiter = (vox_http_rate_limiter_t*)vox_mpool_alloc(mpool, sizeof(*limiter));
-    if (!limiter) return NULL;
-    
-    memset(limiter, 0, sizeof(*limiter));
-    limiter->mpool = mpool;
-    limiter->config = *config;
-    
-    /* 复制错误消息 */
-    if (config->message) {
-        size_t msg_len = strlen(config->message);
-        limiter->message_copy = (char*)vox_mpool_alloc(mpool, msg_len + 1);
-        if (!limiter->message_copy) return NULL;
-        memcpy(limiter->message_copy, config->message, msg_len + 1);
-        limiter->config.message = limiter->message_copy;
-    }
-    
-    if (vox_mutex_create(&limiter->mutex) != 0) {
-        if (limiter->message_copy) vox_mpool_free(mpool, limiter->message_copy);
-        vox_mpool_free(mpool, limiter);
-        return NULL;
+
+    for (size_t i = 0; i < VOX_HTTP_RATE_LIMIT_LEGACY_SLOTS; i++) {
+        vox_http_rate_limit_legacy_t* slot = &g_rate_limit_legacy[i];
+        int32_t state = vox_atomic_int_load(&slot->state);
+        if (state == RATE_LIMIT_SLOT_READY) {
+            /* 相同配置复用同一入口 */
+            if (rate_limit_config_equal(&slot->config, config)) return g_rate_limit_legacy_entries[i];
+            continue;
+        }
+        if (state != RATE_LIMIT_SLOT_FREE) continue;
+        int32_t expected = RATE_LIMIT_SLOT_FREE;
+        if (!vox_atomic_int_compare_exchange(&slot->state, &expected, RATE_LIMIT_SLOT_FILLING)) continue;
+        slot->config = *config;
+        if (config->message) {
+            memcpy(slot->message, config->message, strlen(config->message) + 1);
+            slot->config.message = slot->message;
+        }
+        vox_atomic_int_store(&slot->state, RATE_LIMIT_SLOT_READY);
+        return g_rate_limit_legacy_entries[i];
     }
-    
-    limiter->ip_records = vox_htable_create(mpool);
-    if (!limiter->ip_records) {
-        vox_mutex_destroy(&limiter->mutex);
-        if (limiter->message_copy) vox_mpool_free(mpool, limiter->message_copy);
-        vox_mpool_free(mpool, limiter);
+    VOX_LOG_ERROR("too many rate limit configurations, use vox_http_middleware_rate_limit_engine_create");
+    return NULL;
+}
+
+vox_http_handler_cb vox_http_middleware_rate_limit_engine_create(vox_http_engine_t* engine, const vox_http_rate_limit_config_t* config) {
+    if (!engine) return NULL;
+    vox_http_rate_limiter_t* limiter = vox_http_rate_limiter_create(vox_http_engine_get_mpool(engine), config);
+    if (!limiter) return NULL;
+    if (rate_limit_bind(engine, vox_http_middleware_rate_limit, limiter, true) != 0) {
+        vox_http_rate_limiter_destroy(limiter);
         return NULL;
     }
-    
-    limiter->last_cleanup = vox_time_now_ms();
-    
-    (void)limiter;
-    return NULL; /* TODO: 需要修改架构以支持配置传递 */
+    return vox_http_middleware_rate_limit;
 }
@@ -15,6 +15,7 @@ extern "C" {
 
 /* 前向声明 */
 typedef struct vox_http_context vox_http_context_t;
+struct vox_http_engine;
 
 /* 处理器/中间件回调 */
 typedef void (*vox_http_handler_cb)(vox_http_context_t* ctx);
@@ -103,21 +104,93 @@ vox_http_handler_cb vox_http_middleware_body_limit_create(vox_mpool_t* mpool, si
 
 /**
  * 限流配置
+ * 算法为 GCRA（等价于令牌桶）：窗口内最多突发 max_requests 个请求，之后按 window_ms / max_requests 的间隔放行。
+ * 状态保存在固定大小的组相联表中（每组一个缓存行、8 路），内存在创建时一次分配，不随客户端数量增长；
+ * 组内无空位时替换最久未活跃的项（被替换的客户端重新计数）。
  */
 typedef struct {
     size_t max_requests;      /* 时间窗口内最大请求数 */
     int64_t window_ms;        /* 时间窗口大小（毫秒），例如 1000 表示每秒 */
     const char* message;      /* 限流时的错误消息，NULL 使用默认消息 */
+    size_t table_slots;       /* 状态表槽位数（向上取整为 8 的 2 的幂倍），0 表示默认 16384（128KB） */
+    uint8_t ipv6_prefix_len;  /* IPv6 按前缀聚合的位数（同一 /64 通常属于同一用户），0 表示默认 64 */
 } vox_http_rate_limit_config_t;
 
+/* 限流器（可在多个 loop 线程间共享，判定为无锁原子操作） */
+typedef struct vox_http_rate_limiter vox_http_rate_limiter_t;
+
+/* 限流统计 */
+typedef struct {
+    uint64_t allowed;         /* 放行次数 */
+    uint64_t limited;         /* 被限流次数 */
+    uint64_t evictions;       /* 替换仍在计数中的项的次数（表偏小时会增长） */
+} vox_http_rate_limit_stats_t;
+
 /**
- * 创建限流中间件
- * @param mpool 内存池（用于分配配置数据和IP记录哈希表）
- * @param config 限流配置（max_requests, window_ms, message）
- * @return 中间件回调函数
+ * 创建限流器
+ * @param mpool 内存池（分配固定大小的状态表）
+ * @param config 限流配置
+ * @return 成功返回限流器，失败返回NULL
+ */
+vox_http_rate_limiter_t* vox_http_rate_limiter_create(vox_mpool_t* mpool, const vox_http_rate_limit_config_t* config);
+
+/**
+ * 销毁限流器（须确保没有线程仍在使用）
+ */
+void vox_http_rate_limiter_destroy(vox_http_rate_limiter_t* limiter);
+
+/**
+ * 判定一个请求是否放行
+ * @param limiter 限流器
+ * @param key 客户端键（二进制，如 IPv4 的 4 字节或 IPv6 前缀）
+ * @param key_len 键长度
+ * @param now_us 当前单调时间（微秒），通常为 vox_time_monotonic()
+ * @param retry_after_us 被限流时输出距下次可放行的时间（微秒），可为 NULL
+ * @return 放行返回 true，限流返回 false
+ */
+bool vox_http_rate_limiter_allow(vox_http_rate_limiter_t* limiter, const void* key, size_t key_len,
+                                 int64_t now_us, int64_t* retry_after_us);
+
+/**
+ * 获取统计信息
+ */
+void vox_http_rate_limiter_get_stats(const vox_http_rate_limiter_t* limiter, vox_http_rate_limit_stats_t* stats);
+
+/**
+ * 限流中间件
+ * 按客户端地址（X-Forwarded-For/X-Real-IP 优先，否则为连接对端地址）的二进制形式限流，
+ * 超限返回 429 与 Retry-After。限流器取自当前请求所属 engine 的绑定，未绑定时直接放行。
+ */
+void vox_http_middleware_rate_limit(vox_http_context_t* ctx);
+
+/**
+ * 创建限流中间件（保留原签名）
+ * 每个不同配置占用一个静态入口（最多 8 个，相同配置返回同一入口）；入口在每个 engine
+ * 首次处理请求时从 engine 内存池创建限流器并绑定到该 engine，随 engine 回收。
+ * 新代码应使用 vox_http_middleware_rate_limit_engine_create
+ * @param mpool 内存池（仅校验非NULL）
+ * @param config 限流配置（被复制，message 长度须小于 256）
+ * @return 限流中间件；参数无效或入口已用尽时返回 NULL
  */
 vox_http_handler_cb vox_http_middleware_rate_limit_create(vox_mpool_t* mpool, const vox_http_rate_limit_config_t* config);
 
+/**
+ * 将限流器绑定到 engine（每个 engine 一个）
+ * @param engine engine
+ * @param limiter 限流器，由调用方持有（可在多个 engine 间共享），须比 engine 存活更久
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_middleware_rate_limit_bind(struct vox_http_engine* engine, vox_http_rate_limiter_t* limiter);
+
+/**
+ * 创建绑定到 engine 的限流中间件：从 engine 内存池创建限流器并绑定到 engine
+ * 再次调用会销毁之前由本函数创建的限流器，限流器随 engine 内存池回收
+ * @param engine engine
+ * @param config 限流配置
+ * @return vox_http_middleware_rate_limit；参数无效或内存不足时返回 NULL
+ */
+vox_http_handler_cb vox_http_middleware_rate_limit_engine_create(struct vox_http_engine* engine, const vox_http_rate_limit_config_t* config);
+
 #ifdef __cplusplus
 }
 #endif
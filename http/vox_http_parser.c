@@ -22,6 +22,7 @@ typedef enum {
     VOX_HTTP_PHASE_HEADER_VALUE,
     VOX_HTTP_PHASE_HEADERS_DONE,
     VOX_HTTP_PHASE_BODY,
+    VOX_HTTP_PHASE_BODY_EOF,       /* 响应体以连接关闭结束（无长度信息） */
     VOX_HTTP_PHASE_CHUNK_SIZE,
     VOX_HTTP_PHASE_CHUNK_DATA,
     VOX_HTTP_PHASE_CHUNK_END,
@@ -56,12 +57,14 @@ struct vox_http_parser {
     int http_minor;
     int status_code;
     uint64_t content_length;
+    bool has_content_length;
     uint64_t body_read;
     bool chunked;
     uint64_t chunk_remaining;      /* chunked 剩余字节 */
     bool connection_close;
     bool connection_keepalive;
     bool upgrade;
+    bool skip_body;                /* 响应无消息体（如 HEAD 的响应），跨 reset 保持 */
 
     /* 当前头部：name/value 可能分多段 */
     size_t header_count;
@@ -256,6 +259,7 @@ static int apply_header(vox_http_parser_t* p, const char* name_ptr, size_t name_
             return -1;
         }
         p->content_length = cl;
+        p->has_content_length = true;
     } else if (header_name_is(name_ptr, name_len, "Transfer-Encoding")) {
         if (header_value_is_chunked(value_ptr, value_len))
             p->chunked = true;
@@ -454,6 +458,12 @@ static int parse_headers(vox_http_parser_t* p, vox_scanner_t* sc) {
     }
 }
 
+/* 响应是否不带消息体：HEAD 的响应（skip_body）、1xx、204、304 */
+static inline bool response_has_no_body(const vox_http_parser_t* p) {
+    return p->skip_body || (p->status_code >= 100 && p->status_code < 200) ||
+           p->status_code == 204 || p->status_code == 304;
+}
+
 /* 执行解析：从当前 scanner 位置解析，更新 phase 与 consumed；返回 0 正常，-1 错误，-2 需要更多数据 */
 static int do_parse(vox_http_parser_t* p, size_t* consumed) {
     vox_scanner_t* sc = p->sc;
@@ -482,11 +492,16 @@ static int do_parse(vox_http_parser_t* p, size_t* consumed) {
             if (r != 0) return -1;
             if (invoke_headers_complete(p) != 0) { set_error(p, "callback error"); return -1; }
             p->phase = VOX_HTTP_PHASE_HEADERS_DONE;
-            if (p->chunked)
+            if (p->status_code > 0 && response_has_no_body(p))
+                p->phase = VOX_HTTP_PHASE_MESSAGE_COMPLETE;
+            else if (p->chunked)
                 p->phase = VOX_HTTP_PHASE_CHUNK_SIZE;
             else if (p->content_length > 0)
                 p->phase = VOX_HTTP_PHASE_BODY;
-            else {
+            else if (p->status_code > 0 && !p->has_content_length)
+                p->phase = VOX_HTTP_PHASE_BODY_EOF;
+            if (p->phase == VOX_HTTP_PHASE_HEADERS_DONE ||
+                p->phase == VOX_HTTP_PHASE_MESSAGE_COMPLETE) {
                 p->phase = VOX_HTTP_PHASE_MESSAGE_COMPLETE;
                 p->message_complete = true;
                 if (invoke_message_complete(p) != 0) { set_error(p, "callback error"); return -1; }
@@ -520,6 +535,18 @@ static int do_parse(vox_http_parser_t* p, size_t* consumed) {
             }
             continue;
         }
+        if (p->phase == VOX_HTTP_PHASE_BODY_EOF) {
+            /* 读到连接关闭为止：全部消费，完成由 vox_http_parser_finish 触发 */
+            size_t rem = vox_scanner_remaining(sc);
+            if (rem > 0) {
+                vox_strview_t seg;
+                if (vox_scanner_get(sc, rem, &seg) != 0) { *consumed = vox_scanner_offset(sc) - start_offset; return -2; }
+                if (invoke_body(p, seg.ptr, seg.len) != 0) { set_error(p, "callback error"); return -1; }
+                p->body_read += seg.len;
+            }
+            *consumed = vox_scanner_offset(sc) - start_offset;
+            return -2;
+        }
         if (p->phase == VOX_HTTP_PHASE_CHUNK_SIZE) {
             vox_strview_t line;
             if (peek_line(sc, &line) != 0) {
@@ -674,6 +701,7 @@ void vox_http_parser_reset(vox_http_parser_t* parser) {
     parser->http_major = parser->http_minor = 0;
     parser->status_code = 0;
     parser->content_length = 0;
+    parser->has_content_length = false;
     parser->body_read = 0;
     parser->chunked = false;
     parser->chunk_remaining = 0;
@@ -684,6 +712,27 @@ void vox_http_parser_reset(vox_http_parser_t* parser) {
     vox_scanner_stream_reset(&parser->stream);
 }
 
+int vox_http_parser_finish(vox_http_parser_t* parser) {
+    if (!parser || parser->has_error) return -1;
+    if (parser->message_complete) return 0;
+    if (parser->phase != VOX_HTTP_PHASE_BODY_EOF) return -1;
+    parser->phase = VOX_HTTP_PHASE_MESSAGE_COMPLETE;
+    parser->message_complete = true;
+    if (invoke_message_complete(parser) != 0) {
+        set_error(parser, "callback error");
+        return -1;
+    }
+    return 0;
+}
+
+void vox_http_parser_set_skip_body(vox_http_parser_t* parser, bool skip) {
+    if (parser) parser->skip_body = skip;
+}
+
+size_t vox_http_parser_get_buffered(const vox_http_parser_t* parser) {
+    return parser ? parser->buf_size : 0;
+}
+
 bool vox_http_parser_is_complete(const vox_http_parser_t* parser) {
     return parser && parser->message_complete;
 }
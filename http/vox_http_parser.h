@@ -193,9 +193,33 @@ void vox_http_parser_destroy(vox_http_parser_t* parser);
  * @return 成功返回已消费（解析）的字节数，失败返回-1
  * @note 返回值可能小于 len：例如解析完成一个完整消息后停止，以便上层继续处理 data+ret 的剩余字节（HTTP pipeline）。
  * @note len==0 时返回 0（此时 data 可以为 NULL）。
+ * @note 返回值从内部缓冲的第一个未消费字节算起，包含之前调用缓存下来的字节；
+ *       本次 data 中被消费的字节数为 返回值 - 调用前 vox_http_parser_get_buffered() 的值。
  */
 ssize_t vox_http_parser_execute(vox_http_parser_t* parser, const char* data, size_t len);
 
+/**
+ * 获取内部已缓存但尚未消费的字节数（之前的 execute 因数据不完整而留下的部分）
+ * @param parser 解析器指针
+ * @return 返回缓存的字节数
+ */
+size_t vox_http_parser_get_buffered(const vox_http_parser_t* parser);
+
+/**
+ * 通知解析器对端已关闭连接
+ * 既无 Content-Length 也非 chunked 的响应以连接关闭结束，此时完成消息并触发 on_message_complete
+ * @param parser 解析器指针
+ * @return 消息已完成返回0，消息不完整（被截断）返回-1
+ */
+int vox_http_parser_finish(vox_http_parser_t* parser);
+
+/**
+ * 设置响应不带消息体（用于 HEAD 请求的响应），设置跨 reset 保持
+ * @param parser 解析器指针
+ * @param skip 为 true 时响应头结束即完成消息
+ */
+void vox_http_parser_set_skip_body(vox_http_parser_t* parser, bool skip);
+
 /**
  * 重置解析器状态（用于解析下一个消息）
  * @param parser 解析器指针
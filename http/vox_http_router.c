@@ -1,11 +1,24 @@
 /*
  * vox_http_router.c - 路由实现（Radix Tree）
  * 静态子节点使用哈希表按段 O(1) 查找，避免每层线性扫描。
+ *
+ * 快照与发布：
+ * - 每个快照（路由树）使用独立的内存池，发布后只读，回收时整体销毁内存池
+ * - 写者在锁内修改草稿（未发布的快照）；草稿在发布后即成为只读快照，
+ *   之后的修改先按路由定义列表重建新草稿
+ * - 批量之外的修改只更新草稿并标记待发布，下一次匹配（或 begin/route_count/reclaim）前才发布，
+ *   连续注册 N 条路由只构建一个快照，而不是每条路由各重建一次
+ * - 参数名驻留在 router 的内存池中，匹配结果不引用快照内存
  */
 
 #include "vox_http_router.h"
 #include "vox_http_internal.h"
 #include "../vox_htable.h"
+#include "../vox_vector.h"
+#include "../vox_atomic.h"
+#include "../vox_mutex.h"
+#include "../vox_ebr.h"
+#include "../vox_log.h"
 #include <string.h>
 
 /* 每节点静态子表初始容量（多数节点子节点很少） */
@@ -14,10 +27,10 @@
 typedef struct vox_http_rnode {
     bool is_param;
     bool is_splat;   /* 单段 * 通配：匹配任意剩余路径，用于根路径通配静态兜底 */
-    /* 静态段：segment 指向 mpool 拷贝；参数段：param_name 指向 mpool 拷贝 */
+    /* 静态段：segment 指向快照内存池拷贝；参数段：param_name 指向 router 内驻留的名称 */
     char* segment;
     size_t segment_len;
-    char* param_name;
+    const char* param_name;
     size_t param_name_len;
 
     /* key: (segment, segment_len), value: vox_http_rnode_t* */
@@ -28,9 +41,42 @@ typedef struct vox_http_rnode {
     size_t handler_count;
 } vox_http_rnode_t;
 
+/* 路由树快照 */
+typedef struct {
+    vox_mpool_t* pool;   /* 快照私有内存池（快照结构本身也在其中） */
+    vox_http_rnode_t* roots[VOX_HTTP_METHOD_PATCH + 1];
+    size_t route_count;
+} vox_http_rsnap_t;
+
+/* 路由定义（重建草稿的依据） */
+typedef struct vox_http_route_def {
+    struct vox_http_route_def* next;
+    vox_http_method_t method;
+    vox_http_handler_cb* handlers;
+    size_t handler_count;
+    size_t path_len;
+    char path[1];        /* 去掉末尾 '/' 的路径拷贝 */
+} vox_http_route_def_t;
+
 struct vox_http_router {
     vox_mpool_t* mpool;
-    vox_http_rnode_t* roots[VOX_HTTP_METHOD_PATCH + 1];
+    vox_mpool_t* pool;               /* 路由定义与参数名（锁内使用） */
+    vox_mutex_t lock;                /* 串行化写者 */
+    vox_http_route_def_t* routes;    /* 按注册顺序 */
+    vox_http_route_def_t* routes_tail;
+    vox_htable_t* names;             /* 参数名驻留：key 为名称，value 为名称拷贝 */
+    vox_http_rsnap_t* draft;         /* 未发布的草稿（NULL 表示需要重建） */
+    int batch_depth;
+    bool dirty;                      /* 有未发布的修改 */
+    vox_atomic_int_t pending;        /* 批量之外有未发布的修改：匹配前无锁检查，非0时先发布 */
+    size_t snapshots_built;          /* 已构建的快照数量（统计） */
+
+    vox_atomic_ptr_t current;        /* 当前快照 */
+    vox_ebr_t* ebr;                  /* 旧快照的延迟回收 */
+
+    vox_ebr_free_func_t handlers_free; /* 非NULL时 router 接管 handlers 数组 */
+    void* handlers_free_data;
+    vox_vector_t* dropped;           /* 已摘除、待下次发布后退休的 handlers 数组 */
 };
 
 static char* vox_http_mpool_strdup(vox_mpool_t* mpool, const char* s, size_t len) {
@@ -54,7 +100,7 @@ static vox_http_rnode_t* vox_http_rnode_create(vox_mpool_t* mpool) {
     return n;
 }
 
-static vox_http_rnode_t* vox_http_rnode_find_static_child(vox_http_rnode_t* node, const char* seg, size_t seg_len) {
+static vox_http_rnode_t* vox_http_rnode_find_static_child(const vox_http_rnode_t* node, const char* seg, size_t seg_len) {
     if (!node || !node->static_map || seg_len == 0) return NULL;
     return (vox_http_rnode_t*)vox_htable_get(node->static_map, seg, seg_len);
 }
@@ -84,9 +130,8 @@ static vox_http_rnode_t* vox_http_rnode_get_or_add_param_child(vox_mpool_t* mpoo
     vox_http_rnode_t* c = vox_http_rnode_create(mpool);
     if (!c) return NULL;
     c->is_param = true;
-    c->param_name = vox_http_mpool_strdup(mpool, name, name_len);
+    c->param_name = name;
     c->param_name_len = name_len;
-    if (!c->param_name) return NULL;
     node->param_child = c;
     return c;
 }
@@ -96,38 +141,57 @@ static void vox_http_trim_trailing_slash(const char** path, size_t* len) {
     while (*len > 1 && (*path)[*len - 1] == '/') (*len)--;
 }
 
-vox_http_router_t* vox_http_router_create(vox_mpool_t* mpool) {
-    if (!mpool) return NULL;
-    vox_http_router_t* r = (vox_http_router_t*)vox_mpool_alloc(mpool, sizeof(vox_http_router_t));
-    if (!r) return NULL;
-    memset(r, 0, sizeof(*r));
-    r->mpool = mpool;
-    for (int i = 0; i <= VOX_HTTP_METHOD_PATCH; i++) {
-        r->roots[i] = vox_http_rnode_create(mpool);
-        if (!r->roots[i]) return NULL;
-    }
-    return r;
+/* ===== 快照 ===== */
+
+static void vox_http_rsnap_free(vox_http_rsnap_t* snap) {
+    if (snap) vox_mpool_destroy(snap->pool);
 }
 
-void vox_http_router_destroy(vox_http_router_t* router) {
-    /* router 内部使用 mpool 分配；这里不做深度释放 */
-    VOX_UNUSED(router);
+static void vox_http_rsnap_retired(void* ptr, void* user_data) {
+    VOX_UNUSED(user_data);
+    vox_http_rsnap_free((vox_http_rsnap_t*)ptr);
 }
 
-int vox_http_router_add(vox_http_router_t* router,
-                        vox_http_method_t method,
-                        const char* path,
-                        vox_http_handler_cb* handlers,
-                        size_t handler_count) {
-    if (!router || !path || !handlers || handler_count == 0) return -1;
-    if (method <= VOX_HTTP_METHOD_UNKNOWN || method > VOX_HTTP_METHOD_PATCH) return -1;
-    if (path[0] != '/') return -1;
+static vox_http_rsnap_t* vox_http_rsnap_create(void) {
+    vox_mpool_t* pool = vox_mpool_create();
+    if (!pool) return NULL;
+    vox_http_rsnap_t* snap = (vox_http_rsnap_t*)vox_mpool_alloc(pool, sizeof(vox_http_rsnap_t));
+    if (!snap) {
+        vox_mpool_destroy(pool);
+        return NULL;
+    }
+    memset(snap, 0, sizeof(*snap));
+    snap->pool = pool;
+    for (int i = 0; i <= VOX_HTTP_METHOD_PATCH; i++) {
+        snap->roots[i] = vox_http_rnode_create(pool);
+        if (!snap->roots[i]) {
+            vox_mpool_destroy(pool);
+            return NULL;
+        }
+    }
+    return snap;
+}
 
-    size_t path_len = strlen(path);
-    vox_http_trim_trailing_slash(&path, &path_len);
+/* 驻留参数名（须持有 router->lock） */
+static const char* vox_http_router_intern(vox_http_router_t* router, const char* name, size_t name_len) {
+    const char* s = (const char*)vox_htable_get(router->names, name, name_len);
+    if (s) return s;
+    char* copy = vox_http_mpool_strdup(router->pool, name, name_len);
+    if (!copy) return NULL;
+    if (vox_htable_set(router->names, copy, name_len, copy) != 0) {
+        vox_mpool_free(router->pool, copy);
+        return NULL;
+    }
+    return copy;
+}
 
-    vox_http_rnode_t* node = router->roots[method];
-    if (!node) return -1;
+/* 把一条路由插入草稿；返回终点节点，冲突或内存不足返回NULL */
+static vox_http_rnode_t* vox_http_rsnap_insert(vox_http_router_t* router,
+                                               vox_http_rsnap_t* snap,
+                                               vox_http_method_t method,
+                                               const char* path,
+                                               size_t path_len) {
+    vox_http_rnode_t* node = snap->roots[method];
 
     /* 逐段插入：/a/b/:id */
     size_t i = 1; /* skip leading '/' */
@@ -145,52 +209,360 @@ int vox_http_router_add(vox_http_router_t* router,
 
         if (path[seg_start] == ':') {
             /* param 段 */
-            const char* name = path + seg_start + 1;
             size_t name_len = seg_len - 1;
-            if (name_len == 0) return -1;
-            node = vox_http_rnode_get_or_add_param_child(router->mpool, node, name, name_len);
-            if (!node) return -1;
+            if (name_len == 0) return NULL;
+            const char* name = vox_http_router_intern(router, path + seg_start + 1, name_len);
+            if (!name) return NULL;
+            node = vox_http_rnode_get_or_add_param_child(snap->pool, node, name, name_len);
+            if (!node) return NULL;
         } else {
             /* static 段；单段 "*" 视为通配（匹配任意路径） */
             vox_http_rnode_t* c = vox_http_rnode_find_static_child(node, path + seg_start, seg_len);
-            if (!c) c = vox_http_rnode_add_static_child(router->mpool, node, path + seg_start, seg_len);
-            if (!c) return -1;
+            if (!c) c = vox_http_rnode_add_static_child(snap->pool, node, path + seg_start, seg_len);
+            if (!c) return NULL;
             if (seg_len == 1 && path[seg_start] == '*') c->is_splat = true;
             node = c;
         }
 
         i++; /* skip '/' */
     }
+    return node;
+}
 
-    /* 终点写 handlers */
-    node->handlers = handlers;
-    node->handler_count = handler_count;
+/* 取得草稿，必要时按路由定义重建（须持有 router->lock） */
+static vox_http_rsnap_t* vox_http_router_draft(vox_http_router_t* router) {
+    if (router->draft) return router->draft;
+    vox_http_rsnap_t* snap = vox_http_rsnap_create();
+    if (!snap) return NULL;
+    for (vox_http_route_def_t* d = router->routes; d; d = d->next) {
+        vox_http_rnode_t* node = vox_http_rsnap_insert(router, snap, d->method, d->path, d->path_len);
+        if (!node) {
+            vox_http_rsnap_free(snap);
+            return NULL;
+        }
+        node->handlers = d->handlers;
+        node->handler_count = d->handler_count;
+        snap->route_count++;
+    }
+    router->snapshots_built++;
+    router->draft = snap;
+    return snap;
+}
+
+/* 丢弃草稿（删除路由后需要重建） */
+static void vox_http_router_drop_draft(vox_http_router_t* router) {
+    vox_http_rsnap_free(router->draft);
+    router->draft = NULL;
+}
+
+/* 发布草稿（须持有 router->lock） */
+static int vox_http_router_publish(vox_http_router_t* router) {
+    vox_http_rsnap_t* snap = vox_http_router_draft(router);
+    if (!snap) {
+        VOX_LOG_ERROR("Failed to build http route snapshot");
+        return -1;
+    }
+    router->draft = NULL;
+    router->dirty = false;
+    vox_atomic_int_store(&router->pending, 0);
+    vox_http_rsnap_t* old = (vox_http_rsnap_t*)vox_atomic_ptr_exchange(&router->current, snap);
+    if (old) {
+        vox_ebr_thread_t* t = vox_ebr_thread(router->ebr);
+        if (!t || vox_ebr_retire(t, old, vox_http_rsnap_retired, NULL) != 0) {
+            /* 无法确认没有线程在匹配旧快照，只能泄漏（仅在内存耗尽时发生） */
+            VOX_LOG_ERROR("Failed to retire http route snapshot");
+        }
+    }
+    /* 新快照已不引用被摘除的 handlers，退休后等仍在执行它们的线程离开临界区 */
+    size_t cnt = vox_vector_size(router->dropped);
+    if (cnt > 0) {
+        vox_ebr_thread_t* t = vox_ebr_thread(router->ebr);
+        for (size_t i = 0; i < cnt; i++) {
+            void* handlers = vox_vector_get(router->dropped, i);
+            if (!t || vox_ebr_retire(t, handlers, router->handlers_free, router->handlers_free_data) != 0) {
+                VOX_LOG_ERROR("Failed to retire http handlers");
+            }
+        }
+        vox_vector_clear(router->dropped);
+    }
     return 0;
 }
 
-int vox_http_router_match(vox_http_router_t* router,
-                          vox_http_method_t method,
-                          const char* path,
-                          size_t path_len,
-                          vox_mpool_t* mpool,
-                          vox_http_route_match_t* out) {
-    if (out) memset(out, 0, sizeof(*out));
-    if (!router || !path || path_len == 0 || !out || !mpool) return -1;
+/* 记录一次修改：批量之外只标记待发布，由下一次匹配统一发布（须持有 router->lock） */
+static void vox_http_router_touch(vox_http_router_t* router) {
+    router->dirty = true;
+    if (router->batch_depth == 0) vox_atomic_int_store(&router->pending, 1);
+}
+
+/* 发布批量之外积累的修改 */
+static void vox_http_router_sync(vox_http_router_t* router) {
+    if (!vox_atomic_int_load(&router->pending)) return;
+    vox_mutex_lock(&router->lock);
+    if (router->dirty && router->batch_depth == 0) vox_http_router_publish(router);
+    vox_mutex_unlock(&router->lock);
+}
+
+/* 摘除 handlers 数组：当前快照可能仍引用它，须等新快照发布后才能退休（须持有 router->lock） */
+static void vox_http_router_drop_handlers(vox_http_router_t* router, vox_http_handler_cb* handlers) {
+    if (!router->handlers_free || !handlers) return;
+    if (vox_vector_push(router->dropped, handlers) != 0) {
+        VOX_LOG_ERROR("Failed to track replaced http handlers");
+    }
+}
+
+static vox_http_route_def_t* vox_http_router_find_def(vox_http_router_t* router,
+                                                      vox_http_method_t method,
+                                                      const char* path,
+                                                      size_t path_len,
+                                                      vox_http_route_def_t** prev_out) {
+    vox_http_route_def_t* prev = NULL;
+    for (vox_http_route_def_t* d = router->routes; d; prev = d, d = d->next) {
+        if (d->method == method && d->path_len == path_len && memcmp(d->path, path, path_len) == 0) {
+            if (prev_out) *prev_out = prev;
+            return d;
+        }
+    }
+    return NULL;
+}
+
+/* ===== 创建与销毁 ===== */
+
+vox_http_router_t* vox_http_router_create(vox_mpool_t* mpool) {
+    if (!mpool) return NULL;
+    vox_http_router_t* r = (vox_http_router_t*)vox_mpool_alloc(mpool, sizeof(vox_http_router_t));
+    if (!r) return NULL;
+    memset(r, 0, sizeof(*r));
+    r->mpool = mpool;
+    r->pool = vox_mpool_create();
+    if (!r->pool) goto fail;
+    if (vox_mutex_create(&r->lock) != 0) {
+        vox_mpool_destroy(r->pool);
+        r->pool = NULL;
+        goto fail;
+    }
+    r->names = vox_htable_create(r->pool);
+    r->dropped = vox_vector_create(r->pool);
+    /* 发布不频繁：每次退休旧快照都尝试回收 */
+    vox_ebr_config_t ebr_config = {0};
+    ebr_config.batch_size = 1;
+    r->ebr = vox_ebr_create_with_config(r->pool, &ebr_config);
+    if (!r->names || !r->dropped || !r->ebr) goto fail;
+
+    vox_http_rsnap_t* snap = vox_http_rsnap_create();
+    if (!snap) goto fail;
+    r->snapshots_built = 1;
+    vox_atomic_int_init(&r->pending, 0);
+    vox_atomic_ptr_init(&r->current, snap);
+    return r;
+
+fail:
+    VOX_LOG_ERROR("Failed to create http router");
+    if (r->pool) {
+        if (r->ebr) vox_ebr_destroy(r->ebr);
+        vox_mutex_destroy(&r->lock);
+        vox_mpool_destroy(r->pool);
+    }
+    vox_mpool_free(mpool, r);
+    return NULL;
+}
+
+void vox_http_router_destroy(vox_http_router_t* router) {
+    if (!router) return;
+    /* 先释放所有已退休的旧快照 */
+    vox_ebr_destroy(router->ebr);
+    if (router->handlers_free) {
+        size_t cnt = vox_vector_size(router->dropped);
+        for (size_t i = 0; i < cnt; i++) {
+            router->handlers_free(vox_vector_get(router->dropped, i), router->handlers_free_data);
+        }
+        for (vox_http_route_def_t* d = router->routes; d; d = d->next) {
+            router->handlers_free(d->handlers, router->handlers_free_data);
+        }
+    }
+    vox_http_rsnap_free((vox_http_rsnap_t*)vox_atomic_ptr_load(&router->current));
+    vox_http_rsnap_free(router->draft);
+    vox_mutex_destroy(&router->lock);
+    /* 路由定义与参数名随内部内存池一起释放 */
+    vox_mpool_destroy(router->pool);
+    vox_mpool_free(router->mpool, router);
+}
+
+void vox_http_router_set_handlers_free(vox_http_router_t* router, vox_ebr_free_func_t free_func, void* user_data) {
+    if (!router) return;
+    vox_mutex_lock(&router->lock);
+    router->handlers_free = free_func;
+    router->handlers_free_data = user_data;
+    vox_mutex_unlock(&router->lock);
+}
+
+/* ===== 修改 ===== */
+
+int vox_http_router_add(vox_http_router_t* router,
+                        vox_http_method_t method,
+                        const char* path,
+                        vox_http_handler_cb* handlers,
+                        size_t handler_count) {
+    if (!router || !path || !handlers || handler_count == 0) return -1;
     if (method <= VOX_HTTP_METHOD_UNKNOWN || method > VOX_HTTP_METHOD_PATCH) return -1;
     if (path[0] != '/') return -1;
 
+    size_t path_len = strlen(path);
     vox_http_trim_trailing_slash(&path, &path_len);
 
-    vox_http_rnode_t* node = router->roots[method];
-    if (!node) return -1;
+    int rc = -1;
+    vox_mutex_lock(&router->lock);
+    vox_http_rsnap_t* snap = vox_http_router_draft(router);
+    vox_http_rnode_t* node = snap ? vox_http_rsnap_insert(router, snap, method, path, path_len) : NULL;
+    if (!node) goto out;
+
+    vox_http_route_def_t* d = vox_http_router_find_def(router, method, path, path_len, NULL);
+    if (!d) {
+        d = (vox_http_route_def_t*)vox_mpool_alloc(router->pool, sizeof(vox_http_route_def_t) + path_len);
+        if (!d) goto out;
+        memset(d, 0, sizeof(*d));
+        d->method = method;
+        d->path_len = path_len;
+        memcpy(d->path, path, path_len);
+        d->path[path_len] = '\0';
+        if (router->routes_tail) router->routes_tail->next = d;
+        else router->routes = d;
+        router->routes_tail = d;
+        snap->route_count++;
+    } else if (d->handlers != handlers) {
+        vox_http_router_drop_handlers(router, d->handlers);
+    }
+    d->handlers = handlers;
+    d->handler_count = handler_count;
+
+    /* 终点写 handlers */
+    node->handlers = handlers;
+    node->handler_count = handler_count;
+    vox_http_router_touch(router);
+    rc = 0;
+
+out:
+    vox_mutex_unlock(&router->lock);
+    return rc;
+}
+
+int vox_http_router_remove(vox_http_router_t* router, vox_http_method_t method, const char* path) {
+    if (!router || !path || path[0] != '/') return -1;
+    size_t path_len = strlen(path);
+    vox_http_trim_trailing_slash(&path, &path_len);
+
+    int rc = -1;
+    vox_mutex_lock(&router->lock);
+    vox_http_route_def_t* prev = NULL;
+    vox_http_route_def_t* d = vox_http_router_find_def(router, method, path, path_len, &prev);
+    if (d) {
+        if (prev) prev->next = d->next;
+        else router->routes = d->next;
+        if (router->routes_tail == d) router->routes_tail = prev;
+        vox_http_router_drop_handlers(router, d->handlers);
+        vox_mpool_free(router->pool, d);
+        /* 树节点不删除，草稿按剩余定义重建 */
+        vox_http_router_drop_draft(router);
+        vox_http_router_touch(router);
+        rc = 0;
+    }
+    vox_mutex_unlock(&router->lock);
+    return rc;
+}
+
+void vox_http_router_clear(vox_http_router_t* router) {
+    if (!router) return;
+    vox_mutex_lock(&router->lock);
+    vox_http_route_def_t* d = router->routes;
+    while (d) {
+        vox_http_route_def_t* next = d->next;
+        vox_http_router_drop_handlers(router, d->handlers);
+        vox_mpool_free(router->pool, d);
+        d = next;
+    }
+    router->routes = NULL;
+    router->routes_tail = NULL;
+    vox_http_router_drop_draft(router);
+    vox_http_router_touch(router);
+    vox_mutex_unlock(&router->lock);
+}
+
+void vox_http_router_begin(vox_http_router_t* router) {
+    if (!router) return;
+    vox_mutex_lock(&router->lock);
+    /* 之前的修改先发布，批量内的修改到 commit 才可见 */
+    if (router->batch_depth == 0 && router->dirty) vox_http_router_publish(router);
+    router->batch_depth++;
+    vox_mutex_unlock(&router->lock);
+}
+
+int vox_http_router_commit(vox_http_router_t* router) {
+    if (!router) return -1;
+    int rc = 0;
+    vox_mutex_lock(&router->lock);
+    if (router->batch_depth > 0) router->batch_depth--;
+    if (router->batch_depth == 0 && router->dirty) {
+        rc = vox_http_router_publish(router);
+    }
+    vox_mutex_unlock(&router->lock);
+    return rc;
+}
+
+void vox_http_router_enter(vox_http_router_t* router) {
+    vox_ebr_thread_t* t = router ? vox_ebr_thread(router->ebr) : NULL;
+    if (t) vox_ebr_enter(t);
+}
+
+void vox_http_router_exit(vox_http_router_t* router) {
+    vox_ebr_thread_t* t = router ? vox_ebr_thread(router->ebr) : NULL;
+    if (t) vox_ebr_exit(t);
+}
+
+size_t vox_http_router_reclaim(vox_http_router_t* router) {
+    if (!router) return 0;
+    vox_http_router_sync(router);
+    vox_ebr_thread_t* t = vox_ebr_thread(router->ebr);
+    if (!t) return 0;
+    size_t n = 0;
+    /* 连续推进三次即可回收所有旧快照（前提是没有线程停留在匹配中） */
+    for (int i = 0; i < 3; i++) {
+        n += vox_ebr_collect(t);
+    }
+    return n;
+}
+
+size_t vox_http_router_route_count(vox_http_router_t* router) {
+    if (!router) return 0;
+    vox_http_router_sync(router);
+    vox_ebr_thread_t* t = vox_ebr_thread(router->ebr);
+    if (!t) return 0;
+    vox_ebr_enter(t);
+    const vox_http_rsnap_t* snap = (const vox_http_rsnap_t*)vox_atomic_ptr_load(&router->current);
+    size_t n = snap->route_count;
+    vox_ebr_exit(t);
+    return n;
+}
+
+size_t vox_http_router_snapshots_built(vox_http_router_t* router) {
+    if (!router) return 0;
+    vox_mutex_lock(&router->lock);
+    size_t n = router->snapshots_built;
+    vox_mutex_unlock(&router->lock);
+    return n;
+}
+
+/* ===== 匹配 ===== */
 
-    /* 预估 param 数：按 ':' 的数量估算 */
-    size_t param_cap = 0;
-    for (size_t k = 0; k < path_len; k++) if (path[k] == ':') param_cap++; /* 仅用于 add；match 这里按 '/' 数估算更稳 */
-    VOX_UNUSED(param_cap);
+/* 在快照上匹配（调用方已进入 EBR 临界区） */
+static int vox_http_rsnap_match(const vox_http_rsnap_t* snap,
+                                vox_http_method_t method,
+                                const char* path,
+                                size_t path_len,
+                                vox_mpool_t* mpool,
+                                vox_http_route_match_t* out) {
+    const vox_http_rnode_t* node = snap->roots[method];
     size_t params_count = 0;
-    size_t params_cap2 = 4;
-    vox_http_param_t* params = NULL;
+    size_t params_cap = VOX_HTTP_ROUTE_INLINE_PARAMS;
+    vox_http_param_t* params = out->inline_params;
 
     size_t i = 1;
     while (i <= path_len) {
@@ -218,18 +590,16 @@ int vox_http_router_match(vox_http_router_t* router,
         }
         if (node->param_child) {
             node = node->param_child;
-            if (params_count == 0) {
-                params = (vox_http_param_t*)vox_mpool_alloc(mpool, params_cap2 * sizeof(vox_http_param_t));
-                if (!params) return -1;
-            } else if (params_count >= params_cap2) {
-                /* mpool 无 realloc：一次性扩容到新数组并拷贝 */
-                size_t new_cap = params_cap2 * 2;
+            if (params_count >= params_cap) {
+                /* 超出内联容量：一次性扩容到新数组并拷贝（mpool 无 realloc） */
+                if (!mpool) return -1;
+                size_t new_cap = params_cap * 2;
                 vox_http_param_t* np = (vox_http_param_t*)vox_mpool_alloc(mpool, new_cap * sizeof(vox_http_param_t));
                 if (!np) return -1;
                 memcpy(np, params, params_count * sizeof(vox_http_param_t));
-                vox_mpool_free(mpool, params);
+                if (params != out->inline_params) vox_mpool_free(mpool, params);
                 params = np;
-                params_cap2 = new_cap;
+                params_cap = new_cap;
             }
             params[params_count].name = (vox_strview_t){ node->param_name, node->param_name_len };
             params[params_count].value = (vox_strview_t){ path + seg_start, seg_len };
@@ -237,14 +607,44 @@ int vox_http_router_match(vox_http_router_t* router,
             i++;
             continue;
         }
-        return -1;
+        goto fail;
     }
 
-    if (!node->handlers || node->handler_count == 0) return -1;
+    if (!node->handlers || node->handler_count == 0) goto fail;
     out->handlers = node->handlers;
     out->handler_count = node->handler_count;
-    out->params = params;
+    out->params = params_count > 0 ? params : NULL;
     out->param_count = params_count;
     return 0;
+
+fail:
+    if (params != out->inline_params) vox_mpool_free(mpool, params);
+    return -1;
 }
 
+int vox_http_router_match(vox_http_router_t* router,
+                          vox_http_method_t method,
+                          const char* path,
+                          size_t path_len,
+                          vox_mpool_t* mpool,
+                          vox_http_route_match_t* out) {
+    if (!out) return -1;
+    out->handlers = NULL;
+    out->handler_count = 0;
+    out->params = NULL;
+    out->param_count = 0;
+    if (!router || !path || path_len == 0) return -1;
+    if (method <= VOX_HTTP_METHOD_UNKNOWN || method > VOX_HTTP_METHOD_PATCH) return -1;
+    if (path[0] != '/') return -1;
+
+    vox_http_trim_trailing_slash(&path, &path_len);
+    vox_http_router_sync(router);
+
+    vox_ebr_thread_t* t = vox_ebr_thread(router->ebr);
+    if (!t) return -1;
+    vox_ebr_enter(t);
+    const vox_http_rsnap_t* snap = (const vox_http_rsnap_t*)vox_atomic_ptr_load(&router->current);
+    int rc = vox_http_rsnap_match(snap, method, path, path_len, mpool, out);
+    vox_ebr_exit(t);
+    return rc;
+}
@@ -1,6 +1,17 @@
 /*
  * vox_http_router.h - 高性能路由
  * 目标：支持精确匹配 + :param 参数 + group 前缀（通过上层在注册时拼接）
+ *
+ * 热更新（RCU）：
+ * - 路由树编译为不可变快照，修改在私有草稿上进行，完成后用原子指针交换整体发布
+ * - 匹配只加载当前快照并遍历，不加锁、不分配内存（参数不超过 VOX_HTTP_ROUTE_INLINE_PARAMS 时），
+ *   可以在任意线程（多个 loop）并发调用，也可以与 add/remove/commit 并发
+ * - 旧快照交给 vox_ebr 延迟回收：所有线程都离开匹配（越过静止点）后才释放
+ * - 匹配结果只引用调用方的 handlers 数组、router 内驻留的参数名和请求路径，快照被回收后仍然有效
+ * - 设置 handlers 释放函数后，被替换或删除的 handlers 数组同样交给 vox_ebr，
+ *   执行匹配结果须包在 vox_http_router_enter/exit 之间
+ * - 写操作之间由 router 内部加锁串行化；批量修改时用 begin/commit 包裹，只发布一次
+ * - 批量之外的修改积累在草稿中，由下一次匹配在锁内发布（启动时连续注册路由只构建一个快照）
  */
 
 #ifndef VOX_HTTP_ROUTER_H
@@ -8,6 +19,7 @@
 
 #include "../vox_os.h"
 #include "../vox_mpool.h"
+#include "../vox_ebr.h"
 #include "../vox_string.h"
 #include "vox_http_parser.h"
 #include "vox_http_middleware.h"
@@ -17,26 +29,55 @@
 extern "C" {
 #endif
 
+/* 匹配结果内联保存的参数个数，超出时才从 mpool 分配 */
+#define VOX_HTTP_ROUTE_INLINE_PARAMS 8
+
 typedef struct vox_http_router vox_http_router_t;
 
+/* 匹配结果：params 可能指向 inline_params，不要按值复制后使用副本的 params */
 typedef struct {
     vox_http_handler_cb* handlers;
     size_t handler_count;
     vox_http_param_t* params;
     size_t param_count;
+    vox_http_param_t inline_params[VOX_HTTP_ROUTE_INLINE_PARAMS];
 } vox_http_route_match_t;
 
+/* mpool 仅用于分配 router 结构本身；路由定义、参数名与快照使用内部内存池 */
 vox_http_router_t* vox_http_router_create(vox_mpool_t* mpool);
+
+/* 销毁 router 及所有快照（调用方须保证已没有线程在匹配） */
 void vox_http_router_destroy(vox_http_router_t* router);
 
-/* 注册路由：path 支持静态与 :param（不支持 *wildcard） */
+/* 可选：由 router 接管通过 add 注册的 handlers 数组
+ * - 被替换或删除的数组在不再被已发布快照引用后交给 vox_ebr，安全时以 (handlers, user_data) 调用 free_func
+ * - 销毁 router 时释放其余数组；每个数组只能注册到一条路由
+ * - free_func 可能在任意调用 router 接口的线程中执行 */
+void vox_http_router_set_handlers_free(vox_http_router_t* router, vox_ebr_free_func_t free_func, void* user_data);
+
+/* 注册路由：path 支持静态与 :param（不支持 *wildcard）；同一 method + path 重复注册时替换 handlers
+ * handlers 数组不被复制，须在 router 生命周期内保持有效
+ * 不在 begin/commit 之间时，之后的匹配即可见（在下一次匹配前发布） */
 int vox_http_router_add(vox_http_router_t* router,
                         vox_http_method_t method,
                         const char* path,
                         vox_http_handler_cb* handlers,
                         size_t handler_count);
 
-/* 匹配路由：path 必须是纯 path（不含 query） */
+/* 删除路由：不存在返回-1 */
+int vox_http_router_remove(vox_http_router_t* router, vox_http_method_t method, const char* path);
+
+/* 删除所有路由（常与 begin/commit 配合，整体替换路由表） */
+void vox_http_router_clear(vox_http_router_t* router);
+
+/* 开始批量修改：到匹配的 commit 之前，修改对匹配不可见（可嵌套） */
+void vox_http_router_begin(vox_http_router_t* router);
+
+/* 结束批量修改，最外层 commit 发布新快照；发布失败（内存不足）返回-1 */
+int vox_http_router_commit(vox_http_router_t* router);
+
+/* 匹配路由：path 必须是纯 path（不含 query）
+ * mpool 仅在参数个数超过 VOX_HTTP_ROUTE_INLINE_PARAMS 时使用，可为NULL */
 int vox_http_router_match(vox_http_router_t* router,
                           vox_http_method_t method,
                           const char* path,
@@ -44,9 +85,22 @@ int vox_http_router_match(vox_http_router_t* router,
                           vox_mpool_t* mpool,
                           vox_http_route_match_t* out);
 
+/* 进入/离开读临界区（可嵌套）：临界区内匹配得到的 handlers 不会被回收，
+ * 设置了 handlers 释放函数时须在执行完 handlers 之后才 exit */
+void vox_http_router_enter(vox_http_router_t* router);
+void vox_http_router_exit(vox_http_router_t* router);
+
+/* 尝试回收已无线程引用的旧快照与 handlers 数组（发布时会自动尝试），返回本次回收数量 */
+size_t vox_http_router_reclaim(vox_http_router_t* router);
+
+/* 当前快照中的路由数量 */
+size_t vox_http_router_route_count(vox_http_router_t* router);
+
+/* 已构建的快照数量（含创建时的空快照，统计用） */
+size_t vox_http_router_snapshots_built(vox_http_router_t* router);
+
 #ifdef __cplusplus
 }
 #endif
 
 #endif /* VOX_HTTP_ROUTER_H */
-
@@ -10,6 +10,34 @@
 #include "../vox_list.h"
 #include <string.h>
 
+/* sendfile 未能一次发完且无法等待 socket 可写（IOCP）时，剩余部分每次读入内存写出的块大小 */
+#define VOX_HTTP_SENDFILE_CHUNK (256 * 1024)
+
+/* pipeline 中的一个请求：解析累积、独立的 ctx 与已生成的响应
+ * 同一连接上的多个请求可同时处于处理中（含 defer），响应按到达顺序写回；写出后放回连接的空闲列表复用 */
+typedef struct vox_http_pipe_req {
+    vox_list_node_t node;
+
+    /* 解析累积 */
+    vox_string_t* url;
+    vox_string_t* body;
+    vox_vector_t* headers; /* element: vox_http_header_t* (name/value 为 mpool 拷贝后的 strview) */
+
+    /* Connection/Upgrade 相关 */
+    bool conn_keep_alive;
+    bool conn_close;
+    bool upgrade_websocket;
+
+    bool dispatching;       /* handler 链执行中：期间 finish 只生成响应，handler 返回后再写出 */
+    bool ready;             /* 响应已生成到 out，等待前面的请求写完 */
+    bool close_after_write; /* 写完该响应后关闭连接 */
+    vox_string_t* out;
+
+    vox_http_context_t ctx;
+    /* 路由匹配结果：ctx.params 可能指向其内联参数，须与 ctx 同寿命（defer 后仍会读取） */
+    vox_http_route_match_t route_match;
+} vox_http_pipe_req_t;
+
 typedef struct vox_http_conn {
     vox_list_node_t node;
     vox_http_server_t* server;
@@ -27,42 +55,47 @@ typedef struct vox_http_conn {
     bool handle_closed;
 
     vox_http_parser_t* parser;
-
-    /* 解析累积（按请求重置） */
-    vox_string_t* url;
-    vox_string_t* body;
     vox_string_t* cur_h_name;
     vox_string_t* cur_h_value;
-    vox_vector_t* headers; /* element: vox_http_header_t* (name/value 为 mpool 拷贝后的 strview) */
 
-    /* Connection/Upgrade 相关 */
-    bool conn_keep_alive;
-    bool conn_close;
-    bool upgrade_websocket;
+    /* pipeline：每个完整请求立即分发，未写出响应的请求按到达顺序排队 */
+    vox_http_pipe_req_t* cur; /* 正在解析的请求 */
+    vox_list_t pipeline;      /* 已分发、响应尚未写出的请求 */
+    vox_list_t free_reqs;     /* 可复用的请求 */
+    bool parsing;             /* 解析器执行中（写完成可能同步回调，防止重入解析） */
+    bool parse_stopped;       /* 已收到 Connection: close 或 Upgrade 请求：结果确定前不再解析后续数据 */
+    bool read_eof;            /* 对端已半关闭：已收到的请求写回后关闭 */
 
-    /* 写回相关（简化：每次只允许一个在途响应） */
+    /* 写回相关：一次只有一个在途写，连续已就绪的响应合并写出 */
     bool write_pending;
-    bool deferred_pending; /* defer 后阻止继续解析后续请求（pipeline 数据缓存到 pending_in） */
+    bool flushing;
     bool should_close_after_write;
-    vox_string_t* out;
-    vox_string_t* pending_in; /* 写回期间缓存的后续数据（pipeline） */
+    vox_string_t* out;        /* 在途写缓冲 */
+    vox_string_t* pending_in; /* 暂停解析期间缓存的后续数据（pipeline 已满或等待 Upgrade 结果） */
 
     /* WebSocket 模式 */
     bool ws_mode;
     bool ws_upgrade_pending;
     vox_http_ws_conn_t* ws;
 
+    /* HTTP/2（TLS 协商出 ALPN "h2"，或明文连接以连接前言开头）：请求由会话按流分发，不使用 pipeline */
+    bool proto_checked;        /* 明文连接已检查首个数据是否为 HTTP/2 连接前言 */
+    vox_http2_session_t* h2;
+    vox_string_t* h2_pending;  /* 会话已产生、等待写出的帧（写出时与 out 交换） */
+    bool h2_flushing;
+
     /* 客户端IP缓存（连接建立时获取，避免每次请求都调用getpeername） */
     char cached_ip[64];
     bool ip_cached;
+    vox_socket_addr_t peer_addr; /* 二进制对端地址（限流等按地址做键时避免字符串解析） */
+    bool peer_cached;
 
-    /* 当前 ctx（复用，避免反复分配） */
-    vox_http_context_t ctx;
-
-    /* sendfile：headers 写完后由 write_done 发送文件体并关闭 file */
+    /* sendfile：headers 写完后由 write_done 发送文件体并关闭（或归还）file */
     vox_file_t* sendfile_file;
     int64_t sendfile_offset;
     size_t sendfile_count;
+    void (*sendfile_release)(void* data);
+    void* sendfile_release_data;
 } vox_http_conn_t;
 
 struct vox_http_server {
@@ -74,145 +107,225 @@ struct vox_http_server {
     vox_tls_t* tls_server;
     vox_ssl_context_t* ssl_ctx;
 
+    vox_http2_config_t h2_config;
+    bool has_h2_config;
+
+    size_t max_pipeline; /* 每个连接同时处理的请求数上限 */
+
     vox_list_t conns;
 };
 
 /* vox_http_str_contains_token_ci 已移至 vox_http_internal.h */
 
-static void vox_http_conn_reset_request(vox_http_conn_t* c) {
-    if (!c) return;
-    if (c->url) vox_string_clear(c->url);
-    if (c->body) vox_string_clear(c->body);
-    if (c->cur_h_name) vox_string_clear(c->cur_h_name);
-    if (c->cur_h_value) vox_string_clear(c->cur_h_value);
-    if (c->headers) vox_vector_clear(c->headers);
-    c->conn_keep_alive = false;
-    c->conn_close = false;
-    c->upgrade_websocket = false;
-    memset(&c->ctx.req, 0, sizeof(c->ctx.req));
-    memset(&c->ctx.res, 0, sizeof(c->ctx.res));
-    c->ctx.params = NULL;
-    c->ctx.param_count = 0;
-    c->ctx.handlers = NULL;
-    c->ctx.handler_count = 0;
-    c->ctx.index = 0;
-    c->ctx.aborted = false;
-    c->ctx.deferred = false;
-    c->ctx.sendfile_file = NULL;
-    c->ctx.sendfile_offset = 0;
-    c->ctx.sendfile_count = 0;
-    c->ctx.res_has_connection_header = false;
-    c->deferred_pending = false;
+/* 释放 header 向量中的元素（每个 header 连同 name/value 是一次分配） */
+static void vox_http_free_header_elems(vox_mpool_t* mpool, vox_vector_t* headers) {
+    size_t cnt = vox_vector_size(headers);
+    for (size_t i = 0; i < cnt; i++) {
+        void* kv = vox_vector_get(headers, i);
+        if (kv) vox_mpool_free(mpool, kv);
+    }
+    vox_vector_clear(headers);
+}
+
+/* 清空请求（解析累积、响应与 ctx），ctx 重新指向本连接 */
+static void vox_http_pipe_req_reset(vox_http_conn_t* c, vox_http_pipe_req_t* r) {
+    vox_string_clear(r->url);
+    vox_string_clear(r->body);
+    vox_string_clear(r->out);
+    vox_http_free_header_elems(c->mpool, r->headers);
+    if (r->ctx.res.headers) {
+        vox_http_free_header_elems(c->mpool, (vox_vector_t*)r->ctx.res.headers);
+        vox_vector_destroy((vox_vector_t*)r->ctx.res.headers);
+    }
+    r->conn_keep_alive = false;
+    r->conn_close = false;
+    r->upgrade_websocket = false;
+    r->dispatching = false;
+    r->ready = false;
+    r->close_after_write = false;
+    vox_http_engine_release_chain(&r->ctx);
+    memset(&r->ctx, 0, sizeof(r->ctx));
+    r->ctx.mpool = c->mpool;
+    r->ctx.loop = c->server->loop;
+    r->ctx.engine = c->server->engine;
+    r->ctx.conn = c;
+}
+
+/* 取一个空闲请求（没有则新建） */
+static vox_http_pipe_req_t* vox_http_pipe_req_acquire(vox_http_conn_t* c) {
+    vox_http_pipe_req_t* r;
+    vox_list_node_t* n = vox_list_pop_front(&c->free_reqs);
+    if (n) {
+        r = vox_container_of(n, vox_http_pipe_req_t, node);
+    } else {
+        r = (vox_http_pipe_req_t*)vox_mpool_alloc(c->mpool, sizeof(vox_http_pipe_req_t));
+        if (!r) return NULL;
+        memset(r, 0, sizeof(*r));
+        vox_list_node_init(&r->node);
+        r->url = vox_string_create(c->mpool);
+        r->body = vox_string_create(c->mpool);
+        r->headers = vox_vector_create(c->mpool);
+        r->out = vox_string_create(c->mpool);
+        if (!r->url || !r->body || !r->headers || !r->out) {
+            if (r->url) vox_string_destroy(r->url);
+            if (r->body) vox_string_destroy(r->body);
+            if (r->headers) vox_vector_destroy(r->headers);
+            if (r->out) vox_string_destroy(r->out);
+            vox_mpool_free(c->mpool, r);
+            return NULL;
+        }
+    }
+    vox_http_pipe_req_reset(c, r);
+    return r;
 }
 
 /* forward declarations for send_response() dependencies */
 static int vox_http_res_has_header(const vox_vector_t* headers, const char* name);
-static bool vox_http_should_keep_alive(const vox_http_request_t* req, const vox_http_conn_t* c);
+static bool vox_http_should_keep_alive(const vox_http_request_t* req, const vox_http_pipe_req_t* r);
 static void vox_http_conn_close(vox_http_conn_t* c);
 static void vox_http_conn_try_destroy(vox_http_conn_t* c);
+static void vox_http_conn_flush(vox_http_conn_t* c);
 
-/* forward declarations for send_response() */
+/* forward declarations for flush() */
 static void vox_http_tcp_write_done(vox_tcp_t* tcp, int status, void* user_data);
 static void vox_http_tls_write_done(vox_tls_t* tls, int status, void* user_data);
 
-int vox_http_conn_send_response(void* conn) {
+/* 生成 ctx 的响应；它前面的请求都已写出时立即写出，否则等待 */
+int vox_http_conn_send_response(void* conn, vox_http_context_t* ctx) {
     vox_http_conn_t* c = (vox_http_conn_t*)conn;
-    if (!c) return -1;
+    if (!c || !ctx) return -1;
     if (!c->server || !c->server->engine) return -1;
     if (c->closing || c->handle_closed) return -1;
-    if (c->write_pending) return -1;
-    /* 进入写回阶段，解除 defer 阻塞 */
-    c->deferred_pending = false;
+    vox_http_pipe_req_t* r = vox_container_of(ctx, vox_http_pipe_req_t, ctx);
+    if (r->ready) return -1;
 
-    vox_http_context_t* ctx = &c->ctx;
-    /* TLS 无法使用 sendfile，将文件读入 body */
-    if (ctx->sendfile_file && c->is_tls) {
+    /* 用户态 TLS 无法使用 sendfile，将文件按偏移直接读入 body（pread，不依赖/不改变文件位置，共享 fd 安全）；
+     * 发送方向已卸载到内核 TLS 时由内核加密，仍可 sendfile */
+    if (ctx->sendfile_file && c->is_tls && !(c->tls && vox_tls_ktls_enabled(c->tls, VOX_SSL_KTLS_TX))) {
         vox_string_t* body = ctx->res.body ? ctx->res.body : vox_string_create(c->mpool);
         if (body) {
-            char buf[65536];
-            int64_t n;
-            if (ctx->sendfile_offset > 0 && vox_file_seek(ctx->sendfile_file, ctx->sendfile_offset, VOX_FILE_SEEK_SET) != 0) {
-                vox_file_close(ctx->sendfile_file);
-                ctx->sendfile_file = NULL;
-            } else {
-                size_t remain = ctx->sendfile_count;
-                while (remain > 0 && (n = vox_file_read(ctx->sendfile_file, buf, remain > sizeof(buf) ? sizeof(buf) : remain)) > 0) {
-                    vox_string_append_data(body, buf, (size_t)n);
-                    remain -= (size_t)n;
+            size_t base = vox_string_length(body);
+            if (vox_string_resize(body, base + ctx->sendfile_count) == 0) {
+                char* dst = (char*)vox_string_data(body) + base;
+                size_t done = 0;
+                int64_t n;
+                while (done < ctx->sendfile_count &&
+                       (n = vox_file_read_at(ctx->sendfile_file, dst + done, ctx->sendfile_count - done,
+                                             ctx->sendfile_offset + (int64_t)done)) > 0) {
+                    done += (size_t)n;
                 }
+                vox_string_resize(body, base + done);
                 if (!ctx->res.body) ctx->res.body = body;
-                vox_file_close(ctx->sendfile_file);
             }
-        } else {
-            vox_file_close(ctx->sendfile_file);
         }
+        vox_http_sendfile_release(ctx->sendfile_file, ctx->sendfile_release, ctx->sendfile_release_data);
         ctx->sendfile_file = NULL;
         ctx->sendfile_offset = 0;
         ctx->sendfile_count = 0;
+        ctx->sendfile_release = NULL;
+        ctx->sendfile_release_data = NULL;
     }
 
-    vox_http_request_t* req = &c->ctx.req;
-
     /* keep-alive / close 决策 */
-    bool keep_alive = vox_http_should_keep_alive(req, c);
-    c->should_close_after_write = !keep_alive;
+    bool keep_alive = vox_http_should_keep_alive(&ctx->req, r);
+    r->close_after_write = !keep_alive;
     /* WebSocket upgrade 后连接必须保持打开 */
     if (c->ws_upgrade_pending) {
-        c->should_close_after_write = false;
+        r->close_after_write = false;
     }
 
     /* 自动添加 Connection: close（若需要且用户未设置）；优先用缓存避免线性扫描 res.headers */
-    if (c->should_close_after_write) {
-        if (!c->ctx.res_has_connection_header &&
-            (!c->ctx.res.headers || !vox_http_res_has_header((const vox_vector_t*)c->ctx.res.headers, "Connection"))) {
-            vox_http_context_header(&c->ctx, "Connection", "close");
+    if (r->close_after_write) {
+        if (!ctx->res_has_connection_header &&
+            (!ctx->res.headers || !vox_http_res_has_header((const vox_vector_t*)ctx->res.headers, "Connection"))) {
+            vox_http_context_header(ctx, "Connection", "close");
         }
     }
 
-    if (!c->out) c->out = vox_string_create(c->mpool);
-    if (!c->out) return -1;
-    if (vox_http_context_build_response(&c->ctx, c->out) != 0) return -1;
+    /* 若使用 sendfile，out 中只有 headers，file 留在 ctx，轮到它写出时交给 conn */
+    if (vox_http_context_build_response(ctx, r->out) != 0) return -1;
+    r->ready = true;
+    ctx->deferred = false;
 
-    /* 若使用 sendfile，将 file 交给 conn，headers 已写入 out */
-    if (ctx->sendfile_file && !c->is_tls) {
-        c->sendfile_file = ctx->sendfile_file;
-        c->sendfile_offset = ctx->sendfile_offset;
-        c->sendfile_count = ctx->sendfile_count;
-        ctx->sendfile_file = NULL;
-    } else {
-        c->sendfile_file = NULL;
-    }
+    if (!r->dispatching) vox_http_conn_flush(c);
+    return 0;
+}
 
-    /* 暂停读取，避免 pipeline 触发并发响应 */
-    if (c->is_tls) {
-        if (c->tls) vox_tls_read_stop(c->tls);
-    } else {
-        if (c->tcp) vox_tcp_read_stop(c->tcp);
-    }
+/* 按到达顺序写出已就绪的响应：队首仍在处理（如 defer）时其后已就绪的响应等待。
+ * 连续就绪的响应合并为一次写；带 sendfile 或写后关闭的响应之后单独发起下一次写。
+ * 写完成可能在 write 内同步回调，由 flushing 防止重入，循环继续 */
+static void vox_http_conn_after_write(vox_http_conn_t* c);
+
+static void vox_http_conn_flush(vox_http_conn_t* c) {
+    if (c->flushing) return;
+    c->flushing = true;
+    bool wrote = false;
+    while (!c->write_pending && !c->closing && !c->should_close_after_write) {
+        vox_string_clear(c->out);
+        vox_list_node_t* n;
+        while ((n = vox_list_first(&c->pipeline)) != NULL) {
+            vox_http_pipe_req_t* r = vox_container_of(n, vox_http_pipe_req_t, node);
+            if (!r->ready || r->dispatching) break;
+            vox_list_remove(&c->pipeline, n);
+            /* vox_tcp_write 不复制数据：响应移入 conn 的写缓冲，请求随即可复用 */
+            if (vox_string_length(c->out) == 0) {
+                vox_string_t* t = c->out;
+                c->out = r->out;
+                r->out = t;
+            } else if (vox_string_append_data(c->out, vox_string_data(r->out), vox_string_length(r->out)) != 0) {
+                vox_http_pipe_req_reset(c, r);
+                vox_list_push_back(&c->free_reqs, &r->node);
+                vox_http_conn_close(c);
+                break;
+            }
+            bool stop = false;
+            if (r->ctx.sendfile_file) {
+                c->sendfile_file = r->ctx.sendfile_file;
+                c->sendfile_offset = r->ctx.sendfile_offset;
+                c->sendfile_count = r->ctx.sendfile_count;
+                c->sendfile_release = r->ctx.sendfile_release;
+                c->sendfile_release_data = r->ctx.sendfile_release_data;
+                r->ctx.sendfile_file = NULL;
+                r->ctx.sendfile_release = NULL;
+                r->ctx.sendfile_release_data = NULL;
+                stop = true;
+            }
+            if (r->close_after_write) {
+                c->should_close_after_write = true;
+                stop = true;
+            }
+            vox_http_pipe_req_reset(c, r);
+            vox_list_push_back(&c->free_reqs, &r->node);
+            if (stop) break;
+        }
+        if (c->closing || vox_string_length(c->out) == 0) break;
 
-    c->write_pending = true;
-    const void* buf = vox_string_data(c->out);
-    size_t blen = vox_string_length(c->out);
-    if (c->is_tls) {
-        if (!c->tls) return -1;
-        if (vox_tls_write(c->tls, buf, blen, vox_http_tls_write_done) != 0) {
-            c->write_pending = false;
-            vox_http_conn_close(c);
-            return -1;
+        c->write_pending = true;
+        const void* buf = vox_string_data(c->out);
+        size_t blen = vox_string_length(c->out);
+        int rc;
+        if (c->is_tls) {
+            rc = c->tls ? vox_tls_write(c->tls, buf, blen, vox_http_tls_write_done) : -1;
+        } else {
+            rc = c->tcp ? vox_tcp_write(c->tcp, buf, blen, vox_http_tcp_write_done) : -1;
         }
-    } else {
-        if (!c->tcp) return -1;
-        if (vox_tcp_write(c->tcp, buf, blen, vox_http_tcp_write_done) != 0) {
+        if (rc != 0) {
             c->write_pending = false;
             vox_http_conn_close(c);
-            return -1;
+            break;
         }
+        wrote = true;
+    }
+    c->flushing = false;
+    /* 最后一次写已同步完成：由这里处理写后的关闭、协议切换与继续解析 */
+    if (wrote && !c->write_pending && !c->closing) {
+        vox_http_conn_after_write(c);
     }
-    return 0;
 }
 
 static int vox_http_conn_commit_header(vox_http_conn_t* c) {
-    if (!c || !c->headers || !c->cur_h_name || !c->cur_h_value) return 0;
+    if (!c || !c->cur || !c->cur_h_name || !c->cur_h_value) return 0;
+    vox_http_pipe_req_t* r = c->cur;
     size_t nlen = vox_string_length(c->cur_h_name);
     if (nlen == 0) return 0;
     size_t vlen = vox_string_length(c->cur_h_value);
@@ -220,38 +333,22 @@ static int vox_http_conn_commit_header(vox_http_conn_t* c) {
     const char* nsrc = vox_string_cstr(c->cur_h_name);
     const char* vsrc = vox_string_cstr(c->cur_h_value);
 
-    vox_http_header_t* kv = (vox_http_header_t*)vox_mpool_alloc(c->mpool, sizeof(vox_http_header_t));
+    vox_http_header_t* kv = vox_http_header_alloc(c->mpool, nsrc, nlen, vsrc, vlen);
     if (!kv) return -1;
-
-    char* ncopy = (char*)vox_mpool_alloc(c->mpool, nlen + 1);
-    char* vcopy = (char*)vox_mpool_alloc(c->mpool, vlen + 1);
-    if (!ncopy || !vcopy) {
+    if (vox_vector_push(r->headers, kv) != 0) {
         vox_mpool_free(c->mpool, kv);
         return -1;
     }
-    memcpy(ncopy, nsrc, nlen);
-    ncopy[nlen] = '\0';
-    memcpy(vcopy, vsrc, vlen);
-    vcopy[vlen] = '\0';
-
-    kv->name = (vox_strview_t){ ncopy, nlen };
-    kv->value = (vox_strview_t){ vcopy, vlen };
-    if (vox_vector_push(c->headers, kv) != 0) {
-        vox_mpool_free(c->mpool, kv);
-        vox_mpool_free(c->mpool, ncopy);
-        vox_mpool_free(c->mpool, vcopy);
-        return -1;
-    }
 
     /* Connection/Upgrade/WS 相关快速判断 */
     if (vox_http_strieq(kv->name.ptr, kv->name.len, "Connection", 10)) {
-        if (vox_http_str_contains_token_ci(kv->value.ptr, kv->value.len, "close")) c->conn_close = true;
-        if (vox_http_str_contains_token_ci(kv->value.ptr, kv->value.len, "keep-alive")) c->conn_keep_alive = true;
+        if (vox_http_str_contains_token_ci(kv->value.ptr, kv->value.len, "close")) r->conn_close = true;
+        if (vox_http_str_contains_token_ci(kv->value.ptr, kv->value.len, "keep-alive")) r->conn_keep_alive = true;
         if (vox_http_str_contains_token_ci(kv->value.ptr, kv->value.len, "upgrade")) {
             /* 仅标记，具体 upgrade 类型在 Upgrade 头里看 */
         }
     } else if (vox_http_strieq(kv->name.ptr, kv->name.len, "Upgrade", 7)) {
-        if (vox_http_str_contains_token_ci(kv->value.ptr, kv->value.len, "websocket")) c->upgrade_websocket = true;
+        if (vox_http_str_contains_token_ci(kv->value.ptr, kv->value.len, "websocket")) r->upgrade_websocket = true;
     }
 
     vox_string_clear(c->cur_h_name);
@@ -271,14 +368,14 @@ static int vox_http_res_has_header(const vox_vector_t* headers, const char* name
     return 0;
 }
 
-static bool vox_http_should_keep_alive(const vox_http_request_t* req, const vox_http_conn_t* c) {
-    if (!req || !c) return false;
+static bool vox_http_should_keep_alive(const vox_http_request_t* req, const vox_http_pipe_req_t* r) {
+    if (!req || !r) return false;
     /* HTTP/1.1 默认 keep-alive；HTTP/1.0 默认 close */
     bool keep = (req->http_major > 1) || (req->http_major == 1 && req->http_minor == 1);
     if (req->http_major == 1 && req->http_minor == 0) keep = false;
 
-    if (c->conn_close) keep = false;
-    if (c->conn_keep_alive) keep = true;
+    if (r->conn_close) keep = false;
+    if (r->conn_keep_alive) keep = true;
     return keep;
 }
 
@@ -309,10 +406,36 @@ static void vox_http_conn_close(vox_http_conn_t* c) {
     }
 }
 
+static void vox_http_conn_drop_sendfile(vox_http_conn_t* c) {
+    if (c->sendfile_file) {
+        vox_http_sendfile_release(c->sendfile_file, c->sendfile_release, c->sendfile_release_data);
+        c->sendfile_file = NULL;
+        c->sendfile_release = NULL;
+        c->sendfile_release_data = NULL;
+    }
+    /* 尚未轮到写出的响应 */
+    vox_list_node_t* pos;
+    vox_list_for_each(pos, &c->pipeline) {
+        vox_http_pipe_req_t* r = vox_container_of(pos, vox_http_pipe_req_t, node);
+        if (r->ctx.sendfile_file) {
+            vox_http_sendfile_release(r->ctx.sendfile_file, r->ctx.sendfile_release, r->ctx.sendfile_release_data);
+            r->ctx.sendfile_file = NULL;
+            r->ctx.sendfile_release = NULL;
+            r->ctx.sendfile_release_data = NULL;
+        }
+    }
+}
+
 static void vox_http_conn_try_destroy(vox_http_conn_t* c) {
     if (!c) return;
     if (!c->handle_closed) return;
     if (c->defer_refs != 0) return;
+    /* 连接中途断开时归还尚未发送的文件（缓存 fd 依赖引用计数）与 defer 请求保留的处理链 */
+    vox_http_conn_drop_sendfile(c);
+    vox_list_node_t* pos;
+    vox_list_for_each(pos, &c->pipeline) {
+        vox_http_engine_release_chain(&vox_container_of(pos, vox_http_pipe_req_t, node)->ctx);
+    }
     /* conn 本体与其所有资源都来自 conn->mpool */
     if (c->mpool) {
         vox_mpool_destroy(c->mpool);
@@ -328,6 +451,11 @@ static void vox_http_conn_on_handle_closed(vox_handle_t* handle) {
         vox_list_remove(&s->conns, &c->node);
     }
     c->handle_closed = true;
+    if (c->h2) {
+        /* 归还各流的资源；defer 中的流由其 finish 释放 defer hold */
+        vox_http2_session_destroy(c->h2);
+        c->h2 = NULL;
+    }
     vox_http_conn_try_destroy(c);
 }
 
@@ -335,15 +463,23 @@ static int vox_http_on_message_begin(void* parser) {
     vox_http_parser_t* p = (vox_http_parser_t*)parser;
     vox_http_conn_t* c = (vox_http_conn_t*)vox_http_parser_get_user_data(p);
     if (!c) return -1;
-    vox_http_conn_reset_request(c);
+    /* 数据不足时解析器会从请求开头重新解析，此时复用 cur 并清空 */
+    if (c->cur) {
+        vox_http_pipe_req_reset(c, c->cur);
+    } else {
+        c->cur = vox_http_pipe_req_acquire(c);
+        if (!c->cur) return -1;
+    }
+    vox_string_clear(c->cur_h_name);
+    vox_string_clear(c->cur_h_value);
     return 0;
 }
 
 static int vox_http_on_url(void* parser, const char* data, size_t len) {
     vox_http_parser_t* p = (vox_http_parser_t*)parser;
     vox_http_conn_t* c = (vox_http_conn_t*)vox_http_parser_get_user_data(p);
-    if (!c || !c->url) return -1;
-    if (len > 0) vox_string_append_data(c->url, data, len);
+    if (!c || !c->cur) return -1;
+    if (len > 0) vox_string_append_data(c->cur->url, data, len);
     return 0;
 }
 
@@ -370,21 +506,22 @@ static int vox_http_on_header_value(void* parser, const char* data, size_t len)
 static int vox_http_on_headers_complete(void* parser) {
     vox_http_parser_t* p = (vox_http_parser_t*)parser;
     vox_http_conn_t* c = (vox_http_conn_t*)vox_http_parser_get_user_data(p);
-    if (!c) return -1;
+    if (!c || !c->cur) return -1;
 
     if (vox_http_conn_commit_header(c) != 0) return -1;
 
-    vox_http_request_t* req = &c->ctx.req;
+    vox_http_pipe_req_t* r = c->cur;
+    vox_http_request_t* req = &r->ctx.req;
     req->method = vox_http_parser_get_method(p);
     req->http_major = vox_http_parser_get_http_major(p);
     req->http_minor = vox_http_parser_get_http_minor(p);
     req->is_upgrade = vox_http_parser_is_upgrade(p);
-    req->headers = c->headers;
-    req->body = c->body;
+    req->headers = r->headers;
+    req->body = r->body;
 
     /* raw_url/path/query */
-    const char* u = c->url ? vox_string_cstr(c->url) : NULL;
-    size_t ulen = c->url ? vox_string_length(c->url) : 0;
+    const char* u = vox_string_cstr(r->url);
+    size_t ulen = vox_string_length(r->url);
     if (!u || ulen == 0) {
         req->raw_url = (vox_strview_t)VOX_STRVIEW_NULL;
         req->path = (vox_strview_t)VOX_STRVIEW_NULL;
@@ -410,90 +547,53 @@ static int vox_http_on_headers_complete(void* parser) {
 static int vox_http_on_body(void* parser, const char* data, size_t len) {
     vox_http_parser_t* p = (vox_http_parser_t*)parser;
     vox_http_conn_t* c = (vox_http_conn_t*)vox_http_parser_get_user_data(p);
-    if (!c || !c->body) return -1;
-    if (len > 0) vox_string_append_data(c->body, data, len);
+    if (!c || !c->cur) return -1;
+    if (len > 0) vox_string_append_data(c->cur->body, data, len);
     return 0;
 }
 
 static void vox_http_tcp_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void* user_data);
-static void vox_http_tcp_write_done(vox_tcp_t* tcp, int status, void* user_data);
 static void vox_http_tls_read_cb(vox_tls_t* tls, ssize_t nread, const void* buf, void* user_data);
-static void vox_http_tls_write_done(vox_tls_t* tls, int status, void* user_data);
 static void vox_http_tcp_ws_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void* user_data);
 static void vox_http_tls_ws_read_cb(vox_tls_t* tls, ssize_t nread, const void* buf, void* user_data);
 
+static void vox_http_conn_read_stop(vox_http_conn_t* c) {
+    if (c->is_tls) {
+        if (c->tls) vox_tls_read_stop(c->tls);
+    } else {
+        if (c->tcp) vox_tcp_read_stop(c->tcp);
+    }
+}
+
 static int vox_http_on_message_complete(void* parser) {
     vox_http_parser_t* p = (vox_http_parser_t*)parser;
     vox_http_conn_t* c = (vox_http_conn_t*)vox_http_parser_get_user_data(p);
-    if (!c || !c->server || !c->server->engine) return -1;
-    if (c->write_pending || c->deferred_pending) {
-        /* 简化：不允许并发响应（pipeline 数据会缓存到 pending_in） */
-        return 0;
-    }
+    if (!c || !c->cur || !c->server || !c->server->engine) return -1;
 
-    vox_http_engine_t* engine = c->server->engine;
-    vox_http_router_t* router = vox_http_engine_get_router(engine);
-    if (!router) return -1;
-
-    vox_http_request_t* req = &c->ctx.req;
-
-    vox_http_route_match_t match;
-    memset(&match, 0, sizeof(match));
-
-    int match_rc = -1;
-    if (req->path.ptr && req->path.len > 0) {
-        match_rc = vox_http_router_match(router, req->method, req->path.ptr, req->path.len, c->mpool, &match);
-    }
-
-    /* 初始化 ctx 基本字段 */
-    c->ctx.mpool = c->mpool;
-    c->ctx.loop = c->server->loop;
-    c->ctx.engine = engine;
-    c->ctx.conn = c;
-    c->ctx.user_data = NULL;
-    c->ctx.res.status = 0;
-    c->ctx.res.headers = NULL;
-    c->ctx.res.body = NULL;
-    c->ctx.index = 0;
-    c->ctx.aborted = false;
-    c->ctx.deferred = false;
-
-    if (match_rc != 0) {
-        /* 404 */
-        c->ctx.handlers = NULL;
-        c->ctx.handler_count = 0;
-        c->ctx.params = NULL;
-        c->ctx.param_count = 0;
-        vox_http_context_status(&c->ctx, 404);
-        vox_http_context_write_cstr(&c->ctx, "404 Not Found");
-    } else {
-        c->ctx.handlers = match.handlers;
-        c->ctx.handler_count = match.handler_count;
-        c->ctx.params = match.params;
-        c->ctx.param_count = match.param_count;
-        /* 执行 middleware chain */
-        vox_http_context_next(&c->ctx);
-        if (!c->ctx.deferred) {
-            if (!c->ctx.res.status) {
-                /* 若 handler 未设置状态，默认 200 */
-                c->ctx.res.status = 200;
-            }
-        }
+    vox_http_pipe_req_t* r = c->cur;
+    c->cur = NULL;
+    vox_list_push_back(&c->pipeline, &r->node);
+
+    /* 连接将关闭或切换协议：其后的数据在该请求的响应写出前不再解析 */
+    if (r->upgrade_websocket || r->ctx.req.is_upgrade || !vox_http_should_keep_alive(&r->ctx.req, r)) {
+        c->parse_stopped = true;
+        vox_http_conn_read_stop(c);
     }
 
-    /* defer：handler 返回后不立即发送，等待 finish() */
-    if (c->ctx.deferred) {
-        c->deferred_pending = true;
-        /* 暂停读取，避免 pipeline 覆盖 ctx */
-        if (c->is_tls) {
-            if (c->tls) vox_tls_read_stop(c->tls);
-        } else {
-            if (c->tcp) vox_tcp_read_stop(c->tcp);
-        }
+    /* 每个请求有独立的 ctx：defer 的请求不阻塞后续请求的处理，只是响应按顺序等待 */
+    r->dispatching = true;
+    vox_http_engine_dispatch(c->server->engine, &r->ctx, &r->route_match);
+    r->dispatching = false;
+
+    if (r->ready) {
+        /* handler 内 defer 后已 finish */
+        vox_http_conn_flush(c);
         return 0;
     }
+    /* defer：handler 返回后不立即发送，等待 finish() */
+    if (r->ctx.deferred) return 0;
 
-    return vox_http_conn_send_response(c);
+    return vox_http_conn_send_response(c, &r->ctx);
 }
 
 static int vox_http_on_error(void* parser, const char* message) {
@@ -504,33 +604,196 @@ static int vox_http_on_error(void* parser, const char* message) {
     return 0;
 }
 
-static void vox_http_drain_pending(vox_http_conn_t* c) {
-    if (!c || !c->pending_in || c->write_pending || c->deferred_pending) return;
-    size_t plen = vox_string_length(c->pending_in);
-    if (plen == 0) return;
+/* 是否继续解析后续请求：处理中的请求数未达上限，且没有等待结果的 close/Upgrade 请求 */
+static bool vox_http_conn_can_parse(const vox_http_conn_t* c) {
+    return !c->closing && !c->parse_stopped && !c->ws_mode && !c->ws_upgrade_pending &&
+           vox_list_size(&c->pipeline) < c->server->max_pipeline;
+}
 
-    const char* p = (const char*)vox_string_data(c->pending_in);
-    size_t left = plen;
-    while (left > 0 && !c->write_pending && !c->deferred_pending) {
-        ssize_t n = vox_http_parser_execute(c->parser, p, left);
-        if (n < 0) {
-            vox_http_conn_close(c);
+/* 解析数据，每个完整请求立即分发；不能继续解析时停止
+ * 返回已交给解析器的字节数（不完整的请求由解析器内部缓存），剩余部分由调用方缓存 */
+static size_t vox_http_conn_parse(vox_http_conn_t* c, const char* data, size_t len) {
+    if (c->parsing) return 0;
+    c->parsing = true;
+    size_t off = 0;
+    while (off < len && vox_http_conn_can_parse(c)) {
+        /* 返回值包含之前缓存的字节（请求跨多次读取时），只有超出部分来自本次 data */
+        size_t buffered = vox_http_parser_get_buffered(c->parser);
+        ssize_t n = vox_http_parser_execute(c->parser, data + off, len - off);
+        if (n < 0 || c->closing) {
+            if (n < 0) vox_http_conn_close(c);
+            off = len;
+            break;
+        }
+        if (!vox_http_parser_is_complete(c->parser)) {
+            off = len;
             break;
         }
-        if (n == 0) break;
-        p += (size_t)n;
-        left -= (size_t)n;
-        if (c->write_pending || c->deferred_pending) break;
+        /* 一个请求结束：重置解析器（丢弃其内部缓冲的剩余部分），从下一个请求开头继续喂入 */
+        vox_http_parser_reset(c->parser);
+        off += (size_t)n > buffered ? (size_t)n - buffered : 0;
     }
-    /* 移除已消费的数据 */
-    if (left == 0) {
+    c->parsing = false;
+    return off;
+}
+
+/* Upgrade 请求的 101 已写出：切换到 WS 读循环，不再解析 HTTP（解析进行中时由解析的调用方随后切换） */
+static bool vox_http_conn_try_switch_ws(vox_http_conn_t* c) {
+    if (!c->ws_upgrade_pending || !c->ws || c->parsing || c->write_pending || c->closing) return false;
+    if (!vox_list_empty(&c->pipeline)) return false;
+    c->ws_upgrade_pending = false;
+    c->ws_mode = true;
+    /* 若握手期间已经缓存了后续数据（极少见），先喂给 ws 解析器 */
+    if (vox_string_length(c->pending_in) > 0) {
+        (void)vox_http_ws_internal_feed(c->ws, vox_string_data(c->pending_in), vox_string_length(c->pending_in));
         vox_string_clear(c->pending_in);
+    }
+    if (c->is_tls) {
+        if (c->tls) vox_tls_read_start(c->tls, NULL, vox_http_tls_ws_read_cb);
     } else {
-        size_t consumed = plen - left;
-        if (consumed > 0) {
-            vox_string_remove(c->pending_in, 0, consumed);
+        if (c->tcp) vox_tcp_read_start(c->tcp, NULL, vox_http_tcp_ws_read_cb);
+    }
+    vox_http_ws_internal_on_open(c->ws);
+    return true;
+}
+
+/* 从连接读到的 HTTP/1.x 数据：不能继续解析时缓存剩余数据并暂停读取 */
+static void vox_http_conn_on_data(vox_http_conn_t* c, const char* data, size_t len) {
+    size_t used = 0;
+    if (vox_string_length(c->pending_in) == 0) {
+        used = vox_http_conn_parse(c, data, len);
+    }
+    if (c->closing) return;
+    if (used < len) {
+        if (vox_string_append_data(c->pending_in, data + used, len - used) != 0) {
+            vox_http_conn_close(c);
+            return;
         }
+        vox_http_conn_read_stop(c);
     }
+    (void)vox_http_conn_try_switch_ws(c);
+}
+
+/* 对端半关闭（读到 EOF）：仍有处理中的请求时停止读取，等响应按顺序写回后再关闭 */
+static bool vox_http_conn_hold_on_eof(vox_http_conn_t* c) {
+    if (c->closing || c->ws_mode || c->h2) return false;
+    if (vox_list_empty(&c->pipeline) && !c->write_pending) return false;
+    c->read_eof = true;
+    vox_http_conn_read_stop(c);
+    return true;
+}
+
+/* 有请求写出后：先解析暂停期间缓存的数据，全部消费后恢复读取 */
+static void vox_http_conn_resume_input(vox_http_conn_t* c) {
+    if (c->closing || c->parsing || c->ws_mode || c->h2) return;
+    /* close/Upgrade 请求的响应已写出且连接未关闭、未切换协议（如 Upgrade 被拒绝）：继续按 HTTP 解析 */
+    if (c->parse_stopped && vox_list_empty(&c->pipeline) && !c->ws_upgrade_pending) {
+        c->parse_stopped = false;
+    }
+    size_t plen = vox_string_length(c->pending_in);
+    if (plen > 0) {
+        size_t used = vox_http_conn_parse(c, (const char*)vox_string_data(c->pending_in), plen);
+        if (c->closing) return;
+        if (used >= plen) {
+            vox_string_clear(c->pending_in);
+        } else if (used > 0) {
+            vox_string_remove(c->pending_in, 0, used);
+        }
+        if (vox_http_conn_try_switch_ws(c)) return;
+    }
+    if (c->read_eof) {
+        if (vox_list_empty(&c->pipeline) && !c->write_pending) vox_http_conn_close(c);
+        return;
+    }
+    if (vox_string_length(c->pending_in) == 0 && vox_http_conn_can_parse(c)) {
+        if (c->is_tls) {
+            if (c->tls) vox_tls_read_start(c->tls, NULL, vox_http_tls_read_cb);
+        } else {
+            if (c->tcp) vox_tcp_read_start(c->tcp, NULL, vox_http_tcp_read_cb);
+        }
+    }
+}
+
+/* kTLS 连接等待底层 socket 可写：tcp 的 data 是 tls，转给 tls 写完成回调 */
+static void vox_http_ktls_writable(vox_tcp_t* tcp, int status, void* user_data) {
+    VOX_UNUSED(tcp);
+    vox_tls_t* tls = (vox_tls_t*)user_data;
+    if (!tls) return;
+    vox_http_tls_write_done(tls, status, vox_handle_get_data((vox_handle_t*)tls));
+}
+
+/* 发送 conn 上剩余的文件体。
+ * 非阻塞 socket 上 sendfile 可能只发出一部分（发送缓冲区满）：等 socket 可写后回到 write_done，
+ * 从保存的偏移继续 sendfile，直到发送完毕。无法等待可写（IOCP）时剩余部分按块读入 out 走普通异步写。
+ * 返回 1 表示已发起异步等待/写，0 表示文件已发完（file 已释放），-1 表示出错（file 已释放） */
+static int vox_http_conn_pump_sendfile(vox_http_conn_t* c, vox_socket_t* sock) {
+    intptr_t fd = vox_file_get_fd(c->sendfile_file);
+    size_t sent = 0;
+    errno = 0;
+    (void)vox_socket_sendfile(sock, fd, c->sendfile_offset, c->sendfile_count, &sent);
+    int err = errno;
+    c->sendfile_offset += (int64_t)sent;
+    c->sendfile_count -= sent;
+    if (c->sendfile_count == 0) {
+        vox_http_sendfile_release(c->sendfile_file, c->sendfile_release, c->sendfile_release_data);
+        c->sendfile_file = NULL;
+        c->sendfile_release = NULL;
+        c->sendfile_release_data = NULL;
+        return 0;
+    }
+
+#ifndef VOX_OS_WINDOWS
+    /* 一个字节都没发出且不是缓冲区满：对端已断开或文件被截断，无法补齐 Content-Length */
+    if (sent == 0 && err != EAGAIN && err != EWOULDBLOCK && err != EINTR) {
+        vox_http_conn_drop_sendfile(c);
+        return -1;
+    }
+#else
+    VOX_UNUSED(err);
+#endif
+    c->write_pending = true;
+    int wait = c->is_tls
+        ? vox_tcp_poll_writable(c->tls->tcp, vox_http_ktls_writable)
+        : vox_tcp_poll_writable(c->tcp, vox_http_tcp_write_done);
+    if (wait == 0) return 1;
+    c->write_pending = false;
+
+    size_t chunk = c->sendfile_count < VOX_HTTP_SENDFILE_CHUNK ? c->sendfile_count : VOX_HTTP_SENDFILE_CHUNK;
+    int64_t n = -1;
+    vox_string_clear(c->out);
+    if (vox_string_resize(c->out, chunk) == 0) {
+        n = vox_file_read_at(c->sendfile_file, (char*)vox_string_data(c->out), chunk, c->sendfile_offset);
+    }
+    if (n <= 0) {
+        vox_http_conn_drop_sendfile(c);
+        return -1;
+    }
+    vox_string_resize(c->out, (size_t)n);
+    c->sendfile_offset += n;
+    c->sendfile_count -= (size_t)n;
+    c->write_pending = true;
+    int ret = c->is_tls
+        ? vox_tls_write(c->tls, vox_string_data(c->out), (size_t)n, vox_http_tls_write_done)
+        : vox_tcp_write(c->tcp, vox_string_data(c->out), (size_t)n, vox_http_tcp_write_done);
+    if (ret != 0) {
+        c->write_pending = false;
+        vox_http_conn_drop_sendfile(c);
+        return -1;
+    }
+    return 1;
+}
+
+/* 一次写（含 sendfile 文件体）完成后：关闭、切换到 WebSocket，或写出后续响应并继续解析 */
+static void vox_http_conn_after_write(vox_http_conn_t* c) {
+    if (c->should_close_after_write) {
+        vox_http_conn_close(c);
+        return;
+    }
+    if (vox_http_conn_try_switch_ws(c)) return;
+
+    /* 写出已就绪的后续响应，再消费 pipeline 缓存 */
+    vox_http_conn_flush(c);
+    vox_http_conn_resume_input(c);
 }
 
 static void vox_http_tcp_write_done(vox_tcp_t* tcp, int status, void* user_data) {
@@ -539,60 +802,65 @@ static void vox_http_tcp_write_done(vox_tcp_t* tcp, int status, void* user_data)
     if (!c) return;
     c->write_pending = false;
     if (status != 0) {
-        if (c->sendfile_file) {
-            vox_file_close(c->sendfile_file);
-            c->sendfile_file = NULL;
-        }
+        vox_http_conn_drop_sendfile(c);
         vox_http_conn_close(c);
         return;
     }
     /* sendfile：headers 已发送，再发送文件体 */
     if (c->sendfile_file && c->tcp) {
-        intptr_t fd = vox_file_get_fd(c->sendfile_file);
-        size_t sent = 0;
-        int r = vox_socket_sendfile(&c->tcp->socket, fd, c->sendfile_offset, c->sendfile_count, &sent);
-        vox_file_close(c->sendfile_file);
-        c->sendfile_file = NULL;
-        if (r != 0 || (sent > 0 && sent < c->sendfile_count)) {
+        int r = vox_http_conn_pump_sendfile(c, &c->tcp->socket);
+        if (r < 0) {
             vox_http_conn_close(c);
             return;
         }
+        if (r > 0) return;
     }
-    if (c->should_close_after_write) {
+    /* 同步写完成发生在 flush 循环内时由 flush 继续 */
+    if (c->flushing) return;
+    vox_http_conn_after_write(c);
+}
+
+static void vox_http_tls_write_done(vox_tls_t* tls, int status, void* user_data) {
+    vox_http_conn_t* c = (vox_http_conn_t*)user_data;
+    VOX_UNUSED(tls);
+    if (!c) return;
+    c->write_pending = false;
+    if (status != 0) {
+        vox_http_conn_drop_sendfile(c);
         vox_http_conn_close(c);
         return;
     }
-
-    /* WebSocket upgrade：切换到 WS 读循环，不再解析 HTTP */
-    if (c->ws_upgrade_pending && c->ws) {
-        c->ws_upgrade_pending = false;
-        c->ws_mode = true;
-        /* 若握手期间已经缓存了后续数据（极少见），先喂给 ws 解析器 */
-        if (c->pending_in && vox_string_length(c->pending_in) > 0) {
-            (void)vox_http_ws_internal_feed(c->ws, vox_string_data(c->pending_in), vox_string_length(c->pending_in));
-            vox_string_clear(c->pending_in);
-        }
-        if (c->tcp) {
-            vox_tcp_read_start(c->tcp, NULL, vox_http_tcp_ws_read_cb);
+    /* sendfile：发送方向已卸载到内核 TLS，文件体直接从 socket 发出 */
+    if (c->sendfile_file && c->tls && c->tls->tcp) {
+        int r = vox_http_conn_pump_sendfile(c, &c->tls->tcp->socket);
+        if (r < 0) {
+            vox_http_conn_close(c);
+            return;
         }
-        vox_http_ws_internal_on_open(c->ws);
-        return;
+        if (r > 0) return;
     }
+    /* 同步写完成发生在 flush 循环内时由 flush 继续 */
+    if (c->flushing) return;
+    vox_http_conn_after_write(c);
+}
 
-    /* 准备解析下一个请求 */
-    vox_http_parser_reset(c->parser);
-    vox_http_conn_reset_request(c);
+/* ===== HTTP/2 ===== */
 
-    /* 先消费 pipeline 缓存 */
-    vox_http_drain_pending(c);
+static void vox_http_h2_flush(vox_http_conn_t* c);
 
-    /* 恢复读取 */
-    if (c->tcp) {
-        vox_tcp_read_start(c->tcp, NULL, vox_http_tcp_read_cb);
+static void vox_http_tcp_h2_write_done(vox_tcp_t* tcp, int status, void* user_data) {
+    vox_http_conn_t* c = (vox_http_conn_t*)user_data;
+    VOX_UNUSED(tcp);
+    if (!c) return;
+    c->write_pending = false;
+    if (status != 0) {
+        vox_http_conn_close(c);
+        return;
     }
+    vox_http_h2_flush(c);
 }
 
-static void vox_http_tls_write_done(vox_tls_t* tls, int status, void* user_data) {
+static void vox_http_tls_h2_write_done(vox_tls_t* tls, int status, void* user_data) {
     vox_http_conn_t* c = (vox_http_conn_t*)user_data;
     VOX_UNUSED(tls);
     if (!c) return;
@@ -601,38 +869,81 @@ static void vox_http_tls_write_done(vox_tls_t* tls, int status, void* user_data)
         vox_http_conn_close(c);
         return;
     }
-    if (c->should_close_after_write) {
-        vox_http_conn_close(c);
-        return;
-    }
+    vox_http_h2_flush(c);
+}
 
-    /* WebSocket upgrade：切换到 WS 读循环，不再解析 HTTP */
-    if (c->ws_upgrade_pending && c->ws) {
-        c->ws_upgrade_pending = false;
-        c->ws_mode = true;
-        /* 若握手期间已经缓存了后续数据（极少见），先喂给 ws 解析器 */
-        if (c->pending_in && vox_string_length(c->pending_in) > 0) {
-            (void)vox_http_ws_internal_feed(c->ws, vox_string_data(c->pending_in), vox_string_length(c->pending_in));
-            vox_string_clear(c->pending_in);
+/* 一次只有一个在途写：把累积的帧整体写出；全部写完后让会话继续发送被预算暂停的 DATA
+ * （写完成可能在 write 内同步回调，由 h2_flushing 防止重入，循环继续） */
+static void vox_http_h2_flush(vox_http_conn_t* c) {
+    if (c->h2_flushing) return;
+    c->h2_flushing = true;
+    while (!c->write_pending && !c->closing) {
+        if (vox_string_length(c->h2_pending) == 0) {
+            if (c->h2 && !c->should_close_after_write) vox_http2_session_on_writable(c->h2);
+            if (vox_string_length(c->h2_pending) == 0) {
+                if (c->should_close_after_write || (c->h2 && vox_http2_session_want_close(c->h2))) {
+                    vox_http_conn_close(c);
+                }
+                break;
+            }
         }
-        if (c->tls) {
-            vox_tls_read_start(c->tls, NULL, vox_http_tls_ws_read_cb);
+        /* vox_tcp_write 不复制数据：写出 out，新产生的帧继续累积到换下来的缓冲 */
+        vox_string_t* data = c->h2_pending;
+        c->h2_pending = c->out;
+        c->out = data;
+        vox_string_clear(c->h2_pending);
+
+        c->write_pending = true;
+        int rc;
+        if (c->is_tls) {
+            rc = c->tls ? vox_tls_write(c->tls, vox_string_data(data), vox_string_length(data),
+                                        vox_http_tls_h2_write_done) : -1;
+        } else {
+            rc = c->tcp ? vox_tcp_write(c->tcp, vox_string_data(data), vox_string_length(data),
+                                        vox_http_tcp_h2_write_done) : -1;
+        }
+        if (rc != 0) {
+            c->write_pending = false;
+            vox_http_conn_close(c);
+            break;
         }
-        vox_http_ws_internal_on_open(c->ws);
-        return;
     }
+    c->h2_flushing = false;
+}
 
-    /* 准备解析下一个请求 */
-    vox_http_parser_reset(c->parser);
-    vox_http_conn_reset_request(c);
+static int vox_http_h2_send_cb(void* user_data, const void* data, size_t len) {
+    vox_http_conn_t* c = (vox_http_conn_t*)user_data;
+    if (c->closing || c->handle_closed) return -1;
+    if (vox_string_append_data(c->h2_pending, data, len) != 0) return -1;
+    vox_http_h2_flush(c);
+    return 0;
+}
 
-    /* 先消费 pipeline 缓存 */
-    vox_http_drain_pending(c);
+static int vox_http_conn_start_h2(vox_http_conn_t* c) {
+    vox_http_server_t* s = c->server;
+    c->h2_pending = vox_string_create(c->mpool);
+    if (!c->h2_pending) return -1;
+    /* 创建时即输出本端 SETTINGS */
+    c->h2 = vox_http2_session_create(c->mpool, s->engine, s->has_h2_config ? &s->h2_config : NULL,
+                                     vox_http_h2_send_cb, c);
+    if (!c->h2) return -1;
+    vox_http2_session_bind_conn(c->h2, c);
+    return 0;
+}
 
-    /* 恢复读取 */
-    if (c->tls) {
-        vox_tls_read_start(c->tls, NULL, vox_http_tls_read_cb);
+static void vox_http_h2_on_read(vox_http_conn_t* c, const void* buf, size_t len) {
+    if (c->closing) return;
+    if (vox_http2_session_feed(c->h2, buf, len) != 0) {
+        /* 连接错误：GOAWAY 写出后关闭 */
+        c->should_close_after_write = true;
     }
+    vox_http_h2_flush(c);
+}
+
+/* 明文连接的首个数据是否为 HTTP/2 连接前言（可能只收到前言的一部分） */
+static bool vox_http_is_h2_preface(const void* buf, size_t len) {
+    size_t n = len < VOX_HTTP2_PREFACE_LEN ? len : VOX_HTTP2_PREFACE_LEN;
+    return n > 0 && memcmp(buf, VOX_HTTP2_PREFACE, n) == 0;
 }
 
 static void vox_http_tcp_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void* user_data) {
@@ -640,38 +951,30 @@ static void vox_http_tcp_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf,
     VOX_UNUSED(tcp);
     if (!c) return;
     if (nread <= 0) {
+        if (nread == 0 && vox_http_conn_hold_on_eof(c)) return;
         vox_http_conn_close(c);
         return;
     }
     if (!buf) return;
 
-    const char* p = (const char*)buf;
-    size_t left = (size_t)nread;
-
-    if (c->write_pending || c->deferred_pending) {
-        if (!c->pending_in) c->pending_in = vox_string_create(c->mpool);
-        if (c->pending_in) vox_string_append_data(c->pending_in, p, left);
+    if (c->h2) {
+        vox_http_h2_on_read(c, buf, (size_t)nread);
         return;
     }
-
-    while (left > 0 && !c->write_pending && !c->deferred_pending) {
-        ssize_t n = vox_http_parser_execute(c->parser, p, left);
-        if (n < 0) {
-            vox_http_conn_close(c);
-            return;
-        }
-        if (n == 0) break;
-        p += (size_t)n;
-        left -= (size_t)n;
-        if (c->write_pending || c->deferred_pending) {
-            /* 缓存剩余数据 */
-            if (left > 0) {
-                if (!c->pending_in) c->pending_in = vox_string_create(c->mpool);
-                if (c->pending_in) vox_string_append_data(c->pending_in, p, left);
+    if (!c->proto_checked) {
+        /* prior-knowledge h2c：客户端直接以 HTTP/2 连接前言开始 */
+        c->proto_checked = true;
+        if (vox_http_is_h2_preface(buf, (size_t)nread)) {
+            if (vox_http_conn_start_h2(c) != 0) {
+                vox_http_conn_close(c);
+                return;
             }
+            vox_http_h2_on_read(c, buf, (size_t)nread);
             return;
         }
     }
+
+    vox_http_conn_on_data(c, (const char*)buf, (size_t)nread);
 }
 
 static void vox_http_tls_read_cb(vox_tls_t* tls, ssize_t nread, const void* buf, void* user_data) {
@@ -679,38 +982,18 @@ static void vox_http_tls_read_cb(vox_tls_t* tls, ssize_t nread, const void* buf,
     VOX_UNUSED(tls);
     if (!c) return;
     if (nread <= 0) {
+        if (nread == 0 && vox_http_conn_hold_on_eof(c)) return;
         vox_http_conn_close(c);
         return;
     }
     if (!buf) return;
 
-    const char* p = (const char*)buf;
-    size_t left = (size_t)nread;
-
-    if (c->write_pending || c->deferred_pending) {
-        if (!c->pending_in) c->pending_in = vox_string_create(c->mpool);
-        if (c->pending_in) vox_string_append_data(c->pending_in, p, left);
+    if (c->h2) {
+        vox_http_h2_on_read(c, buf, (size_t)nread);
         return;
     }
 
-    while (left > 0 && !c->write_pending && !c->deferred_pending) {
-        ssize_t n = vox_http_parser_execute(c->parser, p, left);
-        if (n < 0) {
-            vox_http_conn_close(c);
-            return;
-        }
-        if (n == 0) break;
-        p += (size_t)n;
-        left -= (size_t)n;
-        if (c->write_pending || c->deferred_pending) {
-            /* 缓存剩余数据 */
-            if (left > 0) {
-                if (!c->pending_in) c->pending_in = vox_string_create(c->mpool);
-                if (c->pending_in) vox_string_append_data(c->pending_in, p, left);
-            }
-            return;
-        }
-    }
+    vox_http_conn_on_data(c, (const char*)buf, (size_t)nread);
 }
 
 static void vox_http_tcp_ws_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void* user_data) {
@@ -778,23 +1061,25 @@ static void vox_http_tcp_connection_cb(vox_tcp_t* server, int status, void* user
     c->closing = false;
     c->handle_closed = false;
     c->ip_cached = false;
-    c->url = vox_string_create(mpool);
-    c->body = vox_string_create(mpool);
+    c->peer_cached = false;
+    vox_list_init(&c->pipeline);
+    vox_list_init(&c->free_reqs);
     c->cur_h_name = vox_string_create(mpool);
     c->cur_h_value = vox_string_create(mpool);
-    c->headers = vox_vector_create(mpool);
     c->out = vox_string_create(mpool);
     c->pending_in = vox_string_create(mpool);
     
     /* 缓存客户端IP地址 */
     vox_socket_addr_t peer_addr;
     if (vox_tcp_getpeername(client, &peer_addr) == 0) {
+        c->peer_addr = peer_addr;
+        c->peer_cached = true;
         if (vox_socket_address_to_string(&peer_addr, c->cached_ip, sizeof(c->cached_ip)) > 0) {
             c->ip_cached = true;
         }
     }
 
-    if (!c->url || !c->body || !c->cur_h_name || !c->cur_h_value || !c->headers || !c->out || !c->pending_in) {
+    if (!c->cur_h_name || !c->cur_h_value || !c->out || !c->pending_in) {
         vox_mpool_destroy(mpool);
         vox_handle_close((vox_handle_t*)client, NULL);
         return;
@@ -823,13 +1108,6 @@ static void vox_http_tcp_connection_cb(vox_tcp_t* server, int status, void* user
     }
     vox_http_parser_set_user_data(c->parser, c);
 
-    /* 初始化 ctx 固定字段 */
-    memset(&c->ctx, 0, sizeof(c->ctx));
-    c->ctx.mpool = mpool;
-    c->ctx.loop = s->loop;
-    c->ctx.engine = s->engine;
-    c->ctx.conn = c;
-
     vox_handle_set_data((vox_handle_t*)client, c);
     vox_list_push_back(&s->conns, &c->node);
 
@@ -853,13 +1131,25 @@ static void vox_http_tls_handshake_cb(vox_tls_t* tls, int status, void* user_dat
     if (!c->ip_cached && c->tls) {
         vox_socket_addr_t peer_addr;
         if (vox_tls_getpeername(c->tls, &peer_addr) == 0) {
+            c->peer_addr = peer_addr;
+            c->peer_cached = true;
             if (vox_socket_address_to_string(&peer_addr, c->cached_ip, sizeof(c->cached_ip)) > 0) {
                 c->ip_cached = true;
             }
         }
     }
     
-    if (c->tls) {
+    /* ALPN 协商出 h2：改由 HTTP/2 会话处理该连接 */
+    char proto[16];
+    if (c->tls && c->tls->ssl_session &&
+        vox_ssl_session_get_alpn(c->tls->ssl_session, proto, sizeof(proto)) == 2 && memcmp(proto, "h2", 2) == 0) {
+        if (vox_http_conn_start_h2(c) != 0) {
+            vox_http_conn_close(c);
+            return;
+        }
+    }
+
+    if (c->tls && !c->closing) {
         if (vox_tls_read_start(c->tls, NULL, vox_http_tls_read_cb) != 0) {
             vox_http_conn_close(c);
         }
@@ -900,18 +1190,18 @@ static void vox_http_tls_connection_cb(vox_tls_t* server, int status, void* user
     c->closing = false;
     c->handle_closed = false;
     c->ip_cached = false;
-    c->url = vox_string_create(mpool);
-    c->body = vox_string_create(mpool);
+    c->peer_cached = false;
+    vox_list_init(&c->pipeline);
+    vox_list_init(&c->free_reqs);
     c->cur_h_name = vox_string_create(mpool);
     c->cur_h_value = vox_string_create(mpool);
-    c->headers = vox_vector_create(mpool);
     c->out = vox_string_create(mpool);
     c->pending_in = vox_string_create(mpool);
     
     /* 缓存客户端IP地址（TLS握手完成后获取） */
     /* 注意：TLS连接在握手完成前可能无法获取peer地址，所以在handshake_cb中获取 */
 
-    if (!c->url || !c->body || !c->cur_h_name || !c->cur_h_value || !c->headers || !c->out || !c->pending_in) {
+    if (!c->cur_h_name || !c->cur_h_value || !c->out || !c->pending_in) {
         vox_mpool_destroy(mpool);
         vox_handle_close((vox_handle_t*)client, NULL);
         return;
@@ -940,13 +1230,6 @@ static void vox_http_tls_connection_cb(vox_tls_t* server, int status, void* user
     }
     vox_http_parser_set_user_data(c->parser, c);
 
-    /* 初始化 ctx 固定字段 */
-    memset(&c->ctx, 0, sizeof(c->ctx));
-    c->ctx.mpool = mpool;
-    c->ctx.loop = s->loop;
-    c->ctx.engine = s->engine;
-    c->ctx.conn = c;
-
     vox_handle_set_data((vox_handle_t*)client, c);
     vox_list_push_back(&s->conns, &c->node);
 
@@ -969,6 +1252,7 @@ vox_http_server_t* vox_http_server_create(vox_http_engine_t* engine) {
     s->engine = engine;
     s->loop = loop;
     s->mpool = mpool;
+    s->max_pipeline = VOX_HTTP_SERVER_DEFAULT_PIPELINE;
     vox_list_init(&s->conns);
     return s;
 }
@@ -1041,6 +1325,24 @@ int vox_http_server_listen_tls(vox_http_server_t* server, vox_ssl_context_t* ssl
     return 0;
 }
 
+int vox_http_server_set_http2_config(vox_http_server_t* server, const vox_http2_config_t* config) {
+    if (!server) return -1;
+    if (config) {
+        server->h2_config = *config;
+        server->has_h2_config = true;
+    } else {
+        memset(&server->h2_config, 0, sizeof(server->h2_config));
+        server->has_h2_config = false;
+    }
+    return 0;
+}
+
+int vox_http_server_set_max_pipeline(vox_http_server_t* server, size_t max_requests) {
+    if (!server) return -1;
+    server->max_pipeline = max_requests > 0 ? max_requests : VOX_HTTP_SERVER_DEFAULT_PIPELINE;
+    return 0;
+}
+
 void vox_http_server_close(vox_http_server_t* server) {
     if (!server) return;
 
@@ -1094,8 +1396,6 @@ int vox_http_conn_mark_ws_upgrade(void* conn, vox_http_ws_conn_t* ws) {
     c->ws = ws;
     c->ws_upgrade_pending = true;
     c->ws_mode = false;
-    /* upgrade 成功后连接必须保持 */
-    c->should_close_after_write = false;
     return 0;
 }
 
@@ -1116,13 +1416,13 @@ void vox_http_conn_ws_close(void* conn) {
     vox_http_conn_close(c);
 }
 
-int vox_http_conn_get_client_ip(void* conn, char* ip_buf, size_t ip_buf_size) {
-    if (!conn || !ip_buf || ip_buf_size == 0) return -1;
-    vox_http_conn_t* c = (vox_http_conn_t*)conn;
+int vox_http_conn_get_client_ip(const vox_http_context_t* ctx, char* ip_buf, size_t ip_buf_size) {
+    if (!ctx || !ctx->conn || !ip_buf || ip_buf_size == 0) return -1;
+    vox_http_conn_t* c = (vox_http_conn_t*)ctx->conn;
     
-    /* 优先检查 X-Forwarded-For 或 X-Real-IP 头（如果存在代理） */
-    if (c->ctx.req.headers) {
-        const vox_vector_t* vec = (const vox_vector_t*)c->ctx.req.headers;
+    /* 优先检查 X-Forwarded-For 或 X-Real-IP 头（如果存在代理）；HTTP/2 下请求属于流的 ctx 而不是 c->ctx */
+    if (ctx->req.headers) {
+        const vox_vector_t* vec = (const vox_vector_t*)ctx->req.headers;
         size_t cnt = vox_vector_size(vec);
         for (size_t i = 0; i < cnt; i++) {
             const vox_http_header_t* kv = (const vox_http_header_t*)vox_vector_get(vec, i);
@@ -1199,3 +1499,47 @@ int vox_http_conn_get_client_ip(void* conn, char* ip_buf, size_t ip_buf_size) {
     return -1;
 }
 
+int vox_http_conn_get_client_addr(const vox_http_context_t* ctx, vox_socket_addr_t* addr) {
+    if (!ctx || !ctx->conn || !addr) return -1;
+    vox_http_conn_t* c = (vox_http_conn_t*)ctx->conn;
+
+    /* 与 vox_http_conn_get_client_ip 一致：代理头优先（取 X-Forwarded-For 第一个地址） */
+    if (ctx->req.headers) {
+        const vox_vector_t* vec = (const vox_vector_t*)ctx->req.headers;
+        size_t cnt = vox_vector_size(vec);
+        for (size_t i = 0; i < cnt; i++) {
+            const vox_http_header_t* kv = (const vox_http_header_t*)vox_vector_get(vec, i);
+            if (!kv || !kv->name.ptr || !kv->value.ptr) continue;
+            bool xff = vox_http_strieq(kv->name.ptr, kv->name.len, "X-Forwarded-For", 15);
+            if (!xff && !vox_http_strieq(kv->name.ptr, kv->name.len, "X-Real-IP", 9)) continue;
+            const char* val = kv->value.ptr;
+            size_t len = kv->value.len;
+            const char* comma = xff ? (const char*)memchr(val, ',', len) : NULL;
+            if (comma) len = (size_t)(comma - val);
+            while (len > 0 && (*val == ' ' || *val == '\t')) { val++; len--; }
+            while (len > 0 && (val[len - 1] == ' ' || val[len - 1] == '\t')) len--;
+            char ip[64];
+            if (len > 0 && len < sizeof(ip)) {
+                memcpy(ip, val, len);
+                ip[len] = '\0';
+                if (vox_socket_parse_address(ip, 0, addr) == 0) return 0;
+            }
+        }
+    }
+
+    if (c->peer_cached) {
+        *addr = c->peer_addr;
+        return 0;
+    }
+    int ret = -1;
+    if (c->is_tls) {
+        if (c->tls) ret = vox_tls_getpeername(c->tls, addr);
+    } else {
+        if (c->tcp) ret = vox_tcp_getpeername(c->tcp, addr);
+    }
+    if (ret == 0) {
+        c->peer_addr = *addr;
+        c->peer_cached = true;
+    }
+    return ret;
+}
@@ -12,6 +12,7 @@
 #include "../vox_tls.h"
 #include "../ssl/vox_ssl.h"
 #include "vox_http_engine.h"
+#include "vox_http2.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,6 +20,9 @@ extern "C" {
 
 typedef struct vox_http_server vox_http_server_t;
 
+/* 每个 HTTP/1.1 连接默认同时处理的 pipeline 请求数 */
+#define VOX_HTTP_SERVER_DEFAULT_PIPELINE 16
+
 vox_http_server_t* vox_http_server_create(vox_http_engine_t* engine);
 void vox_http_server_destroy(vox_http_server_t* server);
 
@@ -28,6 +32,16 @@ int vox_http_server_listen_tcp(vox_http_server_t* server, const vox_socket_addr_
 /* 监听 HTTPS（WSS 同理，通过 ws upgrade） */
 int vox_http_server_listen_tls(vox_http_server_t* server, vox_ssl_context_t* ssl_ctx, const vox_socket_addr_t* addr, int backlog);
 
+/* HTTP/2 会话配置（对之后建立的连接生效），NULL 恢复默认值
+ * 明文连接以 HTTP/2 连接前言开头时按 prior-knowledge h2c 处理；
+ * HTTPS 需在 ssl_ctx 配置 alpn_protocols（如 "h2,http/1.1"），协商出 "h2" 时使用 HTTP/2 */
+int vox_http_server_set_http2_config(vox_http_server_t* server, const vox_http2_config_t* config);
+
+/* 每个 HTTP/1.1 连接最多同时处理的 pipeline 请求数（含 defer 中的请求），0 恢复默认值
+ * 每个请求有独立的 ctx，慢请求 defer 时后续请求照常分发；响应仍按请求顺序写回，
+ * 达到上限后暂停读取。Connection: close 与 Upgrade 请求之后的数据在其响应写出后才解析；1 表示逐个处理 */
+int vox_http_server_set_max_pipeline(vox_http_server_t* server, size_t max_requests);
+
 /* 停止并关闭所有连接 */
 void vox_http_server_close(vox_http_server_t* server);
 
@@ -0,0 +1,931 @@
+/*
+ * vox_http_static.c - HTTP 静态文件服务实现
+ * 缓存项按规范化后的请求路径索引，持有已打开的文件（及可选的 .gz 兄弟文件）与预先格式化的
+ * ETag/Last-Modified；发送中的响应通过引用计数持有缓存项，失效/淘汰时延迟到最后一次归还才关闭 fd。
+ */
+
+#include "vox_http_static.h"
+#include "vox_http_internal.h"
+#include "vox_http_mime.h"
+#include "../vox_log.h"
+#include "../vox_list.h"
+#include "../vox_htable.h"
+#include "../vox_time.h"
+#include "../vox_loop.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef VOX_OS_LINUX
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#define VOX_HTTP_STATIC_DEFAULT_ENTRIES    1024
+#define VOX_HTTP_STATIC_DEFAULT_REVALIDATE 2000
+#define VOX_HTTP_STATIC_DEFAULT_RANGES     16
+#define VOX_HTTP_STATIC_DEFAULT_MULTIPART  (1024 * 1024)
+#define VOX_HTTP_STATIC_MAX_PATH           1024
+
+/* 一种表示（原文件或 .gz 预压缩文件） */
+typedef struct {
+    vox_file_t* file;            /* NULL 表示不存在 */
+    int64_t size;
+    int64_t mtime;               /* Unix 秒 */
+    char etag[48];               /* "size-mtime"（gz 为 "size-mtime-gz"），含引号 */
+} static_rep_t;
+
+typedef struct static_entry {
+    vox_list_node_t node;        /* LRU（头部为最近使用） */
+    vox_http_static_t* st;
+    char* key;                   /* 规范化后的请求路径 */
+    size_t key_len;
+    char* full_path;             /* 文件系统路径 */
+    const char* name;            /* full_path 中的文件名部分（inotify 事件匹配） */
+    size_t name_len;
+    const char* content_type;
+    int wd;                      /* inotify 目录监听描述符，-1 表示按间隔校验 */
+    int refs;                    /* 发送中的响应引用数 */
+    bool cached;                 /* 仍在 htable/LRU 中 */
+    int64_t validated_at;        /* 上次校验时间（毫秒，单调时钟） */
+    char last_modified[32];
+    static_rep_t plain;
+    static_rep_t gz;
+} static_entry_t;
+
+struct vox_http_static {
+    vox_mpool_t* mpool;
+    char* root;
+    size_t root_len;
+    char* index_file;
+    size_t index_len;
+    vox_http_static_options_t opts;
+    vox_htable_t* cache;         /* key -> static_entry_t* */
+    vox_list_t lru;
+    int inotify_fd;              /* -1 表示未启用 */
+    vox_loop_fd_watch_t* watch;  /* inotify fd 在 loop 上的可读监听（首次请求时注册） */
+    vox_htable_t* wd_refs;       /* inotify wd -> 引用它的缓存项数 */
+    uint32_t boundary_seq;
+    vox_http_static_stats_t stats;
+};
+
+/* ===== 工具 ===== */
+
+static int64_t static_now_ms(void) {
+    return (int64_t)(vox_time_monotonic() / 1000);
+}
+
+static const char* const static_wdays[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+static const char* const static_months[] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+/* IMF-fixdate：Sun, 06 Nov 1994 08:49:37 GMT */
+static void static_format_http_date(int64_t sec, char* buf, size_t size) {
+    vox_time_struct_t tm;
+    if (vox_time_to_struct_gmt(vox_time_from_sec(sec), &tm) != 0 ||
+        tm.weekday < 0 || tm.weekday > 6 || tm.month < 1 || tm.month > 12) {
+        snprintf(buf, size, "Thu, 01 Jan 1970 00:00:00 GMT");
+        return;
+    }
+    snprintf(buf, size, "%s, %02d %s %04d %02d:%02d:%02d GMT",
+             static_wdays[tm.weekday], tm.day, static_months[tm.month - 1], tm.year,
+             tm.hour, tm.minute, tm.second);
+}
+
+/* 解析 IMF-fixdate，失败返回 -1 */
+static int64_t static_parse_http_date(const char* s, size_t len) {
+    char buf[64];
+    if (!s || len == 0 || len >= sizeof(buf)) return -1;
+    memcpy(buf, s, len);
+    buf[len] = '\0';
+
+    char mon[4] = {0};
+    vox_time_struct_t tm;
+    memset(&tm, 0, sizeof(tm));
+    if (sscanf(buf, "%*3s, %d %3s %d %d:%d:%d GMT", &tm.day, mon, &tm.year, &tm.hour, &tm.minute, &tm.second) != 6) {
+        return -1;
+    }
+    for (int i = 0; i < 12; i++) {
+        if (strcasecmp(mon, static_months[i]) == 0) {
+            tm.month = i + 1;
+            break;
+        }
+    }
+    if (tm.month == 0) return -1;
+    return vox_time_to_sec(vox_time_from_struct_gmt(&tm));
+}
+
+static void static_trim(const char** p, size_t* n) {
+    while (*n > 0 && (**p == ' ' || **p == '\t')) { (*p)++; (*n)--; }
+    while (*n > 0 && ((*p)[*n - 1] == ' ' || (*p)[*n - 1] == '\t')) (*n)--;
+}
+
+/* Accept-Encoding 是否接受 gzip（考虑 q=0 与通配符） */
+static bool static_accepts_gzip(vox_strview_t ae) {
+    const char* p = ae.ptr;
+    size_t left = ae.len;
+    bool star = false;
+    while (p && left > 0) {
+        const char* comma = (const char*)memchr(p, ',', left);
+        size_t tlen = comma ? (size_t)(comma - p) : left;
+        const char* tok = p;
+        size_t n = tlen;
+        static_trim(&tok, &n);
+
+        const char* semi = (const char*)memchr(tok, ';', n);
+        size_t name_len = semi ? (size_t)(semi - tok) : n;
+        const char* name = tok;
+        static_trim(&name, &name_len);
+        bool zero_q = false;
+        if (semi) {
+            const char* q = semi + 1;
+            size_t qn = n - (size_t)(q - tok);
+            static_trim(&q, &qn);
+            if (qn >= 2 && (q[0] == 'q' || q[0] == 'Q') && q[1] == '=') {
+                zero_q = true;
+                for (size_t i = 2; i < qn; i++) {
+                    if (q[i] != '0' && q[i] != '.') {
+                        zero_q = false;
+                        break;
+                    }
+                }
+            }
+        }
+        if (vox_http_strieq(name, name_len, "gzip", 4)) return !zero_q;
+        if (name_len == 1 && name[0] == '*') star = !zero_q;
+
+        if (!comma) break;
+        p = comma + 1;
+        left -= tlen + 1;
+    }
+    return star;
+}
+
+/* If-None-Match 弱比较：列表中任一 ETag（忽略 W/ 前缀）与 etag 相同，或为 "*" */
+static bool static_etag_match(vox_strview_t inm, const char* etag) {
+    size_t elen = strlen(etag);
+    const char* p = inm.ptr;
+    size_t left = inm.len;
+    while (p && left > 0) {
+        const char* comma = (const char*)memchr(p, ',', left);
+        size_t tlen = comma ? (size_t)(comma - p) : left;
+        const char* tok = p;
+        size_t n = tlen;
+        static_trim(&tok, &n);
+        if (n == 1 && tok[0] == '*') return true;
+        if (n >= 2 && tok[0] == 'W' && tok[1] == '/') {
+            tok += 2;
+            n -= 2;
+        }
+        if (n == elen && memcmp(tok, etag, elen) == 0) return true;
+        if (!comma) break;
+        p = comma + 1;
+        left -= tlen + 1;
+    }
+    return false;
+}
+
+static int static_hexval(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/* 解码并规范化 URL 路径：去掉空段与 "."，拒绝 ".."、NUL 与反斜杠
+ * 输出总以 '/' 开头，保留末尾 '/'。成功返回长度，非法返回 -1 */
+static int static_normalize_path(const char* path, size_t len, char* out, size_t out_size) {
+    size_t o = 0;
+    size_t i = 0;
+    if (out_size < 2) return -1;
+    out[o++] = '/';
+    while (i < len) {
+        /* 解码一个段 */
+        while (i < len && path[i] == '/') i++;
+        if (i >= len) break;
+        size_t seg_start = o;
+        while (i < len && path[i] != '/') {
+            char c = path[i];
+            if (c == '%') {
+                if (i + 2 >= len) return -1;
+                int hi = static_hexval(path[i + 1]);
+                int lo = static_hexval(path[i + 2]);
+                if (hi < 0 || lo < 0) return -1;
+                c = (char)((hi << 4) | lo);
+                i += 3;
+            } else {
+                i++;
+            }
+            if (c == '\0' || c == '\\' || c == '/') return -1;
+            if (o + 1 >= out_size) return -1;
+            out[o++] = c;
+        }
+        size_t seg_len = o - seg_start;
+        if (seg_len == 1 && out[seg_start] == '.') {
+            o = seg_start;
+            continue;
+        }
+        if (seg_len == 2 && out[seg_start] == '.' && out[seg_start + 1] == '.') return -1;
+        if (o + 1 >= out_size) return -1;
+        out[o++] = '/';
+    }
+    /* 原路径不以 '/' 结尾时去掉补上的分隔符 */
+    if (o > 1 && (len == 0 || path[len - 1] != '/')) o--;
+    out[o] = '\0';
+    return (int)o;
+}
+
+/* ===== 缓存项管理 ===== */
+
+static void static_rep_close(static_rep_t* rep) {
+    if (rep->file) {
+        vox_file_close(rep->file);
+        rep->file = NULL;
+    }
+}
+
+static void static_entry_free(static_entry_t* e) {
+    vox_mpool_t* mpool = e->st->mpool;
+    static_rep_close(&e->plain);
+    static_rep_close(&e->gz);
+    vox_mpool_free(mpool, e->key);
+    vox_mpool_free(mpool, e->full_path);
+    vox_mpool_free(mpool, e);
+}
+
+static void static_unwatch_dir(vox_http_static_t* st, int wd);
+
+/* 从缓存移除；仍被发送中的响应引用时延迟到最后一次归还再关闭 */
+static void static_entry_remove(static_entry_t* e) {
+    vox_http_static_t* st = e->st;
+    if (e->cached) {
+        vox_htable_delete(st->cache, e->key, e->key_len);
+        vox_list_remove(&st->lru, &e->node);
+        e->cached = false;
+        static_unwatch_dir(st, e->wd);
+        e->wd = -1;
+    }
+    if (e->refs == 0) static_entry_free(e);
+}
+
+static void static_entry_invalidate(static_entry_t* e) {
+    e->st->stats.invalidations++;
+    static_entry_remove(e);
+}
+
+static void static_entry_release(void* data) {
+    static_entry_t* e = (static_entry_t*)data;
+    if (--e->refs == 0 && !e->cached) static_entry_free(e);
+}
+
+static int static_rep_open(vox_http_static_t* st, static_rep_t* rep, const char* path, const char* etag_suffix) {
+    vox_file_info_t info;
+    if (vox_file_stat(path, &info) != 0 || !info.exists || !info.is_regular_file) return -1;
+    rep->file = vox_file_open(st->mpool, path, VOX_FILE_MODE_READ);
+    if (!rep->file) return -1;
+    /* 以打开后的 fd 为准取大小，避免 stat 与 open 之间文件被替换 */
+    rep->size = vox_file_size(rep->file);
+    if (rep->size < 0) {
+        static_rep_close(rep);
+        return -1;
+    }
+    rep->mtime = info.modified_time;
+    snprintf(rep->etag, sizeof(rep->etag), "\"%llx-%llx%s\"",
+             (unsigned long long)rep->size, (unsigned long long)rep->mtime, etag_suffix);
+    return 0;
+}
+
+/* 文件是否仍与缓存的表示一致（大小、修改时间、存在性） */
+static bool static_rep_unchanged(const static_rep_t* rep, const char* path) {
+    vox_file_info_t info;
+    bool exists = vox_file_stat(path, &info) == 0 && info.exists && info.is_regular_file;
+    if (!rep->file) return !exists;
+    return exists && info.size == rep->size && info.modified_time == rep->mtime;
+}
+
+static void static_gz_path(const char* full_path, char* out, size_t size) {
+    snprintf(out, size, "%s.gz", full_path);
+}
+
+static bool static_entry_still_valid(static_entry_t* e) {
+    char gz_path[VOX_HTTP_STATIC_MAX_PATH + 512];
+    if (!static_rep_unchanged(&e->plain, e->full_path)) return false;
+    if (e->st->opts.disable_precompressed) return true;
+    static_gz_path(e->full_path, gz_path, sizeof(gz_path));
+    return static_rep_unchanged(&e->gz, gz_path);
+}
+
+#ifdef VOX_OS_LINUX
+/* 监听文件所在目录；同一目录的缓存项共用一个 wd，按引用数在最后一项离开缓存时移除 */
+static int static_watch_dir(vox_http_static_t* st, const char* full_path, size_t dir_len) {
+    if (!st->watch) return -1;
+    char dir[VOX_HTTP_STATIC_MAX_PATH + 512];
+    if (dir_len == 0 || dir_len >= sizeof(dir)) return -1;
+    memcpy(dir, full_path, dir_len);
+    dir[dir_len] = '\0';
+    /* 同一目录重复 add_watch 返回相同 wd */
+    int wd = inotify_add_watch(st->inotify_fd, dir,
+                               IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE |
+                               IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+    if (wd < 0) return -1;
+    intptr_t refs = (intptr_t)vox_htable_get(st->wd_refs, &wd, sizeof(wd));
+    if (vox_htable_set(st->wd_refs, &wd, sizeof(wd), (void*)(refs + 1)) != 0) {
+        if (refs == 0) inotify_rm_watch(st->inotify_fd, wd);
+        return -1;
+    }
+    return wd;
+}
+
+static void static_unwatch_dir(vox_http_static_t* st, int wd) {
+    if (wd < 0) return;
+    intptr_t refs = (intptr_t)vox_htable_get(st->wd_refs, &wd, sizeof(wd));
+    if (refs > 1) {
+        vox_htable_set(st->wd_refs, &wd, sizeof(wd), (void*)(refs - 1));
+        return;
+    }
+    vox_htable_delete(st->wd_refs, &wd, sizeof(wd));
+    if (refs == 1) inotify_rm_watch(st->inotify_fd, wd);
+}
+
+/* inotify fd 可读时读出全部事件并失效对应缓存项 */
+static void static_on_inotify(vox_loop_t* loop, int fd, void* user_data) {
+    VOX_UNUSED(loop);
+    vox_http_static_t* st = (vox_http_static_t*)user_data;
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    for (;;) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            break;
+        }
+        for (char* p = buf; p < buf + n;) {
+            const struct inotify_event* ev = (const struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + ev->len;
+            if (ev->mask & IN_Q_OVERFLOW) {
+                /* 事件丢失：全部失效 */
+                vox_http_static_clear(st);
+                continue;
+            }
+            if (ev->mask & IN_IGNORED) {
+                /* 内核已移除该监听（目录被删除或已 rm_watch），不能再 rm_watch */
+                vox_htable_delete(st->wd_refs, &ev->wd, sizeof(ev->wd));
+            }
+            bool whole_dir = (ev->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) || ev->len == 0;
+            size_t nlen = whole_dir ? 0 : strlen(ev->name);
+            vox_list_node_t* pos;
+            vox_list_node_t* tmp;
+            vox_list_for_each_safe(pos, tmp, &st->lru) {
+                static_entry_t* e = vox_container_of(pos, static_entry_t, node);
+                if (e->wd != ev->wd) continue;
+                if (!whole_dir) {
+                    bool same = nlen == e->name_len && memcmp(ev->name, e->name, nlen) == 0;
+                    bool gz = nlen == e->name_len + 3 && memcmp(ev->name, e->name, e->name_len) == 0 &&
+                              memcmp(ev->name + e->name_len, ".gz", 3) == 0;
+                    if (!same && !gz) continue;
+                }
+                if (ev->mask & IN_IGNORED) e->wd = -1;
+                static_entry_invalidate(e);
+            }
+        }
+    }
+}
+
+/* 首次请求时把 inotify fd 注册到处理请求的 loop；取不到 loop 时缓存项按间隔校验 */
+static void static_attach_loop(vox_http_static_t* st, vox_http_context_t* ctx) {
+    if (st->inotify_fd < 0 || st->watch) return;
+    vox_loop_t* loop = vox_http_engine_get_loop(vox_http_context_get_engine(ctx));
+    if (!loop) return;
+    st->watch = vox_loop_watch_fd(loop, st->inotify_fd, static_on_inotify, st);
+    if (!st->watch) {
+        VOX_LOG_ERROR("failed to watch inotify fd, falling back to periodic revalidation");
+        close(st->inotify_fd);
+        st->inotify_fd = -1;
+        st->stats.inotify = false;
+    }
+}
+#else
+static int static_watch_dir(vox_http_static_t* st, const char* full_path, size_t dir_len) {
+    VOX_UNUSED(st);
+    VOX_UNUSED(full_path);
+    VOX_UNUSED(dir_len);
+    return -1;
+}
+
+static void static_unwatch_dir(vox_http_static_t* st, int wd) {
+    VOX_UNUSED(st);
+    VOX_UNUSED(wd);
+}
+
+static void static_attach_loop(vox_http_static_t* st, vox_http_context_t* ctx) {
+    VOX_UNUSED(st);
+    VOX_UNUSED(ctx);
+}
+#endif
+
+/* 为新缓存项腾出位置 */
+static void static_evict(vox_http_static_t* st) {
+    while (vox_list_size(&st->lru) >= st->opts.max_entries && !vox_list_empty(&st->lru)) {
+        static_entry_remove(vox_container_of(vox_list_last(&st->lru), static_entry_t, node));
+    }
+}
+
+/* 查找或加载缓存项
+ * @return 0 命中/加载成功；1 不存在；2 是目录（需重定向）；-1 出错 */
+static int static_lookup(vox_http_static_t* st, const char* rel, size_t rel_len, static_entry_t** out) {
+    static_entry_t* e = (static_entry_t*)vox_htable_get(st->cache, rel, rel_len);
+    if (e) {
+        int64_t now = static_now_ms();
+        if (e->wd < 0 && now - e->validated_at >= (int64_t)st->opts.revalidate_ms) {
+            if (static_entry_still_valid(e)) {
+                e->validated_at = now;
+            } else {
+                static_entry_invalidate(e);
+                e = NULL;
+            }
+        }
+    }
+    if (e) {
+        st->stats.hits++;
+        vox_list_remove(&st->lru, &e->node);
+        vox_list_push_front(&st->lru, &e->node);
+        *out = e;
+        return 0;
+    }
+    st->stats.misses++;
+
+    /* root + rel (+ index) */
+    bool want_index = rel[rel_len - 1] == '/';
+    if (want_index && st->index_len == 0) return 1;
+    size_t full_len = st->root_len + rel_len + (want_index ? st->index_len : 0);
+    if (full_len >= VOX_HTTP_STATIC_MAX_PATH + 256) return 1;
+    char* full = (char*)vox_mpool_alloc(st->mpool, full_len + 1);
+    if (!full) return -1;
+    memcpy(full, st->root, st->root_len);
+    memcpy(full + st->root_len, rel, rel_len);
+    if (want_index) memcpy(full + st->root_len + rel_len, st->index_file, st->index_len);
+    full[full_len] = '\0';
+
+    vox_file_info_t info;
+    if (vox_file_stat(full, &info) != 0 || !info.exists) {
+        vox_mpool_free(st->mpool, full);
+        return 1;
+    }
+    if (info.is_directory) {
+        vox_mpool_free(st->mpool, full);
+        return want_index ? 1 : 2;
+    }
+
+    e = (static_entry_t*)vox_mpool_alloc(st->mpool, sizeof(static_entry_t));
+    if (!e) {
+        vox_mpool_free(st->mpool, full);
+        return -1;
+    }
+    memset(e, 0, sizeof(*e));
+    e->st = st;
+    e->full_path = full;
+    e->wd = -1;
+    if (static_rep_open(st, &e->plain, full, "") != 0) {
+        vox_mpool_free(st->mpool, full);
+        vox_mpool_free(st->mpool, e);
+        return 1;
+    }
+    if (!st->opts.disable_precompressed) {
+        char gz_path[VOX_HTTP_STATIC_MAX_PATH + 512];
+        static_gz_path(full, gz_path, sizeof(gz_path));
+        (void)static_rep_open(st, &e->gz, gz_path, "-gz");
+    }
+    static_format_http_date(e->plain.mtime, e->last_modified, sizeof(e->last_modified));
+    e->content_type = vox_http_mime_from_path(full, full_len);
+
+    const char* slash = strrchr(full, '/');
+    e->name = slash ? slash + 1 : full;
+    e->name_len = strlen(e->name);
+    e->wd = -1;
+    e->validated_at = static_now_ms();
+
+    e->key = (char*)vox_mpool_alloc(st->mpool, rel_len + 1);
+    if (!e->key) {
+        static_entry_free(e);
+        return -1;
+    }
+    memcpy(e->key, rel, rel_len);
+    e->key[rel_len] = '\0';
+    e->key_len = rel_len;
+    static_evict(st);
+    if (vox_htable_set(st->cache, e->key, e->key_len, e) != 0) {
+        static_entry_free(e);
+        return -1;
+    }
+    e->cached = true;
+    vox_list_push_front(&st->lru, &e->node);
+    /* 入缓存后再监听，离开缓存时由 static_entry_remove 归还 */
+    e->wd = static_watch_dir(st, full, slash ? (size_t)(slash - full) : 0);
+    *out = e;
+    return 0;
+}
+
+/* ===== Range ===== */
+
+typedef struct {
+    int64_t start;
+    int64_t end;   /* 含 */
+} static_range_t;
+
+/* 解析 Range: bytes=...
+ * @return 可满足的区间数（>=1）；0 全部不可满足（416）；-1 语法错误或区间过多（忽略 Range） */
+static int static_parse_range(vox_strview_t hv, int64_t size, static_range_t* ranges, int max_ranges) {
+    const char* p = hv.ptr;
+    size_t left = hv.len;
+    static_trim(&p, &left);
+    if (left < 6 || strncasecmp(p, "bytes=", 6) != 0) return -1;
+    p += 6;
+    left -= 6;
+
+    int count = 0;
+    int specs = 0;
+    while (left > 0) {
+        const char* comma = (const char*)memchr(p, ',', left);
+        size_t tlen = comma ? (size_t)(comma - p) : left;
+        const char* tok = p;
+        size_t n = tlen;
+        static_trim(&tok, &n);
+        if (n > 0) {
+            const char* dash = (const char*)memchr(tok, '-', n);
+            if (!dash) return -1;
+            int64_t a = -1, b = -1;
+            for (const char* q = tok; q < dash; q++) {
+                if (*q < '0' || *q > '9') return -1;
+                a = (a < 0 ? 0 : a) * 10 + (*q - '0');
+                if (a > ((int64_t)1 << 52)) return -1;
+            }
+            for (const char* q = dash + 1; q < tok + n; q++) {
+                if (*q < '0' || *q > '9') return -1;
+                b = (b < 0 ? 0 : b) * 10 + (*q - '0');
+                if (b > ((int64_t)1 << 52)) return -1;
+            }
+            if (a < 0 && b < 0) return -1;
+            if (++specs > max_ranges) return -1;
+
+            static_range_t r;
+            if (a < 0) {
+                /* 后缀区间：最后 b 字节 */
+                if (b == 0 || size == 0) goto next;
+                r.start = b >= size ? 0 : size - b;
+                r.end = size - 1;
+            } else {
+                if (b >= 0 && b < a) return -1;
+                if (a >= size) goto next;
+                r.start = a;
+                r.end = (b < 0 || b >= size) ? size - 1 : b;
+            }
+            ranges[count++] = r;
+        }
+    next:
+        if (!comma) break;
+        p = comma + 1;
+        left -= tlen + 1;
+    }
+    if (specs == 0) return -1;
+    return count;
+}
+
+/* 按起点排序并合并重叠或相邻的区间（RFC 7233 允许），返回合并后的区间数 */
+static int static_merge_ranges(static_range_t* ranges, int count) {
+    for (int i = 1; i < count; i++) {
+        static_range_t r = ranges[i];
+        int j = i;
+        while (j > 0 && ranges[j - 1].start > r.start) {
+            ranges[j] = ranges[j - 1];
+            j--;
+        }
+        ranges[j] = r;
+    }
+    int out = 0;
+    for (int i = 0; i < count; i++) {
+        if (out > 0 && ranges[i].start <= ranges[out - 1].end + 1) {
+            if (ranges[i].end > ranges[out - 1].end) ranges[out - 1].end = ranges[i].end;
+        } else {
+            ranges[out++] = ranges[i];
+        }
+    }
+    return out;
+}
+
+/* If-Range：强 ETag 需完全相同，日期需与 Last-Modified 一致 */
+static bool static_if_range_ok(const vox_http_context_t* ctx, const static_entry_t* e) {
+    vox_strview_t ir = vox_http_context_get_header(ctx, "If-Range");
+    if (!ir.ptr || ir.len == 0) return true;
+    const char* p = ir.ptr;
+    size_t n = ir.len;
+    static_trim(&p, &n);
+    if (n > 0 && (p[0] == '"' || p[0] == 'W')) {
+        return n == strlen(e->plain.etag) && memcmp(p, e->plain.etag, n) == 0;
+    }
+    return n == strlen(e->last_modified) && memcmp(p, e->last_modified, n) == 0;
+}
+
+static int static_send_multipart(vox_http_static_t* st, vox_http_context_t* ctx, static_entry_t* e,
+                                 const static_range_t* ranges, int count, bool head) {
+    char boundary[40];
+    snprintf(boundary, sizeof(boundary), "vox_%08x%08x", (unsigned)st->boundary_seq++, (unsigned)e->plain.size);
+
+    /* HEAD 只拼接分段头，文件数据只计入长度不读取 */
+    vox_string_t* body = vox_string_create(ctx->mpool);
+    if (!body) return -1;
+    size_t skipped = 0;
+    for (int i = 0; i < count; i++) {
+        vox_string_append_format(body, "\r\n--%s\r\nContent-Type: %s\r\nContent-Range: bytes %lld-%lld/%lld\r\n\r\n",
+                                 boundary, e->content_type, (long long)ranges[i].start, (long long)ranges[i].end,
+                                 (long long)e->plain.size);
+        size_t len = (size_t)(ranges[i].end - ranges[i].start + 1);
+        if (head) {
+            skipped += len;
+            continue;
+        }
+        size_t base = vox_string_length(body);
+        if (vox_string_resize(body, base + len) != 0) {
+            vox_string_destroy(body);
+            return -1;
+        }
+        char* dst = (char*)vox_string_data(body) + base;
+        size_t done = 0;
+        while (done < len) {
+            int64_t n = vox_file_read_at(e->plain.file, dst + done, len - done, ranges[i].start + (int64_t)done);
+            if (n <= 0) {
+                vox_string_destroy(body);
+                return -1;
+            }
+            done += (size_t)n;
+        }
+    }
+    vox_string_append_format(body, "\r\n--%s--\r\n", boundary);
+
+    char value[96];
+    vox_http_context_status(ctx, 206);
+    snprintf(value, sizeof(value), "multipart/byteranges; boundary=%s", boundary);
+    vox_http_context_header(ctx, "Content-Type", value);
+    snprintf(value, sizeof(value), "%zu", vox_string_length(body) + skipped);
+    vox_http_context_header(ctx, "Content-Length", value);
+    if (!head) {
+        vox_http_context_write(ctx, vox_string_data(body), vox_string_length(body));
+    }
+    vox_string_destroy(body);
+    return 0;
+}
+
+/* ===== 请求处理 ===== */
+
+static void static_redirect_dir(vox_http_context_t* ctx) {
+    const vox_http_request_t* req = &ctx->req;
+    vox_string_t* loc = vox_string_create(ctx->mpool);
+    if (!loc) return;
+    vox_string_append_data(loc, req->path.ptr, req->path.len);
+    vox_string_append(loc, "/");
+    if (req->query.ptr && req->query.len > 0) {
+        vox_string_append(loc, "?");
+        vox_string_append_data(loc, req->query.ptr, req->query.len);
+    }
+    vox_http_context_status(ctx, 301);
+    vox_http_context_header(ctx, "Location", vox_string_cstr(loc));
+    vox_string_destroy(loc);
+}
+
+int vox_http_static_serve(vox_http_static_t* st, vox_http_context_t* ctx, const char* path, size_t path_len) {
+    if (!st || !ctx) return -1;
+
+    char rel[VOX_HTTP_STATIC_MAX_PATH];
+    int rel_len = static_normalize_path(path ? path : "", path ? path_len : 0, rel, sizeof(rel));
+    if (rel_len < 0) {
+        vox_http_context_status(ctx, 403);
+        vox_http_context_write_cstr(ctx, "403 Forbidden");
+        return 0;
+    }
+
+    static_attach_loop(st, ctx);
+
+    static_entry_t* e = NULL;
+    int rc = static_lookup(st, rel, (size_t)rel_len, &e);
+    if (rc == 1) return 1;
+    if (rc < 0) return -1;
+
+    vox_http_method_t method = ctx->req.method;
+    bool head = method == VOX_HTTP_METHOD_HEAD;
+    if (method != VOX_HTTP_METHOD_GET && !head) {
+        vox_http_context_status(ctx, 405);
+        vox_http_context_header(ctx, "Allow", "GET, HEAD");
+        return 0;
+    }
+    if (rc == 2) {
+        static_redirect_dir(ctx);
+        return 0;
+    }
+
+    /* 选择表示：无 Range 且客户端接受 gzip 时优先使用 .gz
+     * HEAD 与 GET 返回相同的状态与头（含 206/416），只是不发送响应体 */
+    vox_strview_t range = vox_http_context_get_header(ctx, "Range");
+    bool has_range = range.ptr && range.len > 0;
+    const static_rep_t* rep = &e->plain;
+    if (e->gz.file && !has_range && static_accepts_gzip(vox_http_context_get_header(ctx, "Accept-Encoding"))) {
+        rep = &e->gz;
+    }
+
+    char value[64];
+    vox_http_context_header(ctx, "ETag", rep->etag);
+    vox_http_context_header(ctx, "Last-Modified", e->last_modified);
+    if (e->gz.file) vox_http_context_header(ctx, "Vary", "Accept-Encoding");
+    if (st->opts.max_age > 0) {
+        snprintf(value, sizeof(value), "max-age=%u", (unsigned)st->opts.max_age);
+        vox_http_context_header(ctx, "Cache-Control", value);
+    }
+
+    /* 条件请求：If-None-Match 优先于 If-Modified-Since */
+    vox_strview_t inm = vox_http_context_get_header(ctx, "If-None-Match");
+    bool not_modified = false;
+    if (inm.ptr && inm.len > 0) {
+        not_modified = static_etag_match(inm, rep->etag);
+    } else {
+        vox_strview_t ims = vox_http_context_get_header(ctx, "If-Modified-Since");
+        int64_t t = static_parse_http_date(ims.ptr, ims.len);
+        not_modified = t >= 0 && e->plain.mtime <= t;
+    }
+    if (not_modified) {
+        st->stats.not_modified++;
+        vox_http_context_status(ctx, 304);
+        return 0;
+    }
+
+    if (rep == &e->gz) {
+        st->stats.precompressed++;
+        vox_http_context_header(ctx, "Content-Encoding", "gzip");
+    } else {
+        vox_http_context_header(ctx, "Accept-Ranges", "bytes");
+    }
+
+    int64_t offset = 0;
+    int64_t count = rep->size;
+    vox_http_context_status(ctx, 200);
+    if (has_range && static_if_range_ok(ctx, e)) {
+        static_range_t ranges[64];
+        int max_ranges = (int)(st->opts.max_ranges < 64 ? st->opts.max_ranges : 64);
+        int n = static_parse_range(range, rep->size, ranges, max_ranges);
+        if (n > 1) n = static_merge_ranges(ranges, n);
+        if (n == 0) {
+            vox_http_context_status(ctx, 416);
+            snprintf(value, sizeof(value), "bytes */%lld", (long long)rep->size);
+            vox_http_context_header(ctx, "Content-Range", value);
+            vox_http_context_header(ctx, "Content-Length", "0");
+            return 0;
+        }
+        if (n > 1) {
+            /* 多区间：boundary 帧与数据拼成响应体（无法与 sendfile 交错），数据量超限时退回整个文件 */
+            int64_t total = 0;
+            for (int i = 0; i < n; i++) total += ranges[i].end - ranges[i].start + 1;
+            if (total <= (int64_t)st->opts.max_multipart_bytes) {
+                return static_send_multipart(st, ctx, e, ranges, n, head) == 0 ? 0 : -1;
+            }
+            n = -1;
+        }
+        if (n == 1) {
+            offset = ranges[0].start;
+            count = ranges[0].end - ranges[0].start + 1;
+            vox_http_context_status(ctx, 206);
+            snprintf(value, sizeof(value), "bytes %lld-%lld/%lld",
+                     (long long)ranges[0].start, (long long)ranges[0].end, (long long)rep->size);
+            vox_http_context_header(ctx, "Content-Range", value);
+        }
+    }
+
+    vox_http_context_header(ctx, "Content-Type", e->content_type);
+    snprintf(value, sizeof(value), "%lld", (long long)count);
+    vox_http_context_header(ctx, "Content-Length", value);
+    if (!head && count > 0) {
+        e->refs++;
+        if (vox_http_context_send_file_shared(ctx, rep->file, offset, (size_t)count, static_entry_release, e) != 0) {
+            static_entry_release(e);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void vox_http_static_handler(vox_http_context_t* ctx) {
+    vox_http_static_t* st = (vox_http_static_t*)vox_http_context_get_user_data(ctx);
+    if (!st) {
+        vox_http_context_next(ctx);
+        return;
+    }
+    const char* path = ctx->mount_path.ptr ? ctx->mount_path.ptr : ctx->req.path.ptr;
+    size_t len = ctx->mount_path.ptr ? ctx->mount_path.len : ctx->req.path.len;
+    int rc = vox_http_static_serve(st, ctx, path, len);
+    if (rc == 1) {
+        vox_http_context_status(ctx, 404);
+        vox_http_context_write_cstr(ctx, "404 Not Found");
+    } else if (rc < 0) {
+        vox_http_context_status(ctx, 500);
+        vox_http_context_write_cstr(ctx, "500 Internal Server Error");
+    }
+}
+
+/* ===== 创建/销毁 ===== */
+
+vox_http_static_t* vox_http_static_create(const char* root, const vox_http_static_options_t* opts) {
+    if (!root || !*root) return NULL;
+    vox_mpool_t* mpool = vox_mpool_create();
+    if (!mpool) return NULL;
+
+    vox_http_static_t* st = (vox_http_static_t*)vox_mpool_alloc(mpool, sizeof(vox_http_static_t));
+    if (!st) {
+        vox_mpool_destroy(mpool);
+        return NULL;
+    }
+    memset(st, 0, sizeof(*st));
+    st->mpool = mpool;
+    st->inotify_fd = -1;
+    if (opts) st->opts = *opts;
+    if (st->opts.max_entries == 0) st->opts.max_entries = VOX_HTTP_STATIC_DEFAULT_ENTRIES;
+    if (st->opts.revalidate_ms == 0) st->opts.revalidate_ms = VOX_HTTP_STATIC_DEFAULT_REVALIDATE;
+    if (st->opts.max_ranges == 0) st->opts.max_ranges = VOX_HTTP_STATIC_DEFAULT_RANGES;
+    if (st->opts.max_multipart_bytes == 0) st->opts.max_multipart_bytes = VOX_HTTP_STATIC_DEFAULT_MULTIPART;
+
+    /* root 去掉末尾 '/'，请求路径总以 '/' 开头 */
+    size_t rlen = strlen(root);
+    while (rlen > 1 && root[rlen - 1] == '/') rlen--;
+    if (rlen >= VOX_HTTP_STATIC_MAX_PATH) {
+        VOX_LOG_ERROR("static root path too long");
+        vox_mpool_destroy(mpool);
+        return NULL;
+    }
+    st->root = (char*)vox_mpool_alloc(mpool, rlen + 1);
+    const char* index = (opts && opts->index_file) ? opts->index_file : "index.html";
+    st->index_len = strlen(index);
+    st->index_file = (char*)vox_mpool_alloc(mpool, st->index_len + 1);
+    st->cache = vox_htable_create(mpool);
+    st->wd_refs = vox_htable_create(mpool);
+    if (!st->root || !st->index_file || !st->cache || !st->wd_refs) {
+        vox_mpool_destroy(mpool);
+        return NULL;
+    }
+    memcpy(st->root, root, rlen);
+    st->root[rlen] = '\0';
+    st->root_len = (rlen == 1 && root[0] == '/') ? 0 : rlen;
+    memcpy(st->index_file, index, st->index_len + 1);
+    st->opts.index_file = st->index_file;
+    vox_list_init(&st->lru);
+
+    vox_file_info_t info;
+    if (vox_file_stat(st->root, &info) != 0 || !info.exists || !info.is_directory) {
+        VOX_LOG_ERROR("static root is not a directory: %s", st->root);
+        vox_htable_destroy(st->cache);
+        vox_htable_destroy(st->wd_refs);
+        vox_mpool_destroy(mpool);
+        return NULL;
+    }
+
+#ifdef VOX_OS_LINUX
+    if (!st->opts.disable_inotify) {
+        st->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (st->inotify_fd < 0) {
+            VOX_LOG_ERROR("inotify_init1 failed, falling back to periodic revalidation");
+        }
+    }
+#endif
+    st->stats.inotify = st->inotify_fd >= 0;
+    return st;
+}
+
+void vox_http_static_clear(vox_http_static_t* st) {
+    if (!st) return;
+    while (!vox_list_empty(&st->lru)) {
+        static_entry_invalidate(vox_container_of(vox_list_first(&st->lru), static_entry_t, node));
+    }
+}
+
+void vox_http_static_destroy(vox_http_static_t* st) {
+    if (!st) return;
+    while (!vox_list_empty(&st->lru)) {
+        static_entry_t* e = vox_container_of(vox_list_first(&st->lru), static_entry_t, node);
+        e->refs = 0;
+        static_entry_remove(e);
+    }
+    vox_htable_destroy(st->cache);
+    vox_htable_destroy(st->wd_refs);
+#ifdef VOX_OS_LINUX
+    vox_loop_unwatch_fd(st->watch);
+    if (st->inotify_fd >= 0) close(st->inotify_fd);
+#endif
+    vox_mpool_destroy(st->mpool);
+}
+
+int vox_http_static_mount(vox_http_static_t* st, vox_http_engine_t* engine, const char* prefix) {
+    if (!st || !engine || !prefix) return -1;
+    return vox_http_engine_mount(engine, prefix, vox_http_static_handler, st);
+}
+
+int vox_http_static_get_stats(const vox_http_static_t* st, vox_http_static_stats_t* stats) {
+    if (!st || !stats) return -1;
+    *stats = st->stats;
+    stats->entries = vox_list_size(&st->lru);
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * vox_http_static.h - HTTP 静态文件服务
+ * - 打开文件/stat 缓存：命中时复用已打开的 fd，不再每次 open + stat
+ * - 缓存失效：Linux 使用 inotify 监听文件所在目录，其它平台（或 inotify 不可用时）按间隔重新 stat 校验
+ *   inotify fd 在首次请求时注册到所属 engine 的 loop，可读时才读取事件；缓存项被淘汰/销毁时移除对应目录的监听
+ * - 条件请求：ETag / Last-Modified，If-None-Match / If-Modified-Since 返回 304
+ * - Range：单区间 206（sendfile 发送），多区间先合并重叠/相邻区间再按 multipart/byteranges 发送，If-Range 校验
+ * - 预压缩：客户端接受 gzip 且存在同名 .gz 文件时直接发送 .gz（Content-Encoding: gzip）
+ * - 明文连接与已启用内核 TLS 发送的连接使用 sendfile 零拷贝；其余 TLS 连接由框架按偏移 pread 读入响应体
+ *
+ * 说明：
+ * - 实例不是线程安全的，应只在一个 loop 线程内使用（多线程 server 每个 loop 创建一个实例）
+ * - 需在使用它的 server 关闭之后再销毁实例（发送中的响应仍持有缓存 fd 的引用）
+ * - 启用 inotify 时需在 loop 销毁之前销毁实例
+ */
+
+#ifndef VOX_HTTP_STATIC_H
+#define VOX_HTTP_STATIC_H
+
+#include "../vox_os.h"
+#include "vox_http_context.h"
+#include "vox_http_engine.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct vox_http_static vox_http_static_t;
+
+/* 静态文件服务选项（全 0 表示使用默认值） */
+typedef struct {
+    const char* index_file;      /* 目录请求的默认文件；NULL 表示 "index.html"，"" 表示不查找 */
+    uint32_t max_entries;        /* 缓存的最大文件数（每项持有打开的 fd）；0 表示默认 1024 */
+    uint32_t revalidate_ms;      /* 未使用 inotify 时重新 stat 校验的间隔（毫秒）；0 表示默认 2000 */
+    uint32_t max_age;            /* Cache-Control: max-age（秒）；0 表示不发送 Cache-Control */
+    uint32_t max_ranges;         /* 单个请求最多处理的区间数，超过时返回整个文件；0 表示默认 16 */
+    uint32_t max_multipart_bytes; /* 多区间响应的数据总量上限（需读入内存），超过时返回整个文件；0 表示默认 1 MiB */
+    bool disable_inotify;        /* true 时不使用 inotify，仅按 revalidate_ms 校验 */
+    bool disable_precompressed;  /* true 时不查找 .gz 预压缩文件 */
+} vox_http_static_options_t;
+
+/* 统计信息 */
+typedef struct {
+    uint64_t hits;               /* 缓存命中 */
+    uint64_t misses;             /* 缓存未命中（需要 open + stat） */
+    uint64_t invalidations;      /* 因文件变化被失效的缓存项 */
+    uint64_t not_modified;       /* 304 响应次数 */
+    uint64_t precompressed;      /* 发送 .gz 预压缩文件的次数 */
+    size_t entries;              /* 当前缓存项数 */
+    bool inotify;                /* 是否启用了 inotify */
+} vox_http_static_stats_t;
+
+/**
+ * 创建静态文件服务实例
+ * @param root 根目录（文件系统路径）
+ * @param opts 选项，NULL 表示使用默认值
+ * @return 成功返回实例，失败返回 NULL
+ */
+vox_http_static_t* vox_http_static_create(const char* root, const vox_http_static_options_t* opts);
+
+/**
+ * 销毁实例：关闭所有缓存的文件
+ */
+void vox_http_static_destroy(vox_http_static_t* st);
+
+/**
+ * 挂载到 engine：路由未命中且路径位于 prefix 下时由本实例处理
+ * 例如 prefix 为 "/static" 时，"/static/js/app.js" 对应 root/js/app.js
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_static_mount(vox_http_static_t* st, vox_http_engine_t* engine, const char* prefix);
+
+/**
+ * 挂载使用的 handler：从 ctx 的 user_data 取得实例，处理挂载前缀之后的路径，文件不存在时返回 404
+ */
+void vox_http_static_handler(vox_http_context_t* ctx);
+
+/**
+ * 处理一个静态文件请求（可在自定义 handler 中直接调用）
+ * @param st 实例
+ * @param ctx HTTP 上下文
+ * @param path 相对 root 的 URL 路径（未解码，可不以 '/' 开头，不必以 NUL 结尾）
+ * @param path_len 路径长度
+ * @return 已生成响应返回0（含 304/206/416/405 等），文件不存在返回1（未写入任何响应），出错返回-1
+ */
+int vox_http_static_serve(vox_http_static_t* st, vox_http_context_t* ctx, const char* path, size_t path_len);
+
+/**
+ * 清空缓存（关闭未被引用的 fd）
+ */
+void vox_http_static_clear(vox_http_static_t* st);
+
+/**
+ * 获取统计信息
+ * @return 成功返回0，失败返回-1
+ */
+int vox_http_static_get_stats(const vox_http_static_t* st, vox_http_static_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_HTTP_STATIC_H */
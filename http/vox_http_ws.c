@@ -17,9 +17,11 @@ struct vox_http_ws_conn {
     vox_http_ws_callbacks_t cbs;
 
     vox_ws_parser_t* parser;  /* 复用 WebSocket 解析器 */
+    vox_ws_deflate_t* deflate; /* permessage-deflate 状态（未协商时为 NULL） */
     vox_string_t* frag;       /* 分片重组缓存 */
     bool frag_active;
     bool frag_is_text;
+    bool frag_compressed;     /* 分片消息的第一帧带 RSV1 */
 
     bool close_sent;
 };
@@ -113,6 +115,27 @@ static int vox_http_ws_send_frame(vox_http_ws_conn_t* ws, uint8_t opcode, const
     return vox_http_conn_ws_write(ws->conn, frame, frame_len);
 }
 
+/* 发送数据消息：已协商压缩时先压缩并设置 RSV1 */
+static int vox_http_ws_send_message(vox_http_ws_conn_t* ws, uint8_t opcode, const void* data, size_t len) {
+    if (!ws->deflate) return vox_http_ws_send_frame(ws, opcode, data, len);
+
+    vox_string_t* deflated = vox_string_create(ws->mpool);
+    if (!deflated) return -1;
+    int ret = vox_ws_deflate_compress(ws->deflate, data, len, deflated);
+    if (ret <= 0) {
+        vox_string_destroy(deflated);
+        return ret == 0 ? vox_http_ws_send_frame(ws, opcode, data, len) : -1;
+    }
+
+    void* frame = NULL;
+    size_t frame_len = 0;
+    ret = vox_ws_build_frame_ex(ws->mpool, opcode, true, vox_string_data(deflated), vox_string_length(deflated),
+                                false, &frame, &frame_len);
+    vox_string_destroy(deflated);
+    if (ret != 0) return -1;
+    return vox_http_conn_ws_write(ws->conn, frame, frame_len);
+}
+
 static int vox_http_ws_send_close_frame(vox_http_ws_conn_t* ws, int code, const char* reason) {
     if (!ws) return -1;
     if (ws->close_sent) return 0;
@@ -130,7 +153,29 @@ static int vox_http_ws_send_close_frame(vox_http_ws_conn_t* ws, int code, const
 }
 
 int vox_http_ws_upgrade(vox_http_context_t* ctx, const vox_http_ws_callbacks_t* cbs) {
+    return vox_http_ws_upgrade_ex(ctx, cbs, NULL);
+}
+
+/* 依次尝试每个 Sec-WebSocket-Extensions 请求头，接受第一个可接受的 permessage-deflate 提议 */
+static int vox_http_ws_negotiate_deflate(const vox_http_request_t* req, const vox_ws_deflate_config_t* compression,
+                                         vox_ws_deflate_params_t* params) {
+    vox_vector_t* headers = (vox_vector_t*)req->headers;
+    if (!headers) return -1;
+    size_t cnt = vox_vector_size(headers);
+    for (size_t i = 0; i < cnt; i++) {
+        const vox_http_header_t* kv = (const vox_http_header_t*)vox_vector_get(headers, i);
+        if (!kv || !kv->name.ptr || !kv->value.ptr) continue;
+        if (!vox_http_strieq(kv->name.ptr, kv->name.len, "Sec-WebSocket-Extensions", 24)) continue;
+        if (vox_ws_deflate_negotiate(compression, kv->value.ptr, kv->value.len, params) == 0) return 0;
+    }
+    return -1;
+}
+
+int vox_http_ws_upgrade_ex(vox_http_context_t* ctx, const vox_http_ws_callbacks_t* cbs,
+                           const vox_ws_deflate_config_t* compression) {
     if (!ctx) return -1;
+    /* HTTP/2 流不支持 Upgrade（RFC 8441 扩展 CONNECT 未实现） */
+    if (ctx->h2_stream) return -1;
     const vox_http_request_t* req = vox_http_context_request(ctx);
     if (!req) return -1;
 
@@ -189,6 +234,16 @@ int vox_http_ws_upgrade(vox_http_context_t* ctx, const vox_http_ws_callbacks_t*
     vox_http_context_header(ctx, "Connection", "Upgrade");
     vox_http_context_header(ctx, "Sec-WebSocket-Accept", accept_copy);
 
+    /* 协商 permessage-deflate：没有可接受的提议时按未压缩方式升级 */
+    vox_ws_deflate_params_t params;
+    if (compression && vox_http_ws_negotiate_deflate(req, compression, &params) == 0) {
+        char extensions[128];
+        if (vox_ws_deflate_format_response(&params, extensions, sizeof(extensions)) > 0) {
+            ws->deflate = vox_ws_deflate_create(vox_http_context_get_loop(ctx), ctx->mpool, compression, &params, true);
+            if (ws->deflate) vox_http_context_header(ctx, "Sec-WebSocket-Extensions", extensions);
+        }
+    }
+
     /* 标记 upgrade：write_done 后切换到 WS 模式 */
     if (ctx->conn) {
         if (vox_http_conn_mark_ws_upgrade(ctx->conn, ws) != 0) return -1;
@@ -202,13 +257,13 @@ int vox_http_ws_upgrade(vox_http_context_t* ctx, const vox_http_ws_callbacks_t*
 int vox_http_ws_send_text(vox_http_ws_conn_t* ws, const char* text, size_t len) {
     if (!ws) return -1;
     if (!text && len > 0) return -1;
-    return vox_http_ws_send_frame(ws, VOX_WS_OP_TEXT, text, len);
+    return vox_http_ws_send_message(ws, VOX_WS_OP_TEXT, text, len);
 }
 
 int vox_http_ws_send_binary(vox_http_ws_conn_t* ws, const void* data, size_t len) {
     if (!ws) return -1;
     if (!data && len > 0) return -1;
-    return vox_http_ws_send_frame(ws, VOX_WS_OP_BINARY, data, len);
+    return vox_http_ws_send_message(ws, VOX_WS_OP_BINARY, data, len);
 }
 
 int vox_http_ws_close(vox_http_ws_conn_t* ws, int code, const char* reason) {
@@ -231,6 +286,36 @@ static int vox_http_ws_deliver_message(vox_http_ws_conn_t* ws, const void* data,
     return 0;
 }
 
+/* 校验并投递一条完整消息（压缩消息先解压） */
+static int vox_http_ws_finish_message(vox_http_ws_conn_t* ws, const void* data, size_t len, bool is_text,
+                                      bool compressed) {
+    vox_string_t* inflated = NULL;
+    if (compressed) {
+        inflated = vox_string_create(ws->mpool);
+        if (!inflated) return -1;
+        int ret = vox_ws_deflate_decompress(ws->deflate, data, len, inflated);
+        if (ret != 0) {
+            vox_string_destroy(inflated);
+            vox_http_ws_report_error(ws, ret == -2 ? "ws protocol error: message too big"
+                                                   : "ws protocol error: invalid compressed data");
+            return -1;
+        }
+        data = vox_string_data(inflated);
+        len = vox_string_length(inflated);
+    }
+
+    /* UTF-8 验证 */
+    if (is_text && !vox_ws_validate_utf8((const uint8_t*)data, len)) {
+        if (inflated) vox_string_destroy(inflated);
+        vox_http_ws_report_error(ws, "ws protocol error: invalid UTF-8");
+        return -1;
+    }
+
+    vox_http_ws_deliver_message(ws, data, len, is_text);
+    if (inflated) vox_string_destroy(inflated);
+    return 0;
+}
+
 int vox_http_ws_internal_feed(vox_http_ws_conn_t* ws, const void* data, size_t len) {
     if (!ws) return -1;
     if (!data || len == 0) return 0;
@@ -251,6 +336,12 @@ int vox_http_ws_internal_feed(vox_http_ws_conn_t* ws, const void* data, size_t l
             return -1;
         }
         
+        /* RSV1 只允许出现在已协商压缩的消息第一帧上 */
+        if (frame.rsv1 && (!ws->deflate || (frame.opcode != VOX_WS_OP_TEXT && frame.opcode != VOX_WS_OP_BINARY))) {
+            vox_http_ws_report_error(ws, "ws protocol error: unexpected RSV1");
+            return -1;
+        }
+
         /* 解掩码（需要创建副本因为 payload 指向解析器内部缓冲区）*/
         uint8_t* payload = NULL;
         if (frame.payload_len > 0) {
@@ -335,19 +426,12 @@ int vox_http_ws_internal_feed(vox_http_ws_conn_t* ws, const void* data, size_t l
             
             if (frame.fin) {
                 /* 分片完成，传递完整消息 */
-                bool is_text = ws->frag_is_text;
-                const void* msg = vox_string_data(ws->frag);
-                size_t mlen = vox_string_length(ws->frag);
-                
-                /* UTF-8 验证 */
-                if (is_text && !vox_ws_validate_utf8((const uint8_t*)msg, mlen)) {
-                    vox_http_ws_report_error(ws, "ws protocol error: invalid UTF-8");
+                ws->frag_active = false;
+                if (vox_http_ws_finish_message(ws, vox_string_data(ws->frag), vox_string_length(ws->frag),
+                                               ws->frag_is_text, ws->frag_compressed) != 0) {
                     vox_string_remove(ws->parser->buffer, 0, (size_t)frame_len);
                     return -1;
                 }
-                
-                ws->frag_active = false;
-                vox_http_ws_deliver_message(ws, msg, mlen, is_text);
                 vox_string_clear(ws->frag);
             }
             
@@ -359,20 +443,17 @@ int vox_http_ws_internal_feed(vox_http_ws_conn_t* ws, const void* data, size_t l
                 /* 开始分片 */
                 ws->frag_active = true;
                 ws->frag_is_text = is_text;
+                ws->frag_compressed = frame.rsv1;
                 vox_string_clear(ws->frag);
                 if (frame.payload_len > 0) {
                     vox_string_append_data(ws->frag, payload, frame.payload_len);
                 }
             } else {
                 /* 完整消息 */
-                /* UTF-8 验证 */
-                if (is_text && !vox_ws_validate_utf8(payload, frame.payload_len)) {
-                    vox_http_ws_report_error(ws, "ws protocol error: invalid UTF-8");
+                if (vox_http_ws_finish_message(ws, payload, frame.payload_len, is_text, frame.rsv1) != 0) {
                     vox_string_remove(ws->parser->buffer, 0, (size_t)frame_len);
                     return -1;
                 }
-                
-                vox_http_ws_deliver_message(ws, payload, frame.payload_len, is_text);
             }
             
         } else {
@@ -9,6 +9,7 @@
 
 #include "../vox_os.h"
 #include "vox_http_context.h"
+#include "../websocket/vox_websocket_deflate.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +34,11 @@ typedef struct {
 /* 在 HTTP handler 内调用：完成握手并切换连接为 WS 模式 */
 int vox_http_ws_upgrade(vox_http_context_t* ctx, const vox_http_ws_callbacks_t* cbs);
 
+/* 同 vox_http_ws_upgrade，compression 非 NULL 时协商 permessage-deflate（RFC 7692，需要 zlib）；
+ * 客户端没有可接受的提议时按未压缩方式升级 */
+int vox_http_ws_upgrade_ex(vox_http_context_t* ctx, const vox_http_ws_callbacks_t* cbs,
+                           const vox_ws_deflate_config_t* compression);
+
 /* 发送消息（服务器侧发送不需要 mask） */
 int vox_http_ws_send_text(vox_http_ws_conn_t* ws, const char* text, size_t len);
 int vox_http_ws_send_binary(vox_http_ws_conn_t* ws, const void* data, size_t len);
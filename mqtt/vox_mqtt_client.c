@@ -1190,6 +1190,7 @@ int vox_mqtt_client_connect(vox_mqtt_client_t* c,
             connect_cleanup_on_fail(c);
             return -1;
         }
+        vox_tls_set_hostname(c->tls, host);
         vox_handle_set_data((vox_handle_t*)c->tls, c);
         vox_socket_addr_t addr;
         if (vox_socket_parse_address(host, port, &addr) == 0) {
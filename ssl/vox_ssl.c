@@ -65,6 +65,31 @@ int vox_ssl_context_configure(vox_ssl_context_t* ctx, const vox_ssl_config_t* co
 #endif
 }
 
+int vox_ssl_context_get_stats(vox_ssl_context_t* ctx, vox_ssl_stats_t* stats) {
+    if (!ctx || !stats) {
+        return -1;
+    }
+#if defined(VOX_USE_OPENSSL)
+    return vox_ssl_openssl_context_get_stats(ctx, stats);
+#else
+    (void)ctx;
+    (void)stats;
+    return -1;  /* 未实现 */
+#endif
+}
+
+int vox_ssl_context_rotate_ticket_keys(vox_ssl_context_t* ctx) {
+    if (!ctx) {
+        return -1;
+    }
+#if defined(VOX_USE_OPENSSL)
+    return vox_ssl_openssl_context_rotate_ticket_keys(ctx);
+#else
+    (void)ctx;
+    return -1;  /* 未实现 */
+#endif
+}
+
 /* ===== SSL Session API ===== */
 
 vox_ssl_session_t* vox_ssl_session_create(vox_ssl_context_t* ctx, vox_mpool_t* mpool) {
@@ -97,6 +122,74 @@ void vox_ssl_session_destroy(vox_ssl_session_t* session) {
 #endif
 }
 
+int vox_ssl_session_set_hostname(vox_ssl_session_t* session, const char* hostname, uint16_t port) {
+    if (!session || !hostname || hostname[0] == '\0') {
+        return -1;
+    }
+#if defined(VOX_USE_OPENSSL)
+    return vox_ssl_openssl_session_set_hostname(session, hostname, port);
+#else
+    (void)session;
+    (void)hostname;
+    (void)port;
+    return -1;  /* 未实现 */
+#endif
+}
+
+bool vox_ssl_session_is_resumed(vox_ssl_session_t* session) {
+    if (!session) {
+        return false;
+    }
+#if defined(VOX_USE_OPENSSL)
+    return vox_ssl_openssl_session_is_resumed(session);
+#else
+    (void)session;
+    return false;
+#endif
+}
+
+int vox_ssl_session_get_alpn(vox_ssl_session_t* session, char* buf, size_t size) {
+    if (!session || !buf || size == 0) {
+        return -1;
+    }
+#if defined(VOX_USE_OPENSSL)
+    return vox_ssl_openssl_session_get_alpn(session, buf, size);
+#else
+    (void)session;
+    (void)buf;
+    (void)size;
+    return -1;  /* 未实现 */
+#endif
+}
+
+int vox_ssl_session_get_ktls_keys(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, vox_ssl_ktls_keys_t* keys) {
+    if (!session || !keys) {
+        return -1;
+    }
+#if defined(VOX_USE_OPENSSL)
+    return vox_ssl_openssl_session_get_ktls_keys(session, dir, keys);
+#else
+    (void)session;
+    (void)dir;
+    (void)keys;
+    return -1;  /* 未实现 */
+#endif
+}
+
+int vox_ssl_session_set_ktls(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, bool offloaded) {
+    if (!session) {
+        return -1;
+    }
+#if defined(VOX_USE_OPENSSL)
+    return vox_ssl_openssl_session_set_ktls(session, dir, offloaded);
+#else
+    (void)session;
+    (void)dir;
+    (void)offloaded;
+    return -1;  /* 未实现 */
+#endif
+}
+
 void* vox_ssl_session_get_rbio(vox_ssl_session_t* session) {
     if (!session) {
         return NULL;
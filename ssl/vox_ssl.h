@@ -58,8 +58,52 @@ typedef struct {
                                 /* 建议值：IPv4 使用 1440，IPv6 使用 1420，最大不超过 1500 */
     const char* use_srtp;        /* DTLS-SRTP（RFC 5764）：SRTP 套件列表，逗号或冒号分隔，
                                    如 "SRTP_AES128_CM_SHA1_80"；仅 DTLS 有效，NULL 表示不启用 */
+    int session_cache_size;      /* 会话缓存容量：服务器为会话缓存条数，客户端为按主机保存的会话数；
+                                   0 表示默认值（服务器 20480，客户端 1024），负数表示禁用 */
+    int session_timeout;         /* 会话有效期（秒），0 表示默认值 300 */
+    bool disable_session_tickets;/* 禁用无状态会话票据（服务器模式；TLS 1.3 下改为使用会话缓存恢复） */
+    int ticket_key_lifetime;     /* 票据密钥轮换周期（秒），0 表示默认值 3600；
+                                   轮换后上一把密钥仍可解密，客户端恢复时会收到新票据 */
+    bool enable_ktls;            /* 握手后尝试把记录加解密卸载到内核 TLS（Linux，TLS 1.2/1.3，
+                                   AES-GCM / ChaCha20-Poly1305）；不支持时自动回退到用户态加密 */
+    const char* alpn_protocols;  /* ALPN 协议列表，逗号分隔、按优先级排列，如 "h2,http/1.1"；
+                                   服务器按本端顺序选择双方都支持的协议，NULL 表示不协商 */
 } vox_ssl_config_t;
 
+/* 会话恢复统计 */
+typedef struct {
+    uint64_t handshakes;         /* 完成的握手次数 */
+    uint64_t resumed;            /* 其中通过会话恢复（会话缓存或票据）完成的次数 */
+    uint64_t cache_hits;         /* 服务器会话缓存命中次数 */
+    uint64_t cache_misses;       /* 服务器会话缓存未命中次数 */
+    uint64_t cache_timeouts;     /* 服务器会话缓存中会话已过期的次数 */
+    size_t cached_sessions;      /* 当前缓存的会话数（服务器为会话缓存，客户端为按主机保存的会话） */
+} vox_ssl_stats_t;
+
+/* 内核 TLS 卸载方向 */
+typedef enum {
+    VOX_SSL_KTLS_TX = 0,         /* 发送 */
+    VOX_SSL_KTLS_RX = 1          /* 接收 */
+} vox_ssl_ktls_dir_t;
+
+/* 内核 TLS 支持的 AEAD 算法 */
+typedef enum {
+    VOX_SSL_KTLS_AES_128_GCM = 1,
+    VOX_SSL_KTLS_AES_256_GCM,
+    VOX_SSL_KTLS_CHACHA20_POLY1305
+} vox_ssl_ktls_cipher_t;
+
+/* 交给内核 TLS 的单方向记录密钥 */
+typedef struct {
+    uint16_t version;            /* 0x0303（TLS 1.2）或 0x0304（TLS 1.3） */
+    vox_ssl_ktls_cipher_t cipher;
+    unsigned char key[32];       /* 写密钥 */
+    size_t key_len;
+    unsigned char iv[12];        /* 写 IV：TLS 1.2 AES-GCM 为 4 字节隐式部分，其余为 12 字节 */
+    size_t iv_len;
+    uint64_t seq;                /* 下一条记录的序号 */
+} vox_ssl_ktls_keys_t;
+
 /* ===== SSL Context API ===== */
 
 /**
@@ -84,6 +128,22 @@ void vox_ssl_context_destroy(vox_ssl_context_t* ctx);
  */
 int vox_ssl_context_configure(vox_ssl_context_t* ctx, const vox_ssl_config_t* config);
 
+/**
+ * 获取会话恢复统计
+ * @param ctx context 指针
+ * @param stats 输出统计信息
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ssl_context_get_stats(vox_ssl_context_t* ctx, vox_ssl_stats_t* stats);
+
+/**
+ * 立即轮换会话票据密钥（服务器模式）：新票据使用新密钥，上一把密钥仍可解密
+ * 默认按 ticket_key_lifetime 自动轮换，无需调用
+ * @param ctx context 指针
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ssl_context_rotate_ticket_keys(vox_ssl_context_t* ctx);
+
 /* ===== SSL Session API ===== */
 
 /**
@@ -100,6 +160,56 @@ vox_ssl_session_t* vox_ssl_session_create(vox_ssl_context_t* ctx, vox_mpool_t* m
  */
 void vox_ssl_session_destroy(vox_ssl_session_t* session);
 
+/**
+ * 设置对端主机名与端口（客户端模式，须在握手前调用）
+ * 用于 SNI、主机名验证（verify_hostname）以及按 主机:端口 复用会话：
+ * context 中保存有该对端的会话时尝试恢复，握手后收到的新会话也按该对端保存
+ * （context 可被多个 loop 共享，会话缓存是线程安全的）
+ * @param session session 指针
+ * @param hostname 主机名或 IP 地址
+ * @param port 对端端口（主机字节序），0 表示未知，此时只按主机名复用
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ssl_session_set_hostname(vox_ssl_session_t* session, const char* hostname, uint16_t port);
+
+/**
+ * 握手是否通过会话恢复完成
+ * @param session session 指针
+ * @return 是返回true，否则返回false
+ */
+bool vox_ssl_session_is_resumed(vox_ssl_session_t* session);
+
+/**
+ * 获取 ALPN 协商结果
+ * @param session session 指针（须已完成握手）
+ * @param buf 输出协议名（以 '\0' 结尾）
+ * @param size buf 大小
+ * @return 返回协议名长度，未协商 ALPN 返回0，失败返回-1
+ */
+int vox_ssl_session_get_alpn(vox_ssl_session_t* session, char* buf, size_t size);
+
+/**
+ * 导出某一方向的记录密钥与序号，用于安装内核 TLS（需 context 配置 enable_ktls）
+ * 发送方向要求 wbio 中的密文已全部取出；接收方向要求 rbio 与 SSL 内部没有未处理的记录
+ * 客户端 TLS 1.3 不卸载接收方向（握手后仍会收到会话票据）
+ * @param session session 指针（须已完成握手）
+ * @param dir 方向
+ * @param keys 输出密钥（用完后应清零）
+ * @return 成功返回0；还有未处理的记录、稍后可重试返回 VOX_SSL_ERROR_WANT_READ；不支持返回-1
+ */
+int vox_ssl_session_get_ktls_keys(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, vox_ssl_ktls_keys_t* keys);
+
+/**
+ * 记录某一方向的卸载结果
+ * offloaded 为 true 表示该方向的记录已由内核处理，之后 session 不再在该方向上读写；
+ * 为 false 表示放弃卸载（例如内核不支持），该方向继续使用用户态加密
+ * @param session session 指针
+ * @param dir 方向
+ * @param offloaded 是否已卸载
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ssl_session_set_ktls(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, bool offloaded);
+
 /**
  * 获取读取 BIO（用于从 socket 读取加密数据后写入）
  * @param session session 指针
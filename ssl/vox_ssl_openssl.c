@@ -6,17 +6,43 @@
 #include "vox_ssl_openssl.h"
 #include "../vox_log.h"
 #include "../vox_mpool.h"
+#include "../vox_mutex.h"
+#include "../vox_atomic.h"
+#include "../vox_htable.h"
+#include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 #ifdef VOX_USE_OPENSSL
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <openssl/bio.h>
 #include <openssl/x509.h>
+#include <openssl/x509v3.h>
 #include <openssl/pem.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/kdf.h>
+#else
+#include <openssl/hmac.h>
+#endif
 #endif
 
 #ifdef VOX_USE_OPENSSL
+
+#define VOX_SSL_CLIENT_CACHE_DEFAULT 1024   /* 客户端按主机保存的会话数默认上限 */
+#define VOX_SSL_TICKET_KEY_LIFETIME 3600    /* 票据密钥默认轮换周期（秒） */
+
+/* 会话票据密钥 */
+typedef struct {
+    unsigned char name[16];      /* 密钥名（写入票据，用于解密时查找） */
+    unsigned char aes_key[32];   /* AES-256-CBC 加密密钥 */
+    unsigned char hmac_key[32];  /* HMAC-SHA256 密钥 */
+    time_t created;              /* 生成时间 */
+} vox_ssl_ticket_key_t;
+
 /* OpenSSL Context 结构 */
 struct vox_ssl_context {
     SSL_CTX* ctx;                /* OpenSSL context */
@@ -24,8 +50,37 @@ struct vox_ssl_context {
     vox_mpool_t* mpool;          /* 内存池 */
     bool is_dtls;                /* 是否使用 DTLS（而不是 TLS） */
     int dtls_mtu;                /* DTLS 应用层 MTU（字节），0 表示使用默认值 */
+    bool verify_hostname;        /* 客户端是否验证主机名 */
+
+    /* 会话恢复（context 可被多个 loop 共享，以下状态由 lock 保护） */
+    vox_mutex_t lock;
+    vox_mpool_t* cache_pool;     /* 客户端会话缓存使用的线程安全内存池 */
+    vox_htable_t* client_sessions; /* 主机名:端口 -> SSL_SESSION*（客户端） */
+    size_t client_cache_size;    /* 客户端会话缓存上限，0 表示禁用 */
+    vox_ssl_ticket_key_t ticket_keys[2]; /* [0] 当前密钥，[1] 上一把密钥 */
+    int ticket_key_count;
+    int ticket_key_lifetime;     /* 票据密钥轮换周期（秒） */
+    vox_atomic_long_t handshakes; /* 完成的握手次数 */
+    vox_atomic_long_t resumed;   /* 会话恢复次数 */
+    bool enable_ktls;            /* 是否为内核 TLS 记录序号与流量密钥 */
+    unsigned char alpn[256];     /* ALPN 协议列表（线格式：长度前缀），按优先级排列 */
+    unsigned int alpn_len;       /* 0 表示未配置 ALPN */
 };
 
+/* 内核 TLS 卸载状态（按 vox_ssl_ktls_dir_t 下标） */
+#define VOX_SSL_KTLS_PENDING 0     /* 尚未决定 */
+#define VOX_SSL_KTLS_OFFLOADED 1   /* 已卸载到内核 */
+#define VOX_SSL_KTLS_DECLINED 2    /* 不卸载 */
+
+typedef struct {
+    uint8_t state[2];            /* 每个方向的卸载状态 */
+    bool finished[2];            /* 该方向已经过 Finished 消息 */
+    bool key_updated[2];         /* 该方向发生过 KeyUpdate，记录的流量密钥已失效 */
+    uint64_t records[2];         /* Finished 之后该方向的记录数 */
+    unsigned char secret[2][EVP_MAX_MD_SIZE]; /* TLS 1.3 应用流量密钥 */
+    size_t secret_len[2];
+} vox_ssl_ktls_track_t;
+
 /* OpenSSL Session 结构 */
 struct vox_ssl_session {
     SSL* ssl;                    /* OpenSSL SSL 对象 */
@@ -35,6 +90,8 @@ struct vox_ssl_session {
     vox_ssl_state_t state;       /* SSL 状态 */
     vox_ssl_error_t last_error;  /* 最后的错误码 */
     vox_mpool_t* mpool;          /* 内存池 */
+    char* cache_key;             /* 客户端会话缓存键（主机名:端口），NULL 表示不缓存 */
+    vox_ssl_ktls_track_t* ktls;  /* 内核 TLS 跟踪状态，context 未启用时为 NULL */
 };
 
 /* 将 OpenSSL 错误码转换为 vox_ssl_error_t */
@@ -57,6 +114,464 @@ static vox_ssl_error_t openssl_error_to_vox_error(int ssl_error) {
     }
 }
 
+/* ===== 会话恢复 ===== */
+
+/* 生成新的票据密钥并把当前密钥降为上一把（调用方持有 lock） */
+static int openssl_rotate_ticket_keys_locked(vox_ssl_context_t* ctx) {
+    vox_ssl_ticket_key_t key;
+    if (RAND_bytes(key.name, sizeof(key.name)) != 1 ||
+        RAND_bytes(key.aes_key, sizeof(key.aes_key)) != 1 ||
+        RAND_bytes(key.hmac_key, sizeof(key.hmac_key)) != 1) {
+        VOX_LOG_ERROR("Failed to generate session ticket key");
+        return -1;
+    }
+    key.created = time(NULL);
+    if (ctx->ticket_key_count > 0) {
+        ctx->ticket_keys[1] = ctx->ticket_keys[0];
+    }
+    ctx->ticket_keys[0] = key;
+    if (ctx->ticket_key_count < 2) {
+        ctx->ticket_key_count++;
+    }
+    OPENSSL_cleanse(&key, sizeof(key));
+    return 0;
+}
+
+/* 取出加密用的当前密钥（到期自动轮换） */
+static int openssl_current_ticket_key(vox_ssl_context_t* ctx, vox_ssl_ticket_key_t* out) {
+    int ret = 0;
+    vox_mutex_lock(&ctx->lock);
+    if (ctx->ticket_key_count == 0 ||
+        time(NULL) - ctx->ticket_keys[0].created >= ctx->ticket_key_lifetime) {
+        ret = openssl_rotate_ticket_keys_locked(ctx);
+    }
+    if (ret == 0) {
+        *out = ctx->ticket_keys[0];
+    }
+    vox_mutex_unlock(&ctx->lock);
+    return ret;
+}
+
+/* 按名字查找解密用的密钥：返回 1 当前密钥，2 上一把密钥（需要续发新票据），0 未找到 */
+static int openssl_find_ticket_key(vox_ssl_context_t* ctx, const unsigned char* name, vox_ssl_ticket_key_t* out) {
+    int ret = 0;
+    vox_mutex_lock(&ctx->lock);
+    for (int i = 0; i < ctx->ticket_key_count; i++) {
+        if (memcmp(ctx->ticket_keys[i].name, name, sizeof(ctx->ticket_keys[i].name)) == 0) {
+            *out = ctx->ticket_keys[i];
+            ret = (i == 0) ? 1 : 2;
+            break;
+        }
+    }
+    vox_mutex_unlock(&ctx->lock);
+    return ret;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+static int openssl_ticket_hmac_init(EVP_MAC_CTX* hctx, unsigned char* hmac_key) {
+    OSSL_PARAM params[3];
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, hmac_key, 32);
+    params[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char*)"SHA256", 0);
+    params[2] = OSSL_PARAM_construct_end();
+    return EVP_MAC_CTX_set_params(hctx, params) == 1 ? 0 : -1;
+}
+
+static int openssl_ticket_key_cb(SSL* ssl, unsigned char key_name[16], unsigned char* iv,
+                                 EVP_CIPHER_CTX* cctx, EVP_MAC_CTX* hctx, int enc)
+#else
+static int openssl_ticket_hmac_init(HMAC_CTX* hctx, unsigned char* hmac_key) {
+    return HMAC_Init_ex(hctx, hmac_key, 32, EVP_sha256(), NULL) == 1 ? 0 : -1;
+}
+
+static int openssl_ticket_key_cb(SSL* ssl, unsigned char key_name[16], unsigned char* iv,
+                                 EVP_CIPHER_CTX* cctx, HMAC_CTX* hctx, int enc)
+#endif
+{
+    vox_ssl_context_t* ctx = (vox_ssl_context_t*)SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl));
+    if (!ctx) {
+        return -1;
+    }
+
+    vox_ssl_ticket_key_t key;
+    int ret;
+    if (enc) {
+        /* 签发票据：使用当前密钥 */
+        if (openssl_current_ticket_key(ctx, &key) != 0 ||
+            RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1) {
+            return -1;
+        }
+        memcpy(key_name, key.name, sizeof(key.name));
+        ret = 1;
+        if (EVP_EncryptInit_ex(cctx, EVP_aes_256_cbc(), NULL, key.aes_key, iv) != 1) {
+            ret = -1;
+        }
+    } else {
+        /* 解密票据：未知密钥回退到完整握手 */
+        ret = openssl_find_ticket_key(ctx, key_name, &key);
+        if (ret == 0) {
+            return 0;
+        }
+        if (EVP_DecryptInit_ex(cctx, EVP_aes_256_cbc(), NULL, key.aes_key, iv) != 1) {
+            ret = -1;
+        }
+    }
+    if (ret > 0 && openssl_ticket_hmac_init(hctx, key.hmac_key) != 0) {
+        ret = -1;
+    }
+    OPENSSL_cleanse(&key, sizeof(key));
+    return ret;
+}
+
+/* 客户端收到新会话（TLS 1.3 下在握手之后到达）：按主机保存 */
+static int openssl_new_session_cb(SSL* ssl, SSL_SESSION* sess) {
+    vox_ssl_session_t* session = (vox_ssl_session_t*)SSL_get_app_data(ssl);
+    if (!session || !session->cache_key || !SSL_SESSION_is_resumable(sess)) {
+        return 0;
+    }
+    vox_ssl_context_t* ctx = session->ctx;
+    /* 缓存已禁用（session_cache_size < 0）：查找不会读取，不保存 */
+    if (!ctx->client_sessions || ctx->client_cache_size == 0) {
+        return 0;
+    }
+
+    int ret = 0;
+    vox_mutex_lock(&ctx->lock);
+    /* 超出上限时整体清空（主机数超过上限属于少见情况） */
+    if (vox_htable_size(ctx->client_sessions) >= ctx->client_cache_size &&
+        !vox_htable_contains(ctx->client_sessions, session->cache_key, strlen(session->cache_key))) {
+        vox_htable_clear(ctx->client_sessions);
+    }
+    if (vox_htable_set(ctx->client_sessions, session->cache_key, strlen(session->cache_key), sess) == 0) {
+        ret = 1;  /* 缓存持有 sess 的引用 */
+    }
+    vox_mutex_unlock(&ctx->lock);
+    return ret;
+}
+
+static void openssl_session_free(void* value) {
+    SSL_SESSION_free((SSL_SESSION*)value);
+}
+
+/* 初始化会话恢复相关状态（context 创建时调用） */
+static int openssl_session_resumption_init(vox_ssl_context_t* ctx) {
+    if (vox_mutex_create(&ctx->lock) != 0) {
+        return -1;
+    }
+    vox_atomic_long_init(&ctx->handshakes, 0);
+    vox_atomic_long_init(&ctx->resumed, 0);
+    ctx->ticket_key_lifetime = VOX_SSL_TICKET_KEY_LIFETIME;
+    SSL_CTX_set_app_data(ctx->ctx, ctx);
+
+    if (ctx->mode == VOX_SSL_MODE_SERVER) {
+        /* 会话缓存要求设置 session id context；票据使用可轮换的密钥 */
+        SSL_CTX_set_session_id_context(ctx->ctx, (const unsigned char*)"vox", 3);
+        SSL_CTX_set_session_cache_mode(ctx->ctx, SSL_SESS_CACHE_SERVER);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx->ctx, openssl_ticket_key_cb);
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(ctx->ctx, openssl_ticket_key_cb);
+#endif
+        return 0;
+    }
+
+    /* 客户端：会话由 new_session_cb 按主机保存，不使用 OpenSSL 内部缓存 */
+    vox_mpool_config_t pool_config;
+    memset(&pool_config, 0, sizeof(pool_config));
+    pool_config.thread_safe = 1;
+    ctx->cache_pool = vox_mpool_create_with_config(&pool_config);
+    if (!ctx->cache_pool) {
+        vox_mutex_destroy(&ctx->lock);
+        return -1;
+    }
+    vox_htable_config_t table_config;
+    memset(&table_config, 0, sizeof(table_config));
+    table_config.value_free = openssl_session_free;
+    ctx->client_sessions = vox_htable_create_with_config(ctx->cache_pool, &table_config);
+    if (!ctx->client_sessions) {
+        vox_mpool_destroy(ctx->cache_pool);
+        ctx->cache_pool = NULL;
+        vox_mutex_destroy(&ctx->lock);
+        return -1;
+    }
+    ctx->client_cache_size = VOX_SSL_CLIENT_CACHE_DEFAULT;
+    SSL_CTX_set_session_cache_mode(ctx->ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx->ctx, openssl_new_session_cb);
+    return 0;
+}
+
+/* 应用会话恢复相关配置 */
+static void openssl_configure_session_resumption(vox_ssl_context_t* ctx, const vox_ssl_config_t* config) {
+    if (config->session_timeout > 0) {
+        SSL_CTX_set_timeout(ctx->ctx, (long)config->session_timeout);
+    }
+    if (config->ticket_key_lifetime > 0) {
+        ctx->ticket_key_lifetime = config->ticket_key_lifetime;
+    }
+
+    if (ctx->mode == VOX_SSL_MODE_SERVER) {
+        if (config->session_cache_size < 0) {
+            SSL_CTX_set_session_cache_mode(ctx->ctx, SSL_SESS_CACHE_OFF);
+        } else if (config->session_cache_size > 0) {
+            SSL_CTX_sess_set_cache_size(ctx->ctx, (long)config->session_cache_size);
+        }
+        if (config->disable_session_tickets) {
+            SSL_CTX_set_options(ctx->ctx, SSL_OP_NO_TICKET);
+        }
+        return;
+    }
+
+    vox_mutex_lock(&ctx->lock);
+    if (config->session_cache_size < 0) {
+        ctx->client_cache_size = 0;
+        if (ctx->client_sessions) {
+            vox_htable_clear(ctx->client_sessions);
+        }
+    } else if (config->session_cache_size > 0) {
+        ctx->client_cache_size = (size_t)config->session_cache_size;
+    }
+    vox_mutex_unlock(&ctx->lock);
+}
+
+/* 释放会话恢复相关状态 */
+static void openssl_session_resumption_cleanup(vox_ssl_context_t* ctx) {
+    if (ctx->client_sessions) {
+        vox_htable_destroy(ctx->client_sessions);
+        ctx->client_sessions = NULL;
+    }
+    if (ctx->cache_pool) {
+        vox_mpool_destroy(ctx->cache_pool);
+        ctx->cache_pool = NULL;
+    }
+    OPENSSL_cleanse(ctx->ticket_keys, sizeof(ctx->ticket_keys));
+    vox_mutex_destroy(&ctx->lock);
+}
+
+/* 主机名是否为 IP 地址（SNI 不能携带 IP 地址） */
+static bool openssl_hostname_is_ip(const char* hostname) {
+    if (strchr(hostname, ':')) {
+        return true;
+    }
+    for (const char* p = hostname; *p; p++) {
+        if ((*p < '0' || *p > '9') && *p != '.') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* ===== 内核 TLS ===== */
+
+/* 记录 Finished 之后每个方向的记录数，即卸载时内核应使用的序号 */
+static void openssl_ktls_msg_cb(int write_p, int version, int content_type, const void* buf,
+                                size_t len, SSL* ssl, void* arg) {
+    (void)version;
+    (void)ssl;
+    vox_ssl_session_t* session = (vox_ssl_session_t*)arg;
+    if (!session || !session->ktls) {
+        return;
+    }
+    vox_ssl_ktls_track_t* track = session->ktls;
+    int dir = write_p ? VOX_SSL_KTLS_TX : VOX_SSL_KTLS_RX;
+
+    if (content_type == SSL3_RT_HEADER) {
+        if (track->finished[dir]) {
+            track->records[dir]++;
+        }
+    } else if (content_type == SSL3_RT_HANDSHAKE && len > 0) {
+        int type = ((const unsigned char*)buf)[0];
+        if (type == SSL3_MT_FINISHED) {
+            track->finished[dir] = true;
+            track->records[dir] = 0;
+        } else if (type == SSL3_MT_KEY_UPDATE) {
+            track->key_updated[dir] = true;
+        }
+    }
+}
+
+/* 十六进制字符串解码，返回字节数，失败返回0 */
+static size_t openssl_hex_decode(const char* hex, size_t hex_len, unsigned char* out, size_t out_cap) {
+    if (hex_len % 2 != 0 || hex_len / 2 > out_cap) {
+        return 0;
+    }
+    for (size_t i = 0; i < hex_len / 2; i++) {
+        int v = 0;
+        for (int j = 0; j < 2; j++) {
+            char c = hex[i * 2 + j];
+            int d;
+            if (c >= '0' && c <= '9') d = c - '0';
+            else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+            else return 0;
+            v = (v << 4) | d;
+        }
+        out[i] = (unsigned char)v;
+    }
+    return hex_len / 2;
+}
+
+/* TLS 1.3 的应用流量密钥只能从 keylog 回调取得（格式：标签 client_random 密钥） */
+static void openssl_ktls_keylog_cb(const SSL* ssl, const char* line) {
+    vox_ssl_session_t* session = (vox_ssl_session_t*)SSL_get_app_data(ssl);
+    if (!session || !session->ktls) {
+        return;
+    }
+
+    bool client_secret;
+    if (strncmp(line, "CLIENT_TRAFFIC_SECRET_0 ", 24) == 0) {
+        client_secret = true;
+    } else if (strncmp(line, "SERVER_TRAFFIC_SECRET_0 ", 24) == 0) {
+        client_secret = false;
+    } else {
+        return;
+    }
+    const char* secret = strchr(line + 24, ' ');
+    if (!secret) {
+        return;
+    }
+    secret++;
+
+    bool is_client = session->ctx->mode == VOX_SSL_MODE_CLIENT;
+    int dir = (client_secret == is_client) ? VOX_SSL_KTLS_TX : VOX_SSL_KTLS_RX;
+    vox_ssl_ktls_track_t* track = session->ktls;
+    track->secret_len[dir] = openssl_hex_decode(secret, strlen(secret), track->secret[dir], sizeof(track->secret[dir]));
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+/* HKDF-Expand-Label（RFC 8446 7.1），context 为空 */
+static int openssl_hkdf_expand_label(const char* md_name, const unsigned char* secret, size_t secret_len,
+                                     const char* label, unsigned char* out, size_t out_len) {
+    unsigned char info[2 + 1 + 6 + 32 + 1];
+    size_t label_len = strlen(label);
+    if (label_len > 32) {
+        return -1;
+    }
+    size_t n = 0;
+    info[n++] = (unsigned char)(out_len >> 8);
+    info[n++] = (unsigned char)out_len;
+    info[n++] = (unsigned char)(6 + label_len);
+    memcpy(info + n, "tls13 ", 6);
+    n += 6;
+    memcpy(info + n, label, label_len);
+    n += label_len;
+    info[n++] = 0;
+
+    EVP_KDF* kdf = EVP_KDF_fetch(NULL, "HKDF", NULL);
+    EVP_KDF_CTX* kctx = kdf ? EVP_KDF_CTX_new(kdf) : NULL;
+    EVP_KDF_free(kdf);
+    if (!kctx) {
+        return -1;
+    }
+    int mode = EVP_KDF_HKDF_MODE_EXPAND_ONLY;
+    OSSL_PARAM params[5];
+    params[0] = OSSL_PARAM_construct_int(OSSL_KDF_PARAM_MODE, &mode);
+    params[1] = OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, (char*)md_name, 0);
+    params[2] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_KEY, (void*)secret, secret_len);
+    params[3] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_INFO, info, n);
+    params[4] = OSSL_PARAM_construct_end();
+    int ret = EVP_KDF_derive(kctx, out, out_len, params) == 1 ? 0 : -1;
+    EVP_KDF_CTX_free(kctx);
+    return ret;
+}
+
+/* TLS 1.2 密钥块：PRF(master_secret, "key expansion", server_random + client_random) */
+static int openssl_tls12_key_block(SSL* ssl, const char* md_name, unsigned char* out, size_t out_len) {
+    unsigned char master[SSL_MAX_MASTER_KEY_LENGTH];
+    unsigned char seed[13 + 2 * SSL3_RANDOM_SIZE];
+    size_t master_len = SSL_SESSION_get_master_key(SSL_get_session(ssl), master, sizeof(master));
+    if (master_len == 0) {
+        return -1;
+    }
+    memcpy(seed, "key expansion", 13);
+    SSL_get_server_random(ssl, seed + 13, SSL3_RANDOM_SIZE);
+    SSL_get_client_random(ssl, seed + 13 + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+    int ret = -1;
+    EVP_KDF* kdf = EVP_KDF_fetch(NULL, "TLS1-PRF", NULL);
+    EVP_KDF_CTX* kctx = kdf ? EVP_KDF_CTX_new(kdf) : NULL;
+    EVP_KDF_free(kdf);
+    if (kctx) {
+        OSSL_PARAM params[4];
+        params[0] = OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, (char*)md_name, 0);
+        params[1] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SECRET, master, master_len);
+        params[2] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SEED, seed, sizeof(seed));
+        params[3] = OSSL_PARAM_construct_end();
+        ret = EVP_KDF_derive(kctx, out, out_len, params) == 1 ? 0 : -1;
+        EVP_KDF_CTX_free(kctx);
+    }
+    OPENSSL_cleanse(master, sizeof(master));
+    return ret;
+}
+
+/* 按协商结果导出某一方向的记录密钥 */
+static int openssl_ktls_derive(vox_ssl_session_t* session, int dir, vox_ssl_ktls_keys_t* keys) {
+    SSL* ssl = session->ssl;
+    const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+    const EVP_MD* md = cipher ? SSL_CIPHER_get_handshake_digest(cipher) : NULL;
+    if (!md) {
+        return -1;
+    }
+    const char* md_name = EVP_MD_get0_name(md);
+
+    memset(keys, 0, sizeof(*keys));
+    switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+        case NID_aes_128_gcm:
+            keys->cipher = VOX_SSL_KTLS_AES_128_GCM;
+            keys->key_len = 16;
+            break;
+        case NID_aes_256_gcm:
+            keys->cipher = VOX_SSL_KTLS_AES_256_GCM;
+            keys->key_len = 32;
+            break;
+        case NID_chacha20_poly1305:
+            keys->cipher = VOX_SSL_KTLS_CHACHA20_POLY1305;
+            keys->key_len = 32;
+            break;
+        default:
+            return -1;
+    }
+
+    vox_ssl_ktls_track_t* track = session->ktls;
+    int version = SSL_version(ssl);
+    if (version == TLS1_3_VERSION) {
+        if (track->secret_len[dir] == 0) {
+            return -1;
+        }
+        keys->version = 0x0304;
+        keys->iv_len = 12;
+        keys->seq = track->records[dir];
+        if (openssl_hkdf_expand_label(md_name, track->secret[dir], track->secret_len[dir], "key",
+                                      keys->key, keys->key_len) != 0 ||
+            openssl_hkdf_expand_label(md_name, track->secret[dir], track->secret_len[dir], "iv",
+                                      keys->iv, keys->iv_len) != 0) {
+            OPENSSL_cleanse(keys, sizeof(*keys));
+            return -1;
+        }
+        return 0;
+    }
+    if (version != TLS1_2_VERSION) {
+        return -1;
+    }
+
+    /* TLS 1.2 AEAD 密钥块：client_key | server_key | client_iv | server_iv；Finished 占用序号0 */
+    keys->version = 0x0303;
+    keys->iv_len = (keys->cipher == VOX_SSL_KTLS_CHACHA20_POLY1305) ? 12 : 4;
+    keys->seq = track->records[dir] + 1;
+    unsigned char block[2 * 32 + 2 * 12];
+    size_t block_len = 2 * keys->key_len + 2 * keys->iv_len;
+    if (openssl_tls12_key_block(ssl, md_name, block, block_len) != 0) {
+        OPENSSL_cleanse(keys, sizeof(*keys));
+        return -1;
+    }
+    bool client_side = (session->ctx->mode == VOX_SSL_MODE_CLIENT) == (dir == VOX_SSL_KTLS_TX);
+    size_t key_off = client_side ? 0 : keys->key_len;
+    size_t iv_off = 2 * keys->key_len + (client_side ? 0 : keys->iv_len);
+    memcpy(keys->key, block + key_off, keys->key_len);
+    memcpy(keys->iv, block + iv_off, keys->iv_len);
+    OPENSSL_cleanse(block, sizeof(block));
+    return 0;
+}
+#endif
+
 /* ===== Context API ===== */
 
 vox_ssl_context_t* vox_ssl_openssl_context_create(vox_mpool_t* mpool, vox_ssl_mode_t mode) {
@@ -92,6 +607,13 @@ vox_ssl_context_t* vox_ssl_openssl_context_create(vox_mpool_t* mpool, vox_ssl_mo
     /* 设置默认选项 */
     SSL_CTX_set_options(ctx->ctx, SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
 
+    if (openssl_session_resumption_init(ctx) != 0) {
+        VOX_LOG_ERROR("Failed to initialize SSL session resumption");
+        SSL_CTX_free(ctx->ctx);
+        vox_mpool_free(mpool, ctx);
+        return NULL;
+    }
+
     return ctx;
 }
 
@@ -105,6 +627,8 @@ void vox_ssl_openssl_context_destroy(vox_ssl_context_t* ctx) {
         ctx->ctx = NULL;
     }
 
+    openssl_session_resumption_cleanup(ctx);
+
     vox_mpool_t* mpool = ctx->mpool;
     vox_mpool_free(mpool, ctx);
 }
@@ -141,6 +665,20 @@ static int vox_ssl_openssl_context_configure_dtls(vox_ssl_context_t* ctx) {
     /* 禁用自动查询 MTU（推荐手动设置） */
     SSL_CTX_set_options(ctx->ctx, SSL_OP_NO_QUERY_MTU);
 
+    /* 新的 context 需要重新关联会话恢复回调 */
+    SSL_CTX_set_app_data(ctx->ctx, ctx);
+    if (ctx->mode == VOX_SSL_MODE_SERVER) {
+        SSL_CTX_set_session_id_context(ctx->ctx, (const unsigned char*)"vox", 3);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx->ctx, openssl_ticket_key_cb);
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(ctx->ctx, openssl_ticket_key_cb);
+#endif
+    } else {
+        SSL_CTX_set_session_cache_mode(ctx->ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx->ctx, openssl_new_session_cb);
+    }
+
     /* 释放旧的 context */
     SSL_CTX_free(old_ctx);
 
@@ -150,6 +688,42 @@ static int vox_ssl_openssl_context_configure_dtls(vox_ssl_context_t* ctx) {
     return 0;
 }
 
+/* 把逗号分隔的协议列表转换为 ALPN 线格式 */
+static int openssl_alpn_encode(const char* list, unsigned char* out, size_t out_size, unsigned int* out_len) {
+    size_t n = 0;
+    const char* p = list;
+    while (*p) {
+        const char* end = strchr(p, ',');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        while (len > 0 && (*p == ' ' || *p == '\t')) { p++; len--; }
+        while (len > 0 && (p[len - 1] == ' ' || p[len - 1] == '\t')) len--;
+        if (len > 0) {
+            if (len > 255 || n + 1 + len > out_size) return -1;
+            out[n++] = (unsigned char)len;
+            memcpy(out + n, p, len);
+            n += len;
+        }
+        if (!end) break;
+        p = end + 1;
+    }
+    *out_len = (unsigned int)n;
+    return 0;
+}
+
+/* 服务器 ALPN 选择：按服务器配置的优先级取第一个客户端也支持的协议，没有交集时不协商 ALPN */
+static int openssl_alpn_select_cb(SSL* ssl, const unsigned char** out, unsigned char* outlen,
+                                  const unsigned char* in, unsigned int inlen, void* arg) {
+    (void)ssl;
+    vox_ssl_context_t* ctx = (vox_ssl_context_t*)arg;
+    unsigned char* selected = NULL;
+    if (!ctx || ctx->alpn_len == 0 ||
+        SSL_select_next_proto(&selected, outlen, ctx->alpn, ctx->alpn_len, in, inlen) != OPENSSL_NPN_NEGOTIATED) {
+        return SSL_TLSEXT_ERR_NOACK;
+    }
+    *out = selected;
+    return SSL_TLSEXT_ERR_OK;
+}
+
 int vox_ssl_openssl_context_configure(vox_ssl_context_t* ctx, const vox_ssl_config_t* config) {
     if (!ctx || !config) {
         return -1;
@@ -193,6 +767,8 @@ int vox_ssl_openssl_context_configure(vox_ssl_context_t* ctx, const vox_ssl_conf
             }
         }
 
+        ctx->verify_hostname = config->verify_hostname;
+
         /* 设置验证模式 */
         if (config->verify_peer) {
             SSL_CTX_set_verify(ctx->ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, NULL);
@@ -233,9 +809,64 @@ int vox_ssl_openssl_context_configure(vox_ssl_context_t* ctx, const vox_ssl_conf
     }
 #endif
 
+    openssl_configure_session_resumption(ctx, config);
+
+    /* ALPN（RFC 7301）：服务器按本端优先级选择，客户端在 ClientHello 中通告 */
+    ctx->alpn_len = 0;
+    if (!ctx->is_dtls && config->alpn_protocols && config->alpn_protocols[0] != '\0') {
+        if (openssl_alpn_encode(config->alpn_protocols, ctx->alpn, sizeof(ctx->alpn), &ctx->alpn_len) != 0 ||
+            ctx->alpn_len == 0) {
+            VOX_LOG_ERROR("Invalid ALPN protocol list: %s", config->alpn_protocols);
+            ctx->alpn_len = 0;
+            return -1;
+        }
+        if (ctx->mode == VOX_SSL_MODE_SERVER) {
+            SSL_CTX_set_alpn_select_cb(ctx->ctx, openssl_alpn_select_cb, ctx);
+        } else if (SSL_CTX_set_alpn_protos(ctx->ctx, ctx->alpn, ctx->alpn_len) != 0) {
+            VOX_LOG_ERROR("Failed to set ALPN protocols");
+            return -1;
+        }
+    }
+
+    /* 内核 TLS 需要在握手期间统计记录序号并取得 TLS 1.3 流量密钥 */
+    ctx->enable_ktls = config->enable_ktls && !ctx->is_dtls;
+    SSL_CTX_set_keylog_callback(ctx->ctx, ctx->enable_ktls ? openssl_ktls_keylog_cb : NULL);
+
+    return 0;
+}
+
+int vox_ssl_openssl_context_get_stats(vox_ssl_context_t* ctx, vox_ssl_stats_t* stats) {
+    if (!ctx || !ctx->ctx || !stats) {
+        return -1;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->handshakes = (uint64_t)vox_atomic_long_load(&ctx->handshakes);
+    stats->resumed = (uint64_t)vox_atomic_long_load(&ctx->resumed);
+    if (ctx->mode == VOX_SSL_MODE_SERVER) {
+        stats->cache_hits = (uint64_t)SSL_CTX_sess_hits(ctx->ctx);
+        stats->cache_misses = (uint64_t)SSL_CTX_sess_misses(ctx->ctx);
+        stats->cache_timeouts = (uint64_t)SSL_CTX_sess_timeouts(ctx->ctx);
+        stats->cached_sessions = (size_t)SSL_CTX_sess_number(ctx->ctx);
+    } else if (ctx->client_sessions) {
+        vox_mutex_lock(&ctx->lock);
+        stats->cached_sessions = vox_htable_size(ctx->client_sessions);
+        vox_mutex_unlock(&ctx->lock);
+    }
     return 0;
 }
 
+int vox_ssl_openssl_context_rotate_ticket_keys(vox_ssl_context_t* ctx) {
+    if (!ctx || ctx->mode != VOX_SSL_MODE_SERVER) {
+        return -1;
+    }
+
+    vox_mutex_lock(&ctx->lock);
+    int ret = openssl_rotate_ticket_keys_locked(ctx);
+    vox_mutex_unlock(&ctx->lock);
+    return ret;
+}
+
 /* ===== Session API ===== */
 
 vox_ssl_session_t* vox_ssl_openssl_session_create(vox_ssl_context_t* ctx, vox_mpool_t* mpool) {
@@ -291,6 +922,16 @@ vox_ssl_session_t* vox_ssl_openssl_session_create(vox_ssl_context_t* ctx, vox_mp
 
     /* 将 BIO 关联到 SSL 对象 */
     SSL_set_bio(session->ssl, session->rbio, session->wbio);
+    SSL_set_app_data(session->ssl, session);
+
+    if (ctx->enable_ktls) {
+        session->ktls = (vox_ssl_ktls_track_t*)vox_mpool_alloc(mpool, sizeof(vox_ssl_ktls_track_t));
+        if (session->ktls) {
+            memset(session->ktls, 0, sizeof(vox_ssl_ktls_track_t));
+            SSL_set_msg_callback(session->ssl, openssl_ktls_msg_cb);
+            SSL_set_msg_callback_arg(session->ssl, session);
+        }
+    }
 
     /* 如果是 DTLS，设置 DTLS 特定的选项 */
     if (ctx->is_dtls) {
@@ -365,6 +1006,13 @@ void vox_ssl_openssl_session_destroy(vox_ssl_session_t* session) {
     }
 
     if (session->ssl) {
+        /* 未交换 close_notify 就释放时 OpenSSL 会把会话标记为不可恢复；
+         * 握手完成且没有发生协议错误的连接按正常关闭处理，保留会话供恢复 */
+        if (session->state == VOX_SSL_STATE_CONNECTED &&
+            session->last_error != VOX_SSL_ERROR_SSL &&
+            session->last_error != VOX_SSL_ERROR_SYSCALL) {
+            SSL_set_shutdown(session->ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+        }
         /* SSL_free 会自动释放关联的 BIO */
         SSL_free(session->ssl);
         session->ssl = NULL;
@@ -381,9 +1029,156 @@ void vox_ssl_openssl_session_destroy(vox_ssl_session_t* session) {
     }
 
     vox_mpool_t* mpool = session->mpool;
+    if (session->cache_key) {
+        vox_mpool_free(mpool, session->cache_key);
+    }
+    if (session->ktls) {
+        OPENSSL_cleanse(session->ktls, sizeof(vox_ssl_ktls_track_t));
+        vox_mpool_free(mpool, session->ktls);
+    }
     vox_mpool_free(mpool, session);
 }
 
+int vox_ssl_openssl_session_get_ktls_keys(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, vox_ssl_ktls_keys_t* keys) {
+    if (!session || !session->ssl || !keys || (dir != VOX_SSL_KTLS_TX && dir != VOX_SSL_KTLS_RX)) {
+        return -1;
+    }
+    vox_ssl_ktls_track_t* track = session->ktls;
+    if (!track || track->state[dir] != VOX_SSL_KTLS_PENDING ||
+        session->state != VOX_SSL_STATE_CONNECTED || !track->finished[dir]) {
+        return -1;
+    }
+
+    /* 切换必须发生在记录边界上：已产生的密文要先取走，已收到的记录要先由 OpenSSL 处理 */
+    if (dir == VOX_SSL_KTLS_TX) {
+        if (BIO_ctrl_pending(session->wbio) > 0) {
+            return VOX_SSL_ERROR_WANT_READ;
+        }
+    } else if (BIO_ctrl_pending(session->rbio) > 0 || SSL_has_pending(session->ssl)) {
+        return VOX_SSL_ERROR_WANT_READ;
+    }
+
+    int ret = -1;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    /* 客户端 TLS 1.3 握手后还会收到会话票据，接收方向留给 OpenSSL 处理 */
+    bool client_tls13_rx = dir == VOX_SSL_KTLS_RX && session->ctx->mode == VOX_SSL_MODE_CLIENT &&
+                           SSL_version(session->ssl) == TLS1_3_VERSION;
+    if (!track->key_updated[dir] && !client_tls13_rx) {
+        ret = openssl_ktls_derive(session, dir, keys);
+    }
+#endif
+    if (ret != 0) {
+        vox_ssl_openssl_session_set_ktls(session, dir, false);
+    }
+    return ret;
+}
+
+int vox_ssl_openssl_session_set_ktls(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, bool offloaded) {
+    if (!session || !session->ktls || (dir != VOX_SSL_KTLS_TX && dir != VOX_SSL_KTLS_RX)) {
+        return -1;
+    }
+    vox_ssl_ktls_track_t* track = session->ktls;
+    track->state[dir] = offloaded ? VOX_SSL_KTLS_OFFLOADED : VOX_SSL_KTLS_DECLINED;
+    OPENSSL_cleanse(track->secret[dir], sizeof(track->secret[dir]));
+    track->secret_len[dir] = 0;
+
+    /* 两个方向都已决定，不再需要统计记录 */
+    if (track->state[VOX_SSL_KTLS_TX] != VOX_SSL_KTLS_PENDING &&
+        track->state[VOX_SSL_KTLS_RX] != VOX_SSL_KTLS_PENDING) {
+        SSL_set_msg_callback(session->ssl, NULL);
+    }
+    return 0;
+}
+
+int vox_ssl_openssl_session_set_hostname(vox_ssl_session_t* session, const char* hostname, uint16_t port) {
+    if (!session || !session->ssl || !hostname) {
+        return -1;
+    }
+    vox_ssl_context_t* ctx = session->ctx;
+    if (ctx->mode != VOX_SSL_MODE_CLIENT) {
+        return -1;
+    }
+
+    bool is_ip = openssl_hostname_is_ip(hostname);
+    if (!is_ip && SSL_set_tlsext_host_name(session->ssl, hostname) != 1) {
+        VOX_LOG_ERROR("Failed to set SNI hostname: %s", hostname);
+        return -1;
+    }
+    if (ctx->verify_hostname) {
+        int ok = is_ip ? X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(session->ssl), hostname)
+                       : SSL_set1_host(session->ssl, hostname);
+        if (ok != 1) {
+            VOX_LOG_ERROR("Failed to set verify hostname: %s", hostname);
+            return -1;
+        }
+    }
+
+    if (!ctx->client_sessions) {
+        return 0;
+    }
+
+    /* 同一主机的不同端口可能是不同的服务，会话按 主机:端口 区分 */
+    size_t cap = strlen(hostname) + 7;
+    if (session->cache_key) {
+        vox_mpool_free(session->mpool, session->cache_key);
+        session->cache_key = NULL;
+    }
+    session->cache_key = (char*)vox_mpool_alloc(session->mpool, cap);
+    if (!session->cache_key) {
+        return -1;
+    }
+    if (port) {
+        snprintf(session->cache_key, cap, "%s:%u", hostname, (unsigned)port);
+    } else {
+        snprintf(session->cache_key, cap, "%s", hostname);
+    }
+    size_t len = strlen(session->cache_key);
+
+    /* 取出该对端保存的会话尝试恢复 */
+    SSL_SESSION* cached = NULL;
+    vox_mutex_lock(&ctx->lock);
+    if (ctx->client_cache_size > 0) {
+        cached = (SSL_SESSION*)vox_htable_get(ctx->client_sessions, session->cache_key, len);
+        if (cached) {
+            SSL_SESSION_up_ref(cached);
+        }
+    }
+    vox_mutex_unlock(&ctx->lock);
+    if (cached) {
+        if (SSL_SESSION_is_resumable(cached)) {
+            SSL_set_session(session->ssl, cached);
+        }
+        SSL_SESSION_free(cached);
+    }
+    return 0;
+}
+
+bool vox_ssl_openssl_session_is_resumed(vox_ssl_session_t* session) {
+    if (!session || !session->ssl) {
+        return false;
+    }
+    return SSL_session_reused(session->ssl) == 1;
+}
+
+int vox_ssl_openssl_session_get_alpn(vox_ssl_session_t* session, char* buf, size_t size) {
+    if (!session || !session->ssl || !buf || size == 0) {
+        return -1;
+    }
+    const unsigned char* proto = NULL;
+    unsigned int len = 0;
+    SSL_get0_alpn_selected(session->ssl, &proto, &len);
+    if (!proto || len == 0) {
+        buf[0] = '\0';
+        return 0;
+    }
+    if (len >= size) {
+        return -1;
+    }
+    memcpy(buf, proto, len);
+    buf[len] = '\0';
+    return (int)len;
+}
+
 void* vox_ssl_openssl_session_get_rbio(vox_ssl_session_t* session) {
     if (!session) {
         return NULL;
@@ -407,6 +1202,12 @@ int vox_ssl_openssl_session_handshake(vox_ssl_session_t* session) {
     
     if (ret == 1) {
         /* 握手成功 */
+        if (session->state != VOX_SSL_STATE_CONNECTED) {
+            vox_atomic_long_increment(&session->ctx->handshakes);
+            if (SSL_session_reused(session->ssl)) {
+                vox_atomic_long_increment(&session->ctx->resumed);
+            }
+        }
         session->state = VOX_SSL_STATE_CONNECTED;
         session->last_error = VOX_SSL_ERROR_NONE;
         return 0;
@@ -431,6 +1232,10 @@ ssize_t vox_ssl_openssl_session_read(vox_ssl_session_t* session, void* buf, size
     if (!session || !session->ssl || !buf || len == 0) {
         return -1;
     }
+    if (session->ktls && session->ktls->state[VOX_SSL_KTLS_RX] == VOX_SSL_KTLS_OFFLOADED) {
+        session->last_error = VOX_SSL_ERROR_INVALID_STATE;
+        return VOX_SSL_ERROR_INVALID_STATE;  /* 接收方向已由内核解密 */
+    }
 
     int ret = SSL_read(session->ssl, buf, (int)len);
 
@@ -463,6 +1268,10 @@ ssize_t vox_ssl_openssl_session_write(vox_ssl_session_t* session, const void* bu
     if (!session || !session->ssl || !buf || len == 0) {
         return -1;
     }
+    if (session->ktls && session->ktls->state[VOX_SSL_KTLS_TX] == VOX_SSL_KTLS_OFFLOADED) {
+        session->last_error = VOX_SSL_ERROR_INVALID_STATE;
+        return VOX_SSL_ERROR_INVALID_STATE;  /* 发送方向已由内核加密 */
+    }
 
     int ret = SSL_write(session->ssl, buf, (int)len);
 
@@ -669,6 +1478,17 @@ int vox_ssl_openssl_context_configure(vox_ssl_context_t* ctx, const vox_ssl_conf
     return -1;
 }
 
+int vox_ssl_openssl_context_get_stats(vox_ssl_context_t* ctx, vox_ssl_stats_t* stats) {
+    (void)ctx;
+    (void)stats;
+    return -1;
+}
+
+int vox_ssl_openssl_context_rotate_ticket_keys(vox_ssl_context_t* ctx) {
+    (void)ctx;
+    return -1;
+}
+
 vox_ssl_session_t* vox_ssl_openssl_session_create(vox_ssl_context_t* ctx, vox_mpool_t* mpool) {
     (void)ctx;
     (void)mpool;
@@ -679,6 +1499,39 @@ void vox_ssl_openssl_session_destroy(vox_ssl_session_t* session) {
     (void)session;
 }
 
+int vox_ssl_openssl_session_set_hostname(vox_ssl_session_t* session, const char* hostname, uint16_t port) {
+    (void)session;
+    (void)hostname;
+    (void)port;
+    return -1;
+}
+
+bool vox_ssl_openssl_session_is_resumed(vox_ssl_session_t* session) {
+    (void)session;
+    return false;
+}
+
+int vox_ssl_openssl_session_get_alpn(vox_ssl_session_t* session, char* buf, size_t size) {
+    (void)session;
+    (void)buf;
+    (void)size;
+    return -1;
+}
+
+int vox_ssl_openssl_session_get_ktls_keys(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, vox_ssl_ktls_keys_t* keys) {
+    (void)session;
+    (void)dir;
+    (void)keys;
+    return -1;
+}
+
+int vox_ssl_openssl_session_set_ktls(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, bool offloaded) {
+    (void)session;
+    (void)dir;
+    (void)offloaded;
+    return -1;
+}
+
 void* vox_ssl_openssl_session_get_rbio(vox_ssl_session_t* session) {
     (void)session;
     return NULL;
@@ -18,10 +18,17 @@ extern "C" {
 vox_ssl_context_t* vox_ssl_openssl_context_create(vox_mpool_t* mpool, vox_ssl_mode_t mode);
 void vox_ssl_openssl_context_destroy(vox_ssl_context_t* ctx);
 int vox_ssl_openssl_context_configure(vox_ssl_context_t* ctx, const vox_ssl_config_t* config);
+int vox_ssl_openssl_context_get_stats(vox_ssl_context_t* ctx, vox_ssl_stats_t* stats);
+int vox_ssl_openssl_context_rotate_ticket_keys(vox_ssl_context_t* ctx);
 
 /* Session API */
 vox_ssl_session_t* vox_ssl_openssl_session_create(vox_ssl_context_t* ctx, vox_mpool_t* mpool);
 void vox_ssl_openssl_session_destroy(vox_ssl_session_t* session);
+int vox_ssl_openssl_session_set_hostname(vox_ssl_session_t* session, const char* hostname, uint16_t port);
+bool vox_ssl_openssl_session_is_resumed(vox_ssl_session_t* session);
+int vox_ssl_openssl_session_get_alpn(vox_ssl_session_t* session, char* buf, size_t size);
+int vox_ssl_openssl_session_get_ktls_keys(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, vox_ssl_ktls_keys_t* keys);
+int vox_ssl_openssl_session_set_ktls(vox_ssl_session_t* session, vox_ssl_ktls_dir_t dir, bool offloaded);
 void* vox_ssl_openssl_session_get_rbio(vox_ssl_session_t* session);
 void* vox_ssl_openssl_session_get_wbio(vox_ssl_session_t* session);
 int vox_ssl_openssl_session_handshake(vox_ssl_session_t* session);
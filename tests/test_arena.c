@@ -0,0 +1,164 @@
+/* ============================================================
+ * test_arena.c - vox_arena 测试
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_arena.h"
+#include "../vox_json.h"
+#include "../vox_string.h"
+#include "../vox_vector.h"
+
+/* 测试分配对齐、原地 realloc、单独分配与 mark/rewind */
+static void test_arena_alloc_rewind(vox_mpool_t* mpool) {
+    vox_arena_config_t config = { 1024 };
+    vox_arena_t* arena = vox_arena_create_with_config(mpool, &config);
+    TEST_ASSERT_NOT_NULL(arena, "创建 arena 失败");
+
+    char* a = (char*)vox_arena_alloc(arena, 3);
+    char* b = (char*)vox_arena_alloc(arena, 5);
+    TEST_ASSERT_NOT_NULL(a, "分配失败");
+    TEST_ASSERT_EQ(((uintptr_t)b) % 8, 0, "分配应 8 字节对齐");
+    TEST_ASSERT_EQ(b - a, 8, "连续分配应相邻");
+
+    /* 最近一次分配原地扩展，非最近分配需要拷贝 */
+    memcpy(b, "abcd", 5);
+    TEST_ASSERT_EQ(vox_arena_realloc(arena, b, 5, 100), b, "最近分配应原地扩展");
+    char* a2 = (char*)vox_arena_realloc(arena, a, 3, 16);
+    TEST_ASSERT_NE(a2, a, "非最近分配应重新分配");
+
+    vox_arena_mark_t mark = vox_arena_mark(arena);
+    vox_arena_stats_t before;
+    TEST_ASSERT_EQ(vox_arena_get_stats(arena, &before), 0, "获取统计失败");
+
+    /* 超过块大小 1/4 的分配单独分配；小分配填满后进入新块 */
+    void* big = vox_arena_alloc(arena, 4000);
+    TEST_ASSERT_NOT_NULL(big, "单独分配失败");
+    for (int i = 0; i < 40; i++) {
+        TEST_ASSERT_NOT_NULL(vox_arena_alloc(arena, 200), "小分配失败");
+    }
+    vox_arena_stats_t st;
+    vox_arena_get_stats(arena, &st);
+    TEST_ASSERT_EQ(st.large_count, 1, "单独分配数量不正确");
+    TEST_ASSERT(st.chunk_count > before.chunk_count, "应分配新块");
+
+    vox_arena_rewind(arena, mark);
+    vox_arena_get_stats(arena, &st);
+    TEST_ASSERT_EQ(st.large_count, 0, "rewind 应释放单独分配");
+    TEST_ASSERT_EQ(st.used, before.used, "rewind 后已用字节数应恢复");
+    TEST_ASSERT_EQ(memcmp(b, "abcd", 5), 0, "标记之前的数据应保留");
+
+    /* reset 后复用已有块，不再新建 */
+    size_t chunks = st.chunk_count;
+    vox_arena_reset(arena);
+    for (int i = 0; i < 40; i++) {
+        vox_arena_alloc(arena, 200);
+    }
+    vox_arena_get_stats(arena, &st);
+    TEST_ASSERT_EQ(st.chunk_count, chunks, "reset 后应复用块");
+
+    char* s = vox_arena_strndup(arena, "hello world", 5);
+    TEST_ASSERT_STR_EQ(s, "hello", "strndup 结果不正确");
+
+    vox_arena_destroy(arena);
+}
+
+/* 测试标记之前的分配在标记之后 realloc：不能越过标记原地扩展，rewind 后原分配保持有效 */
+static void test_arena_realloc_across_mark(vox_mpool_t* mpool) {
+    vox_arena_config_t config = { 1024 };
+    vox_arena_t* arena = vox_arena_create_with_config(mpool, &config);
+    TEST_ASSERT_NOT_NULL(arena, "创建 arena 失败");
+
+    /* 块内分配 */
+    char* a = (char*)vox_arena_alloc(arena, 16);
+    TEST_ASSERT_NOT_NULL(a, "分配失败");
+    memset(a, 'a', 16);
+    vox_arena_mark_t mark = vox_arena_mark(arena);
+    char* a2 = (char*)vox_arena_realloc(arena, a, 16, 64);
+    TEST_ASSERT_NOT_NULL(a2, "realloc 失败");
+    TEST_ASSERT(a2 != a, "标记之前的分配不应原地扩展");
+    vox_arena_rewind(arena, mark);
+    char* c = (char*)vox_arena_alloc(arena, 64);
+    TEST_ASSERT_NOT_NULL(c, "分配失败");
+    memset(c, 'c', 64);
+    TEST_ASSERT(c >= a + 16, "rewind 后的分配不应与标记之前的分配重叠");
+    for (int i = 0; i < 16; i++) {
+        TEST_ASSERT_EQ(a[i], 'a', "标记之前的数据被覆盖");
+    }
+
+    /* 单独分配 */
+    vox_arena_reset(arena);
+    char* big = (char*)vox_arena_alloc(arena, 4000);
+    TEST_ASSERT_NOT_NULL(big, "单独分配失败");
+    memset(big, 'b', 4000);
+    mark = vox_arena_mark(arena);
+    char* big2 = (char*)vox_arena_realloc(arena, big, 4000, 8000);
+    TEST_ASSERT_NOT_NULL(big2, "realloc 失败");
+    TEST_ASSERT(big2 != big, "标记之前的单独分配不应被移动");
+    vox_arena_rewind(arena, mark);
+    vox_arena_stats_t st;
+    vox_arena_get_stats(arena, &st);
+    TEST_ASSERT_EQ(st.large_count, 1, "rewind 不应释放标记之前的单独分配");
+    TEST_ASSERT_EQ(big[0], 'b', "标记之前的单独分配应保持有效");
+    TEST_ASSERT_EQ(big[3999], 'b', "标记之前的单独分配应保持有效");
+
+    vox_arena_destroy(arena);
+}
+
+/* 测试内存池适配器：现有接受 vox_mpool_t 的模块可直接运行在 arena 上 */
+static void test_arena_mpool_adapter(vox_mpool_t* mpool) {
+    vox_arena_t* arena = vox_arena_create(mpool);
+    TEST_ASSERT_NOT_NULL(arena, "创建 arena 失败");
+    vox_mpool_t* ap = vox_arena_get_mpool(arena);
+    TEST_ASSERT_NOT_NULL(ap, "获取适配器失败");
+    TEST_ASSERT_EQ(vox_arena_get_mpool(arena), ap, "适配器应只创建一次");
+
+    void* p = vox_mpool_alloc(ap, 37);
+    TEST_ASSERT_EQ(vox_mpool_get_size(ap, p), 37, "get_size 不正确");
+    p = vox_mpool_realloc(ap, p, 500);
+    TEST_ASSERT_EQ(vox_mpool_get_size(ap, p), 500, "realloc 后 get_size 不正确");
+    vox_mpool_free(ap, p);
+
+    for (int round = 0; round < 3; round++) {
+        vox_json_err_info_t err;
+        vox_json_elem_t* root = vox_json_parse_str(ap, "{\"a\":[1,2,3],\"b\":{\"c\":\"x\"}}", &err);
+        TEST_ASSERT_NOT_NULL(root, "JSON 解析失败");
+        vox_json_elem_t* arr = vox_json_get_object_value(root, "a");
+        TEST_ASSERT_EQ(vox_json_get_array_count(arr), 3, "数组元素数量不正确");
+
+        vox_string_t* str = vox_string_create(ap);
+        for (int i = 0; i < 1000; i++) {
+            TEST_ASSERT_EQ(vox_string_append(str, "0123456789"), 0, "字符串追加失败");
+        }
+        TEST_ASSERT_EQ(vox_string_length(str), 10000, "字符串长度不正确");
+        vox_string_destroy(str);
+
+        vox_vector_t* vec = vox_vector_create(ap);
+        for (intptr_t i = 1; i <= 100; i++) {
+            TEST_ASSERT_EQ(vox_vector_push(vec, (void*)i), 0, "数组追加失败");
+        }
+        TEST_ASSERT_EQ((intptr_t)vox_vector_get(vec, 99), 100, "数组元素不正确");
+        vox_vector_destroy(vec);
+
+        /* 请求结束：一次性回收 */
+        vox_mpool_reset(ap);
+        vox_arena_stats_t st;
+        vox_arena_get_stats(arena, &st);
+        TEST_ASSERT_EQ(st.used, 0, "reset 后已用字节数应为 0");
+    }
+
+    vox_mpool_destroy(ap);  /* 空操作 */
+    vox_arena_destroy(arena);
+}
+
+/* 测试套件 */
+test_case_t test_arena_cases[] = {
+    {"alloc_rewind", test_arena_alloc_rewind},
+    {"realloc_across_mark", test_arena_realloc_across_mark},
+    {"mpool_adapter", test_arena_mpool_adapter},
+};
+
+test_suite_t test_arena_suite = {
+    "vox_arena",
+    test_arena_cases,
+    sizeof(test_arena_cases) / sizeof(test_arena_cases[0])
+};
@@ -118,6 +118,34 @@ static void test_atomic_ptr(vox_mpool_t* mpool) {
     vox_atomic_ptr_destroy(atomic);
 }
 
+/* 测试嵌入式原子变量与缓存行填充 */
+static void test_atomic_embedded(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    struct {
+        vox_atomic_long_padded_t a;
+        vox_atomic_long_padded_t b;
+        vox_atomic_ptr_t p;
+    } s;
+    vox_atomic_long_init(&s.a.value, 7);
+    vox_atomic_long_init(&s.b.value, -1);
+    vox_atomic_ptr_init(&s.p, NULL);
+
+    TEST_ASSERT_EQ(sizeof(vox_atomic_long_padded_t), VOX_CACHE_LINE_SIZE, "填充后大小应为一个缓存行");
+    TEST_ASSERT_EQ(sizeof(vox_atomic_long_t), sizeof(int64_t), "嵌入的原子长整数不应有额外字段");
+    TEST_ASSERT_EQ(vox_atomic_long_increment(&s.a.value), 8, "递增失败");
+    TEST_ASSERT_EQ(vox_atomic_long_add(&s.b.value, 2), -1, "add返回的旧值不正确");
+    TEST_ASSERT_EQ(vox_atomic_long_load(&s.b.value), 1, "add后的值不正确");
+
+    int64_t expected = 8;
+    TEST_ASSERT(vox_atomic_long_compare_exchange(&s.a.value, &expected, 20), "CAS应成功");
+    TEST_ASSERT_EQ(vox_atomic_long_load_acquire(&s.a.value), 20, "CAS后的值不正确");
+
+    int x = 0;
+    void* exp = NULL;
+    TEST_ASSERT(vox_atomic_ptr_compare_exchange(&s.p, &exp, &x), "指针CAS应成功");
+    TEST_ASSERT_EQ(vox_atomic_ptr_load(&s.p), &x, "指针值不正确");
+}
+
 /* 测试套件 */
 test_case_t test_atomic_cases[] = {
     {"int_create_destroy", test_atomic_int_create_destroy},
@@ -127,6 +155,7 @@ test_case_t test_atomic_cases[] = {
     {"int_exchange", test_atomic_int_exchange},
     {"int_compare_exchange", test_atomic_int_compare_exchange},
     {"ptr", test_atomic_ptr},
+    {"embedded", test_atomic_embedded},
 };
 
 test_suite_t test_atomic_suite = {
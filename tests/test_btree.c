@@ -0,0 +1,291 @@
+/* ============================================================
+ * test_btree.c - vox_btree 测试
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_os.h"
+#include "../vox_btree.h"
+#include <stdio.h>
+
+/* 8 字节大端键：memcmp 顺序与数值顺序一致 */
+static void make_key(uint64_t v, uint8_t out[8]) {
+    for (int i = 7; i >= 0; i--) {
+        out[i] = (uint8_t)(v & 0xFF);
+        v >>= 8;
+    }
+}
+
+static uint64_t read_key(const void* key) {
+    const uint8_t* p = (const uint8_t*)key;
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+typedef struct {
+    uint64_t last;
+    size_t count;
+    int ordered;
+} order_ctx_t;
+
+static void check_order(const void* key, size_t key_len, void* value, void* user_data) {
+    order_ctx_t* ctx = (order_ctx_t*)user_data;
+    uint64_t v = read_key(key);
+    if (key_len != 8 || (ctx->count > 0 && v <= ctx->last) || (uint64_t)(uintptr_t)value != v + 1) {
+        ctx->ordered = 0;
+    }
+    ctx->last = v;
+    ctx->count++;
+}
+
+/* 测试基本操作与长度优先的比较模型 */
+static void test_btree_basic(vox_mpool_t* mpool) {
+    vox_btree_t* tree = vox_btree_create(mpool);
+    TEST_ASSERT_NOT_NULL(tree, "创建 B+ 树失败");
+    int a = 1, b = 2, c = 3;
+
+    TEST_ASSERT_EQ(vox_btree_insert(tree, "aa", 2, &a), 0, "插入失败");
+    TEST_ASSERT_EQ(vox_btree_insert(tree, "b", 1, &b), 0, "插入失败");
+    const char* long_key = "a-key-longer-than-sixteen-bytes";
+    TEST_ASSERT_EQ(vox_btree_insert(tree, long_key, strlen(long_key), &c), 0, "长键插入失败");
+    TEST_ASSERT_NE(vox_btree_insert(tree, "x", 0, &a), 0, "空键应失败");
+    TEST_ASSERT_EQ(vox_btree_size(tree), 3, "数量不正确");
+    TEST_ASSERT_EQ(vox_btree_find(tree, "aa", 2), &a, "查找失败");
+    TEST_ASSERT_EQ(vox_btree_find(tree, long_key, strlen(long_key)), &c, "长键查找失败");
+    TEST_ASSERT_NULL(vox_btree_find(tree, "a", 1), "不存在的键应返回 NULL");
+
+    /* 短键排在长键之前 */
+    const void* key = NULL;
+    size_t len = 0;
+    TEST_ASSERT_EQ(vox_btree_min(tree, &key, &len), 0, "获取最小键失败");
+    TEST_ASSERT(len == 1 && memcmp(key, "b", 1) == 0, "最小键应为 b");
+    TEST_ASSERT_EQ(vox_btree_max(tree, &key, &len), 0, "获取最大键失败");
+    TEST_ASSERT_EQ(len, strlen(long_key), "最大键应为长键");
+
+    TEST_ASSERT_EQ(vox_btree_insert(tree, "aa", 2, &b), 0, "更新失败");
+    TEST_ASSERT_EQ(vox_btree_find(tree, "aa", 2), &b, "更新后值不正确");
+    TEST_ASSERT_EQ(vox_btree_size(tree), 3, "更新不应改变数量");
+    TEST_ASSERT_EQ(vox_btree_delete(tree, "aa", 2), 0, "删除失败");
+    TEST_ASSERT_NE(vox_btree_delete(tree, "aa", 2), 0, "重复删除应失败");
+    TEST_ASSERT(!vox_btree_contains(tree, "aa", 2), "删除后不应存在");
+
+    /* 长键（单独分配）经过分裂与合并 */
+    char buf[64];
+    for (int i = 0; i < 2000; i++) {
+        int n = snprintf(buf, sizeof(buf), "long-key-prefix-padding-%06d", i);
+        TEST_ASSERT_EQ(vox_btree_insert(tree, buf, (size_t)n, &a), 0, "长键插入失败");
+    }
+    for (int i = 0; i < 2000; i += 2) {
+        int n = snprintf(buf, sizeof(buf), "long-key-prefix-padding-%06d", i);
+        TEST_ASSERT_EQ(vox_btree_delete(tree, buf, (size_t)n), 0, "长键删除失败");
+    }
+    int n = snprintf(buf, sizeof(buf), "long-key-prefix-padding-%06d", 1001);
+    TEST_ASSERT_EQ(vox_btree_find(tree, buf, (size_t)n), &a, "长键查找失败");
+    TEST_ASSERT_EQ(vox_btree_size(tree), 1002, "数量不正确");
+
+    vox_btree_clear(tree);
+    TEST_ASSERT(vox_btree_empty(tree), "清空后应为空");
+    TEST_ASSERT_NE(vox_btree_min(tree, &key, &len), 0, "空树没有最小键");
+    vox_btree_destroy(tree);
+}
+
+/* 测试随机插入删除：与参照数组对比，并检查节点分裂/合并后的顺序 */
+static void test_btree_random(vox_mpool_t* mpool) {
+    vox_btree_t* tree = vox_btree_create(mpool);
+    TEST_ASSERT_NOT_NULL(tree, "创建 B+ 树失败");
+
+    enum { N = 4096 };
+    static char present[N];
+    memset(present, 0, sizeof(present));
+    size_t expected = 0;
+    uint32_t seed = 12345;
+    uint8_t key[8];
+
+    for (int op = 0; op < 60000; op++) {
+        seed = seed * 1103515245u + 12345u;
+        uint64_t v = (seed >> 8) % N;
+        make_key(v, key);
+        /* 前半段偏向插入，后半段偏向删除，覆盖分裂与合并 */
+        int insert = ((seed >> 4) % 100) < (op < 30000 ? 70 : 30);
+        if (insert) {
+            TEST_ASSERT_EQ(vox_btree_insert(tree, key, 8, (void*)(uintptr_t)(v + 1)), 0, "插入失败");
+            if (!present[v]) expected++;
+            present[v] = 1;
+        } else {
+            int rc = vox_btree_delete(tree, key, 8);
+            TEST_ASSERT_EQ(rc == 0, present[v] == 1, "删除结果与参照不一致");
+            if (present[v]) expected--;
+            present[v] = 0;
+        }
+        if (op % 5000 == 4999) {
+            order_ctx_t ctx = {0, 0, 1};
+            vox_btree_foreach(tree, check_order, &ctx);
+            TEST_ASSERT(ctx.ordered, "遍历顺序不正确");
+            TEST_ASSERT_EQ(ctx.count, expected, "遍历数量不正确");
+        }
+    }
+    TEST_ASSERT_EQ(vox_btree_size(tree), expected, "数量不正确");
+    for (uint64_t v = 0; v < N; v++) {
+        make_key(v, key);
+        void* got = vox_btree_find(tree, key, 8);
+        TEST_ASSERT_EQ(got != NULL, present[v] == 1, "查找结果与参照不一致");
+    }
+
+    /* 全部删除后树应回到空 */
+    for (uint64_t v = 0; v < N; v++) {
+        make_key(v, key);
+        vox_btree_delete(tree, key, 8);
+    }
+    size_t height = 1, nodes = 1;
+    vox_btree_stats(tree, &height, &nodes);
+    TEST_ASSERT(vox_btree_empty(tree), "应为空");
+    TEST_ASSERT_EQ(height, 0, "空树高度应为0");
+    TEST_ASSERT_EQ(nodes, 0, "空树不应有节点");
+    vox_btree_destroy(tree);
+}
+
+/* 测试 lower_bound/upper_bound 与双向迭代 */
+static void test_btree_iter(vox_mpool_t* mpool) {
+    vox_btree_t* tree = vox_btree_create(mpool);
+    TEST_ASSERT_NOT_NULL(tree, "创建 B+ 树失败");
+    uint8_t key[8];
+    for (uint64_t v = 0; v < 1000; v++) {
+        make_key(v * 10, key);
+        TEST_ASSERT_EQ(vox_btree_insert(tree, key, 8, (void*)(uintptr_t)(v * 10 + 1)), 0, "插入失败");
+    }
+
+    make_key(105, key);
+    vox_btree_iter_t it = vox_btree_lower_bound(tree, key, 8);
+    TEST_ASSERT(vox_btree_iter_valid(&it), "lower_bound 应有效");
+    TEST_ASSERT_EQ(read_key(vox_btree_iter_key(&it, NULL)), 110, "lower_bound 位置不正确");
+    make_key(110, key);
+    it = vox_btree_lower_bound(tree, key, 8);
+    TEST_ASSERT_EQ(read_key(vox_btree_iter_key(&it, NULL)), 110, "lower_bound 应包含等值");
+    it = vox_btree_upper_bound(tree, key, 8);
+    TEST_ASSERT_EQ(read_key(vox_btree_iter_key(&it, NULL)), 120, "upper_bound 应跳过等值");
+    vox_btree_iter_prev(&it);
+    vox_btree_iter_prev(&it);
+    TEST_ASSERT_EQ(read_key(vox_btree_iter_key(&it, NULL)), 100, "prev 不正确");
+    TEST_ASSERT_EQ((uintptr_t)vox_btree_iter_value(&it), 101, "值不正确");
+
+    make_key(99990, key);
+    it = vox_btree_lower_bound(tree, key, 8);
+    TEST_ASSERT(!vox_btree_iter_valid(&it), "超过最大键应无效");
+
+    /* 反向遍历全部 */
+    size_t n = 0;
+    uint64_t last = UINT64_MAX;
+    int ordered = 1;
+    for (it = vox_btree_last(tree); vox_btree_iter_valid(&it); vox_btree_iter_prev(&it)) {
+        uint64_t v = read_key(vox_btree_iter_key(&it, NULL));
+        if (v >= last) ordered = 0;
+        last = v;
+        n++;
+    }
+    TEST_ASSERT(ordered, "反向遍历顺序不正确");
+    TEST_ASSERT_EQ(n, 1000, "反向遍历数量不正确");
+
+    vox_btree_destroy(tree);
+}
+
+static void count_visit(const void* key, size_t key_len, void* value, void* user_data) {
+    VOX_UNUSED(key);
+    VOX_UNUSED(key_len);
+    VOX_UNUSED(value);
+    (*(size_t*)user_data)++;
+}
+
+/* 测试区间遍历边界 */
+static void test_btree_range(vox_mpool_t* mpool) {
+    vox_btree_t* tree = vox_btree_create(mpool);
+    TEST_ASSERT_NOT_NULL(tree, "创建 B+ 树失败");
+    uint8_t key[8], lo[8], hi[8];
+    for (uint64_t v = 0; v < 1000; v++) {
+        make_key(v * 10, key);
+        vox_btree_insert(tree, key, 8, (void*)(uintptr_t)(v * 10 + 1));
+    }
+    size_t n = 0;
+    make_key(2000, lo);
+    make_key(3000, hi);
+    TEST_ASSERT_EQ(vox_btree_range(tree, lo, 8, hi, 8, count_visit, &n), 100, "区间数量不正确");
+    TEST_ASSERT_EQ(n, 100, "回调次数不正确");
+    n = 0;
+    TEST_ASSERT_EQ(vox_btree_range(tree, NULL, 0, hi, 8, count_visit, &n), 300, "无下界区间不正确");
+    n = 0;
+    TEST_ASSERT_EQ(vox_btree_range(tree, lo, 8, NULL, 0, count_visit, &n), 800, "无上界区间不正确");
+    n = 0;
+    TEST_ASSERT_EQ(vox_btree_range(tree, hi, 8, lo, 8, count_visit, &n), 0, "空区间应不遍历");
+    vox_btree_destroy(tree);
+}
+
+/* 测试从有序输入批量构建 */
+static void test_btree_bulk_load(vox_mpool_t* mpool) {
+    enum { N = 10000 };
+    static uint8_t keys[N][8];
+    vox_btree_item_t* items = (vox_btree_item_t*)vox_mpool_alloc(mpool, N * sizeof(vox_btree_item_t));
+    TEST_ASSERT_NOT_NULL(items, "分配输入失败");
+    for (size_t i = 0; i < N; i++) {
+        make_key(i * 2, keys[i]);
+        items[i].key = keys[i];
+        items[i].key_len = 8;
+        items[i].value = (void*)(uintptr_t)(i * 2 + 1);
+    }
+
+    vox_btree_t* tree = vox_btree_create(mpool);
+    TEST_ASSERT_NOT_NULL(tree, "创建 B+ 树失败");
+    TEST_ASSERT_EQ(vox_btree_bulk_load(tree, items, N), 0, "批量构建失败");
+    TEST_ASSERT_EQ(vox_btree_size(tree), N, "数量不正确");
+    TEST_ASSERT_NE(vox_btree_bulk_load(tree, items, N), 0, "非空树批量构建应失败");
+    size_t height = 0;
+    vox_btree_stats(tree, &height, NULL);
+    TEST_ASSERT(height >= 2 && height <= 4, "树高不合理");
+
+    order_ctx_t ctx = {0, 0, 1};
+    vox_btree_foreach(tree, check_order, &ctx);
+    TEST_ASSERT(ctx.ordered && ctx.count == N, "批量构建后顺序不正确");
+
+    /* 构建后的树可以继续插入和删除（奇数键落在已满的叶子之间） */
+    uint8_t key[8];
+    for (uint64_t v = 1; v < 2 * N; v += 2) {
+        make_key(v, key);
+        TEST_ASSERT_EQ(vox_btree_insert(tree, key, 8, (void*)(uintptr_t)(v + 1)), 0, "插入失败");
+    }
+    for (uint64_t v = 0; v < 2 * N; v += 3) {
+        make_key(v, key);
+        TEST_ASSERT_EQ(vox_btree_delete(tree, key, 8), 0, "删除失败");
+    }
+    ctx.count = 0;
+    ctx.ordered = 1;
+    vox_btree_foreach(tree, check_order, &ctx);
+    TEST_ASSERT(ctx.ordered, "修改后顺序不正确");
+    TEST_ASSERT_EQ(ctx.count, vox_btree_size(tree), "修改后数量不正确");
+    vox_btree_destroy(tree);
+
+    /* 未排序的输入被拒绝，树保持为空 */
+    tree = vox_btree_create(mpool);
+    TEST_ASSERT_NOT_NULL(tree, "创建 B+ 树失败");
+    vox_btree_item_t tmp = items[5];
+    items[5] = items[6];
+    items[6] = tmp;
+    TEST_ASSERT_NE(vox_btree_bulk_load(tree, items, N), 0, "未排序输入应失败");
+    TEST_ASSERT(vox_btree_empty(tree), "失败后应为空");
+    TEST_ASSERT_EQ(vox_btree_bulk_load(tree, items, 5), 0, "前5项有序，应成功");
+    TEST_ASSERT_EQ(vox_btree_size(tree), 5, "数量不正确");
+    vox_btree_destroy(tree);
+    vox_mpool_free(mpool, items);
+}
+
+/* 测试套件 */
+test_case_t test_btree_cases[] = {
+    {"basic", test_btree_basic},
+    {"random", test_btree_random},
+    {"iter", test_btree_iter},
+    {"range", test_btree_range},
+    {"bulk_load", test_btree_bulk_load},
+};
+
+test_suite_t test_btree_suite = {
+    "vox_btree",
+    test_btree_cases,
+    sizeof(test_btree_cases) / sizeof(test_btree_cases[0])
+};
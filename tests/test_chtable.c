@@ -0,0 +1,242 @@
+/* ============================================================
+ * test_chtable.c - vox_chtable 并发哈希表测试
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_os.h"
+#include "../vox_chtable.h"
+#include "../vox_thread.h"
+#include "../vox_atomic.h"
+#include <stdio.h>
+
+#define CHT_STABLE_KEYS 512
+#define CHT_WRITERS 4
+#define CHT_READERS 4
+#define CHT_WRITER_OPS 20000
+
+/* 测试基本的插入、更新、查找、删除与遍历 */
+static void test_chtable_basic(vox_mpool_t* mpool) {
+    vox_chtable_t* t = vox_chtable_create(mpool);
+    TEST_ASSERT_NOT_NULL(t, "创建并发哈希表失败");
+    int a = 1, b = 2, c = 3;
+
+    TEST_ASSERT_EQ(vox_chtable_set(t, "alpha", 5, &a), 0, "插入失败");
+    TEST_ASSERT_EQ(vox_chtable_set(t, "beta", 4, &b), 0, "插入失败");
+    TEST_ASSERT_EQ(vox_chtable_set(t, "", 0, &c), 0, "空键插入失败");
+    TEST_ASSERT_EQ(vox_chtable_size(t), 3, "数量不正确");
+    TEST_ASSERT_EQ(vox_chtable_get(t, "alpha", 5), &a, "查找失败");
+    TEST_ASSERT_EQ(vox_chtable_get(t, "", 0), &c, "空键查找失败");
+    TEST_ASSERT_NULL(vox_chtable_get(t, "alph", 4), "不存在的键应返回 NULL");
+
+    TEST_ASSERT_EQ(vox_chtable_set(t, "alpha", 5, &c), 0, "更新失败");
+    TEST_ASSERT_EQ(vox_chtable_get(t, "alpha", 5), &c, "更新后值不正确");
+    TEST_ASSERT_EQ(vox_chtable_size(t), 3, "更新不应改变数量");
+
+    TEST_ASSERT_EQ(vox_chtable_delete(t, "beta", 4), 0, "删除失败");
+    TEST_ASSERT_NE(vox_chtable_delete(t, "beta", 4), 0, "重复删除应失败");
+    TEST_ASSERT(!vox_chtable_contains(t, "beta", 4), "删除后不应存在");
+    TEST_ASSERT(vox_chtable_contains(t, "alpha", 5), "alpha 应存在");
+    TEST_ASSERT_EQ(vox_chtable_foreach(t, NULL, NULL), 0, "空回调应返回0");
+    TEST_ASSERT_EQ(vox_chtable_size(t), 2, "数量不正确");
+
+    vox_chtable_clear(t);
+    TEST_ASSERT_EQ(vox_chtable_size(t), 0, "清空后数量应为0");
+    TEST_ASSERT_NULL(vox_chtable_get(t, "alpha", 5), "清空后不应找到");
+    vox_chtable_destroy(t);
+}
+
+/* 测试扩容与墓碑复用 */
+static void test_chtable_grow(vox_mpool_t* mpool) {
+    vox_chtable_config_t config = {0};
+    config.initial_capacity = 8;
+    vox_chtable_t* t = vox_chtable_create_with_config(mpool, &config);
+    TEST_ASSERT_NOT_NULL(t, "创建并发哈希表失败");
+
+    char key[32];
+    for (intptr_t i = 0; i < 10000; i++) {
+        int n = snprintf(key, sizeof(key), "key-%ld", (long)i);
+        TEST_ASSERT_EQ(vox_chtable_set(t, key, (size_t)n, (void*)(i + 1)), 0, "插入失败");
+    }
+    TEST_ASSERT_EQ(vox_chtable_size(t), 10000, "数量不正确");
+    size_t capacity = 0;
+    vox_chtable_stats(t, &capacity, NULL, NULL);
+    TEST_ASSERT(capacity >= 10000 && (capacity & (capacity - 1)) == 0, "容量应为不小于元素数的2的幂");
+
+    for (intptr_t i = 0; i < 10000; i += 2) {
+        int n = snprintf(key, sizeof(key), "key-%ld", (long)i);
+        TEST_ASSERT_EQ(vox_chtable_delete(t, key, (size_t)n), 0, "删除失败");
+    }
+    /* 反复插入删除：墓碑被复用或在扩容时清理，容量不应无限增长 */
+    for (int round = 0; round < 20; round++) {
+        for (intptr_t i = 0; i < 1000; i++) {
+            int n = snprintf(key, sizeof(key), "tmp-%ld", (long)i);
+            vox_chtable_set(t, key, (size_t)n, (void*)i);
+        }
+        for (intptr_t i = 0; i < 1000; i++) {
+            int n = snprintf(key, sizeof(key), "tmp-%ld", (long)i);
+            vox_chtable_delete(t, key, (size_t)n);
+        }
+    }
+    size_t capacity2 = 0;
+    vox_chtable_stats(t, &capacity2, NULL, NULL);
+    TEST_ASSERT(capacity2 <= capacity, "墓碑不应导致持续扩容");
+
+    for (intptr_t i = 0; i < 10000; i++) {
+        int n = snprintf(key, sizeof(key), "key-%ld", (long)i);
+        void* v = vox_chtable_get(t, key, (size_t)n);
+        if (i % 2 == 0) {
+            TEST_ASSERT_NULL(v, "已删除的键不应存在");
+        } else {
+            TEST_ASSERT_EQ(v, (void*)(i + 1), "值不正确");
+        }
+    }
+    TEST_ASSERT_EQ(vox_chtable_size(t), 5000, "数量不正确");
+    vox_chtable_destroy(t);
+}
+
+static vox_atomic_int_t g_cht_freed;
+
+static void count_free(void* value) {
+    VOX_UNUSED(value);
+    vox_atomic_int_increment(&g_cht_freed);
+}
+
+/* 测试值释放推迟到读者离开临界区之后 */
+static void test_chtable_deferred_free(vox_mpool_t* mpool) {
+    vox_atomic_int_init(&g_cht_freed, 0);
+    vox_chtable_config_t config = {0};
+    config.value_free = count_free;
+    vox_chtable_t* t = vox_chtable_create_with_config(mpool, &config);
+    TEST_ASSERT_NOT_NULL(t, "创建并发哈希表失败");
+    int a = 1, b = 2;
+
+    TEST_ASSERT_EQ(vox_chtable_set(t, "k", 1, &a), 0, "插入失败");
+    vox_chtable_guard_t guard;
+    vox_chtable_pin(t, &guard);
+    void* held = vox_chtable_get(t, "k", 1);
+    TEST_ASSERT_EQ(held, &a, "查找失败");
+    TEST_ASSERT_EQ(vox_chtable_delete(t, "k", 1), 0, "删除失败");
+    vox_chtable_reclaim(t);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&g_cht_freed), 0, "读者仍在临界区内，不应释放");
+    vox_chtable_unpin(t, &guard);
+    vox_chtable_reclaim(t);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&g_cht_freed), 1, "离开临界区后应释放");
+
+    /* 以相同的值更新不释放，以不同的值更新释放旧值 */
+    TEST_ASSERT_EQ(vox_chtable_set(t, "k", 1, &a), 0, "插入失败");
+    TEST_ASSERT_EQ(vox_chtable_set(t, "k", 1, &a), 0, "更新失败");
+    vox_chtable_reclaim(t);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&g_cht_freed), 1, "相同的值不应释放");
+    TEST_ASSERT_EQ(vox_chtable_set(t, "k", 1, &b), 0, "更新失败");
+    vox_chtable_reclaim(t);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&g_cht_freed), 2, "旧值应释放");
+    size_t pending = 1;
+    vox_chtable_stats(t, NULL, NULL, &pending);
+    TEST_ASSERT_EQ(pending, 0, "不应有待回收对象");
+
+    vox_chtable_destroy(t);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&g_cht_freed), 3, "销毁时应释放剩余的值");
+}
+
+typedef struct {
+    vox_chtable_t* table;
+    vox_atomic_int_t* stop;
+    int id;
+    int errors;
+} cht_thread_ctx_t;
+
+/* 读者：稳定键始终存在且值与键对应 */
+static int cht_reader(void* user_data) {
+    cht_thread_ctx_t* ctx = (cht_thread_ctx_t*)user_data;
+    char key[32];
+    unsigned i = (unsigned)ctx->id;
+    while (!vox_atomic_int_load(ctx->stop)) {
+        intptr_t k = (intptr_t)(i++ % CHT_STABLE_KEYS);
+        int n = snprintf(key, sizeof(key), "stable-%ld", (long)k);
+        if (vox_chtable_get(ctx->table, key, (size_t)n) != (void*)(k + 1)) {
+            ctx->errors++;
+        }
+    }
+    return 0;
+}
+
+/* 写者：在自己的键空间内插入、更新、删除，并更新部分稳定键（值不变） */
+static int cht_writer(void* user_data) {
+    cht_thread_ctx_t* ctx = (cht_thread_ctx_t*)user_data;
+    char key[32];
+    for (intptr_t i = 0; i < CHT_WRITER_OPS; i++) {
+        int n = snprintf(key, sizeof(key), "w%d-%ld", ctx->id, (long)(i % 1000));
+        if (vox_chtable_set(ctx->table, key, (size_t)n, (void*)(i + 1)) != 0) ctx->errors++;
+        if (i % 3 == 0) vox_chtable_delete(ctx->table, key, (size_t)n);
+        if (i % 16 == 0) {
+            intptr_t k = i % CHT_STABLE_KEYS;
+            n = snprintf(key, sizeof(key), "stable-%ld", (long)k);
+            if (vox_chtable_set(ctx->table, key, (size_t)n, (void*)(k + 1)) != 0) ctx->errors++;
+        }
+    }
+    /* 最后一轮：保留的键为 w<id>-0..999 中的每一个 */
+    for (intptr_t i = 0; i < 1000; i++) {
+        int n = snprintf(key, sizeof(key), "w%d-%ld", ctx->id, (long)i);
+        if (vox_chtable_set(ctx->table, key, (size_t)n, (void*)(i + 1)) != 0) ctx->errors++;
+    }
+    return 0;
+}
+
+/* 测试多线程并发读写（包括扩容期间的读取） */
+static void test_chtable_concurrent(vox_mpool_t* mpool) {
+    vox_chtable_config_t config = {0};
+    config.initial_capacity = 16;
+    vox_chtable_t* t = vox_chtable_create_with_config(mpool, &config);
+    TEST_ASSERT_NOT_NULL(t, "创建并发哈希表失败");
+    char key[32];
+    for (intptr_t k = 0; k < CHT_STABLE_KEYS; k++) {
+        int n = snprintf(key, sizeof(key), "stable-%ld", (long)k);
+        TEST_ASSERT_EQ(vox_chtable_set(t, key, (size_t)n, (void*)(k + 1)), 0, "插入失败");
+    }
+
+    vox_atomic_int_t stop;
+    vox_atomic_int_init(&stop, 0);
+    cht_thread_ctx_t ctx[CHT_WRITERS + CHT_READERS];
+    vox_thread_t* threads[CHT_WRITERS + CHT_READERS];
+    for (int i = 0; i < CHT_WRITERS + CHT_READERS; i++) {
+        ctx[i].table = t;
+        ctx[i].stop = &stop;
+        ctx[i].id = i;
+        ctx[i].errors = 0;
+        threads[i] = vox_thread_create(mpool, i < CHT_WRITERS ? cht_writer : cht_reader, &ctx[i]);
+        TEST_ASSERT_NOT_NULL(threads[i], "创建线程失败");
+    }
+    for (int i = 0; i < CHT_WRITERS; i++) {
+        vox_thread_join(threads[i], NULL);
+    }
+    vox_atomic_int_store(&stop, 1);
+    for (int i = CHT_WRITERS; i < CHT_WRITERS + CHT_READERS; i++) {
+        vox_thread_join(threads[i], NULL);
+    }
+    for (int i = 0; i < CHT_WRITERS + CHT_READERS; i++) {
+        TEST_ASSERT_EQ(ctx[i].errors, 0, "并发读写出现错误");
+    }
+
+    TEST_ASSERT_EQ(vox_chtable_size(t), CHT_STABLE_KEYS + CHT_WRITERS * 1000, "最终数量不正确");
+    for (int w = 0; w < CHT_WRITERS; w++) {
+        for (intptr_t i = 0; i < 1000; i += 97) {
+            int n = snprintf(key, sizeof(key), "w%d-%ld", w, (long)i);
+            TEST_ASSERT_EQ(vox_chtable_get(t, key, (size_t)n), (void*)(i + 1), "最终值不正确");
+        }
+    }
+    vox_chtable_destroy(t);
+}
+
+/* 测试套件 */
+test_case_t test_chtable_cases[] = {
+    {"basic", test_chtable_basic},
+    {"grow", test_chtable_grow},
+    {"deferred_free", test_chtable_deferred_free},
+    {"concurrent", test_chtable_concurrent},
+};
+
+test_suite_t test_chtable_suite = {
+    "vox_chtable",
+    test_chtable_cases,
+    sizeof(test_chtable_cases) / sizeof(test_chtable_cases[0])
+};
@@ -93,6 +93,142 @@ static void test_crypto_crc32(vox_mpool_t* mpool) {
     crc3 = vox_crc32_final(crc3);
     
     TEST_ASSERT_EQ(crc1, crc3, "流式CRC32结果不正确");
+    
+    /* 标准校验值 */
+    TEST_ASSERT_EQ(vox_crc32("123456789", 9), 0xCBF43926u, "CRC32校验值不正确");
+}
+
+/* 测试CRC32C */
+static void test_crypto_crc32c(vox_mpool_t* mpool) {
+    (void)mpool;  /* 未使用的参数 */
+    TEST_ASSERT_EQ(vox_crc32c("123456789", 9), 0xE3069283u, "CRC32C校验值不正确");
+    TEST_ASSERT_EQ(vox_crc32c("", 0), 0u, "空输入CRC32C应为0");
+    
+    /* 流式处理（跨越对齐边界） */
+    uint8_t buf[300];
+    for (int i = 0; i < 300; i++) buf[i] = (uint8_t)(i * 7 + 3);
+    uint32_t crc = vox_crc32c_init();
+    crc = vox_crc32c_update(crc, buf, 5);
+    crc = vox_crc32c_update(crc, buf + 5, 200);
+    crc = vox_crc32c_update(crc, buf + 205, 95);
+    crc = vox_crc32c_final(crc);
+    TEST_ASSERT_EQ(crc, vox_crc32c(buf, sizeof(buf)), "流式CRC32C结果不正确");
+}
+
+/* 测试SHA1/SHA256 标准向量 */
+static void test_crypto_sha_vectors(vox_mpool_t* mpool) {
+    (void)mpool;  /* 未使用的参数 */
+    const char* msg448 = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    uint8_t digest[VOX_SHA256_DIGEST_SIZE];
+    char hex_str[65];
+    
+    vox_sha1("abc", 3, digest);
+    vox_sha1_hex(digest, hex_str);
+    TEST_ASSERT_STR_EQ(hex_str, "a9993e364706816aba3e25717850c26c9cd0d89d", "SHA1(abc)不正确");
+    vox_sha1(msg448, strlen(msg448), digest);
+    vox_sha1_hex(digest, hex_str);
+    TEST_ASSERT_STR_EQ(hex_str, "84983e441c3bd26ebaae4aa1f95129e5e54670f1", "SHA1(448位)不正确");
+    
+    vox_sha256("", 0, digest);
+    vox_sha256_hex(digest, hex_str);
+    TEST_ASSERT_STR_EQ(hex_str, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+                       "SHA256(空)不正确");
+    vox_sha256(msg448, strlen(msg448), digest);
+    vox_sha256_hex(digest, hex_str);
+    TEST_ASSERT_STR_EQ(hex_str, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+                       "SHA256(448位)不正确");
+}
+
+/* 测试硬件实现与可移植实现结果一致（本机不支持的特性会被忽略） */
+static void test_crypto_hw_paths(vox_mpool_t* mpool) {
+    (void)mpool;  /* 未使用的参数 */
+    static const uint32_t masks[] = {
+        VOX_CRYPTO_CPU_SHA, VOX_CRYPTO_CPU_CRC32, VOX_CRYPTO_CPU_CRC32C, VOX_CRYPTO_CPU_AVX2, 0xFFFFFFFF
+    };
+    static uint8_t buf[1100];
+    for (int i = 0; i < (int)sizeof(buf); i++) buf[i] = (uint8_t)(i * 131 + 7);
+    
+    int mismatches = 0;
+    for (size_t len = 0; len <= sizeof(buf) - 1; len += (len < 200 ? 1 : 61)) {
+        const uint8_t* p = buf + (len & 3);  /* 不对齐的起始地址 */
+        uint8_t ref1[VOX_SHA1_DIGEST_SIZE], ref256[VOX_SHA256_DIGEST_SIZE];
+        uint8_t d1[VOX_SHA1_DIGEST_SIZE], d256[VOX_SHA256_DIGEST_SIZE];
+        
+        vox_crypto_set_cpu_features(0);
+        vox_sha1(p, len, ref1);
+        vox_sha256(p, len, ref256);
+        uint32_t crc = vox_crc32(p, len);
+        uint32_t crcc = vox_crc32c(p, len);
+        
+        for (size_t m = 0; m < sizeof(masks) / sizeof(masks[0]); m++) {
+            vox_crypto_set_cpu_features(masks[m]);
+            vox_sha1(p, len, d1);
+            vox_sha256(p, len, d256);
+            if (memcmp(d1, ref1, sizeof(d1)) != 0 || memcmp(d256, ref256, sizeof(d256)) != 0 ||
+                vox_crc32(p, len) != crc || vox_crc32c(p, len) != crcc) {
+                mismatches++;
+            }
+        }
+    }
+    vox_crypto_set_cpu_features(0xFFFFFFFF);
+    TEST_ASSERT_EQ(mismatches, 0, "硬件实现与可移植实现结果不一致");
+}
+
+/* 测试HMAC-SHA256 与批量计算/验证 */
+static void test_crypto_hmac_sha256_multi(vox_mpool_t* mpool) {
+    (void)mpool;  /* 未使用的参数 */
+    uint8_t digest[VOX_SHA256_DIGEST_SIZE];
+    char hex_str[65];
+    
+    /* RFC 4231 测试用例 2 与 6（密钥长于块大小） */
+    vox_hmac_sha256("Jefe", 4, "what do ya want for nothing?", 28, digest);
+    vox_hmac_sha256_hex(digest, hex_str);
+    TEST_ASSERT_STR_EQ(hex_str, "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843",
+                       "HMAC-SHA256(RFC 4231 #2)不正确");
+    uint8_t long_key[131];
+    memset(long_key, 0xaa, sizeof(long_key));
+    const char* msg6 = "Test Using Larger Than Block-Size Key - Hash Key First";
+    vox_hmac_sha256(long_key, sizeof(long_key), msg6, strlen(msg6), digest);
+    vox_hmac_sha256_hex(digest, hex_str);
+    TEST_ASSERT_STR_EQ(hex_str, "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54",
+                       "HMAC-SHA256(RFC 4231 #6)不正确");
+    
+    /* 长度各不相同的一批消息，与逐条计算比较 */
+    enum { N = 21 };
+    static uint8_t buf[800];
+    const void* data[N];
+    size_t lens[N];
+    uint8_t digests[N][VOX_SHA256_DIGEST_SIZE];
+    uint8_t hashes[N][VOX_SHA256_DIGEST_SIZE];
+    bool results[N];
+    for (int i = 0; i < (int)sizeof(buf); i++) buf[i] = (uint8_t)(i * 17 + 1);
+    for (int i = 0; i < N; i++) {
+        data[i] = buf + i;
+        lens[i] = (size_t)(i * i * 7) % 700;
+    }
+    
+    static const uint32_t masks[] = {0, VOX_CRYPTO_CPU_AVX2, 0xFFFFFFFF};
+    int mismatches = 0;
+    for (size_t m = 0; m < sizeof(masks) / sizeof(masks[0]); m++) {
+        vox_crypto_set_cpu_features(masks[m]);
+        vox_sha256_multi(data, lens, N, hashes);
+        vox_hmac_sha256_multi(long_key, 20, data, lens, N, digests);
+        for (int i = 0; i < N; i++) {
+            vox_sha256(data[i], lens[i], digest);
+            if (memcmp(digest, hashes[i], sizeof(digest)) != 0) mismatches++;
+            vox_hmac_sha256(long_key, 20, data[i], lens[i], digest);
+            if (memcmp(digest, digests[i], sizeof(digest)) != 0) mismatches++;
+        }
+    }
+    vox_crypto_set_cpu_features(0xFFFFFFFF);
+    TEST_ASSERT_EQ(mismatches, 0, "批量计算结果与逐条计算不一致");
+    
+    /* 批量验证：篡改其中一个摘要 */
+    digests[5][0] ^= 1;
+    size_t passed = vox_hmac_sha256_verify_multi(long_key, 20, data, lens, &digests[0][0], N, results);
+    TEST_ASSERT_EQ(passed, (size_t)(N - 1), "批量验证通过数量不正确");
+    TEST_ASSERT_EQ(results[5], false, "被篡改的摘要应验证失败");
+    TEST_ASSERT_EQ(results[6], true, "正确的摘要应验证通过");
 }
 
 /* 测试HMAC-MD5 */
@@ -141,8 +277,12 @@ test_case_t test_crypto_cases[] = {
     {"sha1", test_crypto_sha1},
     {"base64", test_crypto_base64},
     {"crc32", test_crypto_crc32},
+    {"crc32c", test_crypto_crc32c},
+    {"sha_vectors", test_crypto_sha_vectors},
+    {"hw_paths", test_crypto_hw_paths},
     {"hmac_md5", test_crypto_hmac_md5},
     {"hmac_sha1", test_crypto_hmac_sha1},
+    {"hmac_sha256_multi", test_crypto_hmac_sha256_multi},
 };
 
 test_suite_t test_crypto_suite = {
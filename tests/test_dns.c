@@ -0,0 +1,247 @@
+/* ============================================================
+ * test_dns.c - vox_dns 解析缓存测试
+ * 使用同一事件循环中的本地 UDP DNS 桩服务器，不依赖外部网络
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_dns.h"
+#include "../vox_loop.h"
+#include "../vox_udp.h"
+#include "../vox_socket.h"
+#include <stdio.h>
+
+/* 本地 DNS 桩服务器：test.example -> 10.0.0.1（TTL 60），其它名称返回 NXDOMAIN */
+typedef struct {
+    vox_udp_t* udp;
+    int queries;
+    uint8_t reply[512];
+} dns_stub_t;
+
+typedef struct {
+    int done;
+    int status;
+    size_t count;
+    vox_socket_addr_t first;
+} dns_result_t;
+
+static void stub_recv_cb(vox_udp_t* udp, ssize_t nread, const void* buf,
+                         const vox_socket_addr_t* addr, unsigned int flags, void* user_data) {
+    VOX_UNUSED(flags);
+    dns_stub_t* stub = (dns_stub_t*)user_data;
+    const uint8_t* q = (const uint8_t*)buf;
+    if (nread < 17 || !addr) {
+        return;
+    }
+    stub->queries++;
+
+    /* 问题段结束位置（查询中不会出现压缩） */
+    size_t pos = 12;
+    while (pos < (size_t)nread && q[pos] != 0) {
+        pos += (size_t)q[pos] + 1;
+    }
+    pos += 5;
+    if (pos > (size_t)nread || pos > 256) {
+        return;
+    }
+
+    bool known = (pos - 12 == 18) && memcmp(q + 13, "test", 4) == 0;
+    uint16_t qtype = (uint16_t)((q[pos - 4] << 8) | q[pos - 3]);
+
+    uint8_t* r = stub->reply;
+    memcpy(r, q, pos);
+    r[2] = 0x81;                       /* QR | RD */
+    r[3] = known ? 0x80 : 0x83;        /* RA，未知名称 NXDOMAIN */
+    r[6] = 0; r[7] = 0; r[8] = 0; r[9] = 0; r[10] = 0; r[11] = 0;
+    size_t len = pos;
+    if (known && qtype == 1) {
+        static const uint8_t answer[] = {
+            0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3C, 0x00, 0x04, 10, 0, 0, 1
+        };
+        r[7] = 1;
+        memcpy(r + len, answer, sizeof(answer));
+        len += sizeof(answer);
+    }
+    vox_udp_send(udp, r, len, addr, NULL);
+}
+
+static int stub_start_search(vox_loop_t* loop, dns_stub_t* stub, const char* search, uint32_t ndots) {
+    memset(stub, 0, sizeof(*stub));
+    stub->udp = vox_udp_create(loop);
+    if (!stub->udp) {
+        return -1;
+    }
+    vox_socket_addr_t addr;
+    vox_socket_parse_address("127.0.0.1", 0, &addr);
+    vox_handle_set_data((vox_handle_t*)stub->udp, stub);
+    if (vox_udp_bind(stub->udp, &addr, 0) != 0 ||
+        vox_udp_recv_start(stub->udp, NULL, stub_recv_cb) != 0 ||
+        vox_udp_getsockname(stub->udp, &addr) != 0) {
+        return -1;
+    }
+
+    char ns[64];
+    snprintf(ns, sizeof(ns), "127.0.0.1:%u", (unsigned)vox_socket_get_port(&addr));
+    vox_dns_cache_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.nameservers = ns;
+    config.search = search;
+    config.ndots = ndots;
+    config.prefetch_percent = 101;
+    return vox_dns_cache_configure(loop, &config);
+}
+
+static int stub_start(vox_loop_t* loop, dns_stub_t* stub) {
+    return stub_start_search(loop, stub, NULL, 0);
+}
+
+static void result_cb(vox_dns_getaddrinfo_t* req, int status,
+                      const vox_dns_addrinfo_t* addrinfo, void* user_data) {
+    VOX_UNUSED(req);
+    dns_result_t* res = (dns_result_t*)user_data;
+    res->done = 1;
+    res->status = status;
+    res->count = addrinfo ? addrinfo->count : 0;
+    if (res->count > 0) {
+        res->first = addrinfo->addrs[0];
+    }
+}
+
+static void run_until(vox_loop_t* loop, const int* a, const int* b) {
+    for (int i = 0; i < 200 && !(*a && (!b || *b)); i++) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+    }
+}
+
+static int resolve_once(vox_loop_t* loop, const char* name, dns_result_t* res) {
+    memset(res, 0, sizeof(*res));
+    vox_dns_getaddrinfo_t* req = vox_dns_getaddrinfo_create(loop);
+    if (!req || vox_dns_getaddrinfo(req, name, "80", VOX_AF_INET, result_cb, res, 3000) != 0) {
+        return -1;
+    }
+    run_until(loop, &res->done, NULL);
+    vox_dns_getaddrinfo_destroy(req);
+    return 0;
+}
+
+/* 测试并发查询合并与缓存命中 */
+static void test_dns_cache_coalesce_and_hit(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    dns_stub_t stub;
+    TEST_ASSERT_EQ(stub_start(loop, &stub), 0, "启动DNS桩服务器失败");
+
+    dns_result_t r1, r2;
+    memset(&r1, 0, sizeof(r1));
+    memset(&r2, 0, sizeof(r2));
+    vox_dns_getaddrinfo_t* req1 = vox_dns_getaddrinfo_create(loop);
+    vox_dns_getaddrinfo_t* req2 = vox_dns_getaddrinfo_create(loop);
+    TEST_ASSERT_EQ(vox_dns_getaddrinfo(req1, "test.example", "80", VOX_AF_INET, result_cb, &r1, 3000), 0,
+                   "发起查询1失败");
+    TEST_ASSERT_EQ(vox_dns_getaddrinfo(req2, "TEST.example.", "443", VOX_AF_INET, result_cb, &r2, 3000), 0,
+                   "发起查询2失败");
+    run_until(loop, &r1.done, &r2.done);
+
+    TEST_ASSERT_EQ(r1.status, 0, "查询1应成功");
+    TEST_ASSERT_EQ(r2.status, 0, "查询2应成功");
+    TEST_ASSERT_EQ(r1.count, 1, "查询1地址数量不正确");
+    TEST_ASSERT_EQ(stub.queries, 1, "并发查询应合并为一次 UDP 查询");
+    TEST_ASSERT_EQ(vox_socket_get_port(&r1.first), 80, "查询1端口不正确");
+    TEST_ASSERT_EQ(vox_socket_get_port(&r2.first), 443, "查询2端口不正确");
+    char ip[64];
+    vox_socket_address_to_string(&r1.first, ip, sizeof(ip));
+    TEST_ASSERT_STR_EQ(ip, "10.0.0.1", "解析地址不正确");
+    vox_dns_getaddrinfo_destroy(req1);
+    vox_dns_getaddrinfo_destroy(req2);
+
+    dns_result_t r3;
+    TEST_ASSERT_EQ(resolve_once(loop, "test.example", &r3), 0, "发起查询3失败");
+    TEST_ASSERT_EQ(r3.status, 0, "缓存命中应成功");
+    TEST_ASSERT_EQ(stub.queries, 1, "缓存命中不应再发出查询");
+
+    vox_dns_cache_stats_t stats;
+    TEST_ASSERT_EQ(vox_dns_cache_get_stats(loop, &stats), 0, "获取统计失败");
+    TEST_ASSERT_EQ(stats.hits, 1, "命中次数不正确");
+    TEST_ASSERT_EQ(stats.coalesced, 1, "合并次数不正确");
+    TEST_ASSERT_EQ(stats.entries, 1, "缓存项数量不正确");
+
+    vox_dns_cache_clear(loop);
+    TEST_ASSERT_EQ(resolve_once(loop, "test.example", &r3), 0, "发起查询4失败");
+    TEST_ASSERT_EQ(stub.queries, 2, "清空缓存后应重新查询");
+
+    vox_udp_destroy(stub.udp);
+    vox_loop_destroy(loop);
+}
+
+/* 测试 NXDOMAIN 负缓存与数字地址直通 */
+static void test_dns_cache_negative(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    dns_stub_t stub;
+    TEST_ASSERT_EQ(stub_start(loop, &stub), 0, "启动DNS桩服务器失败");
+
+    dns_result_t res;
+    TEST_ASSERT_EQ(resolve_once(loop, "missing.example", &res), 0, "发起查询失败");
+    TEST_ASSERT_EQ(res.done, 1, "回调未执行");
+    TEST_ASSERT_NE(res.status, 0, "NXDOMAIN 应返回失败");
+    TEST_ASSERT_EQ(stub.queries, 1, "应发出一次查询");
+
+    TEST_ASSERT_EQ(resolve_once(loop, "missing.example", &res), 0, "发起查询失败");
+    TEST_ASSERT_NE(res.status, 0, "负缓存应返回失败");
+    TEST_ASSERT_EQ(stub.queries, 1, "负缓存命中不应再发出查询");
+
+    TEST_ASSERT_EQ(resolve_once(loop, "192.0.2.7", &res), 0, "发起查询失败");
+    TEST_ASSERT_EQ(res.status, 0, "数字地址应直接成功");
+    TEST_ASSERT_EQ(vox_socket_get_port(&res.first), 80, "数字地址端口不正确");
+    TEST_ASSERT_EQ(stub.queries, 1, "数字地址不应发出查询");
+
+    vox_udp_destroy(stub.udp);
+    vox_loop_destroy(loop);
+}
+
+/* 测试 search 域与 ndots：NXDOMAIN 后依次尝试下一个候选名称 */
+static void test_dns_cache_search(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    dns_stub_t stub;
+    TEST_ASSERT_EQ(stub_start_search(loop, &stub, "corp, example.", 2), 0, "启动DNS桩服务器失败");
+
+    /* 单标签：test.corp（NXDOMAIN）-> test.example */
+    dns_result_t res;
+    TEST_ASSERT_EQ(resolve_once(loop, "test", &res), 0, "发起查询失败");
+    TEST_ASSERT_EQ(res.status, 0, "search 域展开后应解析成功");
+    TEST_ASSERT_EQ(stub.queries, 2, "应依次查询两个候选名称");
+    char ip[64];
+    vox_socket_address_to_string(&res.first, ip, sizeof(ip));
+    TEST_ASSERT_STR_EQ(ip, "10.0.0.1", "解析地址不正确");
+
+    /* 点数少于 ndots：先 search 域，最后原名 */
+    TEST_ASSERT_EQ(resolve_once(loop, "test.example", &res), 0, "发起查询失败");
+    TEST_ASSERT_EQ(res.status, 0, "原名应作为最后的候选解析成功");
+    TEST_ASSERT_EQ(stub.queries, 5, "应查询 test.example.corp、test.example.example、test.example");
+
+    /* 所有候选均 NXDOMAIN 才负缓存 */
+    TEST_ASSERT_EQ(resolve_once(loop, "missing", &res), 0, "发起查询失败");
+    TEST_ASSERT_NE(res.status, 0, "所有候选均不存在应返回失败");
+    TEST_ASSERT_EQ(stub.queries, 8, "应查询全部候选名称");
+    TEST_ASSERT_EQ(resolve_once(loop, "missing", &res), 0, "发起查询失败");
+    TEST_ASSERT_EQ(stub.queries, 8, "负缓存命中不应再发出查询");
+
+    vox_udp_destroy(stub.udp);
+    vox_loop_destroy(loop);
+}
+
+/* 测试套件 */
+test_case_t test_dns_cases[] = {
+    {"cache_coalesce_and_hit", test_dns_cache_coalesce_and_hit},
+    {"cache_negative", test_dns_cache_negative},
+    {"cache_search", test_dns_cache_search},
+};
+
+test_suite_t test_dns_suite = {
+    "vox_dns",
+    test_dns_cases,
+    sizeof(test_dns_cases) / sizeof(test_dns_cases[0])
+};
@@ -0,0 +1,282 @@
+/* ============================================================
+ * test_ebr.c - vox_ebr 纪元回收测试
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_os.h"
+#include "../vox_ebr.h"
+#include "../vox_thread.h"
+#include "../vox_atomic.h"
+#include <stdio.h>
+
+#define EBR_NODE_MAGIC 0x5EB0C0DEu
+#define EBR_NODE_DEAD 0xDEADBEEFu
+#define EBR_WRITERS 2
+#define EBR_READERS 4
+#define EBR_WRITER_OPS 20000
+
+static void count_free(void* ptr, void* user_data) {
+    VOX_UNUSED(ptr);
+    vox_atomic_int_increment((vox_atomic_int_t*)user_data);
+}
+
+/* 测试临界区嵌套与退休对象的延迟释放 */
+static void test_ebr_basic(vox_mpool_t* mpool) {
+    vox_ebr_t* ebr = vox_ebr_create(mpool);
+    TEST_ASSERT_NOT_NULL(ebr, "创建 EBR 域失败");
+    vox_ebr_thread_t* t = vox_ebr_thread(ebr);
+    TEST_ASSERT_NOT_NULL(t, "获取线程句柄失败");
+    TEST_ASSERT_EQ(vox_ebr_thread(ebr), t, "同一线程应返回相同的句柄");
+
+    vox_ebr_enter(t);
+    vox_ebr_enter(t);
+    TEST_ASSERT(vox_ebr_in_critical(t), "应处于临界区");
+    vox_ebr_exit(t);
+    TEST_ASSERT(vox_ebr_in_critical(t), "嵌套未完全退出，应仍处于临界区");
+    vox_ebr_exit(t);
+    TEST_ASSERT(!vox_ebr_in_critical(t), "应已离开临界区");
+
+    vox_atomic_int_t freed;
+    vox_atomic_int_init(&freed, 0);
+    int obj = 0;
+    vox_ebr_enter(t);
+    TEST_ASSERT_EQ(vox_ebr_retire(t, &obj, count_free, &freed), 0, "退休失败");
+    for (int i = 0; i < 5; i++) vox_ebr_collect(t);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&freed), 0, "仍在临界区内，不应释放");
+    vox_ebr_exit(t);
+    for (int i = 0; i < 3; i++) vox_ebr_collect(t);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&freed), 1, "离开临界区后应释放");
+
+    size_t pending = 1, threads = 0;
+    uint64_t epoch = 0;
+    vox_ebr_stats(ebr, &epoch, &pending, &threads);
+    TEST_ASSERT_EQ(pending, 0, "不应有待回收对象");
+    TEST_ASSERT_EQ(threads, 1, "线程句柄数量不正确");
+    TEST_ASSERT(epoch >= 2, "纪元应已推进");
+
+    /* 销毁时释放剩余对象 */
+    TEST_ASSERT_EQ(vox_ebr_retire(t, &obj, count_free, &freed), 0, "退休失败");
+    vox_ebr_destroy(ebr);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&freed), 2, "销毁时应释放剩余对象");
+}
+
+typedef struct {
+    vox_ebr_t* ebr;
+    vox_atomic_int_t* freed;
+    vox_atomic_int_t* entered;
+    vox_atomic_int_t* release;
+} ebr_blocker_ctx_t;
+
+/* 另一个线程停留在临界区，直到收到释放信号 */
+static int ebr_blocker(void* user_data) {
+    ebr_blocker_ctx_t* ctx = (ebr_blocker_ctx_t*)user_data;
+    vox_ebr_thread_t* t = vox_ebr_register(ctx->ebr);
+    vox_ebr_enter(t);
+    vox_atomic_int_store(ctx->entered, 1);
+    while (!vox_atomic_int_load(ctx->release)) vox_thread_yield();
+    vox_ebr_exit(t);
+    vox_ebr_unregister(t);
+    return 0;
+}
+
+/* 测试其他线程的临界区阻止回收，以及 synchronize 等待其离开 */
+static void test_ebr_cross_thread(vox_mpool_t* mpool) {
+    vox_ebr_t* ebr = vox_ebr_create(mpool);
+    TEST_ASSERT_NOT_NULL(ebr, "创建 EBR 域失败");
+    vox_ebr_thread_t* t = vox_ebr_register(ebr);
+    TEST_ASSERT_NOT_NULL(t, "注册线程失败");
+
+    vox_atomic_int_t freed, entered, release;
+    vox_atomic_int_init(&freed, 0);
+    vox_atomic_int_init(&entered, 0);
+    vox_atomic_int_init(&release, 0);
+    ebr_blocker_ctx_t ctx = {ebr, &freed, &entered, &release};
+    vox_thread_t* th = vox_thread_create(mpool, ebr_blocker, &ctx);
+    TEST_ASSERT_NOT_NULL(th, "创建线程失败");
+    while (!vox_atomic_int_load(&entered)) vox_thread_yield();
+
+    int obj = 0;
+    TEST_ASSERT_EQ(vox_ebr_retire(t, &obj, count_free, &freed), 0, "退休失败");
+    for (int i = 0; i < 5; i++) vox_ebr_collect(t);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&freed), 0, "其他线程仍在临界区内，不应释放");
+
+    vox_atomic_int_store(&release, 1);
+    TEST_ASSERT_EQ(vox_ebr_synchronize(t), 1, "synchronize 应释放退休的对象");
+    TEST_ASSERT_EQ(vox_atomic_int_load(&freed), 1, "应已释放");
+    vox_thread_join(th, NULL);
+
+    /* 临界区内不能 synchronize */
+    vox_ebr_enter(t);
+    TEST_ASSERT_EQ(vox_ebr_synchronize(t), 0, "临界区内 synchronize 应直接返回");
+    vox_ebr_exit(t);
+
+    vox_ebr_unregister(t);
+    vox_ebr_destroy(ebr);
+}
+
+typedef struct {
+    vox_ebr_t* ebr;
+    vox_atomic_int_t* freed;
+    int* objs;
+    int count;
+} ebr_retirer_ctx_t;
+
+/* 退休一批对象后直接退出（句柄由 TLS 析构自动注销） */
+static int ebr_retirer(void* user_data) {
+    ebr_retirer_ctx_t* ctx = (ebr_retirer_ctx_t*)user_data;
+    vox_ebr_thread_t* t = vox_ebr_thread(ctx->ebr);
+    if (!t) return -1;
+    for (int i = 0; i < ctx->count; i++) {
+        vox_ebr_retire(t, &ctx->objs[i], count_free, ctx->freed);
+    }
+    return 0;
+}
+
+/* 测试已注销线程遗留的对象由其他线程接管回收，句柄被复用 */
+static void test_ebr_adopt(vox_mpool_t* mpool) {
+    vox_ebr_config_t config = {0};
+    config.batch_size = 1000;
+    vox_ebr_t* ebr = vox_ebr_create_with_config(mpool, &config);
+    TEST_ASSERT_NOT_NULL(ebr, "创建 EBR 域失败");
+    vox_atomic_int_t freed;
+    vox_atomic_int_init(&freed, 0);
+    int objs[10];
+    ebr_retirer_ctx_t ctx = {ebr, &freed, objs, 10};
+
+    vox_thread_t* th = vox_thread_create(mpool, ebr_retirer, &ctx);
+    TEST_ASSERT_NOT_NULL(th, "创建线程失败");
+    vox_thread_join(th, NULL);
+
+    size_t pending = 0, threads = 1;
+    vox_ebr_stats(ebr, NULL, &pending, &threads);
+#if !defined(VOX_OS_WINDOWS)
+    TEST_ASSERT_EQ(threads, 0, "线程退出后句柄应已注销");
+    TEST_ASSERT(pending > 0, "对象应在退出线程的句柄上等待回收");
+#endif
+
+    vox_ebr_thread_t* t = vox_ebr_register(ebr);
+    TEST_ASSERT_NOT_NULL(t, "注册线程失败");
+    vox_ebr_synchronize(t);
+    vox_ebr_collect(t);
+    vox_ebr_stats(ebr, NULL, &pending, &threads);
+#if !defined(VOX_OS_WINDOWS)
+    TEST_ASSERT_EQ(vox_atomic_int_load(&freed), 10, "遗留对象应被接管回收");
+    TEST_ASSERT_EQ(pending, 0, "不应有待回收对象");
+    TEST_ASSERT_EQ(threads, 1, "线程句柄数量不正确");
+#endif
+    vox_ebr_unregister(t);
+    vox_ebr_destroy(ebr);
+    TEST_ASSERT_EQ(vox_atomic_int_load(&freed), 10, "所有对象应恰好释放一次");
+}
+
+typedef struct {
+    uint32_t magic;
+    intptr_t value;
+} ebr_node_t;
+
+typedef struct {
+    vox_ebr_t* ebr;
+    vox_mpool_t* pool;
+    vox_atomic_ptr_t* shared;
+    vox_atomic_int_t* stop;
+    int errors;
+} ebr_stress_ctx_t;
+
+/* 释放前先破坏魔数，读者若读到已释放的节点即可发现 */
+static void poison_free(void* ptr, void* user_data) {
+    ebr_node_t* node = (ebr_node_t*)ptr;
+    node->magic = EBR_NODE_DEAD;
+    vox_mpool_free((vox_mpool_t*)user_data, node);
+}
+
+static int ebr_stress_reader(void* user_data) {
+    ebr_stress_ctx_t* ctx = (ebr_stress_ctx_t*)user_data;
+    vox_ebr_thread_t* t = vox_ebr_thread(ctx->ebr);
+    if (!t) return -1;
+    while (!vox_atomic_int_load(ctx->stop)) {
+        vox_ebr_enter(t);
+        ebr_node_t* node = (ebr_node_t*)vox_atomic_ptr_load(ctx->shared);
+        if (node->magic != EBR_NODE_MAGIC) ctx->errors++;
+        vox_thread_yield();
+        if (node->magic != EBR_NODE_MAGIC || node->value < 0) ctx->errors++;
+        vox_ebr_exit(t);
+    }
+    return 0;
+}
+
+static int ebr_stress_writer(void* user_data) {
+    ebr_stress_ctx_t* ctx = (ebr_stress_ctx_t*)user_data;
+    vox_ebr_thread_t* t = vox_ebr_thread(ctx->ebr);
+    if (!t) return -1;
+    for (intptr_t i = 0; i < EBR_WRITER_OPS; i++) {
+        ebr_node_t* node = (ebr_node_t*)vox_mpool_alloc(ctx->pool, sizeof(ebr_node_t));
+        if (!node) {
+            ctx->errors++;
+            continue;
+        }
+        node->magic = EBR_NODE_MAGIC;
+        node->value = i;
+        ebr_node_t* old = (ebr_node_t*)vox_atomic_ptr_exchange(ctx->shared, node);
+        if (vox_ebr_retire(t, old, poison_free, ctx->pool) != 0) ctx->errors++;
+    }
+    return 0;
+}
+
+/* 多线程压力测试：写者不断替换共享节点并退休旧节点，读者在临界区内反复校验 */
+static void test_ebr_stress(vox_mpool_t* mpool) {
+    vox_ebr_t* ebr = vox_ebr_create(mpool);
+    TEST_ASSERT_NOT_NULL(ebr, "创建 EBR 域失败");
+    vox_mpool_config_t pool_config = {0};
+    pool_config.thread_safe = 1;
+    vox_mpool_t* pool = vox_mpool_create_with_config(&pool_config);
+    TEST_ASSERT_NOT_NULL(pool, "创建内存池失败");
+
+    ebr_node_t* first = (ebr_node_t*)vox_mpool_alloc(pool, sizeof(ebr_node_t));
+    TEST_ASSERT_NOT_NULL(first, "分配节点失败");
+    first->magic = EBR_NODE_MAGIC;
+    first->value = 0;
+    vox_atomic_ptr_t shared;
+    vox_atomic_ptr_init(&shared, first);
+    vox_atomic_int_t stop;
+    vox_atomic_int_init(&stop, 0);
+
+    ebr_stress_ctx_t ctx[EBR_WRITERS + EBR_READERS];
+    vox_thread_t* threads[EBR_WRITERS + EBR_READERS];
+    for (int i = 0; i < EBR_WRITERS + EBR_READERS; i++) {
+        ctx[i].ebr = ebr;
+        ctx[i].pool = pool;
+        ctx[i].shared = &shared;
+        ctx[i].stop = &stop;
+        ctx[i].errors = 0;
+        threads[i] = vox_thread_create(mpool, i < EBR_WRITERS ? ebr_stress_writer : ebr_stress_reader, &ctx[i]);
+        TEST_ASSERT_NOT_NULL(threads[i], "创建线程失败");
+    }
+    for (int i = 0; i < EBR_WRITERS; i++) {
+        vox_thread_join(threads[i], NULL);
+    }
+    vox_atomic_int_store(&stop, 1);
+    for (int i = EBR_WRITERS; i < EBR_WRITERS + EBR_READERS; i++) {
+        vox_thread_join(threads[i], NULL);
+    }
+    for (int i = 0; i < EBR_WRITERS + EBR_READERS; i++) {
+        TEST_ASSERT_EQ(ctx[i].errors, 0, "读者访问到了已释放的节点");
+    }
+
+    vox_ebr_destroy(ebr);
+    vox_mpool_free(pool, vox_atomic_ptr_load(&shared));
+    vox_mpool_destroy(pool);
+}
+
+/* 测试套件 */
+test_case_t test_ebr_cases[] = {
+    {"basic", test_ebr_basic},
+    {"cross_thread", test_ebr_cross_thread},
+    {"adopt", test_ebr_adopt},
+    {"stress", test_ebr_stress},
+};
+
+test_suite_t test_ebr_suite = {
+    "vox_ebr",
+    test_ebr_cases,
+    sizeof(test_ebr_cases) / sizeof(test_ebr_cases[0])
+};
@@ -0,0 +1,87 @@
+/* ============================================================
+ * test_fdtable.c - vox_fdtable 测试
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_os.h"
+#include "../vox_fdtable.h"
+
+/* 测试设置、查找、删除与最大 fd 维护 */
+static void test_fdtable_basic(vox_mpool_t* mpool) {
+    vox_fdtable_t* t = vox_fdtable_create(mpool);
+    TEST_ASSERT_NOT_NULL(t, "创建 fd 表失败");
+    int a = 1, b = 2, c = 3;
+
+    TEST_ASSERT_EQ(vox_fdtable_set(t, 3, &a), 0, "设置 fd 3 失败");
+    TEST_ASSERT_EQ(vox_fdtable_set(t, 700, &b), 0, "设置 fd 700 失败");
+    TEST_ASSERT_EQ(vox_fdtable_set(t, 100000, &c), 0, "设置稀疏大 fd 失败");
+    TEST_ASSERT_NE(vox_fdtable_set(t, -1, &a), 0, "负 fd 应失败");
+    TEST_ASSERT_EQ(vox_fdtable_count(t), 3, "数量不正确");
+    TEST_ASSERT_EQ(vox_fdtable_max_fd(t), 100000, "最大 fd 不正确");
+    TEST_ASSERT_EQ(vox_fdtable_get(t, 700), &b, "查找 fd 700 失败");
+    TEST_ASSERT_NULL(vox_fdtable_get(t, 4), "未设置的 fd 应返回 NULL");
+    TEST_ASSERT_NULL(vox_fdtable_get(t, 1 << 30), "越界 fd 应返回 NULL");
+
+    /* 覆盖不改变数量 */
+    TEST_ASSERT_EQ(vox_fdtable_set(t, 3, &c), 0, "覆盖 fd 3 失败");
+    TEST_ASSERT_EQ(vox_fdtable_count(t), 3, "覆盖后数量不应变化");
+
+    TEST_ASSERT_EQ(vox_fdtable_remove(t, 100000), &c, "删除应返回旧值");
+    TEST_ASSERT_EQ(vox_fdtable_max_fd(t), 700, "删除后最大 fd 应回落");
+    TEST_ASSERT_NULL(vox_fdtable_remove(t, 100000), "重复删除应返回 NULL");
+    TEST_ASSERT_EQ(vox_fdtable_set(t, 700, NULL), 0, "置 NULL 等同删除");
+    TEST_ASSERT_EQ(vox_fdtable_max_fd(t), 3, "最大 fd 不正确");
+    TEST_ASSERT_EQ(vox_fdtable_count(t), 1, "数量不正确");
+
+    vox_fdtable_destroy(t);
+}
+
+typedef struct {
+    int fds[8];
+    int n;
+    vox_fdtable_t* t;
+} fdtable_iter_ctx_t;
+
+static void collect_cb(int fd, void* value, void* user_data) {
+    VOX_UNUSED(value);
+    fdtable_iter_ctx_t* ctx = (fdtable_iter_ctx_t*)user_data;
+    if (ctx->n < 8) ctx->fds[ctx->n++] = fd;
+    /* 遍历中删除后续项：不应再被访问 */
+    if (fd == 10) vox_fdtable_remove(ctx->t, 2000);
+}
+
+/* 测试按 fd 升序遍历，且回调中可删除表项 */
+static void test_fdtable_foreach(vox_mpool_t* mpool) {
+    vox_fdtable_t* t = vox_fdtable_create(mpool);
+    TEST_ASSERT_NOT_NULL(t, "创建 fd 表失败");
+    int v = 0;
+    static const int fds[] = {2000, 10, 513, 0, 4096};
+    for (size_t i = 0; i < sizeof(fds) / sizeof(fds[0]); i++) {
+        TEST_ASSERT_EQ(vox_fdtable_set(t, fds[i], &v), 0, "设置失败");
+    }
+
+    fdtable_iter_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.t = t;
+    size_t visited = vox_fdtable_foreach(t, collect_cb, &ctx);
+    TEST_ASSERT_EQ(visited, 4, "遍历数量不正确");
+    static const int expected[] = {0, 10, 513, 4096};
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQ(ctx.fds[i], expected[i], "遍历顺序不正确");
+    }
+    TEST_ASSERT_EQ(vox_fdtable_count(t), 4, "数量不正确");
+
+    vox_fdtable_destroy(t);
+}
+
+/* 测试套件 */
+test_case_t test_fdtable_cases[] = {
+    {"basic", test_fdtable_basic},
+    {"foreach", test_fdtable_foreach},
+};
+
+test_suite_t test_fdtable_suite = {
+    "vox_fdtable",
+    test_fdtable_cases,
+    sizeof(test_fdtable_cases) / sizeof(test_fdtable_cases[0])
+};
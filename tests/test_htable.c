@@ -224,6 +224,38 @@ static void test_htable_delete_reinsert(vox_mpool_t* mpool) {
     vox_htable_destroy(htable);
 }
 
+/* 测试长短键混合的反复增删：已删除槽会被整理，容量不随删除次数增长 */
+static void test_htable_churn(vox_mpool_t* mpool) {
+    vox_htable_t* htable = vox_htable_create(mpool);
+    TEST_ASSERT_NOT_NULL(htable, "创建htable失败");
+    
+    char key[64];
+    static int values[64];
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < 64; i++) {
+            int len = (i % 2) ? snprintf(key, sizeof(key), "k%d", i)
+                              : snprintf(key, sizeof(key), "long-key-stored-out-of-line-%d", i);
+            values[i] = round * 64 + i;
+            TEST_ASSERT_EQ(vox_htable_set(htable, key, (size_t)len, &values[i]), 0, "插入失败");
+        }
+        for (int i = 0; i < 64; i++) {
+            int len = (i % 2) ? snprintf(key, sizeof(key), "k%d", i)
+                              : snprintf(key, sizeof(key), "long-key-stored-out-of-line-%d", i);
+            int* val = (int*)vox_htable_get(htable, key, (size_t)len);
+            TEST_ASSERT_NOT_NULL(val, "获取值失败");
+            TEST_ASSERT_EQ(*val, round * 64 + i, "值不正确");
+            TEST_ASSERT_EQ(vox_htable_delete(htable, key, (size_t)len), 0, "删除失败");
+        }
+        TEST_ASSERT_EQ(vox_htable_size(htable), 0, "删除后大小应为0");
+    }
+    
+    size_t capacity = 0;
+    vox_htable_stats(htable, &capacity, NULL, NULL);
+    TEST_ASSERT(capacity <= 256, "反复增删不应持续扩容");
+    
+    vox_htable_destroy(htable);
+}
+
 /* 测试套件 */
 test_case_t test_htable_cases[] = {
     {"create_destroy", test_htable_create_destroy},
@@ -236,6 +268,7 @@ test_case_t test_htable_cases[] = {
     {"collision", test_htable_collision},
     {"edge_cases", test_htable_edge_cases},
     {"delete_reinsert", test_htable_delete_reinsert},
+    {"churn", test_htable_churn},
 };
 
 test_suite_t test_htable_suite = {
@@ -0,0 +1,598 @@
+/* ============================================================
+ * test_http2.c - HPACK（RFC 7541 附录 C 向量）与 HTTP/2 会话测试
+ * 会话测试直接喂入客户端帧，通过 send 回调收集服务端输出并逐帧解析
+ * ============================================================ */
+
+#include "test_runner.h"
+
+#include "../vox_loop.h"
+#include "../vox_string.h"
+
+#include "../http/vox_http2.h"
+#include "../http/vox_http_hpack.h"
+#include "../http/vox_http_engine.h"
+#include "../http/vox_http_context.h"
+
+#include <string.h>
+#include <stdint.h>
+
+/* ===== 工具 ===== */
+
+static size_t h2_unhex(const char* hex, uint8_t* out) {
+    size_t n = 0;
+    for (; hex[0] && hex[1]; hex += 2) {
+        unsigned v = 0;
+        sscanf(hex, "%2x", &v);
+        out[n++] = (uint8_t)v;
+    }
+    return n;
+}
+
+typedef struct {
+    char names[16][64];
+    char values[16][64];
+    size_t count;
+} h2_header_list_t;
+
+static int h2_collect_header(void* user_data, const char* name, size_t nlen, const char* value, size_t vlen) {
+    h2_header_list_t* l = (h2_header_list_t*)user_data;
+    if (l->count >= 16 || nlen >= 64 || vlen >= 64) return -1;
+    memcpy(l->names[l->count], name, nlen);
+    l->names[l->count][nlen] = '\0';
+    memcpy(l->values[l->count], value, vlen);
+    l->values[l->count][vlen] = '\0';
+    l->count++;
+    return 0;
+}
+
+static const char* h2_find(const h2_header_list_t* l, const char* name) {
+    for (size_t i = 0; i < l->count; i++) {
+        if (strcmp(l->names[i], name) == 0) return l->values[i];
+    }
+    return NULL;
+}
+
+/* ===== HPACK ===== */
+
+static void test_hpack_rfc_no_huffman(vox_mpool_t* mpool) {
+    vox_http_hpack_t* dec = vox_http_hpack_create(mpool, 4096);
+    TEST_ASSERT_NOT_NULL(dec, "创建解码器失败");
+    uint8_t buf[128];
+    h2_header_list_t l;
+
+    /* C.3.1 */
+    memset(&l, 0, sizeof(l));
+    size_t n = h2_unhex("828684410f7777772e6578616d706c652e636f6d", buf);
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, buf, n, h2_collect_header, &l), 0, "C.3.1 解码失败");
+    TEST_ASSERT_EQ(l.count, 4, "C.3.1 头部数量不正确");
+    TEST_ASSERT_STR_EQ(l.values[0], "GET", ":method 不正确");
+    TEST_ASSERT_STR_EQ(h2_find(&l, ":authority"), "www.example.com", ":authority 不正确");
+    TEST_ASSERT_EQ(vox_http_hpack_table_size(dec), 57, "C.3.1 动态表大小不正确");
+
+    /* C.3.2：引用动态表条目 */
+    memset(&l, 0, sizeof(l));
+    n = h2_unhex("828684be58086e6f2d6361636865", buf);
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, buf, n, h2_collect_header, &l), 0, "C.3.2 解码失败");
+    TEST_ASSERT_EQ(l.count, 5, "C.3.2 头部数量不正确");
+    TEST_ASSERT_STR_EQ(h2_find(&l, ":authority"), "www.example.com", "动态表索引不正确");
+    TEST_ASSERT_STR_EQ(h2_find(&l, "cache-control"), "no-cache", "cache-control 不正确");
+    TEST_ASSERT_EQ(vox_http_hpack_table_size(dec), 110, "C.3.2 动态表大小不正确");
+
+    /* C.3.3 */
+    memset(&l, 0, sizeof(l));
+    n = h2_unhex("828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565", buf);
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, buf, n, h2_collect_header, &l), 0, "C.3.3 解码失败");
+    TEST_ASSERT_STR_EQ(h2_find(&l, ":path"), "/index.html", ":path 不正确");
+    TEST_ASSERT_STR_EQ(h2_find(&l, "custom-key"), "custom-value", "custom-key 不正确");
+    TEST_ASSERT_EQ(vox_http_hpack_table_size(dec), 164, "C.3.3 动态表大小不正确");
+    TEST_ASSERT_EQ(vox_http_hpack_table_count(dec), 3, "C.3.3 动态表条目数不正确");
+
+    vox_http_hpack_destroy(dec);
+}
+
+static void test_hpack_rfc_huffman(vox_mpool_t* mpool) {
+    vox_http_hpack_t* dec = vox_http_hpack_create(mpool, 4096);
+    TEST_ASSERT_NOT_NULL(dec, "创建解码器失败");
+    uint8_t buf[128];
+    h2_header_list_t l;
+
+    /* C.4.1 ~ C.4.3 */
+    memset(&l, 0, sizeof(l));
+    size_t n = h2_unhex("828684418cf1e3c2e5f23a6ba0ab90f4ff", buf);
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, buf, n, h2_collect_header, &l), 0, "C.4.1 解码失败");
+    TEST_ASSERT_STR_EQ(h2_find(&l, ":authority"), "www.example.com", "Huffman 解码不正确");
+
+    memset(&l, 0, sizeof(l));
+    n = h2_unhex("828684be5886a8eb10649cbf", buf);
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, buf, n, h2_collect_header, &l), 0, "C.4.2 解码失败");
+    TEST_ASSERT_STR_EQ(h2_find(&l, "cache-control"), "no-cache", "Huffman 解码不正确");
+
+    memset(&l, 0, sizeof(l));
+    n = h2_unhex("828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf", buf);
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, buf, n, h2_collect_header, &l), 0, "C.4.3 解码失败");
+    TEST_ASSERT_STR_EQ(h2_find(&l, "custom-key"), "custom-value", "Huffman 解码不正确");
+    TEST_ASSERT_EQ(vox_http_hpack_table_size(dec), 164, "C.4.3 动态表大小不正确");
+
+    /* Huffman 编码与 C.4.1 一致 */
+    vox_string_t* out = vox_string_create(mpool);
+    TEST_ASSERT_EQ(vox_http_hpack_huffman_encoded_len("www.example.com", 15), 12, "Huffman 长度不正确");
+    TEST_ASSERT_EQ(vox_http_hpack_huffman_encode("www.example.com", 15, out), 0, "Huffman 编码失败");
+    n = h2_unhex("f1e3c2e5f23a6ba0ab90f4ff", buf);
+    TEST_ASSERT_EQ(vox_string_length(out), n, "Huffman 编码长度不正确");
+    TEST_ASSERT_EQ(memcmp(vox_string_data(out), buf, n), 0, "Huffman 编码不正确");
+
+    /* 非法填充（填充位不全为1）与超长填充 */
+    vox_string_clear(out);
+    uint8_t bad_pad[] = { 0x1c, 0x00 };
+    TEST_ASSERT_EQ(vox_http_hpack_huffman_decode(bad_pad, 1, out), -1, "非法填充应失败");
+    uint8_t long_pad[] = { 0xff, 0xff };
+    TEST_ASSERT_EQ(vox_http_hpack_huffman_decode(long_pad, 2, out), -1, "超过7位的填充应失败");
+
+    /* 索引越界与索引0 */
+    uint8_t bad_index[] = { 0xff, 0x7f };
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, bad_index, 2, h2_collect_header, &l), -1, "越界索引应失败");
+    uint8_t zero_index[] = { 0x80 };
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, zero_index, 1, h2_collect_header, &l), -1, "索引0应失败");
+
+    vox_string_destroy(out);
+    vox_http_hpack_destroy(dec);
+}
+
+static void test_hpack_roundtrip(vox_mpool_t* mpool) {
+    vox_http_hpack_t* enc = vox_http_hpack_create(mpool, 4096);
+    vox_http_hpack_t* dec = vox_http_hpack_create(mpool, 4096);
+    vox_string_t* blk = vox_string_create(mpool);
+    TEST_ASSERT_TRUE(enc && dec && blk, "创建失败");
+
+    for (int round = 0; round < 2; round++) {
+        vox_string_clear(blk);
+        TEST_ASSERT_EQ(vox_http_hpack_encode_begin(enc, blk), 0, "encode_begin 失败");
+        TEST_ASSERT_EQ(vox_http_hpack_encode(enc, blk, ":status", 7, "200", 3, 0), 0, "编码失败");
+        TEST_ASSERT_EQ(vox_http_hpack_encode(enc, blk, "x-trace", 7, "abc", 3, 0), 0, "编码失败");
+        TEST_ASSERT_EQ(vox_http_hpack_encode(enc, blk, "set-cookie", 10, "sid=1", 5,
+                                             VOX_HTTP_HPACK_NEVER_INDEX), 0, "编码失败");
+        TEST_ASSERT_EQ(vox_http_hpack_encode(enc, blk, "content-length", 14, "12", 2,
+                                             VOX_HTTP_HPACK_NO_INDEX), 0, "编码失败");
+        h2_header_list_t l;
+        memset(&l, 0, sizeof(l));
+        TEST_ASSERT_EQ(vox_http_hpack_decode(dec, vox_string_data(blk), vox_string_length(blk),
+                                             h2_collect_header, &l), 0, "解码失败");
+        TEST_ASSERT_EQ(l.count, 4, "头部数量不正确");
+        TEST_ASSERT_STR_EQ(h2_find(&l, ":status"), "200", ":status 不正确");
+        TEST_ASSERT_STR_EQ(h2_find(&l, "x-trace"), "abc", "x-trace 不正确");
+        TEST_ASSERT_STR_EQ(h2_find(&l, "set-cookie"), "sid=1", "set-cookie 不正确");
+        TEST_ASSERT_STR_EQ(h2_find(&l, "content-length"), "12", "content-length 不正确");
+        /* 只有 x-trace 进入动态表；第二轮完全命中，编码为 1 字节索引 */
+        TEST_ASSERT_EQ(vox_http_hpack_table_count(enc), 1, "编码器动态表条目数不正确");
+        TEST_ASSERT_EQ(vox_http_hpack_table_count(dec), 1, "解码器动态表条目数不正确");
+    }
+
+    /* 对端把表大小降为0：下一个头部块以大小更新开头，双方清空动态表 */
+    vox_http_hpack_set_max_table_size(enc, 0);
+    vox_string_clear(blk);
+    TEST_ASSERT_EQ(vox_http_hpack_encode_begin(enc, blk), 0, "encode_begin 失败");
+    TEST_ASSERT_EQ(((const uint8_t*)vox_string_data(blk))[0], 0x20, "应先输出表大小更新");
+    TEST_ASSERT_EQ(vox_http_hpack_encode(enc, blk, "x-trace", 7, "abc", 3, 0), 0, "编码失败");
+    h2_header_list_t l;
+    memset(&l, 0, sizeof(l));
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, vox_string_data(blk), vox_string_length(blk),
+                                         h2_collect_header, &l), 0, "解码失败");
+    TEST_ASSERT_EQ(vox_http_hpack_table_count(enc), 0, "编码器动态表应为空");
+    TEST_ASSERT_EQ(vox_http_hpack_table_count(dec), 0, "解码器动态表应为空");
+
+    /* 表大小更新超过本端设置 */
+    uint8_t too_big[] = { 0x3f, 0xe2, 0x1f }; /* 4097 */
+    TEST_ASSERT_EQ(vox_http_hpack_decode(dec, too_big, sizeof(too_big), h2_collect_header, &l), -1,
+                   "超限的表大小更新应失败");
+
+    vox_string_destroy(blk);
+    vox_http_hpack_destroy(enc);
+    vox_http_hpack_destroy(dec);
+}
+
+/* ===== 会话 ===== */
+
+typedef struct {
+    vox_mpool_t* mpool;
+    vox_string_t* out;
+    vox_http_hpack_t* dec;
+} h2_peer_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t flags;
+    uint32_t sid;
+    const uint8_t* payload;
+    size_t len;
+} h2_frame_t;
+
+static int h2_capture(void* user_data, const void* data, size_t len) {
+    h2_peer_t* p = (h2_peer_t*)user_data;
+    return vox_string_append_data(p->out, data, len);
+}
+
+static size_t h2_put_frame(uint8_t* dst, uint8_t type, uint8_t flags, uint32_t sid, const void* payload, size_t len) {
+    dst[0] = (uint8_t)(len >> 16);
+    dst[1] = (uint8_t)(len >> 8);
+    dst[2] = (uint8_t)len;
+    dst[3] = type;
+    dst[4] = flags;
+    dst[5] = (uint8_t)(sid >> 24);
+    dst[6] = (uint8_t)(sid >> 16);
+    dst[7] = (uint8_t)(sid >> 8);
+    dst[8] = (uint8_t)sid;
+    if (len > 0) memcpy(dst + 9, payload, len);
+    return 9 + len;
+}
+
+/* 取出 out 中的下一个帧（pos 为游标） */
+static bool h2_next_frame(h2_peer_t* p, size_t* pos, h2_frame_t* f) {
+    const uint8_t* d = (const uint8_t*)vox_string_data(p->out);
+    size_t len = vox_string_length(p->out);
+    if (*pos + 9 > len) return false;
+    const uint8_t* h = d + *pos;
+    f->len = ((size_t)h[0] << 16) | ((size_t)h[1] << 8) | h[2];
+    f->type = h[3];
+    f->flags = h[4];
+    f->sid = (((uint32_t)h[5] & 0x7f) << 24) | ((uint32_t)h[6] << 16) | ((uint32_t)h[7] << 8) | h[8];
+    f->payload = h + 9;
+    if (*pos + 9 + f->len > len) return false;
+    *pos += 9 + f->len;
+    return true;
+}
+
+/* 请求头部块：GET/POST + path，使用静态表与字面量 */
+static size_t h2_request_block(vox_http_hpack_t* enc, vox_mpool_t* mpool, const char* method,
+                               const char* path, uint8_t* out) {
+    vox_string_t* blk = vox_string_create(mpool);
+    vox_http_hpack_encode_begin(enc, blk);
+    vox_http_hpack_encode(enc, blk, ":method", 7, method, strlen(method), 0);
+    vox_http_hpack_encode(enc, blk, ":scheme", 7, "http", 4, 0);
+    vox_http_hpack_encode(enc, blk, ":path", 5, path, strlen(path), 0);
+    vox_http_hpack_encode(enc, blk, ":authority", 10, "example.com", 11, 0);
+    vox_http_hpack_encode(enc, blk, "cookie", 6, "a=1", 3, 0);
+    vox_http_hpack_encode(enc, blk, "cookie", 6, "b=2", 3, 0);
+    size_t n = vox_string_length(blk);
+    memcpy(out, vox_string_data(blk), n);
+    vox_string_destroy(blk);
+    return n;
+}
+
+static vox_http_context_t* g_h2_deferred;
+
+static void h2_hello_handler(vox_http_context_t* ctx) {
+    const vox_http_request_t* req = vox_http_context_request(ctx);
+    char buf[128];
+    vox_strview_t host = vox_http_context_get_header(ctx, "Host");
+    vox_strview_t cookie = vox_http_context_get_header(ctx, "Cookie");
+    snprintf(buf, sizeof(buf), "v=%d host=%.*s cookie=%.*s", req->http_major,
+             (int)host.len, host.ptr ? host.ptr : "", (int)cookie.len, cookie.ptr ? cookie.ptr : "");
+    vox_http_context_header(ctx, "X-Custom", "yes");
+    vox_http_context_header(ctx, "Connection", "keep-alive"); /* 连接相关头部不会出现在 HTTP/2 响应中 */
+    vox_http_context_write_cstr(ctx, buf);
+}
+
+static void h2_echo_handler(vox_http_context_t* ctx) {
+    const vox_http_request_t* req = vox_http_context_request(ctx);
+    vox_http_context_status(ctx, 201);
+    if (req->body) vox_http_context_write(ctx, vox_string_data(req->body), vox_string_length(req->body));
+}
+
+static void h2_big_handler(vox_http_context_t* ctx) {
+    char body[100];
+    for (size_t i = 0; i < sizeof(body); i++) body[i] = (char)('a' + i % 26);
+    vox_http_context_write(ctx, body, sizeof(body));
+}
+
+static void h2_defer_handler(vox_http_context_t* ctx) {
+    vox_http_context_defer(ctx);
+    g_h2_deferred = ctx;
+}
+
+static vox_http_engine_t* h2_test_engine(vox_loop_t* loop) {
+    static vox_http_handler_cb hello[] = { h2_hello_handler };
+    static vox_http_handler_cb echo[] = { h2_echo_handler };
+    static vox_http_handler_cb big[] = { h2_big_handler };
+    static vox_http_handler_cb deferh[] = { h2_defer_handler };
+    vox_http_engine_t* engine = vox_http_engine_create(loop);
+    if (!engine) return NULL;
+    vox_http_engine_get(engine, "/hello", hello, 1);
+    vox_http_engine_post(engine, "/echo", echo, 1);
+    vox_http_engine_get(engine, "/big", big, 1);
+    vox_http_engine_get(engine, "/defer", deferh, 1);
+    return engine;
+}
+
+static void test_http2_session_requests(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    vox_http_engine_t* engine = h2_test_engine(loop);
+    TEST_ASSERT_NOT_NULL(engine, "创建 engine 失败");
+
+    h2_peer_t peer = { mpool, vox_string_create(mpool), vox_http_hpack_create(mpool, 4096) };
+    vox_http_hpack_t* enc = vox_http_hpack_create(mpool, 4096);
+    vox_http2_session_t* s = vox_http2_session_create(mpool, engine, NULL, h2_capture, &peer);
+    TEST_ASSERT_NOT_NULL(s, "创建会话失败");
+
+    /* 服务端连接前言：SETTINGS 在创建时即输出 */
+    size_t pos = 0;
+    h2_frame_t f;
+    TEST_ASSERT_TRUE(h2_next_frame(&peer, &pos, &f), "缺少服务端 SETTINGS");
+    TEST_ASSERT_EQ(f.type, VOX_HTTP2_FRAME_SETTINGS, "第一个帧应为 SETTINGS");
+
+    /* 前言 + SETTINGS + 流1 GET /hello + 流3 POST /echo（两个 DATA 帧）+ 流5 未命中路由 */
+    uint8_t in[1024];
+    uint8_t blk[256];
+    size_t n = 0;
+    memcpy(in, VOX_HTTP2_PREFACE, VOX_HTTP2_PREFACE_LEN);
+    n += VOX_HTTP2_PREFACE_LEN;
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_SETTINGS, 0, 0, NULL, 0);
+    size_t bl = h2_request_block(enc, mpool, "GET", "/hello?x=1", blk);
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_HEADERS, VOX_HTTP2_FLAG_END_HEADERS | VOX_HTTP2_FLAG_END_STREAM, 1, blk, bl);
+    bl = h2_request_block(enc, mpool, "POST", "/echo", blk);
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_HEADERS, VOX_HTTP2_FLAG_END_HEADERS, 3, blk, bl);
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_DATA, 0, 3, "ping-", 5);
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_DATA, VOX_HTTP2_FLAG_END_STREAM, 3, "pong", 4);
+    bl = h2_request_block(enc, mpool, "GET", "/missing", blk);
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_HEADERS, VOX_HTTP2_FLAG_END_HEADERS | VOX_HTTP2_FLAG_END_STREAM, 5, blk, bl);
+
+    /* 分两次喂入，覆盖帧跨读取的情况 */
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in, 30), 0, "feed 失败");
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in + 30, n - 30), 0, "feed 失败");
+
+    char bodies[6][128];
+    memset(bodies, 0, sizeof(bodies));
+    h2_header_list_t heads[6];
+    memset(heads, 0, sizeof(heads));
+    bool ended[6] = { false };
+    bool settings_ack = false;
+    while (h2_next_frame(&peer, &pos, &f)) {
+        if (f.type == VOX_HTTP2_FRAME_SETTINGS && (f.flags & VOX_HTTP2_FLAG_ACK)) settings_ack = true;
+        if (f.sid == 0 || f.sid > 5) continue;
+        if (f.type == VOX_HTTP2_FRAME_HEADERS) {
+            TEST_ASSERT_EQ(vox_http_hpack_decode(peer.dec, f.payload, f.len, h2_collect_header, &heads[f.sid]), 0,
+                           "响应头部解码失败");
+        } else if (f.type == VOX_HTTP2_FRAME_DATA) {
+            strncat(bodies[f.sid], (const char*)f.payload, f.len);
+        }
+        if ((f.type == VOX_HTTP2_FRAME_HEADERS || f.type == VOX_HTTP2_FRAME_DATA) &&
+            (f.flags & VOX_HTTP2_FLAG_END_STREAM)) {
+            ended[f.sid] = true;
+        }
+    }
+    TEST_ASSERT_TRUE(settings_ack, "应确认客户端 SETTINGS");
+    TEST_ASSERT_TRUE(ended[1] && ended[3] && ended[5], "所有流都应结束");
+    TEST_ASSERT_STR_EQ(h2_find(&heads[1], ":status"), "200", "流1 状态不正确");
+    TEST_ASSERT_STR_EQ(h2_find(&heads[1], "x-custom"), "yes", "响应头应转为小写");
+    TEST_ASSERT_NULL(h2_find(&heads[1], "connection"), "不应输出连接相关头部");
+    TEST_ASSERT_STR_EQ(bodies[1], "v=2 host=example.com cookie=a=1; b=2", "流1 响应体不正确");
+    TEST_ASSERT_STR_EQ(h2_find(&heads[1], "content-length"), "36", "content-length 不正确");
+    TEST_ASSERT_STR_EQ(h2_find(&heads[3], ":status"), "201", "流3 状态不正确");
+    TEST_ASSERT_STR_EQ(bodies[3], "ping-pong", "请求体不正确");
+    TEST_ASSERT_STR_EQ(h2_find(&heads[5], ":status"), "404", "未命中路由应返回 404");
+    TEST_ASSERT_EQ(vox_http2_session_stream_count(s), 0, "完成的流应已释放");
+
+    /* PING 回显 */
+    vox_string_clear(peer.out);
+    pos = 0;
+    n = h2_put_frame(in, VOX_HTTP2_FRAME_PING, 0, 0, "12345678", 8);
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in, n), 0, "feed PING 失败");
+    TEST_ASSERT_TRUE(h2_next_frame(&peer, &pos, &f), "缺少 PING ACK");
+    TEST_ASSERT_TRUE(f.type == VOX_HTTP2_FRAME_PING && (f.flags & VOX_HTTP2_FLAG_ACK), "应回复 PING ACK");
+    TEST_ASSERT_EQ(memcmp(f.payload, "12345678", 8), 0, "PING 负载不正确");
+
+    vox_http2_session_destroy(s);
+    vox_http_hpack_destroy(enc);
+    vox_http_hpack_destroy(peer.dec);
+    vox_string_destroy(peer.out);
+    vox_http_engine_destroy(engine);
+    vox_loop_destroy(loop);
+}
+
+static void test_http2_session_flow_control(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    vox_http_engine_t* engine = h2_test_engine(loop);
+    TEST_ASSERT_NOT_NULL(engine, "创建 engine 失败");
+
+    h2_peer_t peer = { mpool, vox_string_create(mpool), vox_http_hpack_create(mpool, 4096) };
+    vox_http_hpack_t* enc = vox_http_hpack_create(mpool, 4096);
+    vox_http2_session_t* s = vox_http2_session_create(mpool, engine, NULL, h2_capture, &peer);
+    TEST_ASSERT_NOT_NULL(s, "创建会话失败");
+
+    /* 客户端初始窗口 30 字节：100 字节响应体先只能发出 30 字节 */
+    uint8_t in[512];
+    uint8_t blk[256];
+    size_t n = 0;
+    memcpy(in, VOX_HTTP2_PREFACE, VOX_HTTP2_PREFACE_LEN);
+    n += VOX_HTTP2_PREFACE_LEN;
+    uint8_t settings[6] = { 0x00, VOX_HTTP2_SETTINGS_INITIAL_WINDOW_SIZE, 0, 0, 0, 30 };
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_SETTINGS, 0, 0, settings, sizeof(settings));
+    size_t bl = h2_request_block(enc, mpool, "GET", "/big", blk);
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_HEADERS, VOX_HTTP2_FLAG_END_HEADERS | VOX_HTTP2_FLAG_END_STREAM, 1, blk, bl);
+    vox_string_clear(peer.out);
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in, n), 0, "feed 失败");
+
+    size_t pos = 0;
+    size_t data_len = 0;
+    bool ended = false;
+    h2_frame_t f;
+    while (h2_next_frame(&peer, &pos, &f)) {
+        if (f.type == VOX_HTTP2_FRAME_DATA && f.sid == 1) {
+            data_len += f.len;
+            if (f.flags & VOX_HTTP2_FLAG_END_STREAM) ended = true;
+        }
+    }
+    TEST_ASSERT_EQ(data_len, 30, "应只发送窗口允许的字节");
+    TEST_ASSERT_FALSE(ended, "窗口耗尽时流不应结束");
+    TEST_ASSERT_EQ(vox_http2_session_stream_count(s), 1, "流应仍在发送中");
+
+    /* 窗口更新 50：再发 50 字节；再更新 20：发完并结束 */
+    uint8_t inc50[4] = { 0, 0, 0, 50 };
+    uint8_t inc20[4] = { 0, 0, 0, 20 };
+    n = h2_put_frame(in, VOX_HTTP2_FRAME_WINDOW_UPDATE, 0, 1, inc50, 4);
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in, n), 0, "feed WINDOW_UPDATE 失败");
+    n = h2_put_frame(in, VOX_HTTP2_FRAME_WINDOW_UPDATE, 0, 1, inc20, 4);
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in, n), 0, "feed WINDOW_UPDATE 失败");
+    while (h2_next_frame(&peer, &pos, &f)) {
+        if (f.type == VOX_HTTP2_FRAME_DATA && f.sid == 1) {
+            data_len += f.len;
+            if (f.flags & VOX_HTTP2_FLAG_END_STREAM) ended = true;
+        }
+    }
+    TEST_ASSERT_EQ(data_len, 100, "响应体长度不正确");
+    TEST_ASSERT_TRUE(ended, "流应结束");
+    TEST_ASSERT_EQ(vox_http2_session_stream_count(s), 0, "完成的流应已释放");
+
+    vox_http2_session_destroy(s);
+    vox_http_hpack_destroy(enc);
+    vox_http_hpack_destroy(peer.dec);
+    vox_string_destroy(peer.out);
+    vox_http_engine_destroy(engine);
+    vox_loop_destroy(loop);
+}
+
+static void test_http2_session_defer(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    vox_http_engine_t* engine = h2_test_engine(loop);
+    TEST_ASSERT_NOT_NULL(engine, "创建 engine 失败");
+
+    h2_peer_t peer = { mpool, vox_string_create(mpool), vox_http_hpack_create(mpool, 4096) };
+    vox_http_hpack_t* enc = vox_http_hpack_create(mpool, 4096);
+    vox_http2_session_t* s = vox_http2_session_create(mpool, engine, NULL, h2_capture, &peer);
+    TEST_ASSERT_NOT_NULL(s, "创建会话失败");
+
+    /* 流1 defer，流3 随后立即完成：defer 不阻塞同连接上的其他流 */
+    uint8_t in[512];
+    uint8_t blk[256];
+    size_t n = 0;
+    memcpy(in, VOX_HTTP2_PREFACE, VOX_HTTP2_PREFACE_LEN);
+    n += VOX_HTTP2_PREFACE_LEN;
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_SETTINGS, 0, 0, NULL, 0);
+    size_t bl = h2_request_block(enc, mpool, "GET", "/defer", blk);
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_HEADERS, VOX_HTTP2_FLAG_END_HEADERS | VOX_HTTP2_FLAG_END_STREAM, 1, blk, bl);
+    bl = h2_request_block(enc, mpool, "GET", "/hello", blk);
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_HEADERS, VOX_HTTP2_FLAG_END_HEADERS | VOX_HTTP2_FLAG_END_STREAM, 3, blk, bl);
+    g_h2_deferred = NULL;
+    vox_string_clear(peer.out);
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in, n), 0, "feed 失败");
+    TEST_ASSERT_NOT_NULL(g_h2_deferred, "handler 应已 defer");
+    TEST_ASSERT_EQ(vox_http2_session_stream_count(s), 1, "只有 defer 的流仍存活");
+
+    size_t pos = 0;
+    h2_frame_t f;
+    bool got1 = false;
+    bool got3 = false;
+    while (h2_next_frame(&peer, &pos, &f)) {
+        if (f.type == VOX_HTTP2_FRAME_HEADERS && f.sid == 1) got1 = true;
+        if (f.type == VOX_HTTP2_FRAME_HEADERS && f.sid == 3) got3 = true;
+    }
+    TEST_ASSERT_FALSE(got1, "defer 的流在 finish 前不应响应");
+    TEST_ASSERT_TRUE(got3, "其他流应正常响应");
+
+    vox_http_context_write_cstr(g_h2_deferred, "later");
+    TEST_ASSERT_EQ(vox_http_context_finish(g_h2_deferred), 0, "finish 失败");
+    size_t data_len = 0;
+    while (h2_next_frame(&peer, &pos, &f)) {
+        if (f.type == VOX_HTTP2_FRAME_HEADERS && f.sid == 1) got1 = true;
+        if (f.type == VOX_HTTP2_FRAME_DATA && f.sid == 1) data_len += f.len;
+    }
+    TEST_ASSERT_TRUE(got1, "finish 后应输出响应");
+    TEST_ASSERT_EQ(data_len, 5, "defer 响应体不正确");
+    TEST_ASSERT_EQ(vox_http2_session_stream_count(s), 0, "完成的流应已释放");
+
+    vox_http2_session_destroy(s);
+    vox_http_hpack_destroy(enc);
+    vox_http_hpack_destroy(peer.dec);
+    vox_string_destroy(peer.out);
+    vox_http_engine_destroy(engine);
+    vox_loop_destroy(loop);
+}
+
+static void test_http2_session_errors(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    vox_http_engine_t* engine = h2_test_engine(loop);
+    TEST_ASSERT_NOT_NULL(engine, "创建 engine 失败");
+    h2_peer_t peer = { mpool, vox_string_create(mpool), NULL };
+    uint8_t in[256];
+    size_t pos;
+    h2_frame_t f;
+    bool goaway;
+
+    /* 错误的连接前言 */
+    vox_http2_session_t* s = vox_http2_session_create(mpool, engine, NULL, h2_capture, &peer);
+    TEST_ASSERT_NOT_NULL(s, "创建会话失败");
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, "GET / HTTP/1.1\r\n\r\n", 18), -1, "错误的前言应失败");
+    TEST_ASSERT_TRUE(vox_http2_session_want_close(s), "连接错误后应关闭");
+    pos = 0;
+    goaway = false;
+    while (h2_next_frame(&peer, &pos, &f)) {
+        if (f.type == VOX_HTTP2_FRAME_GOAWAY) goaway = true;
+    }
+    TEST_ASSERT_TRUE(goaway, "应发出 GOAWAY");
+    vox_http2_session_destroy(s);
+
+    /* 前言后的第一个帧不是 SETTINGS */
+    vox_string_clear(peer.out);
+    s = vox_http2_session_create(mpool, engine, NULL, h2_capture, &peer);
+    TEST_ASSERT_NOT_NULL(s, "创建会话失败");
+    size_t n = 0;
+    memcpy(in, VOX_HTTP2_PREFACE, VOX_HTTP2_PREFACE_LEN);
+    n += VOX_HTTP2_PREFACE_LEN;
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_PING, 0, 0, "12345678", 8);
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in, n), -1, "缺少 SETTINGS 应失败");
+    pos = 0;
+    goaway = false;
+    while (h2_next_frame(&peer, &pos, &f)) {
+        if (f.type == VOX_HTTP2_FRAME_GOAWAY) {
+            goaway = true;
+            TEST_ASSERT_EQ(f.payload[7], VOX_HTTP2_PROTOCOL_ERROR, "错误码应为 PROTOCOL_ERROR");
+        }
+    }
+    TEST_ASSERT_TRUE(goaway, "应发出 GOAWAY");
+    vox_http2_session_destroy(s);
+
+    /* 偶数流 ID 与连接级窗口溢出 */
+    vox_string_clear(peer.out);
+    s = vox_http2_session_create(mpool, engine, NULL, h2_capture, &peer);
+    TEST_ASSERT_NOT_NULL(s, "创建会话失败");
+    n = 0;
+    memcpy(in, VOX_HTTP2_PREFACE, VOX_HTTP2_PREFACE_LEN);
+    n += VOX_HTTP2_PREFACE_LEN;
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_SETTINGS, 0, 0, NULL, 0);
+    uint8_t inc[4] = { 0x7f, 0xff, 0xff, 0xff };
+    n += h2_put_frame(in + n, VOX_HTTP2_FRAME_WINDOW_UPDATE, 0, 0, inc, 4);
+    TEST_ASSERT_EQ(vox_http2_session_feed(s, in, n), -1, "窗口溢出应失败");
+    pos = 0;
+    goaway = false;
+    while (h2_next_frame(&peer, &pos, &f)) {
+        if (f.type == VOX_HTTP2_FRAME_GOAWAY) {
+            goaway = true;
+            TEST_ASSERT_EQ(f.payload[7], VOX_HTTP2_FLOW_CONTROL_ERROR, "错误码应为 FLOW_CONTROL_ERROR");
+        }
+    }
+    TEST_ASSERT_TRUE(goaway, "应发出 GOAWAY");
+    vox_http2_session_destroy(s);
+
+    vox_string_destroy(peer.out);
+    vox_http_engine_destroy(engine);
+    vox_loop_destroy(loop);
+}
+
+test_case_t test_http2_cases[] = {
+    {"hpack_rfc_no_huffman", test_hpack_rfc_no_huffman},
+    {"hpack_rfc_huffman", test_hpack_rfc_huffman},
+    {"hpack_roundtrip", test_hpack_roundtrip},
+    {"session_requests", test_http2_session_requests},
+    {"session_flow_control", test_http2_session_flow_control},
+    {"session_defer", test_http2_session_defer},
+    {"session_errors", test_http2_session_errors},
+};
+
+test_suite_t test_http2_suite = {
+    "http2",
+    test_http2_cases,
+    sizeof(test_http2_cases) / sizeof(test_http2_cases[0])
+};
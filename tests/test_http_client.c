@@ -0,0 +1,366 @@
+/* ============================================================
+ * test_http_client.c - vox_http_client 连接池测试
+ * 桩服务端（vox_tcp）与客户端运行在同一事件循环中，
+ * 统计 accept 次数与连接关闭，检查连接复用、空闲清理、每主机上限与 EOF 结束的响应体
+ * ============================================================ */
+
+#include "test_runner.h"
+
+#include "../vox_loop.h"
+#include "../vox_tcp.h"
+#include "../vox_timer.h"
+#include "../vox_socket.h"
+#include "../vox_string.h"
+#include "../vox_time.h"
+
+#include "../http/vox_http_client.h"
+
+#include <string.h>
+#include <stdio.h>
+
+/* 桩服务端响应方式 */
+typedef enum {
+    STUB_KEEP_ALIVE = 0,   /* Content-Length 响应，保持连接 */
+    STUB_SPLIT,            /* 响应头与响应体分两次写出（客户端分两次读到） */
+    STUB_EOF               /* 无 Content-Length，写完后关闭连接（以 EOF 结束响应体） */
+} stub_mode_t;
+
+typedef struct client_stub client_stub_t;
+
+typedef struct {
+    client_stub_t* stub;
+    vox_tcp_t* tcp;
+    vox_timer_t timer;
+    size_t scanned;        /* 已检查过的请求字节数 */
+    vox_string_t* in;
+} stub_conn_t;
+
+struct client_stub {
+    vox_loop_t* loop;
+    vox_mpool_t* mpool;
+    vox_tcp_t* listener;
+    stub_mode_t mode;
+    int accepts;
+    int requests;
+    int closed;            /* 客户端关闭的连接数 */
+    char url[64];
+};
+
+static const char k_resp_full[] = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+static const char k_resp_head[] = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n";
+static const char k_resp_body[] = "ok";
+static const char k_resp_eof[] = "HTTP/1.1 200 OK\r\n\r\nok";
+
+/* vox_handle_close 只标记关闭，销毁句柄才会关闭 socket（对端才能读到 EOF） */
+static void stub_on_closed(vox_handle_t* handle) {
+    vox_tcp_destroy((vox_tcp_t*)handle);
+}
+
+static void stub_close_after_write_cb(vox_tcp_t* tcp, int status, void* user_data) {
+    VOX_UNUSED(status);
+    VOX_UNUSED(user_data);
+    vox_handle_close((vox_handle_t*)tcp, stub_on_closed);
+}
+
+static void stub_split_timer_cb(vox_timer_t* timer, void* user_data) {
+    VOX_UNUSED(timer);
+    stub_conn_t* sc = (stub_conn_t*)user_data;
+    vox_tcp_write(sc->tcp, k_resp_body, sizeof(k_resp_body) - 1, NULL);
+}
+
+static void stub_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void* user_data) {
+    stub_conn_t* sc = (stub_conn_t*)user_data;
+    client_stub_t* stub = sc->stub;
+    if (nread <= 0) {
+        stub->closed++;
+        vox_timer_destroy(&sc->timer);
+        vox_handle_close((vox_handle_t*)tcp, stub_on_closed);
+        return;
+    }
+    vox_string_append_data(sc->in, buf, (size_t)nread);
+
+    /* 每个 "\r\n\r\n" 是一个完整的（无请求体）请求 */
+    const char* data = (const char*)vox_string_data(sc->in);
+    size_t len = vox_string_length(sc->in);
+    while (sc->scanned + 4 <= len) {
+        const char* end = strstr(data + sc->scanned, "\r\n\r\n");
+        if (!end) break;
+        sc->scanned = (size_t)(end - data) + 4;
+        stub->requests++;
+        if (stub->mode == STUB_EOF) {
+            vox_tcp_write(tcp, k_resp_eof, sizeof(k_resp_eof) - 1, stub_close_after_write_cb);
+        } else if (stub->mode == STUB_SPLIT) {
+            vox_tcp_write(tcp, k_resp_head, sizeof(k_resp_head) - 1, NULL);
+            vox_timer_start(&sc->timer, 20, 0, stub_split_timer_cb, sc);
+        } else {
+            vox_tcp_write(tcp, k_resp_full, sizeof(k_resp_full) - 1, NULL);
+        }
+    }
+}
+
+static void stub_connection_cb(vox_tcp_t* server, int status, void* user_data) {
+    client_stub_t* stub = (client_stub_t*)user_data;
+    if (status != 0) return;
+    stub_conn_t* sc = (stub_conn_t*)vox_mpool_alloc(stub->mpool, sizeof(stub_conn_t));
+    if (!sc) return;
+    memset(sc, 0, sizeof(*sc));
+    sc->stub = stub;
+    sc->in = vox_string_create(stub->mpool);
+    sc->tcp = vox_tcp_create(stub->loop);
+    if (!sc->in || !sc->tcp || vox_tcp_accept(server, sc->tcp) != 0) {
+        if (sc->tcp) vox_tcp_destroy(sc->tcp);
+        return;
+    }
+    vox_timer_init(&sc->timer, stub->loop);
+    vox_handle_set_data((vox_handle_t*)sc->tcp, sc);
+    vox_tcp_read_start(sc->tcp, NULL, stub_read_cb);
+    stub->accepts++;
+}
+
+static int stub_start(vox_loop_t* loop, vox_mpool_t* mpool, client_stub_t* stub, stub_mode_t mode) {
+    memset(stub, 0, sizeof(*stub));
+    stub->loop = loop;
+    stub->mpool = mpool;
+    stub->mode = mode;
+    vox_socket_addr_t addr;
+    vox_socket_parse_address("127.0.0.1", 0, &addr);
+    stub->listener = vox_tcp_create(loop);
+    if (!stub->listener) return -1;
+    vox_handle_set_data((vox_handle_t*)stub->listener, stub);
+    if (vox_tcp_bind(stub->listener, &addr, 0) != 0 || vox_tcp_getsockname(stub->listener, &addr) != 0 ||
+        vox_tcp_listen(stub->listener, 16, stub_connection_cb) != 0) {
+        return -1;
+    }
+    snprintf(stub->url, sizeof(stub->url), "http://127.0.0.1:%u/", (unsigned)vox_socket_get_port(&addr));
+    return 0;
+}
+
+/* 单个请求的结果 */
+typedef struct {
+    int done;              /* 1 完成，-1 出错 */
+    char body[16];
+    size_t body_len;
+} client_result_t;
+
+static void result_body_cb(vox_http_client_req_t* req, const void* data, size_t len, void* user_data) {
+    VOX_UNUSED(req);
+    client_result_t* res = (client_result_t*)user_data;
+    if (res->body_len + len < sizeof(res->body)) {
+        memcpy(res->body + res->body_len, data, len);
+        res->body_len += len;
+    }
+}
+
+static void result_complete_cb(vox_http_client_req_t* req, int status, void* user_data) {
+    VOX_UNUSED(req);
+    VOX_UNUSED(status);
+    ((client_result_t*)user_data)->done = 1;
+}
+
+static void result_error_cb(vox_http_client_req_t* req, const char* message, void* user_data) {
+    VOX_UNUSED(req);
+    VOX_UNUSED(message);
+    ((client_result_t*)user_data)->done = -1;
+}
+
+static int client_get_req(vox_http_client_t* client, const client_stub_t* stub, client_result_t* res,
+                          vox_http_client_req_t** out_req) {
+    vox_http_client_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.method = VOX_HTTP_METHOD_GET;
+    request.url = stub->url;
+    vox_http_client_callbacks_t cbs;
+    memset(&cbs, 0, sizeof(cbs));
+    cbs.on_body = result_body_cb;
+    cbs.on_complete = result_complete_cb;
+    cbs.on_error = result_error_cb;
+    memset(res, 0, sizeof(*res));
+    return vox_http_client_request(client, &request, &cbs, res, out_req);
+}
+
+static int client_get(vox_http_client_t* client, const client_stub_t* stub, client_result_t* res) {
+    return client_get_req(client, stub, res, NULL);
+}
+
+/* 运行 loop 直到 cond(arg) 为真或超过 2 秒 */
+static void client_run_until(vox_loop_t* loop, bool (*cond)(const void* arg), const void* arg) {
+    vox_time_t start = vox_time_monotonic();
+    while (!cond(arg) && vox_time_diff_us(vox_time_monotonic(), start) < 2000000) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+    }
+}
+
+static bool result_is_done(const void* arg) {
+    return ((const client_result_t*)arg)->done != 0;
+}
+
+static bool stub_has_closed(const void* arg) {
+    return ((const client_stub_t*)arg)->closed > 0;
+}
+
+static void client_test_stop(vox_loop_t* loop, vox_http_client_t* client, client_stub_t* stub) {
+    vox_http_client_destroy(client);
+    vox_handle_close((vox_handle_t*)stub->listener, NULL);
+    /* 处理关闭回调，释放连接 */
+    for (int i = 0; i < 20; i++) {
+        vox_loop_run(loop, VOX_RUN_NOWAIT);
+    }
+    vox_loop_destroy(loop);
+}
+
+/* 测试顺序请求复用同一连接（含响应跨两次读取的情况） */
+static void test_http_client_pool_reuse(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    client_stub_t stub;
+    TEST_ASSERT_EQ(stub_start(loop, mpool, &stub, STUB_KEEP_ALIVE), 0, "启动桩服务端失败");
+    vox_http_client_t* client = vox_http_client_create(loop);
+    TEST_ASSERT_NOT_NULL(client, "创建客户端失败");
+
+    client_result_t res;
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQ(client_get(client, &stub, &res), 0, "发起请求失败");
+        client_run_until(loop, result_is_done, &res);
+        TEST_ASSERT_EQ(res.done, 1, "请求应完成");
+        TEST_ASSERT_EQ(vox_http_client_idle_count(client), 1, "完成后连接应放回连接池");
+    }
+    TEST_ASSERT_EQ(stub.accepts, 1, "顺序请求应复用同一连接");
+
+    /* 响应头与响应体分两次到达：解析器缓存的字节不能被重复计入 */
+    stub.mode = STUB_SPLIT;
+    TEST_ASSERT_EQ(client_get(client, &stub, &res), 0, "发起请求失败");
+    client_run_until(loop, result_is_done, &res);
+    TEST_ASSERT_EQ(res.done, 1, "分段响应应完成");
+    TEST_ASSERT_EQ(res.body_len, 2, "分段响应体长度不正确");
+    TEST_ASSERT_EQ(vox_http_client_idle_count(client), 1, "分段响应后连接应放回连接池");
+    TEST_ASSERT_EQ(stub.accepts, 1, "分段响应仍应复用同一连接");
+    TEST_ASSERT_EQ(stub.requests, 3, "请求数不正确");
+
+    client_test_stop(loop, client, &stub);
+}
+
+/* 测试连接池属于 loop：同一 loop 上的两个 client 复用同一空闲连接，销毁 client 不关闭它 */
+static void test_http_client_pool_shared(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    client_stub_t stub;
+    TEST_ASSERT_EQ(stub_start(loop, mpool, &stub, STUB_KEEP_ALIVE), 0, "启动桩服务端失败");
+    vox_http_client_t* first = vox_http_client_create(loop);
+    vox_http_client_t* second = vox_http_client_create(loop);
+    TEST_ASSERT_TRUE(first && second, "创建客户端失败");
+
+    client_result_t res;
+    TEST_ASSERT_EQ(client_get(first, &stub, &res), 0, "发起请求失败");
+    client_run_until(loop, result_is_done, &res);
+    TEST_ASSERT_EQ(res.done, 1, "请求应完成");
+    vox_http_client_destroy(first);
+    TEST_ASSERT_EQ(vox_http_client_idle_count(second), 1, "空闲连接应留在 loop 的连接池中");
+
+    TEST_ASSERT_EQ(client_get(second, &stub, &res), 0, "发起请求失败");
+    client_run_until(loop, result_is_done, &res);
+    TEST_ASSERT_EQ(res.done, 1, "请求应完成");
+    TEST_ASSERT_EQ(stub.accepts, 1, "另一个 client 应复用同一连接");
+    TEST_ASSERT_EQ(stub.requests, 2, "请求数不正确");
+    TEST_ASSERT_EQ(vox_http_client_idle_count(second), 1, "完成后连接应放回连接池");
+
+    client_test_stop(loop, second, &stub);
+}
+
+/* 测试以 EOF 结束的响应体：连接已被对端关闭，客户端应关闭 transport 而不是放回连接池 */
+static void test_http_client_eof_body(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    client_stub_t stub;
+    TEST_ASSERT_EQ(stub_start(loop, mpool, &stub, STUB_EOF), 0, "启动桩服务端失败");
+    vox_http_client_t* client = vox_http_client_create(loop);
+    TEST_ASSERT_NOT_NULL(client, "创建客户端失败");
+    size_t baseline = vox_loop_active_handles(loop);
+
+    client_result_t res;
+    vox_http_client_req_t* req = NULL;
+    TEST_ASSERT_EQ(client_get_req(client, &stub, &res, &req), 0, "发起请求失败");
+    client_run_until(loop, result_is_done, &res);
+    TEST_ASSERT_EQ(res.done, 1, "EOF 结束的响应应完成");
+    TEST_ASSERT_EQ(res.body_len, 2, "响应体长度不正确");
+    TEST_ASSERT_EQ(vox_http_client_idle_count(client), 0, "EOF 后的连接不能放回连接池");
+    for (int i = 0; i < 10; i++) {
+        vox_loop_run(loop, VOX_RUN_NOWAIT);
+    }
+    TEST_ASSERT_EQ(vox_loop_active_handles(loop), baseline, "客户端连接应已关闭");
+    /* transport 已在关闭回调中销毁：之后的 close/cancel 不能再访问它 */
+    vox_http_client_close(req);
+    vox_http_client_cancel(req);
+    TEST_ASSERT_EQ(res.done, 1, "已完成的请求不应再报告错误");
+
+    client_test_stop(loop, client, &stub);
+}
+
+/* 测试空闲连接由定时器按 idle_timeout_ms 清理（无需再次 checkout/checkin） */
+static void test_http_client_idle_evict(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    client_stub_t stub;
+    TEST_ASSERT_EQ(stub_start(loop, mpool, &stub, STUB_KEEP_ALIVE), 0, "启动桩服务端失败");
+    vox_http_client_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.idle_timeout_ms = 50;
+    vox_http_client_t* client = vox_http_client_create_with_config(loop, &config);
+    TEST_ASSERT_NOT_NULL(client, "创建客户端失败");
+
+    client_result_t res;
+    TEST_ASSERT_EQ(client_get(client, &stub, &res), 0, "发起请求失败");
+    client_run_until(loop, result_is_done, &res);
+    TEST_ASSERT_EQ(res.done, 1, "请求应完成");
+    TEST_ASSERT_EQ(vox_http_client_idle_count(client), 1, "完成后连接应放回连接池");
+
+    /* 不再发起请求：清理由定时器驱动 */
+    client_run_until(loop, stub_has_closed, &stub);
+    TEST_ASSERT_EQ(vox_http_client_idle_count(client), 0, "超过 idle_timeout_ms 的空闲连接应被清理");
+    TEST_ASSERT_EQ(stub.closed, 1, "服务端应看到连接关闭");
+
+    client_test_stop(loop, client, &stub);
+}
+
+/* 测试每主机空闲连接上限 */
+static void test_http_client_per_host_limit(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    client_stub_t stub;
+    TEST_ASSERT_EQ(stub_start(loop, mpool, &stub, STUB_KEEP_ALIVE), 0, "启动桩服务端失败");
+    vox_http_client_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.max_idle_per_host = 2;
+    vox_http_client_t* client = vox_http_client_create_with_config(loop, &config);
+    TEST_ASSERT_NOT_NULL(client, "创建客户端失败");
+
+    /* 并发请求各自建立连接 */
+    client_result_t res[3];
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQ(client_get(client, &stub, &res[i]), 0, "发起请求失败");
+    }
+    for (int i = 0; i < 3; i++) {
+        client_run_until(loop, result_is_done, &res[i]);
+        TEST_ASSERT_EQ(res[i].done, 1, "请求应完成");
+    }
+    TEST_ASSERT_EQ(stub.accepts, 3, "并发请求应建立三个连接");
+    TEST_ASSERT_EQ(vox_http_client_idle_count(client), 2, "空闲连接数应受每主机上限限制");
+    client_run_until(loop, stub_has_closed, &stub);
+    TEST_ASSERT_EQ(stub.closed, 1, "超出上限的连接应被关闭");
+
+    client_test_stop(loop, client, &stub);
+}
+
+/* 测试套件 */
+test_case_t test_http_client_cases[] = {
+    {"pool_reuse", test_http_client_pool_reuse},
+    {"pool_shared", test_http_client_pool_shared},
+    {"eof_body", test_http_client_eof_body},
+    {"idle_evict", test_http_client_idle_evict},
+    {"per_host_limit", test_http_client_per_host_limit},
+};
+
+test_suite_t test_http_client_suite = {
+    "vox_http_client",
+    test_http_client_cases,
+    sizeof(test_http_client_cases) / sizeof(test_http_client_cases[0])
+};
@@ -0,0 +1,136 @@
+/* ============================================================
+ * test_http_gzip.c - vox_http_gzip 流式压缩与缓存测试
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_loop.h"
+#include "../vox_string.h"
+#include "../http/vox_http_gzip.h"
+#include <stdio.h>
+
+typedef struct {
+    vox_string_t* out;
+    int calls;
+} gzip_sink_ctx_t;
+
+static int sink_append(const void* data, size_t len, void* user_data) {
+    gzip_sink_ctx_t* sc = (gzip_sink_ctx_t*)user_data;
+    sc->calls++;
+    return vox_string_append_data(sc->out, data, len);
+}
+
+/* 测试分片压缩结果可被完整解压，且 z_stream 在 loop 内复用 */
+static void test_gzip_stream_roundtrip(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+
+    /* 低重复度输入，保证压缩输出超过一个内部缓冲区 */
+    vox_string_t* input = vox_string_create(mpool);
+    uint32_t seed = 12345;
+    for (int i = 0; i < 200000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        char c = (char)('a' + (seed >> 16) % 26);
+        vox_string_append_data(input, &c, 1);
+    }
+    const char* data = vox_string_data(input);
+    size_t len = vox_string_length(input);
+
+    gzip_sink_ctx_t sc = { vox_string_create(mpool), 0 };
+    vox_http_gzip_stream_t* zs = vox_http_gzip_stream_acquire(loop);
+    TEST_ASSERT_NOT_NULL(zs, "获取压缩流失败");
+    size_t off = 0;
+    size_t step = 7777;
+    while (off < len) {
+        size_t n = (len - off < step) ? len - off : step;
+        TEST_ASSERT_EQ(vox_http_gzip_stream_write(zs, data + off, n, sink_append, &sc), 0, "分片压缩失败");
+        off += n;
+    }
+    TEST_ASSERT_EQ(vox_http_gzip_stream_finish(zs, sink_append, &sc), 0, "结束压缩失败");
+    vox_http_gzip_stream_release(zs);
+    TEST_ASSERT(sc.calls > 1, "压缩输出应分多段交给 sink");
+
+    vox_string_t* plain = vox_string_create(mpool);
+    TEST_ASSERT_EQ(vox_http_gzip_decompress(mpool, vox_string_data(sc.out), vox_string_length(sc.out), plain), 0,
+                   "解压失败");
+    TEST_ASSERT_EQ(vox_string_length(plain), len, "解压长度不一致");
+    TEST_ASSERT(memcmp(vox_string_data(plain), data, len) == 0, "解压内容不一致");
+
+    /* 第二次获取应复用池中的流，且重置后产出相同结果 */
+    vox_string_clear(sc.out);
+    zs = vox_http_gzip_stream_acquire(loop);
+    TEST_ASSERT_NOT_NULL(zs, "再次获取压缩流失败");
+    TEST_ASSERT_EQ(vox_http_gzip_stream_write(zs, "hello hello hello", 17, sink_append, &sc), 0, "压缩失败");
+    TEST_ASSERT_EQ(vox_http_gzip_stream_finish(zs, sink_append, &sc), 0, "结束压缩失败");
+    vox_http_gzip_stream_release(zs);
+    vox_string_clear(plain);
+    TEST_ASSERT_EQ(vox_http_gzip_decompress(mpool, vox_string_data(sc.out), vox_string_length(sc.out), plain), 0,
+                   "复用流压缩结果解压失败");
+    TEST_ASSERT_EQ(vox_string_length(plain), 17, "复用流解压长度不一致");
+
+    vox_http_gzip_stats_t stats;
+    TEST_ASSERT_EQ(vox_http_gzip_get_stats(loop, &stats), 0, "获取统计失败");
+    TEST_ASSERT_EQ(stats.streams_created, 1, "应只创建一个 z_stream");
+    TEST_ASSERT_EQ(stats.streams_reused, 1, "应复用一次 z_stream");
+
+    vox_string_destroy(plain);
+    vox_string_destroy(sc.out);
+    vox_string_destroy(input);
+    vox_loop_destroy(loop);
+}
+
+/* 测试 ETag 压缩缓存命中与按字节上限 LRU 淘汰 */
+static void test_gzip_etag_cache(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+
+    vox_http_gzip_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.cache_max_bytes = 100;
+    TEST_ASSERT_EQ(vox_http_gzip_configure(loop, &config), 0, "配置失败");
+
+    char payload[60];
+    memset(payload, 'x', sizeof(payload));
+    TEST_ASSERT_EQ(vox_http_gzip_cache_put(loop, "\"a\"", 3, payload, sizeof(payload)), 0, "写入缓存a失败");
+
+    const void* data = NULL;
+    size_t len = 0;
+    TEST_ASSERT_EQ(vox_http_gzip_cache_get(loop, "\"a\"", 3, &data, &len), 0, "缓存a应命中");
+    TEST_ASSERT_EQ(len, sizeof(payload), "缓存长度不正确");
+    TEST_ASSERT_NE(vox_http_gzip_cache_get(loop, "\"b\"", 3, &data, &len), 0, "缓存b不应命中");
+
+    /* 写入b超出 100 字节上限，淘汰最久未使用的a */
+    TEST_ASSERT_EQ(vox_http_gzip_cache_put(loop, "\"b\"", 3, payload, sizeof(payload)), 0, "写入缓存b失败");
+    TEST_ASSERT_NE(vox_http_gzip_cache_get(loop, "\"a\"", 3, &data, &len), 0, "缓存a应被淘汰");
+    TEST_ASSERT_EQ(vox_http_gzip_cache_get(loop, "\"b\"", 3, &data, &len), 0, "缓存b应命中");
+
+    vox_http_gzip_stats_t stats;
+    TEST_ASSERT_EQ(vox_http_gzip_get_stats(loop, &stats), 0, "获取统计失败");
+    TEST_ASSERT_EQ(stats.cache_entries, 1, "缓存项数量不正确");
+    TEST_ASSERT_EQ(stats.cache_bytes, sizeof(payload), "缓存字节数不正确");
+    TEST_ASSERT_EQ(stats.cache_hits, 2, "命中次数不正确");
+
+    /* 单项上限：超过 cache_max_entry_bytes 的响应体不进缓存 */
+    config.cache_max_entry_bytes = 50;
+    TEST_ASSERT_EQ(vox_http_gzip_configure(loop, &config), 0, "配置失败");
+    TEST_ASSERT(vox_http_gzip_cache_accepts(loop, 50), "不超过单项上限应可缓存");
+    TEST_ASSERT(!vox_http_gzip_cache_accepts(loop, 51), "超过单项上限不应缓存");
+    TEST_ASSERT_NE(vox_http_gzip_cache_put(loop, "\"c\"", 3, payload, sizeof(payload)), 0, "超过单项上限的写入应失败");
+    config.disable_cache = true;
+    TEST_ASSERT_EQ(vox_http_gzip_configure(loop, &config), 0, "配置失败");
+    TEST_ASSERT(!vox_http_gzip_cache_accepts(loop, 1), "禁用缓存时不应缓存");
+
+    vox_loop_destroy(loop);
+}
+
+/* 测试套件 */
+test_case_t test_http_gzip_cases[] = {
+    {"stream_roundtrip", test_gzip_stream_roundtrip},
+    {"etag_cache", test_gzip_etag_cache},
+};
+
+test_suite_t test_http_gzip_suite = {
+    "vox_http_gzip",
+    test_http_gzip_cases,
+    sizeof(test_http_gzip_cases) / sizeof(test_http_gzip_cases[0])
+};
@@ -6,6 +6,10 @@
 
 #include "../http/vox_http_context.h"
 #include "../http/vox_http_internal.h" /* 为了构造内部 ctx 结构 */
+#include "../http/vox_http_middleware.h"
+#include "../http/vox_http_engine.h"
+#include "../vox_loop.h"
+#include "../vox_time.h"
 
 static int g_order[16];
 static int g_order_n = 0;
@@ -80,9 +84,124 @@ static void test_middleware_abort(vox_mpool_t* mpool) {
     TEST_ASSERT_EQ(g_order[0], 7, "abort handler 未执行");
 }
 
+/* 测试 GCRA 限流：突发上限、按间隔恢复、键之间互不影响 */
+static void test_middleware_rate_limiter_gcra(vox_mpool_t* mpool) {
+    vox_http_rate_limit_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.max_requests = 5;
+    config.window_ms = 1000;
+    vox_http_rate_limiter_t* rl = vox_http_rate_limiter_create(mpool, &config);
+    TEST_ASSERT_NOT_NULL(rl, "创建限流器失败");
+
+    const uint8_t a[4] = {10, 0, 0, 1};
+    const uint8_t b[4] = {10, 0, 0, 2};
+    int64_t now = (int64_t)vox_time_monotonic();
+    int64_t retry = 0;
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT(vox_http_rate_limiter_allow(rl, a, sizeof(a), now, &retry), "窗口内前5次应放行");
+    }
+    TEST_ASSERT(!vox_http_rate_limiter_allow(rl, a, sizeof(a), now, &retry), "第6次应被限流");
+    TEST_ASSERT_EQ(retry, 200000, "重试等待时间应为一个放行间隔");
+    TEST_ASSERT(vox_http_rate_limiter_allow(rl, b, sizeof(b), now, &retry), "其它键不应受影响");
+
+    /* 经过一个间隔（200ms）恢复一个名额 */
+    TEST_ASSERT(vox_http_rate_limiter_allow(rl, a, sizeof(a), now + 200000, &retry), "间隔后应放行一次");
+    TEST_ASSERT(!vox_http_rate_limiter_allow(rl, a, sizeof(a), now + 200000, &retry), "名额应再次耗尽");
+
+    vox_http_rate_limit_stats_t stats;
+    vox_http_rate_limiter_get_stats(rl, &stats);
+    TEST_ASSERT_EQ(stats.allowed, 7, "放行次数不正确");
+    TEST_ASSERT_EQ(stats.limited, 2, "限流次数不正确");
+    vox_http_rate_limiter_destroy(rl);
+}
+
+/* 测试固定内存：键数量超过表容量时淘汰活跃槽而不是增长 */
+static void test_middleware_rate_limiter_bounded(vox_mpool_t* mpool) {
+    vox_http_rate_limit_config_t config;
+    memset(&config, 0, sizeof(config));
+    /* 每个键只允许 1 次：指纹冲突的键若共用计数，新键首次请求就会被限流 */
+    config.max_requests = 1;
+    config.window_ms = 60000;
+    config.table_slots = 8;
+    vox_http_rate_limiter_t* rl = vox_http_rate_limiter_create(mpool, &config);
+    TEST_ASSERT_NOT_NULL(rl, "创建限流器失败");
+
+    int64_t now = (int64_t)vox_time_monotonic();
+    /* 键足够多，组内出现 16 位指纹相同的键几乎是必然的 */
+    for (uint32_t i = 0; i < 20000; i++) {
+        TEST_ASSERT(vox_http_rate_limiter_allow(rl, &i, sizeof(i), now, NULL), "新键首次请求应放行");
+    }
+    vox_http_rate_limit_stats_t stats;
+    vox_http_rate_limiter_get_stats(rl, &stats);
+    TEST_ASSERT_EQ(stats.allowed, 20000, "放行次数不正确");
+    TEST_ASSERT(stats.evictions >= 20000 - 8, "超出容量的键应淘汰旧槽");
+    vox_http_rate_limiter_destroy(rl);
+}
+
+/* 测试限流器绑定在 engine 上：实例数不受限，各 engine 互不影响，重复创建替换旧限流器 */
+static void test_middleware_rate_limit_engine(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    vox_http_rate_limit_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.max_requests = 5;
+    config.window_ms = 1000;
+    config.table_slots = 8;
+
+    vox_http_engine_t* engines[12];
+    for (int i = 0; i < 12; i++) {
+        engines[i] = vox_http_engine_create(loop);
+        TEST_ASSERT_NOT_NULL(engines[i], "创建 engine 失败");
+        TEST_ASSERT(vox_http_middleware_rate_limit_engine_create(engines[i], &config) == vox_http_middleware_rate_limit,
+                    "创建限流中间件失败");
+    }
+    void* first = vox_http_engine_get_middleware_data(engines[0], vox_http_middleware_rate_limit);
+    TEST_ASSERT_NOT_NULL(first, "engine 应持有限流器绑定");
+    TEST_ASSERT(first != vox_http_engine_get_middleware_data(engines[1], vox_http_middleware_rate_limit),
+                "不同 engine 的绑定应独立");
+    TEST_ASSERT(vox_http_middleware_rate_limit_engine_create(engines[0], &config) != NULL, "重复创建失败");
+    TEST_ASSERT(vox_http_engine_get_middleware_data(engines[0], vox_http_middleware_rate_limit) == first,
+                "重复创建应复用绑定");
+
+    /* mpool 入口保留原签名：相同配置复用同一入口，限流器在请求时按 engine 创建 */
+    config.max_requests = 0;
+    TEST_ASSERT_NULL(vox_http_middleware_rate_limit_create(mpool, &config), "无效配置应返回 NULL");
+    config.max_requests = 5;
+    vox_http_handler_cb legacy = vox_http_middleware_rate_limit_create(mpool, &config);
+    TEST_ASSERT_NOT_NULL(legacy, "有效配置应返回限流中间件");
+    TEST_ASSERT(legacy != vox_http_middleware_rate_limit, "旧入口应使用独立的处理函数");
+    TEST_ASSERT(vox_http_middleware_rate_limit_create(mpool, &config) == legacy, "相同配置应复用入口");
+
+    /* 调用方持有的限流器可绑定到多个 engine */
+    vox_http_rate_limiter_t* shared = vox_http_rate_limiter_create(mpool, &config);
+    TEST_ASSERT_NOT_NULL(shared, "创建限流器失败");
+    TEST_ASSERT_EQ(vox_http_middleware_rate_limit_bind(engines[0], shared), 0, "绑定限流器失败");
+    TEST_ASSERT_EQ(vox_http_middleware_rate_limit_bind(engines[1], shared), 0, "绑定限流器失败");
+
+    /* 无连接（取不到客户端地址）时放行 */
+    g_order_n = 0;
+    vox_http_handler_cb hs[] = { vox_http_middleware_rate_limit, h };
+    vox_http_context_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.handlers = hs;
+    ctx.handler_count = sizeof(hs) / sizeof(hs[0]);
+    ctx.engine = engines[0];
+    vox_http_context_next(&ctx);
+    TEST_ASSERT_EQ(g_order_n, 1, "取不到地址时应放行");
+
+    for (int i = 0; i < 12; i++) {
+        vox_http_engine_destroy(engines[i]);
+    }
+    vox_http_rate_limiter_destroy(shared);
+    vox_loop_destroy(loop);
+}
+
 test_case_t test_http_middleware_cases[] = {
     {"next_order", test_middleware_next_order},
     {"abort", test_middleware_abort},
+    {"rate_limiter_gcra", test_middleware_rate_limiter_gcra},
+    {"rate_limiter_bounded", test_middleware_rate_limiter_bounded},
+    {"rate_limit_engine", test_middleware_rate_limit_engine},
 };
 
 test_suite_t test_http_middleware_suite = {
@@ -6,9 +6,17 @@
 
 #include "../http/vox_http_router.h"
 #include "../http/vox_http_context.h"
+#include "../vox_thread.h"
+#include "../vox_atomic.h"
+#include <stdio.h>
+
+#define ROUTER_READERS 3
+#define ROUTER_RELOADS 200
+#define ROUTER_BULK_ROUTES 400
 
 static void h1(vox_http_context_t* ctx) { (void)ctx; }
 static void h2(vox_http_context_t* ctx) { (void)ctx; }
+static void h3(vox_http_context_t* ctx) { (void)ctx; }
 
 static void test_router_static_and_param(vox_mpool_t* mpool) {
     vox_http_router_t* r = vox_http_router_create(mpool);
@@ -50,10 +58,243 @@ static void test_router_static_and_param(vox_mpool_t* mpool) {
         TEST_ASSERT_EQ(m.params[0].value.len, 3, "param 值长度不正确");
         TEST_ASSERT_EQ(memcmp(m.params[0].value.ptr, "abc", 3), 0, "param 值不正确");
     }
+    vox_http_router_destroy(r);
+}
+
+/* 测试替换、删除与批量发布 */
+static void test_router_update(vox_mpool_t* mpool) {
+    vox_http_router_t* r = vox_http_router_create(mpool);
+    TEST_ASSERT_NOT_NULL(r, "创建 router 失败");
+    vox_http_handler_cb hs1[] = { h1 };
+    vox_http_handler_cb hs2[] = { h2 };
+    vox_http_handler_cb hs3[] = { h3 };
+    vox_http_route_match_t m;
+
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/a", hs1, 1), 0, "添加路由失败");
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/a/", hs2, 1), 0, "替换路由失败");
+    TEST_ASSERT_EQ(vox_http_router_route_count(r), 1, "重复注册应替换而不是新增");
+    TEST_ASSERT_EQ(vox_http_router_match(r, VOX_HTTP_METHOD_GET, "/a", 2, NULL, &m), 0, "匹配失败");
+    TEST_ASSERT_EQ((uintptr_t)m.handlers[0], (uintptr_t)h2, "替换后 handlers 不正确");
+
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/u/:id", hs1, 1), 0, "添加 param 路由失败");
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/u/:name/x", hs1, 1), -1, "同层不同参数名应冲突");
+    TEST_ASSERT_EQ(vox_http_router_route_count(r), 2, "冲突的路由不应计入");
+
+    /* 批量修改在 commit 前不可见 */
+    vox_http_router_begin(r);
+    vox_http_router_clear(r);
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_POST, "/b", hs3, 1), 0, "添加路由失败");
+    TEST_ASSERT_EQ(vox_http_router_match(r, VOX_HTTP_METHOD_GET, "/a", 2, NULL, &m), 0, "commit 前旧路由应仍可匹配");
+    TEST_ASSERT_NE(vox_http_router_match(r, VOX_HTTP_METHOD_POST, "/b", 2, NULL, &m), 0, "commit 前新路由不应可见");
+    TEST_ASSERT_EQ(vox_http_router_commit(r), 0, "commit 失败");
+    TEST_ASSERT_NE(vox_http_router_match(r, VOX_HTTP_METHOD_GET, "/a", 2, NULL, &m), 0, "commit 后旧路由应消失");
+    TEST_ASSERT_EQ(vox_http_router_match(r, VOX_HTTP_METHOD_POST, "/b", 2, NULL, &m), 0, "commit 后新路由应可见");
+    TEST_ASSERT_EQ(vox_http_router_route_count(r), 1, "路由数量不正确");
+
+    TEST_ASSERT_EQ(vox_http_router_remove(r, VOX_HTTP_METHOD_POST, "/b"), 0, "删除路由失败");
+    TEST_ASSERT_NE(vox_http_router_remove(r, VOX_HTTP_METHOD_POST, "/b"), 0, "重复删除应失败");
+    TEST_ASSERT_NE(vox_http_router_match(r, VOX_HTTP_METHOD_POST, "/b", 2, NULL, &m), 0, "删除后不应匹配");
+    vox_http_router_reclaim(r);
+    vox_http_router_destroy(r);
+}
+
+/* 测试匹配结果在快照被替换、回收后仍有效，以及参数超过内联容量 */
+static void test_router_snapshot_lifetime(vox_mpool_t* mpool) {
+    vox_http_router_t* r = vox_http_router_create(mpool);
+    TEST_ASSERT_NOT_NULL(r, "创建 router 失败");
+    vox_http_handler_cb hs1[] = { h1 };
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/user/:id", hs1, 1), 0, "添加路由失败");
+
+    vox_http_route_match_t m;
+    const char* path = "/user/42";
+    TEST_ASSERT_EQ(vox_http_router_match(r, VOX_HTTP_METHOD_GET, path, strlen(path), NULL, &m), 0, "匹配失败");
+    TEST_ASSERT(m.params == m.inline_params, "参数应存放在内联缓冲区");
+    vox_http_router_clear(r);
+    TEST_ASSERT(vox_http_router_reclaim(r) >= 1, "旧快照应被回收");
+    TEST_ASSERT_STR_EQ(m.params[0].name.ptr, "id", "快照回收后参数名应仍有效");
+
+    /* 超过内联容量：需要 mpool */
+    char route[256] = "";
+    char req[256] = "";
+    size_t off = 0, roff = 0;
+    for (int i = 0; i < VOX_HTTP_ROUTE_INLINE_PARAMS + 2; i++) {
+        off += (size_t)snprintf(route + off, sizeof(route) - off, "/:p%d", i);
+        roff += (size_t)snprintf(req + roff, sizeof(req) - roff, "/v%d", i);
+    }
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, route, hs1, 1), 0, "添加多参数路由失败");
+    TEST_ASSERT_NE(vox_http_router_match(r, VOX_HTTP_METHOD_GET, req, roff, NULL, &m), 0, "无 mpool 时超出内联容量应失败");
+    TEST_ASSERT_EQ(vox_http_router_match(r, VOX_HTTP_METHOD_GET, req, roff, mpool, &m), 0, "多参数匹配失败");
+    TEST_ASSERT_EQ(m.param_count, VOX_HTTP_ROUTE_INLINE_PARAMS + 2, "param_count 不正确");
+    TEST_ASSERT_STR_EQ(m.params[VOX_HTTP_ROUTE_INLINE_PARAMS + 1].name.ptr, "p9", "参数名不正确");
+    TEST_ASSERT_EQ(memcmp(m.params[VOX_HTTP_ROUTE_INLINE_PARAMS].value.ptr, "v8", 2), 0, "参数值不正确");
+    vox_mpool_free(mpool, m.params);
+    vox_http_router_destroy(r);
+}
+
+typedef struct {
+    vox_mpool_t* mpool;
+    int freed;
+} router_free_ctx_t;
+
+static void router_handlers_free(void* ptr, void* user_data) {
+    router_free_ctx_t* fc = (router_free_ctx_t*)user_data;
+    vox_mpool_free(fc->mpool, ptr);
+    fc->freed++;
+}
+
+static vox_http_handler_cb* router_alloc_handlers(vox_mpool_t* mpool, vox_http_handler_cb cb) {
+    vox_http_handler_cb* hs = (vox_http_handler_cb*)vox_mpool_alloc(mpool, sizeof(vox_http_handler_cb));
+    if (hs) hs[0] = cb;
+    return hs;
+}
+
+/* 测试 router 接管 handlers 数组：替换、删除的数组在发布且无读者后才回收 */
+static void test_router_handlers_free(vox_mpool_t* mpool) {
+    vox_http_router_t* r = vox_http_router_create(mpool);
+    TEST_ASSERT_NOT_NULL(r, "创建 router 失败");
+    router_free_ctx_t fc = { mpool, 0 };
+    vox_http_router_set_handlers_free(r, router_handlers_free, &fc);
+
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/a", router_alloc_handlers(mpool, h1), 1), 0, "添加路由失败");
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/a", router_alloc_handlers(mpool, h2), 1), 0, "替换路由失败");
+    vox_http_router_reclaim(r);
+    TEST_ASSERT_EQ(fc.freed, 1, "被替换的 handlers 应被回收");
+
+    /* 读者仍在执行匹配结果时不回收 */
+    vox_http_route_match_t m;
+    vox_http_router_enter(r);
+    TEST_ASSERT_EQ(vox_http_router_match(r, VOX_HTTP_METHOD_GET, "/a", 2, NULL, &m), 0, "匹配失败");
+    vox_http_router_begin(r);
+    vox_http_router_clear(r);
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/a", router_alloc_handlers(mpool, h1), 1), 0, "添加路由失败");
+    TEST_ASSERT_EQ(vox_http_router_commit(r), 0, "提交失败");
+    vox_http_router_reclaim(r);
+    TEST_ASSERT_EQ(fc.freed, 1, "临界区内的 handlers 不应被回收");
+    TEST_ASSERT(m.handlers[0] == h2, "执行中的 handlers 应保持有效");
+    vox_http_router_exit(r);
+    vox_http_router_reclaim(r);
+    TEST_ASSERT_EQ(fc.freed, 2, "离开临界区后应回收");
+
+    /* 批量修改未提交时当前快照仍引用旧数组 */
+    vox_http_router_begin(r);
+    vox_http_router_remove(r, VOX_HTTP_METHOD_GET, "/a");
+    vox_http_router_reclaim(r);
+    TEST_ASSERT_EQ(fc.freed, 2, "未发布前不应回收");
+    TEST_ASSERT_EQ(vox_http_router_commit(r), 0, "提交失败");
+    vox_http_router_reclaim(r);
+    TEST_ASSERT_EQ(fc.freed, 3, "发布后应回收");
+
+    /* 销毁时释放其余数组 */
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/b", router_alloc_handlers(mpool, h1), 1), 0, "添加路由失败");
+    vox_http_router_destroy(r);
+    TEST_ASSERT_EQ(fc.freed, 4, "销毁时应释放剩余 handlers");
+}
+
+/* 测试批量之外连续注册只构建一个快照（不随路由数量重建） */
+static void test_router_bulk_register(vox_mpool_t* mpool) {
+    vox_http_router_t* r = vox_http_router_create(mpool);
+    TEST_ASSERT_NOT_NULL(r, "创建 router 失败");
+    vox_http_handler_cb hs1[] = { h1 };
+    vox_http_handler_cb hs2[] = { h2 };
+    char path[64];
+    for (int i = 0; i < ROUTER_BULK_ROUTES; i++) {
+        snprintf(path, sizeof(path), i % 2 ? "/bulk/%d/:id" : "/bulk/%d", i);
+        TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, path, i % 2 ? hs2 : hs1, 1), 0, "添加路由失败");
+    }
+    /* 创建时的空快照 + 一个草稿 */
+    TEST_ASSERT_EQ(vox_http_router_snapshots_built(r), 2, "注册期间应只构建一个草稿");
+
+    vox_http_route_match_t m;
+    for (int i = 0; i < ROUTER_BULK_ROUTES; i++) {
+        int n = snprintf(path, sizeof(path), i % 2 ? "/bulk/%d/7" : "/bulk/%d", i);
+        TEST_ASSERT_EQ(vox_http_router_match(r, VOX_HTTP_METHOD_GET, path, (size_t)n, NULL, &m), 0, "匹配失败");
+        TEST_ASSERT(m.handlers[0] == (i % 2 ? h2 : h1), "handlers 不正确");
+    }
+    TEST_ASSERT_EQ(vox_http_router_snapshots_built(r), 2, "所有注册应只构建一个快照");
+    TEST_ASSERT_EQ(vox_http_router_route_count(r), ROUTER_BULK_ROUTES, "路由数量不正确");
+
+    /* 发布后的修改在下一次匹配前可见 */
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_POST, "/late", hs1, 1), 0, "添加路由失败");
+    TEST_ASSERT_EQ(vox_http_router_match(r, VOX_HTTP_METHOD_POST, "/late", 5, NULL, &m), 0, "新路由应可匹配");
+    TEST_ASSERT_EQ(vox_http_router_snapshots_built(r), 3, "快照数量不正确");
+    vox_http_router_destroy(r);
+}
+
+typedef struct {
+    vox_http_router_t* router;
+    vox_atomic_int_t* stop;
+    int errors;
+    int matched;
+} router_reader_ctx_t;
+
+/* 读者：/stable 始终可匹配；/v/:n 的参数名只会是 n */
+static int router_reader(void* user_data) {
+    router_reader_ctx_t* ctx = (router_reader_ctx_t*)user_data;
+    vox_http_route_match_t m;
+    while (!vox_atomic_int_load(ctx->stop)) {
+        if (vox_http_router_match(ctx->router, VOX_HTTP_METHOD_GET, "/stable", 7, NULL, &m) != 0 ||
+            m.handler_count != 1 || m.handlers[0] != h1) {
+            ctx->errors++;
+        }
+        if (vox_http_router_match(ctx->router, VOX_HTTP_METHOD_GET, "/v/7", 4, NULL, &m) == 0) {
+            if (m.param_count != 1 || m.params[0].name.len != 1 || m.params[0].name.ptr[0] != 'n') ctx->errors++;
+            ctx->matched++;
+        }
+        vox_thread_yield();
+    }
+    return 0;
+}
+
+/* 测试匹配与整体替换路由表并发进行 */
+static void test_router_concurrent_reload(vox_mpool_t* mpool) {
+    vox_http_router_t* r = vox_http_router_create(mpool);
+    TEST_ASSERT_NOT_NULL(r, "创建 router 失败");
+    vox_http_handler_cb hs1[] = { h1 };
+    vox_http_handler_cb hs2[] = { h2 };
+    TEST_ASSERT_EQ(vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/stable", hs1, 1), 0, "添加路由失败");
+
+    vox_atomic_int_t stop;
+    vox_atomic_int_init(&stop, 0);
+    router_reader_ctx_t ctx[ROUTER_READERS];
+    vox_thread_t* threads[ROUTER_READERS];
+    for (int i = 0; i < ROUTER_READERS; i++) {
+        ctx[i].router = r;
+        ctx[i].stop = &stop;
+        ctx[i].errors = 0;
+        ctx[i].matched = 0;
+        threads[i] = vox_thread_create(mpool, router_reader, &ctx[i]);
+        TEST_ASSERT_NOT_NULL(threads[i], "创建线程失败");
+    }
+
+    char path[64];
+    for (int round = 0; round < ROUTER_RELOADS; round++) {
+        vox_http_router_begin(r);
+        vox_http_router_clear(r);
+        vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/stable", hs1, 1);
+        if (round % 2 == 0) vox_http_router_add(r, VOX_HTTP_METHOD_GET, "/v/:n", hs2, 1);
+        for (int i = 0; i < 20; i++) {
+            snprintf(path, sizeof(path), "/r%d/item-%d/:id", round, i);
+            vox_http_router_add(r, VOX_HTTP_METHOD_GET, path, hs2, 1);
+        }
+        if (vox_http_router_commit(r) != 0) ctx[0].errors++;
+        if (round % 16 == 0) vox_thread_yield();
+    }
+    vox_atomic_int_store(&stop, 1);
+    for (int i = 0; i < ROUTER_READERS; i++) {
+        vox_thread_join(threads[i], NULL);
+        TEST_ASSERT_EQ(ctx[i].errors, 0, "并发热更新期间匹配出错");
+    }
+    TEST_ASSERT_EQ(vox_http_router_route_count(r), 21, "最终路由数量不正确");
+    vox_http_router_destroy(r);
 }
 
 test_case_t test_http_router_cases[] = {
     {"static_and_param", test_router_static_and_param},
+    {"update", test_router_update},
+    {"snapshot_lifetime", test_router_snapshot_lifetime},
+    {"handlers_free", test_router_handlers_free},
+    {"bulk_register", test_router_bulk_register},
+    {"concurrent_reload", test_router_concurrent_reload},
 };
 
 test_suite_t test_http_router_suite = {
@@ -0,0 +1,412 @@
+/* ============================================================
+ * test_http_server.c - vox_http_server HTTP/1.1 管线化测试
+ * 服务端与客户端运行在同一事件循环中，客户端一次写入多个请求，
+ * 由测试决定 defer 请求的 finish 顺序，检查响应顺序与并发处理
+ * ============================================================ */
+
+#include "test_runner.h"
+
+#include "../vox_loop.h"
+#include "../vox_tcp.h"
+#include "../vox_socket.h"
+#include "../vox_string.h"
+#include "../vox_file.h"
+
+#include "../http/vox_http_server.h"
+#include "../http/vox_http_engine.h"
+#include "../http/vox_http_context.h"
+#include "../http/vox_http_router.h"
+#include "../http/vox_http_middleware.h"
+
+#include <string.h>
+#include <stdio.h>
+
+#define PIPE_MAX_DEFERRED 8
+
+/* 大于回环 socket 发送缓冲区，sendfile 必然中途遇到缓冲区满 */
+#define PIPE_FILE_SIZE (16 * 1024 * 1024)
+#define PIPE_FILE_PATH "/tmp/vox_test_http_server_sendfile.bin"
+
+static vox_http_context_t* g_deferred[PIPE_MAX_DEFERRED];
+static int g_deferred_count;
+static vox_mpool_t* g_file_mpool;
+
+typedef struct {
+    vox_http_engine_t* engine;
+    vox_tcp_t* tcp;
+    vox_string_t* in;
+    int connected;
+    int eof;
+} pipe_client_t;
+
+static void pipe_defer_handler(vox_http_context_t* ctx) {
+    vox_http_context_defer(ctx);
+    if (g_deferred_count < PIPE_MAX_DEFERRED) g_deferred[g_deferred_count++] = ctx;
+}
+
+static void pipe_hello_handler(vox_http_context_t* ctx) {
+    vox_http_context_write_cstr(ctx, "hello");
+}
+
+static void pipe_file_handler(vox_http_context_t* ctx) {
+    vox_file_t* file = vox_file_open(g_file_mpool, PIPE_FILE_PATH, VOX_FILE_MODE_READ);
+    if (!file || vox_http_context_send_file(ctx, file, 0, PIPE_FILE_SIZE) != 0) {
+        vox_http_context_status(ctx, 500);
+    }
+}
+
+/* 异步中间件：defer 后由测试 resume_at 到下一个 handler 继续 */
+static size_t g_resume_index;
+
+static void pipe_resume_defer_handler(vox_http_context_t* ctx) {
+    g_resume_index = vox_http_context_get_index(ctx);
+    pipe_defer_handler(ctx);
+}
+
+static void pipe_resume_tail_handler(vox_http_context_t* ctx) {
+    vox_http_context_write_cstr(ctx, "resumed");
+}
+
+static void pipe_finish(int i) {
+    char body[16];
+    snprintf(body, sizeof(body), "d%d", i);
+    vox_http_context_write_cstr(g_deferred[i], body);
+    vox_http_context_finish(g_deferred[i]);
+}
+
+static void pipe_connect_cb(vox_tcp_t* tcp, int status, void* user_data) {
+    VOX_UNUSED(tcp);
+    pipe_client_t* cl = (pipe_client_t*)user_data;
+    cl->connected = status == 0 ? 1 : -1;
+}
+
+static void pipe_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void* user_data) {
+    VOX_UNUSED(tcp);
+    pipe_client_t* cl = (pipe_client_t*)user_data;
+    if (nread > 0) {
+        vox_string_append_data(cl->in, buf, (size_t)nread);
+    } else {
+        cl->eof = 1;
+    }
+}
+
+/* 运行 loop 直到 *flag 非0（flag 为 NULL 时运行固定轮数） */
+static void pipe_run(vox_loop_t* loop, const int* flag) {
+    for (int i = 0; i < 2000 && !(flag && *flag); i++) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+        if (!flag && i >= 50) break;
+    }
+}
+
+/* 运行 loop 直到收到 count 个响应（按 "HTTP/1.1 " 计数） */
+static size_t pipe_count_responses(const vox_string_t* in) {
+    size_t n = 0;
+    const char* p = (const char*)vox_string_data(in);
+    const char* end = p + vox_string_length(in);
+    while (p < end && (p = strstr(p, "HTTP/1.1 ")) != NULL) {
+        n++;
+        p += 9;
+    }
+    return n;
+}
+
+static void pipe_run_responses(vox_loop_t* loop, pipe_client_t* cl, size_t count) {
+    for (int i = 0; i < 2000 && pipe_count_responses(cl->in) < count && !cl->eof; i++) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+    }
+}
+
+/* 在空闲端口上启动服务端，并连接客户端 */
+static vox_http_server_t* pipe_start(vox_loop_t* loop, vox_mpool_t* mpool, size_t max_pipeline,
+                                     pipe_client_t* cl) {
+    static vox_http_handler_cb deferh[] = { pipe_defer_handler };
+    static vox_http_handler_cb hello[] = { pipe_hello_handler };
+    static vox_http_handler_cb fileh[] = { pipe_file_handler };
+    static vox_http_handler_cb resumeh[] = { pipe_resume_defer_handler, pipe_resume_tail_handler };
+    vox_http_engine_t* engine = vox_http_engine_create(loop);
+    if (!engine) return NULL;
+    vox_http_engine_get(engine, "/defer", deferh, 1);
+    vox_http_engine_get(engine, "/hello", hello, 1);
+    vox_http_engine_get(engine, "/file", fileh, 1);
+    vox_http_engine_get(engine, "/resume", resumeh, 2);
+    vox_http_server_t* server = vox_http_server_create(engine);
+    if (!server) return NULL;
+    if (max_pipeline) vox_http_server_set_max_pipeline(server, max_pipeline);
+
+    /* 绑定端口 0 取得一个空闲端口 */
+    vox_socket_addr_t addr;
+    vox_socket_parse_address("127.0.0.1", 0, &addr);
+    vox_tcp_t* probe = vox_tcp_create(loop);
+    if (!probe || vox_tcp_bind(probe, &addr, 0) != 0 || vox_tcp_getsockname(probe, &addr) != 0) return NULL;
+    vox_tcp_destroy(probe);
+    if (vox_http_server_listen_tcp(server, &addr, 16) != 0) return NULL;
+
+    memset(cl, 0, sizeof(*cl));
+    cl->engine = engine;
+    cl->in = vox_string_create(mpool);
+    cl->tcp = vox_tcp_create(loop);
+    if (!cl->in || !cl->tcp) return NULL;
+    vox_handle_set_data((vox_handle_t*)cl->tcp, cl);
+    if (vox_tcp_connect(cl->tcp, &addr, pipe_connect_cb) != 0) return NULL;
+    pipe_run(loop, &cl->connected);
+    if (cl->connected != 1) return NULL;
+    if (vox_tcp_read_start(cl->tcp, NULL, pipe_read_cb) != 0) return NULL;
+    g_deferred_count = 0;
+    return server;
+}
+
+static void pipe_stop(vox_loop_t* loop, vox_http_server_t* server, pipe_client_t* cl) {
+    vox_handle_close((vox_handle_t*)cl->tcp, NULL);
+    vox_http_server_close(server);
+    /* 运行到没有活跃句柄：处理关闭回调，释放连接 */
+    vox_loop_run(loop, VOX_RUN_DEFAULT);
+    vox_http_server_destroy(server);
+    vox_http_engine_destroy(cl->engine);
+    vox_string_destroy(cl->in);
+    vox_loop_destroy(loop);
+}
+
+static const char* pipe_find(const vox_string_t* in, const char* s) {
+    return strstr((const char*)vox_string_data(in), s);
+}
+
+/* 测试 defer 的请求同时处理、按到达顺序响应 */
+static void test_http_server_pipeline_in_order(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    pipe_client_t cl;
+    vox_http_server_t* server = pipe_start(loop, mpool, 0, &cl);
+    TEST_ASSERT_NOT_NULL(server, "启动服务端失败");
+
+    static const char reqs[] =
+        "GET /defer HTTP/1.1\r\nHost: a\r\n\r\n"
+        "GET /defer HTTP/1.1\r\nHost: a\r\n\r\n"
+        "GET /defer HTTP/1.1\r\nHost: a\r\n\r\n"
+        "GET /hello HTTP/1.1\r\nHost: a\r\n\r\n";
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, reqs, sizeof(reqs) - 1, NULL), 0, "写入请求失败");
+    pipe_run(loop, NULL);
+    TEST_ASSERT_EQ(g_deferred_count, 3, "三个 defer 请求应同时在处理中");
+    TEST_ASSERT_EQ(vox_string_length(cl.in), 0, "队首未完成时不应输出响应");
+
+    /* 后面的请求先完成：等待队首 */
+    pipe_finish(2);
+    pipe_finish(1);
+    pipe_run(loop, NULL);
+    TEST_ASSERT_EQ(vox_string_length(cl.in), 0, "队首未完成时后续响应应等待");
+
+    pipe_finish(0);
+    pipe_run_responses(loop, &cl, 4);
+    TEST_ASSERT_EQ(pipe_count_responses(cl.in), 4, "应收到四个响应");
+    const char* p0 = pipe_find(cl.in, "d0");
+    const char* p1 = pipe_find(cl.in, "d1");
+    const char* p2 = pipe_find(cl.in, "d2");
+    const char* ph = pipe_find(cl.in, "hello");
+    TEST_ASSERT_TRUE(p0 && p1 && p2 && ph, "响应内容缺失");
+    TEST_ASSERT_TRUE(p0 < p1 && p1 < p2 && p2 < ph, "响应应按请求顺序输出");
+    TEST_ASSERT_FALSE(cl.eof, "keep-alive 连接不应关闭");
+
+    /* 连接继续可用 */
+    static const char again[] = "GET /hello HTTP/1.1\r\nHost: a\r\n\r\n";
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, again, sizeof(again) - 1, NULL), 0, "写入请求失败");
+    pipe_run_responses(loop, &cl, 5);
+    TEST_ASSERT_EQ(pipe_count_responses(cl.in), 5, "管线化后连接应继续可用");
+
+    pipe_stop(loop, server, &cl);
+}
+
+/* 测试 max_pipeline 限制同时处理的请求数 */
+static void test_http_server_pipeline_limit(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    pipe_client_t cl;
+    vox_http_server_t* server = pipe_start(loop, mpool, 1, &cl);
+    TEST_ASSERT_NOT_NULL(server, "启动服务端失败");
+
+    static const char reqs[] =
+        "GET /defer HTTP/1.1\r\nHost: a\r\n\r\n"
+        "GET /defer HTTP/1.1\r\nHost: a\r\n\r\n"
+        "GET /defer HTTP/1.1\r\nHost: a\r\n\r\n";
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, reqs, sizeof(reqs) - 1, NULL), 0, "写入请求失败");
+    pipe_run(loop, NULL);
+    TEST_ASSERT_EQ(g_deferred_count, 1, "上限为 1 时只应处理一个请求");
+
+    for (int i = 0; i < 3; i++) {
+        pipe_finish(i);
+        pipe_run_responses(loop, &cl, (size_t)i + 1);
+        TEST_ASSERT_EQ(pipe_count_responses(cl.in), (size_t)i + 1, "应逐个输出响应");
+        if (i < 2) {
+            pipe_run(loop, NULL);
+            TEST_ASSERT_EQ(g_deferred_count, i + 2, "响应写出后应处理下一个请求");
+        }
+    }
+    TEST_ASSERT_TRUE(pipe_find(cl.in, "d0") < pipe_find(cl.in, "d2"), "响应顺序不正确");
+
+    pipe_stop(loop, server, &cl);
+}
+
+/* 测试 Connection: close 之后的请求不再处理 */
+static void test_http_server_pipeline_close(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    pipe_client_t cl;
+    vox_http_server_t* server = pipe_start(loop, mpool, 0, &cl);
+    TEST_ASSERT_NOT_NULL(server, "启动服务端失败");
+
+    static const char reqs[] =
+        "GET /defer HTTP/1.1\r\nHost: a\r\nConnection: close\r\n\r\n"
+        "GET /hello HTTP/1.1\r\nHost: a\r\n\r\n";
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, reqs, sizeof(reqs) - 1, NULL), 0, "写入请求失败");
+    pipe_run(loop, NULL);
+    TEST_ASSERT_EQ(g_deferred_count, 1, "应处理 close 请求");
+
+    pipe_finish(0);
+    pipe_run(loop, &cl.eof);
+    TEST_ASSERT_EQ(pipe_count_responses(cl.in), 1, "close 之后的请求不应被处理");
+    TEST_ASSERT_NOT_NULL(pipe_find(cl.in, "Connection: close"), "响应应带 Connection: close");
+    TEST_ASSERT_NULL(pipe_find(cl.in, "hello"), "close 之后的请求不应被处理");
+
+    pipe_stop(loop, server, &cl);
+}
+
+/* 测试请求跨两次读取、后面紧跟管线化请求时，下一个请求的字节不会丢失 */
+static void test_http_server_pipeline_split_read(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    pipe_client_t cl;
+    vox_http_server_t* server = pipe_start(loop, mpool, 0, &cl);
+    TEST_ASSERT_NOT_NULL(server, "启动服务端失败");
+
+    static const char part1[] = "GET /hello HTTP/1.1\r\nHo";
+    static const char part2[] = "st: x\r\n\r\nGET /hello HTTP/1.1\r\nHost: x\r\n\r\n";
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, part1, sizeof(part1) - 1, NULL), 0, "写入请求失败");
+    pipe_run(loop, NULL);
+    TEST_ASSERT_EQ(vox_string_length(cl.in), 0, "请求不完整时不应输出响应");
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, part2, sizeof(part2) - 1, NULL), 0, "写入请求失败");
+    pipe_run_responses(loop, &cl, 2);
+    TEST_ASSERT_EQ(pipe_count_responses(cl.in), 2, "应收到两个响应");
+    TEST_ASSERT_NULL(pipe_find(cl.in, "404"), "第二个请求不应被截断");
+    const char* h0 = pipe_find(cl.in, "hello");
+    TEST_ASSERT_NOT_NULL(h0, "缺少第一个响应体");
+    TEST_ASSERT_NOT_NULL(strstr(h0 + 5, "hello"), "缺少第二个响应体");
+
+    pipe_stop(loop, server, &cl);
+}
+
+/* 测试文件体超过 socket 发送缓冲区时，sendfile 等可写后从中断处继续，数据完整 */
+static void test_http_server_sendfile_resume(vox_mpool_t* mpool) {
+    char* data = (char*)vox_mpool_alloc(mpool, PIPE_FILE_SIZE);
+    TEST_ASSERT_NOT_NULL(data, "分配文件数据失败");
+    for (size_t i = 0; i < PIPE_FILE_SIZE; i++) data[i] = (char)(i % 251);
+    TEST_ASSERT_EQ(vox_file_write_all(mpool, PIPE_FILE_PATH, data, PIPE_FILE_SIZE), 0, "写入测试文件失败");
+    g_file_mpool = mpool;
+
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    pipe_client_t cl;
+    vox_http_server_t* server = pipe_start(loop, mpool, 0, &cl);
+    TEST_ASSERT_NOT_NULL(server, "启动服务端失败");
+
+    static const char req[] = "GET /file HTTP/1.1\r\nHost: a\r\n\r\nGET /hello HTTP/1.1\r\nHost: a\r\n\r\n";
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, req, sizeof(req) - 1, NULL), 0, "写入请求失败");
+    /* 读到文件体与其后 hello 响应的结尾 */
+    for (int i = 0; i < 100000 && !cl.eof; i++) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+        size_t len = vox_string_length(cl.in);
+        if (len > PIPE_FILE_SIZE && memcmp((const char*)vox_string_data(cl.in) + len - 5, "hello", 5) == 0) break;
+    }
+    const char* in = (const char*)vox_string_data(cl.in);
+    const char* hdr_end = strstr(in, "\r\n\r\n");
+    TEST_ASSERT_NOT_NULL(hdr_end, "缺少文件响应头");
+    size_t body_off = (size_t)(hdr_end + 4 - in);
+    TEST_ASSERT(vox_string_length(cl.in) >= body_off + PIPE_FILE_SIZE, "文件体不完整");
+    TEST_ASSERT(memcmp(in + body_off, data, PIPE_FILE_SIZE) == 0, "文件体内容不正确");
+    TEST_ASSERT_NOT_NULL(strstr(in + body_off + PIPE_FILE_SIZE, "hello"), "文件之后的响应应紧随其后");
+
+    pipe_stop(loop, server, &cl);
+    vox_file_remove(mpool, PIPE_FILE_PATH);
+    vox_mpool_free(mpool, data);
+}
+
+/* 测试 defer 期间路由被热更新替换并回收后，resume_at/next 仍按原处理链执行 */
+static void test_http_server_resume_after_replace(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    pipe_client_t cl;
+    vox_http_server_t* server = pipe_start(loop, mpool, 0, &cl);
+    TEST_ASSERT_NOT_NULL(server, "启动服务端失败");
+
+    static const char req[] = "GET /resume HTTP/1.1\r\nHost: a\r\n\r\n";
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, req, sizeof(req) - 1, NULL), 0, "写入请求失败");
+    pipe_run(loop, NULL);
+    TEST_ASSERT_EQ(g_deferred_count, 1, "请求应被 defer");
+
+    static vox_http_handler_cb replaced[] = { pipe_hello_handler };
+    TEST_ASSERT_EQ(vox_http_engine_get(cl.engine, "/resume", replaced, 1), 0, "替换路由失败");
+    vox_http_router_t* router = vox_http_engine_get_router(cl.engine);
+    for (int i = 0; i < 4; i++) vox_http_router_reclaim(router);
+    /* 同样大小的新链会复用被回收的内存 */
+    static vox_http_handler_cb other[] = { pipe_hello_handler, pipe_hello_handler };
+    TEST_ASSERT_EQ(vox_http_engine_get(cl.engine, "/other", other, 2), 0, "注册路由失败");
+
+    vox_http_context_t* ctx = g_deferred[0];
+    vox_http_context_resume_at(ctx, g_resume_index);
+    vox_http_context_next(ctx);
+    TEST_ASSERT_EQ(vox_http_context_finish(ctx), 0, "finish 失败");
+    pipe_run_responses(loop, &cl, 1);
+    TEST_ASSERT_NOT_NULL(pipe_find(cl.in, "resumed"), "应按 defer 时的处理链继续执行");
+    TEST_ASSERT_NULL(pipe_find(cl.in, "hello"), "不应执行替换后的处理链");
+
+    pipe_stop(loop, server, &cl);
+}
+
+/* 测试旧的限流入口 vox_http_middleware_rate_limit_create：超过限额后返回 429 */
+static void test_http_server_rate_limit_legacy(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    pipe_client_t cl;
+    vox_http_server_t* server = pipe_start(loop, mpool, 0, &cl);
+    TEST_ASSERT_NOT_NULL(server, "启动服务端失败");
+
+    vox_http_rate_limit_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.max_requests = 2;
+    config.window_ms = 60000;
+    config.message = "limited";
+    vox_http_handler_cb limit = vox_http_middleware_rate_limit_create(mpool, &config);
+    TEST_ASSERT_NOT_NULL(limit, "创建限流中间件失败");
+    vox_http_handler_cb limited[] = { limit, pipe_hello_handler };
+    TEST_ASSERT_EQ(vox_http_engine_get(cl.engine, "/limited", limited, 2), 0, "注册路由失败");
+
+    static const char reqs[] =
+        "GET /limited HTTP/1.1\r\nHost: a\r\n\r\n"
+        "GET /limited HTTP/1.1\r\nHost: a\r\n\r\n"
+        "GET /limited HTTP/1.1\r\nHost: a\r\n\r\n";
+    TEST_ASSERT_EQ(vox_tcp_write(cl.tcp, reqs, sizeof(reqs) - 1, NULL), 0, "写入请求失败");
+    pipe_run_responses(loop, &cl, 3);
+    TEST_ASSERT_EQ(pipe_count_responses(cl.in), 3, "应收到三个响应");
+    const char* rejected = pipe_find(cl.in, "HTTP/1.1 429");
+    TEST_ASSERT_NOT_NULL(rejected, "超过限额应返回 429");
+    TEST_ASSERT_NOT_NULL(pipe_find(cl.in, "Retry-After"), "429 响应应带 Retry-After");
+    TEST_ASSERT_NOT_NULL(pipe_find(cl.in, "limited"), "应返回配置的消息");
+    const char* first = pipe_find(cl.in, "HTTP/1.1 200");
+    const char* second = first ? strstr(first + 1, "HTTP/1.1 200") : NULL;
+    TEST_ASSERT_TRUE(second && second < rejected, "限额内的两个请求应先成功");
+
+    pipe_stop(loop, server, &cl);
+}
+
+test_case_t test_http_server_cases[] = {
+    {"pipeline_in_order", test_http_server_pipeline_in_order},
+    {"pipeline_limit", test_http_server_pipeline_limit},
+    {"pipeline_close", test_http_server_pipeline_close},
+    {"pipeline_split_read", test_http_server_pipeline_split_read},
+    {"sendfile_resume", test_http_server_sendfile_resume},
+    {"resume_after_replace", test_http_server_resume_after_replace},
+    {"rate_limit_legacy", test_http_server_rate_limit_legacy},
+};
+
+test_suite_t test_http_server_suite = {
+    "http_server",
+    test_http_server_cases,
+    sizeof(test_http_server_cases) / sizeof(test_http_server_cases[0])
+};
@@ -0,0 +1,350 @@
+/* ============================================================
+ * test_http_static.c - vox_http_static 静态文件服务测试
+ * 直接构造内部 ctx 调用 vox_http_static_serve，检查状态码、响应头与 sendfile 参数
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_file.h"
+#include "../vox_vector.h"
+#include "../http/vox_http_static.h"
+#include "../http/vox_http_engine.h"
+#include "../http/vox_http_internal.h" /* 为了构造内部 ctx 结构 */
+#include <stdio.h>
+#ifdef VOX_OS_LINUX
+#include <unistd.h>
+#endif
+
+#define STATIC_TEST_ROOT "/tmp/vox_test_http_static"
+
+static void static_test_setup(vox_mpool_t* mpool) {
+    vox_file_rmdir(mpool, STATIC_TEST_ROOT, true);
+    vox_file_mkdir(mpool, STATIC_TEST_ROOT "/sub", true);
+    vox_file_write_all(mpool, STATIC_TEST_ROOT "/a.txt", "hello world 0123456789", 22);
+    vox_file_write_all(mpool, STATIC_TEST_ROOT "/sub/index.html", "<h1>idx</h1>", 12);
+    vox_file_write_all(mpool, STATIC_TEST_ROOT "/app.css", "body{}", 6);
+    vox_file_write_all(mpool, STATIC_TEST_ROOT "/app.css.gz", "GZDATA", 6);
+}
+
+/* 初始化 ctx；headers 为 name,value 交替的数组 */
+static void static_ctx_init(vox_http_context_t* ctx, vox_mpool_t* mpool, vox_http_method_t method,
+                            const char* const* headers, size_t header_count) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->mpool = mpool;
+    ctx->req.method = method;
+    ctx->req.http_major = 1;
+    ctx->req.http_minor = 1;
+    vox_vector_t* vec = vox_vector_create(mpool);
+    for (size_t i = 0; i + 1 < header_count; i += 2) {
+        vox_http_header_t* kv = (vox_http_header_t*)vox_mpool_alloc(mpool, sizeof(vox_http_header_t));
+        kv->name.ptr = headers[i];
+        kv->name.len = strlen(headers[i]);
+        kv->value.ptr = headers[i + 1];
+        kv->value.len = strlen(headers[i + 1]);
+        vox_vector_push(vec, kv);
+    }
+    ctx->req.headers = vec;
+}
+
+static vox_strview_t static_res_header(vox_http_context_t* ctx, const char* name) {
+    vox_vector_t* vec = (vox_vector_t*)ctx->res.headers;
+    size_t cnt = vec ? vox_vector_size(vec) : 0;
+    for (size_t i = 0; i < cnt; i++) {
+        vox_http_header_t* kv = (vox_http_header_t*)vox_vector_get(vec, i);
+        if (vox_http_strieq(kv->name.ptr, kv->name.len, name, strlen(name))) return kv->value;
+    }
+    return (vox_strview_t)VOX_STRVIEW_NULL;
+}
+
+static bool static_header_is(vox_http_context_t* ctx, const char* name, const char* value) {
+    vox_strview_t v = static_res_header(ctx, name);
+    return v.ptr && v.len == strlen(value) && memcmp(v.ptr, value, v.len) == 0;
+}
+
+/* 归还 serve 交给框架的缓存文件引用 */
+static void static_ctx_done(vox_http_context_t* ctx) {
+    if (ctx->sendfile_file) {
+        vox_http_sendfile_release(ctx->sendfile_file, ctx->sendfile_release, ctx->sendfile_release_data);
+        ctx->sendfile_file = NULL;
+    }
+}
+
+/* 测试整文件发送、缓存命中、304 与目录/越界/不存在处理 */
+static void test_static_basic(vox_mpool_t* mpool) {
+    static_test_setup(mpool);
+    vox_http_static_options_t opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.disable_inotify = true;
+    vox_http_static_t* st = vox_http_static_create(STATIC_TEST_ROOT, &opts);
+    TEST_ASSERT_NOT_NULL(st, "创建静态文件服务失败");
+
+    vox_http_context_t ctx;
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    TEST_ASSERT_EQ(vox_http_static_serve(st, &ctx, "/a.txt", 6), 0, "请求 a.txt 失败");
+    TEST_ASSERT_EQ(ctx.res.status, 200, "状态码应为200");
+    TEST_ASSERT_NOT_NULL(ctx.sendfile_file, "应使用 sendfile 发送文件体");
+    TEST_ASSERT_EQ(ctx.sendfile_count, 22, "发送长度不正确");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Length", "22"), "Content-Length 不正确");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Type", "text/plain"), "Content-Type 不正确");
+    vox_strview_t etag = static_res_header(&ctx, "ETag");
+    TEST_ASSERT(etag.ptr && etag.len > 2 && etag.ptr[0] == '"', "缺少 ETag");
+    char etag_buf[64];
+    snprintf(etag_buf, sizeof(etag_buf), "%.*s", (int)etag.len, etag.ptr);
+    vox_file_t* first_file = ctx.sendfile_file;
+    static_ctx_done(&ctx);
+
+    /* 第二次请求命中缓存，复用同一个已打开的文件 */
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    TEST_ASSERT_EQ(vox_http_static_serve(st, &ctx, "a.txt", 5), 0, "再次请求失败");
+    TEST_ASSERT(ctx.sendfile_file == first_file, "缓存命中应复用已打开的文件");
+    static_ctx_done(&ctx);
+
+    /* If-None-Match（弱比较）-> 304 */
+    char weak[80];
+    snprintf(weak, sizeof(weak), "\"x\", W/%s", etag_buf);
+    const char* h304[] = { "If-None-Match", weak };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h304, 2);
+    TEST_ASSERT_EQ(vox_http_static_serve(st, &ctx, "/a.txt", 6), 0, "条件请求失败");
+    TEST_ASSERT_EQ(ctx.res.status, 304, "ETag 匹配应返回304");
+    TEST_ASSERT(ctx.sendfile_file == NULL, "304 不应发送文件体");
+
+    /* If-Modified-Since 使用 Last-Modified 原值 -> 304 */
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    vox_strview_t lm = static_res_header(&ctx, "Last-Modified");
+    char lm_buf[64];
+    snprintf(lm_buf, sizeof(lm_buf), "%.*s", (int)lm.len, lm.ptr);
+    static_ctx_done(&ctx);
+    const char* hims[] = { "If-Modified-Since", lm_buf };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, hims, 2);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 304, "未修改应返回304");
+
+    /* HEAD：只有头 */
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_HEAD, NULL, 0);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 200, "HEAD 状态码不正确");
+    TEST_ASSERT(ctx.sendfile_file == NULL, "HEAD 不应发送文件体");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Length", "22"), "HEAD Content-Length 不正确");
+
+    /* 目录：无末尾 '/' 重定向，有则返回 index.html */
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    ctx.req.path.ptr = "/sub";
+    ctx.req.path.len = 4;
+    vox_http_static_serve(st, &ctx, "/sub", 4);
+    TEST_ASSERT_EQ(ctx.res.status, 301, "目录应重定向");
+    TEST_ASSERT(static_header_is(&ctx, "Location", "/sub/"), "Location 不正确");
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    vox_http_static_serve(st, &ctx, "/sub/", 5);
+    TEST_ASSERT_EQ(ctx.res.status, 200, "index.html 状态码不正确");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Type", "text/html"), "index.html 类型不正确");
+    static_ctx_done(&ctx);
+
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    vox_http_static_serve(st, &ctx, "/sub/%2e%2e/%2e%2e/etc/passwd", 29);
+    TEST_ASSERT_EQ(ctx.res.status, 403, "越界路径应返回403");
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    TEST_ASSERT_EQ(vox_http_static_serve(st, &ctx, "/missing", 8), 1, "不存在的文件应返回1");
+
+    vox_http_static_stats_t stats;
+    TEST_ASSERT_EQ(vox_http_static_get_stats(st, &stats), 0, "获取统计失败");
+    TEST_ASSERT(stats.hits >= 4, "缓存命中次数不正确");
+    TEST_ASSERT_EQ(stats.not_modified, 2, "304 次数不正确");
+
+    vox_http_static_destroy(st);
+    vox_file_rmdir(mpool, STATIC_TEST_ROOT, true);
+}
+
+/* 测试单区间/多区间/不可满足区间与 .gz 预压缩选择 */
+static void test_static_range_and_gzip(vox_mpool_t* mpool) {
+    static_test_setup(mpool);
+    vox_http_static_options_t opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.disable_inotify = true;
+    vox_http_static_t* st = vox_http_static_create(STATIC_TEST_ROOT, &opts);
+    TEST_ASSERT_NOT_NULL(st, "创建静态文件服务失败");
+
+    vox_http_context_t ctx;
+    const char* h1[] = { "Range", "bytes=6-10" };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h1, 2);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 206, "单区间应返回206");
+    TEST_ASSERT_EQ(ctx.sendfile_offset, 6, "区间偏移不正确");
+    TEST_ASSERT_EQ(ctx.sendfile_count, 5, "区间长度不正确");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Range", "bytes 6-10/22"), "Content-Range 不正确");
+    static_ctx_done(&ctx);
+
+    const char* h2[] = { "Range", "bytes=0-1, -4" };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h2, 2);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 206, "多区间应返回206");
+    TEST_ASSERT(ctx.sendfile_file == NULL, "多区间不使用 sendfile");
+    vox_strview_t ct = static_res_header(&ctx, "Content-Type");
+    TEST_ASSERT(ct.ptr && ct.len > 20 && memcmp(ct.ptr, "multipart/byteranges", 20) == 0, "多区间类型不正确");
+    const char* body = vox_string_cstr(ctx.res.body);
+    TEST_ASSERT(strstr(body, "Content-Range: bytes 0-1/22\r\n\r\nhe\r\n") != NULL, "第一个区间不正确");
+    TEST_ASSERT(strstr(body, "Content-Range: bytes 18-21/22\r\n\r\n6789\r\n") != NULL, "后缀区间不正确");
+    char multi_len[32];
+    vox_strview_t cl = static_res_header(&ctx, "Content-Length");
+    snprintf(multi_len, sizeof(multi_len), "%.*s", (int)cl.len, cl.ptr);
+    TEST_ASSERT_EQ(strtoul(multi_len, NULL, 10), vox_string_length(ctx.res.body), "多区间 Content-Length 不正确");
+
+    /* HEAD 多区间：长度与 GET 一致且不生成响应体 */
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_HEAD, h2, 2);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 206, "HEAD 多区间应返回206");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Length", multi_len), "HEAD 多区间 Content-Length 应与 GET 一致");
+    TEST_ASSERT(ctx.res.body == NULL, "HEAD 多区间不应生成响应体");
+
+    const char* h3[] = { "Range", "bytes=100-200" };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h3, 2);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 416, "不可满足区间应返回416");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Range", "bytes */22"), "416 Content-Range 不正确");
+
+    /* 重叠与相邻的区间合并为单区间 */
+    const char* h7[] = { "Range", "bytes=4-8, 0-3, 2-6" };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h7, 2);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 206, "合并后的区间应返回206");
+    TEST_ASSERT_EQ(ctx.sendfile_offset, 0, "合并区间偏移不正确");
+    TEST_ASSERT_EQ(ctx.sendfile_count, 9, "合并区间长度不正确");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Range", "bytes 0-8/22"), "合并区间 Content-Range 不正确");
+    static_ctx_done(&ctx);
+
+    /* If-Range 不匹配时忽略 Range */
+    const char* h4[] = { "Range", "bytes=0-1", "If-Range", "\"other\"" };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h4, 4);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 200, "If-Range 不匹配应返回整个文件");
+    static_ctx_done(&ctx);
+
+    const char* h5[] = { "Accept-Encoding", "br, gzip;q=0.8" };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h5, 2);
+    vox_http_static_serve(st, &ctx, "/app.css", 8);
+    TEST_ASSERT(static_header_is(&ctx, "Content-Encoding", "gzip"), "应发送 .gz 预压缩文件");
+    TEST_ASSERT(static_header_is(&ctx, "Content-Type", "text/css"), "预压缩文件类型应为原文件类型");
+    TEST_ASSERT(static_header_is(&ctx, "Vary", "Accept-Encoding"), "缺少 Vary");
+    static_ctx_done(&ctx);
+
+    const char* h6[] = { "Accept-Encoding", "gzip;q=0" };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h6, 2);
+    vox_http_static_serve(st, &ctx, "/app.css", 8);
+    TEST_ASSERT(static_res_header(&ctx, "Content-Encoding").ptr == NULL, "q=0 不应发送 gzip");
+    TEST_ASSERT_EQ(ctx.sendfile_count, 6, "应发送原文件");
+    static_ctx_done(&ctx);
+
+    vox_http_static_destroy(st);
+
+    /* 多区间数据总量超过上限时返回整个文件 */
+    opts.max_multipart_bytes = 4;
+    st = vox_http_static_create(STATIC_TEST_ROOT, &opts);
+    TEST_ASSERT_NOT_NULL(st, "创建静态文件服务失败");
+    const char* h8[] = { "Range", "bytes=0-1, 10-14" };
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, h8, 2);
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.res.status, 200, "超过多区间上限应返回整个文件");
+    TEST_ASSERT_EQ(ctx.sendfile_count, 22, "应发送整个文件");
+    TEST_ASSERT(ctx.res.body == NULL, "超过上限不应在内存中拼接区间");
+    static_ctx_done(&ctx);
+
+    vox_http_static_destroy(st);
+    vox_file_rmdir(mpool, STATIC_TEST_ROOT, true);
+}
+
+#ifdef VOX_OS_LINUX
+/* 统计本进程 inotify 实例上的监听数（读 /proc/self/fdinfo） */
+static int static_count_inotify_watches(void) {
+    char path[64];
+    char link[64];
+    for (int fd = 0; fd < 1024; fd++) {
+        snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+        ssize_t n = readlink(path, link, sizeof(link) - 1);
+        if (n <= 0) continue;
+        link[n] = '\0';
+        if (strcmp(link, "anon_inode:inotify") != 0) continue;
+        snprintf(path, sizeof(path), "/proc/self/fdinfo/%d", fd);
+        FILE* f = fopen(path, "r");
+        if (!f) return -1;
+        char line[512];
+        int count = 0;
+        while (fgets(line, sizeof(line), f)) {
+            if (strncmp(line, "inotify wd:", 11) == 0) count++;
+        }
+        fclose(f);
+        return count;
+    }
+    return -1;
+}
+
+/* 测试 inotify 注册到 loop 后按事件失效缓存，淘汰时移除目录监听 */
+static void test_static_inotify(vox_mpool_t* mpool) {
+    static_test_setup(mpool);
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    vox_http_engine_t* engine = vox_http_engine_create(loop);
+    TEST_ASSERT_NOT_NULL(engine, "创建 engine 失败");
+    vox_http_static_options_t opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.max_entries = 1;
+    vox_http_static_t* st = vox_http_static_create(STATIC_TEST_ROOT, &opts);
+    TEST_ASSERT_NOT_NULL(st, "创建静态文件服务失败");
+    vox_http_static_stats_t stats;
+    vox_http_static_get_stats(st, &stats);
+    if (!stats.inotify) {
+        vox_http_static_destroy(st);
+        vox_http_engine_destroy(engine);
+        vox_loop_destroy(loop);
+        return;
+    }
+
+    vox_http_context_t ctx;
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    ctx.engine = engine;
+    TEST_ASSERT_EQ(vox_http_static_serve(st, &ctx, "/a.txt", 6), 0, "请求 a.txt 失败");
+    TEST_ASSERT_EQ(ctx.sendfile_count, 22, "发送长度不正确");
+    static_ctx_done(&ctx);
+    TEST_ASSERT_EQ(static_count_inotify_watches(), 1, "应监听 a.txt 所在目录");
+
+    /* 修改文件后由 loop 分发可读事件失效缓存 */
+    vox_file_write_all(mpool, STATIC_TEST_ROOT "/a.txt", "changed", 7);
+    vox_loop_run(loop, VOX_RUN_NOWAIT);
+    vox_http_static_get_stats(st, &stats);
+    TEST_ASSERT_EQ(stats.invalidations, 1, "文件修改后缓存项应失效");
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    ctx.engine = engine;
+    vox_http_static_serve(st, &ctx, "/a.txt", 6);
+    TEST_ASSERT_EQ(ctx.sendfile_count, 7, "失效后应重新加载文件");
+    static_ctx_done(&ctx);
+
+    /* max_entries=1：加载 sub/index.html 淘汰 a.txt，根目录的监听随之移除 */
+    static_ctx_init(&ctx, mpool, VOX_HTTP_METHOD_GET, NULL, 0);
+    ctx.engine = engine;
+    vox_http_static_serve(st, &ctx, "/sub/", 5);
+    static_ctx_done(&ctx);
+    TEST_ASSERT_EQ(static_count_inotify_watches(), 1, "淘汰后应只剩 sub 目录的监听");
+
+    vox_http_static_clear(st);
+    TEST_ASSERT_EQ(static_count_inotify_watches(), 0, "清空缓存后应移除全部监听");
+    vox_loop_run(loop, VOX_RUN_NOWAIT);
+
+    vox_http_static_destroy(st);
+    vox_http_engine_destroy(engine);
+    vox_loop_destroy(loop);
+    vox_file_rmdir(mpool, STATIC_TEST_ROOT, true);
+}
+#endif
+
+/* 测试套件 */
+test_case_t test_http_static_cases[] = {
+    {"basic", test_static_basic},
+    {"range_and_gzip", test_static_range_and_gzip},
+#ifdef VOX_OS_LINUX
+    {"inotify", test_static_inotify},
+#endif
+};
+
+test_suite_t test_http_static_suite = {
+    "vox_http_static",
+    test_http_static_cases,
+    sizeof(test_http_static_cases) / sizeof(test_http_static_cases[0])
+};
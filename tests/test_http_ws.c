@@ -10,9 +10,18 @@
 #include "../http/vox_http_ws.h"
 #include "../http/vox_http_context.h"
 #include "../http/vox_http_internal.h" /* internal create/feed */
+#include "../websocket/vox_websocket.h"
+#include "../websocket/vox_websocket_deflate.h"
+#include "../websocket/vox_websocket_server.h"
+#include "../websocket/vox_websocket_client.h"
+#include "../websocket/vox_websocket_hub.h"
+#include "../vox_loop.h"
+#include "../vox_tcp.h"
+#include "../vox_time.h"
 
 #include <string.h>
 #include <stdint.h>
+#include <stdio.h>
 
 static vox_strview_t find_res_header(const vox_http_response_t* res, const char* name) {
     if (!res || !name) return (vox_strview_t)VOX_STRVIEW_NULL;
@@ -163,9 +172,658 @@ static void test_ws_frame_text_binary_ping_close(vox_mpool_t* mpool) {
     }
 }
 
+/* 测试掩码：各种起始对齐与长度都与逐字节异或一致，两次掩码还原 */
+static void test_ws_mask_payload(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    static const uint8_t key[4] = {0x37, 0xfa, 0x21, 0x3d};
+    uint8_t buf[160];
+    uint8_t ref[160];
+    for (size_t off = 0; off < 16; off++) {
+        for (size_t len = 0; len + off <= sizeof(buf); len += 7) {
+            for (size_t i = 0; i < sizeof(buf); i++) buf[i] = ref[i] = (uint8_t)(i * 31 + off);
+            vox_ws_mask_payload(buf + off, len, key);
+            for (size_t i = 0; i < len; i++) ref[off + i] ^= key[i & 3];
+            TEST_ASSERT_EQ(memcmp(buf, ref, sizeof(buf)), 0, "掩码结果与逐字节异或不一致");
+            vox_ws_mask_payload(buf + off, len, key);
+            for (size_t i = 0; i < len; i++) ref[off + i] ^= key[i & 3];
+            TEST_ASSERT_EQ(memcmp(buf, ref, sizeof(buf)), 0, "两次掩码应还原数据");
+        }
+    }
+}
+
+/* 测试 UTF-8 验证：非法序列出现在块内、跨 16 字节边界与结尾 */
+static void test_ws_validate_utf8(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    static const struct {
+        const char* s;
+        bool ok;
+    } seqs[] = {
+        {"a", true},
+        {"\xc3\xa9", true},                 /* U+00E9 */
+        {"\xe4\xb8\xad", true},             /* U+4E2D */
+        {"\xf0\x9f\x98\x80", true},         /* U+1F600 */
+        {"\xf4\x8f\xbf\xbf", true},         /* U+10FFFF */
+        {"\xef\xbf\xbf", true},             /* U+FFFF */
+        {"\xc0\xaf", false},                 /* 过长编码 */
+        {"\xc1\xbf", false},
+        {"\xe0\x9f\xbf", false},
+        {"\xf0\x8f\xbf\xbf", false},
+        {"\xed\xa0\x80", false},             /* 代理区 U+D800 */
+        {"\xed\xbf\xbf", false},
+        {"\xf4\x90\x80\x80", false},         /* 超过 U+10FFFF */
+        {"\xf5\x80\x80\x80", false},
+        {"\x80", false},                     /* 孤立续字节 */
+        {"\xc3", false},                     /* 不完整 */
+        {"\xe4\xb8", false},
+        {"\xf0\x9f\x98", false},
+        {"\xc3\x28", false},
+        {"\xff", false},
+    };
+    TEST_ASSERT_TRUE(vox_ws_validate_utf8(NULL, 0), "空数据应有效");
+    TEST_ASSERT_FALSE(vox_ws_validate_utf8(NULL, 1), "NULL 数据应无效");
+
+    uint8_t buf[96];
+    for (size_t k = 0; k < sizeof(seqs) / sizeof(seqs[0]); k++) {
+        size_t slen = strlen(seqs[k].s);
+        /* 放在 ASCII 前缀之后的各个位置：覆盖块内、跨块与结尾 */
+        for (size_t pos = 0; pos + slen <= 40; pos++) {
+            for (size_t total = pos + slen; total <= 48; total += 8) {
+                memset(buf, 'x', sizeof(buf));
+                memcpy(buf + pos, seqs[k].s, slen);
+                bool got = vox_ws_validate_utf8(buf, total);
+                TEST_ASSERT_EQ(got, seqs[k].ok, "UTF-8 验证结果不正确");
+            }
+        }
+    }
+
+    /* 长的合法多字节文本 */
+    size_t n = 0;
+    while (n + 3 <= sizeof(buf)) {
+        memcpy(buf + n, "\xe4\xb8\xad", 3);
+        n += 3;
+    }
+    TEST_ASSERT_TRUE(vox_ws_validate_utf8(buf, n), "合法中文文本应有效");
+    TEST_ASSERT_FALSE(vox_ws_validate_utf8(buf, n - 1), "截断的中文文本应无效");
+}
+
+/* 测试未协商压缩时带 RSV1 的帧被拒绝 */
+static void test_ws_frame_rsv1_without_extension(vox_mpool_t* mpool) {
+    vox_http_ws_callbacks_t cbs;
+    memset(&cbs, 0, sizeof(cbs));
+    cbs.on_message = on_msg;
+    vox_http_ws_conn_t* ws = vox_http_ws_internal_create(mpool, NULL, &cbs);
+    TEST_ASSERT_NOT_NULL(ws, "创建 ws 失败");
+
+    uint8_t buf[64];
+    size_t n = build_masked_frame(0x1u, "hi", 2, buf, sizeof(buf));
+    TEST_ASSERT_GT(n, 0, "构造 text 帧失败");
+    buf[0] |= 0x40u;
+    g_msg_len = 0;
+    TEST_ASSERT_NE(vox_http_ws_internal_feed(ws, buf, n), 0, "未协商压缩时 RSV1 应为协议错误");
+    TEST_ASSERT_EQ(g_msg_len, 0, "RSV1 帧不应投递消息");
+}
+
+/* 运行 loop 直到 *counter >= target（最多 2 秒） */
+static void ws_run_until(vox_loop_t* loop, const int* counter, int target) {
+    vox_time_t start = vox_time_monotonic();
+    while (*counter < target && vox_time_diff_us(vox_time_monotonic(), start) < 2000000) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+    }
+}
+
+/* 在 127.0.0.1 的空闲端口上监听（先绑定端口 0 取得端口号） */
+static int ws_server_listen_any(vox_ws_server_t* server, vox_loop_t* loop, vox_socket_addr_t* addr) {
+    vox_socket_parse_address("127.0.0.1", 0, addr);
+    vox_tcp_t* probe = vox_tcp_create(loop);
+    if (!probe) return -1;
+    int ret = (vox_tcp_bind(probe, addr, 0) == 0 && vox_tcp_getsockname(probe, addr) == 0) ? 0 : -1;
+    vox_tcp_destroy(probe);
+    return ret == 0 ? vox_ws_server_listen(server, addr, 16) : -1;
+}
+
+#ifdef VOX_USE_ZLIB
+
+/* 测试服务端协商：跳过不可接受的提议，按配置收紧窗口 */
+static void test_ws_deflate_negotiate(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_ws_deflate_params_t params;
+    char resp[128];
+
+    static const char basic[] = "permessage-deflate; client_max_window_bits";
+    TEST_ASSERT_EQ(vox_ws_deflate_negotiate(NULL, basic, strlen(basic), &params), 0, "应接受基本提议");
+    TEST_ASSERT_EQ(params.server_max_window_bits, 15, "默认服务端窗口应为 15");
+    TEST_ASSERT_EQ(params.client_max_window_bits, 15, "默认客户端窗口应为 15");
+    TEST_ASSERT_FALSE(params.server_no_context_takeover || params.client_no_context_takeover, "默认保持上下文");
+    TEST_ASSERT_GT(vox_ws_deflate_format_response(&params, resp, sizeof(resp)), 0, "生成响应失败");
+    TEST_ASSERT_STR_EQ(resp, "permessage-deflate", "默认响应不正确");
+
+    vox_ws_deflate_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.server_max_window_bits = 10;
+    cfg.client_max_window_bits = 12;
+    cfg.client_no_context_takeover = true;
+    static const char offers[] =
+        "x-webkit-deflate-frame, "
+        "permessage-deflate; server_max_window_bits=8, "
+        "permessage-deflate; server_max_window_bits=\"11\"; client_max_window_bits";
+    TEST_ASSERT_EQ(vox_ws_deflate_negotiate(&cfg, offers, strlen(offers), &params), 0, "应接受第二个提议");
+    TEST_ASSERT_EQ(params.server_max_window_bits, 10, "服务端窗口应取配置上限");
+    TEST_ASSERT_EQ(params.client_max_window_bits, 12, "客户端窗口应取配置上限");
+    TEST_ASSERT_TRUE(params.client_no_context_takeover, "应要求客户端不保持上下文");
+    TEST_ASSERT_GT(vox_ws_deflate_format_response(&params, resp, sizeof(resp)), 0, "生成响应失败");
+    TEST_ASSERT_STR_EQ(resp, "permessage-deflate; client_no_context_takeover; server_max_window_bits=10; "
+                             "client_max_window_bits=12", "响应不正确");
+
+    /* 客户端没有声明 client_max_window_bits 时不能限制其窗口 */
+    static const char no_cmwb[] = "permessage-deflate";
+    TEST_ASSERT_EQ(vox_ws_deflate_negotiate(&cfg, no_cmwb, strlen(no_cmwb), &params), 0, "应接受提议");
+    TEST_ASSERT_EQ(params.client_max_window_bits, 15, "未声明时客户端窗口应为 15");
+
+    static const char* bad[] = {
+        "permessage-deflate; foo",
+        "permessage-deflate; server_max_window_bits=016",
+        "permessage-deflate; server_max_window_bits",
+        "permessage-deflate; server_no_context_takeover; server_no_context_takeover",
+        "permessage-deflate; client_no_context_takeover=1",
+        "deflate-frame",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        TEST_ASSERT_NE(vox_ws_deflate_negotiate(NULL, bad[i], strlen(bad[i]), &params), 0, "不合法的提议应被拒绝");
+    }
+}
+
+/* 测试客户端提议与响应校验 */
+static void test_ws_deflate_client_accept(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_ws_deflate_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.server_max_window_bits = 12;
+    char offer[128];
+    TEST_ASSERT_GT(vox_ws_deflate_format_offer(&cfg, offer, sizeof(offer)), 0, "生成提议失败");
+    TEST_ASSERT_STR_EQ(offer, "permessage-deflate; server_max_window_bits=12; client_max_window_bits", "提议不正确");
+
+    vox_ws_deflate_params_t params;
+    static const char ok[] = "permessage-deflate; server_max_window_bits=12; client_max_window_bits=10";
+    TEST_ASSERT_EQ(vox_ws_deflate_accept(&cfg, ok, strlen(ok), &params), 0, "应接受合法响应");
+    TEST_ASSERT_EQ(params.server_max_window_bits, 12, "服务端窗口不正确");
+    TEST_ASSERT_EQ(params.client_max_window_bits, 10, "客户端窗口应按响应缩小");
+
+    static const char* bad[] = {
+        "permessage-deflate; server_max_window_bits=15",  /* 超过提议的上限 */
+        "permessage-deflate; client_max_window_bits",     /* 响应中必须带值 */
+        "permessage-deflate; client_max_window_bits=8",   /* zlib 不支持 8 位压缩窗口 */
+        "permessage-deflate, permessage-deflate",
+        "x-unknown",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        TEST_ASSERT_NE(vox_ws_deflate_accept(&cfg, bad[i], strlen(bad[i]), &params), 0, "不合法的响应应被拒绝");
+    }
+}
+
+/* 测试压缩/解压：RFC 7692 示例、上下文接管、共享池与大小上限 */
+static void test_ws_deflate_roundtrip(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    vox_ws_deflate_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.min_size = 1;
+    vox_ws_deflate_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.server_max_window_bits = 15;
+    params.client_max_window_bits = 15;
+
+    vox_ws_deflate_t* srv = vox_ws_deflate_create(loop, mpool, &cfg, &params, true);
+    vox_ws_deflate_t* cli = vox_ws_deflate_create(loop, mpool, &cfg, &params, false);
+    TEST_ASSERT_TRUE(srv && cli, "创建压缩状态失败");
+    vox_string_t* z = vox_string_create(mpool);
+    vox_string_t* out = vox_string_create(mpool);
+
+    /* RFC 7692 7.2.3.1："Hello" 压缩为 f2 48 cd c9 c9 07 00 */
+    static const uint8_t hello_z[] = {0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00};
+    TEST_ASSERT_EQ(vox_ws_deflate_compress(srv, "Hello", 5, z), 1, "压缩失败");
+    TEST_ASSERT_EQ(vox_string_length(z), sizeof(hello_z), "压缩长度不正确");
+    TEST_ASSERT_EQ(memcmp(vox_string_data(z), hello_z, sizeof(hello_z)), 0, "压缩结果与 RFC 示例不一致");
+    TEST_ASSERT_EQ(vox_ws_deflate_decompress(cli, hello_z, sizeof(hello_z), out), 0, "解压失败");
+    TEST_ASSERT_EQ(vox_string_length(out), 5, "解压长度不正确");
+    TEST_ASSERT_EQ(memcmp(vox_string_data(out), "Hello", 5), 0, "解压内容不正确");
+
+    /* 保持上下文：重复的消息第二次压缩得更小 */
+    static const char json[] = "{\"symbol\":\"BTC-USDT\",\"bid\":64012.5,\"ask\":64013.0,\"volume\":1532.25}";
+    size_t first = 0;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQ(vox_ws_deflate_compress(cli, json, sizeof(json) - 1, z), 1, "压缩失败");
+        if (i == 0) first = vox_string_length(z);
+        else TEST_ASSERT_LT(vox_string_length(z), first, "保持上下文时重复消息应压缩得更小");
+        TEST_ASSERT_EQ(vox_ws_deflate_decompress(srv, vox_string_data(z), vox_string_length(z), out), 0, "解压失败");
+        TEST_ASSERT_EQ(vox_string_length(out), sizeof(json) - 1, "解压长度不正确");
+        TEST_ASSERT_EQ(memcmp(vox_string_data(out), json, sizeof(json) - 1), 0, "解压内容不正确");
+    }
+    vox_ws_deflate_destroy(srv);
+    vox_ws_deflate_destroy(cli);
+
+    /* 不保持上下文：每条消息借用池中的流，用完放回 */
+    params.server_no_context_takeover = true;
+    params.client_no_context_takeover = true;
+    params.server_max_window_bits = 10;
+    cfg.max_message_size = 1024;
+    vox_ws_deflate_stats_t before, after;
+    TEST_ASSERT_EQ(vox_ws_deflate_get_stats(loop, &before), 0, "获取统计失败");
+    srv = vox_ws_deflate_create(loop, mpool, &cfg, &params, true);
+    cli = vox_ws_deflate_create(loop, mpool, &cfg, &params, false);
+    TEST_ASSERT_TRUE(srv && cli, "创建压缩状态失败");
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQ(vox_ws_deflate_compress(srv, json, sizeof(json) - 1, z), 1, "压缩失败");
+        TEST_ASSERT_EQ(vox_ws_deflate_decompress(cli, vox_string_data(z), vox_string_length(z), out), 0, "解压失败");
+        TEST_ASSERT_EQ(memcmp(vox_string_data(out), json, sizeof(json) - 1), 0, "解压内容不正确");
+    }
+    TEST_ASSERT_EQ(vox_ws_deflate_get_stats(loop, &after), 0, "获取统计失败");
+    TEST_ASSERT_EQ(after.streams_created - before.streams_created, 2, "只应创建一个压缩流和一个解压流");
+    TEST_ASSERT_EQ(after.streams_reused - before.streams_reused, 6, "后续消息应复用池中的流");
+    TEST_ASSERT_EQ(after.idle_streams, 2, "流应放回池中");
+
+    /* 不可压缩的短消息原样发送 */
+    TEST_ASSERT_EQ(vox_ws_deflate_compress(srv, "ab", 2, z), 0, "压缩后没有变小的消息应原样发送");
+
+    /* 解压大小上限与损坏数据 */
+    uint8_t big[4096];
+    memset(big, 'a', sizeof(big));
+    TEST_ASSERT_EQ(vox_ws_deflate_compress(srv, big, sizeof(big), z), 1, "压缩失败");
+    TEST_ASSERT_EQ(vox_ws_deflate_decompress(cli, vox_string_data(z), vox_string_length(z), out), -2,
+                   "超过 max_message_size 应返回 -2");
+    static const uint8_t garbage[] = {0xff, 0xff, 0xff, 0xff, 0x00};
+    TEST_ASSERT_EQ(vox_ws_deflate_decompress(cli, garbage, sizeof(garbage), out), -1, "损坏数据应返回 -1");
+    TEST_ASSERT_EQ(vox_ws_deflate_decompress(cli, vox_string_data(z), 0, out), 0, "失败后仍可继续解压");
+
+    vox_ws_deflate_destroy(srv);
+    vox_ws_deflate_destroy(cli);
+    vox_string_destroy(z);
+    vox_string_destroy(out);
+    vox_loop_destroy(loop);
+}
+
+/* 测试 http 升级时协商 permessage-deflate */
+static void test_ws_upgrade_deflate(vox_mpool_t* mpool) {
+    vox_http_context_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.mpool = mpool;
+    vox_vector_t* req_headers = vox_vector_create(mpool);
+    TEST_ASSERT_NOT_NULL(req_headers, "创建 req headers 失败");
+    vox_vector_push(req_headers, make_header(mpool, "Connection", "Upgrade"));
+    vox_vector_push(req_headers, make_header(mpool, "Upgrade", "websocket"));
+    vox_vector_push(req_headers, make_header(mpool, "Sec-WebSocket-Version", "13"));
+    vox_vector_push(req_headers, make_header(mpool, "Sec-WebSocket-Key", "dGhlIHNhbXBsZSBub25jZQ=="));
+    vox_vector_push(req_headers, make_header(mpool, "Sec-WebSocket-Extensions", "x-unknown"));
+    vox_vector_push(req_headers, make_header(mpool, "Sec-WebSocket-Extensions",
+                                             "permessage-deflate; client_max_window_bits"));
+    ctx.req.headers = req_headers;
+    ctx.req.http_major = 1;
+    ctx.req.http_minor = 1;
+
+    vox_http_ws_callbacks_t cbs;
+    memset(&cbs, 0, sizeof(cbs));
+    vox_ws_deflate_config_t cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.server_no_context_takeover = true;
+    TEST_ASSERT_EQ(vox_http_ws_upgrade_ex(&ctx, &cbs, &cfg), 0, "ws upgrade 失败");
+    vox_strview_t ext = find_res_header(&ctx.res, "Sec-WebSocket-Extensions");
+    TEST_ASSERT_NOT_NULL(ext.ptr, "缺少 Sec-WebSocket-Extensions");
+    static const char expect[] = "permessage-deflate; server_no_context_takeover";
+    TEST_ASSERT_EQ(ext.len, sizeof(expect) - 1, "扩展响应长度不正确");
+    TEST_ASSERT_EQ(memcmp(ext.ptr, expect, ext.len), 0, "扩展响应不正确");
+}
+
+/* ===== vox_ws_server 与 vox_ws_client 之间的压缩回显 ===== */
+typedef struct {
+    vox_ws_client_t* client;
+    int connected;
+    int received;
+    int errors;
+    size_t server_len;
+    size_t client_len;
+    char server_msg[512];
+    char client_msg[512];
+} ws_echo_state_t;
+
+static ws_echo_state_t g_echo;
+
+static void echo_server_on_message(vox_ws_connection_t* conn, const void* data, size_t len,
+                                   vox_ws_message_type_t type, void* user_data) {
+    VOX_UNUSED(user_data);
+    VOX_UNUSED(type);
+    g_echo.server_len = len < sizeof(g_echo.server_msg) ? len : sizeof(g_echo.server_msg);
+    memcpy(g_echo.server_msg, data, g_echo.server_len);
+    vox_ws_connection_send_text(conn, (const char*)data, len);
+}
+
+static void echo_client_on_connect(vox_ws_client_t* client, void* user_data) {
+    VOX_UNUSED(client);
+    VOX_UNUSED(user_data);
+    g_echo.connected = 1;
+}
+
+static void echo_client_on_message(vox_ws_client_t* client, const void* data, size_t len,
+                                   vox_ws_message_type_t type, void* user_data) {
+    VOX_UNUSED(client);
+    VOX_UNUSED(type);
+    VOX_UNUSED(user_data);
+    g_echo.client_len = len < sizeof(g_echo.client_msg) ? len : sizeof(g_echo.client_msg);
+    memcpy(g_echo.client_msg, data, g_echo.client_len);
+    g_echo.received++;
+}
+
+static void echo_client_on_error(vox_ws_client_t* client, const char* error, void* user_data) {
+    VOX_UNUSED(client);
+    VOX_UNUSED(error);
+    VOX_UNUSED(user_data);
+    g_echo.errors++;
+}
+
+static void test_ws_deflate_server_client(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    memset(&g_echo, 0, sizeof(g_echo));
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+
+    vox_ws_server_config_t scfg;
+    memset(&scfg, 0, sizeof(scfg));
+    scfg.loop = loop;
+    scfg.on_message = echo_server_on_message;
+    scfg.enable_compression = true;
+    scfg.compression.server_max_window_bits = 11;
+    vox_ws_server_t* server = vox_ws_server_create(&scfg);
+    TEST_ASSERT_NOT_NULL(server, "创建服务端失败");
+
+    vox_socket_addr_t addr;
+    TEST_ASSERT_EQ(ws_server_listen_any(server, loop, &addr), 0, "监听失败");
+
+    char url[64];
+    snprintf(url, sizeof(url), "ws://127.0.0.1:%u/", (unsigned)vox_socket_get_port(&addr));
+    vox_ws_client_config_t ccfg;
+    memset(&ccfg, 0, sizeof(ccfg));
+    ccfg.loop = loop;
+    ccfg.url = url;
+    ccfg.on_connect = echo_client_on_connect;
+    ccfg.on_message = echo_client_on_message;
+    ccfg.on_error = echo_client_on_error;
+    ccfg.enable_compression = true;
+    ccfg.compression.client_no_context_takeover = true;
+    vox_ws_client_t* client = vox_ws_client_create(&ccfg);
+    TEST_ASSERT_NOT_NULL(client, "创建客户端失败");
+    TEST_ASSERT_EQ(vox_ws_client_connect(client), 0, "连接失败");
+    ws_run_until(loop, &g_echo.connected, 1);
+    TEST_ASSERT_EQ(g_echo.connected, 1, "握手未完成");
+
+    vox_ws_deflate_stats_t before, after;
+    TEST_ASSERT_EQ(vox_ws_deflate_get_stats(loop, &before), 0, "获取统计失败");
+    static const char json[] = "{\"channel\":\"ticker\",\"data\":[{\"symbol\":\"ETH-USDT\",\"last\":3120.5},"
+                               "{\"symbol\":\"ETH-USDT\",\"last\":3120.5}]}";
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQ(vox_ws_client_send_text(client, json, sizeof(json) - 1), 0, "发送失败");
+        ws_run_until(loop, &g_echo.received, i + 1);
+        TEST_ASSERT_EQ(g_echo.received, i + 1, "未收到回显");
+        TEST_ASSERT_EQ(g_echo.server_len, sizeof(json) - 1, "服务端收到的消息长度不正确");
+        TEST_ASSERT_EQ(memcmp(g_echo.server_msg, json, sizeof(json) - 1), 0, "服务端收到的消息不正确");
+        TEST_ASSERT_EQ(g_echo.client_len, sizeof(json) - 1, "客户端收到的消息长度不正确");
+        TEST_ASSERT_EQ(memcmp(g_echo.client_msg, json, sizeof(json) - 1), 0, "客户端收到的消息不正确");
+    }
+    TEST_ASSERT_EQ(vox_ws_deflate_get_stats(loop, &after), 0, "获取统计失败");
+    /* 客户端压缩流与服务端解压流不保持上下文：第二条消息复用池中的流 */
+    TEST_ASSERT_GE(after.streams_reused - before.streams_reused, 2, "不保持上下文的方向应复用池中的流");
+    TEST_ASSERT_GE(after.streams_created - before.streams_created, 4, "双方都应使用压缩");
+    TEST_ASSERT_EQ(g_echo.errors, 0, "不应出现错误");
+
+    vox_ws_client_destroy(client);
+    vox_ws_server_destroy(server);
+    for (int i = 0; i < 50; i++) vox_loop_run(loop, VOX_RUN_ONCE);
+    vox_loop_destroy(loop);
+}
+
+#endif /* VOX_USE_ZLIB */
+
+/* 测试共享帧与 vox_ws_build_frame 的编码一致 */
+static void test_ws_build_frame_bytes(vox_mpool_t* mpool) {
+    static const size_t sizes[] = {0, 5, 125, 126, 300, 70000};
+    uint8_t* payload = (uint8_t*)vox_mpool_alloc(mpool, 70000);
+    TEST_ASSERT_NOT_NULL(payload, "分配负载失败");
+    for (size_t i = 0; i < 70000; i++) payload[i] = (uint8_t)(i * 31u);
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        void* frame;
+        size_t frame_len;
+        TEST_ASSERT_EQ(vox_ws_build_frame(mpool, VOX_WS_OP_BINARY, payload, sizes[i], false, &frame, &frame_len), 0,
+                       "构造帧失败");
+        vox_bytes_t bytes = VOX_BYTES_NULL;
+        TEST_ASSERT_EQ(vox_ws_build_frame_bytes(mpool, VOX_WS_OP_BINARY, payload, sizes[i], &bytes), 0,
+                       "构造共享帧失败");
+        TEST_ASSERT_EQ(bytes.len, frame_len, "共享帧长度不正确");
+        TEST_ASSERT_EQ(memcmp(bytes.ptr, frame, frame_len), 0, "共享帧内容不正确");
+        TEST_ASSERT_EQ(vox_bytes_refcount(&bytes), 1, "引用计数应为 1");
+        vox_bytes_release(&bytes);
+        vox_mpool_free(mpool, frame);
+    }
+    vox_mpool_free(mpool, payload);
+}
+
+/* ===== vox_ws_hub：订阅、一次编码广播与慢消费者 ===== */
+#define HUB_TEST_CLIENTS 3
+
+typedef struct {
+    vox_ws_client_t* client;
+    int connected;
+    int received;
+    int closed;
+    char last[64];
+} hub_client_t;
+
+static vox_ws_hub_t* g_hub;
+static hub_client_t g_hub_clients[HUB_TEST_CLIENTS];
+static int g_hub_commands;
+static int g_hub_server_errors;
+
+/* 客户端命令："sub:<频道>"、"unsub:<频道>"、"drop"、"kick"（慢消费者策略，上限 1 字节） */
+static void hub_server_on_message(vox_ws_connection_t* conn, const void* data, size_t len,
+                                  vox_ws_message_type_t type, void* user_data) {
+    VOX_UNUSED(type);
+    VOX_UNUSED(user_data);
+    char cmd[64];
+    if (len >= sizeof(cmd)) len = sizeof(cmd) - 1;
+    memcpy(cmd, data, len);
+    cmd[len] = '\0';
+    if (strncmp(cmd, "sub:", 4) == 0) {
+        vox_ws_hub_subscribe(g_hub, conn, cmd + 4);
+    } else if (strncmp(cmd, "unsub:", 6) == 0) {
+        vox_ws_hub_unsubscribe(g_hub, conn, cmd + 6);
+    } else if (strcmp(cmd, "drop") == 0) {
+        vox_ws_hub_set_backpressure(g_hub, conn, VOX_WS_HUB_SLOW_DROP, 1);
+    } else if (strcmp(cmd, "kick") == 0) {
+        vox_ws_hub_set_backpressure(g_hub, conn, VOX_WS_HUB_SLOW_DISCONNECT, 1);
+    }
+    g_hub_commands++;
+}
+
+static void hub_server_on_error(vox_ws_connection_t* conn, const char* error, void* user_data) {
+    VOX_UNUSED(conn);
+    VOX_UNUSED(user_data);
+    if (strcmp(error, "Slow consumer") == 0) g_hub_server_errors++;
+}
+
+static void hub_client_on_connect(vox_ws_client_t* client, void* user_data) {
+    VOX_UNUSED(client);
+    ((hub_client_t*)user_data)->connected = 1;
+}
+
+static void hub_client_on_message(vox_ws_client_t* client, const void* data, size_t len,
+                                  vox_ws_message_type_t type, void* user_data) {
+    VOX_UNUSED(client);
+    VOX_UNUSED(type);
+    hub_client_t* c = (hub_client_t*)user_data;
+    if (len >= sizeof(c->last)) len = sizeof(c->last) - 1;
+    memcpy(c->last, data, len);
+    c->last[len] = '\0';
+    c->received++;
+}
+
+static void hub_client_on_close(vox_ws_client_t* client, uint16_t code, const char* reason, void* user_data) {
+    VOX_UNUSED(client);
+    VOX_UNUSED(code);
+    VOX_UNUSED(reason);
+    ((hub_client_t*)user_data)->closed = 1;
+}
+
+static void hub_client_on_error(vox_ws_client_t* client, const char* error, void* user_data) {
+    VOX_UNUSED(client);
+    VOX_UNUSED(error);
+    ((hub_client_t*)user_data)->closed = 1;
+}
+
+/* 发送命令并等待服务端处理 */
+static int hub_command(vox_loop_t* loop, int idx, const char* cmd) {
+    int expect = g_hub_commands + 1;
+    if (vox_ws_client_send_text(g_hub_clients[idx].client, cmd, strlen(cmd)) != 0) return -1;
+    ws_run_until(loop, &g_hub_commands, expect);
+    return g_hub_commands == expect ? 0 : -1;
+}
+
+/* 运行 loop 直到各客户端收到的消息数达到 expect */
+static void hub_wait_received(vox_loop_t* loop, const int* expect) {
+    for (int k = 0; k < HUB_TEST_CLIENTS; k++) {
+        ws_run_until(loop, &g_hub_clients[k].received, expect[k]);
+    }
+}
+
+static void test_ws_hub_broadcast(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    memset(g_hub_clients, 0, sizeof(g_hub_clients));
+    g_hub_commands = 0;
+    g_hub_server_errors = 0;
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建 loop 失败");
+    g_hub = vox_ws_hub_create(loop, NULL);
+    TEST_ASSERT_NOT_NULL(g_hub, "创建 hub 失败");
+
+    vox_ws_server_config_t scfg;
+    memset(&scfg, 0, sizeof(scfg));
+    scfg.loop = loop;
+    scfg.on_message = hub_server_on_message;
+    scfg.on_error = hub_server_on_error;
+    vox_ws_server_t* server = vox_ws_server_create(&scfg);
+    TEST_ASSERT_NOT_NULL(server, "创建服务端失败");
+    vox_socket_addr_t addr;
+    TEST_ASSERT_EQ(ws_server_listen_any(server, loop, &addr), 0, "监听失败");
+
+    char url[64];
+    snprintf(url, sizeof(url), "ws://127.0.0.1:%u/", (unsigned)vox_socket_get_port(&addr));
+    for (int k = 0; k < HUB_TEST_CLIENTS; k++) {
+        vox_ws_client_config_t ccfg;
+        memset(&ccfg, 0, sizeof(ccfg));
+        ccfg.loop = loop;
+        ccfg.url = url;
+        ccfg.on_connect = hub_client_on_connect;
+        ccfg.on_message = hub_client_on_message;
+        ccfg.on_close = hub_client_on_close;
+        ccfg.on_error = hub_client_on_error;
+        ccfg.user_data = &g_hub_clients[k];
+        g_hub_clients[k].client = vox_ws_client_create(&ccfg);
+        TEST_ASSERT_NOT_NULL(g_hub_clients[k].client, "创建客户端失败");
+        TEST_ASSERT_EQ(vox_ws_client_connect(g_hub_clients[k].client), 0, "连接失败");
+        ws_run_until(loop, &g_hub_clients[k].connected, 1);
+        TEST_ASSERT_EQ(g_hub_clients[k].connected, 1, "握手未完成");
+        TEST_ASSERT_EQ(hub_command(loop, k, "sub:ticker"), 0, "订阅失败");
+    }
+    TEST_ASSERT_EQ(hub_command(loop, 0, "sub:ticker"), 0, "重复订阅失败");
+    TEST_ASSERT_EQ(hub_command(loop, 0, "sub:trades"), 0, "订阅失败");
+    TEST_ASSERT_EQ(vox_ws_hub_subscriber_count(g_hub, "ticker"), HUB_TEST_CLIENTS, "重复订阅不应重复计数");
+    TEST_ASSERT_EQ(vox_ws_hub_publish_text(g_hub, "nobody", "x", 1), 0, "没有订阅者的频道应返回0");
+
+    /* 一次编码，所有订阅者共享同一份帧 */
+    vox_bytes_t frame = VOX_BYTES_NULL;
+    TEST_ASSERT_EQ(vox_ws_build_frame_bytes(vox_loop_get_mpool(loop), VOX_WS_OP_TEXT, "tick-1", 6, &frame), 0,
+                   "构造共享帧失败");
+    TEST_ASSERT_EQ(vox_ws_hub_publish_frame(g_hub, "ticker", &frame), HUB_TEST_CLIENTS, "应排入所有订阅者");
+    int expect[HUB_TEST_CLIENTS] = {1, 1, 1};
+    hub_wait_received(loop, expect);
+    for (int k = 0; k < HUB_TEST_CLIENTS; k++) {
+        TEST_ASSERT_EQ(g_hub_clients[k].received, 1, "订阅者未收到消息");
+        TEST_ASSERT_STR_EQ(g_hub_clients[k].last, "tick-1", "消息内容不正确");
+    }
+    /* 写完后各连接的引用都已释放 */
+    TEST_ASSERT_EQ(vox_bytes_refcount(&frame), 1, "写完后连接应释放共享帧");
+    vox_bytes_release(&frame);
+
+    TEST_ASSERT_EQ(vox_ws_hub_publish_text(g_hub, "trades", "trade-1", 7), 1, "只有一个订阅者");
+    expect[0] = 2;
+    hub_wait_received(loop, expect);
+    TEST_ASSERT_STR_EQ(g_hub_clients[0].last, "trade-1", "消息内容不正确");
+    TEST_ASSERT_EQ(g_hub_clients[1].received, 1, "未订阅的连接不应收到消息");
+
+    /* 退订 */
+    TEST_ASSERT_EQ(hub_command(loop, 1, "unsub:ticker"), 0, "退订失败");
+    TEST_ASSERT_EQ(vox_ws_hub_subscriber_count(g_hub, "ticker"), HUB_TEST_CLIENTS - 1, "退订后数量不正确");
+    TEST_ASSERT_EQ(vox_ws_hub_publish_text(g_hub, "ticker", "tick-2", 6), HUB_TEST_CLIENTS - 1, "排入数量不正确");
+    expect[0] = 3;
+    expect[2] = 2;
+    hub_wait_received(loop, expect);
+    TEST_ASSERT_STR_EQ(g_hub_clients[2].last, "tick-2", "消息内容不正确");
+    TEST_ASSERT_EQ(g_hub_clients[1].received, 1, "已退订的连接不应收到消息");
+
+    /* 慢消费者：丢弃 */
+    TEST_ASSERT_EQ(hub_command(loop, 2, "drop"), 0, "设置背压失败");
+    vox_ws_hub_stats_t stats;
+    TEST_ASSERT_EQ(vox_ws_hub_publish_text(g_hub, "ticker", "tick-3", 6), 1, "超过上限的连接应被跳过");
+    vox_ws_hub_get_stats(g_hub, &stats);
+    TEST_ASSERT_EQ(stats.frames_dropped, 1, "丢弃计数不正确");
+    expect[0] = 4;
+    hub_wait_received(loop, expect);
+    TEST_ASSERT_EQ(g_hub_clients[2].received, 2, "丢弃策略下不应收到消息");
+    TEST_ASSERT_EQ(vox_ws_hub_subscriber_count(g_hub, "ticker"), 2, "丢弃策略不应退订");
+
+    /* 慢消费者：断开，连接关闭后自动退出所有频道 */
+    TEST_ASSERT_EQ(hub_command(loop, 0, "kick"), 0, "设置背压失败");
+    TEST_ASSERT_EQ(vox_ws_hub_publish_text(g_hub, "ticker", "tick-4", 6), 0, "超过上限的连接都应被跳过");
+    vox_ws_hub_get_stats(g_hub, &stats);
+    TEST_ASSERT_EQ(stats.slow_disconnects, 1, "断开计数不正确");
+    TEST_ASSERT_EQ(g_hub_server_errors, 1, "应以 Slow consumer 回调 on_error");
+    TEST_ASSERT_EQ(vox_ws_hub_subscriber_count(g_hub, "ticker"), 1, "断开的连接应退出频道");
+    TEST_ASSERT_EQ(vox_ws_hub_subscriber_count(g_hub, "trades"), 0, "断开的连接应退出所有频道");
+    vox_ws_hub_get_stats(g_hub, &stats);
+    TEST_ASSERT_EQ(stats.channels, 1, "没有订阅者的频道应删除");
+    TEST_ASSERT_EQ(stats.subscriptions, 1, "订阅计数不正确");
+    ws_run_until(loop, &g_hub_clients[0].closed, 1);
+    TEST_ASSERT_EQ(g_hub_clients[0].closed, 1, "被断开的客户端应收到关闭");
+
+    /* 客户端主动断开 */
+    vox_ws_client_destroy(g_hub_clients[2].client);
+    g_hub_clients[2].client = NULL;
+    vox_time_t start = vox_time_monotonic();
+    while (vox_ws_hub_subscriber_count(g_hub, "ticker") > 0 &&
+           vox_time_diff_us(vox_time_monotonic(), start) < 2000000) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+    }
+    TEST_ASSERT_EQ(vox_ws_hub_subscriber_count(g_hub, "ticker"), 0, "对端关闭后应退出频道");
+
+    vox_ws_hub_destroy(g_hub);
+    g_hub = NULL;
+    for (int k = 0; k < HUB_TEST_CLIENTS; k++) vox_ws_client_destroy(g_hub_clients[k].client);
+    vox_ws_server_destroy(server);
+    vox_loop_run(loop, VOX_RUN_DEFAULT);
+    vox_loop_destroy(loop);
+}
+
 test_case_t test_http_ws_cases[] = {
     {"handshake_accept", test_ws_handshake_accept},
     {"frame_text_binary_ping_close", test_ws_frame_text_binary_ping_close},
+    {"mask_payload", test_ws_mask_payload},
+    {"validate_utf8", test_ws_validate_utf8},
+    {"frame_rsv1_without_extension", test_ws_frame_rsv1_without_extension},
+    {"build_frame_bytes", test_ws_build_frame_bytes},
+    {"hub_broadcast", test_ws_hub_broadcast},
+#ifdef VOX_USE_ZLIB
+    {"deflate_negotiate", test_ws_deflate_negotiate},
+    {"deflate_client_accept", test_ws_deflate_client_accept},
+    {"deflate_roundtrip", test_ws_deflate_roundtrip},
+    {"upgrade_deflate", test_ws_upgrade_deflate},
+    {"deflate_server_client", test_ws_deflate_server_client},
+#endif
 };
 
 test_suite_t test_http_ws_suite = {
@@ -0,0 +1,200 @@
+/* ============================================================
+ * test_loop.c - vox_loop 跨线程回调队列测试
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../vox_loop.h"
+#include "../vox_timer.h"
+#include "../vox_time.h"
+#include "../vox_thread.h"
+#include "../vox_atomic.h"
+
+#define LOOP_TEST_PRODUCERS 4
+#define LOOP_TEST_PER_PRODUCER 20000
+
+typedef struct {
+    vox_loop_t* loop;
+    vox_atomic_int_t* done;
+    int order[64];
+    int order_n;
+} loop_test_ctx_t;
+
+static void count_cb(vox_loop_t* loop, void* user_data) {
+    VOX_UNUSED(loop);
+    vox_atomic_int_increment((vox_atomic_int_t*)user_data);
+}
+
+static int producer_thread(void* user_data) {
+    loop_test_ctx_t* ctx = (loop_test_ctx_t*)user_data;
+    for (int i = 0; i < LOOP_TEST_PER_PRODUCER; i++) {
+        if (vox_loop_queue_work(ctx->loop, count_cb, ctx->done) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* 测试多线程并发提交：无界队列不丢任务，全部在 loop 线程执行 */
+static void test_loop_queue_work_mpsc(vox_mpool_t* mpool) {
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    loop_test_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.loop = loop;
+    ctx.done = vox_atomic_int_create(mpool, 0);
+    TEST_ASSERT_NOT_NULL(ctx.done, "创建原子计数失败");
+
+    vox_thread_t* threads[LOOP_TEST_PRODUCERS];
+    for (int i = 0; i < LOOP_TEST_PRODUCERS; i++) {
+        threads[i] = vox_thread_create(mpool, producer_thread, &ctx);
+        TEST_ASSERT_NOT_NULL(threads[i], "创建生产者线程失败");
+    }
+
+    const int total = LOOP_TEST_PRODUCERS * LOOP_TEST_PER_PRODUCER;
+    for (int i = 0; i < 10000 && vox_atomic_int_load(ctx.done) < total; i++) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+    }
+    for (int i = 0; i < LOOP_TEST_PRODUCERS; i++) {
+        int code = -1;
+        vox_thread_join(threads[i], &code);
+        TEST_ASSERT_EQ(code, 0, "提交不应失败");
+    }
+    while (vox_atomic_int_load(ctx.done) < total) {
+        vox_loop_run(loop, VOX_RUN_NOWAIT);
+    }
+    TEST_ASSERT_EQ(vox_atomic_int_load(ctx.done), total, "执行的回调数量不正确");
+
+    vox_atomic_int_destroy(ctx.done);
+    vox_loop_destroy(loop);
+}
+
+typedef struct {
+    vox_loop_work_t work;
+    loop_test_ctx_t* ctx;
+    int id;
+    int remaining;
+} loop_test_node_t;
+
+static void node_cb(vox_loop_t* loop, void* user_data) {
+    loop_test_node_t* node = (loop_test_node_t*)user_data;
+    loop_test_ctx_t* ctx = node->ctx;
+    if (ctx->order_n < (int)(sizeof(ctx->order) / sizeof(ctx->order[0]))) {
+        ctx->order[ctx->order_n++] = node->id;
+    }
+    /* 回调内可以重新入队同一个工作项 */
+    if (--node->remaining > 0) {
+        vox_loop_queue_work_node(loop, &node->work, node_cb, node);
+    }
+}
+
+/* 测试调用方提供的工作项：先进先出，回调内可复用 */
+static void test_loop_queue_work_node(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    loop_test_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    loop_test_node_t nodes[3];
+    for (int i = 0; i < 3; i++) {
+        nodes[i].ctx = &ctx;
+        nodes[i].id = i;
+        nodes[i].remaining = 2;
+        TEST_ASSERT_EQ(vox_loop_queue_work_node(loop, &nodes[i].work, node_cb, &nodes[i]), 0, "入队失败");
+    }
+    TEST_ASSERT_NE(vox_loop_queue_work_node(loop, NULL, node_cb, NULL), 0, "空工作项应失败");
+
+    for (int i = 0; i < 10 && ctx.order_n < 6; i++) {
+        vox_loop_run(loop, VOX_RUN_NOWAIT);
+    }
+    TEST_ASSERT_EQ(ctx.order_n, 6, "回调执行次数不正确");
+    static const int expected[6] = {0, 1, 2, 0, 1, 2};
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_EQ(ctx.order[i], expected[i], "回调顺序不正确");
+    }
+
+    vox_loop_destroy(loop);
+}
+
+static void timer_order_cb(vox_timer_t* timer, void* user_data) {
+    VOX_UNUSED(timer);
+    loop_test_ctx_t* ctx = (loop_test_ctx_t*)user_data;
+    if (ctx->order_n < 64) ctx->order[ctx->order_n++] = (int)(timer->timeout / 1000);
+}
+
+/* 测试定时器按到期时间触发（与启动顺序无关） */
+static void test_loop_timer_order(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+    loop_test_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    static const uint64_t delays[5] = {40, 10, 30, 50, 20};
+    vox_timer_t timers[5];
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQ(vox_timer_init(&timers[i], loop), 0, "初始化定时器失败");
+        TEST_ASSERT_EQ(vox_timer_start(&timers[i], delays[i], 0, timer_order_cb, &ctx), 0, "启动定时器失败");
+    }
+    vox_time_t deadline = vox_time_monotonic() + 2000000;
+    while (ctx.order_n < 5 && vox_time_monotonic() < deadline) {
+        vox_loop_run(loop, VOX_RUN_ONCE);
+    }
+    TEST_ASSERT_EQ(ctx.order_n, 5, "定时器触发次数不正确");
+    for (int i = 1; i < 5; i++) {
+        TEST_ASSERT_LT(ctx.order[i - 1], ctx.order[i], "定时器应按到期时间触发");
+    }
+
+    vox_loop_destroy(loop);
+}
+
+static void timer_restart_cb(vox_timer_t* timer, void* user_data) {
+    int* fired = (int*)user_data;
+    /* 一次性定时器在自己的回调中重新启动 */
+    if (++*fired < 2) vox_timer_start(timer, 10, 0, timer_restart_cb, fired);
+}
+
+static void timer_count_cb(vox_timer_t* timer, void* user_data) {
+    VOX_UNUSED(timer);
+    ++*(int*)user_data;
+}
+
+/* 测试弱定时器不阻止 loop 退出，以及回调内重启一次性定时器 */
+static void test_loop_timer_weak(vox_mpool_t* mpool) {
+    VOX_UNUSED(mpool);
+    vox_loop_t* loop = vox_loop_create();
+    TEST_ASSERT_NOT_NULL(loop, "创建事件循环失败");
+
+    int weak_fired = 0, fired = 0;
+    vox_timer_t weak, strong;
+    vox_timer_init(&weak, loop);
+    vox_timer_init(&strong, loop);
+    TEST_ASSERT_EQ(vox_timer_set_weak(&weak, true), 0, "设置弱定时器失败");
+    TEST_ASSERT_EQ(vox_timer_start(&weak, 5000, 5000, timer_count_cb, &weak_fired), 0, "启动弱定时器失败");
+    TEST_ASSERT_EQ(vox_timer_set_weak(&weak, false), -1, "活跃定时器不能修改 weak");
+    TEST_ASSERT_EQ(vox_timer_start(&strong, 10, 0, timer_restart_cb, &fired), 0, "启动定时器失败");
+
+    vox_time_t start = vox_time_monotonic();
+    vox_loop_run(loop, VOX_RUN_DEFAULT);
+    TEST_ASSERT_EQ(fired, 2, "回调内重启的定时器应再次触发");
+    TEST_ASSERT_EQ(weak_fired, 0, "弱定时器尚未到期");
+    TEST_ASSERT(vox_time_diff_us(vox_time_monotonic(), start) < 1000000, "只剩弱定时器时 loop 应退出");
+    TEST_ASSERT(vox_timer_is_active(&weak), "弱定时器仍应保持活跃");
+
+    vox_timer_destroy(&weak);
+    vox_loop_destroy(loop);
+}
+
+/* 测试套件 */
+test_case_t test_loop_cases[] = {
+    {"queue_work_mpsc", test_loop_queue_work_mpsc},
+    {"queue_work_node", test_loop_queue_work_node},
+    {"timer_order", test_loop_timer_order},
+    {"timer_weak", test_loop_timer_weak},
+};
+
+test_suite_t test_loop_suite = {
+    "vox_loop",
+    test_loop_cases,
+    sizeof(test_loop_cases) / sizeof(test_loop_cases[0])
+};
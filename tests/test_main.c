@@ -9,14 +9,19 @@
 
 /* 外部测试套件声明 */
 extern test_suite_t test_mpool_suite;
+extern test_suite_t test_arena_suite;
 extern test_suite_t test_log_suite;
 extern test_suite_t test_vector_suite;
 extern test_suite_t test_string_suite;
 extern test_suite_t test_queue_suite;
 extern test_suite_t test_htable_suite;
+extern test_suite_t test_fdtable_suite;
+extern test_suite_t test_chtable_suite;
+extern test_suite_t test_ebr_suite;
 extern test_suite_t test_time_suite;
 extern test_suite_t test_atomic_suite;
 extern test_suite_t test_rbtree_suite;
+extern test_suite_t test_btree_suite;
 extern test_suite_t test_mheap_suite;
 extern test_suite_t test_crypto_suite;
 extern test_suite_t test_scanner_suite;
@@ -29,11 +34,23 @@ extern test_suite_t test_mutex_suite;
 extern test_suite_t test_socket_suite;
 extern test_suite_t test_process_suite;
 extern test_suite_t test_tpool_suite;
+extern test_suite_t test_loop_suite;
+extern test_suite_t test_dns_suite;
 extern test_suite_t test_regex_suite;
 extern test_suite_t test_http_router_suite;
 extern test_suite_t test_http_middleware_suite;
 extern test_suite_t test_http_ws_suite;
+extern test_suite_t test_http_static_suite;
+extern test_suite_t test_http2_suite;
+extern test_suite_t test_http_server_suite;
+extern test_suite_t test_http_client_suite;
 
+#ifdef VOX_USE_ZLIB
+extern test_suite_t test_http_gzip_suite;
+#endif
+#ifdef VOX_USE_OPENSSL
+extern test_suite_t test_ssl_suite;
+#endif
 #ifdef VOX_USE_SQLITE3
 extern test_suite_t test_db_sqlite3_suite;
 #endif
@@ -60,13 +77,18 @@ int main(void) {
     test_suite_t suites[] = {
         test_log_suite,
         test_mpool_suite,
+        test_arena_suite,
         test_vector_suite,
         test_string_suite,
         test_queue_suite,
         test_htable_suite,
+        test_fdtable_suite,
+        test_chtable_suite,
+        test_ebr_suite,
         test_time_suite,
         test_atomic_suite,
         test_rbtree_suite,
+        test_btree_suite,
         test_mheap_suite,
         test_crypto_suite,
         test_scanner_suite,
@@ -79,10 +101,22 @@ int main(void) {
         test_socket_suite,
         test_process_suite,
         test_tpool_suite,
+        test_loop_suite,
+        test_dns_suite,
         test_regex_suite,
         test_http_router_suite,
         test_http_middleware_suite,
         test_http_ws_suite,
+        test_http_static_suite,
+        test_http2_suite,
+        test_http_server_suite,
+        test_http_client_suite,
+        #ifdef VOX_USE_ZLIB
+        test_http_gzip_suite,
+        #endif
+        #ifdef VOX_USE_OPENSSL
+        test_ssl_suite,
+        #endif
         #ifdef VOX_USE_SQLITE3
         test_db_sqlite3_suite,
         #endif
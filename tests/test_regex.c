@@ -1,6 +1,6 @@
 /* ============================================================
  * test_regex.c - vox_regex 模块测试
- * 包含44个测试用例，覆盖各种正则表达式功能
+ * 包含51个测试用例，覆盖各种正则表达式功能
  * ============================================================ */
 
 #include "test_runner.h"
@@ -400,6 +400,259 @@ static void test_regex_case_43(vox_mpool_t* mpool) {
     test_regex_match_case(mpool, "\\d{3}-\\d{2}-\\d{4}", "12-45-6789", "", false, "位数不足");
 }
 
+/* 测试44: 惰性 DFA 与 NFA 模拟结果一致（锚点、词边界、多行、忽略大小写、非贪婪） */
+static void test_regex_case_44(vox_mpool_t* mpool) {
+    static const struct { const char* pattern; int flags; } pats[] = {
+        { "^ab|cd$", VOX_REGEX_NONE },
+        { "^\\w+$", VOX_REGEX_MULTILINE },
+        { "\\bfoo\\b", VOX_REGEX_NONE },
+        { "(a|b)*c", VOX_REGEX_NONE },
+        { "a.*?b", VOX_REGEX_NONE },
+        { "a.b", VOX_REGEX_DOTALL },
+        { "[a-c]+x?", VOX_REGEX_IGNORE_CASE },
+        { "(\\d+)-(\\d+)", VOX_REGEX_NONE },
+        { "x*", VOX_REGEX_NONE },
+        { "a*b", VOX_REGEX_NONE },
+        { "a.*z|b", VOX_REGEX_NONE },
+        { "[0-9]+z|q", VOX_REGEX_NONE },
+    };
+    static const char* texts[] = {
+        "ab cd", "foo\nbar\nbaz!", "a foo, foobar foo", "xabacabc", "aXXbYYb",
+        "a\nb", "CABX abc", "12-34 5-6", "", "\n\r\n", "xaaab", "a b z", "123q 45z"
+    };
+    
+    for (size_t i = 0; i < sizeof(pats) / sizeof(pats[0]); i++) {
+        vox_regex_t* dfa = vox_regex_compile(mpool, pats[i].pattern, pats[i].flags);
+        vox_regex_t* nfa = vox_regex_compile(mpool, pats[i].pattern, pats[i].flags | VOX_REGEX_NFA_ONLY);
+        TEST_ASSERT_NOT_NULL(dfa, "编译正则表达式失败");
+        TEST_ASSERT_NOT_NULL(nfa, "编译正则表达式失败");
+        
+        for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+            size_t len = strlen(texts[t]);
+            for (size_t pos = 0; pos <= len; pos++) {
+                vox_regex_match_t a = { 0, 0 };
+                vox_regex_match_t b = { 0, 0 };
+                bool ra = vox_regex_search(dfa, texts[t], len, pos, &a);
+                bool rb = vox_regex_search(nfa, texts[t], len, pos, &b);
+                TEST_ASSERT(ra == rb, "DFA 与 NFA 搜索结果一致");
+                if (ra && rb) {
+                    TEST_ASSERT_EQ(a.start, b.start, "DFA 与 NFA 匹配起点一致");
+                    TEST_ASSERT_EQ(a.end, b.end, "DFA 与 NFA 匹配终点一致");
+                }
+            }
+            TEST_ASSERT(vox_regex_match(dfa, texts[t], len, NULL) == vox_regex_match(nfa, texts[t], len, NULL),
+                        "DFA 与 NFA 完全匹配结果一致");
+        }
+        
+        vox_regex_destroy(dfa);
+        vox_regex_destroy(nfa);
+    }
+}
+
+/* 测试45: 长文本单遍扫描（未命中与末尾命中） */
+static void test_regex_case_45(vox_mpool_t* mpool) {
+    size_t len = 64 * 1024;
+    char* text = (char*)vox_mpool_alloc(mpool, len + 32);
+    TEST_ASSERT_NOT_NULL(text, "分配文本失败");
+    for (size_t i = 0; i < len; i++) {
+        text[i] = (i % 7 == 6) ? ' ' : (char)('a' + i % 5);
+    }
+    
+    vox_regex_t* regex = vox_regex_compile(mpool, "\\w+@\\w+\\.com", VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(regex, "编译正则表达式失败");
+    
+    vox_regex_match_t match;
+    TEST_ASSERT(!vox_regex_search(regex, text, len, 0, &match), "长文本未命中");
+    
+    memcpy(text + len, " me@host.com", 12);
+    TEST_ASSERT(vox_regex_search(regex, text, len + 12, 0, &match), "长文本末尾命中");
+    TEST_ASSERT_EQ(match.start, len + 1, "匹配起点");
+    TEST_ASSERT_EQ(match.end, len + 12, "匹配终点");
+    
+    vox_regex_destroy(regex);
+    vox_mpool_free(mpool, text);
+}
+
+/* 测试46: findall、替换与捕获组（DFA 定位后由 NFA 提取捕获组） */
+static void test_regex_case_46(vox_mpool_t* mpool) {
+    vox_regex_t* regex = vox_regex_compile(mpool, "\\d+", VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(regex, "编译正则表达式失败");
+    
+    const char* text = "a1 b22 c333";
+    vox_regex_match_t* matches = NULL;
+    size_t count = 0;
+    TEST_ASSERT_EQ(vox_regex_findall(regex, text, strlen(text), &matches, &count), 0, "findall 失败");
+    TEST_ASSERT_EQ(count, 3, "findall 数量");
+    if (count == 3) {
+        TEST_ASSERT_EQ(matches[2].start, 8, "第三个匹配起点");
+        TEST_ASSERT_EQ(matches[2].end, 11, "第三个匹配终点");
+    }
+    vox_regex_free_matches(regex, matches, count);
+    
+    char out[64];
+    size_t out_len = 0;
+    TEST_ASSERT_EQ(vox_regex_replace(regex, text, strlen(text), "#", out, sizeof(out), &out_len), 0, "替换失败");
+    TEST_ASSERT_STR_EQ(out, "a# b# c#", "替换结果");
+    vox_regex_destroy(regex);
+    
+    regex = vox_regex_compile(mpool, "(\\w+)@(\\w+)", VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(regex, "编译正则表达式失败");
+    vox_regex_matches_t groups;
+    memset(&groups, 0, sizeof(groups));
+    TEST_ASSERT(vox_regex_match(regex, "user@host", 9, &groups), "完全匹配失败");
+    TEST_ASSERT_EQ(groups.count, 3, "捕获组数量");
+    if (groups.count == 3) {
+        TEST_ASSERT_EQ(groups.matches[0].start, 0, "完整匹配起点");
+        TEST_ASSERT_EQ(groups.matches[0].end, 9, "完整匹配终点");
+    }
+    TEST_ASSERT(!vox_regex_match(regex, "user@", 5, &groups), "不完全时不匹配");
+    vox_regex_destroy(regex);
+}
+
+/* 测试47: 字面量前缀查找只在给定长度内进行（文本无需以 '\0' 结尾） */
+static void test_regex_case_47(vox_mpool_t* mpool) {
+    vox_regex_t* regex = vox_regex_compile(mpool, "abc\\d", VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(regex, "编译正则表达式失败");
+    
+    const char buf[] = { 'x', 'a', 'b', 'c', '1', 'a', 'b', 'c', '2' };
+    vox_regex_match_t match;
+    TEST_ASSERT(!vox_regex_search(regex, buf, 4, 0, &match), "长度之外的前缀不参与匹配");
+    TEST_ASSERT(vox_regex_search(regex, buf, sizeof(buf), 2, &match), "从中间位置搜索");
+    TEST_ASSERT_EQ(match.start, 5, "匹配起点");
+    
+    vox_regex_destroy(regex);
+}
+
+/* 测试48: 正则表达式集合返回所有匹配的模式编号 */
+static void test_regex_case_48(vox_mpool_t* mpool) {
+    const char* patterns[] = {
+        "select\\s+\\w+\\s+from",  /* 0: 必需字面量 select */
+        "\\d{3}-\\d{4}",           /* 1: 没有必需字面量，总是验证 */
+        "(?:union|join)\\s+all",  /* 2: 必需字面量 all */
+        "^GET /admin",            /* 3 */
+        "evil(?=\\d)",            /* 4: 含断言，使用 NFA 验证 */
+    };
+    vox_regex_set_t* set = vox_regex_set_compile(mpool, patterns, 5, VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(set, "编译正则表达式集合失败");
+    TEST_ASSERT_EQ(vox_regex_set_size(set), 5, "模式数量");
+    
+    const char* text = "GET /admin?q=select id from t union all call 555-1234";
+    size_t ids[8];
+    size_t n = vox_regex_set_match(set, text, strlen(text), ids, 8);
+    TEST_ASSERT_EQ(n, 4, "匹配模式数量");
+    if (n == 4) {
+        TEST_ASSERT_EQ(ids[0], 0, "模式0");
+        TEST_ASSERT_EQ(ids[1], 1, "模式1");
+        TEST_ASSERT_EQ(ids[2], 2, "模式2");
+        TEST_ASSERT_EQ(ids[3], 3, "模式3");
+    }
+    
+    /* ids 容量不足时只写入前 max_ids 个，但返回总数 */
+    TEST_ASSERT_EQ(vox_regex_set_match(set, text, strlen(text), ids, 1), 4, "容量不足时返回总数");
+    TEST_ASSERT_EQ(ids[0], 0, "容量不足时写入第一个");
+    
+    TEST_ASSERT_EQ(vox_regex_set_match(set, "evil1", 5, ids, 8), 1, "断言模式匹配");
+    TEST_ASSERT_EQ(ids[0], 4, "断言模式编号");
+    TEST_ASSERT(!vox_regex_set_is_match(set, "evil select", 11), "字面量出现但正则不匹配");
+    TEST_ASSERT(vox_regex_set_is_match(set, "x 123-4567", 10), "无字面量模式匹配");
+    TEST_ASSERT(!vox_regex_set_is_match(set, "", 0), "空文本不匹配");
+    
+    vox_regex_set_destroy(set);
+}
+
+/* 测试49: 正则表达式集合忽略大小写与编译失败 */
+static void test_regex_case_49(vox_mpool_t* mpool) {
+    const char* patterns[] = { "script>", "on\\w+=", "javascript:" };
+    vox_regex_set_t* set = vox_regex_set_compile(mpool, patterns, 3, VOX_REGEX_IGNORE_CASE);
+    TEST_ASSERT_NOT_NULL(set, "编译正则表达式集合失败");
+    
+    const char* text = "<SCRIPT>x</ScRiPt><a href=JavaScript:go()>";
+    size_t ids[3];
+    TEST_ASSERT_EQ(vox_regex_set_match(set, text, strlen(text), ids, 3), 2, "忽略大小写匹配数量");
+    TEST_ASSERT_EQ(ids[0], 0, "模式0");
+    TEST_ASSERT_EQ(ids[1], 2, "模式2");
+    vox_regex_set_destroy(set);
+    
+    const char* bad[] = { "ok", "(unclosed" };
+    TEST_ASSERT_NULL(vox_regex_set_compile(mpool, bad, 2, VOX_REGEX_NONE), "任一模式编译失败时返回NULL");
+    
+    set = vox_regex_set_compile(mpool, NULL, 0, VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(set, "空集合");
+    TEST_ASSERT_EQ(vox_regex_set_match(set, "abc", 3, NULL, 0), 0, "空集合不匹配");
+    vox_regex_set_destroy(set);
+}
+
+/* 测试50: 正则表达式集合首字节跳跃（字面量出现在 16 字节分组的不同位置与末尾） */
+static void test_regex_case_50(vox_mpool_t* mpool) {
+    const char* patterns[] = { "token=\\w+", "Zed" };
+    vox_regex_set_t* set = vox_regex_set_compile(mpool, patterns, 2, VOX_REGEX_IGNORE_CASE);
+    TEST_ASSERT_NOT_NULL(set, "编译正则表达式集合失败");
+    
+    char text[96];
+    size_t ids[2];
+    for (size_t pos = 0; pos + 9 <= 80; pos += 7) {
+        memset(text, '.', sizeof(text));
+        memcpy(text + pos, "TOKEN=ab", 8);
+        TEST_ASSERT_EQ(vox_regex_set_match(set, text, 80, ids, 2), 1, "跳跃后仍应找到字面量");
+        TEST_ASSERT_EQ(ids[0], 0, "模式0");
+    }
+    memset(text, '.', sizeof(text));
+    memcpy(text + 77, "zED", 3);
+    TEST_ASSERT_EQ(vox_regex_set_match(set, text, 80, ids, 2), 1, "文本末尾的字面量");
+    TEST_ASSERT_EQ(ids[0], 1, "模式1");
+    TEST_ASSERT(!vox_regex_set_is_match(set, text, 79), "截断的字面量不匹配");
+    vox_regex_set_destroy(set);
+    
+    /* 首字节种类较多时回退为逐字节查表 */
+    const char* many[] = { "alpha", "beta", "gamma", "delta", "omega" };
+    set = vox_regex_set_compile(mpool, many, 5, VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(set, "编译正则表达式集合失败");
+    const char* text2 = "................................omega..................delta";
+    size_t ids2[5];
+    TEST_ASSERT_EQ(vox_regex_set_match(set, text2, strlen(text2), ids2, 5), 2, "多首字节匹配数量");
+    TEST_ASSERT_EQ(ids2[0], 3, "模式3");
+    TEST_ASSERT_EQ(ids2[1], 4, "模式4");
+    vox_regex_set_destroy(set);
+}
+
+/* 测试51: 命中时定位最左起点是线性的（逐位置锚定重试会退化为平方） */
+static void test_regex_case_51(vox_mpool_t* mpool) {
+    size_t len = 256 * 1024;
+    char* text = (char*)vox_mpool_alloc(mpool, len + 1);
+    TEST_ASSERT_NOT_NULL(text, "分配文本失败");
+    memset(text, '7', len);
+    text[len] = 'q';
+    
+    vox_regex_t* regex = vox_regex_compile(mpool, "[0-9]+z|q", VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(regex, "编译正则表达式失败");
+    
+    vox_regex_match_t match;
+    TEST_ASSERT(vox_regex_search(regex, text, len + 1, 0, &match), "长数字串后命中");
+    TEST_ASSERT_EQ(match.start, len, "匹配起点");
+    TEST_ASSERT_EQ(match.end, len + 1, "匹配终点");
+    /* 线性时间：没有回退到 NFA，扫描的位置数与文本长度成正比 */
+    vox_regex_dfa_stats_t stats;
+    TEST_ASSERT_EQ(vox_regex_get_dfa_stats(regex, &stats), 0, "应使用惰性 DFA");
+    TEST_ASSERT_EQ(stats.cache_flushes, 0, "DFA 缓存不应被清空");
+    TEST_ASSERT(stats.steps <= 3 * (len + 1), "长文本搜索应为线性时间");
+    
+    /* 最左匹配结束得比最早结束的匹配更晚 */
+    text[len / 2] = 'q';
+    text[len] = 'z';
+    vox_regex_t* later = vox_regex_compile(mpool, "\\d[\\dq]*z|q", VOX_REGEX_NONE);
+    TEST_ASSERT_NOT_NULL(later, "编译正则表达式失败");
+    TEST_ASSERT(vox_regex_search(later, text, len + 1, 0, &match), "跨过较早匹配的最左匹配");
+    TEST_ASSERT_EQ(match.start, 0, "最左匹配起点");
+    TEST_ASSERT_EQ(match.end, len + 1, "最左匹配终点");
+    TEST_ASSERT_EQ(vox_regex_get_dfa_stats(later, &stats), 0, "应使用惰性 DFA");
+    TEST_ASSERT_EQ(stats.cache_flushes, 0, "DFA 缓存不应被清空");
+    TEST_ASSERT(stats.steps <= 3 * (len + 1), "跨过较早匹配的搜索应为线性时间");
+    
+    vox_regex_destroy(later);
+    vox_regex_destroy(regex);
+    vox_mpool_free(mpool, text);
+}
+
 /* 测试套件 */
 test_case_t test_regex_cases[] = {
     {"case_1", test_regex_case_1},
@@ -441,6 +694,14 @@ test_case_t test_regex_cases[] = {
     {"case_41", test_regex_case_41},
     {"case_42", test_regex_case_42},
     {"case_43", test_regex_case_43},
+    {"case_44", test_regex_case_44},
+    {"case_45", test_regex_case_45},
+    {"case_46", test_regex_case_46},
+    {"case_47", test_regex_case_47},
+    {"case_48", test_regex_case_48},
+    {"case_49", test_regex_case_49},
+    {"case_50", test_regex_case_50},
+    {"case_51", test_regex_case_51},
 };
 
 test_suite_t test_regex_suite = {
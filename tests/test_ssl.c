@@ -0,0 +1,319 @@
+/* ============================================================
+ * test_ssl.c - vox_ssl 会话恢复与内核 TLS 密钥导出测试（内存 BIO 直连，不经过网络）
+ * ============================================================ */
+
+#include "test_runner.h"
+#include "../ssl/vox_ssl.h"
+#include <string.h>
+#include <openssl/evp.h>
+
+#ifndef VOX_TEST_CERT_DIR
+#define VOX_TEST_CERT_DIR "cert"
+#endif
+
+#define SSL_PUMP_ROUNDS 32
+
+/* 把 from 的 wbio 中的密文搬到 to 的 rbio，返回搬运的字节数 */
+static size_t ssl_transfer(vox_ssl_session_t* from, vox_ssl_session_t* to) {
+    char buf[16384];
+    size_t total = 0;
+    while (vox_ssl_bio_pending(from, VOX_SSL_BIO_WBIO) > 0) {
+        ssize_t n = vox_ssl_bio_read(from, VOX_SSL_BIO_WBIO, buf, sizeof(buf));
+        if (n <= 0) {
+            break;
+        }
+        vox_ssl_bio_write(to, VOX_SSL_BIO_RBIO, buf, (size_t)n);
+        total += (size_t)n;
+    }
+    return total;
+}
+
+/* 双方交替推进握手直到都完成；之后收发一次应用数据，让客户端处理 TLS 1.3 的会话票据 */
+static int ssl_connect_pair(vox_ssl_session_t* client, vox_ssl_session_t* server) {
+    for (int i = 0; i < SSL_PUMP_ROUNDS; i++) {
+        int c = vox_ssl_session_handshake(client);
+        ssl_transfer(client, server);
+        int s = vox_ssl_session_handshake(server);
+        ssl_transfer(server, client);
+        if (c == 0 && s == 0) {
+            break;
+        }
+        if ((c != 0 && c != VOX_SSL_ERROR_WANT_READ && c != VOX_SSL_ERROR_WANT_WRITE) ||
+            (s != 0 && s != VOX_SSL_ERROR_WANT_READ && s != VOX_SSL_ERROR_WANT_WRITE)) {
+            return -1;
+        }
+    }
+    if (vox_ssl_session_get_state(client) != VOX_SSL_STATE_CONNECTED ||
+        vox_ssl_session_get_state(server) != VOX_SSL_STATE_CONNECTED) {
+        return -1;
+    }
+
+    char buf[64];
+    if (vox_ssl_session_write(server, "ping", 4) != 4) {
+        return -1;
+    }
+    ssl_transfer(server, client);
+    if (vox_ssl_session_read(client, buf, sizeof(buf)) != 4 || memcmp(buf, "ping", 4) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/* 用给定主机名与端口建立一次连接，返回客户端是否恢复了会话（失败返回-1） */
+static int ssl_connect_port(vox_mpool_t* mpool, vox_ssl_context_t* client_ctx,
+                            vox_ssl_context_t* server_ctx, const char* hostname, uint16_t port) {
+    vox_ssl_session_t* client = vox_ssl_session_create(client_ctx, mpool);
+    vox_ssl_session_t* server = vox_ssl_session_create(server_ctx, mpool);
+    int ret = -1;
+    if (client && server && vox_ssl_session_set_hostname(client, hostname, port) == 0 &&
+        ssl_connect_pair(client, server) == 0) {
+        bool client_resumed = vox_ssl_session_is_resumed(client);
+        bool server_resumed = vox_ssl_session_is_resumed(server);
+        ret = (client_resumed == server_resumed) ? (client_resumed ? 1 : 0) : -1;
+    }
+    vox_ssl_session_destroy(client);
+    vox_ssl_session_destroy(server);
+    return ret;
+}
+
+static int ssl_connect_once(vox_mpool_t* mpool, vox_ssl_context_t* client_ctx,
+                            vox_ssl_context_t* server_ctx, const char* hostname) {
+    return ssl_connect_port(mpool, client_ctx, server_ctx, hostname, 443);
+}
+
+static vox_ssl_context_t* create_server_ctx(vox_mpool_t* mpool, const vox_ssl_config_t* extra) {
+    vox_ssl_context_t* ctx = vox_ssl_context_create(mpool, VOX_SSL_MODE_SERVER);
+    if (!ctx) {
+        return NULL;
+    }
+    vox_ssl_config_t config;
+    if (extra) {
+        config = *extra;
+    } else {
+        memset(&config, 0, sizeof(config));
+    }
+    config.cert_file = VOX_TEST_CERT_DIR "/server.crt";
+    config.key_file = VOX_TEST_CERT_DIR "/server.key";
+    if (vox_ssl_context_configure(ctx, &config) != 0) {
+        vox_ssl_context_destroy(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+static vox_ssl_context_t* create_client_ctx(vox_mpool_t* mpool, const vox_ssl_config_t* extra) {
+    vox_ssl_context_t* ctx = vox_ssl_context_create(mpool, VOX_SSL_MODE_CLIENT);
+    if (!ctx) {
+        return NULL;
+    }
+    vox_ssl_config_t config;
+    if (extra) {
+        config = *extra;
+    } else {
+        memset(&config, 0, sizeof(config));
+    }
+    config.ca_file = VOX_TEST_CERT_DIR "/server.crt";  /* 自签名证书 */
+    config.verify_peer = true;
+    config.verify_hostname = true;
+    if (vox_ssl_context_configure(ctx, &config) != 0) {
+        vox_ssl_context_destroy(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+/* 测试无状态票据恢复与按主机保存的客户端会话 */
+static void test_ssl_ticket_resumption(vox_mpool_t* mpool) {
+    vox_ssl_context_t* server_ctx = create_server_ctx(mpool, NULL);
+    vox_ssl_context_t* client_ctx = create_client_ctx(mpool, NULL);
+    TEST_ASSERT_NOT_NULL(server_ctx, "创建服务器 context 失败");
+    TEST_ASSERT_NOT_NULL(client_ctx, "创建客户端 context 失败");
+
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 0, "首次连接应为完整握手");
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 1, "再次连接应恢复会话");
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "127.0.0.1"), 0, "不同主机不应复用会话");
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "127.0.0.1"), 1, "IP 地址同样按主机恢复");
+    TEST_ASSERT_EQ(ssl_connect_port(mpool, client_ctx, server_ctx, "localhost", 8443), 0, "同一主机的不同端口不应复用会话");
+
+    vox_ssl_stats_t stats;
+    TEST_ASSERT_EQ(vox_ssl_context_get_stats(server_ctx, &stats), 0, "获取服务器统计失败");
+    TEST_ASSERT_EQ(stats.handshakes, 5, "服务器握手次数不正确");
+    TEST_ASSERT_EQ(stats.resumed, 2, "服务器恢复次数不正确");
+    TEST_ASSERT_EQ(vox_ssl_context_get_stats(client_ctx, &stats), 0, "获取客户端统计失败");
+    TEST_ASSERT_EQ(stats.resumed, 2, "客户端恢复次数不正确");
+    TEST_ASSERT_EQ(stats.cached_sessions, 3, "客户端应为每个 主机:端口 各保存一个会话");
+
+    vox_ssl_context_destroy(client_ctx);
+    vox_ssl_context_destroy(server_ctx);
+}
+
+/* 测试票据密钥轮换：上一把密钥仍可恢复，两次轮换后旧票据失效 */
+static void test_ssl_ticket_rotation(vox_mpool_t* mpool) {
+    vox_ssl_context_t* server_ctx = create_server_ctx(mpool, NULL);
+    vox_ssl_context_t* client_ctx = create_client_ctx(mpool, NULL);
+    TEST_ASSERT_NOT_NULL(server_ctx, "创建服务器 context 失败");
+    TEST_ASSERT_NOT_NULL(client_ctx, "创建客户端 context 失败");
+    TEST_ASSERT_EQ(vox_ssl_context_rotate_ticket_keys(client_ctx), -1, "客户端 context 不应支持票据密钥轮换");
+
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 0, "首次连接应为完整握手");
+    TEST_ASSERT_EQ(vox_ssl_context_rotate_ticket_keys(server_ctx), 0, "轮换票据密钥失败");
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 1, "上一把密钥签发的票据应仍可恢复");
+
+    /* 恢复时已用当前密钥续发了新票据，连续轮换两次后该票据失效 */
+    TEST_ASSERT_EQ(vox_ssl_context_rotate_ticket_keys(server_ctx), 0, "轮换票据密钥失败");
+    TEST_ASSERT_EQ(vox_ssl_context_rotate_ticket_keys(server_ctx), 0, "轮换票据密钥失败");
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 0, "密钥已淘汰，应回退到完整握手");
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 1, "完整握手后应可再次恢复");
+
+    vox_ssl_context_destroy(client_ctx);
+    vox_ssl_context_destroy(server_ctx);
+}
+
+/* 测试禁用票据时通过服务器会话缓存恢复 */
+static void test_ssl_cache_resumption(vox_mpool_t* mpool) {
+    vox_ssl_config_t extra;
+    memset(&extra, 0, sizeof(extra));
+    extra.disable_session_tickets = true;
+    vox_ssl_context_t* server_ctx = create_server_ctx(mpool, &extra);
+    vox_ssl_context_t* client_ctx = create_client_ctx(mpool, NULL);
+    TEST_ASSERT_NOT_NULL(server_ctx, "创建服务器 context 失败");
+    TEST_ASSERT_NOT_NULL(client_ctx, "创建客户端 context 失败");
+
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 0, "首次连接应为完整握手");
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 1, "应通过会话缓存恢复");
+
+    vox_ssl_stats_t stats;
+    TEST_ASSERT_EQ(vox_ssl_context_get_stats(server_ctx, &stats), 0, "获取服务器统计失败");
+    TEST_ASSERT_EQ(stats.resumed, 1, "服务器恢复次数不正确");
+    TEST_ASSERT_EQ(stats.cache_hits, 1, "会话缓存命中次数不正确");
+    TEST_ASSERT(stats.cached_sessions >= 1, "服务器会话缓存应保存会话");
+
+    vox_ssl_context_destroy(client_ctx);
+    vox_ssl_context_destroy(server_ctx);
+}
+
+/* 测试禁用会话缓存：每次都是完整握手 */
+static void test_ssl_cache_disabled(vox_mpool_t* mpool) {
+    vox_ssl_config_t extra;
+    memset(&extra, 0, sizeof(extra));
+    extra.disable_session_tickets = true;
+    extra.session_cache_size = -1;
+    vox_ssl_context_t* server_ctx = create_server_ctx(mpool, &extra);
+    vox_ssl_context_t* client_ctx = create_client_ctx(mpool, NULL);
+    TEST_ASSERT_NOT_NULL(server_ctx, "创建服务器 context 失败");
+    TEST_ASSERT_NOT_NULL(client_ctx, "创建客户端 context 失败");
+
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 0, "首次连接应为完整握手");
+    TEST_ASSERT_EQ(ssl_connect_once(mpool, client_ctx, server_ctx, "localhost"), 0, "禁用缓存后不应恢复");
+
+    vox_ssl_stats_t stats;
+    TEST_ASSERT_EQ(vox_ssl_context_get_stats(server_ctx, &stats), 0, "获取服务器统计失败");
+    TEST_ASSERT_EQ(stats.handshakes, 2, "服务器握手次数不正确");
+    TEST_ASSERT_EQ(stats.resumed, 0, "不应有会话恢复");
+    TEST_ASSERT_EQ(stats.cached_sessions, 0, "服务器不应缓存会话");
+
+    vox_ssl_context_destroy(client_ctx);
+    vox_ssl_context_destroy(server_ctx);
+}
+
+/* 用导出的 TLS 1.3 AEAD 密钥解密一条记录，返回内层明文长度（含内容类型字节），失败返回-1 */
+static int ssl_ktls_decrypt(const vox_ssl_ktls_keys_t* keys, const unsigned char* rec, size_t rec_len,
+                            unsigned char* out) {
+    if (rec_len < 5 + 16 || keys->iv_len != 12) {
+        return -1;
+    }
+    size_t body_len = ((size_t)rec[3] << 8) | rec[4];
+    if (body_len + 5 != rec_len || body_len < 16) {
+        return -1;
+    }
+    const EVP_CIPHER* cipher = keys->cipher == VOX_SSL_KTLS_AES_128_GCM ? EVP_aes_128_gcm()
+                             : keys->cipher == VOX_SSL_KTLS_AES_256_GCM ? EVP_aes_256_gcm()
+                             : EVP_chacha20_poly1305();
+    unsigned char nonce[12];
+    memcpy(nonce, keys->iv, sizeof(nonce));
+    for (int i = 0; i < 8; i++) {
+        nonce[4 + i] ^= (unsigned char)(keys->seq >> (56 - 8 * i));
+    }
+    size_t ct_len = body_len - 16;
+    int len = 0;
+    int final_len = 0;
+    EVP_CIPHER_CTX* x = EVP_CIPHER_CTX_new();
+    int ok = x &&
+             EVP_DecryptInit_ex(x, cipher, NULL, NULL, NULL) == 1 &&
+             EVP_CIPHER_CTX_ctrl(x, EVP_CTRL_AEAD_SET_IVLEN, 12, NULL) == 1 &&
+             EVP_DecryptInit_ex(x, NULL, NULL, keys->key, nonce) == 1 &&
+             EVP_DecryptUpdate(x, NULL, &len, rec, 5) == 1 &&
+             EVP_DecryptUpdate(x, out, &len, rec + 5, (int)ct_len) == 1 &&
+             EVP_CIPHER_CTX_ctrl(x, EVP_CTRL_AEAD_SET_TAG, 16, (void*)(rec + 5 + ct_len)) == 1 &&
+             EVP_DecryptFinal_ex(x, out + len, &final_len) == 1;
+    EVP_CIPHER_CTX_free(x);
+    return ok ? len + final_len : -1;
+}
+
+/* 测试内核 TLS 密钥导出：双方同一方向的密钥与序号一致，导出的密钥能解密下一条记录 */
+static void test_ssl_ktls_keys(vox_mpool_t* mpool) {
+    vox_ssl_config_t extra;
+    memset(&extra, 0, sizeof(extra));
+    extra.enable_ktls = true;
+    vox_ssl_context_t* server_ctx = create_server_ctx(mpool, &extra);
+    vox_ssl_context_t* client_ctx = create_client_ctx(mpool, &extra);
+    TEST_ASSERT_NOT_NULL(server_ctx, "创建服务器 context 失败");
+    TEST_ASSERT_NOT_NULL(client_ctx, "创建客户端 context 失败");
+
+    vox_ssl_session_t* client = vox_ssl_session_create(client_ctx, mpool);
+    vox_ssl_session_t* server = vox_ssl_session_create(server_ctx, mpool);
+    TEST_ASSERT_NOT_NULL(client, "创建客户端会话失败");
+    TEST_ASSERT_NOT_NULL(server, "创建服务器会话失败");
+    TEST_ASSERT_EQ(ssl_connect_pair(client, server), 0, "握手失败");
+
+    vox_ssl_ktls_keys_t client_tx;
+    vox_ssl_ktls_keys_t server_rx;
+    vox_ssl_ktls_keys_t server_tx;
+    TEST_ASSERT_EQ(vox_ssl_session_get_ktls_keys(client, VOX_SSL_KTLS_TX, &client_tx), 0, "导出客户端发送密钥失败");
+    TEST_ASSERT_EQ(vox_ssl_session_get_ktls_keys(server, VOX_SSL_KTLS_RX, &server_rx), 0, "导出服务器接收密钥失败");
+    TEST_ASSERT_EQ(client_tx.version, 0x0304, "默认应协商 TLS 1.3");
+    TEST_ASSERT_EQ(client_tx.cipher, server_rx.cipher, "双方加密套件不一致");
+    TEST_ASSERT_EQ(client_tx.key_len, server_rx.key_len, "密钥长度不一致");
+    TEST_ASSERT(memcmp(client_tx.key, server_rx.key, client_tx.key_len) == 0, "客户端发送与服务器接收密钥不一致");
+    TEST_ASSERT(memcmp(client_tx.iv, server_rx.iv, client_tx.iv_len) == 0, "客户端发送与服务器接收 IV 不一致");
+    TEST_ASSERT_EQ(client_tx.seq, server_rx.seq, "记录序号不一致");
+
+    /* TLS 1.3 客户端接收方向会收到握手后的 NewSessionTicket，不卸载 */
+    vox_ssl_ktls_keys_t declined;
+    TEST_ASSERT_EQ(vox_ssl_session_get_ktls_keys(client, VOX_SSL_KTLS_RX, &declined), -1, "客户端接收方向不应卸载");
+
+    /* 服务器已发送会话票据与 ping，序号应从之后开始，且导出的密钥能解密下一条记录 */
+    TEST_ASSERT_EQ(vox_ssl_session_get_ktls_keys(server, VOX_SSL_KTLS_TX, &server_tx), 0, "导出服务器发送密钥失败");
+    TEST_ASSERT(server_tx.seq > 0, "服务器发送序号应跳过已发送的记录");
+    TEST_ASSERT_EQ(vox_ssl_session_write(server, "kernel", 6), 6, "服务器写入失败");
+    unsigned char rec[256];
+    unsigned char plain[256];
+    ssize_t rec_len = vox_ssl_bio_read(server, VOX_SSL_BIO_WBIO, rec, sizeof(rec));
+    TEST_ASSERT(rec_len > 0, "读取密文记录失败");
+    TEST_ASSERT_EQ(ssl_ktls_decrypt(&server_tx, rec, (size_t)rec_len, plain), 7, "解密记录失败");
+    TEST_ASSERT(memcmp(plain, "kernel", 6) == 0 && plain[6] == 23, "解密内容不正确");
+
+    /* 卸载后该方向不再经过 OpenSSL */
+    TEST_ASSERT_EQ(vox_ssl_session_set_ktls(server, VOX_SSL_KTLS_TX, true), 0, "标记发送方向卸载失败");
+    TEST_ASSERT_EQ(vox_ssl_session_write(server, "x", 1), VOX_SSL_ERROR_INVALID_STATE, "卸载后写入应被拒绝");
+
+    vox_ssl_session_destroy(client);
+    vox_ssl_session_destroy(server);
+    vox_ssl_context_destroy(client_ctx);
+    vox_ssl_context_destroy(server_ctx);
+}
+
+/* 测试套件 */
+test_case_t test_ssl_cases[] = {
+    {"ticket_resumption", test_ssl_ticket_resumption},
+    {"ticket_rotation", test_ssl_ticket_rotation},
+    {"cache_resumption", test_ssl_cache_resumption},
+    {"cache_disabled", test_ssl_cache_disabled},
+    {"ktls_keys", test_ssl_ktls_keys},
+};
+
+test_suite_t test_ssl_suite = {
+    "vox_ssl",
+    test_ssl_cases,
+    sizeof(test_ssl_cases) / sizeof(test_ssl_cases[0])
+};
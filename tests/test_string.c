@@ -4,6 +4,7 @@
 
 #include "test_runner.h"
 #include "../vox_string.h"
+#include "../vox_bytes.h"
 #include <string.h>
 
 /* 测试创建和销毁 */
@@ -178,6 +179,60 @@ static void test_string_edge_cases(vox_mpool_t* mpool) {
     vox_string_destroy(substr);
 }
 
+/* 测试短字符串内联存储：增长到堆后内容保持不变 */
+static void test_string_sso(vox_mpool_t* mpool) {
+    vox_string_t* str = vox_string_from_cstr(mpool, "Content-Type");
+    TEST_ASSERT_NOT_NULL(str, "创建字符串失败");
+    const char* inline_ptr = vox_string_cstr(str);
+    TEST_ASSERT_EQ(vox_string_capacity(str), 32, "默认容量应为内联容量");
+    TEST_ASSERT_EQ(vox_string_append(str, ": text/html"), 0, "追加失败");
+    TEST_ASSERT_EQ(vox_string_cstr(str), inline_ptr, "未超出内联容量时不应重新分配");
+
+    TEST_ASSERT_EQ(vox_string_append(str, "; charset=utf-8; boundary=xyz"), 0, "追加失败");
+    TEST_ASSERT_NE(vox_string_cstr(str), inline_ptr, "超出内联容量应转到堆上");
+    TEST_ASSERT_STR_EQ(vox_string_cstr(str), "Content-Type: text/html; charset=utf-8; boundary=xyz", "内容不正确");
+
+    vox_string_clear(str);
+    TEST_ASSERT_EQ(vox_string_append(str, "x"), 0, "清空后追加失败");
+    TEST_ASSERT_STR_EQ(vox_string_cstr(str), "x", "清空后内容不正确");
+    vox_string_destroy(str);
+
+    /* 指定较大初始容量时直接使用堆存储 */
+    vox_string_config_t config = { 256 };
+    str = vox_string_create_with_config(mpool, &config);
+    TEST_ASSERT_NOT_NULL(str, "创建字符串失败");
+    TEST_ASSERT_EQ(vox_string_capacity(str), 256, "容量不正确");
+    vox_string_destroy(str);
+}
+
+/* 测试引用计数切片：slice/retain 共享数据，最后一次 release 释放 */
+static void test_string_bytes(vox_mpool_t* mpool) {
+    vox_bytes_t b = VOX_BYTES_NULL;
+    TEST_ASSERT_EQ(vox_bytes_create(mpool, "GET /index.html", 15, &b), 0, "创建切片失败");
+    TEST_ASSERT_EQ(vox_bytes_refcount(&b), 1, "初始引用计数应为1");
+
+    vox_bytes_t path = vox_bytes_slice(&b, 4, 100);
+    TEST_ASSERT_EQ(path.len, 11, "越界长度应截断");
+    TEST_ASSERT_EQ(path.ptr, b.ptr + 4, "切片应共享数据");
+    vox_bytes_t copy = vox_bytes_retain(&path);
+    TEST_ASSERT_EQ(vox_bytes_refcount(&b), 3, "引用计数不正确");
+
+    vox_bytes_release(&b);
+    TEST_ASSERT_NULL(b.ptr, "release 后应为空切片");
+    vox_strview_t sv = vox_bytes_view(&copy);
+    TEST_ASSERT_EQ(vox_strview_compare_cstr(&sv, "/index.html"), 0, "原切片释放后数据应仍有效");
+    vox_bytes_release(&path);
+    TEST_ASSERT_EQ(vox_bytes_refcount(&copy), 1, "引用计数不正确");
+    vox_bytes_release(&copy);
+    TEST_ASSERT_EQ(vox_bytes_refcount(&copy), 0, "空切片引用计数应为0");
+
+    vox_bytes_t empty;
+    char* w = vox_bytes_alloc(mpool, 0, &empty);
+    TEST_ASSERT_NOT_NULL(w, "空数据分配失败");
+    TEST_ASSERT_EQ(w[0], '\0', "应以 '\\0' 结尾");
+    vox_bytes_release(&empty);
+}
+
 /* 测试套件 */
 test_case_t test_string_cases[] = {
     {"create_destroy", test_string_create_destroy},
@@ -191,6 +246,8 @@ test_case_t test_string_cases[] = {
     {"long", test_string_long},
     {"replace_multiple", test_string_replace_multiple},
     {"edge_cases", test_string_edge_cases},
+    {"sso", test_string_sso},
+    {"bytes", test_string_bytes},
 };
 
 test_suite_t test_string_suite = {
@@ -85,6 +85,7 @@ extern "C" {
 #include "http/vox_http_client.h"
 #include "http/vox_http_gzip.h"
 #include "http/vox_http_mime.h"
+#include "http/vox_http_static.h"
 #include "http/vox_http_middleware.h"
 
 /* ===== WebSocket ===== */
@@ -0,0 +1,262 @@
+/*
+ * vox_arena.c - 线性（bump-pointer）分配器实现
+ * 块按顺序串成链表：current 之前的块均已使用，之后的块为 reset/rewind 后保留待复用的块
+ * 超过块大小 1/4 的分配单独从内存池分配，按分配顺序串成后进先出链表
+ */
+
+#include "vox_arena.h"
+#include "vox_log.h"
+#include <string.h>
+
+/* 由 vox_mpool.c 实现的内存池适配器 */
+extern vox_mpool_t* vox_mpool_create_arena_adapter(vox_arena_t* arena);
+extern void vox_mpool_release_arena_adapter(vox_mpool_t* pool);
+
+#define VOX_ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#define VOX_ARENA_MIN_CHUNK_SIZE 256
+#define VOX_ARENA_ALIGN 8
+
+/* 块头部（数据紧随其后） */
+typedef struct vox_arena_chunk {
+    struct vox_arena_chunk* next;
+    size_t capacity;                 /* 数据区容量 */
+    size_t used;                     /* 已用字节数 */
+} vox_arena_chunk_t;
+
+/* 单独分配头部（数据紧随其后） */
+typedef struct vox_arena_large {
+    struct vox_arena_large* prev;    /* 更早的单独分配 */
+    size_t size;                     /* 数据大小 */
+} vox_arena_large_t;
+
+struct vox_arena {
+    vox_mpool_t* mpool;              /* 底层内存池 */
+    vox_mpool_t* adapter;            /* 以本 arena 为后端的内存池（按需创建） */
+    size_t chunk_size;               /* 块容量 */
+    size_t large_threshold;          /* 超过该大小的分配单独分配 */
+    vox_arena_chunk_t* head;         /* 第一个块 */
+    vox_arena_chunk_t* current;      /* 当前分配块 */
+    vox_arena_large_t* large;        /* 最近的单独分配 */
+    void* last;                      /* 最近一次分配（realloc 原地扩展用） */
+    size_t chunk_count;
+    size_t large_count;
+    size_t large_bytes;
+};
+
+#define CHUNK_DATA(c) ((char*)(c) + sizeof(vox_arena_chunk_t))
+#define LARGE_DATA(l) ((char*)(l) + sizeof(vox_arena_large_t))
+
+vox_arena_t* vox_arena_create(vox_mpool_t* mpool) {
+    return vox_arena_create_with_config(mpool, NULL);
+}
+
+vox_arena_t* vox_arena_create_with_config(vox_mpool_t* mpool, const vox_arena_config_t* config) {
+    if (!mpool) return NULL;
+
+    vox_arena_t* arena = (vox_arena_t*)vox_mpool_alloc(mpool, sizeof(vox_arena_t));
+    if (!arena) {
+        VOX_LOG_ERROR("Failed to allocate arena");
+        return NULL;
+    }
+    memset(arena, 0, sizeof(vox_arena_t));
+    arena->mpool = mpool;
+
+    size_t chunk_size = VOX_ARENA_DEFAULT_CHUNK_SIZE;
+    if (config && config->chunk_size > 0) {
+        chunk_size = config->chunk_size;
+        if (chunk_size < VOX_ARENA_MIN_CHUNK_SIZE) chunk_size = VOX_ARENA_MIN_CHUNK_SIZE;
+    }
+    arena->chunk_size = VOX_ALIGN_SIZE(chunk_size, VOX_ARENA_ALIGN);
+    arena->large_threshold = arena->chunk_size / 4;
+    return arena;
+}
+
+static void free_large_until(vox_arena_t* arena, vox_arena_large_t* stop) {
+    while (arena->large && arena->large != stop) {
+        vox_arena_large_t* l = arena->large;
+        arena->large = l->prev;
+        arena->large_count--;
+        arena->large_bytes -= l->size;
+        vox_mpool_free(arena->mpool, l);
+    }
+}
+
+void vox_arena_destroy(vox_arena_t* arena) {
+    if (!arena) return;
+
+    free_large_until(arena, NULL);
+    vox_arena_chunk_t* c = arena->head;
+    while (c) {
+        vox_arena_chunk_t* next = c->next;
+        vox_mpool_free(arena->mpool, c);
+        c = next;
+    }
+    if (arena->adapter) {
+        vox_mpool_release_arena_adapter(arena->adapter);
+    }
+    vox_mpool_free(arena->mpool, arena);
+}
+
+static void* alloc_large(vox_arena_t* arena, size_t size) {
+    if (size > SIZE_MAX - sizeof(vox_arena_large_t)) return NULL;
+    vox_arena_large_t* l = (vox_arena_large_t*)vox_mpool_alloc(arena->mpool, sizeof(vox_arena_large_t) + size);
+    if (!l) return NULL;
+    l->prev = arena->large;
+    l->size = size;
+    arena->large = l;
+    arena->large_count++;
+    arena->large_bytes += size;
+    arena->last = LARGE_DATA(l);
+    return arena->last;
+}
+
+/* 当前块空间不足：移到下一个保留块，没有则新建 */
+static vox_arena_chunk_t* next_chunk(vox_arena_t* arena) {
+    vox_arena_chunk_t* c = arena->current ? arena->current->next : arena->head;
+    if (c) {
+        c->used = 0;
+        arena->current = c;
+        return c;
+    }
+
+    c = (vox_arena_chunk_t*)vox_mpool_alloc(arena->mpool, sizeof(vox_arena_chunk_t) + arena->chunk_size);
+    if (!c) {
+        VOX_LOG_ERROR("Failed to allocate arena chunk of %zu bytes", arena->chunk_size);
+        return NULL;
+    }
+    c->next = NULL;
+    c->capacity = arena->chunk_size;
+    c->used = 0;
+    if (arena->current) {
+        arena->current->next = c;
+    } else {
+        arena->head = c;
+    }
+    arena->current = c;
+    arena->chunk_count++;
+    return c;
+}
+
+void* vox_arena_alloc(vox_arena_t* arena, size_t size) {
+    if (!arena || size == 0) return NULL;
+
+    vox_arena_chunk_t* c = arena->current;
+    if (size <= arena->large_threshold) {
+        size_t need = VOX_ALIGN_SIZE(size, VOX_ARENA_ALIGN);
+        if (!c || c->capacity - c->used < need) {
+            c = next_chunk(arena);
+            if (!c) return NULL;
+        }
+        void* p = CHUNK_DATA(c) + c->used;
+        c->used += need;
+        arena->last = p;
+        return p;
+    }
+    return alloc_large(arena, size);
+}
+
+void* vox_arena_realloc(vox_arena_t* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!arena) return NULL;
+    if (!ptr) return vox_arena_alloc(arena, new_size);
+    if (new_size == 0) return NULL;
+
+    if (ptr == arena->last) {
+        vox_arena_large_t* l = arena->large;
+        if (l && ptr == LARGE_DATA(l)) {
+            /* 最近的单独分配：交给内存池 realloc（last 在 mark 时清空，节点一定晚于所有标记） */
+            if (new_size > SIZE_MAX - sizeof(vox_arena_large_t)) return NULL;
+            vox_arena_large_t* nl = (vox_arena_large_t*)vox_mpool_realloc(arena->mpool, l,
+                                                                          sizeof(vox_arena_large_t) + new_size);
+            if (!nl) return NULL;
+            arena->large_bytes = arena->large_bytes - nl->size + new_size;
+            nl->size = new_size;
+            arena->large = nl;
+            arena->last = LARGE_DATA(nl);
+            return arena->last;
+        }
+
+        /* 当前块中的最后一次分配：空间足够时原地调整 */
+        vox_arena_chunk_t* c = arena->current;
+        size_t off = (size_t)((char*)ptr - CHUNK_DATA(c));
+        if (new_size <= c->capacity - off) {
+            c->used = off + VOX_ALIGN_SIZE(new_size, VOX_ARENA_ALIGN);
+            return ptr;
+        }
+    }
+
+    void* p = vox_arena_alloc(arena, new_size);
+    if (!p) return NULL;
+    memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+    return p;
+}
+
+char* vox_arena_strndup(vox_arena_t* arena, const char* str, size_t len) {
+    if (!arena || (!str && len > 0) || len == SIZE_MAX) return NULL;
+    char* p = (char*)vox_arena_alloc(arena, len + 1);
+    if (!p) return NULL;
+    if (len > 0) memcpy(p, str, len);
+    p[len] = '\0';
+    return p;
+}
+
+vox_arena_mark_t vox_arena_mark(vox_arena_t* arena) {
+    vox_arena_mark_t mark;
+    memset(&mark, 0, sizeof(mark));
+    if (!arena) return mark;
+    mark.chunk = arena->current;
+    mark.used = arena->current ? arena->current->used : 0;
+    mark.large = arena->large;
+    /* 标记之前的分配不能再原地扩展：块内扩展会越过 mark.used，
+     * 单独分配交给内存池 realloc 会移动 mark.large 指向的节点 */
+    arena->last = NULL;
+    return mark;
+}
+
+void vox_arena_rewind(vox_arena_t* arena, vox_arena_mark_t mark) {
+    if (!arena) return;
+
+    free_large_until(arena, (vox_arena_large_t*)mark.large);
+    if (mark.chunk) {
+        arena->current = (vox_arena_chunk_t*)mark.chunk;
+        arena->current->used = mark.used;
+    } else {
+        /* 标记时尚未分配块：回到第一个块的起点 */
+        arena->current = arena->head;
+        if (arena->head) arena->head->used = 0;
+    }
+    arena->last = NULL;
+}
+
+void vox_arena_reset(vox_arena_t* arena) {
+    if (!arena) return;
+    vox_arena_mark_t start;
+    memset(&start, 0, sizeof(start));
+    vox_arena_rewind(arena, start);
+}
+
+vox_mpool_t* vox_arena_get_mpool(vox_arena_t* arena) {
+    if (!arena) return NULL;
+    if (!arena->adapter) {
+        arena->adapter = vox_mpool_create_arena_adapter(arena);
+        if (!arena->adapter) {
+            VOX_LOG_ERROR("Failed to create arena mpool adapter");
+        }
+    }
+    return arena->adapter;
+}
+
+int vox_arena_get_stats(const vox_arena_t* arena, vox_arena_stats_t* stats) {
+    if (!arena || !stats) return -1;
+    memset(stats, 0, sizeof(*stats));
+    stats->chunk_count = arena->chunk_count;
+    stats->large_count = arena->large_count;
+    stats->reserved = arena->chunk_count * arena->chunk_size + arena->large_bytes;
+    stats->used = arena->large_bytes;
+    if (arena->current) {
+        for (vox_arena_chunk_t* c = arena->head; c; c = c->next) {
+            stats->used += c->used;
+            if (c == arena->current) break;
+        }
+    }
+    return 0;
+}
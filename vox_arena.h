@@ -0,0 +1,135 @@
+/*
+ * vox_arena.h - 线性（bump-pointer）分配器
+ * 适用于生命周期一致的大量小对象（如一次请求内的解析树、路由参数、响应构建）：
+ * - 分配只移动当前块的游标，无槽查找、无元数据头、无逐个释放
+ * - mark/rewind 回退到之前的位置，reset 一次性回收全部内存（块保留复用）
+ * - vox_arena_get_mpool 返回以本 arena 为后端的 vox_mpool_t，
+ *   可直接传给 vox_json_parse、vox_string_create、vox_vector_create 等接受内存池的接口
+ *
+ * 说明：
+ * - 实例不是线程安全的
+ * - 返回的内存按 8 字节对齐
+ */
+
+#ifndef VOX_ARENA_H
+#define VOX_ARENA_H
+
+#include "vox_os.h"
+#include "vox_mpool.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* arena 不透明类型 */
+typedef struct vox_arena vox_arena_t;
+
+/* arena 配置 */
+typedef struct {
+    size_t chunk_size;       /* 每个块的大小，0 表示默认 64KB；超过块大小 1/4 的分配单独分配 */
+} vox_arena_config_t;
+
+/* 位置标记（用于 rewind） */
+typedef struct {
+    void* chunk;             /* 标记时的当前块 */
+    size_t used;             /* 标记时当前块的已用字节数 */
+    void* large;             /* 标记时最近的单独分配 */
+} vox_arena_mark_t;
+
+/* 统计信息 */
+typedef struct {
+    size_t chunk_count;      /* 持有的块数 */
+    size_t large_count;      /* 当前单独分配的数量 */
+    size_t reserved;         /* 持有的总字节数（块容量 + 单独分配） */
+    size_t used;             /* 已分配给调用方的字节数 */
+} vox_arena_stats_t;
+
+/**
+ * 创建 arena
+ * @param mpool 内存池指针，块和 arena 结构从中分配，必须非NULL
+ * @return 成功返回 arena 指针，失败返回NULL
+ */
+vox_arena_t* vox_arena_create(vox_mpool_t* mpool);
+
+/**
+ * 使用配置创建 arena
+ * @param mpool 内存池指针，必须非NULL
+ * @param config 配置，NULL 表示使用默认值
+ * @return 成功返回 arena 指针，失败返回NULL
+ */
+vox_arena_t* vox_arena_create_with_config(vox_mpool_t* mpool, const vox_arena_config_t* config);
+
+/**
+ * 销毁 arena，释放所有块（通过 vox_arena_get_mpool 取得的内存池同时失效）
+ * @param arena arena 指针
+ */
+void vox_arena_destroy(vox_arena_t* arena);
+
+/**
+ * 分配内存
+ * @param arena arena 指针
+ * @param size 请求的字节数
+ * @return 成功返回内存指针，失败返回NULL
+ */
+void* vox_arena_alloc(vox_arena_t* arena, size_t size);
+
+/**
+ * 重新分配内存：ptr 是最近一次分配且当前块空间足够时原地扩展或收缩，否则分配新内存并拷贝
+ * （vox_arena_mark 之后，标记之前的分配总是重新分配，新内存在 rewind 时释放，原内存保持不变）
+ * @param arena arena 指针
+ * @param ptr 原内存指针（NULL 相当于 alloc）
+ * @param old_size 原大小
+ * @param new_size 新大小
+ * @return 成功返回内存指针，失败返回NULL（原内存不变）
+ */
+void* vox_arena_realloc(vox_arena_t* arena, void* ptr, size_t old_size, size_t new_size);
+
+/**
+ * 复制一段数据到 arena 中，并在末尾追加 '\0'
+ * @return 成功返回副本指针，失败返回NULL
+ */
+char* vox_arena_strndup(vox_arena_t* arena, const char* str, size_t len);
+
+/**
+ * 记录当前位置（此后标记之前的分配不再原地 realloc）
+ * @param arena arena 指针
+ * @return 位置标记
+ */
+vox_arena_mark_t vox_arena_mark(vox_arena_t* arena);
+
+/**
+ * 回退到标记位置，释放标记之后的所有分配（块保留复用，单独分配直接释放）
+ * @param arena arena 指针
+ * @param mark 由 vox_arena_mark 返回且仍然有效的标记（回退到更早位置后，更晚的标记失效）
+ */
+void vox_arena_rewind(vox_arena_t* arena, vox_arena_mark_t mark);
+
+/**
+ * 回收全部分配，保留已有的块供后续复用
+ * @param arena arena 指针
+ */
+void vox_arena_reset(vox_arena_t* arena);
+
+/**
+ * 获取以 arena 为后端的内存池：
+ * - alloc 从 arena 分配（带 8 字节大小头，以支持 get_size/realloc）
+ * - 最近一次分配的 realloc 原地扩展；free 为空操作，内存随 reset/rewind/destroy 回收
+ * - reset 等同于 vox_arena_reset；destroy 为空操作（由 arena 负责释放）
+ * @param arena arena 指针
+ * @return 成功返回内存池指针（多次调用返回同一个），失败返回NULL
+ */
+vox_mpool_t* vox_arena_get_mpool(vox_arena_t* arena);
+
+/**
+ * 获取统计信息
+ * @return 成功返回0，失败返回-1
+ */
+int vox_arena_get_stats(const vox_arena_t* arena, vox_arena_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_ARENA_H */
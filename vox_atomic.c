@@ -11,44 +11,54 @@
 
 #ifndef VOX_OS_WINDOWS
     #include <stdatomic.h>
+
+/* 头文件中只放普通整数存储（C++ 也能包含），这里按尺寸与对齐相同的 C11 原子类型访问 */
+#define VOX_ATOMIC_INT(a) ((atomic_int*)&(a)->value)
+#define VOX_ATOMIC_LONG(a) ((atomic_llong*)&(a)->value)
+#define VOX_ATOMIC_PTR(a) ((atomic_uintptr_t*)&(a)->value)
+
+typedef char vox_atomic_int_layout_check[(sizeof(atomic_int) == sizeof(int) &&
+    VOX_ALIGNOF(atomic_int) <= VOX_ALIGNOF(vox_atomic_int_t)) ? 1 : -1];
+typedef char vox_atomic_long_layout_check[(sizeof(atomic_llong) == sizeof(long long) &&
+    VOX_ALIGNOF(atomic_llong) <= VOX_ALIGNOF(vox_atomic_long_t)) ? 1 : -1];
+typedef char vox_atomic_ptr_layout_check[(sizeof(atomic_uintptr_t) == sizeof(uintptr_t) &&
+    VOX_ALIGNOF(atomic_uintptr_t) <= VOX_ALIGNOF(vox_atomic_ptr_t)) ? 1 : -1];
 #endif
 
 /* ===== 原子整数 ===== */
 
-#ifdef VOX_OS_WINDOWS
-struct vox_atomic_int {
+/* create 分配的对象：原子变量之前保存内存池指针，销毁时据此释放 */
+typedef struct {
     vox_mpool_t* mpool;  /* 内存池指针 */
-    volatile LONG value;  /* Windows使用LONG（32位） */
-};
-#else
-struct vox_atomic_int {
-    vox_mpool_t* mpool;  /* 内存池指针 */
-    atomic_int value;    /* C11原子类型 */
-};
-#endif
+    vox_atomic_int_t atomic;
+} vox_atomic_int_box_t;
 
-vox_atomic_int_t* vox_atomic_int_create(vox_mpool_t* mpool, int32_t initial_value) {
-    if (!mpool) return NULL;
-    
-    vox_atomic_int_t* atomic = (vox_atomic_int_t*)vox_mpool_alloc(mpool, sizeof(vox_atomic_int_t));
-    if (!atomic) return NULL;
-    
-    atomic->mpool = mpool;
+void vox_atomic_int_init(vox_atomic_int_t* atomic, int32_t initial_value) {
+    if (!atomic) return;
     
 #ifdef VOX_OS_WINDOWS
     atomic->value = (LONG)initial_value;
 #else
-    atomic_init(&atomic->value, initial_value);
+    atomic_init(VOX_ATOMIC_INT(atomic), initial_value);
 #endif
+}
+
+vox_atomic_int_t* vox_atomic_int_create(vox_mpool_t* mpool, int32_t initial_value) {
+    if (!mpool) return NULL;
+    
+    vox_atomic_int_box_t* box = (vox_atomic_int_box_t*)vox_mpool_alloc(mpool, sizeof(vox_atomic_int_box_t));
+    if (!box) return NULL;
     
-    return atomic;
+    box->mpool = mpool;
+    vox_atomic_int_init(&box->atomic, initial_value);
+    return &box->atomic;
 }
 
 void vox_atomic_int_destroy(vox_atomic_int_t* atomic) {
     if (!atomic) return;
     
-    vox_mpool_t* mpool = atomic->mpool;
-    vox_mpool_free(mpool, atomic);
+    vox_atomic_int_box_t* box = (vox_atomic_int_box_t*)((char*)atomic - offsetof(vox_atomic_int_box_t, atomic));
+    vox_mpool_free(box->mpool, box);
 }
 
 int32_t vox_atomic_int_load(const vox_atomic_int_t* atomic) {
@@ -58,7 +68,7 @@ int32_t vox_atomic_int_load(const vox_atomic_int_t* atomic) {
     /* 使用volatile读取，在x86/x64上对对齐的32位整数是原子的 */
     return (int32_t)((vox_atomic_int_t*)atomic)->value;
 #else
-    return atomic_load(&atomic->value);
+    return atomic_load(VOX_ATOMIC_INT(atomic));
 #endif
 }
 
@@ -68,7 +78,7 @@ void vox_atomic_int_store(vox_atomic_int_t* atomic, int32_t value) {
 #ifdef VOX_OS_WINDOWS
     InterlockedExchange(&atomic->value, (LONG)value);
 #else
-    atomic_store(&atomic->value, value);
+    atomic_store(VOX_ATOMIC_INT(atomic), value);
 #endif
 }
 
@@ -78,7 +88,7 @@ int32_t vox_atomic_int_exchange(vox_atomic_int_t* atomic, int32_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int32_t)InterlockedExchange(&atomic->value, (LONG)value);
 #else
-    return atomic_exchange(&atomic->value, value);
+    return atomic_exchange(VOX_ATOMIC_INT(atomic), value);
 #endif
 }
 
@@ -91,7 +101,7 @@ bool vox_atomic_int_compare_exchange(vox_atomic_int_t* atomic, int32_t* expected
     *expected = (int32_t)result;
     return (result == old);
 #else
-    return atomic_compare_exchange_strong(&atomic->value, expected, desired);
+    return atomic_compare_exchange_strong(VOX_ATOMIC_INT(atomic), expected, desired);
 #endif
 }
 
@@ -101,7 +111,7 @@ int32_t vox_atomic_int_add(vox_atomic_int_t* atomic, int32_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int32_t)InterlockedExchangeAdd(&atomic->value, (LONG)value);
 #else
-    return atomic_fetch_add(&atomic->value, value);
+    return atomic_fetch_add(VOX_ATOMIC_INT(atomic), value);
 #endif
 }
 
@@ -111,7 +121,7 @@ int32_t vox_atomic_int_sub(vox_atomic_int_t* atomic, int32_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int32_t)InterlockedExchangeAdd(&atomic->value, -(LONG)value);
 #else
-    return atomic_fetch_sub(&atomic->value, value);
+    return atomic_fetch_sub(VOX_ATOMIC_INT(atomic), value);
 #endif
 }
 
@@ -121,7 +131,7 @@ int32_t vox_atomic_int_increment(vox_atomic_int_t* atomic) {
 #ifdef VOX_OS_WINDOWS
     return (int32_t)InterlockedIncrement(&atomic->value);
 #else
-    return atomic_fetch_add(&atomic->value, 1) + 1;
+    return atomic_fetch_add(VOX_ATOMIC_INT(atomic), 1) + 1;
 #endif
 }
 
@@ -131,7 +141,7 @@ int32_t vox_atomic_int_decrement(vox_atomic_int_t* atomic) {
 #ifdef VOX_OS_WINDOWS
     return (int32_t)InterlockedDecrement(&atomic->value);
 #else
-    return atomic_fetch_sub(&atomic->value, 1) - 1;
+    return atomic_fetch_sub(VOX_ATOMIC_INT(atomic), 1) - 1;
 #endif
 }
 
@@ -141,7 +151,7 @@ int32_t vox_atomic_int_and(vox_atomic_int_t* atomic, int32_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int32_t)InterlockedAnd(&atomic->value, (LONG)value);
 #else
-    return atomic_fetch_and(&atomic->value, value);
+    return atomic_fetch_and(VOX_ATOMIC_INT(atomic), value);
 #endif
 }
 
@@ -151,7 +161,7 @@ int32_t vox_atomic_int_or(vox_atomic_int_t* atomic, int32_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int32_t)InterlockedOr(&atomic->value, (LONG)value);
 #else
-    return atomic_fetch_or(&atomic->value, value);
+    return atomic_fetch_or(VOX_ATOMIC_INT(atomic), value);
 #endif
 }
 
@@ -161,46 +171,44 @@ int32_t vox_atomic_int_xor(vox_atomic_int_t* atomic, int32_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int32_t)InterlockedXor(&atomic->value, (LONG)value);
 #else
-    return atomic_fetch_xor(&atomic->value, value);
+    return atomic_fetch_xor(VOX_ATOMIC_INT(atomic), value);
 #endif
 }
 
 /* ===== 原子长整数 ===== */
 
-#ifdef VOX_OS_WINDOWS
-struct vox_atomic_long {
+/* create 分配的对象：原子变量之前保存内存池指针，销毁时据此释放 */
+typedef struct {
     vox_mpool_t* mpool;  /* 内存池指针 */
-    volatile LONGLONG value;  /* Windows使用LONGLONG（64位） */
-};
-#else
-struct vox_atomic_long {
-    vox_mpool_t* mpool;  /* 内存池指针 */
-    atomic_llong value;  /* C11原子类型 */
-};
-#endif
+    vox_atomic_long_t atomic;
+} vox_atomic_long_box_t;
 
-vox_atomic_long_t* vox_atomic_long_create(vox_mpool_t* mpool, int64_t initial_value) {
-    if (!mpool) return NULL;
-    
-    vox_atomic_long_t* atomic = (vox_atomic_long_t*)vox_mpool_alloc(mpool, sizeof(vox_atomic_long_t));
-    if (!atomic) return NULL;
-    
-    atomic->mpool = mpool;
+void vox_atomic_long_init(vox_atomic_long_t* atomic, int64_t initial_value) {
+    if (!atomic) return;
     
 #ifdef VOX_OS_WINDOWS
     atomic->value = (LONGLONG)initial_value;
 #else
-    atomic_init(&atomic->value, initial_value);
+    atomic_init(VOX_ATOMIC_LONG(atomic), initial_value);
 #endif
+}
+
+vox_atomic_long_t* vox_atomic_long_create(vox_mpool_t* mpool, int64_t initial_value) {
+    if (!mpool) return NULL;
+    
+    vox_atomic_long_box_t* box = (vox_atomic_long_box_t*)vox_mpool_alloc(mpool, sizeof(vox_atomic_long_box_t));
+    if (!box) return NULL;
     
-    return atomic;
+    box->mpool = mpool;
+    vox_atomic_long_init(&box->atomic, initial_value);
+    return &box->atomic;
 }
 
 void vox_atomic_long_destroy(vox_atomic_long_t* atomic) {
     if (!atomic) return;
     
-    vox_mpool_t* mpool = atomic->mpool;
-    vox_mpool_free(mpool, atomic);
+    vox_atomic_long_box_t* box = (vox_atomic_long_box_t*)((char*)atomic - offsetof(vox_atomic_long_box_t, atomic));
+    vox_mpool_free(box->mpool, box);
 }
 
 int64_t vox_atomic_long_load(const vox_atomic_long_t* atomic) {
@@ -211,7 +219,7 @@ int64_t vox_atomic_long_load(const vox_atomic_long_t* atomic) {
     /* 在 Windows 上使用 seq_cst 语义 */
     return (int64_t)InterlockedOr64((LONGLONG*)&((vox_atomic_long_t*)atomic)->value, 0);
 #else
-    return atomic_load(&atomic->value);
+    return atomic_load(VOX_ATOMIC_LONG(atomic));
 #endif
 }
 
@@ -224,7 +232,7 @@ int64_t vox_atomic_long_load_acquire(const vox_atomic_long_t* atomic) {
     return (int64_t)InterlockedCompareExchange64(
         (LONGLONG*)&((vox_atomic_long_t*)atomic)->value, 0, 0);
 #else
-    return atomic_load_explicit(&atomic->value, memory_order_acquire);
+    return atomic_load_explicit(VOX_ATOMIC_LONG(atomic), memory_order_acquire);
 #endif
 }
 
@@ -234,7 +242,7 @@ void vox_atomic_long_store(vox_atomic_long_t* atomic, int64_t value) {
 #ifdef VOX_OS_WINDOWS
     InterlockedExchange64(&atomic->value, (LONGLONG)value);
 #else
-    atomic_store(&atomic->value, value);
+    atomic_store(VOX_ATOMIC_LONG(atomic), value);
 #endif
 }
 
@@ -246,7 +254,7 @@ void vox_atomic_long_store_release(vox_atomic_long_t* atomic, int64_t value) {
     /* Exchange 操作隐含 release 语义（写入时） */
     InterlockedExchange64(&atomic->value, (LONGLONG)value);
 #else
-    atomic_store_explicit(&atomic->value, value, memory_order_release);
+    atomic_store_explicit(VOX_ATOMIC_LONG(atomic), value, memory_order_release);
 #endif
 }
 
@@ -256,7 +264,7 @@ int64_t vox_atomic_long_exchange(vox_atomic_long_t* atomic, int64_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int64_t)InterlockedExchange64(&atomic->value, (LONGLONG)value);
 #else
-    return atomic_exchange(&atomic->value, value);
+    return atomic_exchange(VOX_ATOMIC_LONG(atomic), value);
 #endif
 }
 
@@ -269,7 +277,7 @@ bool vox_atomic_long_compare_exchange(vox_atomic_long_t* atomic, int64_t* expect
     *expected = (int64_t)result;
     return (result == old);
 #else
-    return atomic_compare_exchange_strong(&atomic->value, expected, desired);
+    return atomic_compare_exchange_strong(VOX_ATOMIC_LONG(atomic), expected, desired);
 #endif
 }
 
@@ -279,7 +287,7 @@ int64_t vox_atomic_long_add(vox_atomic_long_t* atomic, int64_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int64_t)InterlockedExchangeAdd64(&atomic->value, (LONGLONG)value);
 #else
-    return atomic_fetch_add(&atomic->value, value);
+    return atomic_fetch_add(VOX_ATOMIC_LONG(atomic), value);
 #endif
 }
 
@@ -289,7 +297,7 @@ int64_t vox_atomic_long_sub(vox_atomic_long_t* atomic, int64_t value) {
 #ifdef VOX_OS_WINDOWS
     return (int64_t)InterlockedExchangeAdd64(&atomic->value, -(LONGLONG)value);
 #else
-    return atomic_fetch_sub(&atomic->value, value);
+    return atomic_fetch_sub(VOX_ATOMIC_LONG(atomic), value);
 #endif
 }
 
@@ -299,7 +307,7 @@ int64_t vox_atomic_long_increment(vox_atomic_long_t* atomic) {
 #ifdef VOX_OS_WINDOWS
     return (int64_t)InterlockedIncrement64(&atomic->value);
 #else
-    return atomic_fetch_add(&atomic->value, 1) + 1;
+    return atomic_fetch_add(VOX_ATOMIC_LONG(atomic), 1) + 1;
 #endif
 }
 
@@ -309,46 +317,44 @@ int64_t vox_atomic_long_decrement(vox_atomic_long_t* atomic) {
 #ifdef VOX_OS_WINDOWS
     return (int64_t)InterlockedDecrement64(&atomic->value);
 #else
-    return atomic_fetch_sub(&atomic->value, 1) - 1;
+    return atomic_fetch_sub(VOX_ATOMIC_LONG(atomic), 1) - 1;
 #endif
 }
 
 /* ===== 原子指针 ===== */
 
-#ifdef VOX_OS_WINDOWS
-struct vox_atomic_ptr {
+/* create 分配的对象：原子变量之前保存内存池指针，销毁时据此释放 */
+typedef struct {
     vox_mpool_t* mpool;  /* 内存池指针 */
-    volatile PVOID value;  /* Windows使用PVOID */
-};
-#else
-struct vox_atomic_ptr {
-    vox_mpool_t* mpool;  /* 内存池指针 */
-    atomic_uintptr_t value;  /* C11原子指针类型 */
-};
-#endif
+    vox_atomic_ptr_t atomic;
+} vox_atomic_ptr_box_t;
 
-vox_atomic_ptr_t* vox_atomic_ptr_create(vox_mpool_t* mpool, void* initial_value) {
-    if (!mpool) return NULL;
-    
-    vox_atomic_ptr_t* atomic = (vox_atomic_ptr_t*)vox_mpool_alloc(mpool, sizeof(vox_atomic_ptr_t));
-    if (!atomic) return NULL;
-    
-    atomic->mpool = mpool;
+void vox_atomic_ptr_init(vox_atomic_ptr_t* atomic, void* initial_value) {
+    if (!atomic) return;
     
 #ifdef VOX_OS_WINDOWS
     atomic->value = initial_value;
 #else
-    atomic_init(&atomic->value, (uintptr_t)initial_value);
+    atomic_init(VOX_ATOMIC_PTR(atomic), (uintptr_t)initial_value);
 #endif
+}
+
+vox_atomic_ptr_t* vox_atomic_ptr_create(vox_mpool_t* mpool, void* initial_value) {
+    if (!mpool) return NULL;
+    
+    vox_atomic_ptr_box_t* box = (vox_atomic_ptr_box_t*)vox_mpool_alloc(mpool, sizeof(vox_atomic_ptr_box_t));
+    if (!box) return NULL;
     
-    return atomic;
+    box->mpool = mpool;
+    vox_atomic_ptr_init(&box->atomic, initial_value);
+    return &box->atomic;
 }
 
 void vox_atomic_ptr_destroy(vox_atomic_ptr_t* atomic) {
     if (!atomic) return;
     
-    vox_mpool_t* mpool = atomic->mpool;
-    vox_mpool_free(mpool, atomic);
+    vox_atomic_ptr_box_t* box = (vox_atomic_ptr_box_t*)((char*)atomic - offsetof(vox_atomic_ptr_box_t, atomic));
+    vox_mpool_free(box->mpool, box);
 }
 
 void* vox_atomic_ptr_load(const vox_atomic_ptr_t* atomic) {
@@ -358,7 +364,7 @@ void* vox_atomic_ptr_load(const vox_atomic_ptr_t* atomic) {
     /* 使用volatile读取，在x86/x64上对对齐的指针是原子的 */
     return (void*)((vox_atomic_ptr_t*)atomic)->value;
 #else
-    return (void*)atomic_load(&atomic->value);
+    return (void*)atomic_load(VOX_ATOMIC_PTR(atomic));
 #endif
 }
 
@@ -368,7 +374,7 @@ void vox_atomic_ptr_store(vox_atomic_ptr_t* atomic, void* value) {
 #ifdef VOX_OS_WINDOWS
     InterlockedExchangePointer(&atomic->value, value);
 #else
-    atomic_store(&atomic->value, (uintptr_t)value);
+    atomic_store(VOX_ATOMIC_PTR(atomic), (uintptr_t)value);
 #endif
 }
 
@@ -378,7 +384,7 @@ void* vox_atomic_ptr_exchange(vox_atomic_ptr_t* atomic, void* value) {
 #ifdef VOX_OS_WINDOWS
     return InterlockedExchangePointer(&atomic->value, value);
 #else
-    return (void*)atomic_exchange(&atomic->value, (uintptr_t)value);
+    return (void*)atomic_exchange(VOX_ATOMIC_PTR(atomic), (uintptr_t)value);
 #endif
 }
 
@@ -392,7 +398,7 @@ bool vox_atomic_ptr_compare_exchange(vox_atomic_ptr_t* atomic, void** expected,
     return (result == old);
 #else
     uintptr_t exp = (uintptr_t)*expected;
-    bool success = atomic_compare_exchange_strong(&atomic->value, &exp, (uintptr_t)desired);
+    bool success = atomic_compare_exchange_strong(VOX_ATOMIC_PTR(atomic), &exp, (uintptr_t)desired);
     *expected = (void*)exp;
     return success;
 #endif
@@ -1,6 +1,12 @@
 /*
  * vox_atomic.h - 跨平台原子操作抽象API
  * 提供统一的原子操作接口，支持整数和指针类型
+ *
+ * 两种使用方式：
+ * - create/destroy：从内存池单独分配（兼容旧接口）
+ * - init：直接嵌入到调用方结构体中（值类型），访问时不再多一次指针跳转；
+ *   嵌入的原子变量不需要也不能调用 destroy
+ * 多线程频繁写入的计数器可使用 *_padded_t，按缓存行填充避免伪共享
  */
 
 #ifndef VOX_ATOMIC_H
@@ -18,8 +24,29 @@ extern "C" {
 
 /* ===== 原子整数类型 ===== */
 
-/* 原子整数不透明类型 */
-typedef struct vox_atomic_int vox_atomic_int_t;
+/* 原子整数类型（可嵌入，成员仅供内部使用）
+ * 非 Windows 平台为普通存储，只在 vox_atomic.c 中按 <stdatomic.h> 的原子类型访问，
+ * 因此本头文件不依赖 <stdatomic.h>，可被 C++ 包含 */
+typedef struct vox_atomic_int {
+#ifdef VOX_OS_WINDOWS
+    volatile LONG value;
+#else
+    int value;
+#endif
+} vox_atomic_int_t;
+
+/* 按缓存行填充的原子整数 */
+typedef struct {
+    vox_atomic_int_t value;
+    char pad[VOX_CACHE_LINE_SIZE - sizeof(vox_atomic_int_t)];
+} vox_atomic_int_padded_t;
+
+/**
+ * 初始化嵌入的原子整数（非原子操作，须在并发访问前完成）
+ * @param atomic 原子整数指针
+ * @param initial_value 初始值
+ */
+void vox_atomic_int_init(vox_atomic_int_t* atomic, int32_t initial_value);
 
 /**
  * 创建原子整数
@@ -30,7 +57,7 @@ typedef struct vox_atomic_int vox_atomic_int_t;
 vox_atomic_int_t* vox_atomic_int_create(vox_mpool_t* mpool, int32_t initial_value);
 
 /**
- * 销毁原子整数
+ * 销毁原子整数（仅用于 create 创建的对象）
  * @param atomic 原子整数指针
  */
 void vox_atomic_int_destroy(vox_atomic_int_t* atomic);
@@ -122,8 +149,27 @@ int32_t vox_atomic_int_xor(vox_atomic_int_t* atomic, int32_t value);
 
 /* ===== 原子长整数类型 ===== */
 
-/* 原子长整数不透明类型 */
-typedef struct vox_atomic_long vox_atomic_long_t;
+/* 原子长整数类型（可嵌入，成员仅供内部使用） */
+typedef struct vox_atomic_long {
+#ifdef VOX_OS_WINDOWS
+    volatile LONGLONG value;
+#else
+    long long value __attribute__((aligned(8)));  /* 32 位平台上 64 位原子操作要求 8 字节对齐 */
+#endif
+} vox_atomic_long_t;
+
+/* 按缓存行填充的原子长整数 */
+typedef struct {
+    vox_atomic_long_t value;
+    char pad[VOX_CACHE_LINE_SIZE - sizeof(vox_atomic_long_t)];
+} vox_atomic_long_padded_t;
+
+/**
+ * 初始化嵌入的原子长整数（非原子操作，须在并发访问前完成）
+ * @param atomic 原子长整数指针
+ * @param initial_value 初始值
+ */
+void vox_atomic_long_init(vox_atomic_long_t* atomic, int64_t initial_value);
 
 /**
  * 创建原子长整数
@@ -134,7 +180,7 @@ typedef struct vox_atomic_long vox_atomic_long_t;
 vox_atomic_long_t* vox_atomic_long_create(vox_mpool_t* mpool, int64_t initial_value);
 
 /**
- * 销毁原子长整数
+ * 销毁原子长整数（仅用于 create 创建的对象）
  * @param atomic 原子长整数指针
  */
 void vox_atomic_long_destroy(vox_atomic_long_t* atomic);
@@ -218,8 +264,21 @@ int64_t vox_atomic_long_decrement(vox_atomic_long_t* atomic);
 
 /* ===== 原子指针类型 ===== */
 
-/* 原子指针不透明类型 */
-typedef struct vox_atomic_ptr vox_atomic_ptr_t;
+/* 原子指针类型（可嵌入，成员仅供内部使用） */
+typedef struct vox_atomic_ptr {
+#ifdef VOX_OS_WINDOWS
+    volatile PVOID value;
+#else
+    uintptr_t value;
+#endif
+} vox_atomic_ptr_t;
+
+/**
+ * 初始化嵌入的原子指针（非原子操作，须在并发访问前完成）
+ * @param atomic 原子指针指针
+ * @param initial_value 初始值（可为NULL）
+ */
+void vox_atomic_ptr_init(vox_atomic_ptr_t* atomic, void* initial_value);
 
 /**
  * 创建原子指针
@@ -230,7 +289,7 @@ typedef struct vox_atomic_ptr vox_atomic_ptr_t;
 vox_atomic_ptr_t* vox_atomic_ptr_create(vox_mpool_t* mpool, void* initial_value);
 
 /**
- * 销毁原子指针
+ * 销毁原子指针（仅用于 create 创建的对象）
  * @param atomic 原子指针指针
  */
 void vox_atomic_ptr_destroy(vox_atomic_ptr_t* atomic);
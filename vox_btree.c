@@ -0,0 +1,805 @@
+/*
+ * vox_btree.c - B+ 树有序映射实现
+ * - 每个节点最多 VOX_BTREE_MAX 个键，非根节点至少 VOX_BTREE_MIN 个键
+ * - 内部节点：children[i] 中的键 < keys[i] <= children[i + 1] 中的键；分隔键为独立副本
+ * - 叶子保存键和值，按顺序双向链接
+ * - 插入先写入节点（数组多留一个位置）再分裂，分裂所需节点在修改前预先分配，失败时树不变
+ * 使用 vox_mpool 内存池管理所有内存分配
+ */
+
+#include "vox_btree.h"
+#include "vox_mpool.h"
+#include "vox_log.h"
+#include <string.h>
+
+#define VOX_BTREE_MAX 32                     /* 节点最多键数 */
+#define VOX_BTREE_MIN (VOX_BTREE_MAX / 2)    /* 非根节点最少键数 */
+#define VOX_BTREE_INLINE_KEY 16              /* 内联存放的最大键长度 */
+#define VOX_BTREE_MAX_DEPTH 32
+
+/* 节点中的键：短键内联，长键单独分配 */
+typedef struct {
+    size_t len;
+    union {
+        uint8_t bytes[VOX_BTREE_INLINE_KEY];
+        void* ptr;
+    } u;
+} btree_key_t;
+
+/* 节点公共头部 */
+typedef struct {
+    uint16_t count;                          /* 键数量 */
+    uint16_t leaf;                           /* 是否叶子 */
+    btree_key_t keys[VOX_BTREE_MAX + 1];     /* 多留一个位置：先插入再分裂 */
+} btree_node_t;
+
+typedef struct btree_leaf {
+    btree_node_t hdr;
+    void* values[VOX_BTREE_MAX + 1];
+    struct btree_leaf* prev;
+    struct btree_leaf* next;
+} btree_leaf_t;
+
+typedef struct {
+    btree_node_t hdr;
+    btree_node_t* children[VOX_BTREE_MAX + 2];
+} btree_inner_t;
+
+/* 查找路径上的一层 */
+typedef struct {
+    btree_inner_t* node;
+    int index;                               /* 走向的子节点下标 */
+} btree_path_t;
+
+struct vox_btree {
+    vox_mpool_t* mpool;
+    btree_node_t* root;
+    btree_leaf_t* head;                      /* 最左叶子 */
+    btree_leaf_t* tail;                      /* 最右叶子 */
+    size_t size;
+    size_t height;
+    size_t node_count;
+    vox_key_cmp_func_t key_cmp;
+    vox_value_free_func_t value_free;
+};
+
+#define AS_LEAF(n) ((btree_leaf_t*)(n))
+#define AS_INNER(n) ((btree_inner_t*)(n))
+
+static int default_key_cmp(const void* key1, const void* key2, size_t key_len) {
+    return memcmp(key1, key2, key_len);
+}
+
+/* ===== 键 ===== */
+
+static inline const void* key_data(const btree_key_t* k) {
+    return k->len <= VOX_BTREE_INLINE_KEY ? (const void*)k->u.bytes : (const void*)k->u.ptr;
+}
+
+static int key_set(vox_btree_t* tree, btree_key_t* k, const void* key, size_t len) {
+    k->len = len;
+    if (len <= VOX_BTREE_INLINE_KEY) {
+        memcpy(k->u.bytes, key, len);
+        return 0;
+    }
+    k->u.ptr = vox_mpool_alloc(tree->mpool, len);
+    if (!k->u.ptr) return -1;
+    memcpy(k->u.ptr, key, len);
+    return 0;
+}
+
+static inline void key_release(vox_btree_t* tree, btree_key_t* k) {
+    if (k->len > VOX_BTREE_INLINE_KEY) {
+        vox_mpool_free(tree->mpool, k->u.ptr);
+    }
+}
+
+/* 与 vox_rbtree 相同的比较模型：先比较长度，长度相同再比较内容 */
+static inline int compare(const vox_btree_t* tree, const void* key, size_t len,
+                          const void* other, size_t other_len) {
+    if (len != other_len) return len < other_len ? -1 : 1;
+    return tree->key_cmp(key, other, len);
+}
+
+static inline int compare_key(const vox_btree_t* tree, const void* key, size_t len, const btree_key_t* k) {
+    return compare(tree, key, len, key_data(k), k->len);
+}
+
+/* 第一个不小于 key 的位置 */
+static int node_lower_bound(const vox_btree_t* tree, const btree_node_t* n,
+                            const void* key, size_t len, bool* found) {
+    int lo = 0, hi = n->count;
+    *found = false;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        int c = compare_key(tree, key, len, &n->keys[mid]);
+        if (c > 0) {
+            lo = mid + 1;
+        } else {
+            if (c == 0) *found = true;
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* 内部节点中应进入的子节点：第一个大于 key 的分隔键的位置 */
+static int inner_child_index(const vox_btree_t* tree, const btree_node_t* n, const void* key, size_t len) {
+    bool found;
+    int i = node_lower_bound(tree, n, key, len, &found);
+    return found ? i + 1 : i;
+}
+
+/* ===== 节点分配 ===== */
+
+static btree_leaf_t* leaf_new(vox_btree_t* tree) {
+    btree_leaf_t* leaf = (btree_leaf_t*)vox_mpool_alloc(tree->mpool, sizeof(btree_leaf_t));
+    if (!leaf) return NULL;
+    leaf->hdr.count = 0;
+    leaf->hdr.leaf = 1;
+    leaf->prev = NULL;
+    leaf->next = NULL;
+    tree->node_count++;
+    return leaf;
+}
+
+static btree_inner_t* inner_new(vox_btree_t* tree) {
+    btree_inner_t* inner = (btree_inner_t*)vox_mpool_alloc(tree->mpool, sizeof(btree_inner_t));
+    if (!inner) return NULL;
+    inner->hdr.count = 0;
+    inner->hdr.leaf = 0;
+    tree->node_count++;
+    return inner;
+}
+
+static void node_free(vox_btree_t* tree, btree_node_t* n) {
+    tree->node_count--;
+    vox_mpool_free(tree->mpool, n);
+}
+
+static void free_subtree(vox_btree_t* tree, btree_node_t* n, bool free_values) {
+    if (!n) return;
+    for (int i = 0; i < n->count; i++) {
+        key_release(tree, &n->keys[i]);
+    }
+    if (n->leaf) {
+        if (free_values && tree->value_free) {
+            btree_leaf_t* leaf = AS_LEAF(n);
+            for (int i = 0; i < n->count; i++) {
+                if (leaf->values[i]) tree->value_free(leaf->values[i]);
+            }
+        }
+    } else {
+        btree_inner_t* inner = AS_INNER(n);
+        for (int i = 0; i <= n->count; i++) {
+            free_subtree(tree, inner->children[i], free_values);
+        }
+    }
+    node_free(tree, n);
+}
+
+/* ===== 创建与销毁 ===== */
+
+vox_btree_t* vox_btree_create(vox_mpool_t* mpool) {
+    return vox_btree_create_with_config(mpool, NULL);
+}
+
+vox_btree_t* vox_btree_create_with_config(vox_mpool_t* mpool, const vox_btree_config_t* config) {
+    if (!mpool) return NULL;
+
+    vox_btree_t* tree = (vox_btree_t*)vox_mpool_alloc(mpool, sizeof(vox_btree_t));
+    if (!tree) {
+        VOX_LOG_ERROR("Failed to allocate btree");
+        return NULL;
+    }
+    memset(tree, 0, sizeof(vox_btree_t));
+    tree->mpool = mpool;
+    tree->key_cmp = default_key_cmp;
+    if (config) {
+        if (config->key_cmp) tree->key_cmp = config->key_cmp;
+        tree->value_free = config->value_free;
+    }
+    return tree;
+}
+
+void vox_btree_clear(vox_btree_t* tree) {
+    if (!tree) return;
+    free_subtree(tree, tree->root, true);
+    tree->root = NULL;
+    tree->head = NULL;
+    tree->tail = NULL;
+    tree->size = 0;
+    tree->height = 0;
+}
+
+void vox_btree_destroy(vox_btree_t* tree) {
+    if (!tree) return;
+    vox_btree_clear(tree);
+    vox_mpool_free(tree->mpool, tree);
+}
+
+/* ===== 查找 ===== */
+
+/* 从根下降到 key 所在的叶子，记录路径（path 可为NULL） */
+static btree_leaf_t* descend(const vox_btree_t* tree, const void* key, size_t len,
+                             btree_path_t* path, int* depth) {
+    btree_node_t* n = tree->root;
+    int d = 0;
+    while (n && !n->leaf) {
+        int i = inner_child_index(tree, n, key, len);
+        if (path) {
+            path[d].node = AS_INNER(n);
+            path[d].index = i;
+        }
+        d++;
+        n = AS_INNER(n)->children[i];
+    }
+    if (depth) *depth = d;
+    return AS_LEAF(n);
+}
+
+void* vox_btree_find(const vox_btree_t* tree, const void* key, size_t key_len) {
+    if (!tree || !key || key_len == 0 || !tree->root) return NULL;
+    btree_leaf_t* leaf = descend(tree, key, key_len, NULL, NULL);
+    bool found;
+    int i = node_lower_bound(tree, &leaf->hdr, key, key_len, &found);
+    return found ? leaf->values[i] : NULL;
+}
+
+bool vox_btree_contains(const vox_btree_t* tree, const void* key, size_t key_len) {
+    if (!tree || !key || key_len == 0 || !tree->root) return false;
+    btree_leaf_t* leaf = descend(tree, key, key_len, NULL, NULL);
+    bool found;
+    node_lower_bound(tree, &leaf->hdr, key, key_len, &found);
+    return found;
+}
+
+size_t vox_btree_size(const vox_btree_t* tree) {
+    return tree ? tree->size : 0;
+}
+
+bool vox_btree_empty(const vox_btree_t* tree) {
+    return !tree || tree->size == 0;
+}
+
+/* ===== 插入 ===== */
+
+/* 在节点的 pos 处插入一个键（调用方负责值/子节点数组） */
+static inline void node_insert_key(btree_node_t* n, int pos, const btree_key_t* k) {
+    memmove(&n->keys[pos + 1], &n->keys[pos], (size_t)(n->count - pos) * sizeof(btree_key_t));
+    n->keys[pos] = *k;
+}
+
+int vox_btree_insert(vox_btree_t* tree, const void* key, size_t key_len, void* value) {
+    if (!tree || !key || key_len == 0) return -1;
+
+    if (!tree->root) {
+        btree_leaf_t* leaf = leaf_new(tree);
+        if (!leaf) return -1;
+        if (key_set(tree, &leaf->hdr.keys[0], key, key_len) != 0) {
+            node_free(tree, &leaf->hdr);
+            return -1;
+        }
+        leaf->values[0] = value;
+        leaf->hdr.count = 1;
+        tree->root = &leaf->hdr;
+        tree->head = tree->tail = leaf;
+        tree->height = 1;
+        tree->size = 1;
+        return 0;
+    }
+
+    btree_path_t path[VOX_BTREE_MAX_DEPTH];
+    int depth = 0;
+    btree_leaf_t* leaf = descend(tree, key, key_len, path, &depth);
+    bool found;
+    int idx = node_lower_bound(tree, &leaf->hdr, key, key_len, &found);
+    if (found) {
+        if (tree->value_free && leaf->values[idx] && leaf->values[idx] != value) {
+            tree->value_free(leaf->values[idx]);
+        }
+        leaf->values[idx] = value;
+        return 0;
+    }
+
+    /* 预先分配分裂要用的节点和叶子分隔键，保证之后的修改不会失败 */
+    btree_leaf_t* spare_leaf = NULL;
+    btree_inner_t* spare_inner[VOX_BTREE_MAX_DEPTH + 1];
+    int spare_count = 0;
+    btree_key_t sep;
+    btree_key_t nk;
+    if (key_set(tree, &nk, key, key_len) != 0) return -1;
+
+    const int left_count = (VOX_BTREE_MAX + 2) / 2;   /* 分裂后左半部分的键数 */
+    if (leaf->hdr.count == VOX_BTREE_MAX) {
+        int need = 0;
+        int d = depth - 1;
+        while (d >= 0 && path[d].node->hdr.count == VOX_BTREE_MAX) {
+            need++;
+            d--;
+        }
+        if (d < 0) need++;   /* 根也要分裂：需要新根 */
+
+        spare_leaf = leaf_new(tree);
+        bool ok = spare_leaf != NULL;
+        while (ok && spare_count < need) {
+            spare_inner[spare_count] = inner_new(tree);
+            if (!spare_inner[spare_count]) ok = false;
+            else spare_count++;
+        }
+        /* 分隔键为插入后位于 left_count 处的键 */
+        if (ok) {
+            const btree_key_t* s = idx < left_count ? &leaf->hdr.keys[left_count - 1]
+                                 : idx == left_count ? &nk
+                                 : &leaf->hdr.keys[left_count];
+            ok = key_set(tree, &sep, key_data(s), s->len) == 0;
+        }
+        if (!ok) {
+            if (spare_leaf) node_free(tree, &spare_leaf->hdr);
+            while (spare_count > 0) node_free(tree, &spare_inner[--spare_count]->hdr);
+            key_release(tree, &nk);
+            VOX_LOG_ERROR("Failed to allocate btree nodes");
+            return -1;
+        }
+    }
+
+    node_insert_key(&leaf->hdr, idx, &nk);
+    memmove(&leaf->values[idx + 1], &leaf->values[idx], (size_t)(leaf->hdr.count - idx) * sizeof(void*));
+    leaf->values[idx] = value;
+    leaf->hdr.count++;
+    tree->size++;
+    if (leaf->hdr.count <= VOX_BTREE_MAX) return 0;
+
+    /* 叶子分裂：后半部分移到新叶子 */
+    btree_leaf_t* right = spare_leaf;
+    int right_count = leaf->hdr.count - left_count;
+    memcpy(right->hdr.keys, &leaf->hdr.keys[left_count], (size_t)right_count * sizeof(btree_key_t));
+    memcpy(right->values, &leaf->values[left_count], (size_t)right_count * sizeof(void*));
+    right->hdr.count = (uint16_t)right_count;
+    leaf->hdr.count = (uint16_t)left_count;
+    right->next = leaf->next;
+    right->prev = leaf;
+    if (leaf->next) leaf->next->prev = right;
+    else tree->tail = right;
+    leaf->next = right;
+
+    /* 向上插入分隔键，父节点溢出时继续分裂（中间键上移） */
+    btree_node_t* new_child = &right->hdr;
+    int used = 0;
+    for (int d = depth - 1; d >= 0; d--) {
+        btree_inner_t* parent = path[d].node;
+        int pos = path[d].index;
+        node_insert_key(&parent->hdr, pos, &sep);
+        memmove(&parent->children[pos + 2], &parent->children[pos + 1],
+                (size_t)(parent->hdr.count - pos) * sizeof(btree_node_t*));
+        parent->children[pos + 1] = new_child;
+        parent->hdr.count++;
+        if (parent->hdr.count <= VOX_BTREE_MAX) return 0;
+
+        btree_inner_t* sibling = spare_inner[used++];
+        int mid = parent->hdr.count / 2;
+        int moved = parent->hdr.count - mid - 1;
+        sep = parent->hdr.keys[mid];
+        memcpy(sibling->hdr.keys, &parent->hdr.keys[mid + 1], (size_t)moved * sizeof(btree_key_t));
+        memcpy(sibling->children, &parent->children[mid + 1], (size_t)(moved + 1) * sizeof(btree_node_t*));
+        sibling->hdr.count = (uint16_t)moved;
+        parent->hdr.count = (uint16_t)mid;
+        new_child = &sibling->hdr;
+    }
+
+    /* 根分裂：树长高一层 */
+    btree_inner_t* root = spare_inner[used];
+    root->hdr.keys[0] = sep;
+    root->children[0] = tree->root;
+    root->children[1] = new_child;
+    root->hdr.count = 1;
+    tree->root = &root->hdr;
+    tree->height++;
+    return 0;
+}
+
+/* ===== 删除 ===== */
+
+/* 从节点删除 pos 处的键（不释放键内存） */
+static inline void node_remove_key(btree_node_t* n, int pos) {
+    memmove(&n->keys[pos], &n->keys[pos + 1], (size_t)(n->count - pos - 1) * sizeof(btree_key_t));
+}
+
+/* 从父节点删除分隔键 keys[pos] 及其右侧子节点 */
+static void inner_remove(vox_btree_t* tree, btree_inner_t* parent, int pos) {
+    key_release(tree, &parent->hdr.keys[pos]);
+    node_remove_key(&parent->hdr, pos);
+    memmove(&parent->children[pos + 1], &parent->children[pos + 2],
+            (size_t)(parent->hdr.count - pos - 1) * sizeof(btree_node_t*));
+    parent->hdr.count--;
+}
+
+/* 把右叶子合并进左叶子，sep 为二者之间分隔键在父节点中的位置 */
+static void merge_leaves(vox_btree_t* tree, btree_leaf_t* left, btree_leaf_t* right,
+                         btree_inner_t* parent, int sep) {
+    int n = left->hdr.count;
+    memcpy(&left->hdr.keys[n], right->hdr.keys, (size_t)right->hdr.count * sizeof(btree_key_t));
+    memcpy(&left->values[n], right->values, (size_t)right->hdr.count * sizeof(void*));
+    left->hdr.count = (uint16_t)(n + right->hdr.count);
+    left->next = right->next;
+    if (right->next) right->next->prev = left;
+    else tree->tail = left;
+    inner_remove(tree, parent, sep);
+    node_free(tree, &right->hdr);
+}
+
+/* 叶子键数不足：向兄弟借一个键，或与兄弟合并 */
+static void rebalance_leaf(vox_btree_t* tree, btree_leaf_t* leaf, btree_inner_t* parent, int i) {
+    btree_leaf_t* left = i > 0 ? AS_LEAF(parent->children[i - 1]) : NULL;
+    btree_leaf_t* right = i < parent->hdr.count ? AS_LEAF(parent->children[i + 1]) : NULL;
+    btree_key_t sep;
+
+    if (left && left->hdr.count > VOX_BTREE_MIN) {
+        btree_key_t* moved = &left->hdr.keys[left->hdr.count - 1];
+        if (key_set(tree, &sep, key_data(moved), moved->len) == 0) {
+            node_insert_key(&leaf->hdr, 0, moved);
+            memmove(&leaf->values[1], leaf->values, (size_t)leaf->hdr.count * sizeof(void*));
+            leaf->values[0] = left->values[left->hdr.count - 1];
+            leaf->hdr.count++;
+            left->hdr.count--;
+            key_release(tree, &parent->hdr.keys[i - 1]);
+            parent->hdr.keys[i - 1] = sep;
+            return;
+        }
+    }
+    if (right && right->hdr.count > VOX_BTREE_MIN) {
+        btree_key_t* next_first = &right->hdr.keys[1];
+        if (key_set(tree, &sep, key_data(next_first), next_first->len) == 0) {
+            leaf->hdr.keys[leaf->hdr.count] = right->hdr.keys[0];
+            leaf->values[leaf->hdr.count] = right->values[0];
+            leaf->hdr.count++;
+            node_remove_key(&right->hdr, 0);
+            memmove(right->values, &right->values[1], (size_t)(right->hdr.count - 1) * sizeof(void*));
+            right->hdr.count--;
+            key_release(tree, &parent->hdr.keys[i]);
+            parent->hdr.keys[i] = sep;
+            return;
+        }
+    }
+    if (left && left->hdr.count + leaf->hdr.count <= VOX_BTREE_MAX) {
+        merge_leaves(tree, left, leaf, parent, i - 1);
+    } else if (right && leaf->hdr.count + right->hdr.count <= VOX_BTREE_MAX) {
+        merge_leaves(tree, leaf, right, parent, i);
+    } else {
+        /* 只有复制长分隔键失败时才会走到这里：保持键数不足，树仍然有效 */
+        VOX_LOG_ERROR("Failed to rebalance btree leaf");
+    }
+}
+
+/* 内部节点键数不足：经父节点旋转借一个键，或与兄弟合并 */
+static void rebalance_inner(vox_btree_t* tree, btree_inner_t* node, btree_inner_t* parent, int i) {
+    btree_inner_t* left = i > 0 ? AS_INNER(parent->children[i - 1]) : NULL;
+    btree_inner_t* right = i < parent->hdr.count ? AS_INNER(parent->children[i + 1]) : NULL;
+
+    if (left && left->hdr.count > VOX_BTREE_MIN) {
+        int ln = left->hdr.count;
+        node_insert_key(&node->hdr, 0, &parent->hdr.keys[i - 1]);
+        memmove(&node->children[1], node->children, (size_t)(node->hdr.count + 1) * sizeof(btree_node_t*));
+        node->children[0] = left->children[ln];
+        node->hdr.count++;
+        parent->hdr.keys[i - 1] = left->hdr.keys[ln - 1];
+        left->hdr.count--;
+        return;
+    }
+    if (right && right->hdr.count > VOX_BTREE_MIN) {
+        int n = node->hdr.count;
+        node->hdr.keys[n] = parent->hdr.keys[i];
+        node->children[n + 1] = right->children[0];
+        node->hdr.count++;
+        parent->hdr.keys[i] = right->hdr.keys[0];
+        node_remove_key(&right->hdr, 0);
+        memmove(right->children, &right->children[1], (size_t)right->hdr.count * sizeof(btree_node_t*));
+        right->hdr.count--;
+        return;
+    }
+
+    /* 合并：左 + 分隔键 + 右 */
+    btree_inner_t* l = left ? left : node;
+    btree_inner_t* r = left ? node : right;
+    int sep = left ? i - 1 : i;
+    if (!r) return;
+    int n = l->hdr.count;
+    l->hdr.keys[n] = parent->hdr.keys[sep];
+    memcpy(&l->hdr.keys[n + 1], r->hdr.keys, (size_t)r->hdr.count * sizeof(btree_key_t));
+    memcpy(&l->children[n + 1], r->children, (size_t)(r->hdr.count + 1) * sizeof(btree_node_t*));
+    l->hdr.count = (uint16_t)(n + 1 + r->hdr.count);
+    /* 分隔键已下移到子节点，从父节点移除时不释放 */
+    node_remove_key(&parent->hdr, sep);
+    memmove(&parent->children[sep + 1], &parent->children[sep + 2],
+            (size_t)(parent->hdr.count - sep - 1) * sizeof(btree_node_t*));
+    parent->hdr.count--;
+    node_free(tree, &r->hdr);
+}
+
+int vox_btree_delete(vox_btree_t* tree, const void* key, size_t key_len) {
+    if (!tree || !key || key_len == 0 || !tree->root) return -1;
+
+    btree_path_t path[VOX_BTREE_MAX_DEPTH];
+    int depth = 0;
+    btree_leaf_t* leaf = descend(tree, key, key_len, path, &depth);
+    bool found;
+    int idx = node_lower_bound(tree, &leaf->hdr, key, key_len, &found);
+    if (!found) return -1;
+
+    void* value = leaf->values[idx];
+    key_release(tree, &leaf->hdr.keys[idx]);
+    node_remove_key(&leaf->hdr, idx);
+    memmove(&leaf->values[idx], &leaf->values[idx + 1], (size_t)(leaf->hdr.count - idx - 1) * sizeof(void*));
+    leaf->hdr.count--;
+    tree->size--;
+    if (tree->value_free && value) {
+        tree->value_free(value);
+    }
+
+    if (depth == 0) {
+        if (leaf->hdr.count == 0) {
+            node_free(tree, &leaf->hdr);
+            tree->root = NULL;
+            tree->head = tree->tail = NULL;
+            tree->height = 0;
+        }
+        return 0;
+    }
+    if (leaf->hdr.count >= VOX_BTREE_MIN) return 0;
+
+    rebalance_leaf(tree, leaf, path[depth - 1].node, path[depth - 1].index);
+    for (int d = depth - 1; d >= 1; d--) {
+        btree_inner_t* node = path[d].node;
+        if (node->hdr.count >= VOX_BTREE_MIN) break;
+        rebalance_inner(tree, node, path[d - 1].node, path[d - 1].index);
+    }
+
+    /* 根只剩一个子节点：树降低一层 */
+    if (!tree->root->leaf && tree->root->count == 0) {
+        btree_node_t* old = tree->root;
+        tree->root = AS_INNER(old)->children[0];
+        node_free(tree, old);
+        tree->height--;
+    }
+    return 0;
+}
+
+/* ===== 批量构建 ===== */
+
+int vox_btree_bulk_load(vox_btree_t* tree, const vox_btree_item_t* items, size_t count) {
+    if (!tree || tree->root || (!items && count > 0)) return -1;
+    if (count == 0) return 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!items[i].key || items[i].key_len == 0) return -1;
+        if (i > 0 && compare(tree, items[i - 1].key, items[i - 1].key_len,
+                             items[i].key, items[i].key_len) >= 0) {
+            VOX_LOG_ERROR("btree bulk load input is not strictly ascending at %zu", i);
+            return -1;
+        }
+    }
+
+    /* 每层节点与其子树最小键（指向叶子中的键） */
+    size_t n = (count + VOX_BTREE_MAX - 1) / VOX_BTREE_MAX;
+    btree_node_t** nodes = (btree_node_t**)vox_mpool_alloc(tree->mpool, n * sizeof(btree_node_t*));
+    const btree_key_t** mins = (const btree_key_t**)vox_mpool_alloc(tree->mpool, n * sizeof(btree_key_t*));
+    if (!nodes || !mins) {
+        if (nodes) vox_mpool_free(tree->mpool, nodes);
+        if (mins) vox_mpool_free(tree->mpool, mins);
+        return -1;
+    }
+
+    /* 叶子层：元素平均分配，保证每个叶子不少于最小键数 */
+    size_t built = 0;
+    size_t item = 0;
+    btree_leaf_t* prev = NULL;
+    for (; built < n; built++) {
+        size_t take = count / n + (built < count % n ? 1 : 0);
+        btree_leaf_t* leaf = leaf_new(tree);
+        if (!leaf) goto fail_leaves;
+        nodes[built] = &leaf->hdr;
+        leaf->prev = prev;
+        if (prev) prev->next = leaf;
+        prev = leaf;
+        for (size_t k = 0; k < take; k++, item++) {
+            if (key_set(tree, &leaf->hdr.keys[k], items[item].key, items[item].key_len) != 0) {
+                built++;
+                goto fail_leaves;
+            }
+            leaf->values[k] = items[item].value;
+            leaf->hdr.count++;
+        }
+        mins[built] = &leaf->hdr.keys[0];
+    }
+    tree->head = AS_LEAF(nodes[0]);
+    tree->tail = prev;
+    tree->height = 1;
+
+    /* 逐层向上构建内部节点（原地覆盖 nodes/mins：父节点下标不超过其第一个子节点的下标） */
+    while (n > 1) {
+        size_t parents = (n + VOX_BTREE_MAX) / (VOX_BTREE_MAX + 1);
+        size_t child = 0;
+        for (size_t p = 0; p < parents; p++) {
+            size_t take = n / parents + (p < n % parents ? 1 : 0);
+            btree_inner_t* inner = inner_new(tree);
+            if (!inner) {
+                for (size_t j = 0; j < p; j++) free_subtree(tree, nodes[j], false);
+                for (size_t j = child; j < n; j++) free_subtree(tree, nodes[j], false);
+                goto fail;
+            }
+            const btree_key_t* first_min = mins[child];
+            inner->children[0] = nodes[child];
+            for (size_t k = 1; k < take; k++) {
+                const btree_key_t* m = mins[child + k];
+                if (key_set(tree, &inner->hdr.keys[k - 1], key_data(m), m->len) != 0) {
+                    for (size_t j = 0; j < p; j++) free_subtree(tree, nodes[j], false);
+                    free_subtree(tree, &inner->hdr, false);
+                    for (size_t j = child + k; j < n; j++) free_subtree(tree, nodes[j], false);
+                    goto fail;
+                }
+                inner->children[k] = nodes[child + k];
+                inner->hdr.count++;
+            }
+            child += take;
+            nodes[p] = &inner->hdr;
+            mins[p] = first_min;
+        }
+        n = parents;
+        tree->height++;
+    }
+
+    tree->root = nodes[0];
+    tree->size = count;
+    vox_mpool_free(tree->mpool, nodes);
+    vox_mpool_free(tree->mpool, mins);
+    return 0;
+
+fail_leaves:
+    for (size_t j = 0; j < built; j++) free_subtree(tree, nodes[j], false);
+fail:
+    VOX_LOG_ERROR("Failed to allocate btree nodes for bulk load");
+    tree->head = tree->tail = NULL;
+    tree->height = 0;
+    vox_mpool_free(tree->mpool, nodes);
+    vox_mpool_free(tree->mpool, mins);
+    return -1;
+}
+
+/* ===== 迭代器 ===== */
+
+/* 跳过空叶子（只在长分隔键复制失败导致再平衡放弃时才可能出现） */
+static void iter_fix_forward(vox_btree_iter_t* it) {
+    btree_leaf_t* leaf = (btree_leaf_t*)it->leaf;
+    while (leaf && it->index >= leaf->hdr.count) {
+        leaf = leaf->next;
+        it->index = 0;
+    }
+    it->leaf = leaf;
+}
+
+vox_btree_iter_t vox_btree_first(const vox_btree_t* tree) {
+    vox_btree_iter_t it = {tree, NULL, 0};
+    if (tree) {
+        it.leaf = tree->head;
+        iter_fix_forward(&it);
+    }
+    return it;
+}
+
+vox_btree_iter_t vox_btree_last(const vox_btree_t* tree) {
+    vox_btree_iter_t it = {tree, NULL, 0};
+    if (!tree) return it;
+    btree_leaf_t* leaf = tree->tail;
+    while (leaf && leaf->hdr.count == 0) leaf = leaf->prev;
+    if (leaf) {
+        it.leaf = leaf;
+        it.index = (size_t)leaf->hdr.count - 1;
+    }
+    return it;
+}
+
+static vox_btree_iter_t seek(const vox_btree_t* tree, const void* key, size_t key_len, bool upper) {
+    vox_btree_iter_t it = {tree, NULL, 0};
+    if (!tree || !key || key_len == 0 || !tree->root) return it;
+    btree_leaf_t* leaf = descend(tree, key, key_len, NULL, NULL);
+    bool found;
+    int i = node_lower_bound(tree, &leaf->hdr, key, key_len, &found);
+    if (upper && found) i++;
+    it.leaf = leaf;
+    it.index = (size_t)i;
+    iter_fix_forward(&it);
+    return it;
+}
+
+vox_btree_iter_t vox_btree_lower_bound(const vox_btree_t* tree, const void* key, size_t key_len) {
+    return seek(tree, key, key_len, false);
+}
+
+vox_btree_iter_t vox_btree_upper_bound(const vox_btree_t* tree, const void* key, size_t key_len) {
+    return seek(tree, key, key_len, true);
+}
+
+void vox_btree_iter_next(vox_btree_iter_t* it) {
+    if (!vox_btree_iter_valid(it)) return;
+    it->index++;
+    iter_fix_forward(it);
+}
+
+void vox_btree_iter_prev(vox_btree_iter_t* it) {
+    if (!vox_btree_iter_valid(it)) return;
+    if (it->index > 0) {
+        it->index--;
+        return;
+    }
+    btree_leaf_t* leaf = ((btree_leaf_t*)it->leaf)->prev;
+    while (leaf && leaf->hdr.count == 0) leaf = leaf->prev;
+    it->leaf = leaf;
+    it->index = leaf ? (size_t)leaf->hdr.count - 1 : 0;
+}
+
+const void* vox_btree_iter_key(const vox_btree_iter_t* it, size_t* key_len_out) {
+    if (!vox_btree_iter_valid(it)) return NULL;
+    const btree_key_t* k = &((const btree_leaf_t*)it->leaf)->hdr.keys[it->index];
+    if (key_len_out) *key_len_out = k->len;
+    return key_data(k);
+}
+
+void* vox_btree_iter_value(const vox_btree_iter_t* it) {
+    if (!vox_btree_iter_valid(it)) return NULL;
+    return ((const btree_leaf_t*)it->leaf)->values[it->index];
+}
+
+/* ===== 遍历 ===== */
+
+size_t vox_btree_foreach(const vox_btree_t* tree, vox_btree_visit_func_t visit, void* user_data) {
+    if (!tree || !visit) return 0;
+    size_t count = 0;
+    for (const btree_leaf_t* leaf = tree->head; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->hdr.count; i++) {
+            const btree_key_t* k = &leaf->hdr.keys[i];
+            visit(key_data(k), k->len, leaf->values[i], user_data);
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t vox_btree_range(const vox_btree_t* tree,
+                       const void* lo, size_t lo_len,
+                       const void* hi, size_t hi_len,
+                       vox_btree_visit_func_t visit, void* user_data) {
+    if (!tree || !visit) return 0;
+    vox_btree_iter_t it = lo ? vox_btree_lower_bound(tree, lo, lo_len) : vox_btree_first(tree);
+    size_t count = 0;
+    while (vox_btree_iter_valid(&it)) {
+        size_t len;
+        const void* key = vox_btree_iter_key(&it, &len);
+        if (hi && compare(tree, key, len, hi, hi_len) >= 0) break;
+        visit(key, len, vox_btree_iter_value(&it), user_data);
+        count++;
+        vox_btree_iter_next(&it);
+    }
+    return count;
+}
+
+int vox_btree_min(const vox_btree_t* tree, const void** key_out, size_t* key_len_out) {
+    vox_btree_iter_t it = vox_btree_first(tree);
+    if (!vox_btree_iter_valid(&it)) return -1;
+    const void* key = vox_btree_iter_key(&it, key_len_out);
+    if (key_out) *key_out = key;
+    return 0;
+}
+
+int vox_btree_max(const vox_btree_t* tree, const void** key_out, size_t* key_len_out) {
+    vox_btree_iter_t it = vox_btree_last(tree);
+    if (!vox_btree_iter_valid(&it)) return -1;
+    const void* key = vox_btree_iter_key(&it, key_len_out);
+    if (key_out) *key_out = key;
+    return 0;
+}
+
+void vox_btree_stats(const vox_btree_t* tree, size_t* height, size_t* node_count) {
+    if (!tree) return;
+    if (height) *height = tree->height;
+    if (node_count) *node_count = tree->node_count;
+}
@@ -0,0 +1,213 @@
+/*
+ * vox_btree.h - B+ 树有序映射
+ * 与 vox_rbtree 相同的键比较模型（先比较长度，长度相同再调用 key_cmp），但每个节点容纳多个键：
+ * - 节点内键连续存放，不超过 16 字节的键直接内联在节点中，查找时逐层二分而不是逐个节点跳转
+ * - 数据只存放在叶子中，叶子之间双向链接，范围扫描和迭代顺序访问内存
+ * - 支持 lower_bound/upper_bound 定位、区间遍历，以及从有序输入批量构建
+ * 使用 vox_mpool 内存池管理所有内存分配
+ */
+
+#ifndef VOX_BTREE_H
+#define VOX_BTREE_H
+
+#include "vox_mpool.h"
+#include "vox_kv_types.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* B+ 树不透明类型 */
+typedef struct vox_btree vox_btree_t;
+
+/* 遍历回调函数类型 */
+typedef void (*vox_btree_visit_func_t)(const void* key, size_t key_len, void* value, void* user_data);
+
+/* B+ 树配置 */
+typedef struct {
+    vox_key_cmp_func_t key_cmp;       /* 键比较函数（只用于等长键），NULL表示使用memcmp */
+    vox_value_free_func_t value_free; /* 值释放函数，NULL表示不释放 */
+} vox_btree_config_t;
+
+/* 批量构建的输入项 */
+typedef struct {
+    const void* key;
+    size_t key_len;
+    void* value;
+} vox_btree_item_t;
+
+/* 迭代器（值类型；树被修改后失效） */
+typedef struct {
+    const vox_btree_t* tree;
+    void* leaf;          /* 当前叶子，NULL 表示已越过末尾/开头 */
+    size_t index;        /* 叶子中的位置 */
+} vox_btree_iter_t;
+
+/**
+ * 使用默认配置创建 B+ 树
+ * @param mpool 内存池指针，必须非NULL
+ * @return 成功返回树指针，失败返回NULL
+ */
+vox_btree_t* vox_btree_create(vox_mpool_t* mpool);
+
+/**
+ * 使用自定义配置创建 B+ 树
+ * @param mpool 内存池指针，必须非NULL
+ * @param config 配置结构体，NULL表示使用默认配置
+ * @return 成功返回树指针，失败返回NULL
+ */
+vox_btree_t* vox_btree_create_with_config(vox_mpool_t* mpool, const vox_btree_config_t* config);
+
+/**
+ * 插入或更新键值对（键被复制）
+ * @param tree 树指针
+ * @param key 键指针
+ * @param key_len 键长度（字节，必须大于0）
+ * @param value 值指针
+ * @return 成功返回0，失败返回-1
+ */
+int vox_btree_insert(vox_btree_t* tree, const void* key, size_t key_len, void* value);
+
+/**
+ * 查找值
+ * @return 找到返回值指针，未找到返回NULL
+ */
+void* vox_btree_find(const vox_btree_t* tree, const void* key, size_t key_len);
+
+/**
+ * 删除键值对
+ * @return 成功返回0，键不存在返回-1
+ */
+int vox_btree_delete(vox_btree_t* tree, const void* key, size_t key_len);
+
+/**
+ * 检查键是否存在
+ */
+bool vox_btree_contains(const vox_btree_t* tree, const void* key, size_t key_len);
+
+/**
+ * 获取元素数量
+ */
+size_t vox_btree_size(const vox_btree_t* tree);
+
+/**
+ * 检查树是否为空
+ */
+bool vox_btree_empty(const vox_btree_t* tree);
+
+/**
+ * 清空树
+ * @param tree 树指针
+ */
+void vox_btree_clear(vox_btree_t* tree);
+
+/**
+ * 销毁树并释放所有资源
+ * @param tree 树指针
+ */
+void vox_btree_destroy(vox_btree_t* tree);
+
+/**
+ * 从按键严格递增的输入批量构建（叶子按满载填充，比逐个插入快得多）
+ * @param tree 树指针，必须为空
+ * @param items 输入项数组
+ * @param count 输入项数量
+ * @return 成功返回0；树非空、输入未严格递增或内存不足返回-1（失败时树保持为空）
+ */
+int vox_btree_bulk_load(vox_btree_t* tree, const vox_btree_item_t* items, size_t count);
+
+/**
+ * 按键顺序遍历所有键值对
+ * @return 返回遍历的元素数量
+ */
+size_t vox_btree_foreach(const vox_btree_t* tree, vox_btree_visit_func_t visit, void* user_data);
+
+/**
+ * 按键顺序遍历区间 [lo, hi) 内的键值对
+ * @param lo 下界（包含），NULL 表示不限
+ * @param hi 上界（不包含），NULL 表示不限
+ * @return 返回遍历的元素数量
+ */
+size_t vox_btree_range(const vox_btree_t* tree,
+                       const void* lo, size_t lo_len,
+                       const void* hi, size_t hi_len,
+                       vox_btree_visit_func_t visit, void* user_data);
+
+/**
+ * 获取最小键
+ * @return 成功返回0，树为空返回-1
+ */
+int vox_btree_min(const vox_btree_t* tree, const void** key_out, size_t* key_len_out);
+
+/**
+ * 获取最大键
+ * @return 成功返回0，树为空返回-1
+ */
+int vox_btree_max(const vox_btree_t* tree, const void** key_out, size_t* key_len_out);
+
+/**
+ * 获取统计信息（用于调试）
+ * @param height 输出树高（空树为0）
+ * @param node_count 输出节点数
+ */
+void vox_btree_stats(const vox_btree_t* tree, size_t* height, size_t* node_count);
+
+/* ===== 迭代器 ===== */
+
+/**
+ * 定位到第一个元素
+ */
+vox_btree_iter_t vox_btree_first(const vox_btree_t* tree);
+
+/**
+ * 定位到最后一个元素
+ */
+vox_btree_iter_t vox_btree_last(const vox_btree_t* tree);
+
+/**
+ * 定位到第一个不小于 key 的元素
+ */
+vox_btree_iter_t vox_btree_lower_bound(const vox_btree_t* tree, const void* key, size_t key_len);
+
+/**
+ * 定位到第一个大于 key 的元素
+ */
+vox_btree_iter_t vox_btree_upper_bound(const vox_btree_t* tree, const void* key, size_t key_len);
+
+/**
+ * 迭代器是否指向有效元素
+ */
+static inline bool vox_btree_iter_valid(const vox_btree_iter_t* it) {
+    return it && it->leaf != NULL;
+}
+
+/**
+ * 移动到下一个元素（越过末尾后失效）
+ */
+void vox_btree_iter_next(vox_btree_iter_t* it);
+
+/**
+ * 移动到上一个元素（越过开头后失效）
+ */
+void vox_btree_iter_prev(vox_btree_iter_t* it);
+
+/**
+ * 获取当前元素的键
+ * @param key_len_out 输出键长度（可为NULL）
+ * @return 返回键指针，迭代器无效时返回NULL
+ */
+const void* vox_btree_iter_key(const vox_btree_iter_t* it, size_t* key_len_out);
+
+/**
+ * 获取当前元素的值，迭代器无效时返回NULL
+ */
+void* vox_btree_iter_value(const vox_btree_iter_t* it);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_BTREE_H */
@@ -0,0 +1,78 @@
+/*
+ * vox_bytes.c - 引用计数的不可变字节切片实现
+ * 缓冲区头部与数据一次分配：[vox_bytes_buf_t][data...]['\0']
+ */
+
+#include "vox_bytes.h"
+#include "vox_atomic.h"
+#include <string.h>
+
+struct vox_bytes_buf {
+    vox_mpool_t* mpool;          /* 分配所用的内存池 */
+    vox_atomic_int_t refcount;   /* 引用计数 */
+    size_t len;                  /* 数据长度 */
+};
+
+#define BYTES_BUF_DATA(b) ((char*)(b) + sizeof(vox_bytes_buf_t))
+
+char* vox_bytes_alloc(vox_mpool_t* mpool, size_t len, vox_bytes_t* out) {
+    if (!mpool || !out) return NULL;
+    if (len > SIZE_MAX - sizeof(vox_bytes_buf_t) - 1) return NULL;
+
+    vox_bytes_buf_t* buf = (vox_bytes_buf_t*)vox_mpool_alloc(mpool, sizeof(vox_bytes_buf_t) + len + 1);
+    if (!buf) return NULL;
+    buf->mpool = mpool;
+    buf->len = len;
+    vox_atomic_int_init(&buf->refcount, 1);
+
+    char* data = BYTES_BUF_DATA(buf);
+    data[len] = '\0';
+    out->buf = buf;
+    out->ptr = data;
+    out->len = len;
+    return data;
+}
+
+int vox_bytes_create(vox_mpool_t* mpool, const void* data, size_t len, vox_bytes_t* out) {
+    if (!data && len > 0) return -1;
+    char* dst = vox_bytes_alloc(mpool, len, out);
+    if (!dst) return -1;
+    if (len > 0) memcpy(dst, data, len);
+    return 0;
+}
+
+vox_bytes_t vox_bytes_retain(const vox_bytes_t* bytes) {
+    vox_bytes_t r = VOX_BYTES_NULL;
+    if (!bytes || !bytes->buf) return r;
+    vox_atomic_int_increment(&bytes->buf->refcount);
+    return *bytes;
+}
+
+vox_bytes_t vox_bytes_slice(const vox_bytes_t* bytes, size_t offset, size_t len) {
+    vox_bytes_t r = VOX_BYTES_NULL;
+    if (!bytes || !bytes->buf) return r;
+    if (offset > bytes->len) offset = bytes->len;
+    if (len > bytes->len - offset) len = bytes->len - offset;
+    vox_atomic_int_increment(&bytes->buf->refcount);
+    r.buf = bytes->buf;
+    r.ptr = bytes->ptr + offset;
+    r.len = len;
+    return r;
+}
+
+void vox_bytes_release(vox_bytes_t* bytes) {
+    if (!bytes) return;
+    vox_bytes_buf_t* buf = bytes->buf;
+    bytes->buf = NULL;
+    bytes->ptr = NULL;
+    bytes->len = 0;
+    if (!buf) return;
+    if (vox_atomic_int_decrement(&buf->refcount) == 0) {
+        vox_mpool_free(buf->mpool, buf);
+    }
+}
+
+int32_t vox_bytes_refcount(const vox_bytes_t* bytes) {
+    if (!bytes || !bytes->buf) return 0;
+    return vox_atomic_int_load(&bytes->buf->refcount);
+}
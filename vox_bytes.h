@@ -0,0 +1,88 @@
+/*
+ * vox_bytes.h - 引用计数的不可变字节切片
+ * - 数据只在创建时复制一次，之后 slice/retain 只增加引用计数，不再 memcpy
+ * - vox_bytes_t 是值类型（缓冲区指针 + 数据指针 + 长度），可直接嵌入其它结构或按值传递
+ * - 引用计数为原子操作，切片可在线程间传递；最后一次 release 时把缓冲区归还创建时的内存池，
+ *   跨线程释放时该内存池须为线程安全的
+ */
+
+#ifndef VOX_BYTES_H
+#define VOX_BYTES_H
+
+#include "vox_os.h"
+#include "vox_mpool.h"
+#include "vox_string.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 共享缓冲区不透明类型 */
+typedef struct vox_bytes_buf vox_bytes_buf_t;
+
+/* 字节切片 */
+typedef struct {
+    vox_bytes_buf_t* buf;    /* 共享缓冲区，NULL 表示空切片 */
+    const char* ptr;         /* 切片起始位置 */
+    size_t len;              /* 切片长度 */
+} vox_bytes_t;
+
+/* 空切片常量 */
+#define VOX_BYTES_NULL {NULL, NULL, 0}
+
+/**
+ * 分配一个长度为 len 的缓冲区，返回可写指针供调用方填充（填充完成后视为不可变）
+ * @param mpool 内存池指针，必须非NULL
+ * @param len 数据长度（缓冲区末尾额外保留一个 '\0'）
+ * @param out 输出切片（引用计数为1）
+ * @return 成功返回可写指针，失败返回NULL
+ */
+char* vox_bytes_alloc(vox_mpool_t* mpool, size_t len, vox_bytes_t* out);
+
+/**
+ * 复制数据创建切片
+ * @param mpool 内存池指针，必须非NULL
+ * @param data 数据（len 为 0 时可为NULL）
+ * @param len 数据长度
+ * @param out 输出切片（引用计数为1）
+ * @return 成功返回0，失败返回-1
+ */
+int vox_bytes_create(vox_mpool_t* mpool, const void* data, size_t len, vox_bytes_t* out);
+
+/**
+ * 增加引用，返回指向同一数据的切片
+ */
+vox_bytes_t vox_bytes_retain(const vox_bytes_t* bytes);
+
+/**
+ * 取子切片（共享缓冲区并增加引用）；offset/len 超出范围时截断
+ */
+vox_bytes_t vox_bytes_slice(const vox_bytes_t* bytes, size_t offset, size_t len);
+
+/**
+ * 释放引用，并将 bytes 置为空切片
+ */
+void vox_bytes_release(vox_bytes_t* bytes);
+
+/**
+ * 当前引用计数（用于调试和测试），空切片返回0
+ */
+int32_t vox_bytes_refcount(const vox_bytes_t* bytes);
+
+/* 以字符串视图访问切片 */
+static inline vox_strview_t vox_bytes_view(const vox_bytes_t* bytes) {
+    vox_strview_t sv = VOX_STRVIEW_NULL;
+    if (bytes && bytes->ptr) {
+        sv.ptr = bytes->ptr;
+        sv.len = bytes->len;
+    }
+    return sv;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_BYTES_H */
@@ -0,0 +1,547 @@
+/*
+ * vox_chtable.c - 并发哈希表实现
+ * 槽数组为原子指针数组（线性探测），每个槽指向不可变条目 {哈希, 值, 键}：
+ * - 读者：pin -> 加载当前槽数组 -> 探测 -> unpin，全程无锁
+ * - 写者：按哈希取分段锁；空槽/墓碑用 CAS 占用（不同分段可能争抢同一个槽），
+ *   已有条目由所属分段独占修改，直接原子替换；删除写入墓碑
+ * - 扩容：锁住全部分段，把条目指针（保存了完整哈希，无需重算）搬到新数组后原子发布，
+ *   旧数组与被替换的条目一样交给 vox_ebr 延迟回收
+ * - 每个表有自己的 EBR 域：pin/unpin 即 vox_ebr_enter/exit，退休对象在所有
+ *   可能持有它的读者离开临界区后才释放
+ */
+
+#include "vox_chtable.h"
+#include "vox_atomic.h"
+#include "vox_mutex.h"
+#include "vox_thread.h"
+#include "vox_log.h"
+#include <string.h>
+
+#define VOX_CHTABLE_DEFAULT_CAPACITY 64
+#define VOX_CHTABLE_WRITE_STRIPES 64      /* 写分段数（2的幂） */
+
+/* 待回收对象类型 */
+enum {
+    CHTABLE_RETIRED_ENTRY = 0,
+    CHTABLE_RETIRED_ARRAY = 1
+};
+
+/* 待回收对象头部（只由写者访问） */
+typedef struct {
+    int kind;
+    int free_value;                  /* 回收条目时是否调用 value_free */
+} chtable_retired_t;
+
+/* 条目（插入后不再修改，键紧随其后） */
+typedef struct {
+    chtable_retired_t retired;
+    uint64_t hash;
+    void* value;
+    size_t key_len;
+} chtable_entry_t;
+
+/* 槽数组（槽紧随其后） */
+typedef struct {
+    chtable_retired_t retired;
+    size_t capacity;                 /* 2的幂 */
+    size_t growth_limit;             /* 已占用槽（条目 + 墓碑）达到该值时扩容 */
+} chtable_array_t;
+
+#define ENTRY_KEY(e) ((char*)(e) + sizeof(chtable_entry_t))
+#define ARRAY_SLOTS(a) ((vox_atomic_ptr_t*)((char*)(a) + sizeof(chtable_array_t)))
+
+/* 墓碑：已删除的槽，探测时跳过，插入时可复用 */
+static char chtable_tombstone_mark;
+#define TOMBSTONE ((void*)&chtable_tombstone_mark)
+
+/* 写分段锁（按缓存行填充） */
+typedef union {
+    vox_mutex_t lock;
+    char pad[VOX_CACHE_LINE_SIZE];
+} chtable_stripe_t;
+
+struct vox_chtable {
+    vox_mpool_t* mpool;              /* 表结构所在的内存池 */
+    vox_mpool_t* pool;               /* 条目与槽数组的内部线程安全内存池 */
+    vox_hash_func_t hash_func;
+    vox_value_free_func_t value_free;
+    size_t initial_capacity;
+
+    vox_atomic_ptr_t array;          /* 当前槽数组 */
+    char pad0[VOX_CACHE_LINE_SIZE];
+    vox_atomic_long_padded_t size;   /* 元素数量 */
+    vox_atomic_long_padded_t used;   /* 已占用槽数量（条目 + 墓碑） */
+    chtable_stripe_t stripes[VOX_CHTABLE_WRITE_STRIPES];
+
+    vox_ebr_t* ebr;                  /* 旧条目与旧槽数组的延迟回收 */
+};
+
+/* ===== 延迟回收 ===== */
+
+void vox_chtable_pin(vox_chtable_t* table, vox_chtable_guard_t* guard) {
+    if (!guard) return;
+    guard->thread = table ? vox_ebr_thread(table->ebr) : NULL;
+    if (!guard->thread) {
+        if (table) VOX_LOG_ERROR("Failed to register chtable reader");
+        return;
+    }
+    vox_ebr_enter(guard->thread);
+}
+
+void vox_chtable_unpin(vox_chtable_t* table, const vox_chtable_guard_t* guard) {
+    (void)table;
+    if (!guard) return;
+    vox_ebr_exit(guard->thread);
+}
+
+static void free_retired(vox_chtable_t* table, chtable_retired_t* r) {
+    if (r->kind == CHTABLE_RETIRED_ENTRY) {
+        chtable_entry_t* e = (chtable_entry_t*)r;
+        if (r->free_value && table->value_free && e->value) {
+            table->value_free(e->value);
+        }
+    }
+    vox_mpool_free(table->pool, r);
+}
+
+static void ebr_free_retired(void* ptr, void* user_data) {
+    free_retired((vox_chtable_t*)user_data, (chtable_retired_t*)ptr);
+}
+
+static void retire(vox_chtable_t* table, chtable_retired_t* r) {
+    vox_ebr_thread_t* t = vox_ebr_thread(table->ebr);
+    if (!t || vox_ebr_retire(t, r, ebr_free_retired, table) != 0) {
+        /* 无法确认没有读者引用，只能泄漏（仅在内存耗尽时发生） */
+        VOX_LOG_ERROR("Failed to retire chtable object");
+    }
+}
+
+size_t vox_chtable_reclaim(vox_chtable_t* table) {
+    if (!table) return 0;
+    vox_ebr_thread_t* t = vox_ebr_thread(table->ebr);
+    if (!t) return 0;
+    size_t n = 0;
+    /* 连续推进三次即可清空所有纪元的待回收对象（前提是没有读者停留） */
+    for (int i = 0; i < 3; i++) {
+        n += vox_ebr_collect(t);
+    }
+    return n;
+}
+
+/* ===== 槽数组 ===== */
+
+static size_t next_power_of_two(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+static chtable_array_t* array_create(vox_chtable_t* table, size_t capacity) {
+    if (capacity > (SIZE_MAX - sizeof(chtable_array_t)) / sizeof(vox_atomic_ptr_t)) return NULL;
+    chtable_array_t* a = (chtable_array_t*)vox_mpool_alloc(table->pool,
+        sizeof(chtable_array_t) + capacity * sizeof(vox_atomic_ptr_t));
+    if (!a) return NULL;
+    memset(&a->retired, 0, sizeof(a->retired));
+    a->retired.kind = CHTABLE_RETIRED_ARRAY;
+    a->capacity = capacity;
+    a->growth_limit = capacity - capacity / 4;
+    vox_atomic_ptr_t* slots = ARRAY_SLOTS(a);
+    for (size_t i = 0; i < capacity; i++) {
+        vox_atomic_ptr_init(&slots[i], NULL);
+    }
+    return a;
+}
+
+static inline bool entry_matches(const chtable_entry_t* e, uint64_t hash, const void* key, size_t key_len) {
+    return e->hash == hash && e->key_len == key_len &&
+           (key_len == 0 || memcmp(ENTRY_KEY(e), key, key_len) == 0);
+}
+
+/* 无锁查找（调用方已 pin） */
+static chtable_entry_t* find_entry(chtable_array_t* a, uint64_t hash, const void* key, size_t key_len) {
+    vox_atomic_ptr_t* slots = ARRAY_SLOTS(a);
+    size_t mask = a->capacity - 1;
+    size_t idx = (size_t)hash & mask;
+    for (size_t n = 0; n < a->capacity; n++) {
+        void* p = vox_atomic_ptr_load(&slots[idx]);
+        if (!p) return NULL;
+        if (p != TOMBSTONE && entry_matches((const chtable_entry_t*)p, hash, key, key_len)) {
+            return (chtable_entry_t*)p;
+        }
+        idx = (idx + 1) & mask;
+    }
+    return NULL;
+}
+
+/* ===== 创建与销毁 ===== */
+
+vox_chtable_t* vox_chtable_create(vox_mpool_t* mpool) {
+    return vox_chtable_create_with_config(mpool, NULL);
+}
+
+vox_chtable_t* vox_chtable_create_with_config(vox_mpool_t* mpool, const vox_chtable_config_t* config) {
+    if (!mpool) return NULL;
+
+    vox_chtable_t* table = (vox_chtable_t*)vox_mpool_alloc(mpool, sizeof(vox_chtable_t));
+    if (!table) {
+        VOX_LOG_ERROR("Failed to allocate chtable");
+        return NULL;
+    }
+    memset(table, 0, sizeof(vox_chtable_t));
+    table->mpool = mpool;
+    table->hash_func = vox_htable_hash;
+    table->initial_capacity = VOX_CHTABLE_DEFAULT_CAPACITY;
+    if (config) {
+        if (config->hash_func) table->hash_func = config->hash_func;
+        table->value_free = config->value_free;
+        if (config->initial_capacity > 0) {
+            table->initial_capacity = next_power_of_two(config->initial_capacity);
+            if (table->initial_capacity < 8) table->initial_capacity = 8;
+        }
+    }
+
+    vox_mpool_config_t pool_config = {0};
+    pool_config.thread_safe = 1;
+    table->pool = vox_mpool_create_with_config(&pool_config);
+    if (!table->pool) {
+        VOX_LOG_ERROR("Failed to create chtable entry pool");
+        vox_mpool_free(mpool, table);
+        return NULL;
+    }
+
+    chtable_array_t* a = array_create(table, table->initial_capacity);
+    if (!a) {
+        VOX_LOG_ERROR("Failed to allocate chtable slots");
+        vox_mpool_destroy(table->pool);
+        vox_mpool_free(mpool, table);
+        return NULL;
+    }
+    vox_atomic_ptr_init(&table->array, a);
+    vox_atomic_long_init(&table->size.value, 0);
+    vox_atomic_long_init(&table->used.value, 0);
+
+    int i = 0;
+    for (; i < VOX_CHTABLE_WRITE_STRIPES; i++) {
+        if (vox_mutex_create(&table->stripes[i].lock) != 0) break;
+    }
+    if (i < VOX_CHTABLE_WRITE_STRIPES) {
+        VOX_LOG_ERROR("Failed to create chtable locks");
+        while (i-- > 0) vox_mutex_destroy(&table->stripes[i].lock);
+        vox_mpool_destroy(table->pool);
+        vox_mpool_free(mpool, table);
+        return NULL;
+    }
+
+    table->ebr = vox_ebr_create(mpool);
+    if (!table->ebr) {
+        VOX_LOG_ERROR("Failed to create chtable ebr");
+        for (i = 0; i < VOX_CHTABLE_WRITE_STRIPES; i++) vox_mutex_destroy(&table->stripes[i].lock);
+        vox_mpool_destroy(table->pool);
+        vox_mpool_free(mpool, table);
+        return NULL;
+    }
+    return table;
+}
+
+void vox_chtable_destroy(vox_chtable_t* table) {
+    if (!table) return;
+
+    chtable_array_t* a = (chtable_array_t*)vox_atomic_ptr_load(&table->array);
+    vox_atomic_ptr_t* slots = ARRAY_SLOTS(a);
+    for (size_t i = 0; i < a->capacity; i++) {
+        void* p = vox_atomic_ptr_load(&slots[i]);
+        if (p && p != TOMBSTONE) {
+            chtable_entry_t* e = (chtable_entry_t*)p;
+            e->retired.free_value = 1;
+            free_retired(table, &e->retired);
+        }
+    }
+    vox_mpool_free(table->pool, a);
+    /* 待回收对象的释放函数会用到内部内存池，须先于内存池销毁 */
+    vox_ebr_destroy(table->ebr);
+
+    for (int i = 0; i < VOX_CHTABLE_WRITE_STRIPES; i++) {
+        vox_mutex_destroy(&table->stripes[i].lock);
+    }
+    vox_mpool_destroy(table->pool);
+    vox_mpool_free(table->mpool, table);
+}
+
+/* ===== 写操作 ===== */
+
+static inline vox_mutex_t* stripe_lock(vox_chtable_t* table, uint64_t hash) {
+    return &table->stripes[(hash >> 40) & (VOX_CHTABLE_WRITE_STRIPES - 1)].lock;
+}
+
+static void lock_all(vox_chtable_t* table) {
+    for (int i = 0; i < VOX_CHTABLE_WRITE_STRIPES; i++) {
+        vox_mutex_lock(&table->stripes[i].lock);
+    }
+}
+
+static void unlock_all(vox_chtable_t* table) {
+    for (int i = VOX_CHTABLE_WRITE_STRIPES - 1; i >= 0; i--) {
+        vox_mutex_unlock(&table->stripes[i].lock);
+    }
+}
+
+/* 扩容或整理墓碑（调用方不能持有任何分段锁） */
+static int resize(vox_chtable_t* table, chtable_array_t* seen) {
+    chtable_array_t* old;
+    chtable_array_t* a;
+    size_t capacity;
+    for (;;) {
+        /* 在加锁前分配新数组，缩短全部分段被锁住的时间 */
+        size_t live = (size_t)vox_atomic_long_load(&table->size.value);
+        capacity = next_power_of_two(live * 2 + 1);
+        if (capacity < table->initial_capacity) capacity = table->initial_capacity;
+        a = array_create(table, capacity);
+        if (!a) {
+            VOX_LOG_ERROR("Failed to grow chtable to %zu slots", capacity);
+            return -1;
+        }
+
+        lock_all(table);
+        old = (chtable_array_t*)vox_atomic_ptr_load(&table->array);
+        if (old != seen) {
+            /* 其他线程已经完成扩容 */
+            unlock_all(table);
+            vox_mpool_free(table->pool, a);
+            return 0;
+        }
+        live = (size_t)vox_atomic_long_load(&table->size.value);
+        if (live < a->growth_limit) break;
+        /* 分配期间元素数继续增长，按新的数量重试 */
+        unlock_all(table);
+        vox_mpool_free(table->pool, a);
+    }
+
+    /* 新数组尚未发布，直接写入 */
+    vox_atomic_ptr_t* old_slots = ARRAY_SLOTS(old);
+    vox_atomic_ptr_t* slots = ARRAY_SLOTS(a);
+    size_t mask = capacity - 1;
+    size_t count = 0;
+    for (size_t i = 0; i < old->capacity; i++) {
+        void* p = vox_atomic_ptr_load(&old_slots[i]);
+        if (!p || p == TOMBSTONE) continue;
+        size_t idx = (size_t)((chtable_entry_t*)p)->hash & mask;
+        while (vox_atomic_ptr_load(&slots[idx])) {
+            idx = (idx + 1) & mask;
+        }
+        vox_atomic_ptr_store(&slots[idx], p);
+        count++;
+    }
+    vox_atomic_long_store(&table->used.value, (int64_t)count);
+    vox_atomic_ptr_store(&table->array, a);
+    unlock_all(table);
+
+    retire(table, &old->retired);
+    return 0;
+}
+
+int vox_chtable_set(vox_chtable_t* table, const void* key, size_t key_len, void* value) {
+    if (!table || (!key && key_len > 0)) return -1;
+    if (key_len > SIZE_MAX - sizeof(chtable_entry_t)) return -1;
+
+    uint64_t hash = table->hash_func(key, key_len);
+    chtable_entry_t* ne = (chtable_entry_t*)vox_mpool_alloc(table->pool, sizeof(chtable_entry_t) + key_len);
+    if (!ne) return -1;
+    memset(&ne->retired, 0, sizeof(ne->retired));
+    ne->retired.kind = CHTABLE_RETIRED_ENTRY;
+    ne->hash = hash;
+    ne->value = value;
+    ne->key_len = key_len;
+    if (key_len > 0) memcpy(ENTRY_KEY(ne), key, key_len);
+
+    /* 探测时会读取其他分段的条目，它们可能被并发删除，因此写者也要 pin */
+    vox_mutex_t* lock = stripe_lock(table, hash);
+    vox_chtable_guard_t guard;
+    for (;;) {
+        vox_chtable_pin(table, &guard);
+        vox_mutex_lock(lock);
+        chtable_array_t* a = (chtable_array_t*)vox_atomic_ptr_load(&table->array);
+        vox_atomic_ptr_t* slots = ARRAY_SLOTS(a);
+        size_t mask = a->capacity - 1;
+        size_t idx = (size_t)hash & mask;
+        vox_atomic_ptr_t* free_slot = NULL;
+        void* free_prev = NULL;
+        chtable_entry_t* old = NULL;
+
+        /* 同一键的条目只由本分段修改，探测到空槽即可确定不存在 */
+        for (size_t n = 0; n < a->capacity; n++) {
+            void* p = vox_atomic_ptr_load(&slots[idx]);
+            if (!p || p == TOMBSTONE) {
+                if (!free_slot) {
+                    free_slot = &slots[idx];
+                    free_prev = p;
+                }
+                if (!p) break;
+            } else if (entry_matches((chtable_entry_t*)p, hash, key, key_len)) {
+                old = (chtable_entry_t*)p;
+                vox_atomic_ptr_store(&slots[idx], ne);
+                break;
+            }
+            idx = (idx + 1) & mask;
+        }
+
+        if (old) {
+            vox_mutex_unlock(lock);
+            vox_chtable_unpin(table, &guard);
+            old->retired.free_value = (old->value != value);
+            retire(table, &old->retired);
+            return 0;
+        }
+
+        if (free_slot && free_prev == NULL &&
+            vox_atomic_long_increment(&table->used.value) > (int64_t)a->growth_limit) {
+            /* 需要新占用一个空槽但已达到负载上限：先扩容 */
+            vox_atomic_long_decrement(&table->used.value);
+            free_slot = NULL;
+        }
+        if (!free_slot) {
+            vox_mutex_unlock(lock);
+            vox_chtable_unpin(table, &guard);
+            if (resize(table, a) != 0) {
+                vox_mpool_free(table->pool, ne);
+                return -1;
+            }
+            continue;
+        }
+
+        /* 空槽和墓碑可能被其他分段同时争抢 */
+        void* expected = free_prev;
+        if (vox_atomic_ptr_compare_exchange(free_slot, &expected, ne)) {
+            vox_atomic_long_increment(&table->size.value);
+            vox_mutex_unlock(lock);
+            vox_chtable_unpin(table, &guard);
+            return 0;
+        }
+        if (free_prev == NULL) vox_atomic_long_decrement(&table->used.value);
+        vox_mutex_unlock(lock);
+        vox_chtable_unpin(table, &guard);
+    }
+}
+
+int vox_chtable_delete(vox_chtable_t* table, const void* key, size_t key_len) {
+    if (!table || (!key && key_len > 0)) return -1;
+
+    uint64_t hash = table->hash_func(key, key_len);
+    vox_mutex_t* lock = stripe_lock(table, hash);
+    vox_chtable_guard_t guard;
+    vox_chtable_pin(table, &guard);
+    vox_mutex_lock(lock);
+    chtable_array_t* a = (chtable_array_t*)vox_atomic_ptr_load(&table->array);
+    vox_atomic_ptr_t* slots = ARRAY_SLOTS(a);
+    size_t mask = a->capacity - 1;
+    size_t idx = (size_t)hash & mask;
+    chtable_entry_t* old = NULL;
+    for (size_t n = 0; n < a->capacity; n++) {
+        void* p = vox_atomic_ptr_load(&slots[idx]);
+        if (!p) break;
+        if (p != TOMBSTONE && entry_matches((chtable_entry_t*)p, hash, key, key_len)) {
+            old = (chtable_entry_t*)p;
+            vox_atomic_ptr_store(&slots[idx], TOMBSTONE);
+            vox_atomic_long_decrement(&table->size.value);
+            break;
+        }
+        idx = (idx + 1) & mask;
+    }
+    vox_mutex_unlock(lock);
+    vox_chtable_unpin(table, &guard);
+
+    if (!old) return -1;
+    old->retired.free_value = 1;
+    retire(table, &old->retired);
+    return 0;
+}
+
+void vox_chtable_clear(vox_chtable_t* table) {
+    if (!table) return;
+
+    chtable_array_t* a = array_create(table, table->initial_capacity);
+    if (!a) {
+        VOX_LOG_ERROR("Failed to allocate chtable slots");
+        return;
+    }
+    lock_all(table);
+    chtable_array_t* old = (chtable_array_t*)vox_atomic_ptr_load(&table->array);
+    vox_atomic_ptr_store(&table->array, a);
+    vox_atomic_long_store(&table->size.value, 0);
+    vox_atomic_long_store(&table->used.value, 0);
+    unlock_all(table);
+
+    vox_atomic_ptr_t* slots = ARRAY_SLOTS(old);
+    for (size_t i = 0; i < old->capacity; i++) {
+        void* p = vox_atomic_ptr_load(&slots[i]);
+        if (p && p != TOMBSTONE) {
+            chtable_entry_t* e = (chtable_entry_t*)p;
+            e->retired.free_value = 1;
+            retire(table, &e->retired);
+        }
+    }
+    retire(table, &old->retired);
+}
+
+/* ===== 读操作 ===== */
+
+void* vox_chtable_get(vox_chtable_t* table, const void* key, size_t key_len) {
+    if (!table || (!key && key_len > 0)) return NULL;
+
+    uint64_t hash = table->hash_func(key, key_len);
+    vox_chtable_guard_t guard;
+    vox_chtable_pin(table, &guard);
+    chtable_array_t* a = (chtable_array_t*)vox_atomic_ptr_load(&table->array);
+    chtable_entry_t* e = find_entry(a, hash, key, key_len);
+    void* value = e ? e->value : NULL;
+    vox_chtable_unpin(table, &guard);
+    return value;
+}
+
+bool vox_chtable_contains(vox_chtable_t* table, const void* key, size_t key_len) {
+    if (!table || (!key && key_len > 0)) return false;
+
+    uint64_t hash = table->hash_func(key, key_len);
+    vox_chtable_guard_t guard;
+    vox_chtable_pin(table, &guard);
+    chtable_array_t* a = (chtable_array_t*)vox_atomic_ptr_load(&table->array);
+    bool found = find_entry(a, hash, key, key_len) != NULL;
+    vox_chtable_unpin(table, &guard);
+    return found;
+}
+
+size_t vox_chtable_size(const vox_chtable_t* table) {
+    if (!table) return 0;
+    int64_t n = vox_atomic_long_load(&table->size.value);
+    return n > 0 ? (size_t)n : 0;
+}
+
+size_t vox_chtable_foreach(vox_chtable_t* table,
+                           void (*callback)(const void* key, size_t key_len, void* value, void* user_data),
+                           void* user_data) {
+    if (!table || !callback) return 0;
+
+    vox_chtable_guard_t guard;
+    vox_chtable_pin(table, &guard);
+    chtable_array_t* a = (chtable_array_t*)vox_atomic_ptr_load(&table->array);
+    vox_atomic_ptr_t* slots = ARRAY_SLOTS(a);
+    size_t count = 0;
+    for (size_t i = 0; i < a->capacity; i++) {
+        void* p = vox_atomic_ptr_load(&slots[i]);
+        if (!p || p == TOMBSTONE) continue;
+        chtable_entry_t* e = (chtable_entry_t*)p;
+        callback(ENTRY_KEY(e), e->key_len, e->value, user_data);
+        count++;
+    }
+    vox_chtable_unpin(table, &guard);
+    return count;
+}
+
+void vox_chtable_stats(const vox_chtable_t* table, size_t* capacity, size_t* size, size_t* pending) {
+    if (!table) return;
+    if (capacity) {
+        const chtable_array_t* a = (const chtable_array_t*)vox_atomic_ptr_load(&table->array);
+        *capacity = a->capacity;
+    }
+    if (size) *size = vox_chtable_size(table);
+    if (pending) vox_ebr_stats(table->ebr, NULL, pending, NULL);
+}
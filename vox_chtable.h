@@ -0,0 +1,156 @@
+/*
+ * vox_chtable.h - 并发哈希表（跨线程共享状态：会话表、连接注册表、路由缓存等）
+ * - 读操作无锁：只做原子加载和线性探测，不获取任何锁
+ * - 写操作按键哈希分段加锁，不同分段的写入互不阻塞
+ * - 条目不可变，更新/删除时整体替换，旧条目和旧槽数组通过 vox_ebr 延迟回收，
+ *   在所有可能持有它们的读者离开临界区后才释放
+ *
+ * 说明：
+ * - 键在插入时复制，比较使用 memcmp
+ * - 配置了 value_free 时，被替换或删除的值在回收时才释放；
+ *   若其他线程可能并发删除，应在 vox_chtable_pin/unpin 之间调用 get 并使用返回值
+ */
+
+#ifndef VOX_CHTABLE_H
+#define VOX_CHTABLE_H
+
+#include "vox_os.h"
+#include "vox_mpool.h"
+#include "vox_htable.h"
+#include "vox_ebr.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 并发哈希表不透明类型 */
+typedef struct vox_chtable vox_chtable_t;
+
+/* 并发哈希表配置 */
+typedef struct {
+    size_t initial_capacity;          /* 初始容量，0表示使用默认值 */
+    vox_hash_func_t hash_func;        /* 自定义哈希函数，NULL表示使用 vox_htable_hash */
+    vox_value_free_func_t value_free; /* 值释放函数，NULL表示不释放（延迟到回收时调用，可能在任意线程） */
+} vox_chtable_config_t;
+
+/* 读临界区句柄（由 vox_chtable_pin 填充） */
+typedef struct {
+    vox_ebr_thread_t* thread;
+} vox_chtable_guard_t;
+
+/**
+ * 使用默认配置创建并发哈希表
+ * @param mpool 内存池指针，仅用于分配表结构本身，必须非NULL
+ * @return 成功返回哈希表指针，失败返回NULL
+ */
+vox_chtable_t* vox_chtable_create(vox_mpool_t* mpool);
+
+/**
+ * 使用自定义配置创建并发哈希表（条目和槽数组从内部的线程安全内存池分配）
+ * @param mpool 内存池指针，必须非NULL
+ * @param config 配置结构体，NULL表示使用默认配置
+ * @return 成功返回哈希表指针，失败返回NULL
+ */
+vox_chtable_t* vox_chtable_create_with_config(vox_mpool_t* mpool, const vox_chtable_config_t* config);
+
+/**
+ * 销毁哈希表并立即释放所有条目（调用方须保证已无其他线程访问）
+ * @param table 哈希表指针
+ */
+void vox_chtable_destroy(vox_chtable_t* table);
+
+/**
+ * 插入或更新键值对（线程安全）
+ * @param table 哈希表指针
+ * @param key 键指针
+ * @param key_len 键长度（字节）
+ * @param value 值指针
+ * @return 成功返回0，失败返回-1
+ */
+int vox_chtable_set(vox_chtable_t* table, const void* key, size_t key_len, void* value);
+
+/**
+ * 查找键对应的值（无锁）
+ * @param table 哈希表指针
+ * @param key 键指针
+ * @param key_len 键长度（字节）
+ * @return 找到返回值指针，未找到返回NULL
+ */
+void* vox_chtable_get(vox_chtable_t* table, const void* key, size_t key_len);
+
+/**
+ * 删除键值对（线程安全）
+ * @param table 哈希表指针
+ * @param key 键指针
+ * @param key_len 键长度（字节）
+ * @return 成功返回0，键不存在返回-1
+ */
+int vox_chtable_delete(vox_chtable_t* table, const void* key, size_t key_len);
+
+/**
+ * 检查键是否存在（无锁）
+ */
+bool vox_chtable_contains(vox_chtable_t* table, const void* key, size_t key_len);
+
+/**
+ * 获取元素数量（并发修改时为近似值）
+ */
+size_t vox_chtable_size(const vox_chtable_t* table);
+
+/**
+ * 清空哈希表（线程安全，旧条目延迟回收）
+ * @param table 哈希表指针
+ */
+void vox_chtable_clear(vox_chtable_t* table);
+
+/**
+ * 遍历哈希表中的键值对（无锁快照遍历，不保证包含遍历期间的并发修改）
+ * 回调中可以调用 set/delete
+ * @param table 哈希表指针
+ * @param callback 回调函数，参数为(key, key_len, value, user_data)
+ * @param user_data 用户数据指针
+ * @return 返回遍历的元素数量
+ */
+size_t vox_chtable_foreach(vox_chtable_t* table,
+                           void (*callback)(const void* key, size_t key_len, void* value, void* user_data),
+                           void* user_data);
+
+/**
+ * 进入读临界区：在 unpin 之前，get/foreach 得到的值不会被回收
+ * 可以嵌套；临界区应尽量短，长时间持有会推迟所有回收
+ * @param table 哈希表指针
+ * @param guard 输出句柄，传给 vox_chtable_unpin
+ */
+void vox_chtable_pin(vox_chtable_t* table, vox_chtable_guard_t* guard);
+
+/**
+ * 离开读临界区
+ * @param table 哈希表指针
+ * @param guard vox_chtable_pin 填充的句柄
+ */
+void vox_chtable_unpin(vox_chtable_t* table, const vox_chtable_guard_t* guard);
+
+/**
+ * 尝试推进纪元并回收已无读者引用的条目（写操作会自动触发，通常无需手动调用）
+ * @param table 哈希表指针
+ * @return 返回本次回收的对象数量
+ */
+size_t vox_chtable_reclaim(vox_chtable_t* table);
+
+/**
+ * 获取统计信息（用于调试）
+ * @param table 哈希表指针
+ * @param capacity 输出槽数组容量
+ * @param size 输出元素数量
+ * @param pending 输出等待回收的对象数量
+ */
+void vox_chtable_stats(const vox_chtable_t* table, size_t* capacity, size_t* size, size_t* pending);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_CHTABLE_H */
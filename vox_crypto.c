@@ -1,10 +1,12 @@
 /*
  * vox_crypto.c - 加密和哈希算法实现
- * 提供 MD5, SHA1, SHA256, HMAC-MD5, HMAC-SHA1, HMAC-SHA256, Base64, CRC32 等常见算法
+ * 提供 MD5, SHA1, SHA256, HMAC-MD5, HMAC-SHA1, HMAC-SHA256, Base64, CRC32, CRC32C 等常见算法
  */
 
 #include "vox_os.h"
 #include "vox_crypto.h"
+#include "vox_atomic.h"
+#include "vox_thread.h"
 #include <string.h>
 #include <stdint.h>
 
@@ -40,6 +42,109 @@ static inline uint32_t right_rotate(uint32_t x, int n) {
     return (x >> n) | (x << (32 - n));
 }
 
+/* ===== CPU 特性检测与运行时分派 ===== */
+
+/* x86 的硬件实现用 target 属性单独编译，运行时按 cpuid 结果选择，不依赖 -march；
+ * ARM64 没有可移植的运行时检测方式，只在编译目标启用对应扩展时使用 */
+#if (defined(VOX_ARCH_X86_64) || defined(VOX_ARCH_X86)) && \
+    (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+    #define VOX_CRYPTO_X86 1
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #define VOX_CRYPTO_TARGET(s)
+    #else
+        #include <cpuid.h>
+        #define VOX_CRYPTO_TARGET(s) __attribute__((target(s)))
+    #endif
+    #include <immintrin.h>
+#elif defined(VOX_ARCH_ARM64) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO) || \
+                                  defined(__ARM_FEATURE_CRC32))
+    #include <arm_neon.h>
+    #if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+        #define VOX_CRYPTO_ARM_SHA 1
+    #endif
+    #if defined(__ARM_FEATURE_CRC32)
+        #include <arm_acle.h>
+        #define VOX_CRYPTO_ARM_CRC 1
+    #endif
+#endif
+
+/* 检测结果与屏蔽掩码可被任意线程读写，统一经 vox_atomic 访问 */
+#define VOX_CRYPTO_DETECT_DONE 0x40000000u   /* g_crypto_detected 中的已检测标记 */
+static vox_atomic_int_t g_crypto_detected;   /* 检测结果 | VOX_CRYPTO_DETECT_DONE，0 表示尚未检测 */
+static vox_atomic_int_t g_crypto_mask = { -1 };
+
+#if defined(VOX_CRYPTO_X86)
+static void crypto_cpuid(unsigned leaf, unsigned subleaf, unsigned r[4]) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuidex(regs, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; i++) r[i] = (unsigned)regs[i];
+#else
+    r[0] = r[1] = r[2] = r[3] = 0;
+    if (__get_cpuid_max(leaf & 0x80000000u, NULL) < leaf) return;
+    __cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+/* 操作系统是否保存 YMM 寄存器（XCR0 的 SSE 与 AVX 位） */
+static int crypto_os_avx(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return (_xgetbv(0) & 6) == 6;
+#else
+    unsigned lo, hi;
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    (void)hi;
+    return (lo & 6) == 6;
+#endif
+}
+#endif
+
+static uint32_t crypto_detect(void) {
+    uint32_t f = 0;
+#if defined(VOX_CRYPTO_X86)
+    unsigned r1[4], r7[4];
+    crypto_cpuid(1, 0, r1);
+    crypto_cpuid(7, 0, r7);
+    int ssse3 = (r1[2] >> 9) & 1;
+    int sse41 = (r1[2] >> 19) & 1;
+    int sse42 = (r1[2] >> 20) & 1;
+    int pclmul = (r1[2] >> 1) & 1;
+    int osxsave = (r1[2] >> 27) & 1;
+    int avx = (r1[2] >> 28) & 1;
+    int avx2 = (r7[1] >> 5) & 1;
+    int sha = (r7[1] >> 29) & 1;
+    if (sha && ssse3 && sse41) f |= VOX_CRYPTO_CPU_SHA;
+    if (pclmul && sse41) f |= VOX_CRYPTO_CPU_CRC32;
+    if (sse42) f |= VOX_CRYPTO_CPU_CRC32C;
+    if (avx && avx2 && osxsave && crypto_os_avx()) f |= VOX_CRYPTO_CPU_AVX2;
+#endif
+#if defined(VOX_CRYPTO_ARM_SHA)
+    f |= VOX_CRYPTO_CPU_SHA;
+#endif
+#if defined(VOX_CRYPTO_ARM_CRC)
+    f |= VOX_CRYPTO_CPU_CRC32 | VOX_CRYPTO_CPU_CRC32C;
+#endif
+    f |= VOX_CRYPTO_DETECT_DONE;
+    /* 并发首次调用可能各自检测一次，写入的结果相同 */
+    vox_atomic_int_store(&g_crypto_detected, (int32_t)f);
+    return f;
+}
+
+static inline uint32_t crypto_features(void) {
+    uint32_t f = (uint32_t)vox_atomic_int_load(&g_crypto_detected);
+    if (!f) f = crypto_detect();
+    return f & (uint32_t)vox_atomic_int_load(&g_crypto_mask) & ~VOX_CRYPTO_DETECT_DONE;
+}
+
+uint32_t vox_crypto_cpu_features(void) {
+    return crypto_features();
+}
+
+uint32_t vox_crypto_set_cpu_features(uint32_t mask) {
+    vox_atomic_int_store(&g_crypto_mask, (int32_t)mask);
+    return crypto_features();
+}
+
 /* ===== MD5 实现 ===== */
 
 /* MD5 常量 */
@@ -330,9 +435,116 @@ static void sha1_transform(uint32_t state[5], const uint8_t block[64]) {
     state[4] += e;
 }
 
+#if defined(VOX_CRYPTO_X86)
+/* SHA-NI 的一组 4 轮（g 为常量，展开后条件在编译期确定）
+ * w[g & 3] 为本组消息字，sha1msg1/异或/sha1msg2 分三组滚动生成第 g + 4 组；
+ * ecur 为本组的 E，enext 保存当前 ABCD 供下一组 sha1nexte 推导 E */
+#define SHA1_NI_GROUP(g, ecur, enext, f) do { \
+    if ((g) < 4) w[(g) & 3] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + ((g) & 3) * 16)), mask); \
+    ecur = ((g) == 0) ? _mm_add_epi32(ecur, w[0]) : _mm_sha1nexte_epu32(ecur, w[(g) & 3]); \
+    enext = abcd; \
+    if ((g) >= 3 && (g) <= 18) w[((g) + 1) & 3] = _mm_sha1msg2_epu32(w[((g) + 1) & 3], w[(g) & 3]); \
+    abcd = _mm_sha1rnds4_epu32(abcd, ecur, f); \
+    if ((g) >= 1 && (g) <= 16) w[((g) + 3) & 3] = _mm_sha1msg1_epu32(w[((g) + 3) & 3], w[(g) & 3]); \
+    if ((g) >= 2 && (g) <= 17) w[((g) + 2) & 3] = _mm_xor_si128(w[((g) + 2) & 3], w[(g) & 3]); \
+} while (0)
+
+VOX_CRYPTO_TARGET("sha,sse4.1,ssse3")
+static void sha1_blocks_shani(uint32_t state[5], const uint8_t* data, size_t nblocks) {
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0x1B);
+    __m128i e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+    __m128i e1;
+    __m128i w[4];
+
+    while (nblocks--) {
+        __m128i abcd_save = abcd;
+        __m128i e_save = e0;
+
+        SHA1_NI_GROUP(0, e0, e1, 0);  SHA1_NI_GROUP(1, e1, e0, 0);
+        SHA1_NI_GROUP(2, e0, e1, 0);  SHA1_NI_GROUP(3, e1, e0, 0);
+        SHA1_NI_GROUP(4, e0, e1, 0);  SHA1_NI_GROUP(5, e1, e0, 1);
+        SHA1_NI_GROUP(6, e0, e1, 1);  SHA1_NI_GROUP(7, e1, e0, 1);
+        SHA1_NI_GROUP(8, e0, e1, 1);  SHA1_NI_GROUP(9, e1, e0, 1);
+        SHA1_NI_GROUP(10, e0, e1, 2); SHA1_NI_GROUP(11, e1, e0, 2);
+        SHA1_NI_GROUP(12, e0, e1, 2); SHA1_NI_GROUP(13, e1, e0, 2);
+        SHA1_NI_GROUP(14, e0, e1, 2); SHA1_NI_GROUP(15, e1, e0, 3);
+        SHA1_NI_GROUP(16, e0, e1, 3); SHA1_NI_GROUP(17, e1, e0, 3);
+        SHA1_NI_GROUP(18, e0, e1, 3); SHA1_NI_GROUP(19, e1, e0, 3);
+
+        e0 = _mm_sha1nexte_epu32(e0, e_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+        data += 64;
+    }
+
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+#undef SHA1_NI_GROUP
+#endif
+
+#if defined(VOX_CRYPTO_ARM_SHA)
+/* ARMv8 SHA1 指令：每组 4 轮，sha1su0/sha1su1 生成第 g + 4 组的消息字 */
+static void sha1_blocks_arm(uint32_t state[5], const uint8_t* data, size_t nblocks) {
+    static const uint32_t k[4] = {0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6};
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32_t e = state[4];
+    uint32x4_t w[4];
+
+    while (nblocks--) {
+        uint32x4_t abcd_save = abcd;
+        uint32_t e_save = e;
+
+        for (int g = 0; g < 4; g++) {
+            w[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + g * 16)));
+        }
+        for (int g = 0; g < 20; g++) {
+            uint32x4_t wk = vaddq_u32(w[g & 3], vdupq_n_u32(k[g / 5]));
+            uint32_t e_next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (g < 5) abcd = vsha1cq_u32(abcd, e, wk);
+            else if (g >= 10 && g < 15) abcd = vsha1mq_u32(abcd, e, wk);
+            else abcd = vsha1pq_u32(abcd, e, wk);
+            e = e_next;
+            if (g < 16) {
+                w[g & 3] = vsha1su1q_u32(vsha1su0q_u32(w[g & 3], w[(g + 1) & 3], w[(g + 2) & 3]),
+                                         w[(g + 3) & 3]);
+            }
+        }
+
+        abcd = vaddq_u32(abcd, abcd_save);
+        e += e_save;
+        data += 64;
+    }
+
+    vst1q_u32(state, abcd);
+    state[4] = e;
+}
+#endif
+
+/* 处理 nblocks 个连续的64字节块，按 CPU 特性选择实现 */
+static void sha1_blocks(uint32_t state[5], const uint8_t* data, size_t nblocks) {
+#if defined(VOX_CRYPTO_X86)
+    if (crypto_features() & VOX_CRYPTO_CPU_SHA) {
+        sha1_blocks_shani(state, data, nblocks);
+        return;
+    }
+#elif defined(VOX_CRYPTO_ARM_SHA)
+    if (crypto_features() & VOX_CRYPTO_CPU_SHA) {
+        sha1_blocks_arm(state, data, nblocks);
+        return;
+    }
+#endif
+    while (nblocks--) {
+        sha1_transform(state, data);
+        data += 64;
+    }
+}
+
 void vox_sha1_update(vox_sha1_ctx_t* ctx, const void* data, size_t len) {
     const uint8_t* input = (const uint8_t*)data;
-    uint32_t i, index, partLen;
+    size_t i;
+    uint32_t index, partLen;
     
     index = (uint32_t)((ctx->count[0] >> 3) & 0x3F);
     
@@ -346,12 +558,12 @@ void vox_sha1_update(vox_sha1_ctx_t* ctx, const void* data, size_t len) {
     
     if (len >= partLen) {
         memcpy(&ctx->buffer[index], input, partLen);
-        sha1_transform(ctx->state, ctx->buffer);
+        sha1_blocks(ctx->state, ctx->buffer, 1);
         
-        /* 处理完整的64字节块 */
-        for (i = partLen; i + 63 < len; i += 64) {
-            sha1_transform(ctx->state, &input[i]);
-        }
+        /* 处理完整的64字节块（一次交给块函数，硬件实现可在寄存器中保持状态） */
+        size_t nblocks = (len - partLen) / 64;
+        sha1_blocks(ctx->state, &input[partLen], nblocks);
+        i = partLen + nblocks * 64;
         index = 0;
     } else {
         i = 0;
@@ -531,6 +743,110 @@ static void sha256_transform(uint32_t state[8], const uint8_t block[64]) {
     state[7] += h;
 }
 
+#if defined(VOX_CRYPTO_X86)
+/* SHA-NI 的一组 4 轮（g 为常量）：状态按 ABEF/CDGH 排列，sha256rnds2 每次 2 轮；
+ * w[g & 3] 为本组消息字，sha256msg1/sha256msg2 滚动生成后续组 */
+#define SHA256_NI_GROUP(g) do { \
+    if ((g) < 4) w[(g) & 3] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + ((g) & 3) * 16)), mask); \
+    msg = _mm_add_epi32(w[(g) & 3], _mm_loadu_si128((const __m128i*)&SHA256_K[(g) * 4])); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+    if ((g) >= 3 && (g) <= 14) { \
+        w[((g) + 1) & 3] = _mm_add_epi32(w[((g) + 1) & 3], _mm_alignr_epi8(w[(g) & 3], w[((g) + 3) & 3], 4)); \
+        w[((g) + 1) & 3] = _mm_sha256msg2_epu32(w[((g) + 1) & 3], w[(g) & 3]); \
+    } \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E)); \
+    if ((g) >= 1 && (g) <= 12) w[((g) + 3) & 3] = _mm_sha256msg1_epu32(w[((g) + 3) & 3], w[(g) & 3]); \
+} while (0)
+
+VOX_CRYPTO_TARGET("sha,sse4.1,ssse3")
+static void sha256_blocks_shani(uint32_t state[8], const uint8_t* data, size_t nblocks) {
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1);  /* CDAB */
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B); /* EFGH */
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);                                 /* ABEF */
+    __m128i msg;
+    __m128i w[4];
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                      /* CDGH */
+
+    while (nblocks--) {
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+
+        SHA256_NI_GROUP(0);  SHA256_NI_GROUP(1);  SHA256_NI_GROUP(2);  SHA256_NI_GROUP(3);
+        SHA256_NI_GROUP(4);  SHA256_NI_GROUP(5);  SHA256_NI_GROUP(6);  SHA256_NI_GROUP(7);
+        SHA256_NI_GROUP(8);  SHA256_NI_GROUP(9);  SHA256_NI_GROUP(10); SHA256_NI_GROUP(11);
+        SHA256_NI_GROUP(12); SHA256_NI_GROUP(13); SHA256_NI_GROUP(14); SHA256_NI_GROUP(15);
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        data += 64;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);                 /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);              /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);           /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);              /* HGFE */
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+
+#undef SHA256_NI_GROUP
+#endif
+
+#if defined(VOX_CRYPTO_ARM_SHA)
+/* ARMv8 SHA2 指令：每组 4 轮，sha256su0/sha256su1 生成第 g + 4 组的消息字 */
+static void sha256_blocks_arm(uint32_t state[8], const uint8_t* data, size_t nblocks) {
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+    uint32x4_t w[4];
+
+    while (nblocks--) {
+        uint32x4_t abcd_save = state0;
+        uint32x4_t efgh_save = state1;
+
+        for (int g = 0; g < 4; g++) {
+            w[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + g * 16)));
+        }
+        for (int g = 0; g < 16; g++) {
+            uint32x4_t wk = vaddq_u32(w[g & 3], vld1q_u32(&SHA256_K[g * 4]));
+            uint32x4_t abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, wk);
+            state1 = vsha256h2q_u32(state1, abcd, wk);
+            if (g < 12) {
+                w[g & 3] = vsha256su1q_u32(vsha256su0q_u32(w[g & 3], w[(g + 1) & 3]),
+                                           w[(g + 2) & 3], w[(g + 3) & 3]);
+            }
+        }
+
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+        data += 64;
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+#endif
+
+/* 处理 nblocks 个连续的64字节块，按 CPU 特性选择实现 */
+static void sha256_blocks(uint32_t state[8], const uint8_t* data, size_t nblocks) {
+#if defined(VOX_CRYPTO_X86)
+    if (crypto_features() & VOX_CRYPTO_CPU_SHA) {
+        sha256_blocks_shani(state, data, nblocks);
+        return;
+    }
+#elif defined(VOX_CRYPTO_ARM_SHA)
+    if (crypto_features() & VOX_CRYPTO_CPU_SHA) {
+        sha256_blocks_arm(state, data, nblocks);
+        return;
+    }
+#endif
+    while (nblocks--) {
+        sha256_transform(state, data);
+        data += 64;
+    }
+}
+
 void vox_sha256_update(vox_sha256_ctx_t* ctx, const void* data, size_t len) {
     const uint8_t* input = (const uint8_t*)data;
     size_t i, index, partLen;
@@ -544,12 +860,12 @@ void vox_sha256_update(vox_sha256_ctx_t* ctx, const void* data, size_t len) {
     
     if (len >= partLen) {
         memcpy(&ctx->buffer[index], input, partLen);
-        sha256_transform(ctx->state, ctx->buffer);
+        sha256_blocks(ctx->state, ctx->buffer, 1);
         
-        /* 处理完整的64字节块 */
-        for (i = partLen; i + 64 <= len; i += 64) {
-            sha256_transform(ctx->state, &input[i]);
-        }
+        /* 处理完整的64字节块（一次交给块函数，硬件实现可在寄存器中保持状态） */
+        size_t nblocks = (len - partLen) / 64;
+        sha256_blocks(ctx->state, &input[partLen], nblocks);
+        i = partLen + nblocks * 64;
         index = 0;
     } else {
         i = 0;
@@ -614,11 +930,220 @@ void vox_sha256_hex(const uint8_t digest[VOX_SHA256_DIGEST_SIZE], char hex_str[6
     hex_str[64] = '\0';
 }
 
+/* ===== SHA256 多缓冲区 ===== */
+
+static const uint32_t SHA256_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/* 一条消息的计算状态：完整块直接从原数据读取，剩余字节与填充放在 tail 中（1 或 2 块） */
+typedef struct {
+    const uint8_t* data;
+    size_t full_blocks;
+    size_t total_blocks;
+    size_t next_block;
+    uint32_t state[8];
+    uint8_t tail[128];
+} sha256_lane_t;
+
+/* prefix_len 为已压缩进 init 的前缀长度（HMAC 的密钥填充块），计入长度字段 */
+static void sha256_lane_init(sha256_lane_t* lane, const uint32_t init[8], uint64_t prefix_len,
+                             const void* data, size_t len) {
+    size_t rem = len % 64;
+    size_t tail_len = (rem < 56) ? 64 : 128;
+    uint64_t bit_count = (prefix_len + len) << 3;
+
+    lane->data = (const uint8_t*)data;
+    lane->full_blocks = len / 64;
+    lane->total_blocks = lane->full_blocks + tail_len / 64;
+    lane->next_block = 0;
+    memcpy(lane->state, init, sizeof(lane->state));
+
+    if (rem > 0) {
+        memcpy(lane->tail, lane->data + lane->full_blocks * 64, rem);
+    }
+    lane->tail[rem] = 0x80;
+    memset(&lane->tail[rem + 1], 0, tail_len - rem - 9);
+    for (int i = 0; i < 8; i++) {
+        lane->tail[tail_len - 8 + i] = (uint8_t)(bit_count >> (56 - i * 8));
+    }
+}
+
+static const uint8_t* sha256_lane_block(const sha256_lane_t* lane, size_t j) {
+    return (j < lane->full_blocks) ? lane->data + j * 64 : lane->tail + (j - lane->full_blocks) * 64;
+}
+
+/* 用单消息实现处理剩余的块 */
+static void sha256_lane_run(sha256_lane_t* lane) {
+    size_t j = lane->next_block;
+    if (j < lane->full_blocks) {
+        sha256_blocks(lane->state, lane->data + j * 64, lane->full_blocks - j);
+        j = lane->full_blocks;
+    }
+    sha256_blocks(lane->state, sha256_lane_block(lane, j), lane->total_blocks - j);
+    lane->next_block = lane->total_blocks;
+}
+
+static void sha256_lane_digest(const sha256_lane_t* lane, uint8_t digest[VOX_SHA256_DIGEST_SIZE]) {
+    for (int i = 0; i < 8; i++) {
+        digest[i * 4] = (uint8_t)(lane->state[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(lane->state[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(lane->state[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)lane->state[i];
+    }
+}
+
+#if defined(VOX_CRYPTO_X86)
+#define SHA256_X8_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define SHA256_X8_XOR3(a, b, c) _mm256_xor_si256(_mm256_xor_si256((a), (b)), (c))
+
+/* AVX2：8 条消息各压缩一个块，每个 32 位通道对应一条消息 */
+VOX_CRYPTO_TARGET("avx2")
+static void sha256_x8_avx2(uint32_t* const states[8], const uint8_t* const blocks[8]) {
+    uint32_t tmp[8];
+    __m256i s[8], w[16];
+
+    for (int j = 0; j < 8; j++) {
+        for (int k = 0; k < 8; k++) tmp[k] = states[k][j];
+        s[j] = _mm256_loadu_si256((const __m256i*)tmp);
+    }
+    for (int i = 0; i < 16; i++) {
+        for (int k = 0; k < 8; k++) {
+            uint32_t v;
+            memcpy(&v, blocks[k] + i * 4, 4);
+            tmp[k] = swap_uint32(v);
+        }
+        w[i] = _mm256_loadu_si256((const __m256i*)tmp);
+    }
+
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3];
+    __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int t = 0; t < 64; t++) {
+        if (t >= 16) {
+            __m256i w2 = w[(t - 2) & 15];
+            __m256i w15 = w[(t - 15) & 15];
+            __m256i sig0 = SHA256_X8_XOR3(SHA256_X8_ROTR(w15, 7), SHA256_X8_ROTR(w15, 18), _mm256_srli_epi32(w15, 3));
+            __m256i sig1 = SHA256_X8_XOR3(SHA256_X8_ROTR(w2, 17), SHA256_X8_ROTR(w2, 19), _mm256_srli_epi32(w2, 10));
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], sig0),
+                                         _mm256_add_epi32(w[(t - 7) & 15], sig1));
+        }
+        __m256i ep1 = SHA256_X8_XOR3(SHA256_X8_ROTR(e, 6), SHA256_X8_ROTR(e, 11), SHA256_X8_ROTR(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, ep1),
+                                      _mm256_add_epi32(_mm256_add_epi32(ch, w[t & 15]),
+                                                       _mm256_set1_epi32((int)SHA256_K[t])));
+        __m256i ep0 = SHA256_X8_XOR3(SHA256_X8_ROTR(a, 2), SHA256_X8_ROTR(a, 13), SHA256_X8_ROTR(a, 22));
+        __m256i maj = _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(ep0, maj));
+    }
+
+    s[0] = _mm256_add_epi32(s[0], a);
+    s[1] = _mm256_add_epi32(s[1], b);
+    s[2] = _mm256_add_epi32(s[2], c);
+    s[3] = _mm256_add_epi32(s[3], d);
+    s[4] = _mm256_add_epi32(s[4], e);
+    s[5] = _mm256_add_epi32(s[5], f);
+    s[6] = _mm256_add_epi32(s[6], g);
+    s[7] = _mm256_add_epi32(s[7], h);
+    for (int j = 0; j < 8; j++) {
+        _mm256_storeu_si256((__m256i*)tmp, s[j]);
+        for (int k = 0; k < 8; k++) states[k][j] = tmp[k];
+    }
+}
+
+#undef SHA256_X8_ROTR
+#undef SHA256_X8_XOR3
+
+/* 8 个通道轮流装入消息，某条消息算完立即换下一条，长度不同的消息不会让通道长时间空转 */
+static void sha256_multi_avx2(const uint32_t init[8], uint64_t prefix_len,
+                              const void* const data[], const size_t lens[], size_t count,
+                              uint8_t digests[][VOX_SHA256_DIGEST_SIZE]) {
+    static const uint8_t idle_block[64];
+    sha256_lane_t lanes[8];
+    size_t lane_msg[8];
+    int busy[8] = {0};
+    uint32_t idle_state[8][8];
+    uint32_t* states[8];
+    const uint8_t* blocks[8];
+    size_t next = 0;
+
+    memset(idle_state, 0, sizeof(idle_state));
+    for (;;) {
+        int active = 0;
+        for (int k = 0; k < 8; k++) {
+            if (!busy[k] && next < count) {
+                sha256_lane_init(&lanes[k], init, prefix_len, data[next], lens[next]);
+                lane_msg[k] = next++;
+                busy[k] = 1;
+            }
+            active += busy[k];
+        }
+        if (active == 0) break;
+        if (active == 1) {
+            /* 只剩最后一条消息，单独计算 */
+            for (int k = 0; k < 8; k++) {
+                if (busy[k]) {
+                    sha256_lane_run(&lanes[k]);
+                    sha256_lane_digest(&lanes[k], digests[lane_msg[k]]);
+                }
+            }
+            break;
+        }
+
+        for (int k = 0; k < 8; k++) {
+            states[k] = busy[k] ? lanes[k].state : idle_state[k];
+            blocks[k] = busy[k] ? sha256_lane_block(&lanes[k], lanes[k].next_block) : idle_block;
+        }
+        sha256_x8_avx2(states, blocks);
+        for (int k = 0; k < 8; k++) {
+            if (busy[k] && ++lanes[k].next_block == lanes[k].total_blocks) {
+                sha256_lane_digest(&lanes[k], digests[lane_msg[k]]);
+                busy[k] = 0;
+            }
+        }
+    }
+}
+#endif
+
+/* 从 init 状态开始批量计算；消息内容在装入通道时已读完尾部，digests 可以与短消息输入重叠 */
+static void sha256_multi_core(const uint32_t init[8], uint64_t prefix_len,
+                              const void* const data[], const size_t lens[], size_t count,
+                              uint8_t digests[][VOX_SHA256_DIGEST_SIZE]) {
+#if defined(VOX_CRYPTO_X86)
+    /* SHA-NI 的单消息速度高于 8 路 AVX2，只在没有 SHA-NI 时并行 */
+    if (count > 1 && (crypto_features() & (VOX_CRYPTO_CPU_SHA | VOX_CRYPTO_CPU_AVX2)) == VOX_CRYPTO_CPU_AVX2) {
+        sha256_multi_avx2(init, prefix_len, data, lens, count, digests);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; i++) {
+        sha256_lane_t lane;
+        sha256_lane_init(&lane, init, prefix_len, data[i], lens[i]);
+        sha256_lane_run(&lane);
+        sha256_lane_digest(&lane, digests[i]);
+    }
+}
+
+void vox_sha256_multi(const void* const data[], const size_t lens[], size_t count,
+                      uint8_t digests[][VOX_SHA256_DIGEST_SIZE]) {
+    if (!data || !lens || !digests) return;
+    sha256_multi_core(SHA256_IV, 0, data, lens, count, digests);
+}
+
 /* ===== HMAC-MD5 实现 ===== */
 
 void vox_hmac_md5(const void* key, size_t key_len,
                   const void* data, size_t data_len,
                   uint8_t digest[VOX_MD5_DIGEST_SIZE]) {
+    uint8_t key_hash[VOX_MD5_DIGEST_SIZE];
     uint8_t key_block[64];
     uint8_t o_key_pad[64];
     uint8_t i_key_pad[64];
@@ -626,8 +1151,8 @@ void vox_hmac_md5(const void* key, size_t key_len,
     
     /* 如果密钥长度超过64字节，先计算其MD5 */
     if (key_len > 64) {
-        vox_md5(key, key_len, key_block);
-        key = key_block;
+        vox_md5(key, key_len, key_hash);
+        key = key_hash;
         key_len = 16;
     }
     
@@ -662,6 +1187,7 @@ void vox_hmac_md5_hex(const uint8_t digest[VOX_MD5_DIGEST_SIZE], char hex_str[33
 void vox_hmac_sha1(const void* key, size_t key_len,
                    const void* data, size_t data_len,
                    uint8_t digest[VOX_SHA1_DIGEST_SIZE]) {
+    uint8_t key_hash[VOX_SHA1_DIGEST_SIZE];
     uint8_t key_block[64];
     uint8_t o_key_pad[64];
     uint8_t i_key_pad[64];
@@ -669,8 +1195,8 @@ void vox_hmac_sha1(const void* key, size_t key_len,
     
     /* 如果密钥长度超过64字节，先计算其SHA1 */
     if (key_len > 64) {
-        vox_sha1(key, key_len, key_block);
-        key = key_block;
+        vox_sha1(key, key_len, key_hash);
+        key = key_hash;
         key_len = 20;
     }
     
@@ -705,6 +1231,7 @@ void vox_hmac_sha1_hex(const uint8_t digest[VOX_SHA1_DIGEST_SIZE], char hex_str[
 void vox_hmac_sha256(const void* key, size_t key_len,
                      const void* data, size_t data_len,
                      uint8_t digest[VOX_SHA256_DIGEST_SIZE]) {
+    uint8_t key_hash[VOX_SHA256_DIGEST_SIZE];
     uint8_t key_block[64];
     uint8_t o_key_pad[64];
     uint8_t i_key_pad[64];
@@ -712,8 +1239,8 @@ void vox_hmac_sha256(const void* key, size_t key_len,
     
     /* 如果密钥长度超过64字节，先计算其SHA256 */
     if (key_len > 64) {
-        vox_sha256(key, key_len, key_block);
-        key = key_block;
+        vox_sha256(key, key_len, key_hash);
+        key = key_hash;
         key_len = 32;
     }
     
@@ -743,6 +1270,88 @@ void vox_hmac_sha256_hex(const uint8_t digest[VOX_SHA256_DIGEST_SIZE], char hex_
     vox_sha256_hex(digest, hex_str);
 }
 
+/* 压缩 i_key_pad/o_key_pad 得到内外两层哈希的起始状态 */
+static void hmac_sha256_key_states(const void* key, size_t key_len, uint32_t istate[8], uint32_t ostate[8]) {
+    uint8_t key_hash[VOX_SHA256_DIGEST_SIZE];
+    uint8_t key_block[64];
+    uint8_t pad[64];
+
+    if (key_len > 64) {
+        vox_sha256(key, key_len, key_hash);
+        key = key_hash;
+        key_len = VOX_SHA256_DIGEST_SIZE;
+    }
+    memset(key_block, 0, 64);
+    if (key_len > 0) {
+        memcpy(key_block, key, key_len);
+    }
+
+    for (int i = 0; i < 64; i++) pad[i] = key_block[i] ^ 0x36;
+    memcpy(istate, SHA256_IV, sizeof(SHA256_IV));
+    sha256_blocks(istate, pad, 1);
+
+    for (int i = 0; i < 64; i++) pad[i] = key_block[i] ^ 0x5c;
+    memcpy(ostate, SHA256_IV, sizeof(SHA256_IV));
+    sha256_blocks(ostate, pad, 1);
+}
+
+#define HMAC_MULTI_BATCH 64
+
+static void hmac_sha256_multi_states(const uint32_t istate[8], const uint32_t ostate[8],
+                                     const void* const data[], const size_t lens[], size_t count,
+                                     uint8_t digests[][VOX_SHA256_DIGEST_SIZE]) {
+    const void* inner[HMAC_MULTI_BATCH];
+    size_t inner_lens[HMAC_MULTI_BATCH];
+
+    sha256_multi_core(istate, 64, data, lens, count, digests);
+
+    /* 外层哈希的输入是内层摘要，原地覆盖为最终结果 */
+    for (size_t off = 0; off < count; off += HMAC_MULTI_BATCH) {
+        size_t n = count - off < HMAC_MULTI_BATCH ? count - off : HMAC_MULTI_BATCH;
+        for (size_t i = 0; i < n; i++) {
+            inner[i] = digests[off + i];
+            inner_lens[i] = VOX_SHA256_DIGEST_SIZE;
+        }
+        sha256_multi_core(ostate, 64, inner, inner_lens, n, digests + off);
+    }
+}
+
+void vox_hmac_sha256_multi(const void* key, size_t key_len,
+                           const void* const data[], const size_t lens[], size_t count,
+                           uint8_t digests[][VOX_SHA256_DIGEST_SIZE]) {
+    uint32_t istate[8], ostate[8];
+    if (!data || !lens || !digests) return;
+    hmac_sha256_key_states(key, key_len, istate, ostate);
+    hmac_sha256_multi_states(istate, ostate, data, lens, count, digests);
+}
+
+size_t vox_hmac_sha256_verify_multi(const void* key, size_t key_len,
+                                    const void* const data[], const size_t lens[],
+                                    const uint8_t* expected, size_t count, bool results[]) {
+    uint32_t istate[8], ostate[8];
+    uint8_t digests[HMAC_MULTI_BATCH][VOX_SHA256_DIGEST_SIZE];
+    size_t passed = 0;
+
+    if (!data || !lens || !expected) return 0;
+    hmac_sha256_key_states(key, key_len, istate, ostate);
+
+    for (size_t off = 0; off < count; off += HMAC_MULTI_BATCH) {
+        size_t n = count - off < HMAC_MULTI_BATCH ? count - off : HMAC_MULTI_BATCH;
+        hmac_sha256_multi_states(istate, ostate, data + off, lens + off, n, digests);
+        for (size_t i = 0; i < n; i++) {
+            uint8_t diff = 0;
+            for (int b = 0; b < VOX_SHA256_DIGEST_SIZE; b++) {
+                diff |= (uint8_t)(digests[i][b] ^ expected[(off + i) * VOX_SHA256_DIGEST_SIZE + b]);
+            }
+            if (results) results[off + i] = (diff == 0);
+            passed += (diff == 0);
+        }
+    }
+    return passed;
+}
+
+#undef HMAC_MULTI_BATCH
+
 /* ===== Base64 实现 ===== */
 
 static const char base64_chars[] = 
@@ -1046,73 +1655,245 @@ int vox_base64url_decode(const char* encoded, void* output, size_t output_size)
     return (int)j;
 }
 
-/* ===== CRC32 实现 ===== */
+/* ===== CRC32 / CRC32C 实现 ===== */
 
-static uint32_t crc32_table[256];
-static int crc32_table_computed = 0;
+/* slice-by-8 查表：table[k][b] 为字节 b 之后再经过 k 个零字节的余数，每次处理 8 字节 */
+static uint32_t crc32_table[8][256];
+static uint32_t crc32c_table[8][256];
 
-static void compute_crc32_table(void) {
-    if (crc32_table_computed) return;
-    
+/* 查表的初始化状态：只有 CAS 成功的线程写表，写完后以原子 store 发布，
+ * 读到 CRC_TABLE_READY 的线程可见完整的表 */
+enum {
+    CRC_TABLE_EMPTY = 0,
+    CRC_TABLE_COMPUTING,
+    CRC_TABLE_READY
+};
+static vox_atomic_int_t crc32_table_state;
+static vox_atomic_int_t crc32c_table_state;
+
+static void compute_crc_slice8_table(uint32_t table[8][256], uint32_t poly) {
     for (uint32_t i = 0; i < 256; i++) {
         uint32_t crc = i;
         for (int j = 0; j < 8; j++) {
             if (crc & 1) {
-                crc = (crc >> 1) ^ 0xEDB88320;
+                crc = (crc >> 1) ^ poly;
             } else {
                 crc >>= 1;
             }
         }
-        crc32_table[i] = crc;
+        table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int k = 1; k < 8; k++) {
+            table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+        }
     }
-    
-    crc32_table_computed = 1;
 }
 
-uint32_t vox_crc32_init(void) {
-    compute_crc32_table();
-    return 0xFFFFFFFF;
+static void compute_crc_table_once(vox_atomic_int_t* state, uint32_t table[8][256], uint32_t poly) {
+    if (vox_atomic_int_load(state) == CRC_TABLE_READY) return;
+    int32_t expected = CRC_TABLE_EMPTY;
+    if (vox_atomic_int_compare_exchange(state, &expected, CRC_TABLE_COMPUTING)) {
+        compute_crc_slice8_table(table, poly);
+        vox_atomic_int_store(state, CRC_TABLE_READY);
+        return;
+    }
+    /* 其他线程正在计算：等待发布（只需 8KB 查表，很快完成） */
+    while (vox_atomic_int_load(state) != CRC_TABLE_READY) {
+        vox_thread_yield();
+    }
 }
 
-uint32_t vox_crc32_update(uint32_t crc, const void* data, size_t len) {
-    compute_crc32_table();
-    
-    const uint8_t* bytes = (const uint8_t*)data;
-    
-    /* 对齐到4字节边界以提高性能 */
-    while (len > 0 && ((uintptr_t)bytes & 3) != 0) {
-        crc = (crc >> 8) ^ crc32_table[(crc ^ *bytes) & 0xFF];
+static void compute_crc32_table(void) {
+    compute_crc_table_once(&crc32_table_state, crc32_table, 0xEDB88320);
+}
+
+static void compute_crc32c_table(void) {
+    compute_crc_table_once(&crc32c_table_state, crc32c_table, 0x82F63B78);
+}
+
+static uint32_t crc_slice8(uint32_t table[8][256], uint32_t crc, const uint8_t* bytes, size_t len) {
+#if VOX_LITTLE_ENDIAN
+    while (len > 0 && ((uintptr_t)bytes & 7) != 0) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *bytes) & 0xFF];
         bytes++;
         len--;
     }
-    
-    /* 处理4字节对齐的数据块 */
-    const uint32_t* words = (const uint32_t*)bytes;
-    size_t word_count = len / 4;
-    for (size_t i = 0; i < word_count; i++) {
-        uint32_t word = words[i];
-        #if VOX_LITTLE_ENDIAN
-            /* 小端序直接处理 */
-        #else
-            word = swap_uint32(word);
-        #endif
-        crc ^= word;
-        crc = (crc >> 8) ^ crc32_table[crc & 0xFF];
-        crc = (crc >> 8) ^ crc32_table[crc & 0xFF];
-        crc = (crc >> 8) ^ crc32_table[crc & 0xFF];
-        crc = (crc >> 8) ^ crc32_table[crc & 0xFF];
+    while (len >= 8) {
+        uint32_t lo, hi;
+        memcpy(&lo, bytes, 4);
+        memcpy(&hi, bytes + 4, 4);
+        lo ^= crc;
+        crc = table[7][lo & 0xFF] ^ table[6][(lo >> 8) & 0xFF] ^
+              table[5][(lo >> 16) & 0xFF] ^ table[4][lo >> 24] ^
+              table[3][hi & 0xFF] ^ table[2][(hi >> 8) & 0xFF] ^
+              table[1][(hi >> 16) & 0xFF] ^ table[0][hi >> 24];
+        bytes += 8;
+        len -= 8;
     }
-    
-    /* 处理剩余字节 */
-    bytes = (const uint8_t*)(words + word_count);
-    len = len % 4;
-    for (size_t i = 0; i < len; i++) {
-        crc = (crc >> 8) ^ crc32_table[(crc ^ bytes[i]) & 0xFF];
+#endif
+    while (len > 0) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *bytes) & 0xFF];
+        bytes++;
+        len--;
     }
-    
     return crc;
 }
 
+#if defined(VOX_CRYPTO_X86)
+/* PCLMULQDQ 折叠（Intel "Fast CRC Computation Using PCLMULQDQ"）：
+ * 4 路并行每次折叠 64 字节，再合并为 128 位、降到 64 位，最后 Barrett 规约到 32 位
+ * 要求 len >= 64 且为 16 的倍数 */
+VOX_CRYPTO_TARGET("pclmul,sse4.1")
+static uint32_t crc32_clmul(uint32_t crc, const uint8_t* buf, size_t len) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+    const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124LL);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = _mm_loadu_si128((const __m128i*)(buf + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*)(buf + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*)(buf + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*)(buf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    buf += 64;
+    len -= 64;
+
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(buf + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(buf + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(buf + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(buf + 0x30)));
+        buf += 64;
+        len -= 64;
+    }
+
+    /* 4 路合并为 128 位 */
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    while (len >= 16) {
+        x2 = _mm_loadu_si128((const __m128i*)buf);
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        buf += 16;
+        len -= 16;
+    }
+
+    /* 128 位降到 64 位 */
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett 规约到 32 位 */
+    x0 = poly;
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+/* SSE4.2 crc32 指令（多项式即 Castagnoli），64 位目标每次 8 字节 */
+VOX_CRYPTO_TARGET("sse4.2")
+static uint32_t crc32c_sse42(uint32_t crc, const uint8_t* bytes, size_t len) {
+    while (len > 0 && ((uintptr_t)bytes & 7) != 0) {
+        crc = _mm_crc32_u8(crc, *bytes++);
+        len--;
+    }
+#if defined(VOX_ARCH_X86_64)
+    uint64_t crc64 = crc;
+    while (len >= 8) {
+        uint64_t v;
+        memcpy(&v, bytes, 8);
+        crc64 = _mm_crc32_u64(crc64, v);
+        bytes += 8;
+        len -= 8;
+    }
+    crc = (uint32_t)crc64;
+#endif
+    while (len >= 4) {
+        uint32_t v;
+        memcpy(&v, bytes, 4);
+        crc = _mm_crc32_u32(crc, v);
+        bytes += 4;
+        len -= 4;
+    }
+    while (len > 0) {
+        crc = _mm_crc32_u8(crc, *bytes++);
+        len--;
+    }
+    return crc;
+}
+#endif
+
+#if defined(VOX_CRYPTO_ARM_CRC)
+/* ARMv8 CRC32 指令：crc32x 为 IEEE 多项式，crc32cx 为 Castagnoli */
+static uint32_t crc32_arm(uint32_t crc, const uint8_t* bytes, size_t len, int castagnoli) {
+    while (len >= 8) {
+        uint64_t v;
+        memcpy(&v, bytes, 8);
+        crc = castagnoli ? __crc32cd(crc, v) : __crc32d(crc, v);
+        bytes += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        crc = castagnoli ? __crc32cb(crc, *bytes) : __crc32b(crc, *bytes);
+        bytes++;
+        len--;
+    }
+    return crc;
+}
+#endif
+
+uint32_t vox_crc32_init(void) {
+    return 0xFFFFFFFF;
+}
+
+uint32_t vox_crc32_update(uint32_t crc, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    if (len == 0) return crc;
+
+#if defined(VOX_CRYPTO_X86)
+    if (len >= 64 && (crypto_features() & VOX_CRYPTO_CPU_CRC32)) {
+        size_t chunk = len & ~(size_t)15;
+        crc = crc32_clmul(crc, bytes, chunk);
+        bytes += chunk;
+        len -= chunk;
+        if (len == 0) return crc;
+    }
+#elif defined(VOX_CRYPTO_ARM_CRC)
+    if (crypto_features() & VOX_CRYPTO_CPU_CRC32) {
+        return crc32_arm(crc, bytes, len, 0);
+    }
+#endif
+
+    compute_crc32_table();
+    return crc_slice8(crc32_table, crc, bytes, len);
+}
+
 uint32_t vox_crc32_final(uint32_t crc) {
     return crc ^ 0xFFFFFFFF;
 }
@@ -1123,6 +1904,38 @@ uint32_t vox_crc32(const void* data, size_t len) {
     return vox_crc32_final(crc);
 }
 
+uint32_t vox_crc32c_init(void) {
+    return 0xFFFFFFFF;
+}
+
+uint32_t vox_crc32c_update(uint32_t crc, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    if (len == 0) return crc;
+
+#if defined(VOX_CRYPTO_X86)
+    if (crypto_features() & VOX_CRYPTO_CPU_CRC32C) {
+        return crc32c_sse42(crc, bytes, len);
+    }
+#elif defined(VOX_CRYPTO_ARM_CRC)
+    if (crypto_features() & VOX_CRYPTO_CPU_CRC32C) {
+        return crc32_arm(crc, bytes, len, 1);
+    }
+#endif
+
+    compute_crc32c_table();
+    return crc_slice8(crc32c_table, crc, bytes, len);
+}
+
+uint32_t vox_crc32c_final(uint32_t crc) {
+    return crc ^ 0xFFFFFFFF;
+}
+
+uint32_t vox_crc32c(const void* data, size_t len) {
+    uint32_t crc = vox_crc32c_init();
+    crc = vox_crc32c_update(crc, data, len);
+    return vox_crc32c_final(crc);
+}
+
 /* ===== 安全随机数生成 ===== */
 
 #if defined(VOX_OS_WINDOWS)
@@ -1,6 +1,11 @@
 /*
  * vox_crypto.h - 加密和哈希算法
- * 提供 MD5, SHA1, SHA256, HMAC-MD5, HMAC-SHA1, HMAC-SHA256, Base64, CRC32 等常见算法
+ * 提供 MD5, SHA1, SHA256, HMAC-MD5, HMAC-SHA1, HMAC-SHA256, Base64, CRC32, CRC32C 等常见算法
+ *
+ * SHA1/SHA256/CRC32/CRC32C 在运行时检测 CPU 特性并选择硬件实现：
+ * - x86: SHA-NI、PCLMULQDQ 折叠 CRC32、SSE4.2 crc32 指令（CRC32C）、AVX2 多缓冲区 SHA256
+ * - ARM64: 编译目标启用 crypto/crc 扩展时（如 Apple Silicon、-march=native）使用 SHA1/SHA2/CRC32 指令
+ * 不支持时回退到可移植实现（CRC 为 slice-by-8 查表），结果完全一致
  */
 
 #ifndef VOX_CRYPTO_H
@@ -8,6 +13,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -199,6 +205,17 @@ void vox_hmac_sha1(const void* key, size_t key_len,
  */
 void vox_hmac_sha1_hex(const uint8_t digest[VOX_SHA1_DIGEST_SIZE], char hex_str[41]);
 
+/**
+ * 批量计算 SHA256（多缓冲区）
+ * 无 SHA-NI 但有 AVX2 时 8 条消息并行计算，否则逐条使用最快的单消息实现
+ * @param data 各消息数据
+ * @param lens 各消息长度（字节）
+ * @param count 消息数量
+ * @param digests 输出缓冲区（count 个32字节摘要）
+ */
+void vox_sha256_multi(const void* const data[], const size_t lens[], size_t count,
+                      uint8_t digests[][VOX_SHA256_DIGEST_SIZE]);
+
 /* ===== HMAC-SHA256 ===== */
 
 /**
@@ -220,6 +237,31 @@ void vox_hmac_sha256(const void* key, size_t key_len,
  */
 void vox_hmac_sha256_hex(const uint8_t digest[VOX_SHA256_DIGEST_SIZE], char hex_str[65]);
 
+/**
+ * 使用同一密钥批量计算 HMAC-SHA256
+ * 密钥填充块只压缩一次，内外两层哈希按 vox_sha256_multi 的方式批量计算
+ * @param key 密钥
+ * @param key_len 密钥长度（字节）
+ * @param data 各消息数据
+ * @param lens 各消息长度（字节）
+ * @param count 消息数量
+ * @param digests 输出缓冲区（count 个32字节摘要）
+ */
+void vox_hmac_sha256_multi(const void* key, size_t key_len,
+                           const void* const data[], const size_t lens[], size_t count,
+                           uint8_t digests[][VOX_SHA256_DIGEST_SIZE]);
+
+/**
+ * 使用同一密钥批量验证 HMAC-SHA256（如一批请求的令牌签名）
+ * 摘要比较与内容无关地耗时（常量时间）
+ * @param expected 各消息期望的摘要（count 个32字节摘要连续存放）
+ * @param results 输出：各消息是否验证通过（可以为 NULL）
+ * @return 验证通过的消息数量
+ */
+size_t vox_hmac_sha256_verify_multi(const void* key, size_t key_len,
+                                    const void* const data[], const size_t lens[],
+                                    const uint8_t* expected, size_t count, bool results[]);
+
 /* ===== Base64 ===== */
 
 /**
@@ -296,6 +338,59 @@ uint32_t vox_crc32_update(uint32_t crc, const void* data, size_t len);
  */
 uint32_t vox_crc32_final(uint32_t crc);
 
+/* ===== CRC32C (Castagnoli) ===== */
+
+/**
+ * 计算 CRC32C 校验值（iSCSI/SCTP/ext4 等使用的 Castagnoli 多项式）
+ * @param data 输入数据
+ * @param len 数据长度（字节）
+ * @return CRC32C 校验值
+ */
+uint32_t vox_crc32c(const void* data, size_t len);
+
+/**
+ * 初始化 CRC32C 计算（用于流式处理）
+ * @return 初始 CRC32C 值
+ */
+uint32_t vox_crc32c_init(void);
+
+/**
+ * 更新 CRC32C 计算
+ * @param crc 当前的 CRC32C 值
+ * @param data 输入数据
+ * @param len 数据长度（字节）
+ * @return 更新后的 CRC32C 值
+ */
+uint32_t vox_crc32c_update(uint32_t crc, const void* data, size_t len);
+
+/**
+ * 完成 CRC32C 计算（用于流式处理）
+ * @param crc 当前的 CRC32C 值
+ * @return 最终的 CRC32C 值
+ */
+uint32_t vox_crc32c_final(uint32_t crc);
+
+/* ===== 硬件加速 ===== */
+
+#define VOX_CRYPTO_CPU_SHA     0x01  /* SHA1/SHA256 指令（x86 SHA-NI，ARMv8 SHA1/SHA2） */
+#define VOX_CRYPTO_CPU_CRC32   0x02  /* CRC32 加速（x86 PCLMULQDQ 折叠，ARMv8 CRC32 指令） */
+#define VOX_CRYPTO_CPU_CRC32C  0x04  /* CRC32C 指令（x86 SSE4.2，ARMv8 CRC32） */
+#define VOX_CRYPTO_CPU_AVX2    0x08  /* AVX2 多缓冲区 SHA256（8 路并行） */
+
+/**
+ * 获取当前生效的硬件加速特性
+ * @return VOX_CRYPTO_CPU_* 的组合（CPU 支持、已编译且未被屏蔽的特性）
+ */
+uint32_t vox_crypto_cpu_features(void);
+
+/**
+ * 限制可使用的硬件加速特性（用于测试与基准对比，传 0 强制使用可移植实现）
+ * 不是线程安全的，应在其他线程使用本模块之前调用
+ * @param mask 允许的 VOX_CRYPTO_CPU_* 组合
+ * @return 限制后生效的特性
+ */
+uint32_t vox_crypto_set_cpu_features(uint32_t mask);
+
 /* ===== 安全随机数生成 ===== */
 
 /**
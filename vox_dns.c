@@ -1,6 +1,7 @@
 /*
  * vox_dns.c - 异步DNS解析实现
- * 使用线程池执行阻塞的DNS查询，在事件循环中执行回调
+ * 使用线程池执行阻塞的DNS查询，在事件循环中执行回调；
+ * getaddrinfo 结果经 loop 级缓存，缓存未命中时优先使用基于 vox_udp 的原生查询
  */
 
 #include "vox_dns.h"
@@ -11,6 +12,10 @@
 #include "vox_log.h"
 #include "vox_os.h"
 #include "vox_socket.h"
+#include "vox_udp.h"
+#include "vox_htable.h"
+#include "vox_crypto.h"
+#include "vox_time.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -61,6 +66,7 @@ typedef struct {
 /* 前向声明 */
 static void getaddrinfo_callback_wrapper(vox_loop_t* loop, void* user_data);
 static void getnameinfo_callback_wrapper(vox_loop_t* loop, void* user_data);
+static void req_detach(vox_dns_getaddrinfo_t* req);
 
 /* 获取线程池（从事件循环中获取） */
 static vox_tpool_t* get_thread_pool(vox_loop_t* loop) {
@@ -125,6 +131,9 @@ static void getaddrinfo_timeout_cb(vox_timer_t* timer, void* user_data) {
         vox_timer_stop(req->timeout_timer);
     }
     
+    /* 从缓存项的等待链表摘除 */
+    req_detach(req);
+    
     /* 标记为超时并取消请求 */
     req->handle.closing = true;
     req->pending = false;
@@ -331,6 +340,1220 @@ static void getnameinfo_callback_wrapper(vox_loop_t* loop, void* user_data) {
     }
 }
 
+/* ===== 解析缓存与原生 UDP 解析器 ===== */
+
+#define VOX_DNS_DEFAULT_POSITIVE_TTL_MS   60000
+#define VOX_DNS_DEFAULT_MIN_TTL_MS        1000
+#define VOX_DNS_DEFAULT_MAX_TTL_MS        3600000
+#define VOX_DNS_DEFAULT_NEGATIVE_TTL_MS   5000
+#define VOX_DNS_DEFAULT_PREFETCH_PERCENT  10
+#define VOX_DNS_DEFAULT_MAX_ENTRIES       1024
+#define VOX_DNS_DEFAULT_UDP_TIMEOUT_MS    1000
+#define VOX_DNS_DEFAULT_UDP_ATTEMPTS      2
+
+#define VOX_DNS_MAX_NAMESERVERS  3
+#define VOX_DNS_MAX_SEARCH       6
+#define VOX_DNS_MAX_NDOTS        15
+#define VOX_DNS_MAX_NAME_LEN     253
+#define VOX_DNS_MAX_ADDRS        16
+#define VOX_DNS_PACKET_SIZE      512
+#define VOX_DNS_RECV_BUF_SIZE    4096
+
+#define VOX_DNS_TYPE_A           1
+#define VOX_DNS_TYPE_CNAME       5
+#define VOX_DNS_TYPE_AAAA        28
+#define VOX_DNS_CLASS_IN         1
+#define VOX_DNS_RCODE_NXDOMAIN   3
+
+/* 缓存键中的地址族字节：VOX_AF_INET / VOX_AF_INET6 / 任意 */
+#define VOX_DNS_FAMILY_ANY       2
+
+typedef struct dns_resolver dns_resolver_t;
+
+/* 缓存项：一个 (主机名, 地址族) 的解析结果 */
+typedef struct {
+    vox_list_node_t lru_node;          /* LRU 链表节点（表头为最近使用） */
+    dns_resolver_t* resolver;
+    char* key;                         /* 主机名 + '\0' + 地址族字节 */
+    size_t key_len;
+    int family;                        /* VOX_AF_INET / VOX_AF_INET6 / VOX_DNS_FAMILY_ANY */
+    uint64_t gen;                      /* 解析代次，用于识别过期的回退结果 */
+
+    /* 缓存结果（端口为0） */
+    vox_socket_addr_t* addrs;
+    size_t count;
+    bool has_data;
+    uint64_t expire_at;                /* 过期时间（单调时钟，微秒） */
+    uint64_t ttl_us;
+
+    /* 进行中的解析 */
+    bool resolving;
+    vox_list_t waiters;                /* 等待该项的请求（vox_dns_getaddrinfo_t.cache_node） */
+
+    /* UDP 查询暂存（按候选名称逐个尝试，见 entry_candidate） */
+    uint32_t cand;
+    int outstanding;
+    bool udp_failed;
+    bool nxdomain;
+    vox_socket_addr_t addrs4[VOX_DNS_MAX_ADDRS];
+    size_t count4;
+    vox_socket_addr_t addrs6[VOX_DNS_MAX_ADDRS];
+    size_t count6;
+    uint32_t min_ttl;
+    bool have_ttl;
+} dns_cache_entry_t;
+
+/* 一次 UDP 查询（A 或 AAAA） */
+typedef struct {
+    vox_list_node_t node;
+    dns_resolver_t* resolver;
+    dns_cache_entry_t* entry;
+    uint16_t id;
+    uint16_t qtype;
+    uint8_t packet[VOX_DNS_PACKET_SIZE];
+    size_t len;
+    uint32_t ns_index;
+    uint32_t tries;
+    vox_socket_addr_t server;
+    vox_timer_t timer;
+} dns_query_t;
+
+struct dns_resolver {
+    vox_loop_t* loop;
+    vox_mpool_t* mpool;
+    vox_dns_cache_config_t config;     /* config.nameservers/search 解析后不再保留 */
+
+    vox_htable_t* entries;             /* key -> dns_cache_entry_t* */
+    vox_list_t lru;
+
+    vox_socket_addr_t nameservers[VOX_DNS_MAX_NAMESERVERS];
+    size_t ns_count;
+    char search[VOX_DNS_MAX_SEARCH][VOX_DNS_MAX_NAME_LEN + 1];
+    size_t search_count;
+    uint32_t ndots;
+    vox_udp_t* udp4;
+    vox_udp_t* udp6;
+    vox_list_t queries;                /* 进行中的查询 */
+    vox_list_t retired;                /* 已结束但报文仍在 UDP 发送队列中的查询 */
+    vox_htable_t* hosts;               /* /etc/hosts 中出现的名称 */
+
+    vox_dns_cache_stats_t stats;
+    uint64_t gen_seq;
+    uint32_t rng;
+    uint8_t recv_buf[VOX_DNS_RECV_BUF_SIZE];
+};
+
+/* 线程池回退工作项（只持有副本，完成后按 key + gen 找回缓存项） */
+typedef struct {
+    vox_loop_t* loop;
+    char* key;
+    size_t key_len;
+    int family;
+    uint64_t gen;
+    vox_socket_addr_t* addrs;
+    size_t count;
+} dns_fallback_work_t;
+
+/* 解析器挂在 loop 扩展数据上的 key */
+static const char dns_resolver_key = 0;
+
+static void resolver_destroy(vox_loop_t* loop, void* data);
+static void entry_resolve(dns_cache_entry_t* entry);
+static uint32_t entry_candidate_count(const dns_cache_entry_t* entry);
+static int entry_query_candidate(dns_cache_entry_t* entry);
+
+static uint32_t resolver_random(dns_resolver_t* r) {
+    /* xorshift32 */
+    uint32_t x = r->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    r->rng = x;
+    return x;
+}
+
+static uint64_t ms_to_us(uint32_t ms) {
+    return (uint64_t)ms * 1000;
+}
+
+static bool addr_equal(const vox_socket_addr_t* a, const vox_socket_addr_t* b) {
+    if (a->family != b->family) {
+        return false;
+    }
+    if (a->family == VOX_AF_INET) {
+        return a->u.ipv4.addr == b->u.ipv4.addr && a->u.ipv4.port == b->u.ipv4.port;
+    }
+    return memcmp(a->u.ipv6.addr, b->u.ipv6.addr, 16) == 0 && a->u.ipv6.port == b->u.ipv6.port;
+}
+
+static void config_apply_defaults(vox_dns_cache_config_t* c) {
+    if (c->positive_ttl_ms == 0) c->positive_ttl_ms = VOX_DNS_DEFAULT_POSITIVE_TTL_MS;
+    if (c->min_ttl_ms == 0) c->min_ttl_ms = VOX_DNS_DEFAULT_MIN_TTL_MS;
+    if (c->max_ttl_ms == 0) c->max_ttl_ms = VOX_DNS_DEFAULT_MAX_TTL_MS;
+    if (c->max_ttl_ms < c->min_ttl_ms) c->max_ttl_ms = c->min_ttl_ms;
+    if (c->negative_ttl_ms == 0) c->negative_ttl_ms = VOX_DNS_DEFAULT_NEGATIVE_TTL_MS;
+    if (c->prefetch_percent == 0) c->prefetch_percent = VOX_DNS_DEFAULT_PREFETCH_PERCENT;
+    if (c->max_entries == 0) c->max_entries = VOX_DNS_DEFAULT_MAX_ENTRIES;
+    if (c->udp_timeout_ms == 0) c->udp_timeout_ms = VOX_DNS_DEFAULT_UDP_TIMEOUT_MS;
+    if (c->udp_attempts == 0) c->udp_attempts = VOX_DNS_DEFAULT_UDP_ATTEMPTS;
+}
+
+/* 解析一个 nameserver："ip"、"ip:port"、"[v6]:port" 或不带端口的 IPv6 */
+static int parse_nameserver(const char* s, size_t len, vox_socket_addr_t* out) {
+    char host[64];
+    uint16_t port = 53;
+
+    while (len > 0 && (*s == ' ' || *s == '\t')) { s++; len--; }
+    while (len > 0 && (s[len - 1] == ' ' || s[len - 1] == '\t')) len--;
+    if (len == 0) {
+        return -1;
+    }
+
+    const char* port_str = NULL;
+    size_t host_len = len;
+    if (s[0] == '[') {
+        const char* end = memchr(s, ']', len);
+        if (!end) {
+            return -1;
+        }
+        s++;
+        host_len = (size_t)(end - s);
+        if ((size_t)(end + 1 - (s - 1)) < len && end[1] == ':') {
+            port_str = end + 2;
+        }
+    } else {
+        const char* colon = memchr(s, ':', len);
+        if (colon && !memchr(colon + 1, ':', len - (size_t)(colon + 1 - s))) {
+            host_len = (size_t)(colon - s);
+            port_str = colon + 1;
+        }
+    }
+    if (host_len == 0 || host_len >= sizeof(host)) {
+        return -1;
+    }
+    memcpy(host, s, host_len);
+    host[host_len] = '\0';
+
+    if (port_str) {
+        unsigned long p = strtoul(port_str, NULL, 10);
+        if (p == 0 || p > 65535) {
+            return -1;
+        }
+        port = (uint16_t)p;
+    }
+    return vox_socket_parse_address(host, port, out);
+}
+
+/* 追加空格/逗号分隔的 search 域（去掉末尾的点，转小写，超长的跳过） */
+static void resolver_add_search(dns_resolver_t* r, const char* list) {
+    const char* p = list;
+    while (*p && r->search_count < VOX_DNS_MAX_SEARCH) {
+        p += strspn(p, " \t\r\n,");
+        size_t len = strcspn(p, " \t\r\n,#;");
+        if (len == 0) break;
+        size_t n = (p[len - 1] == '.') ? len - 1 : len;
+        if (n > 0 && n < VOX_DNS_MAX_NAME_LEN) {
+            char* d = r->search[r->search_count++];
+            for (size_t i = 0; i < n; i++) {
+                char c = p[i];
+                d[i] = (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+            }
+            d[n] = '\0';
+        }
+        p += len;
+        if (*p == '#' || *p == ';') break;
+    }
+}
+
+/**
+ * 加载 nameserver、search 域与 ndots
+ * 显式指定 nameservers 时不读取 resolv.conf 的 search/options（二者属于系统 nameserver 的配置）
+ */
+static void resolver_load_nameservers(dns_resolver_t* r, const char* list, const char* search,
+                                      uint32_t ndots) {
+    r->ns_count = 0;
+    r->search_count = 0;
+    r->ndots = 1;
+    if (search) {
+        resolver_add_search(r, search);
+    }
+    if (list) {
+        const char* p = list;
+        while (*p && r->ns_count < VOX_DNS_MAX_NAMESERVERS) {
+            const char* comma = strchr(p, ',');
+            size_t len = comma ? (size_t)(comma - p) : strlen(p);
+            if (parse_nameserver(p, len, &r->nameservers[r->ns_count]) == 0) {
+                r->ns_count++;
+            }
+            if (!comma) break;
+            p = comma + 1;
+        }
+        if (ndots > 0) r->ndots = ndots > VOX_DNS_MAX_NDOTS ? VOX_DNS_MAX_NDOTS : ndots;
+        return;
+    }
+
+#ifndef VOX_OS_WINDOWS
+    FILE* fp = fopen("/etc/resolv.conf", "r");
+    if (!fp) {
+        return;
+    }
+    char line[1024];
+    while (fgets(line, sizeof(line), fp)) {
+        if ((strncmp(line, "search", 6) == 0 && (line[6] == ' ' || line[6] == '\t')) ||
+            (strncmp(line, "domain", 6) == 0 && (line[6] == ' ' || line[6] == '\t'))) {
+            /* search 与 domain 互相覆盖，以最后出现的为准 */
+            if (!search) {
+                r->search_count = 0;
+                resolver_add_search(r, line + 7);
+            }
+            continue;
+        }
+        if (strncmp(line, "options", 7) == 0 && (line[7] == ' ' || line[7] == '\t')) {
+            const char* opt = strstr(line + 8, "ndots:");
+            if (opt) {
+                unsigned long n = strtoul(opt + 6, NULL, 10);
+                r->ndots = n > VOX_DNS_MAX_NDOTS ? VOX_DNS_MAX_NDOTS : (uint32_t)n;
+            }
+            continue;
+        }
+        if (strncmp(line, "nameserver", 10) != 0 || (line[10] != ' ' && line[10] != '\t') ||
+            r->ns_count >= VOX_DNS_MAX_NAMESERVERS) {
+            continue;
+        }
+        char* v = line + 11;
+        size_t len = strcspn(v, " \t\r\n#;%");
+        if (parse_nameserver(v, len, &r->nameservers[r->ns_count]) == 0) {
+            r->ns_count++;
+        }
+    }
+    fclose(fp);
+#endif
+    if (ndots > 0) r->ndots = ndots > VOX_DNS_MAX_NDOTS ? VOX_DNS_MAX_NDOTS : ndots;
+}
+
+/* 记录 /etc/hosts 中的名称，这些名称交给系统 getaddrinfo 解析 */
+static void resolver_load_hosts(dns_resolver_t* r) {
+#ifdef VOX_OS_WINDOWS
+    const char* path = "C:\\Windows\\System32\\drivers\\etc\\hosts";
+#else
+    const char* path = "/etc/hosts";
+#endif
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        return;
+    }
+    char line[512];
+    while (fgets(line, sizeof(line), fp)) {
+        char* hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char* tok = strtok(line, " \t\r\n");
+        if (!tok) continue;  /* 第一个字段是地址 */
+        while ((tok = strtok(NULL, " \t\r\n")) != NULL) {
+            size_t len = strlen(tok);
+            for (size_t i = 0; i < len; i++) {
+                if (tok[i] >= 'A' && tok[i] <= 'Z') tok[i] = (char)(tok[i] - 'A' + 'a');
+            }
+            if (len > 0 && tok[len - 1] == '.') len--;
+            if (len > 0) {
+                vox_htable_set(r->hosts, tok, len, (void*)r);
+            }
+        }
+    }
+    fclose(fp);
+}
+
+static dns_resolver_t* resolver_create(vox_loop_t* loop, const vox_dns_cache_config_t* config) {
+    vox_mpool_t* mpool = vox_loop_get_mpool(loop);
+    dns_resolver_t* r = (dns_resolver_t*)vox_mpool_alloc(mpool, sizeof(dns_resolver_t));
+    if (!r) {
+        return NULL;
+    }
+    memset(r, 0, sizeof(*r));
+    r->loop = loop;
+    r->mpool = mpool;
+    if (config) {
+        r->config = *config;
+    }
+    config_apply_defaults(&r->config);
+    vox_list_init(&r->lru);
+    vox_list_init(&r->queries);
+    vox_list_init(&r->retired);
+
+    r->entries = vox_htable_create(mpool);
+    r->hosts = vox_htable_create(mpool);
+    if (!r->entries || !r->hosts) {
+        if (r->entries) vox_htable_destroy(r->entries);
+        if (r->hosts) vox_htable_destroy(r->hosts);
+        vox_mpool_free(mpool, r);
+        return NULL;
+    }
+
+    resolver_load_nameservers(r, r->config.nameservers, r->config.search, r->config.ndots);
+    r->config.nameservers = NULL;
+    r->config.search = NULL;
+    resolver_load_hosts(r);
+
+    if (vox_crypto_random_bytes(&r->rng, sizeof(r->rng)) != 0 || r->rng == 0) {
+        r->rng = (uint32_t)vox_time_monotonic() | 1u;
+    }
+    r->gen_seq = ((uint64_t)resolver_random(r) << 32);
+
+    /* 挂到 loop 上，loop 销毁时（backend 销毁前）释放 UDP 句柄与定时器 */
+    if (vox_loop_set_ext(loop, &dns_resolver_key, r, resolver_destroy) != 0) {
+        resolver_destroy(loop, r);
+        return NULL;
+    }
+    return r;
+}
+
+/* 获取 loop 的解析器，首次使用时按默认配置创建 */
+static dns_resolver_t* resolver_get(vox_loop_t* loop) {
+    dns_resolver_t* r = (dns_resolver_t*)vox_loop_get_ext(loop, &dns_resolver_key);
+    if (!r) {
+        r = resolver_create(loop, NULL);
+    }
+    return r;
+}
+
+/* ----- 请求交付 ----- */
+
+static uint16_t req_port(const vox_dns_getaddrinfo_t* req) {
+    return req->service ? (uint16_t)strtoul(req->service, NULL, 10) : 0;
+}
+
+static void req_detach(vox_dns_getaddrinfo_t* req) {
+    dns_cache_entry_t* entry = (dns_cache_entry_t*)req->cache_entry;
+    if (entry) {
+        vox_list_remove(&entry->waiters, &req->cache_node);
+        req->cache_entry = NULL;
+    }
+}
+
+/* 以缓存结果完成请求：复制地址并填入请求端口，回调在下一轮事件循环中执行 */
+static void req_deliver(vox_dns_getaddrinfo_t* req, const vox_socket_addr_t* addrs, size_t count) {
+    vox_loop_t* loop = req->handle.loop;
+    vox_mpool_t* mpool = vox_loop_get_mpool(loop);
+
+    req_detach(req);
+    if (req->timeout_timer && vox_timer_is_active(req->timeout_timer)) {
+        vox_timer_stop(req->timeout_timer);
+    }
+
+    req->addrinfo.addrs = NULL;
+    req->addrinfo.count = 0;
+    if (count > 0) {
+        req->addrinfo.addrs = (vox_socket_addr_t*)vox_mpool_alloc(mpool, sizeof(vox_socket_addr_t) * count);
+        if (req->addrinfo.addrs) {
+            uint16_t port = req_port(req);
+            memcpy(req->addrinfo.addrs, addrs, sizeof(vox_socket_addr_t) * count);
+            for (size_t i = 0; i < count; i++) {
+                vox_socket_set_port(&req->addrinfo.addrs[i], port);
+            }
+            req->addrinfo.count = count;
+        }
+    }
+    req->pending = false;
+    vox_loop_queue_work(loop, (vox_loop_cb)getaddrinfo_callback_wrapper, req);
+}
+
+/* ----- 缓存项 ----- */
+
+static void entry_free(dns_cache_entry_t* entry) {
+    dns_resolver_t* r = entry->resolver;
+    vox_htable_delete(r->entries, entry->key, entry->key_len);
+    vox_list_remove(&r->lru, &entry->lru_node);
+    if (entry->addrs) {
+        vox_mpool_free(r->mpool, entry->addrs);
+    }
+    vox_mpool_free(r->mpool, entry->key);
+    vox_mpool_free(r->mpool, entry);
+}
+
+static void entry_touch(dns_cache_entry_t* entry) {
+    dns_resolver_t* r = entry->resolver;
+    vox_list_remove(&r->lru, &entry->lru_node);
+    vox_list_push_front(&r->lru, &entry->lru_node);
+}
+
+static void resolver_evict(dns_resolver_t* r) {
+    vox_list_node_t* node = vox_list_last(&r->lru);
+    while (vox_htable_size(r->entries) >= r->config.max_entries && node && node != &r->lru.head) {
+        vox_list_node_t* prev = node->prev;
+        dns_cache_entry_t* e = vox_container_of(node, dns_cache_entry_t, lru_node);
+        if (!e->resolving && vox_list_empty(&e->waiters)) {
+            entry_free(e);
+        }
+        node = prev;
+    }
+}
+
+static dns_cache_entry_t* entry_create(dns_resolver_t* r, const char* key, size_t key_len, int family) {
+    resolver_evict(r);
+
+    dns_cache_entry_t* entry = (dns_cache_entry_t*)vox_mpool_alloc(r->mpool, sizeof(dns_cache_entry_t));
+    if (!entry) {
+        return NULL;
+    }
+    memset(entry, 0, sizeof(*entry));
+    entry->key = (char*)vox_mpool_alloc(r->mpool, key_len);
+    if (!entry->key) {
+        vox_mpool_free(r->mpool, entry);
+        return NULL;
+    }
+    memcpy(entry->key, key, key_len);
+    entry->key_len = key_len;
+    entry->resolver = r;
+    entry->family = family;
+    vox_list_init(&entry->waiters);
+    if (vox_htable_set(r->entries, entry->key, key_len, entry) != 0) {
+        vox_mpool_free(r->mpool, entry->key);
+        vox_mpool_free(r->mpool, entry);
+        return NULL;
+    }
+    vox_list_push_front(&r->lru, &entry->lru_node);
+    return entry;
+}
+
+/* 解析结束：更新缓存并交付给所有等待者 */
+static void entry_complete(dns_cache_entry_t* entry, const vox_socket_addr_t* addrs, size_t count,
+                           uint64_t ttl_us) {
+    dns_resolver_t* r = entry->resolver;
+    uint64_t now = vox_time_monotonic();
+
+    entry->resolving = false;
+
+    /* 预取失败时保留尚未过期的正结果 */
+    bool keep_old = (count == 0 && entry->has_data && entry->count > 0 && entry->expire_at > now);
+    if (!keep_old) {
+        vox_socket_addr_t* copy = NULL;
+        if (count > 0) {
+            copy = (vox_socket_addr_t*)vox_mpool_alloc(r->mpool, sizeof(vox_socket_addr_t) * count);
+            if (copy) {
+                memcpy(copy, addrs, sizeof(vox_socket_addr_t) * count);
+            } else {
+                count = 0;
+            }
+        }
+        if (entry->addrs) {
+            vox_mpool_free(r->mpool, entry->addrs);
+        }
+        entry->addrs = copy;
+        entry->count = count;
+        entry->has_data = true;
+        entry->ttl_us = ttl_us;
+        entry->expire_at = now + ttl_us;
+    }
+
+    while (!vox_list_empty(&entry->waiters)) {
+        vox_dns_getaddrinfo_t* req = vox_container_of(vox_list_first(&entry->waiters),
+                                                      vox_dns_getaddrinfo_t, cache_node);
+        req_deliver(req, entry->addrs, entry->count);
+    }
+}
+
+/* ----- 线程池 getaddrinfo 回退 ----- */
+
+static void fallback_work_free(vox_mpool_t* mpool, dns_fallback_work_t* work) {
+    if (work->addrs) {
+        vox_mpool_free(mpool, work->addrs);
+    }
+    vox_mpool_free(mpool, work->key);
+    vox_mpool_free(mpool, work);
+}
+
+static void fallback_task(void* user_data) {
+    dns_fallback_work_t* work = (dns_fallback_work_t*)user_data;
+    struct addrinfo hints;
+    struct addrinfo* res = NULL;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = (work->family == VOX_AF_INET) ? AF_INET :
+                      (work->family == VOX_AF_INET6) ? AF_INET6 : AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_ADDRCONFIG;
+
+    int rc = getaddrinfo(work->key, NULL, &hints, &res);
+    if (rc != 0) {
+        hints.ai_flags = 0;
+        rc = getaddrinfo(work->key, NULL, &hints, &res);
+    }
+    if (rc != 0 || !res) {
+        return;
+    }
+
+    size_t count = 0;
+    for (struct addrinfo* ai = res; ai; ai = ai->ai_next) {
+        if (ai->ai_family == AF_INET || ai->ai_family == AF_INET6) count++;
+    }
+    if (count > 0) {
+        vox_mpool_t* mpool = vox_loop_get_mpool(work->loop);
+        work->addrs = (vox_socket_addr_t*)vox_mpool_alloc(mpool, sizeof(vox_socket_addr_t) * count);
+        if (work->addrs) {
+            for (struct addrinfo* ai = res; ai; ai = ai->ai_next) {
+                if (ai->ai_family == AF_INET || ai->ai_family == AF_INET6) {
+                    convert_from_sockaddr(ai->ai_addr, &work->addrs[work->count]);
+                    vox_socket_set_port(&work->addrs[work->count], 0);
+                    work->count++;
+                }
+            }
+        }
+    }
+    freeaddrinfo(res);
+}
+
+static void fallback_done(vox_loop_t* loop, void* user_data) {
+    dns_fallback_work_t* work = (dns_fallback_work_t*)user_data;
+    dns_resolver_t* r = (dns_resolver_t*)vox_loop_get_ext(loop, &dns_resolver_key);
+    if (r) {
+        dns_cache_entry_t* entry = (dns_cache_entry_t*)vox_htable_get(r->entries, work->key, work->key_len);
+        if (entry && entry->resolving && entry->gen == work->gen) {
+            uint64_t ttl = ms_to_us(work->count > 0 ? r->config.positive_ttl_ms : r->config.negative_ttl_ms);
+            entry_complete(entry, work->addrs, work->count, ttl);
+        }
+    }
+    fallback_work_free(vox_loop_get_mpool(loop), work);
+}
+
+static void fallback_complete(void* user_data, int result) {
+    VOX_UNUSED(result);
+    dns_fallback_work_t* work = (dns_fallback_work_t*)user_data;
+    vox_loop_queue_work(work->loop, fallback_done, work);
+}
+
+static void fallback_start(dns_cache_entry_t* entry) {
+    dns_resolver_t* r = entry->resolver;
+    vox_tpool_t* tpool = get_thread_pool(r->loop);
+    dns_fallback_work_t* work = (dns_fallback_work_t*)vox_mpool_alloc(r->mpool, sizeof(dns_fallback_work_t));
+    if (work) {
+        memset(work, 0, sizeof(*work));
+        work->key = (char*)vox_mpool_alloc(r->mpool, entry->key_len);
+        if (!work->key) {
+            vox_mpool_free(r->mpool, work);
+            work = NULL;
+        }
+    }
+    if (!work) {
+        entry_complete(entry, NULL, 0, ms_to_us(r->config.negative_ttl_ms));
+        return;
+    }
+    memcpy(work->key, entry->key, entry->key_len);
+    work->key_len = entry->key_len;
+    work->loop = r->loop;
+    work->family = entry->family;
+    work->gen = entry->gen;
+
+    r->stats.fallbacks++;
+    if (!tpool || vox_tpool_submit(tpool, fallback_task, work, fallback_complete) != 0) {
+        fallback_work_free(r->mpool, work);
+        entry_complete(entry, NULL, 0, ms_to_us(r->config.negative_ttl_ms));
+    }
+}
+
+/* ----- DNS 报文 ----- */
+
+/* 构造查询报文，返回长度，失败返回0 */
+static size_t dns_build_query(uint8_t* buf, size_t size, uint16_t id, const char* name, uint16_t qtype) {
+    size_t name_len = strlen(name);
+    if (name_len == 0 || name_len > VOX_DNS_MAX_NAME_LEN || 12 + name_len + 2 + 4 > size) {
+        return 0;
+    }
+    memset(buf, 0, 12);
+    buf[0] = (uint8_t)(id >> 8);
+    buf[1] = (uint8_t)id;
+    buf[2] = 0x01;  /* RD */
+    buf[5] = 1;     /* QDCOUNT */
+
+    size_t pos = 12;
+    const char* label = name;
+    while (*label) {
+        const char* dot = strchr(label, '.');
+        size_t len = dot ? (size_t)(dot - label) : strlen(label);
+        if (len == 0 || len > 63) {
+            return 0;
+        }
+        buf[pos++] = (uint8_t)len;
+        memcpy(buf + pos, label, len);
+        pos += len;
+        if (!dot) break;
+        label = dot + 1;
+    }
+    buf[pos++] = 0;
+    buf[pos++] = (uint8_t)(qtype >> 8);
+    buf[pos++] = (uint8_t)qtype;
+    buf[pos++] = 0;
+    buf[pos++] = VOX_DNS_CLASS_IN;
+    return pos;
+}
+
+/* 跳过（可能压缩的）域名，返回之后的偏移，失败返回0 */
+static size_t dns_skip_name(const uint8_t* buf, size_t len, size_t pos) {
+    for (int guard = 0; guard < 128 && pos < len; guard++) {
+        uint8_t c = buf[pos];
+        if ((c & 0xC0) == 0xC0) {
+            return (pos + 2 <= len) ? pos + 2 : 0;
+        }
+        if (c & 0xC0) {
+            return 0;
+        }
+        if (c == 0) {
+            return pos + 1;
+        }
+        pos += (size_t)c + 1;
+    }
+    return 0;
+}
+
+static uint16_t rd16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t rd32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+typedef enum {
+    DNS_QUERY_OK = 0,      /* 有应答（可能为空：NODATA） */
+    DNS_QUERY_NXDOMAIN,
+    DNS_QUERY_FAIL         /* 超时、截断、服务器错误：需要回退 */
+} dns_query_result_t;
+
+/* 解析应答，地址追加到缓存项暂存区；返回 -1 表示报文与查询不匹配 */
+static int dns_parse_response(dns_query_t* q, const uint8_t* buf, size_t len, dns_query_result_t* result) {
+    dns_cache_entry_t* entry = q->entry;
+    if (len < 12 || rd16(buf) != q->id || !(buf[2] & 0x80)) {
+        return -1;
+    }
+    /* 问题段必须与查询一致（名称大小写不敏感） */
+    size_t qlen = q->len - 12;
+    if (rd16(buf + 4) != 1 || len < 12 + qlen) {
+        return -1;
+    }
+    for (size_t i = 0; i < qlen; i++) {
+        uint8_t a = buf[12 + i], b = q->packet[12 + i];
+        if (a >= 'A' && a <= 'Z') a = (uint8_t)(a - 'A' + 'a');
+        if (b >= 'A' && b <= 'Z') b = (uint8_t)(b - 'A' + 'a');
+        if (a != b) {
+            return -1;
+        }
+    }
+
+    uint8_t rcode = buf[3] & 0x0F;
+    if (buf[2] & 0x02) {
+        *result = DNS_QUERY_FAIL;  /* TC：截断，交给系统解析器（TCP） */
+        return 0;
+    }
+    if (rcode == VOX_DNS_RCODE_NXDOMAIN) {
+        *result = DNS_QUERY_NXDOMAIN;
+        return 0;
+    }
+    if (rcode != 0) {
+        *result = DNS_QUERY_FAIL;
+        return 0;
+    }
+
+    uint16_t ancount = rd16(buf + 6);
+    size_t pos = 12 + qlen;
+    for (uint16_t i = 0; i < ancount; i++) {
+        pos = dns_skip_name(buf, len, pos);
+        if (pos == 0 || pos + 10 > len) {
+            break;
+        }
+        uint16_t type = rd16(buf + pos);
+        uint16_t cls = rd16(buf + pos + 2);
+        uint32_t ttl = rd32(buf + pos + 4);
+        uint16_t rdlen = rd16(buf + pos + 8);
+        pos += 10;
+        if (pos + rdlen > len) {
+            break;
+        }
+        if (cls == VOX_DNS_CLASS_IN && (type == q->qtype || type == VOX_DNS_TYPE_CNAME)) {
+            if (!entry->have_ttl || ttl < entry->min_ttl) {
+                entry->min_ttl = ttl;
+                entry->have_ttl = true;
+            }
+        }
+        if (cls == VOX_DNS_CLASS_IN && type == VOX_DNS_TYPE_A && q->qtype == VOX_DNS_TYPE_A &&
+            rdlen == 4 && entry->count4 < VOX_DNS_MAX_ADDRS) {
+            vox_socket_addr_t* a = &entry->addrs4[entry->count4++];
+            memset(a, 0, sizeof(*a));
+            a->family = VOX_AF_INET;
+            memcpy(&a->u.ipv4.addr, buf + pos, 4);
+        } else if (cls == VOX_DNS_CLASS_IN && type == VOX_DNS_TYPE_AAAA && q->qtype == VOX_DNS_TYPE_AAAA &&
+                   rdlen == 16 && entry->count6 < VOX_DNS_MAX_ADDRS) {
+            vox_socket_addr_t* a = &entry->addrs6[entry->count6++];
+            memset(a, 0, sizeof(*a));
+            a->family = VOX_AF_INET6;
+            memcpy(a->u.ipv6.addr, buf + pos, 16);
+        }
+        pos += rdlen;
+    }
+    *result = DNS_QUERY_OK;
+    return 0;
+}
+
+/* ----- UDP 查询 ----- */
+
+static void resolver_purge_retired(dns_resolver_t* r) {
+    if ((r->udp4 && r->udp4->send_queue) || (r->udp6 && r->udp6->send_queue)) {
+        return;
+    }
+    while (!vox_list_empty(&r->retired)) {
+        vox_list_node_t* node = vox_list_pop_front(&r->retired);
+        vox_mpool_free(r->mpool, vox_container_of(node, dns_query_t, node));
+    }
+}
+
+static void query_free(dns_query_t* q) {
+    dns_resolver_t* r = q->resolver;
+    vox_timer_destroy(&q->timer);
+    vox_list_remove(&r->queries, &q->node);
+    /* vox_udp_send 在 EAGAIN 时只保存报文指针，排队期间不能释放 */
+    vox_list_push_back(&r->retired, &q->node);
+    resolver_purge_retired(r);
+}
+
+static void query_finish(dns_query_t* q, dns_query_result_t result) {
+    dns_cache_entry_t* entry = q->entry;
+    dns_resolver_t* r = q->resolver;
+    query_free(q);
+
+    if (result == DNS_QUERY_NXDOMAIN) {
+        entry->nxdomain = true;
+    } else if (result == DNS_QUERY_FAIL) {
+        entry->udp_failed = true;
+    }
+    if (--entry->outstanding > 0) {
+        return;
+    }
+
+    size_t count = entry->count4 + entry->count6;
+    if (count > 0) {
+        vox_socket_addr_t addrs[VOX_DNS_MAX_ADDRS * 2];
+        memcpy(addrs, entry->addrs4, sizeof(vox_socket_addr_t) * entry->count4);
+        memcpy(addrs + entry->count4, entry->addrs6, sizeof(vox_socket_addr_t) * entry->count6);
+        uint64_t ttl = entry->have_ttl ? (uint64_t)entry->min_ttl * 1000 : r->config.positive_ttl_ms;
+        if (ttl < r->config.min_ttl_ms) ttl = r->config.min_ttl_ms;
+        if (ttl > r->config.max_ttl_ms) ttl = r->config.max_ttl_ms;
+        entry_complete(entry, addrs, count, ttl * 1000);
+    } else if (entry->udp_failed && !entry->nxdomain) {
+        fallback_start(entry);
+    } else if (entry->cand + 1 < entry_candidate_count(entry)) {
+        /* NXDOMAIN 或无记录：换下一个 search 候选，与系统解析器一致 */
+        entry->cand++;
+        if (entry_query_candidate(entry) != 0) {
+            fallback_start(entry);
+        }
+    } else {
+        entry_complete(entry, NULL, 0, ms_to_us(r->config.negative_ttl_ms));
+    }
+}
+
+static void udp_alloc_cb(vox_udp_t* udp, size_t suggested_size, void* buf, size_t* len, void* user_data) {
+    VOX_UNUSED(udp);
+    VOX_UNUSED(suggested_size);
+    dns_resolver_t* r = (dns_resolver_t*)user_data;
+    *(void**)buf = r->recv_buf;
+    *len = sizeof(r->recv_buf);
+}
+
+static void udp_recv_cb(vox_udp_t* udp, ssize_t nread, const void* buf,
+                        const vox_socket_addr_t* addr, unsigned int flags, void* user_data) {
+    VOX_UNUSED(udp);
+    VOX_UNUSED(flags);
+    dns_resolver_t* r = (dns_resolver_t*)user_data;
+    if (nread < 12 || !buf || !addr) {
+        return;
+    }
+    uint16_t id = rd16((const uint8_t*)buf);
+    vox_list_node_t* node;
+    vox_list_for_each(node, &r->queries) {
+        dns_query_t* q = vox_container_of(node, dns_query_t, node);
+        if (q->id != id || !addr_equal(&q->server, addr)) {
+            continue;
+        }
+        dns_query_result_t result;
+        if (dns_parse_response(q, (const uint8_t*)buf, (size_t)nread, &result) == 0) {
+            query_finish(q, result);
+        }
+        return;
+    }
+}
+
+static vox_udp_t* resolver_socket(dns_resolver_t* r, vox_address_family_t family) {
+    vox_udp_t** slot = (family == VOX_AF_INET6) ? &r->udp6 : &r->udp4;
+    if (*slot) {
+        return *slot;
+    }
+    vox_udp_t* udp = vox_udp_create(r->loop);
+    if (!udp) {
+        return NULL;
+    }
+    vox_socket_addr_t local;
+    vox_socket_parse_address(family == VOX_AF_INET6 ? "::" : "0.0.0.0", 0, &local);
+    vox_handle_set_data((vox_handle_t*)udp, r);
+    if (vox_udp_bind(udp, &local, 0) != 0 || vox_udp_recv_start(udp, udp_alloc_cb, udp_recv_cb) != 0) {
+        vox_udp_destroy(udp);
+        return NULL;
+    }
+    /* 套接字常驻，不计入 loop 活跃句柄；进行中的查询由其定时器保持 loop 运行 */
+    vox_handle_deactivate((vox_handle_t*)udp);
+    *slot = udp;
+    return udp;
+}
+
+static void query_timeout_cb(vox_timer_t* timer, void* user_data);
+
+static void query_send(dns_query_t* q) {
+    dns_resolver_t* r = q->resolver;
+    q->server = r->nameservers[q->ns_index % r->ns_count];
+    vox_udp_t* udp = resolver_socket(r, q->server.family);
+
+    r->stats.udp_queries++;
+    if (!udp || vox_udp_send(udp, q->packet, q->len, &q->server, NULL) != 0) {
+        VOX_LOG_DEBUG("DNS UDP 查询发送失败，等待超时重试");
+    }
+    vox_timer_start(&q->timer, r->config.udp_timeout_ms, 0, query_timeout_cb, q);
+}
+
+static void query_timeout_cb(vox_timer_t* timer, void* user_data) {
+    VOX_UNUSED(timer);
+    dns_query_t* q = (dns_query_t*)user_data;
+    dns_resolver_t* r = q->resolver;
+
+    if (++q->tries >= r->config.udp_attempts * (uint32_t)r->ns_count) {
+        query_finish(q, DNS_QUERY_FAIL);
+        return;
+    }
+    /* 轮换 nameserver 并更换事务 ID */
+    q->ns_index++;
+    q->id = (uint16_t)resolver_random(r);
+    q->packet[0] = (uint8_t)(q->id >> 8);
+    q->packet[1] = (uint8_t)q->id;
+    query_send(q);
+}
+
+static int query_start(dns_cache_entry_t* entry, const char* name, uint16_t qtype) {
+    dns_resolver_t* r = entry->resolver;
+    dns_query_t* q = (dns_query_t*)vox_mpool_alloc(r->mpool, sizeof(dns_query_t));
+    if (!q) {
+        return -1;
+    }
+    memset(q, 0, sizeof(*q));
+    q->resolver = r;
+    q->entry = entry;
+    q->qtype = qtype;
+    q->id = (uint16_t)resolver_random(r);
+    q->ns_index = resolver_random(r) % (uint32_t)r->ns_count;
+    q->len = dns_build_query(q->packet, sizeof(q->packet), q->id, name, qtype);
+    if (q->len == 0 || vox_timer_init(&q->timer, r->loop) != 0) {
+        vox_mpool_free(r->mpool, q);
+        return -1;
+    }
+    vox_list_push_back(&r->queries, &q->node);
+    entry->outstanding++;
+    query_send(q);
+    return 0;
+}
+
+static bool entry_use_udp(dns_cache_entry_t* entry) {
+    dns_resolver_t* r = entry->resolver;
+    size_t name_len = entry->key_len - 2;
+    if (r->config.disable_udp_resolver || r->ns_count == 0) {
+        return false;
+    }
+    /* 没有 search 域时单标签名称交给系统解析，hosts 中的名称以系统配置为准 */
+    if (r->search_count == 0 && !memchr(entry->key, '.', name_len)) {
+        return false;
+    }
+    return !vox_htable_contains(r->hosts, entry->key, name_len);
+}
+
+/* 候选名称个数：原名 + 各 search 域 */
+static uint32_t entry_candidate_count(const dns_cache_entry_t* entry) {
+    return 1 + (uint32_t)entry->resolver->search_count;
+}
+
+/**
+ * 按 resolv.conf 规则生成第 idx 个候选名称：
+ * 点数不少于 ndots 时先查原名再依次追加 search 域，否则先追加 search 域、最后查原名
+ * @return 0 成功，-1 名称过长（跳过该候选）
+ */
+static int entry_candidate(const dns_cache_entry_t* entry, uint32_t idx, char* out) {
+    dns_resolver_t* r = entry->resolver;
+    size_t name_len = entry->key_len - 2;
+    uint32_t dots = 0;
+    for (size_t i = 0; i < name_len; i++) {
+        if (entry->key[i] == '.') dots++;
+    }
+    bool bare_first = dots >= r->ndots;
+    bool bare = bare_first ? (idx == 0) : (idx == r->search_count);
+    if (bare) {
+        memcpy(out, entry->key, name_len + 1);
+        return 0;
+    }
+    const char* domain = r->search[bare_first ? idx - 1 : idx];
+    size_t dlen = strlen(domain);
+    if (name_len + 1 + dlen > VOX_DNS_MAX_NAME_LEN) {
+        return -1;
+    }
+    memcpy(out, entry->key, name_len);
+    out[name_len] = '.';
+    memcpy(out + name_len + 1, domain, dlen + 1);
+    return 0;
+}
+
+/* 从 entry->cand 开始对可用的候选名称发出 A/AAAA 查询；全部无法发出返回 -1 */
+static int entry_query_candidate(dns_cache_entry_t* entry) {
+    char name[VOX_DNS_MAX_NAME_LEN + 1];
+    uint32_t total = entry_candidate_count(entry);
+
+    entry->udp_failed = false;
+    entry->nxdomain = false;
+    entry->count4 = 0;
+    entry->count6 = 0;
+    entry->have_ttl = false;
+    while (entry->cand < total && entry_candidate(entry, entry->cand, name) != 0) {
+        entry->cand++;
+    }
+    if (entry->cand >= total) {
+        return -1;
+    }
+
+    /* outstanding 先加一，防止第一个查询同步失败时提前结束 */
+    entry->outstanding = 1;
+    if (entry->family != VOX_AF_INET6 && query_start(entry, name, VOX_DNS_TYPE_A) != 0) {
+        entry->udp_failed = true;
+    }
+    if (entry->family != VOX_AF_INET && query_start(entry, name, VOX_DNS_TYPE_AAAA) != 0) {
+        entry->udp_failed = true;
+    }
+    return --entry->outstanding > 0 ? 0 : -1;
+}
+
+static void entry_resolve(dns_cache_entry_t* entry) {
+    dns_resolver_t* r = entry->resolver;
+
+    entry->resolving = true;
+    entry->gen = ++r->gen_seq;
+    entry->outstanding = 0;
+    entry->cand = 0;
+
+    if (entry_use_udp(entry) && entry_query_candidate(entry) == 0) {
+        return;
+    }
+    fallback_start(entry);
+}
+
+/* ----- 与 getaddrinfo 请求的衔接 ----- */
+
+/* 规范化主机名：小写、去掉末尾的点 */
+static size_t dns_normalize_name(const char* node, char* out, size_t size) {
+    size_t len = strlen(node);
+    if (len > 0 && node[len - 1] == '.') len--;
+    if (len == 0 || len > VOX_DNS_MAX_NAME_LEN || len + 2 > size) {
+        return 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+        char c = node[i];
+        out[i] = (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
+    return len;
+}
+
+/**
+ * 经过缓存处理请求
+ * @return 0 已接管（命中或挂入等待），1 不适用缓存（走原有线程池路径），-1 失败
+ */
+static int dns_cache_resolve(vox_dns_getaddrinfo_t* req) {
+    vox_loop_t* loop = req->handle.loop;
+    dns_resolver_t* r = resolver_get(loop);
+    if (!r || r->config.disable_cache || !req->node || !req->node[0]) {
+        return 1;
+    }
+
+    /* 仅缓存数字端口（服务名解析依赖系统 services 数据库） */
+    if (req->service) {
+        const char* p = req->service;
+        if (!*p) return 1;
+        for (; *p; p++) {
+            if (*p < '0' || *p > '9') return 1;
+        }
+        if (strtoul(req->service, NULL, 10) > 65535) return 1;
+    }
+
+    int family = (req->family == VOX_AF_INET || req->family == VOX_AF_INET6) ? (int)req->family
+                                                                               : VOX_DNS_FAMILY_ANY;
+
+    /* 数字地址直接返回 */
+    vox_socket_addr_t numeric;
+    if (vox_socket_parse_address(req->node, 0, &numeric) == 0) {
+        bool match = (family == VOX_DNS_FAMILY_ANY) || ((int)numeric.family == family);
+        req_deliver(req, &numeric, match ? 1 : 0);
+        return 0;
+    }
+
+    char key[VOX_DNS_MAX_NAME_LEN + 2];
+    size_t name_len = dns_normalize_name(req->node, key, sizeof(key));
+    if (name_len == 0) {
+        return 1;
+    }
+    key[name_len] = '\0';
+    key[name_len + 1] = (char)family;
+    size_t key_len = name_len + 2;
+
+    uint64_t now = vox_time_monotonic();
+    dns_cache_entry_t* entry = (dns_cache_entry_t*)vox_htable_get(r->entries, key, key_len);
+    if (entry && entry->has_data && entry->expire_at > now) {
+        r->stats.hits++;
+        entry_touch(entry);
+        req_deliver(req, entry->addrs, entry->count);
+        /* 剩余 TTL 不足时后台刷新，本次仍返回旧结果 */
+        if (!entry->resolving && entry->count > 0 && r->config.prefetch_percent <= 100 &&
+            (entry->expire_at - now) * 100 < entry->ttl_us * r->config.prefetch_percent) {
+            r->stats.prefetches++;
+            entry_resolve(entry);
+        }
+        return 0;
+    }
+
+    r->stats.misses++;
+    if (!entry) {
+        entry = entry_create(r, key, key_len, family);
+        if (!entry) {
+            return -1;
+        }
+    } else {
+        entry_touch(entry);
+    }
+
+    req->cache_entry = entry;
+    vox_list_push_back(&entry->waiters, &req->cache_node);
+
+    if (req->timeout_ms > 0 && req->timeout_timer) {
+        if (vox_timer_start(req->timeout_timer, req->timeout_ms, 0, getaddrinfo_timeout_cb, req) != 0) {
+            VOX_LOG_ERROR("DNS超时定时器启动失败");
+        }
+    }
+
+    if (entry->resolving) {
+        r->stats.coalesced++;
+    } else {
+        entry_resolve(entry);
+    }
+    return 0;
+}
+
+/* ===== 解析缓存 API ===== */
+
+int vox_dns_cache_configure(vox_loop_t* loop, const vox_dns_cache_config_t* config) {
+    if (!loop) {
+        return -1;
+    }
+    dns_resolver_t* r = (dns_resolver_t*)vox_loop_get_ext(loop, &dns_resolver_key);
+    if (!r) {
+        r = resolver_create(loop, config);
+        if (!r) {
+            VOX_LOG_ERROR("创建DNS解析缓存失败");
+            return -1;
+        }
+        return 0;
+    }
+
+    /* 已存在：更新配置，进行中的解析沿用原有查询 */
+    vox_dns_cache_config_t c;
+    memset(&c, 0, sizeof(c));
+    if (config) {
+        c = *config;
+    }
+    config_apply_defaults(&c);
+    resolver_load_nameservers(r, c.nameservers, c.search, c.ndots);
+    c.nameservers = NULL;
+    c.search = NULL;
+    r->config = c;
+    vox_dns_cache_clear(loop);
+    return 0;
+}
+
+void vox_dns_cache_clear(vox_loop_t* loop) {
+    dns_resolver_t* r = loop ? (dns_resolver_t*)vox_loop_get_ext(loop, &dns_resolver_key) : NULL;
+    if (!r) {
+        return;
+    }
+    vox_list_node_t* node;
+    vox_list_node_t* next;
+    vox_list_for_each_safe(node, next, &r->lru) {
+        dns_cache_entry_t* e = vox_container_of(node, dns_cache_entry_t, lru_node);
+        if (!e->resolving && vox_list_empty(&e->waiters)) {
+            entry_free(e);
+        } else {
+            /* 进行中：结果仍会交付给等待者，但丢弃旧数据 */
+            if (e->addrs) {
+                vox_mpool_free(r->mpool, e->addrs);
+                e->addrs = NULL;
+            }
+            e->count = 0;
+            e->has_data = false;
+        }
+    }
+}
+
+int vox_dns_cache_get_stats(vox_loop_t* loop, vox_dns_cache_stats_t* stats) {
+    if (!loop || !stats) {
+        return -1;
+    }
+    dns_resolver_t* r = (dns_resolver_t*)vox_loop_get_ext(loop, &dns_resolver_key);
+    if (!r) {
+        memset(stats, 0, sizeof(*stats));
+        return 0;
+    }
+    *stats = r->stats;
+    stats->entries = vox_htable_size(r->entries);
+    return 0;
+}
+
+static void resolver_close_socket(dns_resolver_t* r, vox_udp_t* udp) {
+    if (!udp) {
+        return;
+    }
+    vox_udp_destroy(udp);
+    /* loop 即将销毁，关闭队列不会再被处理，直接摘除并释放 */
+    vox_list_t* closing = vox_loop_get_closing_handles(r->loop);
+    if (closing && udp->handle.node.next != &udp->handle.node) {
+        vox_list_remove(closing, &udp->handle.node);
+    }
+    vox_mpool_free(r->mpool, udp);
+}
+
+/* 销毁解析缓存（loop 扩展数据的 cleanup，调用时已从 loop 上移除） */
+static void resolver_destroy(vox_loop_t* loop, void* data) {
+    VOX_UNUSED(loop);
+    dns_resolver_t* r = (dns_resolver_t*)data;
+
+    while (!vox_list_empty(&r->queries)) {
+        dns_query_t* q = vox_container_of(vox_list_pop_front(&r->queries), dns_query_t, node);
+        vox_timer_destroy(&q->timer);
+        vox_mpool_free(r->mpool, q);
+    }
+    resolver_close_socket(r, r->udp4);
+    resolver_close_socket(r, r->udp6);
+    while (!vox_list_empty(&r->retired)) {
+        vox_mpool_free(r->mpool, vox_container_of(vox_list_pop_front(&r->retired), dns_query_t, node));
+    }
+
+    while (!vox_list_empty(&r->lru)) {
+        dns_cache_entry_t* e = vox_container_of(vox_list_first(&r->lru), dns_cache_entry_t, lru_node);
+        while (!vox_list_empty(&e->waiters)) {
+            vox_dns_getaddrinfo_t* req = vox_container_of(vox_list_first(&e->waiters),
+                                                          vox_dns_getaddrinfo_t, cache_node);
+            req_detach(req);
+        }
+        entry_free(e);
+    }
+    vox_htable_destroy(r->entries);
+    vox_htable_destroy(r->hosts);
+    vox_mpool_free(r->mpool, r);
+}
+
 /* ===== getaddrinfo API ===== */
 
 int vox_dns_getaddrinfo_init(vox_dns_getaddrinfo_t* req, vox_loop_t* loop) {
@@ -482,6 +1705,22 @@ int vox_dns_getaddrinfo(vox_dns_getaddrinfo_t* req,
     /* 激活句柄 */
     vox_handle_activate((vox_handle_t*)req);
     
+    /* 优先经过解析缓存（命中、合并或原生 UDP 查询） */
+    if (req->addrinfo.addrs) {
+        vox_mpool_free(mpool, req->addrinfo.addrs);
+        req->addrinfo.addrs = NULL;
+        req->addrinfo.count = 0;
+    }
+    int cache_rc = dns_cache_resolve(req);
+    if (cache_rc == 0) {
+        return 0;
+    }
+    if (cache_rc < 0) {
+        req->pending = false;
+        vox_handle_deactivate((vox_handle_t*)req);
+        return -1;
+    }
+    
     /* 创建工作项 */
     getaddrinfo_work_t* work = (getaddrinfo_work_t*)vox_mpool_alloc(mpool, sizeof(getaddrinfo_work_t));
     if (!work) {
@@ -553,6 +1792,9 @@ int vox_dns_getaddrinfo_cancel(vox_dns_getaddrinfo_t* req) {
         return 0;  /* 没有正在进行的请求 */
     }
     
+    /* 从缓存项的等待链表摘除 */
+    req_detach(req);
+    
     /* 标记为关闭，线程任务会检查这个标志 */
     req->handle.closing = true;
     req->pending = false;
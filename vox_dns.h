@@ -1,6 +1,14 @@
 /*
  * vox_dns.h - 异步DNS解析
  * 提供类似 libuv 的异步DNS解析接口
+ *
+ * getaddrinfo 默认经过 loop 级解析缓存：
+ * - 数字地址直接返回，不进入缓存
+ * - 正/负结果按 TTL 缓存，同一主机名的并发查询合并为一次解析（single-flight）
+ * - 命中时若剩余 TTL 低于阈值，在后台预取刷新
+ * - 缓存未命中时优先使用基于 vox_udp 的原生异步 DNS 查询（nameserver 来自配置或 /etc/resolv.conf），
+ *   按 search 域与 ndots 依次尝试候选名称（NXDOMAIN 后换下一个）；
+ *   /etc/hosts 中的名称、无 search 域时的单标签名称、截断或失败的应答回退到线程池 getaddrinfo
  */
 
 #ifndef VOX_DNS_H
@@ -73,6 +81,10 @@ struct vox_dns_getaddrinfo {
     /* 超时机制 */
     vox_timer_t* timeout_timer;  /* 超时定时器 */
     uint64_t timeout_ms;         /* 超时时间（毫秒），0表示无超时 */
+
+    /* 解析缓存（内部使用）：等待同一缓存项解析完成时挂在其等待链表上 */
+    void* cache_entry;
+    vox_list_node_t cache_node;
 };
 
 /* DNS getnameinfo 请求结构 */
@@ -177,6 +189,58 @@ int vox_dns_getaddrinfo_simple(vox_loop_t* loop,
                                void* user_data,
                                uint64_t timeout_ms);
 
+/* ===== 解析缓存 ===== */
+
+/* 解析缓存配置（所有数值字段 0 表示使用默认值） */
+typedef struct {
+    bool disable_cache;           /* true 时每次查询都直接走线程池 getaddrinfo（旧行为） */
+    bool disable_udp_resolver;    /* true 时缓存未命中统一回退线程池 getaddrinfo */
+    const char* nameservers;      /* 逗号分隔，如 "127.0.0.1:5353,8.8.8.8"；NULL 表示读取 /etc/resolv.conf */
+    const char* search;           /* search 域，空格或逗号分隔；NULL 且 nameservers 为 NULL 时取 resolv.conf 的 search/domain */
+    uint32_t ndots;               /* 点数少于该值的名称先尝试 search 域；0 表示取 resolv.conf 的 options ndots，默认 1 */
+    uint32_t positive_ttl_ms;     /* getaddrinfo 回退结果的缓存时间，默认 60000 */
+    uint32_t min_ttl_ms;          /* UDP 应答 TTL 下限，默认 1000 */
+    uint32_t max_ttl_ms;          /* UDP 应答 TTL 上限，默认 3600000 */
+    uint32_t negative_ttl_ms;     /* 解析失败/NXDOMAIN 的缓存时间，默认 5000 */
+    uint32_t prefetch_percent;    /* 命中时剩余 TTL 低于该百分比则后台刷新，默认 10；大于 100 表示关闭 */
+    uint32_t max_entries;         /* 最大缓存项数（LRU 淘汰），默认 1024 */
+    uint32_t udp_timeout_ms;      /* 单次 UDP 查询超时，默认 1000 */
+    uint32_t udp_attempts;        /* 每个 nameserver 的尝试次数，默认 2 */
+} vox_dns_cache_config_t;
+
+/* 解析缓存统计 */
+typedef struct {
+    uint64_t hits;                /* 缓存命中次数 */
+    uint64_t misses;              /* 缓存未命中次数 */
+    uint64_t coalesced;           /* 合并到进行中解析的次数 */
+    uint64_t prefetches;          /* 后台预取次数 */
+    uint64_t udp_queries;         /* 发出的 UDP 查询数（含重传） */
+    uint64_t fallbacks;           /* 回退到线程池 getaddrinfo 的次数 */
+    size_t entries;               /* 当前缓存项数 */
+} vox_dns_cache_stats_t;
+
+/**
+ * 配置事件循环的解析缓存（会清空已有缓存项）
+ * @param loop 事件循环指针
+ * @param config 配置，NULL 表示使用默认配置
+ * @return 成功返回0，失败返回-1
+ */
+int vox_dns_cache_configure(vox_loop_t* loop, const vox_dns_cache_config_t* config);
+
+/**
+ * 清空解析缓存（进行中的解析不受影响）
+ * @param loop 事件循环指针
+ */
+void vox_dns_cache_clear(vox_loop_t* loop);
+
+/**
+ * 获取解析缓存统计
+ * @param loop 事件循环指针
+ * @param stats 输出统计
+ * @return 成功返回0，失败返回-1
+ */
+int vox_dns_cache_get_stats(vox_loop_t* loop, vox_dns_cache_stats_t* stats);
+
 /**
  * 初始化 getnameinfo 请求
  * @param req 请求指针
@@ -0,0 +1,360 @@
+/*
+ * vox_ebr.c - 基于纪元的内存回收实现
+ * - 线程句柄串成只追加的全局链表（注销后标记为空闲，供后续注册复用，直到域销毁才释放）
+ * - 句柄的 state 为 (纪元 << 1) | ACTIVE，不在临界区时为 0
+ * - 每个句柄有 3 个按纪元分组的待回收链表，只由持有句柄的线程访问，退休无需加锁
+ * - 推进：所有处于临界区的线程都已观察到当前纪元 e 时，CAS 把全局纪元改为 e + 1
+ */
+
+#include "vox_ebr.h"
+#include "vox_atomic.h"
+#include "vox_mutex.h"
+#include "vox_thread.h"
+#include "vox_log.h"
+#include <string.h>
+
+#define VOX_EBR_DEFAULT_BATCH 64
+#define EBR_ACTIVE 1
+
+/* 退休记录 */
+typedef struct ebr_retired {
+    struct ebr_retired* next;
+    void* ptr;
+    vox_ebr_free_func_t free_func;
+    void* user_data;
+} ebr_retired_t;
+
+/* 同一纪元退休的对象 */
+typedef struct {
+    int64_t epoch;
+    ebr_retired_t* head;
+    size_t count;
+} ebr_bucket_t;
+
+struct vox_ebr_thread {
+    vox_atomic_long_t state;             /* 读者公告，其他线程推进纪元时扫描 */
+    char pad0[VOX_CACHE_LINE_SIZE - sizeof(vox_atomic_long_t)];
+    vox_ebr_t* ebr;
+    struct vox_ebr_thread* next;         /* 全局链表（发布后不再修改） */
+    vox_atomic_int_t in_use;             /* 是否被某个线程持有 */
+    int depth;                           /* 临界区嵌套深度 */
+    int tls_bound;                       /* 是否为 vox_ebr_thread 绑定到 TLS 的句柄 */
+    ebr_bucket_t limbo[3];
+    ebr_retired_t* free_records;         /* 回收后复用的退休记录 */
+    size_t pending;
+};
+
+struct vox_ebr {
+    vox_mpool_t* mpool;                  /* 域结构所在的内存池 */
+    vox_mpool_t* pool;                   /* 句柄与退休记录的内部线程安全内存池 */
+    size_t batch_size;
+    vox_tls_key_t* tls;
+    vox_mutex_t lock;                    /* 保护链表追加 */
+    vox_atomic_ptr_t threads;            /* 句柄链表头 */
+    vox_atomic_long_t thread_count;
+    char pad0[VOX_CACHE_LINE_SIZE];
+    vox_atomic_long_padded_t epoch;      /* 全局纪元 */
+    vox_atomic_long_padded_t pending;    /* 所有句柄上的待回收对象数量 */
+};
+
+static void ebr_tls_destructor(void* value);
+
+vox_ebr_t* vox_ebr_create(vox_mpool_t* mpool) {
+    return vox_ebr_create_with_config(mpool, NULL);
+}
+
+vox_ebr_t* vox_ebr_create_with_config(vox_mpool_t* mpool, const vox_ebr_config_t* config) {
+    if (!mpool) return NULL;
+
+    vox_ebr_t* ebr = (vox_ebr_t*)vox_mpool_alloc(mpool, sizeof(vox_ebr_t));
+    if (!ebr) {
+        VOX_LOG_ERROR("Failed to allocate ebr");
+        return NULL;
+    }
+    memset(ebr, 0, sizeof(vox_ebr_t));
+    ebr->mpool = mpool;
+    ebr->batch_size = (config && config->batch_size > 0) ? config->batch_size : VOX_EBR_DEFAULT_BATCH;
+
+    vox_mpool_config_t pool_config = {0};
+    pool_config.thread_safe = 1;
+    ebr->pool = vox_mpool_create_with_config(&pool_config);
+    if (!ebr->pool) {
+        VOX_LOG_ERROR("Failed to create ebr pool");
+        vox_mpool_free(mpool, ebr);
+        return NULL;
+    }
+    if (vox_mutex_create(&ebr->lock) != 0) {
+        vox_mpool_destroy(ebr->pool);
+        vox_mpool_free(mpool, ebr);
+        return NULL;
+    }
+    ebr->tls = vox_tls_key_create(ebr->pool, ebr_tls_destructor);
+    if (!ebr->tls) {
+        VOX_LOG_ERROR("Failed to create ebr tls key");
+        vox_mutex_destroy(&ebr->lock);
+        vox_mpool_destroy(ebr->pool);
+        vox_mpool_free(mpool, ebr);
+        return NULL;
+    }
+    vox_atomic_ptr_init(&ebr->threads, NULL);
+    vox_atomic_long_init(&ebr->thread_count, 0);
+    vox_atomic_long_init(&ebr->epoch.value, 0);
+    vox_atomic_long_init(&ebr->pending.value, 0);
+    return ebr;
+}
+
+/* 依次调用释放函数，记录放回句柄的复用链表 */
+static size_t free_list(vox_ebr_thread_t* t, ebr_retired_t* r) {
+    size_t n = 0;
+    while (r) {
+        ebr_retired_t* next = r->next;
+        r->free_func(r->ptr, r->user_data);
+        r->next = t->free_records;
+        t->free_records = r;
+        r = next;
+        n++;
+    }
+    return n;
+}
+
+static size_t free_bucket(vox_ebr_thread_t* t, ebr_bucket_t* b) {
+    ebr_retired_t* list = b->head;
+    size_t count = b->count;
+    b->head = NULL;
+    b->count = 0;
+    if (count == 0) return 0;
+    t->pending -= count;
+    vox_atomic_long_sub(&t->ebr->pending.value, (int64_t)count);
+    return free_list(t, list);
+}
+
+void vox_ebr_destroy(vox_ebr_t* ebr) {
+    if (!ebr) return;
+
+    /* 先删除 TLS 键，之后线程退出不再调用析构函数 */
+    vox_tls_key_destroy(ebr->tls);
+    vox_ebr_thread_t* t = (vox_ebr_thread_t*)vox_atomic_ptr_load(&ebr->threads);
+    while (t) {
+        for (int i = 0; i < 3; i++) {
+            free_bucket(t, &t->limbo[i]);
+        }
+        t = t->next;
+    }
+    vox_mutex_destroy(&ebr->lock);
+    vox_mpool_destroy(ebr->pool);
+    vox_mpool_free(ebr->mpool, ebr);
+}
+
+/* ===== 线程句柄 ===== */
+
+vox_ebr_thread_t* vox_ebr_register(vox_ebr_t* ebr) {
+    if (!ebr) return NULL;
+
+    /* 优先复用已注销的句柄（连同其遗留的待回收对象） */
+    vox_ebr_thread_t* t = (vox_ebr_thread_t*)vox_atomic_ptr_load(&ebr->threads);
+    for (; t; t = t->next) {
+        int32_t expected = 0;
+        if (vox_atomic_int_load(&t->in_use) == 0 &&
+            vox_atomic_int_compare_exchange(&t->in_use, &expected, 1)) {
+            t->depth = 0;
+            t->tls_bound = 0;
+            vox_atomic_long_increment(&ebr->thread_count);
+            return t;
+        }
+    }
+
+    t = (vox_ebr_thread_t*)vox_mpool_alloc(ebr->pool, sizeof(vox_ebr_thread_t));
+    if (!t) {
+        VOX_LOG_ERROR("Failed to allocate ebr thread");
+        return NULL;
+    }
+    memset(t, 0, sizeof(vox_ebr_thread_t));
+    vox_atomic_long_init(&t->state, 0);
+    vox_atomic_int_init(&t->in_use, 1);
+    t->ebr = ebr;
+
+    vox_mutex_lock(&ebr->lock);
+    t->next = (vox_ebr_thread_t*)vox_atomic_ptr_load(&ebr->threads);
+    vox_atomic_ptr_store(&ebr->threads, t);
+    vox_mutex_unlock(&ebr->lock);
+    vox_atomic_long_increment(&ebr->thread_count);
+    return t;
+}
+
+void vox_ebr_unregister(vox_ebr_thread_t* t) {
+    if (!t) return;
+    vox_ebr_t* ebr = t->ebr;
+    if (t->depth > 0) {
+        VOX_LOG_ERROR("ebr thread unregistered inside a critical section");
+        t->depth = 0;
+        vox_atomic_long_store(&t->state, 0);
+    }
+    if (t->tls_bound) {
+        t->tls_bound = 0;
+        vox_tls_set(ebr->tls, NULL);
+    }
+    vox_ebr_collect(t);
+    vox_atomic_long_decrement(&ebr->thread_count);
+    vox_atomic_int_store(&t->in_use, 0);
+}
+
+static void ebr_tls_destructor(void* value) {
+    vox_ebr_thread_t* t = (vox_ebr_thread_t*)value;
+    if (!t) return;
+    /* 线程退出时 TLS 值已被清空，不需要再 vox_tls_set */
+    t->tls_bound = 0;
+    vox_ebr_unregister(t);
+}
+
+vox_ebr_thread_t* vox_ebr_thread(vox_ebr_t* ebr) {
+    if (!ebr) return NULL;
+    vox_ebr_thread_t* t = (vox_ebr_thread_t*)vox_tls_get(ebr->tls);
+    if (t) return t;
+
+    t = vox_ebr_register(ebr);
+    if (!t) return NULL;
+    if (vox_tls_set(ebr->tls, t) != 0) {
+        vox_ebr_unregister(t);
+        return NULL;
+    }
+    t->tls_bound = 1;
+    return t;
+}
+
+/* ===== 临界区 ===== */
+
+void vox_ebr_enter(vox_ebr_thread_t* t) {
+    if (!t || t->depth++ > 0) return;
+    vox_ebr_t* ebr = t->ebr;
+    for (;;) {
+        int64_t e = vox_atomic_long_load(&ebr->epoch.value);
+        vox_atomic_long_store(&t->state, (e << 1) | EBR_ACTIVE);
+        /* 公告对推进者可见之后纪元仍未变化，才算进入了纪元 e */
+        if (vox_atomic_long_load(&ebr->epoch.value) == e) return;
+    }
+}
+
+void vox_ebr_exit(vox_ebr_thread_t* t) {
+    if (!t || t->depth <= 0) return;
+    if (--t->depth == 0) {
+        vox_atomic_long_store(&t->state, 0);
+    }
+}
+
+bool vox_ebr_in_critical(const vox_ebr_thread_t* t) {
+    return t && t->depth > 0;
+}
+
+/* ===== 回收 ===== */
+
+/* 所有临界区内的线程都已观察到当前纪元时推进一次 */
+static bool try_advance(vox_ebr_t* ebr) {
+    int64_t e = vox_atomic_long_load(&ebr->epoch.value);
+    for (vox_ebr_thread_t* t = (vox_ebr_thread_t*)vox_atomic_ptr_load(&ebr->threads); t; t = t->next) {
+        int64_t s = vox_atomic_long_load(&t->state);
+        if ((s & EBR_ACTIVE) && (s >> 1) != e) return false;
+    }
+    vox_atomic_long_compare_exchange(&ebr->epoch.value, &e, e + 1);
+    return true;
+}
+
+/* 释放句柄上退休纪元不晚于 全局纪元 - 2 的对象 */
+static size_t collect_thread(vox_ebr_thread_t* t) {
+    int64_t g = vox_atomic_long_load(&t->ebr->epoch.value);
+    size_t n = 0;
+    for (int i = 0; i < 3; i++) {
+        ebr_bucket_t* b = &t->limbo[i];
+        if (b->count > 0 && b->epoch <= g - 2) {
+            n += free_bucket(t, b);
+        }
+    }
+    return n;
+}
+
+size_t vox_ebr_collect(vox_ebr_thread_t* t) {
+    if (!t) return 0;
+    vox_ebr_t* ebr = t->ebr;
+    try_advance(ebr);
+    size_t n = collect_thread(t);
+
+    /* 接管已注销句柄遗留的对象 */
+    for (vox_ebr_thread_t* o = (vox_ebr_thread_t*)vox_atomic_ptr_load(&ebr->threads); o; o = o->next) {
+        int32_t expected = 0;
+        if (o == t || vox_atomic_int_load(&o->in_use) != 0) continue;
+        if (vox_atomic_int_compare_exchange(&o->in_use, &expected, 1)) {
+            n += collect_thread(o);
+            vox_atomic_int_store(&o->in_use, 0);
+        }
+    }
+    return n;
+}
+
+size_t vox_ebr_synchronize(vox_ebr_thread_t* t) {
+    if (!t) return 0;
+    if (t->depth > 0) {
+        VOX_LOG_ERROR("vox_ebr_synchronize called inside a critical section");
+        return 0;
+    }
+    vox_ebr_t* ebr = t->ebr;
+    int64_t target = vox_atomic_long_load(&ebr->epoch.value) + 2;
+    while (vox_atomic_long_load(&ebr->epoch.value) < target) {
+        if (!try_advance(ebr)) {
+            vox_thread_yield();
+        }
+    }
+    return vox_ebr_collect(t);
+}
+
+int vox_ebr_retire(vox_ebr_thread_t* t, void* ptr, vox_ebr_free_func_t free_func, void* user_data) {
+    if (!t || !free_func) return -1;
+    vox_ebr_t* ebr = t->ebr;
+
+    ebr_retired_t* r = t->free_records;
+    if (r) {
+        t->free_records = r->next;
+    } else {
+        r = (ebr_retired_t*)vox_mpool_alloc(ebr->pool, sizeof(ebr_retired_t));
+        if (!r) {
+            VOX_LOG_ERROR("Failed to allocate ebr retire record");
+            return -1;
+        }
+    }
+    r->ptr = ptr;
+    r->free_func = free_func;
+    r->user_data = user_data;
+
+    /* 纪元在摘除之后读取，不早于任何仍可能持有该对象的读者的纪元 */
+    int64_t e = vox_atomic_long_load(&ebr->epoch.value);
+    ebr_bucket_t* b = &t->limbo[e % 3];
+    if (b->count > 0 && b->epoch != e) {
+        /* 槽位中是至少三个纪元之前的对象，已经可以释放 */
+        free_bucket(t, b);
+    }
+    b->epoch = e;
+    r->next = b->head;
+    b->head = r;
+    b->count++;
+    t->pending++;
+    vox_atomic_long_increment(&ebr->pending.value);
+
+    if (t->pending >= ebr->batch_size) {
+        vox_ebr_collect(t);
+    }
+    return 0;
+}
+
+static void ebr_mpool_free(void* ptr, void* user_data) {
+    vox_mpool_free((vox_mpool_t*)user_data, ptr);
+}
+
+int vox_ebr_retire_mpool(vox_ebr_thread_t* t, vox_mpool_t* mpool, void* ptr) {
+    if (!mpool) return -1;
+    return vox_ebr_retire(t, ptr, ebr_mpool_free, mpool);
+}
+
+void vox_ebr_stats(const vox_ebr_t* ebr, uint64_t* epoch, size_t* pending, size_t* threads) {
+    if (!ebr) return;
+    if (epoch) *epoch = (uint64_t)vox_atomic_long_load(&ebr->epoch.value);
+    if (pending) *pending = (size_t)vox_atomic_long_load(&ebr->pending.value);
+    if (threads) *threads = (size_t)vox_atomic_long_load(&ebr->thread_count);
+}
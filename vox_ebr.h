@@ -0,0 +1,147 @@
+/*
+ * vox_ebr.h - 基于纪元的内存回收（Epoch-Based Reclamation）
+ * 供无锁结构（并发哈希表、RCU 式的配置/路由替换、分片服务器共享数据等）安全地释放被摘除的节点：
+ * - 读者在访问共享结构前 enter，访问结束后 exit（可以嵌套），临界区内只做原子加载，不加锁
+ * - 写者把节点从结构中摘除后调用 retire，节点在所有可能看到它的读者离开临界区后才被释放
+ * - 全局纪元只有在所有处于临界区的线程都已观察到当前纪元时才推进；
+ *   在纪元 e 退休的对象，等全局纪元推进到 e + 2 后即可释放
+ *
+ * 线程：
+ * - 每个访问线程需要一个 vox_ebr_thread_t：显式 register/unregister，
+ *   或用 vox_ebr_thread 取当前线程的句柄（首次使用时自动注册，POSIX 下线程退出时自动注销）
+ * - 线程句柄只能由其所属线程使用；退休的对象由退休它的线程回收，
+ *   注销时未回收的对象留给其他线程在 collect 时接管
+ */
+
+#ifndef VOX_EBR_H
+#define VOX_EBR_H
+
+#include "vox_os.h"
+#include "vox_mpool.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* EBR 域不透明类型 */
+typedef struct vox_ebr vox_ebr_t;
+
+/* 线程句柄不透明类型 */
+typedef struct vox_ebr_thread vox_ebr_thread_t;
+
+/* 释放函数：回收时以 (ptr, user_data) 调用，可能在任意注册线程中执行 */
+typedef void (*vox_ebr_free_func_t)(void* ptr, void* user_data);
+
+/* EBR 配置 */
+typedef struct {
+    size_t batch_size;       /* 每个线程累计多少个待回收对象后自动尝试回收，0表示默认64 */
+} vox_ebr_config_t;
+
+/**
+ * 创建 EBR 域
+ * @param mpool 内存池指针，仅用于分配域结构本身，必须非NULL
+ * @return 成功返回域指针，失败返回NULL
+ */
+vox_ebr_t* vox_ebr_create(vox_mpool_t* mpool);
+
+/**
+ * 使用配置创建 EBR 域（线程句柄和退休记录从内部的线程安全内存池分配）
+ * @param mpool 内存池指针，必须非NULL
+ * @param config 配置，NULL表示使用默认值
+ * @return 成功返回域指针，失败返回NULL
+ */
+vox_ebr_t* vox_ebr_create_with_config(vox_mpool_t* mpool, const vox_ebr_config_t* config);
+
+/**
+ * 销毁 EBR 域：立即释放所有待回收对象，所有线程句柄失效
+ * 调用方须保证已没有线程处于临界区或仍在使用句柄
+ * @param ebr 域指针
+ */
+void vox_ebr_destroy(vox_ebr_t* ebr);
+
+/**
+ * 为调用线程注册一个句柄
+ * @param ebr 域指针
+ * @return 成功返回线程句柄，失败返回NULL
+ */
+vox_ebr_thread_t* vox_ebr_register(vox_ebr_t* ebr);
+
+/**
+ * 注销线程句柄（不能在临界区内调用）；未回收的对象由其他线程接管
+ * @param thread 线程句柄
+ */
+void vox_ebr_unregister(vox_ebr_thread_t* thread);
+
+/**
+ * 获取当前线程的句柄，首次调用时自动注册
+ * @param ebr 域指针
+ * @return 成功返回线程句柄，失败返回NULL
+ */
+vox_ebr_thread_t* vox_ebr_thread(vox_ebr_t* ebr);
+
+/**
+ * 进入临界区（可嵌套）：在对应的 exit 之前，读到的共享对象不会被释放
+ * @param thread 线程句柄
+ */
+void vox_ebr_enter(vox_ebr_thread_t* thread);
+
+/**
+ * 离开临界区
+ * @param thread 线程句柄
+ */
+void vox_ebr_exit(vox_ebr_thread_t* thread);
+
+/**
+ * 是否处于临界区
+ */
+bool vox_ebr_in_critical(const vox_ebr_thread_t* thread);
+
+/**
+ * 退休一个已从共享结构中摘除的对象，安全后调用 free_func(ptr, user_data)
+ * @param thread 线程句柄
+ * @param ptr 对象指针
+ * @param free_func 释放函数，必须非NULL
+ * @param user_data 传给释放函数的用户数据
+ * @return 成功返回0，失败返回-1（记录分配失败，此时不会释放 ptr）
+ */
+int vox_ebr_retire(vox_ebr_thread_t* thread, void* ptr, vox_ebr_free_func_t free_func, void* user_data);
+
+/**
+ * 退休一个从内存池分配的对象，安全后调用 vox_mpool_free(mpool, ptr)
+ * （回收可能发生在其他线程，mpool 须为线程安全的）
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ebr_retire_mpool(vox_ebr_thread_t* thread, vox_mpool_t* mpool, void* ptr);
+
+/**
+ * 尝试推进纪元，并释放本线程（以及已注销线程遗留）的可回收对象；不阻塞
+ * @param thread 线程句柄
+ * @return 返回本次释放的对象数量
+ */
+size_t vox_ebr_collect(vox_ebr_thread_t* thread);
+
+/**
+ * 等待纪元推进两次，然后释放本线程在调用前退休的全部对象
+ * 会等待其他线程离开临界区；不能在临界区内调用
+ * @param thread 线程句柄
+ * @return 返回本次释放的对象数量
+ */
+size_t vox_ebr_synchronize(vox_ebr_thread_t* thread);
+
+/**
+ * 获取统计信息
+ * @param ebr 域指针
+ * @param epoch 输出当前全局纪元（可为NULL）
+ * @param pending 输出等待回收的对象数量（可为NULL）
+ * @param threads 输出正在使用的线程句柄数量（可为NULL）
+ */
+void vox_ebr_stats(const vox_ebr_t* ebr, uint64_t* epoch, size_t* pending, size_t* threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_EBR_H */
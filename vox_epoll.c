@@ -2,10 +2,12 @@
  * vox_epoll.c - Linux epoll backend 实现（高并发优化版）
  *
  * 优化特性：
- * - 使用 data.ptr 直接存储 info 指针，避免事件处理时的哈希表查找
+ * - 使用 data.ptr 直接存储 info 指针，事件分发无需任何查找
+ * - fd -> info 使用按 fd 下标索引的 vox_fdtable，add/modify/remove 无需哈希
  * - 增大默认队列大小以支持更高并发（8192个事件）
  * - 改进错误处理和资源清理机制
  * - 优化唤醒管道处理逻辑
+ * - 唤醒优先使用 eventfd（一个 fd、写入合并为计数），不可用时退回管道
  */
 
 #ifdef VOX_OS_LINUX
@@ -13,9 +15,10 @@
 #include "vox_epoll.h"
 #include "vox_backend.h"
 #include "vox_mpool.h"
-#include "vox_htable.h"
+#include "vox_fdtable.h"
 #include "vox_log.h"
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
@@ -35,15 +38,27 @@ typedef struct {
 /* epoll 结构 */
 struct vox_epoll {
     int epoll_fd;                    /* epoll 文件描述符 */
-    int wakeup_fd[2];                /* 用于唤醒的管道 [0]=read, [1]=write */
+    int wakeup_fd[2];                /* 唤醒 fd [0]=read, [1]=write；使用 eventfd 时两者相同 */
     size_t max_events;               /* 每次 epoll_wait 的最大事件数 */
     struct epoll_event* events;      /* 事件数组 */
-    vox_htable_t* fd_map;            /* fd -> fd_info 映射 */
+    vox_fdtable_t* fd_map;           /* fd -> fd_info 映射 */
     vox_mpool_t* mpool;              /* 内存池 */
     bool own_mpool;                  /* 是否拥有内存池 */
     bool initialized;                /* 是否已初始化 */
 };
 
+/* 关闭唤醒 fd（eventfd 时读写端为同一个 fd） */
+static void epoll_close_wakeup(vox_epoll_t* epoll) {
+    if (epoll->wakeup_fd[1] >= 0 && epoll->wakeup_fd[1] != epoll->wakeup_fd[0]) {
+        close(epoll->wakeup_fd[1]);
+    }
+    if (epoll->wakeup_fd[0] >= 0) {
+        close(epoll->wakeup_fd[0]);
+    }
+    epoll->wakeup_fd[0] = -1;
+    epoll->wakeup_fd[1] = -1;
+}
+
 /* 创建 epoll backend */
 vox_epoll_t* vox_epoll_create(const vox_epoll_config_t* config) {
     vox_mpool_t* mpool = config ? config->mpool : NULL;
@@ -83,7 +98,7 @@ vox_epoll_t* vox_epoll_create(const vox_epoll_config_t* config) {
     }
     
     /* 创建 fd 映射表 */
-    epoll->fd_map = vox_htable_create(epoll->mpool);
+    epoll->fd_map = vox_fdtable_create(epoll->mpool);
     if (!epoll->fd_map) {
         VOX_LOG_ERROR("Failed to create fd map for epoll");
         vox_mpool_free(epoll->mpool, epoll);
@@ -100,7 +115,7 @@ vox_epoll_t* vox_epoll_create(const vox_epoll_config_t* config) {
     );
     if (!epoll->events) {
         VOX_LOG_ERROR("Failed to allocate events array for epoll");
-        vox_htable_destroy(epoll->fd_map);
+        vox_fdtable_destroy(epoll->fd_map);
         vox_mpool_free(epoll->mpool, epoll);
         if (own_mpool) {
             vox_mpool_destroy(mpool);
@@ -127,9 +142,12 @@ int vox_epoll_init(vox_epoll_t* epoll) {
         return -1;
     }
     
-    /* 创建唤醒管道 */
-    /* 使用 pipe + fcntl 以确保兼容性（pipe2 需要 _GNU_SOURCE） */
-    if (pipe(epoll->wakeup_fd) < 0) {
+    /* 创建唤醒 fd：优先 eventfd，失败时使用 pipe + fcntl（pipe2 需要 _GNU_SOURCE） */
+    int efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (efd >= 0) {
+        epoll->wakeup_fd[0] = efd;
+        epoll->wakeup_fd[1] = efd;
+    } else if (pipe(epoll->wakeup_fd) < 0) {
         VOX_LOG_ERROR("Failed to create wakeup pipe: errno=%d", errno);
         close(epoll->epoll_fd);
         epoll->epoll_fd = -1;
@@ -159,11 +177,8 @@ int vox_epoll_init(vox_epoll_t* epoll) {
     vox_epoll_fd_info_t* wakeup_info = (vox_epoll_fd_info_t*)vox_mpool_alloc(
         epoll->mpool, sizeof(vox_epoll_fd_info_t));
     if (!wakeup_info) {
-        close(epoll->wakeup_fd[0]);
-        close(epoll->wakeup_fd[1]);
+        epoll_close_wakeup(epoll);
         close(epoll->epoll_fd);
-        epoll->wakeup_fd[0] = -1;
-        epoll->wakeup_fd[1] = -1;
         epoll->epoll_fd = -1;
         return -1;
     }
@@ -176,12 +191,9 @@ int vox_epoll_init(vox_epoll_t* epoll) {
     ev.data.ptr = wakeup_info;  /* 使用 ptr 存储指针 */
     if (epoll_ctl(epoll->epoll_fd, EPOLL_CTL_ADD, epoll->wakeup_fd[0], &ev) < 0) {
         VOX_LOG_ERROR("Failed to add wakeup pipe to epoll: errno=%d", errno);
-        close(epoll->wakeup_fd[0]);
-        close(epoll->wakeup_fd[1]);
+        epoll_close_wakeup(epoll);
         close(epoll->epoll_fd);
         epoll->epoll_fd = -1;
-        epoll->wakeup_fd[0] = -1;
-        epoll->wakeup_fd[1] = -1;
         return -1;
     }
     
@@ -199,19 +211,13 @@ void vox_epoll_destroy(vox_epoll_t* epoll) {
         close(epoll->epoll_fd);
     }
     
-    if (epoll->wakeup_fd[0] >= 0) {
-        close(epoll->wakeup_fd[0]);
-    }
-    
-    if (epoll->wakeup_fd[1] >= 0) {
-        close(epoll->wakeup_fd[1]);
-    }
+    epoll_close_wakeup(epoll);
     
     vox_mpool_t* mpool = epoll->mpool;
     bool own_mpool = epoll->own_mpool;
     
     if (epoll->fd_map) {
-        vox_htable_destroy(epoll->fd_map);
+        vox_fdtable_destroy(epoll->fd_map);
     }
     
     /* 从内存池释放 epoll 结构 */
@@ -281,8 +287,7 @@ int vox_epoll_add(vox_epoll_t* epoll, int fd, uint32_t events, void* user_data)
     }
     
     /* 检查是否已存在 */
-    int key = fd;
-    if (vox_htable_contains(epoll->fd_map, &key, sizeof(key))) {
+    if (vox_fdtable_get(epoll->fd_map, fd)) {
         return -1;  /* 已存在，避免重复添加 */
     }
     
@@ -319,8 +324,8 @@ int vox_epoll_add(vox_epoll_t* epoll, int fd, uint32_t events, void* user_data)
     }
     
     /* 添加到映射表（用于 modify/remove 操作） */
-    if (vox_htable_set(epoll->fd_map, &key, sizeof(key), info) != 0) {
-        /* 哈希表添加失败，回滚 epoll 添加 */
+    if (vox_fdtable_set(epoll->fd_map, fd, info) != 0) {
+        /* 映射表添加失败，回滚 epoll 添加 */
         VOX_LOG_ERROR("Failed to add fd %d to epoll fd map", fd);
         epoll_ctl(epoll->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
         vox_mpool_free(epoll->mpool, info);
@@ -337,12 +342,7 @@ int vox_epoll_modify(vox_epoll_t* epoll, int fd, uint32_t events) {
     }
     
     /* 查找 fd 信息 */
-    int key = fd;
-    vox_epoll_fd_info_t* info = (vox_epoll_fd_info_t*)vox_htable_get(
-        epoll->fd_map, 
-        &key, 
-        sizeof(key)
-    );
+    vox_epoll_fd_info_t* info = (vox_epoll_fd_info_t*)vox_fdtable_get(epoll->fd_map, fd);
     if (!info) {
         return -1;  /* 不存在 */
     }
@@ -381,14 +381,8 @@ int vox_epoll_remove(vox_epoll_t* epoll, int fd) {
     }
     
     /* 2. 无论 epoll_ctl 结果如何，都尝试从映射表移除并释放 info 内存 */
-    int key = fd;
-    vox_epoll_fd_info_t* info = (vox_epoll_fd_info_t*)vox_htable_get(
-        epoll->fd_map, 
-        &key, 
-        sizeof(key)
-    );
+    vox_epoll_fd_info_t* info = (vox_epoll_fd_info_t*)vox_fdtable_remove(epoll->fd_map, fd);
     if (info) {
-        vox_htable_delete(epoll->fd_map, &key, sizeof(key));
         vox_mpool_free(epoll->mpool, info);
     }
     
@@ -456,11 +450,11 @@ int vox_epoll_wakeup(vox_epoll_t* epoll) {
         return -1;
     }
     
-    /* 写入一个字节到唤醒管道 */
-    char byte = 1;
-    if (write(epoll->wakeup_fd[1], &byte, 1) < 0) {
+    /* eventfd 要求写入 8 字节计数；管道同样可以接受 */
+    uint64_t one = 1;
+    if (write(epoll->wakeup_fd[1], &one, sizeof(one)) < 0) {
         if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            return 0;  /* 管道已满，说明已经唤醒 */
+            return 0;  /* 管道已满 / 计数已满，说明已经唤醒 */
         }
         VOX_LOG_ERROR("Failed to write to wakeup pipe: errno=%d", errno);
         return -1;
@@ -0,0 +1,124 @@
+/*
+ * vox_fdtable.c - 按文件描述符下标索引的稀疏数组实现
+ */
+
+#include "vox_fdtable.h"
+#include <string.h>
+
+#define VOX_FDTABLE_INITIAL_PAGES 8
+
+vox_fdtable_t* vox_fdtable_create(vox_mpool_t* mpool) {
+    if (!mpool) return NULL;
+
+    vox_fdtable_t* table = (vox_fdtable_t*)vox_mpool_alloc(mpool, sizeof(vox_fdtable_t));
+    if (!table) return NULL;
+    memset(table, 0, sizeof(*table));
+    table->mpool = mpool;
+    table->max_fd = -1;
+
+    table->pages = (void***)vox_mpool_alloc(mpool, VOX_FDTABLE_INITIAL_PAGES * sizeof(void**));
+    if (!table->pages) {
+        vox_mpool_free(mpool, table);
+        return NULL;
+    }
+    memset(table->pages, 0, VOX_FDTABLE_INITIAL_PAGES * sizeof(void**));
+    table->page_count = VOX_FDTABLE_INITIAL_PAGES;
+    return table;
+}
+
+void vox_fdtable_destroy(vox_fdtable_t* table) {
+    if (!table) return;
+    vox_mpool_t* mpool = table->mpool;
+    for (size_t i = 0; i < table->page_count; i++) {
+        if (table->pages[i]) {
+            vox_mpool_free(mpool, table->pages[i]);
+        }
+    }
+    vox_mpool_free(mpool, table->pages);
+    vox_mpool_free(mpool, table);
+}
+
+/* 确保 fd 所在的页存在 */
+static void** fdtable_page(vox_fdtable_t* table, size_t page) {
+    if (page >= table->page_count) {
+        size_t new_count = table->page_count;
+        while (new_count <= page) new_count *= 2;
+        void*** pages = (void***)vox_mpool_alloc(table->mpool, new_count * sizeof(void**));
+        if (!pages) return NULL;
+        memcpy(pages, table->pages, table->page_count * sizeof(void**));
+        memset(pages + table->page_count, 0, (new_count - table->page_count) * sizeof(void**));
+        vox_mpool_free(table->mpool, table->pages);
+        table->pages = pages;
+        table->page_count = new_count;
+    }
+    if (!table->pages[page]) {
+        void** p = (void**)vox_mpool_alloc(table->mpool, VOX_FDTABLE_PAGE_SIZE * sizeof(void*));
+        if (!p) return NULL;
+        memset(p, 0, VOX_FDTABLE_PAGE_SIZE * sizeof(void*));
+        table->pages[page] = p;
+    }
+    return table->pages[page];
+}
+
+/* 删除最大 fd 后向下查找新的最大 fd */
+static void fdtable_update_max(vox_fdtable_t* table) {
+    int fd = table->max_fd;
+    while (fd >= 0) {
+        size_t page = (size_t)fd >> VOX_FDTABLE_PAGE_SHIFT;
+        if (!table->pages[page]) {
+            fd = (int)(page << VOX_FDTABLE_PAGE_SHIFT) - 1;
+            continue;
+        }
+        if (table->pages[page][(size_t)fd & VOX_FDTABLE_PAGE_MASK]) break;
+        fd--;
+    }
+    table->max_fd = fd;
+}
+
+int vox_fdtable_set(vox_fdtable_t* table, int fd, void* value) {
+    if (!table || fd < 0) return -1;
+    if (!value) {
+        vox_fdtable_remove(table, fd);
+        return 0;
+    }
+    void** page = fdtable_page(table, (size_t)fd >> VOX_FDTABLE_PAGE_SHIFT);
+    if (!page) return -1;
+    void** slot = &page[(size_t)fd & VOX_FDTABLE_PAGE_MASK];
+    if (!*slot) {
+        table->count++;
+        if (fd > table->max_fd) table->max_fd = fd;
+    }
+    *slot = value;
+    return 0;
+}
+
+void* vox_fdtable_remove(vox_fdtable_t* table, int fd) {
+    if (!table || fd < 0) return NULL;
+    size_t page = (size_t)fd >> VOX_FDTABLE_PAGE_SHIFT;
+    if (page >= table->page_count || !table->pages[page]) return NULL;
+    void** slot = &table->pages[page][(size_t)fd & VOX_FDTABLE_PAGE_MASK];
+    void* value = *slot;
+    if (value) {
+        *slot = NULL;
+        table->count--;
+        if (fd == table->max_fd) fdtable_update_max(table);
+    }
+    return value;
+}
+
+size_t vox_fdtable_foreach(vox_fdtable_t* table, void (*callback)(int fd, void* value, void* user_data),
+                           void* user_data) {
+    if (!table || !callback) return 0;
+    size_t n = 0;
+    for (size_t page = 0; page < table->page_count; page++) {
+        void** p = table->pages[page];
+        if (!p) continue;
+        for (size_t i = 0; i < VOX_FDTABLE_PAGE_SIZE; i++) {
+            if (p[i]) {
+                callback((int)((page << VOX_FDTABLE_PAGE_SHIFT) | i), p[i], user_data);
+                n++;
+            }
+        }
+    }
+    return n;
+}
@@ -0,0 +1,93 @@
+/*
+ * vox_fdtable.h - 按文件描述符下标索引的稀疏数组
+ * 供各 backend 维护 fd -> fd_info 映射：两级分页（每页 512 项），按 fd 直接寻址，无需哈希
+ * 页按需分配，目录按 2 倍增长；较大的 fd 只会分配其所在的页
+ * 使用 vox_mpool 内存池管理所有内存分配
+ */
+
+#ifndef VOX_FDTABLE_H
+#define VOX_FDTABLE_H
+
+#include "vox_mpool.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VOX_FDTABLE_PAGE_SHIFT 9
+#define VOX_FDTABLE_PAGE_SIZE (1u << VOX_FDTABLE_PAGE_SHIFT)
+#define VOX_FDTABLE_PAGE_MASK (VOX_FDTABLE_PAGE_SIZE - 1)
+
+/* 结构公开仅为了内联 get；请通过函数访问 */
+typedef struct vox_fdtable {
+    vox_mpool_t* mpool;
+    void*** pages;        /* 页目录：pages[fd >> SHIFT][fd & MASK] */
+    size_t page_count;    /* 目录长度 */
+    size_t count;         /* 非空项数量 */
+    int max_fd;           /* 当前最大的已设置 fd，空表为 -1 */
+} vox_fdtable_t;
+
+/**
+ * 创建 fd 表
+ * @param mpool 内存池指针，必须非NULL
+ * @return 成功返回 fd 表指针，失败返回NULL
+ */
+vox_fdtable_t* vox_fdtable_create(vox_mpool_t* mpool);
+
+/**
+ * 销毁 fd 表（不释放存储的值）
+ */
+void vox_fdtable_destroy(vox_fdtable_t* table);
+
+/**
+ * 设置 fd 对应的值（value 为 NULL 等同于删除）
+ * @return 成功返回0，fd 非法或分配失败返回-1
+ */
+int vox_fdtable_set(vox_fdtable_t* table, int fd, void* value);
+
+/**
+ * 删除 fd 对应的值
+ * @return 返回被删除的值，不存在返回NULL
+ */
+void* vox_fdtable_remove(vox_fdtable_t* table, int fd);
+
+/**
+ * 获取 fd 对应的值
+ * @return 存在返回值，否则返回NULL
+ */
+static inline void* vox_fdtable_get(const vox_fdtable_t* table, int fd) {
+    if (fd < 0) return NULL;
+    size_t page = (size_t)fd >> VOX_FDTABLE_PAGE_SHIFT;
+    if (page >= table->page_count || !table->pages[page]) return NULL;
+    return table->pages[page][(size_t)fd & VOX_FDTABLE_PAGE_MASK];
+}
+
+/**
+ * 非空项数量
+ */
+static inline size_t vox_fdtable_count(const vox_fdtable_t* table) {
+    return table->count;
+}
+
+/**
+ * 当前最大的已设置 fd，空表返回 -1
+ */
+static inline int vox_fdtable_max_fd(const vox_fdtable_t* table) {
+    return table->max_fd;
+}
+
+/**
+ * 按 fd 升序遍历所有非空项（回调中可删除当前项）
+ * @return 返回遍历的项数
+ */
+size_t vox_fdtable_foreach(vox_fdtable_t* table, void (*callback)(int fd, void* value, void* user_data),
+                           void* user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_FDTABLE_H */
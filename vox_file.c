@@ -201,6 +201,29 @@ int64_t vox_file_read(vox_file_t* file, void* buffer, size_t size) {
 #endif
 }
 
+/* 从指定偏移读取文件数据 */
+int64_t vox_file_read_at(vox_file_t* file, void* buffer, size_t size, int64_t offset) {
+    if (!file || !buffer || size == 0 || offset < 0) return -1;
+
+#ifdef VOX_OS_WINDOWS
+    OVERLAPPED ov;
+    memset(&ov, 0, sizeof(ov));
+    ov.Offset = (DWORD)((uint64_t)offset & 0xFFFFFFFFu);
+    ov.OffsetHigh = (DWORD)((uint64_t)offset >> 32);
+    DWORD bytes_read = 0;
+    if (!ReadFile(file->handle, buffer, (DWORD)size, &bytes_read, &ov)) {
+        return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+    }
+    return (int64_t)bytes_read;
+#else
+    ssize_t bytes_read;
+    do {
+        bytes_read = pread(file->fd, buffer, size, (off_t)offset);
+    } while (bytes_read < 0 && errno == EINTR);
+    return (int64_t)bytes_read;
+#endif
+}
+
 /* 写入文件数据 */
 int64_t vox_file_write(vox_file_t* file, const void* buffer, size_t size) {
     if (!file || !buffer || size == 0) return -1;
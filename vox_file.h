@@ -81,6 +81,16 @@ intptr_t vox_file_get_fd(vox_file_t* file);
  */
 int64_t vox_file_read(vox_file_t* file, void* buffer, size_t size);
 
+/**
+ * 从指定偏移读取文件数据（不改变文件当前位置，多个读者可共享同一文件）
+ * @param file 文件指针
+ * @param buffer 缓冲区
+ * @param size 要读取的字节数
+ * @param offset 文件偏移（字节）
+ * @return 成功返回实际读取的字节数，失败返回-1，到达文件末尾返回0
+ */
+int64_t vox_file_read_at(vox_file_t* file, void* buffer, size_t size, int64_t offset);
+
 /**
  * 写入文件数据
  * @param file 文件指针
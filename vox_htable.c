@@ -1,6 +1,9 @@
 /*
  * vox_htable.c - 高性能哈希表实现
- * 使用 wyhash 哈希函数和开放寻址法（线性探测）
+ * 使用 wyhash 哈希函数和开放寻址法（Swiss table 布局）：
+ * - 每个槽位对应 1 字节控制元数据（空/已删除/哈希低 7 位），按 16 字节一组用 SSE2/NEON 并行比较
+ * - 槽位保存完整哈希值，哈希不同的候选无需比较键
+ * - 不超过 VOX_HTABLE_INLINE_KEY 字节的键直接存放在槽位内，避免额外分配与指针跳转
  * 使用 vox_mpool 内存池管理所有内存分配
  */
 
@@ -11,30 +14,52 @@
 #include <stdio.h>
 #include <stdint.h>
 
-/* 默认初始容量（必须是2的幂） */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VOX_HTABLE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define VOX_HTABLE_NEON 1
+#endif
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/* 默认初始容量（必须是2的幂，且不小于分组宽度） */
 #define VOX_HTABLE_DEFAULT_INITIAL_CAPACITY 16
-#define VOX_HTABLE_DEFAULT_LOAD_FACTOR 0.75
+#define VOX_HTABLE_DEFAULT_LOAD_FACTOR 0.875
+#define VOX_HTABLE_MAX_LOAD_FACTOR 0.9375
+
+/* 分组宽度：一次比较的控制字节数 */
+#define VOX_HTABLE_GROUP 16
 
-/* 标记：空槽、已删除槽 */
-#define VOX_HTABLE_EMPTY 0
-#define VOX_HTABLE_DELETED 1
-#define VOX_HTABLE_OCCUPIED 2
+/* 内联存放的最大键长度 */
+#define VOX_HTABLE_INLINE_KEY 16
 
-/* 哈希表条目 */
+/* 控制字节：空槽、已删除槽；占用槽为哈希低 7 位（0x00-0x7F） */
+#define VOX_HTABLE_CTRL_EMPTY ((uint8_t)0x80)
+#define VOX_HTABLE_CTRL_DELETED ((uint8_t)0xFE)
+
+/* 槽位 */
 typedef struct {
-    uint8_t status;      /* 状态：EMPTY/DELETED/OCCUPIED */
-    void* key;           /* 键指针 */
-    size_t key_len;      /* 键长度 */
+    uint64_t hash;       /* 完整哈希值 */
     void* value;         /* 值指针 */
-} vox_htable_entry_t;
+    size_t key_len;      /* 键长度 */
+    union {
+        void* ptr;                               /* 外部键（长键或配置了 key_free） */
+        uint8_t inline_key[VOX_HTABLE_INLINE_KEY];  /* 内联键 */
+    } key;
+} vox_htable_slot_t;
 
 /* 哈希表结构 */
 struct vox_htable {
     vox_mpool_t* mpool;           /* 内存池 */
-    vox_htable_entry_t* entries;  /* 条目数组 */
+    uint8_t* ctrl;                /* 控制字节数组（capacity + GROUP，尾部镜像前 GROUP 字节） */
+    vox_htable_slot_t* slots;     /* 槽位数组 */
     size_t capacity;              /* 容量（必须是2的幂） */
     size_t size;                  /* 当前元素数量 */
     size_t deleted_count;         /* 已删除的条目数量 */
+    size_t growth_limit;          /* size + deleted_count 达到该值时扩容或整理 */
     double load_factor_threshold;  /* 负载因子阈值 */
     vox_hash_func_t hash_func;    /* 哈希函数 */
     vox_key_cmp_func_t key_cmp;   /* 键比较函数 */
@@ -136,6 +161,10 @@ static uint64_t default_hash_func(const void* key, size_t key_len) {
     return wyhash(key, key_len, 0);
 }
 
+uint64_t vox_htable_hash(const void* key, size_t key_len) {
+    return wyhash(key, key_len, 0);
+}
+
 /* 默认键比较函数 */
 static int default_key_cmp(const void* key1, const void* key2, size_t key_len) {
     return memcmp(key1, key2, key_len);
@@ -150,127 +179,226 @@ static size_t next_power_of_two(size_t n) {
     n |= n >> 4;
     n |= n >> 8;
     n |= n >> 16;
+#if SIZE_MAX > 0xFFFFFFFFu
     n |= n >> 32;
+#endif
     return n + 1;
 }
 
-/* 计算哈希索引 */
-static inline size_t hash_index(const vox_htable_t* htable, const void* key, size_t key_len) {
-    uint64_t hash = htable->hash_func(key, key_len);
-    return hash & (htable->capacity - 1);  /* capacity是2的幂，所以可以用位运算 */
+/* 对哈希值再做一次混合：自定义哈希函数（如整数恒等哈希）低位分布差时也能均匀分组 */
+static inline uint64_t hash_mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
 }
 
-/* 查找条目（内部函数，前向声明） */
-static vox_htable_entry_t* find_entry(vox_htable_t* htable, const void* key, size_t key_len, bool for_insert);
+static inline uint8_t hash_h2(uint64_t hash) {
+    return (uint8_t)(hash & 0x7F);
+}
 
-/* 检查是否需要扩容 */
-static bool needs_resize(const vox_htable_t* htable) {
-    if (htable->capacity == 0) return false;  /* 防止除零 */
-    size_t total_used = htable->size + htable->deleted_count;
-    double load_factor = (double)total_used / htable->capacity;
-    return load_factor >= htable->load_factor_threshold;
+static inline size_t hash_h1(uint64_t hash) {
+    return (size_t)(hash >> 7);
 }
 
-/* 扩容哈希表 */
-static int vox_htable_resize(vox_htable_t* htable, size_t new_capacity) {
-    if (new_capacity < htable->size) {
-        return -1;  /* 新容量不能小于当前元素数量 */
+/* 最低位 1 的位置 */
+static inline unsigned mask_lowest(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return (unsigned)idx;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+/* ===== 分组匹配：返回 16 位掩码，第 i 位表示组内第 i 个控制字节满足条件 ===== */
+
+#if defined(VOX_HTABLE_SSE2)
+
+static inline uint32_t group_match(const uint8_t* ctrl, uint8_t h2) {
+    __m128i g = _mm_loadu_si128((const __m128i*)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)h2)));
+}
+
+static inline uint32_t group_match_empty(const uint8_t* ctrl) {
+    return group_match(ctrl, VOX_HTABLE_CTRL_EMPTY);
+}
+
+/* 空槽或已删除槽：最高位为 1 */
+static inline uint32_t group_match_free(const uint8_t* ctrl) {
+    __m128i g = _mm_loadu_si128((const __m128i*)ctrl);
+    return (uint32_t)_mm_movemask_epi8(g);
+}
+
+#elif defined(VOX_HTABLE_NEON)
+
+static inline uint32_t neon_movemask(uint8x16_t v) {
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t m = vandq_u8(v, vld1q_u8(bits));
+    return (uint32_t)vaddv_u8(vget_low_u8(m)) | ((uint32_t)vaddv_u8(vget_high_u8(m)) << 8);
+}
+
+static inline uint32_t group_match(const uint8_t* ctrl, uint8_t h2) {
+    return neon_movemask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(h2)));
+}
+
+static inline uint32_t group_match_empty(const uint8_t* ctrl) {
+    return group_match(ctrl, VOX_HTABLE_CTRL_EMPTY);
+}
+
+static inline uint32_t group_match_free(const uint8_t* ctrl) {
+    return neon_movemask(vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl)), vdupq_n_s8(0)));
+}
+
+#else
+
+/* 标量回退 */
+static inline uint32_t group_match(const uint8_t* ctrl, uint8_t h2) {
+    uint32_t mask = 0;
+    for (int i = 0; i < VOX_HTABLE_GROUP; i++) {
+        if (ctrl[i] == h2) mask |= 1u << i;
     }
-    
-    /* 检查容量溢出 */
-    if (new_capacity < htable->capacity) {
-        return -1;  /* 溢出 */
+    return mask;
+}
+
+static inline uint32_t group_match_empty(const uint8_t* ctrl) {
+    return group_match(ctrl, VOX_HTABLE_CTRL_EMPTY);
+}
+
+static inline uint32_t group_match_free(const uint8_t* ctrl) {
+    uint32_t mask = 0;
+    for (int i = 0; i < VOX_HTABLE_GROUP; i++) {
+        if (ctrl[i] & 0x80) mask |= 1u << i;
     }
-    
-    /* 保存旧数据 */
-    vox_htable_entry_t* old_entries = htable->entries;
-    size_t old_capacity = htable->capacity;
-    
-    /* 分配新数组（使用内存池） */
-    htable->entries = (vox_htable_entry_t*)vox_mpool_alloc(htable->mpool, new_capacity * sizeof(vox_htable_entry_t));
-    if (!htable->entries) {
-        htable->entries = old_entries;  /* 恢复 */
-        return -1;
+    return mask;
+}
+
+#endif
+
+/* 写控制字节，同时维护尾部镜像（分组读取可越过末尾） */
+static inline void set_ctrl(vox_htable_t* htable, size_t i, uint8_t v) {
+    htable->ctrl[i] = v;
+    if (i < VOX_HTABLE_GROUP) {
+        htable->ctrl[htable->capacity + i] = v;
     }
-    /* 清零新数组 */
-    memset(htable->entries, 0, new_capacity * sizeof(vox_htable_entry_t));
-    
-    htable->capacity = new_capacity;
-    size_t old_size = htable->size;  /* 保存旧的大小，用于验证 */
-    htable->size = 0;
-    htable->deleted_count = 0;
-    
-    /* 重新插入所有元素（直接插入，不检查扩容，因为新容量已经足够） */
-    for (size_t i = 0; i < old_capacity; i++) {
-        if (old_entries[i].status == VOX_HTABLE_OCCUPIED) {
-            /* 直接查找并插入，跳过扩容检查 */
-            vox_htable_entry_t* entry = find_entry(htable, old_entries[i].key, old_entries[i].key_len, true);
-            if (!entry) {
-                /* 如果找不到插入位置（理论上不应该发生），恢复并返回错误 */
-                vox_mpool_free(htable->mpool, htable->entries);
-                htable->entries = old_entries;
-                htable->capacity = old_capacity;
-                htable->size = old_size;
-                return -1;
-            }
-            entry->status = VOX_HTABLE_OCCUPIED;
-            entry->key = old_entries[i].key;  /* 复用旧键，不需要重新分配 */
-            entry->key_len = old_entries[i].key_len;
-            entry->value = old_entries[i].value;
-            htable->size++;
-        }
+}
+
+static inline const void* slot_key(const vox_htable_t* htable, const vox_htable_slot_t* slot) {
+    if (slot->key_len <= VOX_HTABLE_INLINE_KEY && !htable->key_free) {
+        return slot->key.inline_key;
     }
-    
-    /* 释放旧数组（使用内存池） */
-    vox_mpool_free(htable->mpool, old_entries);
-    
-    return 0;
+    return slot->key.ptr;
 }
 
-/* 查找条目（内部函数） */
-static vox_htable_entry_t* find_entry(vox_htable_t* htable, const void* key, size_t key_len, bool for_insert) {
-    size_t index = hash_index(htable, key, key_len);
-    size_t start_index = index;
-    vox_htable_entry_t* first_deleted = NULL;
-    
-    /* 线性探测 */
-    while (true) {
-        vox_htable_entry_t* entry = &htable->entries[index];
-        
-        if (entry->status == VOX_HTABLE_EMPTY) {
-            /* 找到空槽 */
-            if (for_insert && first_deleted) {
-                /* 如果有已删除的槽，优先使用它 */
-                return first_deleted;
-            }
-            return entry;
+/* 释放槽位持有的键与值 */
+static void slot_release(vox_htable_t* htable, vox_htable_slot_t* slot) {
+    if (slot->key_len > VOX_HTABLE_INLINE_KEY || htable->key_free) {
+        if (htable->key_free) {
+            htable->key_free(slot->key.ptr);
+        } else {
+            vox_mpool_free(htable->mpool, slot->key.ptr);
         }
-        
-        if (entry->status == VOX_HTABLE_DELETED) {
-            /* 记录第一个已删除的槽 */
-            if (!first_deleted) {
-                first_deleted = entry;
-            }
-        } else if (entry->status == VOX_HTABLE_OCCUPIED) {
-            /* 检查键是否匹配 */
-            if (entry->key_len == key_len && 
-                htable->key_cmp(entry->key, key, key_len) == 0) {
-                return entry;
+    }
+    if (htable->value_free && slot->value) {
+        htable->value_free(slot->value);
+    }
+}
+
+static size_t compute_growth_limit(size_t capacity, double load_factor) {
+    size_t limit = (size_t)((double)capacity * load_factor);
+    if (limit >= capacity) limit = capacity - 1;  /* 始终保留空槽，保证探测终止 */
+    return limit;
+}
+
+/* 按三角数步长逐组探测：容量为 2 的幂时可遍历全部分组 */
+static vox_htable_slot_t* find_slot(const vox_htable_t* htable, const void* key, size_t key_len, uint64_t hash) {
+    size_t mask = htable->capacity - 1;
+    size_t pos = hash_h1(hash) & mask;
+    uint8_t h2 = hash_h2(hash);
+    for (size_t step = 0; step <= htable->capacity; step += VOX_HTABLE_GROUP) {
+        const uint8_t* g = htable->ctrl + pos;
+        uint32_t match = group_match(g, h2);
+        while (match) {
+            size_t i = (pos + mask_lowest(match)) & mask;
+            vox_htable_slot_t* slot = &htable->slots[i];
+            if (slot->hash == hash && slot->key_len == key_len &&
+                htable->key_cmp(slot_key(htable, slot), key, key_len) == 0) {
+                return slot;
             }
+            match &= match - 1;
         }
-        
-        /* 继续探测下一个位置 */
-        index = (index + 1) & (htable->capacity - 1);
-        
-        /* 防止无限循环（理论上不应该发生，但为了安全） */
-        if (index == start_index) {
-            break;
+        if (group_match_empty(g)) {
+            return NULL;
         }
+        pos = (pos + step + VOX_HTABLE_GROUP) & mask;
     }
-    
     return NULL;
 }
 
+/* 查找第一个可插入位置（空槽或已删除槽） */
+static size_t find_free(const vox_htable_t* htable, uint64_t hash) {
+    size_t mask = htable->capacity - 1;
+    size_t pos = hash_h1(hash) & mask;
+    for (size_t step = 0;; step += VOX_HTABLE_GROUP) {
+        uint32_t free_mask = group_match_free(htable->ctrl + pos);
+        if (free_mask) {
+            return (pos + mask_lowest(free_mask)) & mask;
+        }
+        pos = (pos + step + VOX_HTABLE_GROUP) & mask;
+    }
+}
+
+/* 分配控制字节与槽位数组 */
+static int alloc_tables(vox_htable_t* htable, size_t capacity) {
+    uint8_t* ctrl = (uint8_t*)vox_mpool_alloc(htable->mpool, capacity + VOX_HTABLE_GROUP);
+    if (!ctrl) return -1;
+    vox_htable_slot_t* slots = (vox_htable_slot_t*)vox_mpool_alloc(htable->mpool, capacity * sizeof(vox_htable_slot_t));
+    if (!slots) {
+        vox_mpool_free(htable->mpool, ctrl);
+        return -1;
+    }
+    memset(ctrl, VOX_HTABLE_CTRL_EMPTY, capacity + VOX_HTABLE_GROUP);
+    htable->ctrl = ctrl;
+    htable->slots = slots;
+    htable->capacity = capacity;
+    htable->growth_limit = compute_growth_limit(capacity, htable->load_factor_threshold);
+    return 0;
+}
+
+/* 重建哈希表：扩容，或在已删除槽过多时按原容量整理 */
+static int vox_htable_resize(vox_htable_t* htable, size_t new_capacity) {
+    if (new_capacity < htable->size || new_capacity < VOX_HTABLE_GROUP) {
+        return -1;
+    }
+
+    uint8_t* old_ctrl = htable->ctrl;
+    vox_htable_slot_t* old_slots = htable->slots;
+    size_t old_capacity = htable->capacity;
+    size_t old_limit = htable->growth_limit;
+
+    if (alloc_tables(htable, new_capacity) != 0) {
+        htable->ctrl = old_ctrl;
+        htable->slots = old_slots;
+        htable->capacity = old_capacity;
+        htable->growth_limit = old_limit;
+        return -1;
+    }
+
+    /* 重新插入所有元素：保存了完整哈希，无需重新计算或比较键 */
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_ctrl[i] & 0x80) continue;
+        size_t idx = find_free(htable, old_slots[i].hash);
+        set_ctrl(htable, idx, hash_h2(old_slots[i].hash));
+        htable->slots[idx] = old_slots[i];
+    }
+    htable->deleted_count = 0;
+
+    vox_mpool_free(htable->mpool, old_ctrl);
+    vox_mpool_free(htable->mpool, old_slots);
+    return 0;
+}
+
 /* 创建哈希表 */
 vox_htable_t* vox_htable_create(vox_mpool_t* mpool) {
     return vox_htable_create_with_config(mpool, NULL);
@@ -319,8 +447,13 @@ vox_htable_t* vox_htable_create_with_config(vox_mpool_t* mpool, const vox_htable
             value_free = config->value_free;
         }
     }
+    if (initial_capacity < VOX_HTABLE_GROUP) {
+        initial_capacity = VOX_HTABLE_GROUP;
+    }
+    if (load_factor > VOX_HTABLE_MAX_LOAD_FACTOR) {
+        load_factor = VOX_HTABLE_MAX_LOAD_FACTOR;
+    }
     
-    htable->capacity = initial_capacity;
     htable->size = 0;
     htable->deleted_count = 0;
     htable->load_factor_threshold = load_factor;
@@ -329,14 +462,10 @@ vox_htable_t* vox_htable_create_with_config(vox_mpool_t* mpool, const vox_htable
     htable->key_free = key_free;
     htable->value_free = value_free;
     
-    /* 分配条目数组（使用内存池） */
-    htable->entries = (vox_htable_entry_t*)vox_mpool_alloc(htable->mpool, htable->capacity * sizeof(vox_htable_entry_t));
-    if (!htable->entries) {
+    if (alloc_tables(htable, initial_capacity) != 0) {
         vox_mpool_free(htable->mpool, htable);
         return NULL;
     }
-    /* 清零数组 */
-    memset(htable->entries, 0, htable->capacity * sizeof(vox_htable_entry_t));
     
     return htable;
 }
@@ -345,54 +474,57 @@ vox_htable_t* vox_htable_create_with_config(vox_mpool_t* mpool, const vox_htable
 int vox_htable_set(vox_htable_t* htable, const void* key, size_t key_len, void* value) {
     if (!htable || !key || key_len == 0) return -1;
     
-    /* 检查是否需要扩容 */
-    if (needs_resize(htable)) {
-        size_t new_capacity = htable->capacity * 2;
-        if (vox_htable_resize(htable, new_capacity) != 0) {
-            return -1;
-        }
-    }
-    
-    /* 查找条目 */
-    vox_htable_entry_t* entry = find_entry(htable, key, key_len, true);
-    if (!entry) {
-        return -1;  /* 不应该发生 */
-    }
+    uint64_t hash = hash_mix(htable->hash_func(key, key_len));
+    vox_htable_slot_t* slot = find_slot(htable, key, key_len, hash);
     
     /* 如果是更新现有值 */
-    if (entry->status == VOX_HTABLE_OCCUPIED) {
+    if (slot) {
         /* 释放旧值（如果配置了释放函数） */
-        if (htable->value_free && entry->value) {
-            htable->value_free(entry->value);
+        if (htable->value_free && slot->value && slot->value != value) {
+            htable->value_free(slot->value);
         }
-        entry->value = value;
+        slot->value = value;
         return 0;
     }
     
-    /* 如果是新插入 */
-    /* 如果使用的是已删除的槽，减少deleted_count */
-    if (entry->status == VOX_HTABLE_DELETED) {
-        /* 释放旧键（如果配置了释放函数） */
-        if (htable->key_free && entry->key) {
-            htable->key_free(entry->key);
+    /* 新插入：占用槽数达到上限时扩容；已删除槽占多数时按原容量整理 */
+    if (htable->size + htable->deleted_count >= htable->growth_limit) {
+        size_t new_capacity = htable->capacity;
+        if (htable->size + 1 > htable->growth_limit / 2) {
+            new_capacity *= 2;
+            if (new_capacity < htable->capacity) {
+                return -1;  /* 溢出 */
+            }
         }
-        if (htable->value_free && entry->value) {
-            htable->value_free(entry->value);
+        if (vox_htable_resize(htable, new_capacity) != 0) {
+            return -1;
         }
-        htable->deleted_count--;
     }
     
-    /* 分配并复制键（使用内存池） */
-    void* key_copy = vox_mpool_alloc(htable->mpool, key_len);
-    if (!key_copy) {
-        return -1;
+    /* 复制键：短键内联，长键（或由 key_free 管理的键）使用内存池分配 */
+    void* key_copy = NULL;
+    if (key_len > VOX_HTABLE_INLINE_KEY || htable->key_free) {
+        key_copy = vox_mpool_alloc(htable->mpool, key_len);
+        if (!key_copy) {
+            return -1;
+        }
+        memcpy(key_copy, key, key_len);
     }
-    memcpy(key_copy, key, key_len);
     
-    entry->status = VOX_HTABLE_OCCUPIED;
-    entry->key = key_copy;
-    entry->key_len = key_len;
-    entry->value = value;
+    size_t idx = find_free(htable, hash);
+    if (htable->ctrl[idx] == VOX_HTABLE_CTRL_DELETED) {
+        htable->deleted_count--;
+    }
+    set_ctrl(htable, idx, hash_h2(hash));
+    slot = &htable->slots[idx];
+    slot->hash = hash;
+    slot->key_len = key_len;
+    if (key_copy) {
+        slot->key.ptr = key_copy;
+    } else {
+        memcpy(slot->key.inline_key, key, key_len);
+    }
+    slot->value = value;
     htable->size++;
     
     return 0;
@@ -402,35 +534,25 @@ int vox_htable_set(vox_htable_t* htable, const void* key, size_t key_len, void*
 void* vox_htable_get(const vox_htable_t* htable, const void* key, size_t key_len) {
     if (!htable || !key || key_len == 0) return NULL;
     
-    vox_htable_entry_t* entry = find_entry((vox_htable_t*)htable, key, key_len, false);
-    if (entry && entry->status == VOX_HTABLE_OCCUPIED) {
-        return entry->value;
-    }
-    
-    return NULL;
+    uint64_t hash = hash_mix(htable->hash_func(key, key_len));
+    vox_htable_slot_t* slot = find_slot(htable, key, key_len, hash);
+    return slot ? slot->value : NULL;
 }
 
 /* 删除键值对 */
 int vox_htable_delete(vox_htable_t* htable, const void* key, size_t key_len) {
     if (!htable || !key || key_len == 0) return -1;
     
-    vox_htable_entry_t* entry = find_entry(htable, key, key_len, false);
-    if (!entry || entry->status != VOX_HTABLE_OCCUPIED) {
+    uint64_t hash = hash_mix(htable->hash_func(key, key_len));
+    vox_htable_slot_t* slot = find_slot(htable, key, key_len, hash);
+    if (!slot) {
         return -1;  /* 不存在 */
     }
     
     /* 释放键和值 */
-    if (htable->key_free && entry->key) {
-        htable->key_free(entry->key);
-    }
-    if (htable->value_free && entry->value) {
-        htable->value_free(entry->value);
-    }
+    slot_release(htable, slot);
     
-    entry->status = VOX_HTABLE_DELETED;
-    entry->key = NULL;
-    entry->key_len = 0;
-    entry->value = NULL;
+    set_ctrl(htable, (size_t)(slot - htable->slots), VOX_HTABLE_CTRL_DELETED);
     htable->size--;
     htable->deleted_count++;
     
@@ -439,7 +561,9 @@ int vox_htable_delete(vox_htable_t* htable, const void* key, size_t key_len) {
 
 /* 检查键是否存在 */
 bool vox_htable_contains(const vox_htable_t* htable, const void* key, size_t key_len) {
-    return vox_htable_get(htable, key, key_len) != NULL;
+    if (!htable || !key || key_len == 0) return false;
+    uint64_t hash = hash_mix(htable->hash_func(key, key_len));
+    return find_slot(htable, key, key_len, hash) != NULL;
 }
 
 /* 获取元素数量 */
@@ -457,25 +581,11 @@ void vox_htable_clear(vox_htable_t* htable) {
     if (!htable) return;
     
     for (size_t i = 0; i < htable->capacity; i++) {
-        vox_htable_entry_t* entry = &htable->entries[i];
-        if (entry->status == VOX_HTABLE_OCCUPIED) {
-            if (htable->key_free && entry->key) {
-                htable->key_free(entry->key);
-            }
-            if (htable->value_free && entry->value) {
-                htable->value_free(entry->value);
-            }
-            entry->status = VOX_HTABLE_EMPTY;
-            entry->key = NULL;
-            entry->key_len = 0;
-            entry->value = NULL;
-        } else if (entry->status == VOX_HTABLE_DELETED) {
-            entry->status = VOX_HTABLE_EMPTY;
-            entry->key = NULL;
-            entry->key_len = 0;
-            entry->value = NULL;
+        if (!(htable->ctrl[i] & 0x80)) {
+            slot_release(htable, &htable->slots[i]);
         }
     }
+    memset(htable->ctrl, VOX_HTABLE_CTRL_EMPTY, htable->capacity + VOX_HTABLE_GROUP);
     
     htable->size = 0;
     htable->deleted_count = 0;
@@ -485,24 +595,19 @@ void vox_htable_clear(vox_htable_t* htable) {
 void vox_htable_destroy(vox_htable_t* htable) {
     if (!htable) return;
     
-    /* 清空所有条目 */
+    /* 释放所有条目 */
     for (size_t i = 0; i < htable->capacity; i++) {
-        vox_htable_entry_t* entry = &htable->entries[i];
-        if (entry->status == VOX_HTABLE_OCCUPIED || entry->status == VOX_HTABLE_DELETED) {
-            if (htable->key_free && entry->key) {
-                htable->key_free(entry->key);
-            }
-            if (htable->value_free && entry->value) {
-                htable->value_free(entry->value);
-            }
+        if (!(htable->ctrl[i] & 0x80)) {
+            slot_release(htable, &htable->slots[i]);
         }
     }
     
     /* 保存内存池指针 */
     vox_mpool_t* mpool = htable->mpool;
     
-    /* 释放条目数组（使用内存池） */
-    vox_mpool_free(mpool, htable->entries);
+    /* 释放控制字节与槽位数组（使用内存池） */
+    vox_mpool_free(mpool, htable->ctrl);
+    vox_mpool_free(mpool, htable->slots);
     
     /* 释放哈希表结构（使用内存池） */
     vox_mpool_free(mpool, htable);
@@ -516,9 +621,9 @@ size_t vox_htable_foreach(vox_htable_t* htable,
     
     size_t count = 0;
     for (size_t i = 0; i < htable->capacity; i++) {
-        vox_htable_entry_t* entry = &htable->entries[i];
-        if (entry->status == VOX_HTABLE_OCCUPIED) {
-            callback(entry->key, entry->key_len, entry->value, user_data);
+        if (!(htable->ctrl[i] & 0x80)) {
+            vox_htable_slot_t* slot = &htable->slots[i];
+            callback(slot_key(htable, slot), slot->key_len, slot->value, user_data);
             count++;
         }
     }
@@ -1,6 +1,6 @@
 /*
  * vox_htable.h - 高性能哈希表
- * 使用 wyhash 哈希函数，支持开放寻址法
+ * 使用 wyhash 哈希函数，开放寻址（Swiss table 布局：SSE2/NEON 分组比较控制字节、保存完整哈希、短键内联）
  */
 
 #ifndef VOX_HTABLE_H
@@ -25,13 +25,21 @@ typedef uint64_t (*vox_hash_func_t)(const void* key, size_t key_len);
 /* 哈希表配置 */
 typedef struct {
     size_t initial_capacity;        /* 初始容量，0表示使用默认值 */
-    double load_factor;              /* 负载因子阈值（0.0-1.0），0表示使用默认值0.75 */
+    double load_factor;              /* 负载因子阈值（0.0-1.0，上限按 0.9375 处理），0表示使用默认值0.875 */
     vox_hash_func_t hash_func;      /* 自定义哈希函数，NULL表示使用默认wyhash */
     vox_key_cmp_func_t key_cmp;     /* 键比较函数，NULL表示使用memcmp */
     vox_key_free_func_t key_free;   /* 键释放函数，NULL表示不释放 */
     vox_value_free_func_t value_free; /* 值释放函数，NULL表示不释放 */
 } vox_htable_config_t;
 
+/**
+ * 默认哈希函数（wyhash，种子为0），供需要相同哈希的其他容器复用
+ * @param key 键指针
+ * @param key_len 键长度（字节）
+ * @return 64位哈希值
+ */
+uint64_t vox_htable_hash(const void* key, size_t key_len);
+
 /**
  * 使用默认配置创建哈希表
  * @param mpool 内存池指针，必须非NULL
@@ -7,7 +7,7 @@
 #include "vox_kqueue.h"
 #include "vox_backend.h"
 #include "vox_mpool.h"
-#include "vox_htable.h"
+#include "vox_fdtable.h"
 #include "vox_log.h"
 #include <sys/event.h>
 #include <sys/time.h>
@@ -33,7 +33,7 @@ struct vox_kqueue {
     int wakeup_fd[2];                 /* 用于唤醒的管道 [0]=read, [1]=write */
     size_t max_events;                /* 每次 kevent 的最大事件数 */
     struct kevent* events;            /* 事件数组 */
-    vox_htable_t* fd_map;             /* fd -> fd_info 映射 */
+    vox_fdtable_t* fd_map;            /* fd -> fd_info 映射 */
     vox_mpool_t* mpool;               /* 内存池 */
     bool own_mpool;                   /* 是否拥有内存池 */
     bool initialized;                 /* 是否已初始化 */
@@ -78,7 +78,7 @@ vox_kqueue_t* vox_kqueue_create(const vox_kqueue_config_t* config) {
     }
     
     /* 创建 fd 映射表 */
-    kq->fd_map = vox_htable_create(kq->mpool);
+    kq->fd_map = vox_fdtable_create(kq->mpool);
     if (!kq->fd_map) {
         VOX_LOG_ERROR("Failed to create fd map for kqueue");
         vox_mpool_free(kq->mpool, kq);
@@ -95,7 +95,7 @@ vox_kqueue_t* vox_kqueue_create(const vox_kqueue_config_t* config) {
     );
     if (!kq->events) {
         VOX_LOG_ERROR("Failed to allocate events array for kqueue");
-        vox_htable_destroy(kq->fd_map);
+        vox_fdtable_destroy(kq->fd_map);
         vox_mpool_free(kq->mpool, kq);
         if (own_mpool) {
             vox_mpool_destroy(mpool);
@@ -193,7 +193,7 @@ void vox_kqueue_destroy(vox_kqueue_t* kq) {
     }
     
     if (kq->fd_map) {
-        vox_htable_destroy(kq->fd_map);
+        vox_fdtable_destroy(kq->fd_map);
     }
     
     /* 从内存池释放 kqueue 结构 */
@@ -272,9 +272,8 @@ int vox_kqueue_add(vox_kqueue_t* kq, int fd, uint32_t events, void* user_data) {
     }
     
     /* 添加到映射表（用于 modify/remove 操作） */
-    int key = fd;
-    if (vox_htable_set(kq->fd_map, &key, sizeof(key), info) != 0) {
-        /* 哈希表添加失败，回滚 kqueue 添加 */
+    if (vox_fdtable_set(kq->fd_map, fd, info) != 0) {
+        /* 映射表添加失败，回滚 kqueue 添加 */
         VOX_LOG_ERROR("Failed to add fd %d to kqueue fd map", fd);
         struct kevent del_evs[2];
         EV_SET(&del_evs[0], fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
@@ -293,13 +292,8 @@ int vox_kqueue_modify(vox_kqueue_t* kq, int fd, uint32_t events) {
         return -1;
     }
     
-    /* 查找 fd 信息 - 仍然需要哈希表查找（因为需要更新） */
-    int key = fd;
-    vox_kqueue_fd_info_t* info = (vox_kqueue_fd_info_t*)vox_htable_get(
-        kq->fd_map, 
-        &key, 
-        sizeof(key)
-    );
+    /* 查找 fd 信息（按 fd 下标直接寻址） */
+    vox_kqueue_fd_info_t* info = (vox_kqueue_fd_info_t*)vox_fdtable_get(kq->fd_map, fd);
     if (!info) {
         return -1;  /* 不存在 */
     }
@@ -342,14 +336,8 @@ int vox_kqueue_remove(vox_kqueue_t* kq, int fd) {
     kevent(kq->kqueue_fd, evs, 2, NULL, 0, NULL);
     
     /* 从映射表移除并释放内存 */
-    int key = fd;
-    vox_kqueue_fd_info_t* info = (vox_kqueue_fd_info_t*)vox_htable_get(
-        kq->fd_map, 
-        &key, 
-        sizeof(key)
-    );
+    vox_kqueue_fd_info_t* info = (vox_kqueue_fd_info_t*)vox_fdtable_remove(kq->fd_map, fd);
     if (info) {
-        vox_htable_delete(kq->fd_map, &key, sizeof(key));
         vox_mpool_free(kq->mpool, info);
     }
     
@@ -6,6 +6,7 @@
 #include "vox_backend.h"
 #include "vox_handle.h"
 #include "vox_tpool.h"
+#include "vox_timer.h"
 #include "vox_os.h"
 #include "vox_log.h"
 #include <string.h>
@@ -22,17 +23,23 @@ void vox_udp_backend_event_cb(vox_backend_t* backend, int fd, uint32_t events, v
 }
 #endif
 
-/* 回调工作项 */
-typedef struct vox_work_item {
-    vox_loop_cb callback;
-    void* user_data;
-} vox_work_item_t;
+/* 工作项标志：由 vox_loop_queue_work 从内存池分配，回调后由 loop 释放 */
+#define VOX_LOOP_WORK_OWNED 0x1u
 
 /* 前向声明 */
 static int calculate_poll_timeout(vox_loop_t* loop);
 extern void vox_timer_process_expired(vox_loop_t* loop);
 extern int vox_timer_get_next_timeout(vox_loop_t* loop);
 
+/* 非套接字 fd 的可读监听：backend 内部数据即本结构，前两个成员与 TCP/UDP 内部数据布局一致 */
+struct vox_loop_fd_watch {
+    void* handle_ptr;                 /* 指向 handle */
+    void* user_data;
+    vox_handle_t handle;              /* 只设置 type/loop 供事件分发识别，不计入活跃句柄 */
+    vox_loop_fd_cb cb;                /* NULL 表示已取消监听 */
+    int fd;
+};
+
 /* 事件回调函数（用于 backend poll） */
 static void handle_backend_event(vox_backend_t* backend, int fd,
                                  uint32_t events, void* user_data,
@@ -75,6 +82,10 @@ static void handle_backend_event(vox_backend_t* backend, int fd,
             /* 调用 UDP 的事件回调 */
             vox_udp_backend_event_cb(backend, fd, events, user_data, overlapped, bytes_transferred);
             return;
+        } else if (handle && handle->type == VOX_HANDLE_POLL) {
+            vox_loop_fd_watch_t* watch = (vox_loop_fd_watch_t*)user_data;
+            if (watch->cb) watch->cb(handle->loop, watch->fd, watch->user_data);
+            return;
         }
     }
 
@@ -92,7 +103,16 @@ struct vox_loop {
     
     /* 事件队列 */
     vox_queue_t* pending_events;     /* 待处理事件 */
-    vox_queue_t* pending_callbacks;  /* 待执行回调 */
+
+    /* 待执行回调：Vyukov 无界侵入式 MPSC 队列
+     * 生产者只交换 work_head（与消费者端分开放置，避免伪共享），消费者独占 work_tail */
+    vox_loop_work_t* work_tail;
+    vox_loop_work_t work_stub;
+    char work_pad[VOX_CACHE_LINE_SIZE];
+    vox_atomic_ptr_t work_head;
+    /* 1 表示 loop 正在处理（或已有未消费的唤醒），提交方无需再唤醒 backend */
+    vox_atomic_int_t wakeup_pending;
+    char wakeup_pad[VOX_CACHE_LINE_SIZE];
     
     /* 定时器管理（最小堆） */
     vox_mheap_t* timers;
@@ -105,22 +125,33 @@ struct vox_loop {
     
     /* 线程池（用于阻塞操作） */
     void* thread_pool;  /* vox_tpool_t*，暂时用void*避免循环依赖 */
+
+    /* 上层模块扩展数据 */
+    struct {
+        const void* key;
+        void* data;
+        vox_loop_ext_cleanup_cb cleanup;
+    } ext[VOX_LOOP_MAX_EXT];
+    size_t ext_count;
     
     /* 状态 */
     bool stop_flag;
     bool running;
     uint64_t loop_time;              /* 当前循环时间（微秒） */
     size_t active_handles_count;
+    size_t weak_timers;              /* 定时器堆中的弱定时器数量，不阻止 loop 退出 */
     size_t ref_count;                /* 引用计数：协程 await 等未完成时 >0，防止 loop 提前退出 */
 };
 
-/* 定时器比较函数（用于最小堆） */
+/* 定时器堆中是否有会阻止 loop 退出的（非弱）定时器 */
+static bool loop_has_strong_timers(vox_loop_t* loop) {
+    return loop->timers && vox_mheap_size(loop->timers) > loop->weak_timers;
+}
+
+/* 定时器比较函数（用于最小堆）：按到期时间排序 */
 static int timer_cmp(const void* a, const void* b) {
-    /* 实际实现在 vox_timer.c 中 */
-    /* 这里提供一个默认实现，但应该使用 vox_timer.c 中的版本 */
-    typedef struct { uint64_t timeout; } timer_struct_t;
-    const timer_struct_t* timer_a = (const timer_struct_t*)a;
-    const timer_struct_t* timer_b = (const timer_struct_t*)b;
+    const vox_timer_t* timer_a = (const vox_timer_t*)a;
+    const vox_timer_t* timer_b = (const vox_timer_t*)b;
     
     if (timer_a->timeout < timer_b->timeout) return -1;
     if (timer_a->timeout > timer_b->timeout) return 1;
@@ -196,23 +227,11 @@ vox_loop_t* vox_loop_create_with_config(const vox_loop_config_t* config) {
         goto error;
     }
     
-    /* 待执行回调使用 MPSC 队列，确保其他线程可以安全提交任务 */
-    vox_queue_config_t callback_queue_config = {
-        .type = VOX_QUEUE_TYPE_MPSC,
-        .initial_capacity = 4096,  /* 初始容量调大以支持高并发 */
-        .elem_free = NULL
-    };
-    
-    if (config && config->pending_callbacks_config) {
-        /* 使用配置中的回调队列配置，但确保类型是 MPSC */
-        callback_queue_config = *config->pending_callbacks_config;
-        callback_queue_config.type = VOX_QUEUE_TYPE_MPSC;  /* 强制 MPSC 类型 */
-    }
-    
-    loop->pending_callbacks = vox_queue_create_with_config(pool, &callback_queue_config);
-    if (!loop->pending_callbacks) {
-        goto error;
-    }
+    /* 待执行回调队列：初始只含哨兵节点 */
+    vox_atomic_ptr_init(&loop->work_stub.next, NULL);
+    vox_atomic_ptr_init(&loop->work_head, &loop->work_stub);
+    loop->work_tail = &loop->work_stub;
+    vox_atomic_int_init(&loop->wakeup_pending, 0);
     
     /* 创建定时器堆 */
     vox_mheap_config_t timer_config = {
@@ -282,9 +301,6 @@ error:
     if (loop->pending_events) {
         vox_queue_destroy(loop->pending_events);
     }
-    if (loop->pending_callbacks) {
-        vox_queue_destroy(loop->pending_callbacks);
-    }
     if (loop->timers) {
         vox_mheap_destroy(loop->timers);
     }
@@ -295,6 +311,48 @@ error:
     return NULL;
 }
 
+/* 入队（多生产者）：交换 head 后再链接前驱，两步之间消费者会看到“未完成”状态并稍后重试 */
+static void work_queue_push(vox_loop_t* loop, vox_loop_work_t* work) {
+    vox_atomic_ptr_init(&work->next, NULL);
+    vox_loop_work_t* prev = (vox_loop_work_t*)vox_atomic_ptr_exchange(&loop->work_head, work);
+    vox_atomic_ptr_store(&prev->next, work);
+}
+
+/* 出队（仅 loop 线程）：队列为空或生产者尚未完成链接时返回 NULL */
+static vox_loop_work_t* work_queue_pop(vox_loop_t* loop) {
+    vox_loop_work_t* tail = loop->work_tail;
+    vox_loop_work_t* next = (vox_loop_work_t*)vox_atomic_ptr_load(&tail->next);
+    if (tail == &loop->work_stub) {
+        if (!next) {
+            return NULL;
+        }
+        loop->work_tail = next;
+        tail = next;
+        next = (vox_loop_work_t*)vox_atomic_ptr_load(&tail->next);
+    }
+    if (next) {
+        loop->work_tail = next;
+        return tail;
+    }
+    if (tail != vox_atomic_ptr_load(&loop->work_head)) {
+        return NULL;
+    }
+    /* tail 是最后一个节点：重新放入哨兵，使 tail 可以安全出队 */
+    work_queue_push(loop, &loop->work_stub);
+    next = (vox_loop_work_t*)vox_atomic_ptr_load(&tail->next);
+    if (next) {
+        loop->work_tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+/* 是否有已提交（含正在链接中）的回调 */
+static bool work_queue_empty(vox_loop_t* loop) {
+    vox_loop_work_t* tail = loop->work_tail;
+    return tail == vox_atomic_ptr_load(&loop->work_head) && vox_atomic_ptr_load(&tail->next) == NULL;
+}
+
 /* 运行事件循环 */
 int vox_loop_run(vox_loop_t* loop, vox_run_mode_t mode) {
     if (!loop) {
@@ -321,15 +379,19 @@ int vox_loop_run(vox_loop_t* loop, vox_run_mode_t mode) {
         #define VOX_LOOP_MAX_CALLBACKS_PER_ITERATION 8192  /* 调大默认值以支持高并发 */
         #endif
         int callback_count = 0;
-        while (!vox_queue_empty(loop->pending_callbacks) && 
-               callback_count < VOX_LOOP_MAX_CALLBACKS_PER_ITERATION) {
-            vox_work_item_t* item = (vox_work_item_t*)vox_queue_dequeue(loop->pending_callbacks);
-            if (item) {
-                if (item->callback) {
-                    item->callback(loop, item->user_data);
-                }
-                /* 处理完后释放工作项内存 */
-                vox_mpool_free(loop->mpool, item);
+        while (callback_count < VOX_LOOP_MAX_CALLBACKS_PER_ITERATION) {
+            vox_loop_work_t* work = work_queue_pop(loop);
+            if (!work) {
+                break;
+            }
+            /* 回调可能释放或重新入队工作项，先取出字段 */
+            vox_loop_cb cb = work->cb;
+            void* user_data = work->user_data;
+            if (work->flags & VOX_LOOP_WORK_OWNED) {
+                vox_mpool_free(loop->mpool, work);
+            }
+            if (cb) {
+                cb(loop, user_data);
             }
             callback_count++;
         }
@@ -342,14 +404,22 @@ int vox_loop_run(vox_loop_t* loop, vox_run_mode_t mode) {
             timeout = 0;
         } else if (mode == VOX_RUN_ONCE) {
             /* ONCE 模式：如果没有待处理的回调和定时器，使用非阻塞模式 */
-            if (vox_queue_empty(loop->pending_callbacks)) {
-                vox_mheap_t* timers = vox_loop_get_timers(loop);
-                if (timers == NULL || vox_mheap_empty(timers)) {
+            if (work_queue_empty(loop)) {
+                if (!loop_has_strong_timers(loop)) {
                     timeout = 0;  /* 非阻塞，立即返回 */
                 }
             }
         }
         
+        /* 即将阻塞：清除唤醒标志，此后的提交会唤醒 backend；
+         * 清除后再检查一次队列，覆盖清除之前已入队但未唤醒的提交 */
+        if (timeout != 0) {
+            vox_atomic_int_store(&loop->wakeup_pending, 0);
+            if (!work_queue_empty(loop)) {
+                timeout = 0;
+            }
+        }
+
         /* 使用 backend 进行 poll */
         if (loop->backend) {
             vox_backend_poll(loop->backend, timeout, handle_backend_event);
@@ -362,26 +432,27 @@ int vox_loop_run(vox_loop_t* loop, vox_run_mode_t mode) {
             }
         }
         
+        /* loop 重新进入处理阶段，期间的提交无需唤醒 */
+        vox_atomic_int_store(&loop->wakeup_pending, 1);
+
         /* poll 返回后若已请求停止则立即退出（回调中调用了 vox_loop_stop 时） */
         if (loop->stop_flag) {
             break;
         }
         
+        /* 处理关闭的句柄（一次性运行也要处理，否则关闭回调永不执行） */
+        vox_handle_process_closing(loop);
+
         /* 如果是一次性运行，退出 */
         if (mode == VOX_RUN_ONCE || mode == VOX_RUN_NOWAIT) {
             break;
         }
-        
-        /* 处理关闭的句柄 */
-        vox_handle_process_closing(loop);
-
-        /* 如果没有活跃句柄、无待处理回调、无定时器且无引用（如协程在 await），则退出 */
-        vox_mheap_t* timers = vox_loop_get_timers(loop);
 
+        /* 如果没有活跃句柄、无待处理回调、无（非弱）定时器且无引用（如协程在 await），则退出 */
         if (loop->active_handles_count == 0 && 
             loop->ref_count == 0 &&
-            vox_queue_empty(loop->pending_callbacks) &&
-            (timers == NULL || vox_mheap_empty(timers))) {
+            work_queue_empty(loop) &&
+            !loop_has_strong_timers(loop)) {
             break;
         }
     }
@@ -397,7 +468,7 @@ static int calculate_poll_timeout(vox_loop_t* loop) {
     }
     
     /* 1. 如果有待执行的回调，立即返回（不等待） */
-    if (!vox_queue_empty(loop->pending_callbacks)) {
+    if (!work_queue_empty(loop)) {
         return 0;
     }
     
@@ -406,7 +477,13 @@ static int calculate_poll_timeout(vox_loop_t* loop) {
         return 0;
     }
     
-    /* 3. 获取下一个定时器的到期时间 */
+    /* 3. 只剩弱定时器时循环即将退出，不为其到期时间阻塞 */
+    if (loop->active_handles_count == 0 && loop->ref_count == 0 &&
+        !loop_has_strong_timers(loop)) {
+        return 0;
+    }
+    
+    /* 4. 获取下一个定时器的到期时间 */
     int timer_timeout = vox_timer_get_next_timeout(loop);
     if (timer_timeout < 0) {
         /* 没有定时器，如果没有活跃句柄，应该立即返回 */
@@ -484,6 +561,14 @@ void vox_loop_destroy(vox_loop_t* loop) {
         vox_loop_stop(loop);
     }
     
+    /* 扩展数据（如 DNS 解析缓存）可能持有句柄与定时器，需在 backend 销毁前清理 */
+    while (loop->ext_count > 0) {
+        loop->ext_count--;
+        if (loop->ext[loop->ext_count].cleanup) {
+            loop->ext[loop->ext_count].cleanup(loop, loop->ext[loop->ext_count].data);
+        }
+    }
+    
     /* 清理平台抽象层 backend */
     if (loop->backend) {
         vox_backend_destroy(loop->backend);
@@ -496,9 +581,12 @@ void vox_loop_destroy(vox_loop_t* loop) {
         vox_queue_destroy(loop->pending_events);
         loop->pending_events = NULL;
     }
-    if (loop->pending_callbacks) {
-        vox_queue_destroy(loop->pending_callbacks);
-        loop->pending_callbacks = NULL;
+    /* 释放未执行的内部分配工作项（调用方提供的工作项由调用方管理） */
+    vox_loop_work_t* work;
+    while ((work = work_queue_pop(loop)) != NULL) {
+        if (work->flags & VOX_LOOP_WORK_OWNED) {
+            vox_mpool_free(loop->mpool, work);
+        }
     }
     
     /* 销毁线程池（使用独立 mpool，其大块释放顺序与 loop 的队列无关） */
@@ -530,24 +618,36 @@ int vox_loop_queue_work(vox_loop_t* loop, vox_loop_cb cb, void* user_data) {
         return -1;
     }
     
-    vox_work_item_t* item = (vox_work_item_t*)vox_mpool_alloc(loop->mpool, sizeof(vox_work_item_t));
-    if (!item) {
+    vox_loop_work_t* work = (vox_loop_work_t*)vox_mpool_alloc(loop->mpool, sizeof(vox_loop_work_t));
+    if (!work) {
         return -1;
     }
-    
-    item->callback = cb;
-    item->user_data = user_data;
-    
-    if (vox_queue_enqueue(loop->pending_callbacks, item) != 0) {
-        vox_mpool_free(loop->mpool, item);
+    work->cb = cb;
+    work->user_data = user_data;
+    work->flags = VOX_LOOP_WORK_OWNED;
+    work_queue_push(loop, work);
+
+    /* 唤醒 backend 以便立即处理新任务（类似 libuv 的 uv_async_send），已有未消费的唤醒时合并 */
+    if (vox_atomic_int_exchange(&loop->wakeup_pending, 1) == 0 && loop->backend) {
+        vox_backend_wakeup(loop->backend);
+    }
+    return 0;
+}
+
+/* 使用调用方提供的工作项入队 */
+int vox_loop_queue_work_node(vox_loop_t* loop, vox_loop_work_t* work, vox_loop_cb cb, void* user_data) {
+    if (!loop || !work || !cb) {
         return -1;
     }
-    
-    /* 唤醒 backend 以便立即处理新任务（类似 libuv 的 uv_async_send） */
-    if (loop->backend) {
+
+    work->cb = cb;
+    work->user_data = user_data;
+    work->flags = 0;
+    work_queue_push(loop, work);
+
+    if (vox_atomic_int_exchange(&loop->wakeup_pending, 1) == 0 && loop->backend) {
         vox_backend_wakeup(loop->backend);
     }
-    
     return 0;
 }
 
@@ -590,12 +690,104 @@ void vox_loop_decrement_active_handles(vox_loop_t* loop) {
     }
 }
 
+/* 调整弱定时器数量（内部使用） */
+void vox_loop_adjust_weak_timers(vox_loop_t* loop, int delta) {
+    if (!loop) return;
+    if (delta >= 0) {
+        loop->weak_timers += (size_t)delta;
+    } else if (loop->weak_timers >= (size_t)-delta) {
+        loop->weak_timers -= (size_t)-delta;
+    } else {
+        loop->weak_timers = 0;
+    }
+}
+
 /* 获取 backend（内部使用） */
 vox_backend_t* vox_loop_get_backend(vox_loop_t* loop) {
     return loop ? loop->backend : NULL;
 }
 
+vox_loop_fd_watch_t* vox_loop_watch_fd(vox_loop_t* loop, int fd, vox_loop_fd_cb cb, void* user_data) {
+    if (!loop || !loop->backend || fd < 0 || !cb) return NULL;
+    /* IOCP 只能投递套接字的完成事件 */
+    if (vox_backend_get_type(loop->backend) == VOX_BACKEND_TYPE_IOCP) return NULL;
+    vox_loop_fd_watch_t* watch = (vox_loop_fd_watch_t*)vox_mpool_alloc(loop->mpool, sizeof(*watch));
+    if (!watch) return NULL;
+    memset(watch, 0, sizeof(*watch));
+    watch->handle_ptr = &watch->handle;
+    watch->user_data = user_data;
+    watch->handle.type = VOX_HANDLE_POLL;
+    watch->handle.loop = loop;
+    watch->cb = cb;
+    watch->fd = fd;
+    if (vox_backend_add(loop->backend, fd, VOX_BACKEND_READ, watch) != 0) {
+        vox_mpool_free(loop->mpool, watch);
+        return NULL;
+    }
+    return watch;
+}
+
+static void loop_fd_watch_free(vox_loop_t* loop, void* user_data) {
+    vox_mpool_free(loop->mpool, user_data);
+}
+
+void vox_loop_unwatch_fd(vox_loop_fd_watch_t* watch) {
+    if (!watch || !watch->cb) return;
+    vox_loop_t* loop = watch->handle.loop;
+    vox_backend_remove(loop->backend, watch->fd);
+    watch->cb = NULL;
+    /* 本轮 poll 返回的事件可能还引用它，推迟到下一轮处理回调时释放 */
+    if (vox_loop_queue_work(loop, loop_fd_watch_free, watch) != 0) {
+        VOX_LOG_ERROR("Failed to defer fd watch release");
+    }
+}
+
 /* 获取线程池（内部使用） */
 vox_tpool_t* vox_loop_get_thread_pool(vox_loop_t* loop) {
     return loop ? (vox_tpool_t*)loop->thread_pool : NULL;
 }
+
+/* 获取扩展数据（内部使用） */
+void* vox_loop_get_ext(vox_loop_t* loop, const void* key) {
+    if (!loop || !key) {
+        return NULL;
+    }
+    for (size_t i = 0; i < loop->ext_count; i++) {
+        if (loop->ext[i].key == key) {
+            return loop->ext[i].data;
+        }
+    }
+    return NULL;
+}
+
+/* 设置扩展数据（内部使用） */
+int vox_loop_set_ext(vox_loop_t* loop, const void* key, void* data, vox_loop_ext_cleanup_cb cleanup) {
+    if (!loop || !key) {
+        return -1;
+    }
+    for (size_t i = 0; i < loop->ext_count; i++) {
+        if (loop->ext[i].key != key) {
+            continue;
+        }
+        if (data) {
+            loop->ext[i].data = data;
+            loop->ext[i].cleanup = cleanup;
+        } else {
+            memmove(&loop->ext[i], &loop->ext[i + 1], sizeof(loop->ext[0]) * (loop->ext_count - i - 1));
+            loop->ext_count--;
+        }
+        return 0;
+    }
+    if (!data) {
+        return 0;
+    }
+    if (loop->ext_count >= VOX_LOOP_MAX_EXT) {
+        VOX_LOG_ERROR("loop 扩展数据槽位已满");
+        return -1;
+    }
+    loop->ext[loop->ext_count].key = key;
+    loop->ext[loop->ext_count].data = data;
+    loop->ext[loop->ext_count].cleanup = cleanup;
+    loop->ext_count++;
+    return 0;
+}
@@ -14,6 +14,7 @@
 #include "vox_time.h"
 #include "vox_backend.h"
 #include "vox_tpool.h"
+#include "vox_atomic.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -38,6 +39,15 @@ typedef enum {
 /* 回调函数类型 */
 typedef void (*vox_loop_cb)(vox_loop_t* loop, void* user_data);
 
+/* 侵入式回调工作项：由调用方嵌入自己的结构体中，入队时不再分配内存
+ * 入队后到回调开始执行前不得修改或释放；回调内可释放或再次入队 */
+typedef struct vox_loop_work {
+    vox_atomic_ptr_t next;                /* 内部使用：指向下一个 vox_loop_work_t */
+    vox_loop_cb cb;
+    void* user_data;
+    uint32_t flags;                       /* 内部使用 */
+} vox_loop_work_t;
+
 /* 事件循环配置 */
 typedef struct {
     /* 内存池配置 */
@@ -46,7 +56,7 @@ typedef struct {
     
     /* 队列配置 */
     vox_queue_config_t* pending_events_config;      /* 待处理事件队列配置，NULL表示使用默认配置 */
-    vox_queue_config_t* pending_callbacks_config;   /* 待执行回调队列配置，NULL表示使用默认配置 */
+    vox_queue_config_t* pending_callbacks_config;   /* 已不再使用：待执行回调为无界侵入式 MPSC 队列，保留仅为兼容 */
     
     /* Backend 配置 */
     vox_backend_config_t* backend_config;   /* Backend 配置，NULL表示使用默认配置 */
@@ -144,7 +154,9 @@ void vox_loop_destroy(vox_loop_t* loop);
 /* ===== 回调队列 ===== */
 
 /**
- * 在事件循环的下一次迭代中执行回调
+ * 在事件循环的下一次迭代中执行回调（可跨线程调用）
+ * 工作项从 loop 内存池分配；队列无界，不会因积压而失败
+ * loop 正在处理或已有未消费的唤醒时不再重复唤醒，一批提交只触发一次系统调用
  * @param loop 事件循环指针
  * @param cb 回调函数
  * @param user_data 用户数据
@@ -152,6 +164,16 @@ void vox_loop_destroy(vox_loop_t* loop);
  */
 int vox_loop_queue_work(vox_loop_t* loop, vox_loop_cb cb, void* user_data);
 
+/**
+ * 使用调用方提供的工作项入队回调（可跨线程调用，不分配内存）
+ * @param loop 事件循环指针
+ * @param work 工作项，回调开始执行前须保持有效
+ * @param cb 回调函数
+ * @param user_data 用户数据
+ * @return 成功返回0，参数无效返回-1
+ */
+int vox_loop_queue_work_node(vox_loop_t* loop, vox_loop_work_t* work, vox_loop_cb cb, void* user_data);
+
 /**
  * 立即执行回调（在当前迭代中）
  * @param loop 事件循环指针
@@ -178,12 +200,31 @@ void vox_loop_increment_active_handles(vox_loop_t* loop);
 /* 减少活跃句柄计数（内部使用） */
 void vox_loop_decrement_active_handles(vox_loop_t* loop);
 
+/* 调整定时器堆中弱定时器的数量（内部使用，供 vox_timer 使用） */
+void vox_loop_adjust_weak_timers(vox_loop_t* loop, int delta);
+
 /* 获取 backend（内部使用，供 vox_tcp 等使用） */
 vox_backend_t* vox_loop_get_backend(vox_loop_t* loop);
 
+/* 监听非套接字 fd 的可读事件（内部使用，如 inotify）：不计入活跃句柄，回调在 loop 线程执行
+ * fd 的读取与关闭由调用方负责；IOCP backend 不支持，返回NULL */
+typedef struct vox_loop_fd_watch vox_loop_fd_watch_t;
+typedef void (*vox_loop_fd_cb)(vox_loop_t* loop, int fd, void* user_data);
+vox_loop_fd_watch_t* vox_loop_watch_fd(vox_loop_t* loop, int fd, vox_loop_fd_cb cb, void* user_data);
+/* 取消监听（须在关闭 fd 之前调用），之后不再回调 */
+void vox_loop_unwatch_fd(vox_loop_fd_watch_t* watch);
+
 /* 获取线程池（内部使用，供 vox_dns、vox_fs 等使用） */
 vox_tpool_t* vox_loop_get_thread_pool(vox_loop_t* loop);
 
+/* loop 级扩展数据（内部使用）：上层模块按 key（通常取模块内静态变量地址）挂载私有数据，
+ * loop 销毁时按挂载的逆序调用 cleanup */
+#define VOX_LOOP_MAX_EXT 8
+typedef void (*vox_loop_ext_cleanup_cb)(vox_loop_t* loop, void* data);
+void* vox_loop_get_ext(vox_loop_t* loop, const void* key);
+/* data 为 NULL 时移除该 key（不调用 cleanup）；槽位已满返回 -1 */
+int vox_loop_set_ext(vox_loop_t* loop, const void* key, void* data, vox_loop_ext_cleanup_cb cleanup);
+
 #ifdef __cplusplus
 }
 #endif
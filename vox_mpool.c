@@ -5,6 +5,7 @@
 
  #include "vox_mpool.h"
  #include "vox_mutex.h"
+ #include "vox_arena.h"
  #include <stdlib.h>
  #include <string.h>
  #include <stdio.h>
@@ -66,7 +67,53 @@ struct vox_mpool {
     int thread_safe;         /* 是否线程安全 */
     vox_mutex_t mutex;       /* 互斥锁（仅在thread_safe为真时使用） */
     size_t initial_block_count;  /* 每个块大小对应的初始块数量 */
+    vox_arena_t* arena;      /* 非NULL表示以 arena 为后端的适配器（见 vox_arena_get_mpool） */
 };
+
+/* ===== arena 适配器 =====
+ * 每次分配前置 8 字节保存请求大小，以支持 get_size 和 realloc；
+ * free 为空操作，内存随 arena 的 reset/rewind/destroy 回收 */
+
+typedef struct {
+    size_t size;
+} vox_arena_block_header_t;
+
+static void* vox_mpool_arena_alloc(vox_arena_t* arena, size_t size) {
+    if (size > SIZE_MAX - sizeof(vox_arena_block_header_t)) return NULL;
+    vox_arena_block_header_t* h = (vox_arena_block_header_t*)vox_arena_alloc(arena,
+        sizeof(vox_arena_block_header_t) + size);
+    if (!h) return NULL;
+    h->size = size;
+    return h + 1;
+}
+
+static void* vox_mpool_arena_realloc(vox_arena_t* arena, void* ptr, size_t new_size) {
+    if (new_size > SIZE_MAX - sizeof(vox_arena_block_header_t)) return NULL;
+    vox_arena_block_header_t* h = (vox_arena_block_header_t*)ptr - 1;
+    h = (vox_arena_block_header_t*)vox_arena_realloc(arena, h,
+        sizeof(vox_arena_block_header_t) + h->size,
+        sizeof(vox_arena_block_header_t) + new_size);
+    if (!h) return NULL;
+    h->size = new_size;
+    return h + 1;
+}
+
+/* 创建 arena 适配器（供 vox_arena_get_mpool 使用） */
+vox_mpool_t* vox_mpool_create_arena_adapter(vox_arena_t* arena) {
+    if (!arena) return NULL;
+    vox_mpool_t* pool = (vox_mpool_t*)malloc(sizeof(vox_mpool_t));
+    if (!pool) return NULL;
+    memset(pool, 0, sizeof(vox_mpool_t));
+    pool->arena = arena;
+    return pool;
+}
+
+/* 释放 arena 适配器（供 vox_arena_destroy 使用） */
+void vox_mpool_release_arena_adapter(vox_mpool_t* pool) {
+    if (pool && pool->arena) {
+        free(pool);
+    }
+}
  
  /* 获取块大小对应的槽索引（优化：使用位操作和查找表） */
  static inline int vox_mpool_get_slot_index(size_t size) {
@@ -281,6 +328,7 @@ vox_mpool_t* vox_mpool_create_with_config(const vox_mpool_config_t* config) {
  /* 从内存池分配内存（优化：减少分支，提高缓存友好性） */
  void* vox_mpool_alloc(vox_mpool_t* pool, size_t size) {
      if (!pool || size == 0) return NULL;
+     if (pool->arena) return vox_mpool_arena_alloc(pool->arena, size);
      
      VOX_MPOOL_LOCK(pool);
      void* result = vox_mpool_alloc_internal(pool, size);
@@ -340,6 +388,7 @@ vox_mpool_t* vox_mpool_create_with_config(const vox_mpool_config_t* config) {
  /* 释放内存回内存池（优化：减少分支，提高缓存友好性） */
  void vox_mpool_free(vox_mpool_t* pool, void* ptr) {
      if (!pool || !ptr) return;
+     if (pool->arena) return;  /* arena 后端：随 reset/rewind 统一回收 */
      
      VOX_MPOOL_LOCK(pool);
      vox_mpool_free_internal(pool, ptr);
@@ -349,6 +398,7 @@ vox_mpool_t* vox_mpool_create_with_config(const vox_mpool_config_t* config) {
  /* 获取已分配内存块的大小 */
  size_t vox_mpool_get_size(vox_mpool_t* pool, void* ptr) {
      if (!pool || !ptr) return 0;
+     if (pool->arena) return ((vox_arena_block_header_t*)ptr - 1)->size;
      
      VOX_MPOOL_LOCK(pool);
      
@@ -388,6 +438,8 @@ vox_mpool_t* vox_mpool_create_with_config(const vox_mpool_config_t* config) {
          return NULL;
      }
      
+     if (pool->arena) return vox_mpool_arena_realloc(pool->arena, ptr, new_size);
+     
      VOX_MPOOL_LOCK(pool);
      
      /* 获取原大小 */
@@ -443,6 +495,10 @@ vox_mpool_t* vox_mpool_create_with_config(const vox_mpool_config_t* config) {
 /* 重置内存池 */
 void vox_mpool_reset(vox_mpool_t* pool) {
     if (!pool) return;
+    if (pool->arena) {
+        vox_arena_reset(pool->arena);
+        return;
+    }
 
     VOX_MPOOL_LOCK(pool);
 
@@ -498,6 +554,7 @@ void vox_mpool_reset(vox_mpool_t* pool) {
 /* 销毁内存池 */
 void vox_mpool_destroy(vox_mpool_t* pool) {
     if (!pool) return;
+    if (pool->arena) return;  /* 适配器由 arena 负责释放 */
     
     /* 如果启用了线程安全，先加锁 */
     if (pool->thread_safe) {
@@ -537,6 +594,14 @@ void vox_mpool_destroy(vox_mpool_t* pool) {
  /* 打印内存池统计信息 */
  void vox_mpool_stats(vox_mpool_t* pool) {
      if (!pool) return;
+     if (pool->arena) {
+         vox_arena_stats_t st;
+         vox_arena_get_stats(pool->arena, &st);
+         printf("=== Memory Pool Statistics (arena) ===\n");
+         printf("Total used: %zu bytes, reserved: %zu bytes, chunks: %zu, large: %zu\n",
+                st.used, st.reserved, st.chunk_count, st.large_count);
+         return;
+     }
      
      VOX_MPOOL_LOCK(pool);
      
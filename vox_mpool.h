@@ -1,6 +1,7 @@
 /*
  * vox_mpool.h - 高性能内存池
  * 支持多种固定大小的内存块分配 (16/32/64/128/256/512/1024/2048/4096/8192)
+ * vox_arena_get_mpool 返回的内存池以 arena 为后端：free/destroy 为空操作，reset 回收全部分配
  */
 
  #ifndef VOX_MPOOL_H
@@ -276,6 +276,11 @@ extern "C" {
 /* 向上对齐到对齐边界 */
 #define VOX_ALIGN_SIZE(size, align) (((size) + (align) - 1) & ~((align) - 1))
 
+/* 缓存行大小（用于填充，避免伪共享） */
+#ifndef VOX_CACHE_LINE_SIZE
+    #define VOX_CACHE_LINE_SIZE 64
+#endif
+
 /* 计算数组大小 */
 #define VOX_ARRAY_SIZE(array) (sizeof(array) / sizeof(array[0]))
 
@@ -19,7 +19,7 @@
 /* 队列槽结构（用于 MPSC 队列的序列号方案） */
 typedef struct {
     void* data;                      /* 元素数据 */
-    vox_atomic_long_t* sequence;     /* 序列号（用于同步） */
+    vox_atomic_long_t sequence;      /* 序列号（用于同步，内嵌在槽中） */
 } vox_queue_slot_t;
 
 /* 队列结构 */
@@ -36,10 +36,12 @@ struct vox_queue {
     size_t head;             /* 队首索引 */
     size_t tail;             /* 队尾索引 */
 
-    /* 无锁队列字段（SPSC/MPSC） */
-    vox_atomic_long_t* atomic_head;  /* 原子队首索引 */
-    vox_atomic_long_t* atomic_tail;  /* 原子队尾索引 */
     size_t mask;             /* 容量掩码（capacity - 1，用于快速取模） */
+
+    /* 无锁队列字段（SPSC/MPSC）：生产者与消费者各写一端，分别独占缓存行 */
+    char pad0[VOX_CACHE_LINE_SIZE];
+    vox_atomic_long_padded_t head_line;  /* 原子队首索引 */
+    vox_atomic_long_padded_t tail_line;  /* 原子队尾索引 */
 };
 
 /* 扩容队列 */
@@ -139,15 +141,9 @@ vox_queue_t* vox_queue_create_with_config(vox_mpool_t* mpool, const vox_queue_co
         initial_capacity = cap;
         queue->mask = cap - 1;  /* 用于快速取模 */
 
-        /* 创建原子变量 */
-        queue->atomic_head = vox_atomic_long_create(mpool, 0);
-        queue->atomic_tail = vox_atomic_long_create(mpool, 0);
-        if (!queue->atomic_head || !queue->atomic_tail) {
-            if (queue->atomic_head) vox_atomic_long_destroy(queue->atomic_head);
-            if (queue->atomic_tail) vox_atomic_long_destroy(queue->atomic_tail);
-            vox_mpool_free(mpool, queue);
-            return NULL;
-        }
+        /* 初始化内嵌的原子变量 */
+        vox_atomic_long_init(&queue->head_line.value, 0);
+        vox_atomic_long_init(&queue->tail_line.value, 0);
     } else {
         queue->size = 0;
         queue->head = 0;
@@ -162,8 +158,6 @@ vox_queue_t* vox_queue_create_with_config(vox_mpool_t* mpool, const vox_queue_co
         queue->slots = (vox_queue_slot_t*)vox_mpool_alloc(mpool,
             initial_capacity * sizeof(vox_queue_slot_t));
         if (!queue->slots) {
-            vox_atomic_long_destroy(queue->atomic_head);
-            vox_atomic_long_destroy(queue->atomic_tail);
             vox_mpool_free(mpool, queue);
             return NULL;
         }
@@ -171,26 +165,13 @@ vox_queue_t* vox_queue_create_with_config(vox_mpool_t* mpool, const vox_queue_co
         /* 初始化每个槽的序列号 */
         for (size_t i = 0; i < initial_capacity; i++) {
             queue->slots[i].data = NULL;
-            queue->slots[i].sequence = vox_atomic_long_create(mpool, (int64_t)i);
-            if (!queue->slots[i].sequence) {
-                /* 清理已创建的序列号 */
-                for (size_t j = 0; j < i; j++) {
-                    vox_atomic_long_destroy(queue->slots[j].sequence);
-                }
-                vox_mpool_free(mpool, queue->slots);
-                vox_atomic_long_destroy(queue->atomic_head);
-                vox_atomic_long_destroy(queue->atomic_tail);
-                vox_mpool_free(mpool, queue);
-                return NULL;
-            }
+            vox_atomic_long_init(&queue->slots[i].sequence, (int64_t)i);
         }
         queue->elements = NULL;
     } else {
         /* 普通队列和 SPSC 使用元素数组 */
         queue->elements = (void**)vox_mpool_alloc(mpool, initial_capacity * sizeof(void*));
         if (!queue->elements) {
-            if (queue->atomic_head) vox_atomic_long_destroy(queue->atomic_head);
-            if (queue->atomic_tail) vox_atomic_long_destroy(queue->atomic_tail);
             vox_mpool_free(mpool, queue);
             return NULL;
         }
@@ -207,8 +188,8 @@ int vox_queue_enqueue(vox_queue_t* queue, void* elem) {
     
     if (queue->type == VOX_QUEUE_TYPE_SPSC) {
         /* SPSC 无锁入队（单生产者） */
-        int64_t tail = vox_atomic_long_load(queue->atomic_tail);
-        int64_t head = vox_atomic_long_load_acquire(queue->atomic_head);
+        int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
+        int64_t head = vox_atomic_long_load_acquire(&queue->head_line.value);
         int64_t next_tail = (tail + 1) & queue->mask;
 
         /* 检查队列是否已满 */
@@ -220,7 +201,7 @@ int vox_queue_enqueue(vox_queue_t* queue, void* elem) {
         queue->elements[tail] = elem;
 
         /* 更新 tail（使用 release 语义，确保元素写入对消费者可见） */
-        vox_atomic_long_store_release(queue->atomic_tail, next_tail);
+        vox_atomic_long_store_release(&queue->tail_line.value, next_tail);
 
         return 0;
     } else if (queue->type == VOX_QUEUE_TYPE_MPSC) {
@@ -229,15 +210,15 @@ int vox_queue_enqueue(vox_queue_t* queue, void* elem) {
         vox_queue_slot_t* slot;
 
         while (true) {
-            pos = vox_atomic_long_load(queue->atomic_tail);
+            pos = vox_atomic_long_load(&queue->tail_line.value);
             slot = &queue->slots[pos & queue->mask];
-            int64_t seq = vox_atomic_long_load_acquire(slot->sequence);
+            int64_t seq = vox_atomic_long_load_acquire(&slot->sequence);
             int64_t diff = seq - pos;
 
             if (diff == 0) {
                 /* 槽位可用，尝试原子性地预留 */
                 int64_t expected = pos;
-                if (vox_atomic_long_compare_exchange(queue->atomic_tail, &expected, pos + 1)) {
+                if (vox_atomic_long_compare_exchange(&queue->tail_line.value, &expected, pos + 1)) {
                     break;  /* 成功预留槽位 */
                 }
                 /* CAS 失败，其他生产者已经更新了 tail，重试 */
@@ -262,7 +243,7 @@ int vox_queue_enqueue(vox_queue_t* queue, void* elem) {
         slot->data = elem;
 
         /* 更新序列号，标记槽位已就绪（使用 release 确保数据写入对消费者可见） */
-        vox_atomic_long_store_release(slot->sequence, pos + 1);
+        vox_atomic_long_store_release(&slot->sequence, pos + 1);
 
         return 0;
     } else {
@@ -289,8 +270,8 @@ void* vox_queue_dequeue(vox_queue_t* queue) {
     
     if (queue->type == VOX_QUEUE_TYPE_SPSC) {
         /* SPSC 无锁出队（单消费者） */
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load_acquire(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load_acquire(&queue->tail_line.value);
 
         /* 检查队列是否为空 */
         if (head == tail) {
@@ -302,14 +283,14 @@ void* vox_queue_dequeue(vox_queue_t* queue) {
 
         /* 更新 head（使用 release 语义，让生产者能看到空出的槽位） */
         int64_t next_head = (head + 1) & queue->mask;
-        vox_atomic_long_store_release(queue->atomic_head, next_head);
+        vox_atomic_long_store_release(&queue->head_line.value, next_head);
 
         return elem;
     } else if (queue->type == VOX_QUEUE_TYPE_MPSC) {
         /* MPSC 无锁出队（支持多消费者，使用序列号方案和 CAS） */
         while (true) {
-            int64_t pos = vox_atomic_long_load(queue->atomic_head);
-            int64_t tail = vox_atomic_long_load(queue->atomic_tail);
+            int64_t pos = vox_atomic_long_load(&queue->head_line.value);
+            int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
 
             /* 检查队列是否为空 */
             if (pos == tail) {
@@ -318,7 +299,7 @@ void* vox_queue_dequeue(vox_queue_t* queue) {
 
             /* 获取槽位引用 */
             vox_queue_slot_t* slot = &queue->slots[pos & queue->mask];
-            int64_t seq = vox_atomic_long_load_acquire(slot->sequence);
+            int64_t seq = vox_atomic_long_load_acquire(&slot->sequence);
             int64_t diff = seq - (pos + 1);
 
             if (diff < 0) {
@@ -329,7 +310,7 @@ void* vox_queue_dequeue(vox_queue_t* queue) {
 
             /* 原子性地更新 head */
             int64_t expected = pos;
-            if (!vox_atomic_long_compare_exchange(queue->atomic_head, &expected, pos + 1)) {
+            if (!vox_atomic_long_compare_exchange(&queue->head_line.value, &expected, pos + 1)) {
                 /* CAS 失败，其他消费者已经取走了这个元素，重试 */
                 continue;
             }
@@ -338,7 +319,7 @@ void* vox_queue_dequeue(vox_queue_t* queue) {
             void* elem = slot->data;
 
             /* 更新序列号，标记槽位可重用（使用 release 让生产者能看到） */
-            vox_atomic_long_store_release(slot->sequence, pos + (int64_t)queue->capacity);
+            vox_atomic_long_store_release(&slot->sequence, pos + (int64_t)queue->capacity);
 
             return elem;
         }
@@ -363,8 +344,8 @@ void* vox_queue_peek(const vox_queue_t* queue) {
 
     if (queue->type == VOX_QUEUE_TYPE_SPSC) {
         /* SPSC 无锁查看 */
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load_acquire(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load_acquire(&queue->tail_line.value);
 
         if (head == tail) {
             return NULL;  /* 队列为空 */
@@ -373,8 +354,8 @@ void* vox_queue_peek(const vox_queue_t* queue) {
         return queue->elements[head];
     } else if (queue->type == VOX_QUEUE_TYPE_MPSC) {
         /* MPSC 无锁查看 */
-        int64_t pos = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load(queue->atomic_tail);
+        int64_t pos = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
 
         /* 检查队列是否为空 */
         if (pos == tail) {
@@ -382,7 +363,7 @@ void* vox_queue_peek(const vox_queue_t* queue) {
         }
 
         vox_queue_slot_t* slot = &queue->slots[pos & queue->mask];
-        int64_t seq = vox_atomic_long_load_acquire(slot->sequence);
+        int64_t seq = vox_atomic_long_load_acquire(&slot->sequence);
 
         /* 使用与 dequeue 相同的逻辑来检查槽位是否就绪 */
         int64_t diff = seq - (pos + 1);
@@ -404,8 +385,8 @@ size_t vox_queue_size(const vox_queue_t* queue) {
     
     if (queue->type == VOX_QUEUE_TYPE_SPSC || queue->type == VOX_QUEUE_TYPE_MPSC) {
         /* SPSC/MPSC 无锁获取大小 */
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
         
         int64_t size = tail - head;
         
@@ -437,8 +418,8 @@ bool vox_queue_empty(const vox_queue_t* queue) {
     
     if (queue->type == VOX_QUEUE_TYPE_SPSC || queue->type == VOX_QUEUE_TYPE_MPSC) {
         /* SPSC/MPSC 无锁检查 */
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
         
         /* 对于MPSC队列，可能存在元素已经在槽位中但还没有被正确访问的情况 */
         /* 但我们仍然使用基本的 head == tail 检查，这是无锁队列的标准做法 */
@@ -459,14 +440,14 @@ bool vox_queue_full(const vox_queue_t* queue) {
 
     if (queue->type == VOX_QUEUE_TYPE_SPSC) {
         /* SPSC 无锁检查 */
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
         int64_t next_tail = (tail + 1) & queue->mask;
         return next_tail == head;
     } else if (queue->type == VOX_QUEUE_TYPE_MPSC) {
         /* MPSC 检查队列是否已满 */
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
         /* tail 和 head 是序列号，它们的差值表示队列中的元素数 */
         int64_t size = tail - head;
         /* 防止整数溢出，如果计算出的大小为负数，则认为队列未满 */
@@ -486,8 +467,8 @@ void vox_queue_clear(vox_queue_t* queue) {
     if (queue->type == VOX_QUEUE_TYPE_SPSC) {
         /* SPSC 无锁清空（注意：应该由消费者或在无并发操作时调用） */
         if (queue->elem_free) {
-            int64_t head = vox_atomic_long_load(queue->atomic_head);
-            int64_t tail = vox_atomic_long_load_acquire(queue->atomic_tail);
+            int64_t head = vox_atomic_long_load(&queue->head_line.value);
+            int64_t tail = vox_atomic_long_load_acquire(&queue->tail_line.value);
 
             while (head != tail) {
                 if (queue->elements[head]) {
@@ -497,21 +478,21 @@ void vox_queue_clear(vox_queue_t* queue) {
             }
         }
 
-        vox_atomic_long_store(queue->atomic_head, 0);
-        vox_atomic_long_store(queue->atomic_tail, 0);
+        vox_atomic_long_store(&queue->head_line.value, 0);
+        vox_atomic_long_store(&queue->tail_line.value, 0);
     } else if (queue->type == VOX_QUEUE_TYPE_MPSC) {
         /* MPSC 清空（注意：调用者必须确保在清空期间没有并发的入队操作）*/
         /* 对于 MPSC 队列，如果在有活跃生产者的情况下调用 clear，会导致未定义行为 */
         /* 正确的使用方式是：先停止所有生产者，然后调用 clear */
 
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
 
         /* 遍历所有可能包含数据的槽位并清理 */
         if (queue->elem_free) {
             for (int64_t pos = head; pos < tail; pos++) {
                 vox_queue_slot_t* slot = &queue->slots[pos & queue->mask];
-                int64_t seq = vox_atomic_long_load(slot->sequence);
+                int64_t seq = vox_atomic_long_load(&slot->sequence);
                 /* 检查槽位是否已就绪（序列号 == pos + 1） */
                 if (seq == pos + 1 && slot->data) {
                     queue->elem_free(slot->data);
@@ -522,13 +503,13 @@ void vox_queue_clear(vox_queue_t* queue) {
 
         /* 重置所有序列号为初始值 */
         for (size_t i = 0; i < queue->capacity; i++) {
-            vox_atomic_long_store(queue->slots[i].sequence, (int64_t)i);
+            vox_atomic_long_store(&queue->slots[i].sequence, (int64_t)i);
             queue->slots[i].data = NULL;
         }
 
         /* 重置 head 和 tail 为 0 */
-        vox_atomic_long_store(queue->atomic_head, 0);
-        vox_atomic_long_store(queue->atomic_tail, 0);
+        vox_atomic_long_store(&queue->head_line.value, 0);
+        vox_atomic_long_store(&queue->tail_line.value, 0);
     } else {
         /* 普通队列清空 */
         if (queue->elem_free) {
@@ -554,8 +535,8 @@ size_t vox_queue_foreach(vox_queue_t* queue, vox_queue_visit_func_t visit, void*
 
     if (queue->type == VOX_QUEUE_TYPE_SPSC) {
         /* SPSC 无锁遍历（注意：在并发环境下可能不准确） */
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load_acquire(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load_acquire(&queue->tail_line.value);
         size_t count = 0;
         size_t index = 0;
 
@@ -569,14 +550,14 @@ size_t vox_queue_foreach(vox_queue_t* queue, vox_queue_visit_func_t visit, void*
         return count;
     } else if (queue->type == VOX_QUEUE_TYPE_MPSC) {
         /* MPSC 遍历（注意：在并发环境下可能不准确） */
-        int64_t head = vox_atomic_long_load(queue->atomic_head);
-        int64_t tail = vox_atomic_long_load(queue->atomic_tail);
+        int64_t head = vox_atomic_long_load(&queue->head_line.value);
+        int64_t tail = vox_atomic_long_load(&queue->tail_line.value);
         size_t count = 0;
         size_t index = 0;
 
         while (head != tail) {
             vox_queue_slot_t* slot = &queue->slots[head & queue->mask];
-            int64_t seq = vox_atomic_long_load_acquire(slot->sequence);
+            int64_t seq = vox_atomic_long_load_acquire(&slot->sequence);
             if (seq == head + 1) {
                 visit(slot->data, index, user_data);
                 count++;
@@ -610,21 +591,8 @@ void vox_queue_destroy(vox_queue_t* queue) {
     /* 保存内存池指针 */
     vox_mpool_t* mpool = queue->mpool;
 
-    /* 销毁原子变量 */
-    if (queue->atomic_head) {
-        vox_atomic_long_destroy(queue->atomic_head);
-    }
-    if (queue->atomic_tail) {
-        vox_atomic_long_destroy(queue->atomic_tail);
-    }
-
     /* 释放槽数组（MPSC） */
     if (queue->slots) {
-        for (size_t i = 0; i < queue->capacity; i++) {
-            if (queue->slots[i].sequence) {
-                vox_atomic_long_destroy(queue->slots[i].sequence);
-            }
-        }
         vox_mpool_free(mpool, queue->slots);
     }
 
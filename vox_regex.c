@@ -5,9 +5,21 @@
 
 #include "vox_regex.h"
 #include "vox_os.h"
+#include "vox_htable.h"
 #include <string.h>
 #include <stdlib.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VOX_REGEX_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define VOX_REGEX_NEON 1
+#endif
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
 /* ===== 内部数据结构 ===== */
 
 /* NFA状态类型 */
@@ -62,6 +74,7 @@ struct vox_regex {
     int state_count;           /* 状态总数 */
     char* prefix;              /* 字面量前缀 */
     size_t prefix_len;         /* 前缀长度 */
+    struct regex_dfa* dfa;     /* 惰性 DFA（含环视断言时为NULL） */
 };
 
 /* 匹配状态（用于NFA模拟） */
@@ -1359,6 +1372,9 @@ static void assign_state_ids(nfa_state_t* state, int* count) {
     }
 }
 
+/* 创建惰性 DFA（前向声明） */
+static struct regex_dfa* dfa_create(vox_regex_t* regex);
+
 /* 编译正则表达式 */
 vox_regex_t* vox_regex_compile(vox_mpool_t* mpool, const char* pattern, int flags) {
     if (!mpool || !pattern) {
@@ -1461,6 +1477,11 @@ vox_regex_t* vox_regex_compile(vox_mpool_t* mpool, const char* pattern, int flag
         }
     }
     
+    /* 惰性 DFA 构建失败时仍可使用 NFA 模拟 */
+    if (!(flags & VOX_REGEX_NFA_ONLY)) {
+        regex->dfa = dfa_create(regex);
+    }
+    
     return regex;
 }
 
@@ -1491,6 +1512,7 @@ static bool verify_assertion(nfa_state_t* start_state, const char* text, size_t
     tmp_regex.state_count = state_count;
     tmp_regex.prefix = NULL;
     tmp_regex.prefix_len = 0;
+    tmp_regex.dfa = NULL;
     
     if (lookbehind) {
         /* 对于后行断言，我们需要找到一个起始位置 i <= pos，使得子表达式从 i 到 pos 恰好完全匹配 */
@@ -1651,16 +1673,547 @@ static bool match_internal(vox_regex_t* regex, const char* text, size_t text_len
     return res;
 }
 
+
+/* ===== 惰性 DFA ===== */
+
+/*
+ * 不含环视断言的模式在首次使用时按需把 NFA 状态集合确定化：
+ * - 字节按 NFA 中所有字符/字符集以及单词字符、换行符划分为等价类，转移表按类索引
+ * - DFA 状态 = (前一字符类别, 是否非锚定, 未展开 epsilon 的 NFA 状态集合)，
+ *   ^、$、\b 在计算转移时根据前一字符和下一字符求值，因此与 NFA 模拟的语义一致
+ * - 转移表最后一列表示文本结束；转移项同时记录"在当前位置是否匹配"
+ * - 缓存超过 VOX_REGEX_DFA_CACHE_LIMIT 时清空，本次调用改用 NFA 模拟
+ * 搜索先用非锚定 DFA 单遍扫描找到最早的匹配结束位置（未命中时线性返回），同时记下
+ * 最后一个只含新起点线程的位置；再从该位置起做一遍携带起点的 NFA 线程扫描求出最左起点，
+ * 最后从该起点运行一次锚定 DFA 求匹配终点。三遍都是线性的，结果与 NFA 相同
+ */
+
+#ifndef VOX_REGEX_DFA_CACHE_LIMIT
+#define VOX_REGEX_DFA_CACHE_LIMIT (1024 * 1024)  /* DFA 状态缓存上限（字节） */
+#endif
+
+/* 前一字符类别 */
+enum {
+    DFA_PREV_BEGIN = 0,   /* 文本开头 */
+    DFA_PREV_NEWLINE,     /* \n 或 \r */
+    DFA_PREV_WORD,        /* 单词字符 */
+    DFA_PREV_OTHER,       /* 其他字符 */
+    DFA_PREV_KINDS
+};
+
+#define DFA_DEAD 0        /* 死状态下标 */
+
+/* DFA 状态 */
+typedef struct {
+    int32_t* trans;       /* 转移：0 未计算，否则 ((目标下标 + 1) << 1) | 当前位置是否匹配 */
+    int32_t* key;         /* [0] = 前一字符类别 | 非锚定标记 << 8，其后为升序的 NFA 状态 ID */
+    int thread_count;     /* NFA 状态个数 */
+    bool restart;         /* 只含起始 NFA 状态（此前开始的线程都已结束） */
+} dfa_state_t;
+
+/* 惰性 DFA */
+typedef struct regex_dfa {
+    vox_mpool_t* mpool;
+    nfa_state_t** nfa;        /* 按 ID 索引的 NFA 状态 */
+    int nfa_count;
+    int start_id;             /* 起始 NFA 状态 ID；消耗字符后可能回到起始状态时为-1，不记录重新开始的位置 */
+    int ncls;                 /* 字节类数量（转移表列数为 ncls + 1） */
+    uint8_t cls[256];         /* 字节 -> 字节类 */
+    uint8_t rep[256];         /* 字节类 -> 代表字节 */
+    uint8_t prev_kind[256];   /* 字节 -> 前一字符类别 */
+    dfa_state_t* states;
+    size_t state_count;
+    size_t state_capacity;
+    vox_htable_t* index;      /* 状态键 -> 下标 + 1 */
+    int start[DFA_PREV_KINDS][2]; /* (前一字符类别, 非锚定) -> 起始状态下标 + 1 */
+    size_t mem;               /* 缓存占用（估算） */
+    size_t flushes;           /* 缓存超限清空次数（统计） */
+    uint64_t steps;           /* 累计扫描的文本位置数（统计） */
+    /* 计算转移用的临时缓冲区 */
+    uint32_t* mark;
+    uint32_t* next_mark;
+    uint32_t generation;
+    nfa_state_t** stack;
+    int32_t* next_key;
+    /* 携带起点的线程扫描用：按起点升序的 (NFA 状态, 起点) 列表 */
+    int32_t* scan_ids[2];
+    size_t* scan_starts[2];
+} regex_dfa_t;
+
+/* 收集 NFA 状态到 ID 表，遇到环视断言返回 false */
+static bool dfa_collect_states(nfa_state_t* state, nfa_state_t** table) {
+    if (!state || table[state->id]) return true;
+    if (state->type >= NFA_STATE_LOOKAHEAD_POS && state->type <= NFA_STATE_LOOKBEHIND_NEG) {
+        return false;
+    }
+    table[state->id] = state;
+    return dfa_collect_states(state->out1, table) && dfa_collect_states(state->out2, table);
+}
+
+/* 按成员集合细分字节类 */
+static void dfa_refine_classes(regex_dfa_t* dfa, const bool* member) {
+    int map[512];
+    int n = 0;
+    for (int i = 0; i < 512; i++) map[i] = -1;
+    for (int b = 0; b < 256; b++) {
+        int k = dfa->cls[b] * 2 + (member[b] ? 1 : 0);
+        if (map[k] < 0) map[k] = n++;
+        dfa->cls[b] = (uint8_t)map[k];
+    }
+    dfa->ncls = n;
+}
+
+/* NFA 叶子状态能否消耗字节 c（c < 0 表示文本结束） */
+static inline bool dfa_leaf_accepts(const vox_regex_t* regex, const nfa_state_t* s, int c) {
+    if (c < 0) return false;
+    if (s->type == NFA_STATE_CHAR) {
+        return (regex->flags & VOX_REGEX_IGNORE_CASE) ?
+               (to_lower_if_needed((char)c, true) == to_lower_if_needed(s->u.ch, true)) :
+               (s->u.ch == (char)c);
+    }
+    if (s->type == NFA_STATE_CHARSET) {
+        return char_in_charset(s->u.charset.bitmap, (char)c);
+    }
+    return false;
+}
+
+/* 释放全部 DFA 状态（保留死状态） */
+static void dfa_flush(regex_dfa_t* dfa) {
+    for (size_t i = 1; i < dfa->state_count; i++) {
+        vox_mpool_free(dfa->mpool, dfa->states[i].trans);
+    }
+    dfa->state_count = 1;
+    dfa->mem = 0;
+    dfa->flushes++;
+    vox_htable_clear(dfa->index);
+    memset(dfa->start, 0, sizeof(dfa->start));
+}
+
+/* 查找或创建状态，缓存超限返回-1 */
+static int dfa_add_state(regex_dfa_t* dfa, const int32_t* key, int thread_count) {
+    size_t key_size = sizeof(int32_t) * (size_t)(thread_count + 1);
+    void* found = vox_htable_get(dfa->index, key, key_size);
+    if (found) return (int)((intptr_t)found - 1);
+
+    size_t trans_size = sizeof(int32_t) * (size_t)(dfa->ncls + 1);
+    size_t cost = sizeof(dfa_state_t) + trans_size + key_size * 2 + 32;
+    if (dfa->mem + cost > VOX_REGEX_DFA_CACHE_LIMIT) return -1;
+
+    if (dfa->state_count >= dfa->state_capacity) {
+        size_t cap = dfa->state_capacity * 2;
+        dfa_state_t* states = (dfa_state_t*)vox_mpool_realloc(dfa->mpool, dfa->states, sizeof(dfa_state_t) * cap);
+        if (!states) return -1;
+        dfa->states = states;
+        dfa->state_capacity = cap;
+    }
+
+    /* 转移表与状态键一次分配 */
+    int32_t* block = (int32_t*)vox_mpool_alloc(dfa->mpool, trans_size + key_size);
+    if (!block) return -1;
+    memset(block, 0, trans_size);
+    memcpy(block + dfa->ncls + 1, key, key_size);
+
+    int idx = (int)dfa->state_count;
+    if (vox_htable_set(dfa->index, key, key_size, (void*)(intptr_t)(idx + 1)) != 0) {
+        vox_mpool_free(dfa->mpool, block);
+        return -1;
+    }
+    dfa->states[idx].trans = block;
+    dfa->states[idx].key = block + dfa->ncls + 1;
+    dfa->states[idx].thread_count = thread_count;
+    dfa->states[idx].restart = (dfa->start_id >= 0 && thread_count == 1 && key[1] == dfa->start_id);
+    dfa->state_count++;
+    dfa->mem += cost;
+    return idx;
+}
+
+/* 升序插入排序（状态集合通常很小） */
+static void dfa_sort_ids(int32_t* ids, int n) {
+    for (int i = 1; i < n; i++) {
+        int32_t v = ids[i];
+        int j = i - 1;
+        while (j >= 0 && ids[j] > v) {
+            ids[j + 1] = ids[j];
+            j--;
+        }
+        ids[j + 1] = v;
+    }
+}
+
+/* 开始新一轮标记，计数回绕时清零 */
+static uint32_t dfa_next_generation(regex_dfa_t* dfa) {
+    if (++dfa->generation == 0) {
+        memset(dfa->mark, 0, sizeof(uint32_t) * dfa->nfa_count);
+        memset(dfa->next_mark, 0, sizeof(uint32_t) * dfa->nfa_count);
+        dfa->generation = 1;
+    }
+    return dfa->generation;
+}
+
+/*
+ * 从 NFA 状态 id 展开 epsilon 闭包（条件与 add_state 保持一致），消耗 c 后到达的状态追加到 next
+ * prev 为前一字符类别，c < 0 表示文本结束；返回闭包中是否含有匹配状态
+ */
+static bool dfa_expand(const vox_regex_t* regex, regex_dfa_t* dfa, int id, int prev, int c,
+                       uint32_t gen, int32_t* next, int* next_count) {
+    bool multiline = (regex->flags & VOX_REGEX_MULTILINE) != 0;
+    bool matched = false;
+    if (dfa->mark[id] == gen) return false;
+    dfa->mark[id] = gen;
+    int sp = 0;
+    dfa->stack[sp++] = dfa->nfa[id];
+    while (sp > 0) {
+        nfa_state_t* s = dfa->stack[--sp];
+        nfa_state_t* follow1 = NULL;
+        nfa_state_t* follow2 = NULL;
+        if (s->type == NFA_STATE_SPLIT) {
+            follow1 = s->out1;
+            follow2 = s->out2;
+        } else if (s->type == NFA_STATE_ANCHOR_START) {
+            if (prev == DFA_PREV_BEGIN || (multiline && prev == DFA_PREV_NEWLINE)) follow1 = s->out1;
+        } else if (s->type == NFA_STATE_ANCHOR_END) {
+            if (c < 0 || (multiline && (c == '\n' || c == '\r'))) follow1 = s->out1;
+        } else if (s->group_id >= 0 && regex->group_count > 0) {
+            follow1 = s->out1;
+        } else if (s->type == NFA_STATE_WORD_BOUNDARY) {
+            bool left = (prev == DFA_PREV_WORD);
+            bool right = (c >= 0) && is_word_char((char)c);
+            if (left != right) follow1 = s->out1;
+        } else if (s->type == NFA_STATE_MATCH) {
+            matched = true;
+        } else if (s->out1 && dfa_leaf_accepts(regex, s, c)) {
+            int nid = s->out1->id;
+            if (dfa->next_mark[nid] != gen) {
+                dfa->next_mark[nid] = gen;
+                next[(*next_count)++] = nid;
+            }
+        }
+        if (follow2 && dfa->mark[follow2->id] != gen) {
+            dfa->mark[follow2->id] = gen;
+            dfa->stack[sp++] = follow2;
+        }
+        if (follow1 && dfa->mark[follow1->id] != gen) {
+            dfa->mark[follow1->id] = gen;
+            dfa->stack[sp++] = follow1;
+        }
+    }
+    return matched;
+}
+
+/* 计算状态 si 在字节类 col 上的转移（col == ncls 表示文本结束），缓存超限返回0 */
+static int32_t dfa_compute(const vox_regex_t* regex, regex_dfa_t* dfa, int si, int col) {
+    int c = (col < dfa->ncls) ? dfa->rep[col] : -1;
+    int prev = dfa->states[si].key[0] & 0xff;
+    int unanchored = dfa->states[si].key[0] >> 8;
+    bool matched = false;
+    int next_count = 0;
+
+    uint32_t gen = dfa_next_generation(dfa);
+    int32_t* next = dfa->next_key + 1;
+    for (int i = 0; i < dfa->states[si].thread_count; i++) {
+        if (dfa_expand(regex, dfa, dfa->states[si].key[i + 1], prev, c, gen, next, &next_count)) {
+            matched = true;
+        }
+    }
+
+    int target = DFA_DEAD;
+    if (c >= 0) {
+        /* 非锚定搜索：每个位置都重新从起始状态开始 */
+        if (unanchored) {
+            int id = regex->start->id;
+            if (dfa->next_mark[id] != gen) {
+                dfa->next_mark[id] = gen;
+                next[next_count++] = id;
+            }
+        }
+        if (next_count > 0) {
+            dfa_sort_ids(next, next_count);
+            dfa->next_key[0] = dfa->prev_kind[c] | (unanchored << 8);
+            target = dfa_add_state(dfa, dfa->next_key, next_count);
+            if (target < 0) return 0;
+        }
+    }
+
+    int32_t entry = (int32_t)(((target + 1) << 1) | (matched ? 1 : 0));
+    dfa->states[si].trans[col] = entry;
+    return entry;
+}
+
+/* 获取起始状态，缓存超限返回-1 */
+static int dfa_start_state(const vox_regex_t* regex, regex_dfa_t* dfa, int prev, int unanchored) {
+    int cached = dfa->start[prev][unanchored];
+    if (cached) return cached - 1;
+    int32_t key[2];
+    key[0] = prev | (unanchored << 8);
+    key[1] = regex->start->id;
+    int idx = dfa_add_state(dfa, key, 1);
+    if (idx >= 0) dfa->start[prev][unanchored] = idx + 1;
+    return idx;
+}
+
+/*
+ * 从 pos 开始运行 DFA
+ * earliest 为真时在第一个匹配位置停止，否则返回最长匹配；full 为真时只接受在文本末尾结束的匹配
+ * restart_out 非NULL时记录最后一个只含起始 NFA 状态的位置（最左匹配起点的下界）
+ * 返回1找到（*end_out 为匹配结束位置），0未找到，-1缓存超限（已清空，应回退到 NFA）
+ */
+static int dfa_run(const vox_regex_t* regex, const char* text, size_t text_len, size_t pos,
+                   bool unanchored, bool earliest, bool full, size_t* end_out, size_t* restart_out) {
+    regex_dfa_t* dfa = regex->dfa;
+    int prev = (pos == 0) ? DFA_PREV_BEGIN : dfa->prev_kind[(unsigned char)text[pos - 1]];
+    int si = dfa_start_state(regex, dfa, prev, unanchored ? 1 : 0);
+    if (si < 0) {
+        dfa_flush(dfa);
+        return -1;
+    }
+
+    int found = 0;
+    size_t p;
+    for (p = pos; ; p++) {
+        if (restart_out && dfa->states[si].restart) *restart_out = p;
+        int col = (p < text_len) ? dfa->cls[(unsigned char)text[p]] : dfa->ncls;
+        int32_t entry = dfa->states[si].trans[col];
+        if (entry == 0) {
+            entry = dfa_compute(regex, dfa, si, col);
+            if (entry == 0) {
+                dfa->steps += p - pos + 1;
+                dfa_flush(dfa);
+                return -1;
+            }
+        }
+        if ((entry & 1) && (!full || p == text_len)) {
+            found = 1;
+            *end_out = p;
+            if (earliest) break;
+        }
+        si = (entry >> 1) - 1;
+        if (p >= text_len || si == DFA_DEAD) break;
+    }
+    dfa->steps += p - pos + 1;
+    return found;
+}
+
+/* 在 [from, text_len] 中查找字面量，未找到返回 (size_t)-1 */
+static size_t find_literal(const char* text, size_t text_len, size_t from,
+                           const char* lit, size_t lit_len) {
+    while (from + lit_len <= text_len) {
+        const char* p = (const char*)memchr(text + from, lit[0], text_len - from - lit_len + 1);
+        if (!p) break;
+        if (memcmp(p + 1, lit + 1, lit_len - 1) == 0) return (size_t)(p - text);
+        from = (size_t)(p - text) + 1;
+    }
+    return (size_t)-1;
+}
+
+/*
+ * 携带起点的 NFA 线程扫描：从 lo 起每个不超过 hi 的位置开启一个线程，同一 NFA 状态只保留起点
+ * 最小的线程；一旦有线程匹配，起点不小于它的线程都不再需要，剩余线程全部结束时得到最左起点
+ * 调用方已确认存在起点在 [lo, hi] 内的匹配；返回1找到，0未找到
+ */
+static int dfa_leftmost_start(const vox_regex_t* regex, const char* text, size_t text_len,
+                              size_t lo, size_t hi, size_t* start_out) {
+    regex_dfa_t* dfa = regex->dfa;
+    int32_t* cur_ids = dfa->scan_ids[0];
+    size_t* cur_starts = dfa->scan_starts[0];
+    int32_t* next_ids = dfa->scan_ids[1];
+    size_t* next_starts = dfa->scan_starts[1];
+    int start_id = regex->start->id;
+    size_t best = (size_t)-1;
+    int cur_count = 1;
+    cur_ids[0] = start_id;
+    cur_starts[0] = lo;
+
+    size_t p;
+    for (p = lo; ; p++) {
+        int c = (p < text_len) ? (unsigned char)text[p] : -1;
+        int prev = (p == 0) ? DFA_PREV_BEGIN : dfa->prev_kind[(unsigned char)text[p - 1]];
+        uint32_t gen = dfa_next_generation(dfa);
+        int next_count = 0;
+        /* 列表按起点升序：先展开的线程占据共享状态，保证保留的是较小的起点 */
+        for (int i = 0; i < cur_count && cur_starts[i] < best; i++) {
+            int before = next_count;
+            if (dfa_expand(regex, dfa, cur_ids[i], prev, c, gen, next_ids, &next_count)) {
+                best = cur_starts[i];
+                next_count = before;
+                break;
+            }
+            for (int j = before; j < next_count; j++) next_starts[j] = cur_starts[i];
+        }
+        if (c < 0) break;
+        if (best == (size_t)-1 && p + 1 <= hi && dfa->next_mark[start_id] != gen) {
+            dfa->next_mark[start_id] = gen;
+            next_ids[next_count] = start_id;
+            next_starts[next_count] = p + 1;
+            next_count++;
+        }
+        if (next_count == 0) break;
+
+        int32_t* tmp_ids = cur_ids;
+        size_t* tmp_starts = cur_starts;
+        cur_ids = next_ids;
+        cur_starts = next_starts;
+        next_ids = tmp_ids;
+        next_starts = tmp_starts;
+        cur_count = next_count;
+    }
+    dfa->steps += p - lo + 1;
+    if (best == (size_t)-1) return 0;
+    *start_out = best;
+    return 1;
+}
+
+/* DFA 搜索：返回1找到，0未找到，-1需要回退到 NFA */
+static int dfa_search(vox_regex_t* regex, const char* text, size_t text_len,
+                      size_t start_pos, vox_regex_match_t* match) {
+    if (!regex->dfa) return -1;
+
+    size_t from = start_pos;
+    if (regex->prefix && !(regex->flags & VOX_REGEX_IGNORE_CASE)) {
+        from = find_literal(text, text_len, from, regex->prefix, regex->prefix_len);
+        if (from == (size_t)-1) return 0;
+    }
+
+    /* 单遍扫描：最早结束的匹配决定最左匹配起点的上界，最后一个重新开始的位置是下界 */
+    size_t first_end = 0;
+    size_t lo = from;
+    int r = dfa_run(regex, text, text_len, from, true, true, false, &first_end, &lo);
+    if (r <= 0) return r;
+
+    size_t pos = 0;
+    if (!dfa_leftmost_start(regex, text, text_len, lo, first_end, &pos)) return 0;
+    size_t end = 0;
+    r = dfa_run(regex, text, text_len, pos, false, regex->has_non_greedy, false, &end, NULL);
+    if (r <= 0) return r;
+    if (match) {
+        match->start = pos;
+        match->end = end;
+    }
+    return 1;
+}
+
+/* 创建惰性 DFA，包含环视断言等不支持的结构时返回NULL */
+static regex_dfa_t* dfa_create(vox_regex_t* regex) {
+    vox_mpool_t* mpool = regex->mpool;
+    int n = regex->state_count;
+
+    regex_dfa_t* dfa = (regex_dfa_t*)vox_mpool_alloc(mpool, sizeof(regex_dfa_t));
+    if (!dfa) return NULL;
+    memset(dfa, 0, sizeof(regex_dfa_t));
+    dfa->mpool = mpool;
+    dfa->nfa_count = n;
+
+    dfa->nfa = (nfa_state_t**)vox_mpool_alloc(mpool, sizeof(nfa_state_t*) * n);
+    dfa->mark = (uint32_t*)vox_mpool_alloc(mpool, sizeof(uint32_t) * n);
+    dfa->next_mark = (uint32_t*)vox_mpool_alloc(mpool, sizeof(uint32_t) * n);
+    dfa->stack = (nfa_state_t**)vox_mpool_alloc(mpool, sizeof(nfa_state_t*) * n);
+    dfa->next_key = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * (n + 1));
+    for (int i = 0; i < 2; i++) {
+        dfa->scan_ids[i] = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * n);
+        dfa->scan_starts[i] = (size_t*)vox_mpool_alloc(mpool, sizeof(size_t) * n);
+    }
+    dfa->state_capacity = 64;
+    dfa->states = (dfa_state_t*)vox_mpool_alloc(mpool, sizeof(dfa_state_t) * dfa->state_capacity);
+    dfa->index = vox_htable_create(mpool);
+    if (!dfa->nfa || !dfa->mark || !dfa->next_mark || !dfa->stack || !dfa->next_key ||
+        !dfa->scan_ids[0] || !dfa->scan_ids[1] || !dfa->scan_starts[0] || !dfa->scan_starts[1] ||
+        !dfa->states || !dfa->index) {
+        goto fail;
+    }
+    memset(dfa->nfa, 0, sizeof(nfa_state_t*) * n);
+    memset(dfa->mark, 0, sizeof(uint32_t) * n);
+    memset(dfa->next_mark, 0, sizeof(uint32_t) * n);
+    if (!dfa_collect_states(regex->start, dfa->nfa)) goto fail;
+    dfa->start_id = regex->start->id;
+    for (int i = 0; i < n; i++) {
+        nfa_state_t* s = dfa->nfa[i];
+        if (s && (s->type == NFA_STATE_CHAR || s->type == NFA_STATE_CHARSET) && s->out1 == regex->start) {
+            dfa->start_id = -1;
+            break;
+        }
+    }
+
+    /* 字节类：能区分的字节才分到不同类 */
+    bool member[256];
+    dfa->ncls = 1;
+    for (int i = 0; i < n && dfa->ncls < 256; i++) {
+        nfa_state_t* s = dfa->nfa[i];
+        if (!s || (s->type != NFA_STATE_CHAR && s->type != NFA_STATE_CHARSET)) continue;
+        for (int b = 0; b < 256; b++) member[b] = dfa_leaf_accepts(regex, s, b);
+        dfa_refine_classes(dfa, member);
+    }
+    for (int b = 0; b < 256; b++) member[b] = is_word_char((char)b);
+    dfa_refine_classes(dfa, member);
+    for (int b = 0; b < 256; b++) member[b] = (b == '\n' || b == '\r');
+    dfa_refine_classes(dfa, member);
+    for (int b = 255; b >= 0; b--) {
+        dfa->rep[dfa->cls[b]] = (uint8_t)b;
+        dfa->prev_kind[b] = (b == '\n' || b == '\r') ? DFA_PREV_NEWLINE :
+                            is_word_char((char)b) ? DFA_PREV_WORD : DFA_PREV_OTHER;
+    }
+
+    /* 死状态：所有转移指向自身且不匹配 */
+    dfa->states[DFA_DEAD].trans = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * (dfa->ncls + 1));
+    if (!dfa->states[DFA_DEAD].trans) goto fail;
+    for (int i = 0; i <= dfa->ncls; i++) dfa->states[DFA_DEAD].trans[i] = (DFA_DEAD + 1) << 1;
+    dfa->states[DFA_DEAD].key = NULL;
+    dfa->states[DFA_DEAD].thread_count = 0;
+    dfa->state_count = 1;
+    return dfa;
+
+fail:
+    if (dfa->index) vox_htable_destroy(dfa->index);
+    if (dfa->states) vox_mpool_free(mpool, dfa->states);
+    for (int i = 0; i < 2; i++) {
+        if (dfa->scan_ids[i]) vox_mpool_free(mpool, dfa->scan_ids[i]);
+        if (dfa->scan_starts[i]) vox_mpool_free(mpool, dfa->scan_starts[i]);
+    }
+    if (dfa->next_key) vox_mpool_free(mpool, dfa->next_key);
+    if (dfa->stack) vox_mpool_free(mpool, dfa->stack);
+    if (dfa->next_mark) vox_mpool_free(mpool, dfa->next_mark);
+    if (dfa->mark) vox_mpool_free(mpool, dfa->mark);
+    if (dfa->nfa) vox_mpool_free(mpool, dfa->nfa);
+    vox_mpool_free(mpool, dfa);
+    return NULL;
+}
+
+/* 销毁惰性 DFA */
+static void dfa_destroy(regex_dfa_t* dfa) {
+    if (!dfa) return;
+    vox_mpool_t* mpool = dfa->mpool;
+    dfa_flush(dfa);
+    vox_mpool_free(mpool, dfa->states[DFA_DEAD].trans);
+    vox_htable_destroy(dfa->index);
+    vox_mpool_free(mpool, dfa->states);
+    for (int i = 0; i < 2; i++) {
+        vox_mpool_free(mpool, dfa->scan_ids[i]);
+        vox_mpool_free(mpool, dfa->scan_starts[i]);
+    }
+    vox_mpool_free(mpool, dfa->next_key);
+    vox_mpool_free(mpool, dfa->stack);
+    vox_mpool_free(mpool, dfa->next_mark);
+    vox_mpool_free(mpool, dfa->mark);
+    vox_mpool_free(mpool, dfa->nfa);
+    vox_mpool_free(mpool, dfa);
+}
+
 /* 匹配函数实现 */
 bool vox_regex_match(vox_regex_t* regex, const char* text, size_t text_len,
                      vox_regex_matches_t* matches) {
+    if (!regex || !text) return false;
+    if (regex->dfa) {
+        size_t end = 0;
+        int r = dfa_run(regex, text, text_len, 0, false, false, true, &end, NULL);
+        if (r == 0) return false;
+        /* 不需要捕获组时 DFA 的结论即为结果 */
+        if (r > 0 && !matches) return true;
+    }
     return match_internal(regex, text, text_len, 0, true, matches);
 }
 
-/* 内部搜索函数（支持上下文复用） */
-static bool vox_regex_search_with_context(vox_regex_t* regex, match_context_t* ctx,
-                                         const char* text, size_t text_len,
-                                         size_t start_pos, vox_regex_match_t* match) {
+/* NFA 模拟搜索（支持上下文复用） */
+static bool nfa_search_with_context(vox_regex_t* regex, match_context_t* ctx,
+                                    const char* text, size_t text_len,
+                                    size_t start_pos, vox_regex_match_t* match) {
     if (!regex || !text || start_pos > text_len || !ctx) return false;
     
     bool is_anchor_start = (regex->start->type == NFA_STATE_ANCHOR_START);
@@ -1675,9 +2228,8 @@ static bool vox_regex_search_with_context(vox_regex_t* regex, match_context_t* c
         }
         
         if (regex->prefix && !(regex->flags & VOX_REGEX_IGNORE_CASE) && pos < text_len) {
-            const char* next_p = strstr(text + pos, regex->prefix);
-            if (!next_p) break;
-            pos = (size_t)(next_p - text);
+            pos = find_literal(text, text_len, pos, regex->prefix, regex->prefix_len);
+            if (pos == (size_t)-1) break;
         }
 
         vox_regex_matches_t matches = { NULL, 0, 0 };
@@ -1695,15 +2247,28 @@ static bool vox_regex_search_with_context(vox_regex_t* regex, match_context_t* c
     return found;
 }
 
+/* 内部搜索函数：优先使用惰性 DFA，缓存超限时回退到 NFA */
+static bool vox_regex_search_with_context(vox_regex_t* regex, match_context_t* ctx,
+                                         const char* text, size_t text_len,
+                                         size_t start_pos, vox_regex_match_t* match) {
+    if (!regex || !text || start_pos > text_len) return false;
+    int r = dfa_search(regex, text, text_len, start_pos, match);
+    if (r >= 0) return r > 0;
+    return nfa_search_with_context(regex, ctx, text, text_len, start_pos, match);
+}
+
 /* 搜索函数实现 */
 bool vox_regex_search(vox_regex_t* regex, const char* text, size_t text_len,
                       size_t start_pos, vox_regex_match_t* match) {
     if (!regex || !text || start_pos > text_len) return false;
     
+    int r = dfa_search(regex, text, text_len, start_pos, match);
+    if (r >= 0) return r > 0;
+    
     match_context_t* ctx = create_match_context(regex);
     if (!ctx) return false;
     
-    bool res = vox_regex_search_with_context(regex, ctx, text, text_len, start_pos, match);
+    bool res = nfa_search_with_context(regex, ctx, text, text_len, start_pos, match);
     free_match_context(ctx);
     return res;
 }
@@ -1831,7 +2396,9 @@ int vox_regex_replace(vox_regex_t* regex, const char* text, size_t text_len,
 /* 销毁正则表达式 */
 void vox_regex_destroy(vox_regex_t* regex) {
     if (regex) {
-        /* 内存池会自动管理所有内存，这里不需要手动释放 */
+        /* NFA 由内存池管理；DFA 缓存可能较大，这里主动释放 */
+        dfa_destroy(regex->dfa);
+        regex->dfa = NULL;
     }
 }
 
@@ -1842,3 +2409,435 @@ void vox_regex_free_matches(vox_regex_t* regex, vox_regex_match_t* matches, size
     }
     (void)match_count;
 }
+
+int vox_regex_get_dfa_stats(const vox_regex_t* regex, vox_regex_dfa_stats_t* stats) {
+    if (!stats) return -1;
+    memset(stats, 0, sizeof(*stats));
+    if (!regex || !regex->dfa) return -1;
+    stats->states = regex->dfa->state_count;
+    stats->cache_flushes = regex->dfa->flushes;
+    stats->steps = regex->dfa->steps;
+    return 0;
+}
+
+/* ===== 正则表达式集合 ===== */
+
+/*
+ * 多模式匹配：
+ * - 编译时从每个模式的 NFA 中提取一段"必需字面量"：任何匹配都必须包含它
+ *   （起始字符是到达匹配状态的必经状态，其后的字符由唯一的 epsilon 链强制衔接）
+ * - 所有必需字面量构建一个 Aho-Corasick 自动机，匹配时对文本只扫描一遍，标记候选模式
+ * - 只有候选模式和没有必需字面量的模式才用各自的惰性 DFA 验证
+ */
+
+struct vox_regex_set {
+    vox_mpool_t* mpool;
+    vox_regex_t** regexes;     /* 各模式的正则对象 */
+    size_t count;              /* 模式数量 */
+    int flags;                 /* 编译选项 */
+    bool* has_literal;         /* 模式是否有必需字面量 */
+    size_t literal_count;      /* 有必需字面量的模式数量 */
+    uint8_t* candidate;        /* 匹配时的候选标记（临时缓冲区） */
+    /* Aho-Corasick 自动机（已展开为完整转移表） */
+    uint8_t cls[256];          /* 字节 -> 字节类（0 表示不出现在任何字面量中） */
+    int ncls;
+    int32_t* ac_next;          /* 节点 * ncls -> 下一节点 */
+    int32_t* ac_out;           /* 节点 -> 首个输出项，-1 表示无 */
+    int32_t* ac_dict;          /* 节点 -> 最近的带输出的后缀节点，-1 表示无 */
+    int32_t* out_pattern;      /* 输出项 -> 模式编号 */
+    int32_t* out_next;         /* 输出项 -> 同一节点的下一个输出项 */
+    size_t node_count;
+    /* 根节点跳跃：字面量首字节（含大小写变体）不超过 SET_SKIP_MAX 种时按 16 字节一组查找 */
+    int nfirst;                /* 首字节种数，0 表示太多，逐字节查转移表 */
+    uint8_t first[4];
+};
+
+#define SET_SKIP_MAX 4
+
+/* NFA 状态是否只做 epsilon 转移（与 add_state 的判定顺序一致） */
+static inline bool set_state_is_epsilon(const vox_regex_t* regex, const nfa_state_t* s) {
+    if (s->type == NFA_STATE_SPLIT || s->type == NFA_STATE_ANCHOR_START ||
+        s->type == NFA_STATE_ANCHOR_END) {
+        return true;
+    }
+    if (s->group_id >= 0 && regex->group_count > 0) return true;
+    return s->type != NFA_STATE_CHAR && s->type != NFA_STATE_CHARSET && s->type != NFA_STATE_MATCH;
+}
+
+/* 收集主路径上的 NFA 状态（不进入断言子 NFA） */
+static void set_collect_states(nfa_state_t* state, nfa_state_t** table) {
+    if (!state || table[state->id]) return;
+    table[state->id] = state;
+    set_collect_states(state->out1, table);
+    if (state->type == NFA_STATE_SPLIT) set_collect_states(state->out2, table);
+}
+
+/* 去掉 removed 后是否仍能从起始状态到达匹配状态（断言按可通过处理，结论偏保守） */
+static bool set_reaches_match(const vox_regex_t* regex, const nfa_state_t* removed,
+                              nfa_state_t** stack, uint8_t* seen) {
+    memset(seen, 0, (size_t)regex->state_count);
+    int sp = 0;
+    if (regex->start == removed) return false;
+    stack[sp++] = regex->start;
+    seen[regex->start->id] = 1;
+    while (sp > 0) {
+        nfa_state_t* s = stack[--sp];
+        if (s->type == NFA_STATE_MATCH && !(s->group_id >= 0 && regex->group_count > 0)) return true;
+        nfa_state_t* outs[2] = { s->out1, s->type == NFA_STATE_SPLIT ? s->out2 : NULL };
+        for (int i = 0; i < 2; i++) {
+            nfa_state_t* t = outs[i];
+            if (t && t != removed && !seen[t->id]) {
+                seen[t->id] = 1;
+                stack[sp++] = t;
+            }
+        }
+    }
+    return false;
+}
+
+/* 从消耗字符的状态 s 开始沿唯一的 epsilon 链收集连续字面量 */
+static size_t set_forced_run(const vox_regex_t* regex, const nfa_state_t* s, char* buf, size_t cap) {
+    bool ignore_case = (regex->flags & VOX_REGEX_IGNORE_CASE) != 0;
+    size_t len = 0;
+    int steps = 0;
+    while (s && len < cap && steps++ <= regex->state_count) {
+        if (s->type == NFA_STATE_CHAR && !set_state_is_epsilon(regex, s)) {
+            buf[len++] = to_lower_if_needed(s->u.ch, ignore_case);
+            s = s->out1;
+        } else if (s->type == NFA_STATE_SPLIT) {
+            if (s->out1 && s->out2) break;
+            s = s->out1 ? s->out1 : s->out2;
+        } else if (set_state_is_epsilon(regex, s)) {
+            s = s->out1;
+        } else {
+            break;
+        }
+    }
+    return len;
+}
+
+/* 提取必需字面量，没有时返回0 */
+static size_t set_required_literal(vox_mpool_t* mpool, const vox_regex_t* regex, char* buf, size_t cap) {
+    int n = regex->state_count;
+    nfa_state_t** table = (nfa_state_t**)vox_mpool_alloc(mpool, sizeof(nfa_state_t*) * n);
+    nfa_state_t** stack = (nfa_state_t**)vox_mpool_alloc(mpool, sizeof(nfa_state_t*) * n);
+    uint8_t* seen = (uint8_t*)vox_mpool_alloc(mpool, (size_t)n);
+    char* run = (char*)vox_mpool_alloc(mpool, cap);
+    size_t best = 0;
+    if (!table || !stack || !seen || !run) goto done;
+    memset(table, 0, sizeof(nfa_state_t*) * n);
+    set_collect_states(regex->start, table);
+
+    /* 字面量越长过滤效果越好：按链长从长到短检查必经性 */
+    for (;;) {
+        size_t cand_len = 0;
+        int cand_id = -1;
+        for (int i = 0; i < n; i++) {
+            nfa_state_t* s = table[i];
+            if (!s || s->type != NFA_STATE_CHAR || set_state_is_epsilon(regex, s)) continue;
+            size_t len = set_forced_run(regex, s, run, cap);
+            if (len > cand_len) {
+                cand_len = len;
+                cand_id = i;
+            }
+        }
+        if (cand_id < 0) break;
+        if (!set_reaches_match(regex, table[cand_id], stack, seen)) {
+            best = set_forced_run(regex, table[cand_id], buf, cap);
+            break;
+        }
+        table[cand_id] = NULL;  /* 不是必经状态，不再考虑 */
+    }
+
+done:
+    if (run) vox_mpool_free(mpool, run);
+    if (seen) vox_mpool_free(mpool, seen);
+    if (stack) vox_mpool_free(mpool, stack);
+    if (table) vox_mpool_free(mpool, table);
+    return best;
+}
+
+/* 构建 Aho-Corasick 自动机 */
+static int set_build_automaton(vox_regex_set_t* set, char** literals, size_t* lengths) {
+    vox_mpool_t* mpool = set->mpool;
+    bool ignore_case = (set->flags & VOX_REGEX_IGNORE_CASE) != 0;
+
+    /* 字节类：字面量中出现的字节各占一类，忽略大小写时大小写同类 */
+    memset(set->cls, 0, sizeof(set->cls));
+    set->ncls = 1;
+    size_t total = 0;
+    for (size_t i = 0; i < set->count; i++) {
+        total += lengths[i];
+        for (size_t j = 0; j < lengths[i]; j++) {
+            unsigned char c = (unsigned char)literals[i][j];
+            if (set->cls[c]) continue;
+            set->cls[c] = (uint8_t)set->ncls;
+            if (ignore_case && c >= 'a' && c <= 'z') set->cls[c - 'a' + 'A'] = (uint8_t)set->ncls;
+            set->ncls++;
+        }
+    }
+
+    size_t max_nodes = total + 1;
+    set->ac_next = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * max_nodes * set->ncls);
+    set->ac_out = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * max_nodes);
+    set->ac_dict = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * max_nodes);
+    set->out_pattern = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * (set->count + 1));
+    set->out_next = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * (set->count + 1));
+    int32_t* fail = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * max_nodes);
+    int32_t* queue = (int32_t*)vox_mpool_alloc(mpool, sizeof(int32_t) * max_nodes);
+    if (!set->ac_next || !set->ac_out || !set->ac_dict || !set->out_pattern ||
+        !set->out_next || !fail || !queue) {
+        if (fail) vox_mpool_free(mpool, fail);
+        if (queue) vox_mpool_free(mpool, queue);
+        return -1;
+    }
+    memset(set->ac_next, 0xff, sizeof(int32_t) * max_nodes * set->ncls);
+    memset(set->ac_out, 0xff, sizeof(int32_t) * max_nodes);
+    memset(set->ac_dict, 0xff, sizeof(int32_t) * max_nodes);
+
+    /* 字典树 */
+    int ncls = set->ncls;
+    set->node_count = 1;
+    size_t out_count = 0;
+    for (size_t i = 0; i < set->count; i++) {
+        if (lengths[i] == 0) continue;
+        int32_t node = 0;
+        for (size_t j = 0; j < lengths[i]; j++) {
+            int c = set->cls[(unsigned char)literals[i][j]];
+            if (set->ac_next[node * ncls + c] < 0) {
+                set->ac_next[node * ncls + c] = (int32_t)set->node_count++;
+            }
+            node = set->ac_next[node * ncls + c];
+        }
+        set->out_pattern[out_count] = (int32_t)i;
+        set->out_next[out_count] = set->ac_out[node];
+        set->ac_out[node] = (int32_t)out_count++;
+    }
+
+    /* 广度优先计算失败链接，并把缺失的转移补全为确定性转移 */
+    size_t head = 0, tail = 0;
+    fail[0] = 0;
+    for (int c = 0; c < ncls; c++) {
+        int32_t child = set->ac_next[c];
+        if (child < 0) {
+            set->ac_next[c] = 0;
+        } else {
+            fail[child] = 0;
+            queue[tail++] = child;
+        }
+    }
+    while (head < tail) {
+        int32_t node = queue[head++];
+        int32_t f = fail[node];
+        set->ac_dict[node] = (set->ac_out[f] >= 0) ? f : set->ac_dict[f];
+        for (int c = 0; c < ncls; c++) {
+            int32_t child = set->ac_next[node * ncls + c];
+            if (child < 0) {
+                set->ac_next[node * ncls + c] = set->ac_next[f * ncls + c];
+            } else {
+                fail[child] = set->ac_next[f * ncls + c];
+                queue[tail++] = child;
+            }
+        }
+    }
+
+    vox_mpool_free(mpool, fail);
+    vox_mpool_free(mpool, queue);
+
+    /* 根节点上不开始任何字面量的字节仍停在根节点，可整段跳过 */
+    set->nfirst = 0;
+    for (int b = 0; b < 256; b++) {
+        uint8_t c = set->cls[b];
+        if (c == 0 || set->ac_next[c] == 0) continue;
+        if (set->nfirst == SET_SKIP_MAX) {
+            set->nfirst = 0;
+            break;
+        }
+        set->first[set->nfirst++] = (uint8_t)b;
+    }
+    return 0;
+}
+
+vox_regex_set_t* vox_regex_set_compile(vox_mpool_t* mpool, const char* const* patterns,
+                                       size_t count, int flags) {
+    if (!mpool || (!patterns && count > 0)) return NULL;
+
+    vox_regex_set_t* set = (vox_regex_set_t*)vox_mpool_alloc(mpool, sizeof(vox_regex_set_t));
+    if (!set) return NULL;
+    memset(set, 0, sizeof(vox_regex_set_t));
+    set->mpool = mpool;
+    set->flags = flags;
+    set->count = count;
+
+    size_t n = count ? count : 1;
+    set->regexes = (vox_regex_t**)vox_mpool_alloc(mpool, sizeof(vox_regex_t*) * n);
+    set->has_literal = (bool*)vox_mpool_alloc(mpool, sizeof(bool) * n);
+    set->candidate = (uint8_t*)vox_mpool_alloc(mpool, n);
+    char** literals = (char**)vox_mpool_alloc(mpool, sizeof(char*) * n);
+    size_t* lengths = (size_t*)vox_mpool_alloc(mpool, sizeof(size_t) * n);
+    if (!set->regexes || !set->has_literal || !set->candidate || !literals || !lengths) {
+        if (literals) vox_mpool_free(mpool, literals);
+        if (lengths) vox_mpool_free(mpool, lengths);
+        vox_regex_set_destroy(set);
+        return NULL;
+    }
+    memset(set->regexes, 0, sizeof(vox_regex_t*) * n);
+    memset(literals, 0, sizeof(char*) * n);
+    memset(lengths, 0, sizeof(size_t) * n);
+
+    int ret = 0;
+    for (size_t i = 0; i < count && ret == 0; i++) {
+        set->regexes[i] = patterns[i] ? vox_regex_compile(mpool, patterns[i], flags) : NULL;
+        if (!set->regexes[i]) {
+            ret = -1;
+            break;
+        }
+        literals[i] = (char*)vox_mpool_alloc(mpool, 256);
+        if (!literals[i]) {
+            ret = -1;
+            break;
+        }
+        lengths[i] = set_required_literal(mpool, set->regexes[i], literals[i], 256);
+        set->has_literal[i] = lengths[i] > 0;
+        if (set->has_literal[i]) set->literal_count++;
+    }
+    if (ret == 0) ret = set_build_automaton(set, literals, lengths);
+
+    for (size_t i = 0; i < count; i++) {
+        if (literals[i]) vox_mpool_free(mpool, literals[i]);
+    }
+    vox_mpool_free(mpool, literals);
+    vox_mpool_free(mpool, lengths);
+
+    if (ret != 0) {
+        vox_regex_set_destroy(set);
+        return NULL;
+    }
+    return set;
+}
+
+void vox_regex_set_destroy(vox_regex_set_t* set) {
+    if (!set) return;
+    vox_mpool_t* mpool = set->mpool;
+    if (set->regexes) {
+        for (size_t i = 0; i < set->count; i++) {
+            vox_regex_destroy(set->regexes[i]);
+        }
+        vox_mpool_free(mpool, set->regexes);
+    }
+    if (set->has_literal) vox_mpool_free(mpool, set->has_literal);
+    if (set->candidate) vox_mpool_free(mpool, set->candidate);
+    if (set->ac_next) vox_mpool_free(mpool, set->ac_next);
+    if (set->ac_out) vox_mpool_free(mpool, set->ac_out);
+    if (set->ac_dict) vox_mpool_free(mpool, set->ac_dict);
+    if (set->out_pattern) vox_mpool_free(mpool, set->out_pattern);
+    if (set->out_next) vox_mpool_free(mpool, set->out_next);
+    vox_mpool_free(mpool, set);
+}
+
+size_t vox_regex_set_size(const vox_regex_set_t* set) {
+    return set ? set->count : 0;
+}
+
+/* 16 字节一组查找首字节：返回组内命中位掩码 */
+#if defined(VOX_REGEX_SSE2)
+static inline uint32_t set_first_mask(const vox_regex_set_t* set, const char* p) {
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    __m128i m = _mm_cmpeq_epi8(v, _mm_set1_epi8((char)set->first[0]));
+    for (int k = 1; k < set->nfirst; k++) {
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8((char)set->first[k])));
+    }
+    return (uint32_t)_mm_movemask_epi8(m);
+}
+#elif defined(VOX_REGEX_NEON)
+static inline uint32_t set_first_mask(const vox_regex_set_t* set, const char* p) {
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t v = vld1q_u8((const uint8_t*)p);
+    uint8x16_t m = vceqq_u8(v, vdupq_n_u8(set->first[0]));
+    for (int k = 1; k < set->nfirst; k++) {
+        m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8(set->first[k])));
+    }
+    m = vandq_u8(m, vld1q_u8(bits));
+    return (uint32_t)vaddv_u8(vget_low_u8(m)) | ((uint32_t)vaddv_u8(vget_high_u8(m)) << 8);
+}
+#endif
+
+/* 在根节点时跳到下一个可能开始字面量的位置，无则返回 text_len */
+static inline size_t set_skip_root(const vox_regex_set_t* set, const char* text, size_t i, size_t text_len) {
+#if defined(VOX_REGEX_SSE2) || defined(VOX_REGEX_NEON)
+    if (set->nfirst > 0) {
+        for (; i + 16 <= text_len; i += 16) {
+            uint32_t mask = set_first_mask(set, text + i);
+            if (mask) {
+#if defined(_MSC_VER)
+                unsigned long idx;
+                _BitScanForward(&idx, mask);
+                return i + idx;
+#else
+                return i + (size_t)__builtin_ctz(mask);
+#endif
+            }
+        }
+    }
+#endif
+    const int32_t* root = set->ac_next;
+    while (i < text_len && root[set->cls[(unsigned char)text[i]]] == 0) i++;
+    return i;
+}
+
+/* 单遍扫描文本，标记包含必需字面量的候选模式 */
+static void set_scan_literals(vox_regex_set_t* set, const char* text, size_t text_len) {
+    memset(set->candidate, 0, set->count);
+    size_t remaining = set->literal_count;
+    if (remaining == 0) return;
+
+    const int32_t* next = set->ac_next;
+    int ncls = set->ncls;
+    int32_t node = 0;
+    for (size_t i = 0; i < text_len; i++) {
+        if (node == 0) {
+            i = set_skip_root(set, text, i, text_len);
+            if (i >= text_len) break;
+        }
+        node = next[node * ncls + set->cls[(unsigned char)text[i]]];
+        if (set->ac_out[node] < 0 && set->ac_dict[node] < 0) continue;
+        for (int32_t m = (set->ac_out[node] >= 0) ? node : set->ac_dict[node]; m >= 0; m = set->ac_dict[m]) {
+            for (int32_t o = set->ac_out[m]; o >= 0; o = set->out_next[o]) {
+                int32_t id = set->out_pattern[o];
+                if (!set->candidate[id]) {
+                    set->candidate[id] = 1;
+                    remaining--;
+                }
+            }
+        }
+        if (remaining == 0) break;  /* 所有字面量都已出现 */
+    }
+}
+
+size_t vox_regex_set_match(vox_regex_set_t* set, const char* text, size_t text_len,
+                           size_t* ids, size_t max_ids) {
+    if (!set || !text) return 0;
+
+    set_scan_literals(set, text, text_len);
+
+    size_t matched = 0;
+    for (size_t i = 0; i < set->count; i++) {
+        if (set->has_literal[i] && !set->candidate[i]) continue;
+        if (!vox_regex_search(set->regexes[i], text, text_len, 0, NULL)) continue;
+        if (ids && matched < max_ids) ids[matched] = i;
+        matched++;
+    }
+    return matched;
+}
+
+bool vox_regex_set_is_match(vox_regex_set_t* set, const char* text, size_t text_len) {
+    if (!set || !text) return false;
+
+    set_scan_literals(set, text, text_len);
+
+    for (size_t i = 0; i < set->count; i++) {
+        if (set->has_literal[i] && !set->candidate[i]) continue;
+        if (vox_regex_search(set->regexes[i], text, text_len, 0, NULL)) return true;
+    }
+    return false;
+}
@@ -1,6 +1,12 @@
 /*
  * vox_regex.h - 高性能正则表达式引擎
  * 使用NFA（非确定性有限自动机）实现，支持基本正则表达式功能
+ *
+ * 执行引擎：
+ * - 不含环视断言的模式使用惰性 DFA：状态在匹配时按需确定化并缓存，
+ *   搜索对未命中的文本只做一次线性扫描；缓存有上限，超出时清空并回退到 NFA 模拟
+ * - 含环视断言的模式以及需要捕获组位置时使用 NFA 模拟
+ * - 匹配会更新正则对象内部的 DFA 缓存，同一对象不能在多个线程中并发使用
  */
 
 #ifndef VOX_REGEX_H
@@ -26,7 +32,8 @@ typedef enum {
     VOX_REGEX_NONE = 0,           /* 无选项 */
     VOX_REGEX_IGNORE_CASE = 1,    /* 忽略大小写 */
     VOX_REGEX_MULTILINE = 2,      /* 多行模式（^和$匹配行首行尾） */
-    VOX_REGEX_DOTALL = 4          /* .匹配换行符 */
+    VOX_REGEX_DOTALL = 4,         /* .匹配换行符 */
+    VOX_REGEX_NFA_ONLY = 8        /* 禁用惰性 DFA，只用 NFA 模拟（用于对比和调试） */
 } vox_regex_flag_t;
 
 /**
@@ -146,6 +153,71 @@ int vox_regex_replace(vox_regex_t* regex, const char* text, size_t text_len,
  */
 void vox_regex_free_matches(vox_regex_t* regex, vox_regex_match_t* matches, size_t match_count);
 
+/* 惰性 DFA 统计（用于测试与调优） */
+typedef struct {
+    size_t states;            /* 当前缓存的 DFA 状态数（含死状态） */
+    size_t cache_flushes;     /* 缓存超限清空的次数（清空后该次匹配回退到 NFA 模拟） */
+    uint64_t steps;           /* DFA 运行与最左起点扫描累计处理的文本位置数 */
+} vox_regex_dfa_stats_t;
+
+/**
+ * 获取惰性 DFA 统计（自编译起累计）
+ * @param regex 正则表达式对象指针
+ * @param stats 输出统计
+ * @return 成功返回0；未使用惰性 DFA（VOX_REGEX_NFA_ONLY 或含环视断言）时返回-1，stats 清零
+ */
+int vox_regex_get_dfa_stats(const vox_regex_t* regex, vox_regex_dfa_stats_t* stats);
+
+/* ===== 正则表达式集合 ===== */
+
+/* 正则表达式集合不透明类型：一次扫描判断多个模式中哪些在文本中有匹配 */
+typedef struct vox_regex_set vox_regex_set_t;
+
+/**
+ * 编译正则表达式集合
+ * @param mpool 内存池指针，必须非NULL
+ * @param patterns 模式字符串数组，模式编号为数组下标
+ * @param count 模式数量
+ * @param flags 编译选项标志（对所有模式生效）
+ * @return 成功返回集合指针，任一模式编译失败返回NULL
+ * 
+ * 每个模式中任何匹配都必须包含的字面量会被提取出来，组成 Aho-Corasick 预过滤器：
+ * 匹配时先对文本扫描一遍，只有出现了必需字面量的模式（以及没有必需字面量的模式）才做正则验证
+ */
+vox_regex_set_t* vox_regex_set_compile(vox_mpool_t* mpool, const char* const* patterns,
+                                       size_t count, int flags);
+
+/**
+ * 销毁正则表达式集合
+ * @param set 集合指针
+ */
+void vox_regex_set_destroy(vox_regex_set_t* set);
+
+/**
+ * 获取集合中的模式数量
+ */
+size_t vox_regex_set_size(const vox_regex_set_t* set);
+
+/**
+ * 查找文本中有匹配（等同于 vox_regex_search 成功）的所有模式
+ * @param set 集合指针
+ * @param text 要搜索的文本
+ * @param text_len 文本长度（字节数）
+ * @param ids 输出匹配的模式编号（升序，最多 max_ids 个，可为NULL）
+ * @param max_ids ids 数组容量
+ * @return 返回匹配的模式总数（可能大于 max_ids）
+ * 
+ * 注意：集合内部有匹配用的缓存，同一集合不能在多个线程中并发使用
+ */
+size_t vox_regex_set_match(vox_regex_set_t* set, const char* text, size_t text_len,
+                           size_t* ids, size_t max_ids);
+
+/**
+ * 判断是否有任一模式在文本中有匹配
+ * @return 有匹配返回true，否则返回false
+ */
+bool vox_regex_set_is_match(vox_regex_set_t* set, const char* text, size_t text_len);
+
 #ifdef __cplusplus
 }
 #endif
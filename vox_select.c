@@ -6,7 +6,7 @@
 #include "vox_os.h"
 #include "vox_backend.h"
 #include "vox_mpool.h"
-#include "vox_htable.h"
+#include "vox_fdtable.h"
 #include "vox_socket.h"
 #include "vox_log.h"
 #include <string.h>
@@ -53,7 +53,7 @@ struct vox_select {
     fd_set read_fds;                 /* 读文件描述符集合 */
     fd_set write_fds;                /* 写文件描述符集合 */
     fd_set error_fds;                /* 错误文件描述符集合 */
-    vox_htable_t* fd_map;            /* fd -> fd_info 映射 */
+    vox_fdtable_t* fd_map;           /* fd -> fd_info 映射（按 fd 升序遍历） */
     vox_mpool_t* mpool;              /* 内存池 */
     bool own_mpool;                  /* 是否拥有内存池 */
     bool initialized;                /* 是否已初始化 */
@@ -72,26 +72,8 @@ typedef struct {
     int* event_count;
 } vox_select_poll_ctx_t;
 
-/* 查找最大 fd 的上下文结构 */
-typedef struct {
-    int max_fd;
-} find_max_fd_ctx_t;
-
-/* 查找最大 fd 的回调函数 */
-static void find_max_fd_cb(const void* key, size_t key_len, void* value, void* user_data) {
-    (void)key_len;
-    (void)value;
-    int current_fd = *(const int*)key;
-    find_max_fd_ctx_t* ctx = (find_max_fd_ctx_t*)user_data;
-    if (current_fd > ctx->max_fd) {
-        ctx->max_fd = current_fd;
-    }
-}
-
-/* 事件处理回调（用于 htable foreach） */
-static void process_events_cb(const void* key, size_t key_len, void* value, void* user_data) {
-    (void)key_len;
-    int fd = *(const int*)key;
+/* 事件处理回调（用于 fdtable foreach） */
+static void process_events_cb(int fd, void* value, void* user_data) {
     vox_select_fd_info_t* info = (vox_select_fd_info_t*)value;
     vox_select_poll_ctx_t* ctx = (vox_select_poll_ctx_t*)user_data;
     
@@ -176,7 +158,7 @@ vox_select_t* vox_select_create(const vox_select_config_t* config) {
     FD_ZERO(&select->error_fds);
     
     /* 创建 fd 映射表 */
-    select->fd_map = vox_htable_create(select->mpool);
+    select->fd_map = vox_fdtable_create(select->mpool);
     if (!select->fd_map) {
         vox_mpool_free(select->mpool, select);
         if (own_mpool) {
@@ -337,8 +319,7 @@ int vox_select_init(vox_select_t* select) {
     wakeup_info->user_data = NULL;
     
     /* 添加到映射表 */
-    int key = select->wakeup_fd[0];
-    vox_htable_set(select->fd_map, &key, sizeof(key), wakeup_info);
+    vox_fdtable_set(select->fd_map, select->wakeup_fd[0], wakeup_info);
     
     /* 添加到读集合 */
     FD_SET(select->wakeup_fd[0], &select->read_fds);
@@ -379,7 +360,7 @@ void vox_select_destroy(vox_select_t* select) {
     
     /* 销毁映射表 */
     if (select->fd_map) {
-        vox_htable_destroy(select->fd_map);
+        vox_fdtable_destroy(select->fd_map);
     }
     
     /* 释放内存 */
@@ -405,8 +386,7 @@ int vox_select_add(vox_select_t* select, int fd, uint32_t events, void* user_dat
     }
     
     /* 检查是否已存在 */
-    int key = fd;
-    vox_select_fd_info_t* info = (vox_select_fd_info_t*)vox_htable_get(select->fd_map, &key, sizeof(key));
+    vox_select_fd_info_t* info = (vox_select_fd_info_t*)vox_fdtable_get(select->fd_map, fd);
     if (info) {
         /* 已存在，修改事件 */
         return vox_select_modify(select, fd, events);
@@ -429,7 +409,10 @@ int vox_select_add(vox_select_t* select, int fd, uint32_t events, void* user_dat
     info->user_data = user_data;
     
     /* 添加到映射表 */
-    vox_htable_set(select->fd_map, &key, sizeof(key), info);
+    if (vox_fdtable_set(select->fd_map, fd, info) != 0) {
+        vox_mpool_free(select->mpool, info);
+        return -1;
+    }
     
     /* 添加到相应的文件描述符集合 */
     if (events & VOX_BACKEND_READ) {
@@ -456,8 +439,7 @@ int vox_select_modify(vox_select_t* select, int fd, uint32_t events) {
         return -1;
     }
     
-    int key = fd;
-    vox_select_fd_info_t* info = (vox_select_fd_info_t*)vox_htable_get(select->fd_map, &key, sizeof(key));
+    vox_select_fd_info_t* info = (vox_select_fd_info_t*)vox_fdtable_get(select->fd_map, fd);
     if (!info) {
         return -1;
     }
@@ -490,8 +472,7 @@ int vox_select_remove(vox_select_t* select, int fd) {
         return -1;
     }
     
-    int key = fd;
-    vox_select_fd_info_t* info = (vox_select_fd_info_t*)vox_htable_get(select->fd_map, &key, sizeof(key));
+    vox_select_fd_info_t* info = (vox_select_fd_info_t*)vox_fdtable_get(select->fd_map, fd);
     if (!info) {
         return -1;
     }
@@ -501,19 +482,12 @@ int vox_select_remove(vox_select_t* select, int fd) {
     FD_CLR(fd, &select->write_fds);
     FD_CLR(fd, &select->error_fds);
     
-    /* 从映射表中移除 */
-    vox_htable_delete(select->fd_map, &key, sizeof(key));
+    /* 从映射表中移除并释放 */
+    vox_fdtable_remove(select->fd_map, fd);
+    vox_mpool_free(select->mpool, info);
     
-    /* 更新最大文件描述符（需要重新计算） */
-    if (fd == select->max_fd) {
-        select->max_fd = -1;
-        /* 遍历映射表找到新的最大 fd */
-        find_max_fd_ctx_t ctx = { .max_fd = -1 };
-        
-        vox_htable_foreach(select->fd_map, find_max_fd_cb, &ctx);
-        
-        select->max_fd = ctx.max_fd;
-    }
+    /* 更新最大文件描述符（fd 表自行维护） */
+    select->max_fd = vox_fdtable_max_fd(select->fd_map);
     
     return 0;
 }
@@ -581,7 +555,7 @@ int vox_select_poll(vox_select_t* select_impl, int timeout_ms, vox_select_event_
     };
     
     /* 遍历所有文件描述符，检查是否有事件 */
-    vox_htable_foreach(select_impl->fd_map, process_events_cb, &ctx);
+    vox_fdtable_foreach(select_impl->fd_map, process_events_cb, &ctx);
     
     return event_count;
 }
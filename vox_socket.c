@@ -679,8 +679,10 @@ int vox_socket_sendfile(vox_socket_t* sock, intptr_t file_fd_or_handle,
         int s = (int)sock->fd;
         off_t len = (off_t)count;
         int r = sendfile(fd, s, offset, &len, NULL, 0);
-        if (out_sent) *out_sent = (size_t)(r == 0 ? len : 0);
-        return (r == 0 && len > 0) ? 0 : -1;
+        /* EAGAIN/EINTR 时 len 仍返回已发送的字节数 */
+        if (r != 0 && errno != EAGAIN && errno != EINTR) len = 0;
+        if (out_sent) *out_sent = (size_t)len;
+        return (len > 0) ? 0 : -1;
     }
 #else
     (void)offset;
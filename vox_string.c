@@ -13,6 +13,9 @@
 /* 默认初始容量 */
 #define VOX_STRING_DEFAULT_INITIAL_CAPACITY 32
 
+/* 内联存储大小（包括'\0'）：结构体正好占满内存池 64 字节槽 */
+#define VOX_STRING_SSO_CAPACITY 32
+
 /* 快速字符串长度计算的阈值 */
 #define VOX_STRING_FAST_LEN_THRESHOLD 16
 
@@ -71,14 +74,22 @@ int vox_strview_compare_cstr(const vox_strview_t* sv, const char* cstr) {
 
 /* ===== 字符串对象实现 ===== */
 
-/* 字符串结构 */
+/* 字符串结构
+ * 短字符串（容量不超过 VOX_STRING_SSO_CAPACITY）直接存放在结构体内的 sso 中，
+ * 创建和短字符串赋值只需一次分配；超出后 data 指向内存池分配的缓冲区 */
 struct vox_string {
     vox_mpool_t* mpool;      /* 内存池 */
-    char* data;               /* 字符串数据 */
+    char* data;               /* 字符串数据（指向 sso 或堆缓冲区） */
     size_t length;            /* 当前长度（不包括'\0'） */
     size_t capacity;          /* 容量（包括'\0'） */
+    char sso[VOX_STRING_SSO_CAPACITY]; /* 内联存储 */
 };
 
+/* 数据是否存放在内联存储中 */
+static inline bool is_inline(const vox_string_t* str) {
+    return str->data == str->sso;
+}
+
 /* 快速计算字符串长度（优化：对于短字符串避免 strlen 的开销） */
 static inline size_t fast_strlen(const char* str) {
     if (!str) return 0;
@@ -183,7 +194,9 @@ static inline int ensure_capacity(vox_string_t* str, size_t needed) {
         } else {
             memcpy(new_data, str->data, copy_len);  /* 包括'\0' */
         }
-        vox_mpool_free(str->mpool, str->data);
+        if (!is_inline(str)) {
+            vox_mpool_free(str->mpool, str->data);
+        }
     } else {
         new_data[0] = '\0';
     }
@@ -221,14 +234,20 @@ vox_string_t* vox_string_create_with_config(vox_mpool_t* mpool, const vox_string
         initial_capacity = config->initial_capacity;
     }
     
-    str->capacity = initial_capacity;
     str->length = 0;
     
-    /* 分配字符串数据 */
-    str->data = (char*)vox_mpool_alloc(str->mpool, str->capacity);
-    if (!str->data) {
-        vox_mpool_free(str->mpool, str);
-        return NULL;
+    if (initial_capacity <= VOX_STRING_SSO_CAPACITY) {
+        /* 使用内联存储，无需额外分配 */
+        str->data = str->sso;
+        str->capacity = VOX_STRING_SSO_CAPACITY;
+    } else {
+        /* 分配字符串数据 */
+        str->capacity = initial_capacity;
+        str->data = (char*)vox_mpool_alloc(str->mpool, str->capacity);
+        if (!str->data) {
+            vox_mpool_free(str->mpool, str);
+            return NULL;
+        }
     }
     
     str->data[0] = '\0';
@@ -299,8 +318,8 @@ void vox_string_destroy(vox_string_t* str) {
     /* 保存内存池指针 */
     vox_mpool_t* mpool = str->mpool;
     
-    /* 释放字符串数据 */
-    if (str->data) {
+    /* 释放字符串数据（内联存储随结构体释放） */
+    if (str->data && !is_inline(str)) {
         vox_mpool_free(mpool, str->data);
     }
     
@@ -813,7 +832,9 @@ int vox_string_reserve(vox_string_t* str, size_t capacity) {
     /* 复制旧数据 */
     if (str->data) {
         memcpy(new_data, str->data, str->length + 1);
-        vox_mpool_free(str->mpool, str->data);
+        if (!is_inline(str)) {
+            vox_mpool_free(str->mpool, str->data);
+        }
     } else {
         new_data[0] = '\0';
     }
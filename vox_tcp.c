@@ -1631,6 +1631,55 @@ int vox_tcp_write(vox_tcp_t* tcp, const void* buf, size_t len, vox_tcp_write_cb
     return 0;
 }
 
+/* 等待可写：队列中放入长度为0的请求，轮到它且可写事件到来时直接完成 */
+int vox_tcp_poll_writable(vox_tcp_t* tcp, vox_tcp_write_cb cb) {
+    if (!tcp || !cb || tcp->socket.fd == VOX_INVALID_SOCKET || !tcp->connected) {
+        return -1;
+    }
+
+#ifdef VOX_OS_WINDOWS
+    vox_backend_t* backend = vox_loop_get_backend(tcp->handle.loop);
+    if (backend && vox_backend_get_type(backend) == VOX_BACKEND_TYPE_IOCP) {
+        return -1;
+    }
+#endif
+
+    vox_mpool_t* mpool = vox_loop_get_mpool(tcp->handle.loop);
+    vox_tcp_write_req_t* req = (vox_tcp_write_req_t*)vox_mpool_alloc(
+        mpool, sizeof(vox_tcp_write_req_t));
+    if (!req) {
+        return -1;
+    }
+    req->buf = NULL;
+    req->len = 0;
+    req->offset = 0;
+    req->cb = cb;
+    req->next = NULL;
+
+    vox_tcp_write_req_t* last = (vox_tcp_write_req_t*)tcp->write_queue;
+    if (last) {
+        while (last->next) {
+            last = last->next;
+        }
+        last->next = req;
+    } else {
+        tcp->write_queue = (void*)req;
+    }
+
+    if (!(tcp->backend_events & VOX_BACKEND_WRITE)) {
+        if (tcp_update_backend(tcp, tcp->backend_events | VOX_BACKEND_WRITE) != 0) {
+            if (last) {
+                last->next = NULL;
+            } else {
+                tcp->write_queue = NULL;
+            }
+            vox_mpool_free(mpool, req);
+            return -1;
+        }
+    }
+    return 0;
+}
+
 /* 关闭写入端 */
 int vox_tcp_shutdown(vox_tcp_t* tcp, vox_tcp_shutdown_cb cb) {
     if (!tcp) {
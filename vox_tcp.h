@@ -214,6 +214,15 @@ int vox_tcp_read_stop(vox_tcp_t* tcp);
  */
 int vox_tcp_write(vox_tcp_t* tcp, const void* buf, size_t len, vox_tcp_write_cb cb);
 
+/**
+ * 等待 socket 可写（排在已提交的写入之后）
+ * 供直接写 socket 的调用方（如 sendfile）在发送缓冲区满时使用；IOCP backend 不支持
+ * @param tcp TCP 句柄指针
+ * @param cb 可写时调用一次（status 为0），连接关闭时以-1调用
+ * @return 成功返回0，失败返回-1
+ */
+int vox_tcp_poll_writable(vox_tcp_t* tcp, vox_tcp_write_cb cb);
+
 /**
  * 关闭写入端（shutdown）
  * @param tcp TCP 句柄指针
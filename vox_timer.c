@@ -72,6 +72,7 @@ int vox_timer_start(vox_timer_t* timer, uint64_t timeout_ms,
         timer->active = false;
         return -1;
     }
+    if (timer->weak) vox_loop_adjust_weak_timers(timer->loop, 1);
     
     return 0;
 }
@@ -87,8 +88,8 @@ int vox_timer_stop(vox_timer_t* timer) {
 
     /* 从堆中删除定时器 */
     vox_mheap_t* timers = vox_loop_get_timers(timer->loop);
-    if (timers) {
-        vox_mheap_remove(timers, timer);
+    if (timers && vox_mheap_remove(timers, timer) == 0 && timer->weak) {
+        vox_loop_adjust_weak_timers(timer->loop, -1);
     }
 
     return 0;
@@ -123,6 +124,7 @@ int vox_timer_again(vox_timer_t* timer) {
     /* 重新添加到堆 */
     if (vox_mheap_push(timers, timer) != 0) {
         timer->active = false;
+        if (timer->weak) vox_loop_adjust_weak_timers(timer->loop, -1);
         return -1;
     }
 
@@ -134,6 +136,15 @@ bool vox_timer_is_active(const vox_timer_t* timer) {
     return timer && timer->active;
 }
 
+/* 设置弱定时器（只能在停止状态下修改，保证堆中的弱定时器计数准确） */
+int vox_timer_set_weak(vox_timer_t* timer, bool weak) {
+    if (!timer || timer->active) {
+        return -1;
+    }
+    timer->weak = weak;
+    return 0;
+}
+
 /* 获取定时器的重复间隔 */
 uint64_t vox_timer_get_repeat(const vox_timer_t* timer) {
     if (!timer) {
@@ -188,6 +199,7 @@ void vox_timer_process_expired(vox_loop_t* loop) {
         /* 如果定时器已停止，移除并继续检查下一个 */
         if (!timer->active) {
             vox_mheap_pop(timers);
+            if (timer->weak) vox_loop_adjust_weak_timers(loop, -1);
             continue;
         }
 
@@ -198,19 +210,24 @@ void vox_timer_process_expired(vox_loop_t* loop) {
 
         /* 移除定时器 */
         vox_mheap_pop(timers);
+        if (timer->weak) vox_loop_adjust_weak_timers(loop, -1);
 
-        /* 执行回调 */
-        if (timer->callback) {
-            timer->callback(timer, timer->user_data);
-        }
-
-        /* 如果是重复定时器，重新添加 */
-        if (timer->repeat > 0 && timer->active) {
+        /* 回调之前完成重新入堆或停止，回调中可以安全地 stop/start 该定时器 */
+        if (timer->repeat > 0) {
             timer->timeout = now + timer->repeat;
-            vox_mheap_push(timers, timer);
+            if (vox_mheap_push(timers, timer) == 0) {
+                if (timer->weak) vox_loop_adjust_weak_timers(loop, 1);
+            } else {
+                timer->active = false;
+            }
         } else {
             timer->active = false;
         }
+
+        /* 执行回调 */
+        if (timer->callback) {
+            timer->callback(timer, timer->user_data);
+        }
     }
 }
 
@@ -229,6 +246,7 @@ int vox_timer_get_next_timeout(vox_loop_t* loop) {
     vox_timer_t* timer = (vox_timer_t*)vox_mheap_peek(timers);
     while (timer && !timer->active) {
         vox_mheap_pop(timers);
+        if (timer->weak) vox_loop_adjust_weak_timers(loop, -1);
         if (vox_mheap_empty(timers)) {
             return -1;
         }
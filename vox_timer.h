@@ -29,6 +29,7 @@ struct vox_timer {
     vox_timer_cb callback;       /* 回调函数 */
     void* user_data;             /* 用户数据 */
     bool active;                 /* 是否活跃 */
+    bool weak;                   /* 弱定时器：不阻止事件循环退出 */
 } ;
 
 /**
@@ -72,6 +73,15 @@ int vox_timer_again(vox_timer_t* timer);
  */
 bool vox_timer_is_active(const vox_timer_t* timer);
 
+/**
+ * 设置为弱定时器：事件循环只剩弱定时器时 vox_loop_run 不再等待它们而直接返回，
+ * 适合连接池清理等后台维护任务
+ * @param timer 定时器指针（必须处于停止状态）
+ * @param weak true 为弱定时器，false 恢复默认
+ * @return 成功返回0，定时器活跃时返回-1
+ */
+int vox_timer_set_weak(vox_timer_t* timer, bool weak);
+
 /**
  * 获取定时器的重复间隔
  * @param timer 定时器指针
@@ -11,6 +11,20 @@
 #include "vox_socket.h"
 #include <string.h>
 
+#ifdef VOX_OS_LINUX
+#include <errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/tls.h>
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
 /* 默认读取缓冲区大小 */
 #define VOX_TLS_DEFAULT_READ_BUF_SIZE 4096
 #define VOX_TLS_DEFAULT_BIO_BUF_SIZE 16384  /* BIO 缓冲区大小 */
@@ -38,6 +52,335 @@ static void tls_tcp_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void
 static void tls_tcp_write_cb(vox_tcp_t* tcp, int status, void* user_data);
 static void tls_tcp_connect_cb(vox_tcp_t* tcp, int status, void* user_data);
 static void tls_tcp_connection_cb(vox_tcp_t* server, int status, void* user_data);
+static void tls_ktls_try(vox_tls_t* tls);
+static void tls_ktls_flush(vox_tls_t* tls);
+
+/* ===== 内核 TLS ===== */
+
+/* 把一个方向的记录密钥安装到 socket（Linux kTLS） */
+static int tls_ktls_install(vox_tls_t* tls, vox_ssl_ktls_dir_t dir, const vox_ssl_ktls_keys_t* keys) {
+#ifdef VOX_OS_LINUX
+    union {
+        struct tls12_crypto_info_aes_gcm_128 aes128;
+        struct tls12_crypto_info_aes_gcm_256 aes256;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+        struct tls12_crypto_info_chacha20_poly1305 chacha;
+#endif
+    } info;
+    size_t info_len;
+    unsigned char seq[8];
+    for (int i = 0; i < 8; i++) {
+        seq[i] = (unsigned char)(keys->seq >> (56 - 8 * i));
+    }
+
+    memset(&info, 0, sizeof(info));
+    unsigned short version = keys->version == 0x0304 ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+    /* AES-GCM：salt 为 IV 的前4字节；TLS 1.3 的其余8字节是静态 IV，TLS 1.2 是显式 nonce 的起始值（取序号） */
+    switch (keys->cipher) {
+        case VOX_SSL_KTLS_AES_128_GCM:
+            info.aes128.info.version = version;
+            info.aes128.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+            memcpy(info.aes128.key, keys->key, TLS_CIPHER_AES_GCM_128_KEY_SIZE);
+            memcpy(info.aes128.salt, keys->iv, TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+            memcpy(info.aes128.iv, keys->iv_len == 12 ? keys->iv + 4 : seq, TLS_CIPHER_AES_GCM_128_IV_SIZE);
+            memcpy(info.aes128.rec_seq, seq, sizeof(seq));
+            info_len = sizeof(info.aes128);
+            break;
+        case VOX_SSL_KTLS_AES_256_GCM:
+            info.aes256.info.version = version;
+            info.aes256.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+            memcpy(info.aes256.key, keys->key, TLS_CIPHER_AES_GCM_256_KEY_SIZE);
+            memcpy(info.aes256.salt, keys->iv, TLS_CIPHER_AES_GCM_256_SALT_SIZE);
+            memcpy(info.aes256.iv, keys->iv_len == 12 ? keys->iv + 4 : seq, TLS_CIPHER_AES_GCM_256_IV_SIZE);
+            memcpy(info.aes256.rec_seq, seq, sizeof(seq));
+            info_len = sizeof(info.aes256);
+            break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+        case VOX_SSL_KTLS_CHACHA20_POLY1305:
+            info.chacha.info.version = version;
+            info.chacha.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+            memcpy(info.chacha.key, keys->key, TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE);
+            memcpy(info.chacha.iv, keys->iv, TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE);
+            memcpy(info.chacha.rec_seq, seq, sizeof(seq));
+            info_len = sizeof(info.chacha);
+            break;
+#endif
+        default:
+            return -1;
+    }
+
+    int fd = (int)tls->tcp->socket.fd;
+    int ret = 0;
+    if (!tls->ktls_ulp) {
+        if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 && errno != EEXIST) {
+            VOX_LOG_DEBUG("kTLS unavailable (TCP_ULP): %s", strerror(errno));
+            ret = -1;
+        } else {
+            tls->ktls_ulp = true;
+        }
+    }
+    if (ret == 0 && setsockopt(fd, SOL_TLS, dir == VOX_SSL_KTLS_TX ? TLS_TX : TLS_RX, &info, (socklen_t)info_len) != 0) {
+        VOX_LOG_DEBUG("kTLS %s setup failed: %s", dir == VOX_SSL_KTLS_TX ? "TX" : "RX", strerror(errno));
+        ret = -1;
+    }
+    memset(&info, 0, sizeof(info));
+    return ret;
+#else
+    (void)tls;
+    (void)dir;
+    (void)keys;
+    return -1;
+#endif
+}
+
+/* 尝试卸载一个方向：返回 true 表示已卸载 */
+static bool tls_ktls_try_dir(vox_tls_t* tls, vox_ssl_ktls_dir_t dir) {
+    vox_ssl_ktls_keys_t keys;
+    if (vox_ssl_session_get_ktls_keys(tls->ssl_session, dir, &keys) != 0) {
+        return false;  /* 不支持，或还有未处理的记录（下次再试） */
+    }
+    int ret = tls_ktls_install(tls, dir, &keys);
+    memset(&keys, 0, sizeof(keys));
+    if (ret != 0) {
+        vox_ssl_session_set_ktls(tls->ssl_session, dir, false);
+        if (!tls->ktls_ulp) {
+            /* 内核不支持 kTLS，另一方向也不必再尝试 */
+            vox_ssl_session_set_ktls(tls->ssl_session,
+                                     dir == VOX_SSL_KTLS_TX ? VOX_SSL_KTLS_RX : VOX_SSL_KTLS_TX, false);
+        }
+        return false;
+    }
+    vox_ssl_session_set_ktls(tls->ssl_session, dir, true);
+    return true;
+}
+
+/* 握手完成后，在记录边界上把发送/接收方向切换到内核 TLS */
+static void tls_ktls_try(vox_tls_t* tls) {
+    if (!tls->tls_connected || tls->handshaking || tls->shutting_down || !tls->ssl_session || !tls->tcp) {
+        return;
+    }
+
+    /* 发送：已交给 TCP 但未写出的密文必须先发完，否则会被内核再次加密 */
+    if (!tls->ktls_tx && !tls->tcp->write_queue && tls_ktls_try_dir(tls, VOX_SSL_KTLS_TX)) {
+        tls->ktls_tx = true;
+        tls_ktls_flush(tls);
+    }
+
+    /* 接收：之后 TCP 读到的是明文，读取的开关直接交给 TCP */
+    if (!tls->ktls_rx && tls_ktls_try_dir(tls, VOX_SSL_KTLS_RX)) {
+        tls->ktls_rx = true;
+        if (!tls->reading) {
+            vox_tcp_read_stop(tls->tcp);
+        }
+    }
+}
+
+/* 从写队列中移除头部请求，并回调 */
+static void tls_ktls_complete_head(vox_tls_t* tls, int status) {
+    vox_tls_write_req_t* req = (vox_tls_write_req_t*)tls->write_queue;
+    if (!req) {
+        return;
+    }
+    tls->write_queue = (void*)req->next;
+    if (tls->write_queue_tail == (void*)req) {
+        tls->write_queue_tail = NULL;
+    }
+    vox_tls_write_cb cb = req->cb;
+    vox_mpool_t* mpool = vox_loop_get_mpool(tls->handle.loop);
+    if (req->buf) {
+        vox_mpool_free(mpool, req->buf);
+    }
+    vox_mpool_free(mpool, req);
+    if (cb) {
+        cb(tls, status, vox_handle_get_data((vox_handle_t*)tls));
+    }
+}
+
+/* kTLS 模式下写队列头部完成 */
+static void tls_ktls_tcp_write_cb(vox_tcp_t* tcp, int status, void* user_data) {
+    (void)tcp;
+    vox_tls_t* tls = (vox_tls_t*)user_data;
+    if (!tls) {
+        return;
+    }
+    tls->ktls_write_pending = false;
+    tls_ktls_complete_head(tls, status == 0 ? 0 : -1);
+    tls_ktls_flush(tls);
+}
+
+/* kTLS 模式下把写队列中的明文逐个交给 TCP（同一时刻只有一个在途） */
+static void tls_ktls_flush(vox_tls_t* tls) {
+    while (tls->write_queue && !tls->ktls_write_pending) {
+        vox_tls_write_req_t* req = (vox_tls_write_req_t*)tls->write_queue;
+        tls->ktls_write_pending = true;
+        if (vox_tcp_write(tls->tcp, (const char*)req->buf + req->offset, req->len - req->offset,
+                          tls_ktls_tcp_write_cb) != 0) {
+            tls->ktls_write_pending = false;
+            tls_ktls_complete_head(tls, -1);
+        }
+    }
+}
+
+/* kTLS 模式写入：先尝试直接发送，剩余部分复制后排队 */
+static int tls_ktls_write(vox_tls_t* tls, const void* buf, size_t len, vox_tls_write_cb cb) {
+    size_t sent = 0;
+    if (!tls->write_queue && !tls->tcp->write_queue) {
+        int64_t n = vox_socket_send(&tls->tcp->socket, buf, len);
+        if (n > 0) {
+            sent = (size_t)n;
+        }
+        if (sent == len) {
+            if (cb) {
+                cb(tls, 0, vox_handle_get_data((vox_handle_t*)tls));
+            }
+            return 0;
+        }
+    }
+
+    vox_mpool_t* mpool = vox_loop_get_mpool(tls->handle.loop);
+    vox_tls_write_req_t* req = (vox_tls_write_req_t*)vox_mpool_alloc(mpool, sizeof(vox_tls_write_req_t));
+    if (!req) {
+        return -1;
+    }
+    req->buf = vox_mpool_alloc(mpool, len - sent);
+    if (!req->buf) {
+        vox_mpool_free(mpool, req);
+        return -1;
+    }
+    memcpy(req->buf, (const char*)buf + sent, len - sent);
+    req->len = len - sent;
+    req->offset = 0;
+    req->cb = cb;
+    req->next = NULL;
+
+    vox_tls_write_req_t* old_tail = (vox_tls_write_req_t*)tls->write_queue_tail;
+    if (old_tail) {
+        old_tail->next = req;
+    } else {
+        tls->write_queue = (void*)req;
+    }
+    tls->write_queue_tail = (void*)req;
+
+    tls_ktls_flush(tls);
+    return 0;
+}
+
+/* 向读取回调交付明文，返回已交付的字节数（回调中停止读取或 alloc_cb 不给缓冲区时提前返回） */
+static size_t tls_ktls_deliver(vox_tls_t* tls, const char* buf, size_t len) {
+    void* user_data = vox_handle_get_data((vox_handle_t*)tls);
+    if (!tls->reading || !tls->read_cb) {
+        return 0;
+    }
+    if (!tls->alloc_cb) {
+        tls->read_cb(tls, (ssize_t)len, buf, user_data);
+        return len;
+    }
+    /* 调用方提供缓冲区时按其大小分块复制 */
+    size_t done = 0;
+    while (done < len && tls->reading && tls->read_cb && tls->alloc_cb) {
+        void* dst = NULL;
+        size_t cap = 0;
+        tls->alloc_cb(tls, len - done, &dst, &cap, user_data);
+        if (!dst || cap == 0) {
+            break;
+        }
+        size_t n = len - done < cap ? len - done : cap;
+        memcpy(dst, buf + done, n);
+        done += n;
+        tls->read_cb(tls, (ssize_t)n, dst, user_data);
+    }
+    return done;
+}
+
+/* 交付上次读取中途停止时留下的明文，全部交付后释放 */
+static void tls_ktls_deliver_pending(vox_tls_t* tls) {
+    while (tls->ktls_pending && tls->reading) {
+        size_t off = tls->ktls_pending_off;
+        size_t n = tls_ktls_deliver(tls, (const char*)tls->ktls_pending + off, tls->ktls_pending_len - off);
+        if (!tls->ktls_pending) {
+            return;  /* 回调中已销毁 */
+        }
+        tls->ktls_pending_off += n;
+        if (tls->ktls_pending_off == tls->ktls_pending_len) {
+            vox_mpool_free(vox_loop_get_mpool(tls->handle.loop), tls->ktls_pending);
+            tls->ktls_pending = NULL;
+            tls->ktls_pending_len = 0;
+            tls->ktls_pending_off = 0;
+        } else if (n == 0) {
+            return;
+        }
+    }
+}
+
+/* kTLS 模式读取：TCP 读到的已是明文 */
+static void tls_ktls_read(vox_tls_t* tls, ssize_t nread, const void* buf) {
+    if (!tls->read_cb) {
+        return;
+    }
+    if (nread <= 0) {
+        /* 非应用数据记录（close_notify 等告警）在普通 recv 上表现为 EIO，同样按连接结束处理 */
+        tls->read_cb(tls, nread < 0 ? -1 : 0, NULL, vox_handle_get_data((vox_handle_t*)tls));
+        return;
+    }
+    size_t done = tls_ktls_deliver(tls, (const char*)buf, (size_t)nread);
+    if (done == (size_t)nread) {
+        return;
+    }
+    /* 读取中途停止：TCP 读缓冲会被下一次读取覆盖，余下的明文留到下次 read_start 交付 */
+    vox_mpool_t* mpool = vox_loop_get_mpool(tls->handle.loop);
+    size_t rest = (size_t)nread - done;
+    size_t kept = tls->ktls_pending ? tls->ktls_pending_len - tls->ktls_pending_off : 0;
+    char* pending = (char*)vox_mpool_alloc(mpool, kept + rest);
+    if (!pending) {
+        VOX_LOG_ERROR("Failed to buffer %zu bytes of kTLS plaintext", rest);
+        return;
+    }
+    if (kept > 0) {
+        memcpy(pending, (const char*)tls->ktls_pending + tls->ktls_pending_off, kept);
+    }
+    if (tls->ktls_pending) {
+        vox_mpool_free(mpool, tls->ktls_pending);
+    }
+    memcpy(pending + kept, (const char*)buf + done, rest);
+    tls->ktls_pending = pending;
+    tls->ktls_pending_len = kept + rest;
+    tls->ktls_pending_off = 0;
+    if (tls->reading) {
+        /* alloc_cb 没有给出缓冲区：停止 TCP 读取，等待调用方重新 read_start */
+        vox_tls_read_stop(tls);
+    }
+}
+
+/* 发送方向卸载后，由内核发出 close_notify 告警 */
+static int tls_ktls_send_close_notify(vox_tls_t* tls) {
+#ifdef VOX_OS_LINUX
+    /* 排队中的数据尚未写出时不能插队发送告警 */
+    if (tls->write_queue || tls->tcp->write_queue) {
+        return -1;
+    }
+    unsigned char alert[2] = {1, 0};  /* warning, close_notify */
+    char cbuf[CMSG_SPACE(sizeof(unsigned char))];
+    struct iovec iov;
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    memset(cbuf, 0, sizeof(cbuf));
+    iov.iov_base = alert;
+    iov.iov_len = sizeof(alert);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = cbuf;
+    msg.msg_controllen = sizeof(cbuf);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_TLS;
+    cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+    *CMSG_DATA(cmsg) = 21;  /* alert */
+    return sendmsg((int)tls->tcp->socket.fd, &msg, MSG_DONTWAIT) == (ssize_t)sizeof(alert) ? 0 : -1;
+#else
+    (void)tls;
+    return -1;
+#endif
+}
 
 /* 处理 rbio 数据：从 socket 读取后写入 rbio，然后尝试 SSL 操作 */
 static int tls_process_rbio_data(vox_tls_t* tls) {
@@ -127,8 +470,8 @@ static int tls_process_rbio_data(vox_tls_t* tls) {
         }
     }
 
-    /* 如果已连接，尝试读取解密后的数据 */
-    if (tls->tls_connected && tls->reading && tls->read_cb) {
+    /* 如果已连接，尝试读取解密后的数据（接收已卸载到内核时由 TCP 直接交付明文） */
+    if (tls->tls_connected && tls->reading && tls->read_cb && !tls->ktls_rx) {
         /* 循环读取，直到没有更多数据 */
         /* 限制循环次数，避免无限循环 */
         int max_iterations = 100;
@@ -210,6 +553,9 @@ static int tls_process_rbio_data(vox_tls_t* tls) {
         tls_process_wbio_data(tls);
     }
 
+    /* 握手后的记录都已处理完时尝试切换到内核 TLS */
+    tls_ktls_try(tls);
+
     return 0;
 }
 
@@ -228,6 +574,18 @@ static int tls_process_wbio_data(vox_tls_t* tls) {
             return 0;  /* 没有数据需要写入 */
         }
 
+        if (tls->ktls_tx) {
+            /* 发送已卸载后 OpenSSL 不应再产生记录（例如响应对端的 KeyUpdate），无法继续保持同步 */
+            VOX_LOG_ERROR("TLS record generated after kTLS TX offload, dropping connection");
+            char drain[256];
+            while (vox_ssl_bio_read(tls->ssl_session, VOX_SSL_BIO_WBIO, drain, sizeof(drain)) > 0) {
+            }
+            if (tls->read_cb) {
+                tls->read_cb(tls, -1, NULL, vox_handle_get_data((vox_handle_t*)tls));
+            }
+            return -1;
+        }
+
         /* 分配缓冲区 */
         vox_mpool_t* mpool = vox_loop_get_mpool(tls->handle.loop);
         if (!tls->wbio_buf || tls->wbio_buf_size < pending) {
@@ -279,6 +637,11 @@ static void tls_tcp_read_cb(vox_tcp_t* tcp, ssize_t nread, const void* buf, void
         return;
     }
 
+    if (tls->ktls_rx) {
+        tls_ktls_read(tls, nread, buf);
+        return;
+    }
+
     if (nread < 0) {
         /* 读取错误 */
         if (tls->read_cb) {
@@ -384,6 +747,9 @@ static void tls_tcp_write_cb(vox_tcp_t* tcp, int status, void* user_data) {
 
     /* 如果写入队列中有请求，继续处理 */
     tls_process_write_queue(tls);
+
+    /* 握手尾部的密文已发完，可以切换发送方向 */
+    tls_ktls_try(tls);
 }
 
 /* TCP 连接回调：TCP 连接成功后，开始 TLS 握手 */
@@ -439,6 +805,11 @@ static void tls_tcp_connect_cb(vox_tcp_t* tcp, int status, void* user_data) {
             return;
         }
     }
+
+    /* 设置 SNI 并尝试恢复该对端（主机:端口）的会话 */
+    if (tls->hostname && vox_ssl_session_set_hostname(tls->ssl_session, tls->hostname, tls->peer_port) != 0) {
+        VOX_LOG_WARN("Failed to set TLS hostname: %s", tls->hostname);
+    }
     
     /* 开始 TLS 握手 */
     if (vox_tls_handshake(tls, NULL) != 0) {
@@ -496,6 +867,12 @@ static void tls_process_write_queue(vox_tls_t* tls) {
         return;
     }
 
+    /* 发送已卸载：剩余明文直接交给内核加密 */
+    if (tls->ktls_tx) {
+        tls_ktls_flush(tls);
+        return;
+    }
+
     vox_mpool_t* mpool = vox_loop_get_mpool(tls->handle.loop);
     vox_tls_write_req_t* req = (vox_tls_write_req_t*)tls->write_queue;
 
@@ -699,6 +1076,11 @@ void vox_tls_destroy(vox_tls_t* tls) {
         tls->ssl_session = NULL;
     }
 
+    if (tls->hostname) {
+        vox_mpool_free(vox_loop_get_mpool(tls->handle.loop), tls->hostname);
+        tls->hostname = NULL;
+    }
+
     /* 销毁底层 TCP 句柄 */
     if (tls->tcp) {
         /* 清除 user_data 以防止回调访问正在销毁的 TLS 句柄 */
@@ -714,6 +1096,12 @@ void vox_tls_destroy(vox_tls_t* tls) {
         tls->read_buf = NULL;
         tls->read_buf_size = 0;
     }
+    if (tls->ktls_pending) {
+        vox_mpool_free(vox_loop_get_mpool(tls->handle.loop), tls->ktls_pending);
+        tls->ktls_pending = NULL;
+        tls->ktls_pending_len = 0;
+        tls->ktls_pending_off = 0;
+    }
 
     /* 释放 BIO 缓冲区 */
     vox_mpool_t* mpool = vox_loop_get_mpool(tls->handle.loop);
@@ -799,6 +1187,34 @@ int vox_tls_accept(vox_tls_t* server, vox_tls_t* client) {
     return 0;
 }
 
+/* 查询某个方向是否已卸载到内核 TLS */
+bool vox_tls_ktls_enabled(const vox_tls_t* tls, vox_ssl_ktls_dir_t dir) {
+    if (!tls) {
+        return false;
+    }
+    return dir == VOX_SSL_KTLS_TX ? tls->ktls_tx : tls->ktls_rx;
+}
+
+/* 设置服务器主机名：复制保存，connect 成功后握手前应用到 SSL 会话 */
+int vox_tls_set_hostname(vox_tls_t* tls, const char* hostname) {
+    if (!tls || !hostname || tls->handshaking || tls->tls_connected) {
+        return -1;
+    }
+
+    vox_mpool_t* mpool = vox_loop_get_mpool(tls->handle.loop);
+    size_t len = strlen(hostname);
+    char* copy = (char*)vox_mpool_alloc(mpool, len + 1);
+    if (!copy) {
+        return -1;
+    }
+    memcpy(copy, hostname, len + 1);
+    if (tls->hostname) {
+        vox_mpool_free(mpool, tls->hostname);
+    }
+    tls->hostname = copy;
+    return 0;
+}
+
 /* 异步连接 */
 int vox_tls_connect(vox_tls_t* tls, const vox_socket_addr_t* addr, vox_tls_connect_cb cb) {
     if (!tls || !tls->tcp || !addr) {
@@ -806,6 +1222,7 @@ int vox_tls_connect(vox_tls_t* tls, const vox_socket_addr_t* addr, vox_tls_conne
     }
 
     tls->connect_cb = cb;
+    tls->peer_port = vox_socket_get_port(addr);
 
     return vox_tcp_connect(tls->tcp, addr, tls_tcp_connect_cb);
 }
@@ -845,6 +1262,7 @@ int vox_tls_handshake(vox_tls_t* tls, vox_tls_handshake_cb cb) {
         if (cb) {
             cb(tls, 0, vox_handle_get_data((vox_handle_t*)tls));
         }
+        tls_ktls_try(tls);
     } else if (ret == VOX_SSL_ERROR_WANT_READ || ret == VOX_SSL_ERROR_WANT_WRITE) {
         /* 需要更多数据，这是正常的 */
         /* 处理 wbio 数据（发送握手消息到对端） */
@@ -889,6 +1307,14 @@ int vox_tls_read_start(vox_tls_t* tls, vox_tls_alloc_cb alloc_cb, vox_tls_read_c
     tls->alloc_cb = alloc_cb;
     tls->read_cb = read_cb;
 
+    /* 先交付上次中途停止时留下的明文；回调中再次停止读取时不恢复 TCP 读取 */
+    if (tls->ktls_pending) {
+        tls_ktls_deliver_pending(tls);
+        if (!tls->reading) {
+            return 0;
+        }
+    }
+
     /* 开始 TCP 读取（如果还没有开始） */
     if (!tls->tcp->reading) {
         if (vox_tcp_read_start(tls->tcp, NULL, tls_tcp_read_cb) != 0) {
@@ -917,6 +1343,11 @@ int vox_tls_read_stop(vox_tls_t* tls) {
     tls->read_cb = NULL;
     tls->alloc_cb = NULL;
 
+    /* 接收已卸载时 TCP 读到的是明文，必须真正停止读取，不能像 rbio 那样先缓存 */
+    if (tls->ktls_rx) {
+        vox_tcp_read_stop(tls->tcp);
+    }
+
     return 0;
 }
 
@@ -939,6 +1370,10 @@ int vox_tls_write(vox_tls_t* tls, const void* buf, size_t len, vox_tls_write_cb
         return -1;  /* TLS 未连接 */
     }
 
+    if (tls->ktls_tx) {
+        return tls_ktls_write(tls, buf, len, cb);
+    }
+
     vox_mpool_t* mpool = vox_loop_get_mpool(tls->handle.loop);
 
     /* 如果有待处理的写入请求，直接加入队列 */
@@ -1054,6 +1489,15 @@ int vox_tls_shutdown(vox_tls_t* tls, vox_tls_shutdown_cb cb) {
         return -1;
     }
 
+    if (tls->ktls_tx) {
+        /* 发送已卸载：close_notify 由内核按当前序号加密发出 */
+        int ret = tls_ktls_send_close_notify(tls);
+        if (cb) {
+            cb(tls, ret, vox_handle_get_data((vox_handle_t*)tls));
+        }
+        return ret;
+    }
+
     tls->shutdown_cb = cb;
     tls->shutting_down = true;
 
@@ -51,6 +51,8 @@ struct vox_tls {
     /* SSL Context 和 Session */
     vox_ssl_context_t* ssl_ctx;
     vox_ssl_session_t* ssl_session;
+    char* hostname;                       /* 服务器主机名（SNI、证书验证与会话恢复），客户端使用 */
+    uint16_t peer_port;                   /* connect 的目标端口（主机字节序），与主机名一起作为会话缓存键 */
 
     /* 回调函数 */
     vox_tls_connect_cb connect_cb;        /* 连接回调 */
@@ -80,6 +82,15 @@ struct vox_tls {
     size_t rbio_buf_size;                /* rbio 缓冲区大小 */
     void* wbio_buf;                      /* wbio 读取缓冲区（要写入 socket 的加密数据） */
     size_t wbio_buf_size;                /* wbio 缓冲区大小 */
+
+    /* 内核 TLS（SSL Context 配置 enable_ktls 时在握手后尝试） */
+    bool ktls_tx;                        /* 发送方向已卸载：明文直接写 socket，可使用 sendfile */
+    bool ktls_rx;                        /* 接收方向已卸载：从 socket 读到的就是明文 */
+    bool ktls_ulp;                       /* socket 已挂载 "tls" ULP */
+    bool ktls_write_pending;             /* 写队列头部已交给 TCP，等待完成 */
+    void* ktls_pending;                  /* 接收已卸载时读到但读取中途停止、尚未交付的明文 */
+    size_t ktls_pending_len;             /* 未交付明文的结束位置 */
+    size_t ktls_pending_off;             /* 已交付到的位置 */
 };
 
 /**
@@ -140,6 +151,24 @@ int vox_tls_accept(vox_tls_t* server, vox_tls_t* client);
  */
 int vox_tls_connect(vox_tls_t* tls, const vox_socket_addr_t* addr, vox_tls_connect_cb cb);
 
+/**
+ * 查询某一方向是否已卸载到内核 TLS
+ * 发送方向卸载后，写入的明文由内核加密，可直接对底层 socket 使用 sendfile（须在写队列为空时）
+ * @param tls TLS 句柄指针
+ * @param dir 方向
+ * @return 已卸载返回true，否则返回false
+ */
+bool vox_tls_ktls_enabled(const vox_tls_t* tls, vox_ssl_ktls_dir_t dir);
+
+/**
+ * 设置服务器主机名（客户端，须在 connect 之前调用）
+ * 用于 SNI 与证书主机名验证；同一 SSL Context 下按 主机名:端口 复用会话，重连时恢复握手
+ * @param tls TLS 句柄指针
+ * @param hostname 主机名或 IP 地址
+ * @return 成功返回0，失败返回-1
+ */
+int vox_tls_set_hostname(vox_tls_t* tls, const char* hostname);
+
 /**
  * 开始 TLS 握手（服务器端在 accept 后调用，客户端在 connect 后自动调用）
  * @param tls TLS 句柄指针
@@ -150,6 +179,8 @@ int vox_tls_handshake(vox_tls_t* tls, vox_tls_handshake_cb cb);
 
 /**
  * 开始异步读取
+ * 接收已卸载到内核 TLS 时，上次读取中途停止（回调内 read_stop 或 alloc_cb 未给出缓冲区）
+ * 留下的明文会在这里先交付
  * @param tls TLS 句柄指针
  * @param alloc_cb 缓冲区分配回调函数（可以为NULL，使用默认缓冲区）
  * @param read_cb 读取回调函数
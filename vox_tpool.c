@@ -36,12 +36,15 @@ typedef struct {
     vox_tpool_complete_func_t complete_func; /* 完成回调 */
 } vox_tpool_task_t;
 
+typedef struct vox_tpool_worker vox_tpool_worker_t;
+
 /* 线程池结构 */
 struct vox_tpool {
     vox_mpool_t* mpool;                   /* 内存池 */
     vox_queue_t* task_queue;              /* 任务队列 */
     vox_queue_type_t queue_type;          /* 队列类型 */
     vox_thread_t** threads;               /* 工作线程数组 */
+    vox_tpool_worker_t* workers;          /* 工作线程上下文数组（与 threads 一一对应） */
     size_t thread_count;                  /* 线程数量 */
     bool use_queue_mutex;                 /* 是否使用mutex保护队列（NORMAL类型且多线程时） */
     bool mutex_initialized;                /* mutex是否已初始化 */
@@ -51,14 +54,32 @@ struct vox_tpool {
     vox_mutex_t mutex;                    /* 互斥锁（用于保护NORMAL类型队列） */
     vox_semaphore_t semaphore;            /* 信号量（用于唤醒工作线程） */
     
-    /* 状态跟踪（使用原子变量） */
-    vox_atomic_int_t* state;              /* 线程池状态 */
-    vox_atomic_int_t* running_tasks;      /* 正在执行的任务数 */
-    vox_atomic_int_t* total_tasks;        /* 总任务数 */
-    vox_atomic_int_t* completed_tasks;    /* 已完成任务数 */
-    vox_atomic_int_t* failed_tasks;       /* 失败任务数 */
+    /* 状态跟踪（内嵌原子变量，各占一个缓存行） */
+    vox_atomic_int_padded_t state;        /* 线程池状态 */
+    vox_atomic_int_padded_t running_tasks; /* 正在执行的任务数 */
+    vox_atomic_long_padded_t total_tasks; /* 总任务数 */
+};
+
+/* 工作线程上下文：完成/失败数只由所属线程写入，按缓存行填充，统计时汇总 */
+struct vox_tpool_worker {
+    vox_tpool_t* tpool;                   /* 所属线程池 */
+    vox_atomic_long_padded_t completed;   /* 已完成任务数 */
+    vox_atomic_long_padded_t failed;      /* 失败任务数 */
 };
 
+/* 汇总所有工作线程的完成/失败数 */
+static void sum_worker_stats(const vox_tpool_t* tpool, int64_t* completed, int64_t* failed) {
+    int64_t c = 0, f = 0;
+    if (tpool->workers) {
+        for (size_t i = 0; i < tpool->thread_count; i++) {
+            c += vox_atomic_long_load(&tpool->workers[i].completed.value);
+            f += vox_atomic_long_load(&tpool->workers[i].failed.value);
+        }
+    }
+    if (completed) *completed = c;
+    if (failed) *failed = f;
+}
+
 /* 清理线程池资源（不释放线程池结构和内存池） */
 static void cleanup_tpool_resources(vox_tpool_t* tpool) {
     if (!tpool) return;
@@ -69,26 +90,10 @@ static void cleanup_tpool_resources(vox_tpool_t* tpool) {
         tpool->threads = NULL;
     }
     
-    /* 销毁原子变量 */
-    if (tpool->state) {
-        vox_atomic_int_destroy(tpool->state);
-        tpool->state = NULL;
-    }
-    if (tpool->running_tasks) {
-        vox_atomic_int_destroy(tpool->running_tasks);
-        tpool->running_tasks = NULL;
-    }
-    if (tpool->total_tasks) {
-        vox_atomic_int_destroy(tpool->total_tasks);
-        tpool->total_tasks = NULL;
-    }
-    if (tpool->completed_tasks) {
-        vox_atomic_int_destroy(tpool->completed_tasks);
-        tpool->completed_tasks = NULL;
-    }
-    if (tpool->failed_tasks) {
-        vox_atomic_int_destroy(tpool->failed_tasks);
-        tpool->failed_tasks = NULL;
+    /* 释放工作线程上下文 */
+    if (tpool->workers) {
+        vox_mpool_free(tpool->mpool, tpool->workers);
+        tpool->workers = NULL;
     }
     
     /* 销毁同步原语 */
@@ -110,15 +115,16 @@ static void cleanup_tpool_resources(vox_tpool_t* tpool) {
 
 /* 工作线程函数 */
 static int worker_thread_func(void* user_data) {
-    vox_tpool_t* tpool = (vox_tpool_t*)user_data;
-    if (!tpool) return -1;
+    vox_tpool_worker_t* worker = (vox_tpool_worker_t*)user_data;
+    if (!worker || !worker->tpool) return -1;
+    vox_tpool_t* tpool = worker->tpool;
     
     while (true) {
         /* 等待信号量（有新任务时会被唤醒） */
         vox_semaphore_wait(&tpool->semaphore);
         
         /* 检查线程池状态 */
-        int32_t state = vox_atomic_int_load(tpool->state);
+        int32_t state = vox_atomic_int_load(&tpool->state.value);
         if (state == VOX_TPOOL_STATE_SHUTDOWN) {
             /* 线程池已关闭，退出 */
             break;
@@ -138,7 +144,7 @@ static int worker_thread_func(void* user_data) {
         
         if (!task) {
             /* 队列为空，检查是否正在关闭 */
-            state = vox_atomic_int_load(tpool->state);
+            state = vox_atomic_int_load(&tpool->state.value);
             if (state == VOX_TPOOL_STATE_SHUTTING_DOWN || state == VOX_TPOOL_STATE_SHUTDOWN) {
                 /* 再次检查队列是否为空且没有正在执行的任务 */
                 bool queue_empty;
@@ -150,7 +156,7 @@ static int worker_thread_func(void* user_data) {
                     queue_empty = vox_queue_empty(tpool->task_queue);
                 }
                 
-                if (queue_empty && vox_atomic_int_load(tpool->running_tasks) == 0) {
+                if (queue_empty && vox_atomic_int_load(&tpool->running_tasks.value) == 0) {
                     /* 队列为空且没有正在执行的任务，退出 */
                     break;
                 }
@@ -160,7 +166,7 @@ static int worker_thread_func(void* user_data) {
         }
         
         /* 更新正在执行的任务数 */
-        vox_atomic_int_increment(tpool->running_tasks);
+        vox_atomic_int_increment(&tpool->running_tasks.value);
         
         /* 执行任务 */
         int result = 0;
@@ -178,13 +184,13 @@ static int worker_thread_func(void* user_data) {
         
         /* 更新统计信息 */
         if (result == 0) {
-            vox_atomic_int_increment(tpool->completed_tasks);
+            vox_atomic_long_increment(&worker->completed.value);
         } else {
-            vox_atomic_int_increment(tpool->failed_tasks);
+            vox_atomic_long_increment(&worker->failed.value);
         }
         
         /* 更新正在执行的任务数 */
-        vox_atomic_int_decrement(tpool->running_tasks);
+        vox_atomic_int_decrement(&tpool->running_tasks.value);
         
         /* 释放任务结构（使用内存池） */
         vox_mpool_free(tpool->mpool, task);
@@ -300,20 +306,24 @@ vox_tpool_t* vox_tpool_create_with_config(const vox_tpool_config_t* config) {
     }
     tpool->semaphore_initialized = true;
     
-    /* 创建原子变量 */
-    tpool->state = vox_atomic_int_create(mpool, VOX_TPOOL_STATE_RUNNING);
-    tpool->running_tasks = vox_atomic_int_create(mpool, 0);
-    tpool->total_tasks = vox_atomic_int_create(mpool, 0);
-    tpool->completed_tasks = vox_atomic_int_create(mpool, 0);
-    tpool->failed_tasks = vox_atomic_int_create(mpool, 0);
+    /* 初始化原子变量 */
+    vox_atomic_int_init(&tpool->state.value, VOX_TPOOL_STATE_RUNNING);
+    vox_atomic_int_init(&tpool->running_tasks.value, 0);
+    vox_atomic_long_init(&tpool->total_tasks.value, 0);
     
-    if (!tpool->state || !tpool->running_tasks || !tpool->total_tasks || 
-        !tpool->completed_tasks || !tpool->failed_tasks) {
+    /* 分配工作线程上下文 */
+    tpool->workers = (vox_tpool_worker_t*)vox_mpool_alloc(mpool, thread_count * sizeof(vox_tpool_worker_t));
+    if (!tpool->workers) {
         cleanup_tpool_resources(tpool);
         vox_mpool_free(mpool, tpool);
         vox_mpool_destroy(mpool);
         return NULL;
     }
+    for (size_t i = 0; i < thread_count; i++) {
+        tpool->workers[i].tpool = tpool;
+        vox_atomic_long_init(&tpool->workers[i].completed.value, 0);
+        vox_atomic_long_init(&tpool->workers[i].failed.value, 0);
+    }
     
     /* 分配线程数组 */
     tpool->threads = (vox_thread_t**)vox_mpool_alloc(mpool, thread_count * sizeof(vox_thread_t*));
@@ -328,10 +338,10 @@ vox_tpool_t* vox_tpool_create_with_config(const vox_tpool_config_t* config) {
     
     /* 创建工作线程 */
     for (size_t i = 0; i < thread_count; i++) {
-        tpool->threads[i] = vox_thread_create(mpool, worker_thread_func, tpool);
+        tpool->threads[i] = vox_thread_create(mpool, worker_thread_func, &tpool->workers[i]);
         if (!tpool->threads[i]) {
             /* 创建失败，清理已创建的线程 */
-            vox_atomic_int_store(tpool->state, VOX_TPOOL_STATE_SHUTDOWN);
+            vox_atomic_int_store(&tpool->state.value, VOX_TPOOL_STATE_SHUTDOWN);
             
             /* 唤醒所有等待的线程 */
             for (size_t j = 0; j < i + 1; j++) {
@@ -362,7 +372,7 @@ int vox_tpool_submit(vox_tpool_t* tpool, vox_tpool_task_func_t task_func,
     if (!tpool || !task_func) return -1;
     
     /* 检查线程池状态 */
-    int32_t state = vox_atomic_int_load(tpool->state);
+    int32_t state = vox_atomic_int_load(&tpool->state.value);
     if (state != VOX_TPOOL_STATE_RUNNING) {
         return -1;  /* 线程池已关闭，不接受新任务 */
     }
@@ -394,7 +404,7 @@ int vox_tpool_submit(vox_tpool_t* tpool, vox_tpool_task_func_t task_func,
     }
     
     /* 更新总任务数 */
-    vox_atomic_int_increment(tpool->total_tasks);
+    vox_atomic_long_increment(&tpool->total_tasks.value);
     
     /* 唤醒一个工作线程 */
     vox_semaphore_post(&tpool->semaphore);
@@ -421,10 +431,10 @@ int vox_tpool_wait(vox_tpool_t* tpool) {
             pending = vox_queue_size(tpool->task_queue);
         }
         
-        int32_t running = vox_atomic_int_load(tpool->running_tasks);
-        int32_t total = vox_atomic_int_load(tpool->total_tasks);
-        int32_t completed = vox_atomic_int_load(tpool->completed_tasks);
-        int32_t failed = vox_atomic_int_load(tpool->failed_tasks);
+        int32_t running = vox_atomic_int_load(&tpool->running_tasks.value);
+        int64_t total = vox_atomic_long_load(&tpool->total_tasks.value);
+        int64_t completed, failed;
+        sum_worker_stats(tpool, &completed, &failed);
         
         /* 检查所有任务是否完成 */
         /* 如果没有任务，直接返回 */
@@ -456,7 +466,7 @@ int vox_tpool_shutdown(vox_tpool_t* tpool) {
     if (!tpool) return -1;
     
     /* 设置状态为正在关闭 */
-    int32_t old_state = vox_atomic_int_exchange(tpool->state, VOX_TPOOL_STATE_SHUTTING_DOWN);
+    int32_t old_state = vox_atomic_int_exchange(&tpool->state.value, VOX_TPOOL_STATE_SHUTTING_DOWN);
     if (old_state == VOX_TPOOL_STATE_SHUTDOWN) {
         return 0;  /* 已经关闭 */
     }
@@ -465,7 +475,7 @@ int vox_tpool_shutdown(vox_tpool_t* tpool) {
     vox_tpool_wait(tpool);
     
     /* 设置状态为已关闭 */
-    vox_atomic_int_store(tpool->state, VOX_TPOOL_STATE_SHUTDOWN);
+    vox_atomic_int_store(&tpool->state.value, VOX_TPOOL_STATE_SHUTDOWN);
     
     /* 唤醒所有工作线程（让它们退出） */
     /* 需要唤醒所有线程，因为可能有多个线程在等待信号量 */
@@ -490,7 +500,7 @@ void vox_tpool_force_shutdown(vox_tpool_t* tpool) {
     if (!tpool) return;
     
     /* 直接设置状态为已关闭 */
-    vox_atomic_int_store(tpool->state, VOX_TPOOL_STATE_SHUTDOWN);
+    vox_atomic_int_store(&tpool->state.value, VOX_TPOOL_STATE_SHUTDOWN);
     
     /* 唤醒所有工作线程 */
     /* 需要唤醒所有线程，因为可能有多个线程在等待信号量 */
@@ -529,7 +539,7 @@ size_t vox_tpool_pending_tasks(const vox_tpool_t* tpool) {
 /* 获取正在执行的任务数 */
 size_t vox_tpool_running_tasks(const vox_tpool_t* tpool) {
     if (!tpool) return 0;
-    return (size_t)vox_atomic_int_load(tpool->running_tasks);
+    return (size_t)vox_atomic_int_load(&tpool->running_tasks.value);
 }
 
 /* 获取统计信息 */
@@ -539,14 +549,16 @@ void vox_tpool_stats(const vox_tpool_t* tpool,
                      size_t* failed_tasks) {
     if (!tpool) return;
     
+    int64_t completed, failed;
+    sum_worker_stats(tpool, &completed, &failed);
     if (total_tasks) {
-        *total_tasks = (size_t)vox_atomic_int_load(tpool->total_tasks);
+        *total_tasks = (size_t)vox_atomic_long_load(&tpool->total_tasks.value);
     }
     if (completed_tasks) {
-        *completed_tasks = (size_t)vox_atomic_int_load(tpool->completed_tasks);
+        *completed_tasks = (size_t)completed;
     }
     if (failed_tasks) {
-        *failed_tasks = (size_t)vox_atomic_int_load(tpool->failed_tasks);
+        *failed_tasks = (size_t)failed;
     }
 }
 
@@ -555,7 +567,7 @@ void vox_tpool_destroy(vox_tpool_t* tpool) {
     if (!tpool) return;
     
     /* 如果还在运行，先关闭 */
-    int32_t state = vox_atomic_int_load(tpool->state);
+    int32_t state = vox_atomic_int_load(&tpool->state.value);
     if (state != VOX_TPOOL_STATE_SHUTDOWN) {
         vox_tpool_shutdown(tpool);
     }
@@ -16,10 +16,11 @@
 #include "vox_uring.h"
 #include "vox_backend.h"
 #include "vox_mpool.h"
-#include "vox_htable.h"
+#include "vox_fdtable.h"
 #include "vox_log.h"
 #include <liburing.h>
 #include <poll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
@@ -46,10 +47,10 @@ typedef struct {
 /* io_uring 结构 */
 struct vox_uring {
     struct io_uring ring;              /* io_uring 实例 */
-    int wakeup_fd[2];                  /* 用于唤醒的管道 [0]=read, [1]=write */
+    int wakeup_fd[2];                  /* 唤醒 fd [0]=read, [1]=write；使用 eventfd 时两者相同 */
     vox_uring_fd_info_t* wakeup_info;  /* 唤醒管道的信息 */
     size_t max_events;                 /* 每次处理的最大事件数 */
-    vox_htable_t* fd_map;              /* fd -> fd_info 映射 */
+    vox_fdtable_t* fd_map;             /* fd -> fd_info 映射 */
     vox_mpool_t* mpool;                /* 内存池 */
     bool own_mpool;                    /* 是否拥有内存池 */
     bool initialized;                  /* 是否已初始化 */
@@ -91,6 +92,18 @@ static int uring_add_poll(vox_uring_t* uring, vox_uring_fd_info_t* info) {
     return 0;
 }
 
+/* 关闭唤醒 fd（eventfd 时读写端为同一个 fd） */
+static void uring_close_wakeup(vox_uring_t* uring) {
+    if (uring->wakeup_fd[1] >= 0 && uring->wakeup_fd[1] != uring->wakeup_fd[0]) {
+        close(uring->wakeup_fd[1]);
+    }
+    if (uring->wakeup_fd[0] >= 0) {
+        close(uring->wakeup_fd[0]);
+    }
+    uring->wakeup_fd[0] = -1;
+    uring->wakeup_fd[1] = -1;
+}
+
 /* 创建 io_uring backend */
 vox_uring_t* vox_uring_create(const vox_uring_config_t* config) {
     vox_mpool_t* mpool = config ? config->mpool : NULL;
@@ -126,8 +139,7 @@ vox_uring_t* vox_uring_create(const vox_uring_config_t* config) {
         uring->max_events = config->max_events;
     }
 
-    vox_htable_config_t htable_config = {0};
-    uring->fd_map = vox_htable_create_with_config(uring->mpool, &htable_config);
+    uring->fd_map = vox_fdtable_create(uring->mpool);
     if (!uring->fd_map) {
         VOX_LOG_ERROR("Failed to create fd map for io_uring");
         vox_mpool_free(uring->mpool, uring);
@@ -194,8 +206,12 @@ int vox_uring_init(vox_uring_t* uring) {
         io_uring_free_probe(probe);
     }
 
-    /* 创建唤醒管道 */
-    if (pipe(uring->wakeup_fd) < 0) {
+    /* 创建唤醒 fd：优先 eventfd，不可用时退回管道 */
+    int efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (efd >= 0) {
+        uring->wakeup_fd[0] = efd;
+        uring->wakeup_fd[1] = efd;
+    } else if (pipe(uring->wakeup_fd) < 0) {
         VOX_LOG_ERROR("Failed to create wakeup pipe: errno=%d", errno);
         io_uring_queue_exit(&uring->ring);
         return -1;
@@ -217,8 +233,7 @@ int vox_uring_init(vox_uring_t* uring) {
     uring->wakeup_info = (vox_uring_fd_info_t*)vox_mpool_alloc(uring->mpool, sizeof(vox_uring_fd_info_t));
     if (!uring->wakeup_info) {
         VOX_LOG_ERROR("Failed to allocate wakeup info for io_uring");
-        close(uring->wakeup_fd[0]);
-        close(uring->wakeup_fd[1]);
+        uring_close_wakeup(uring);
         io_uring_queue_exit(&uring->ring);
         return -1;
     }
@@ -231,8 +246,7 @@ int vox_uring_init(vox_uring_t* uring) {
     if (uring_add_poll(uring, uring->wakeup_info) != 0) {
         VOX_LOG_ERROR("Failed to register wakeup pipe with io_uring");
         vox_mpool_free(uring->mpool, uring->wakeup_info);
-        close(uring->wakeup_fd[0]);
-        close(uring->wakeup_fd[1]);
+        uring_close_wakeup(uring);
         io_uring_queue_exit(&uring->ring);
         return -1;
     }
@@ -256,15 +270,10 @@ void vox_uring_destroy(vox_uring_t* uring) {
         io_uring_queue_exit(&uring->ring);
     }
 
-    if (uring->wakeup_fd[0] >= 0) {
-        close(uring->wakeup_fd[0]);
-    }
-    if (uring->wakeup_fd[1] >= 0) {
-        close(uring->wakeup_fd[1]);
-    }
+    uring_close_wakeup(uring);
 
     if (uring->fd_map) {
-        vox_htable_destroy(uring->fd_map);
+        vox_fdtable_destroy(uring->fd_map);
     }
 
     if (uring->wakeup_info) {
@@ -285,8 +294,7 @@ int vox_uring_add(vox_uring_t* uring, int fd, uint32_t events, void* user_data)
         return -1;
     }
 
-    int key = fd;
-    if (vox_htable_contains(uring->fd_map, &key, sizeof(key))) {
+    if (vox_fdtable_get(uring->fd_map, fd)) {
         return -1;
     }
 
@@ -307,7 +315,7 @@ int vox_uring_add(vox_uring_t* uring, int fd, uint32_t events, void* user_data)
         return -1;
     }
 
-    if (vox_htable_set(uring->fd_map, &key, sizeof(key), info) != 0) {
+    if (vox_fdtable_set(uring->fd_map, fd, info) != 0) {
         VOX_LOG_ERROR("Failed to add fd %d to io_uring fd map", fd);
         vox_mpool_free(uring->mpool, info);
         return -1;
@@ -325,9 +333,7 @@ int vox_uring_modify(vox_uring_t* uring, int fd, uint32_t events) {
         return -1;
     }
 
-    int key = fd;
-    vox_uring_fd_info_t* info = (vox_uring_fd_info_t*)vox_htable_get(
-        uring->fd_map, &key, sizeof(key));
+    vox_uring_fd_info_t* info = (vox_uring_fd_info_t*)vox_fdtable_get(uring->fd_map, fd);
     if (!info) {
         return -1;
     }
@@ -365,9 +371,7 @@ int vox_uring_remove(vox_uring_t* uring, int fd) {
         return -1;
     }
 
-    int key = fd;
-    vox_uring_fd_info_t* info = (vox_uring_fd_info_t*)vox_htable_get(
-        uring->fd_map, &key, sizeof(key));
+    vox_uring_fd_info_t* info = (vox_uring_fd_info_t*)vox_fdtable_get(uring->fd_map, fd);
     if (info) {
         /* 取消 poll */
         if (info->multishot_active) {
@@ -377,7 +381,7 @@ int vox_uring_remove(vox_uring_t* uring, int fd) {
             }
         }
 
-        vox_htable_delete(uring->fd_map, &key, sizeof(key));
+        vox_fdtable_remove(uring->fd_map, fd);
         vox_mpool_free(uring->mpool, info);
     }
     
@@ -470,8 +474,7 @@ int vox_uring_poll(vox_uring_t* uring, int timeout_ms, vox_uring_event_cb event_
             }
             /* multishot 被取消，需要重新注册 */
             info->multishot_active = false;
-            int key = fd;
-            if (vox_htable_contains(uring->fd_map, &key, sizeof(key))) {
+            if (vox_fdtable_get(uring->fd_map, fd) == info) {
                 uring_add_poll(uring, info);
             }
         } else if (fd == uring->wakeup_fd[0]) {
@@ -495,8 +498,7 @@ int vox_uring_poll(vox_uring_t* uring, int timeout_ms, vox_uring_event_cb event_
             /* 如果 multishot 结束（没有 MORE 标志），需要重新注册 */
             if (!more) {
                 info->multishot_active = false;
-                int key = fd;
-                if (vox_htable_contains(uring->fd_map, &key, sizeof(key))) {
+                if (vox_fdtable_get(uring->fd_map, fd) == info) {
                     uring_add_poll(uring, info);
                 }
             }
@@ -522,8 +524,9 @@ int vox_uring_wakeup(vox_uring_t* uring) {
         return -1;
     }
 
-    char byte = 1;
-    if (write(uring->wakeup_fd[1], &byte, 1) < 0) {
+    /* eventfd 要求写入 8 字节计数；管道同样可以接受 */
+    uint64_t one = 1;
+    if (write(uring->wakeup_fd[1], &one, sizeof(one)) < 0) {
         if (errno == EAGAIN || errno == EWOULDBLOCK) {
             return 0;
         }
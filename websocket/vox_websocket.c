@@ -6,6 +6,25 @@
 #include "../vox_crypto.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+/* 掩码与 UTF-8 验证的向量化实现按编译目标选择（Release 使用 -march=native）：
+ * x86 基线 SSE2，AVX2 时掩码每次处理 32 字节；UTF-8 查表验证需要 SSSE3（pshufb）或 NEON（tbl） */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VOX_WS_SSE2 1
+    #if defined(__SSSE3__)
+        #include <tmmintrin.h>
+        #define VOX_WS_SSSE3 1
+    #endif
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+        #define VOX_WS_AVX2 1
+    #endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define VOX_WS_NEON 1
+#endif
 
 /* 创建帧解析器 */
 vox_ws_parser_t* vox_ws_parser_create(vox_mpool_t* mpool) {
@@ -72,6 +91,7 @@ int vox_ws_parser_parse_frame(vox_ws_parser_t* parser, vox_ws_frame_t* frame) {
     /* 解析第一字节 */
     uint8_t byte0 = buf[0];
     frame->fin = (byte0 & 0x80) != 0;
+    frame->rsv1 = (byte0 & 0x40) != 0;
     frame->opcode = byte0 & 0x0F;
     
     /* 解析第二字节 */
@@ -124,11 +144,52 @@ int vox_ws_parser_parse_frame(vox_ws_parser_t* parser, vox_ws_frame_t* frame) {
     return (int)(header_len + payload_len);
 }
 
-/* 掩码/解掩码 */
+/* 掩码/解掩码
+ * 先逐字节处理到 16 字节对齐，再用按当前偏移旋转后的 4 字节掩码广播成向量整块异或，尾部逐字节 */
 void vox_ws_mask_payload(uint8_t* payload, size_t len, const uint8_t mask_key[4]) {
     if (!payload || !mask_key) return;
-    
-    for (size_t i = 0; i < len; i++) {
+
+    size_t i = 0;
+    while (i < len && ((uintptr_t)(payload + i) & 15) != 0) {
+        payload[i] ^= mask_key[i & 3];
+        i++;
+    }
+
+    if (len - i >= 16) {
+        /* 16/32/8 都是 4 的倍数：对齐后每块起点的掩码相位相同 */
+        uint8_t rot[4] = { mask_key[i & 3], mask_key[(i + 1) & 3], mask_key[(i + 2) & 3], mask_key[(i + 3) & 3] };
+        uint32_t m32;
+        memcpy(&m32, rot, 4);
+#if defined(VOX_WS_AVX2)
+        __m256i m256 = _mm256_set1_epi32((int)m32);
+        for (; i + 32 <= len; i += 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(payload + i));
+            _mm256_storeu_si256((__m256i*)(payload + i), _mm256_xor_si256(v, m256));
+        }
+#endif
+#if defined(VOX_WS_SSE2)
+        __m128i m128 = _mm_set1_epi32((int)m32);
+        for (; i + 16 <= len; i += 16) {
+            __m128i v = _mm_load_si128((const __m128i*)(payload + i));
+            _mm_store_si128((__m128i*)(payload + i), _mm_xor_si128(v, m128));
+        }
+#elif defined(VOX_WS_NEON)
+        uint8x16_t m128 = vreinterpretq_u8_u32(vdupq_n_u32(m32));
+        for (; i + 16 <= len; i += 16) {
+            vst1q_u8(payload + i, veorq_u8(vld1q_u8(payload + i), m128));
+        }
+#else
+        uint64_t m64 = (uint64_t)m32 | ((uint64_t)m32 << 32);
+        for (; i + 8 <= len; i += 8) {
+            uint64_t v;
+            memcpy(&v, payload + i, 8);
+            v ^= m64;
+            memcpy(payload + i, &v, 8);
+        }
+#endif
+    }
+
+    for (; i < len; i++) {
         payload[i] ^= mask_key[i & 3];
     }
 }
@@ -142,25 +203,13 @@ void vox_ws_generate_mask_key(uint8_t mask_key[4]) {
 /* 构建帧 */
 int vox_ws_build_frame(vox_mpool_t* mpool, uint8_t opcode, const void* payload,
                        size_t payload_len, bool masked, void** out_frame, size_t* out_len) {
-    if (!mpool || !out_frame || !out_len) return -1;
-    if (payload_len > 0 && !payload) return -1;
-    
-    /* 计算头部长度 */
-    size_t header_len = 2;
-    if (payload_len > 125) {
-        header_len += (payload_len <= 0xFFFF) ? 2 : 8;
-    }
-    if (masked) {
-        header_len += 4;
-    }
-    
-    /* 分配内存 */
-    size_t total_len = header_len + payload_len;
-    uint8_t* frame = (uint8_t*)vox_mpool_alloc(mpool, total_len);
-    if (!frame) return -1;
-    
-    /* 构建第一字节：FIN=1, RSV=0, opcode */
-    frame[0] = 0x80 | (opcode & 0x0F);
+    return vox_ws_build_frame_ex(mpool, opcode, false, payload, payload_len, masked, out_frame, out_len);
+}
+
+/* 写入帧头（FIN=1，不含掩码密钥），返回头部长度 */
+static size_t ws_write_frame_header(uint8_t* frame, uint8_t opcode, bool rsv1, size_t payload_len, bool masked) {
+    /* 构建第一字节：FIN=1, RSV1, opcode */
+    frame[0] = 0x80 | (rsv1 ? 0x40 : 0) | (opcode & 0x0F);
     
     /* 构建第二字节和长度 */
     size_t pos = 2;
@@ -184,11 +233,40 @@ int vox_ws_build_frame(vox_mpool_t* mpool, uint8_t opcode, const void* payload,
         frame[9] = (uint8_t)(len64 & 0xFF);
         pos = 10;
     }
+    if (masked) {
+        frame[1] |= 0x80;
+    }
+    return pos;
+}
+
+/* 帧头长度（含掩码密钥） */
+static size_t ws_frame_header_len(size_t payload_len, bool masked) {
+    size_t header_len = 2;
+    if (payload_len > 125) {
+        header_len += (payload_len <= 0xFFFF) ? 2 : 8;
+    }
+    if (masked) {
+        header_len += 4;
+    }
+    return header_len;
+}
+
+/* 构建帧（可设置 RSV1） */
+int vox_ws_build_frame_ex(vox_mpool_t* mpool, uint8_t opcode, bool rsv1, const void* payload,
+                          size_t payload_len, bool masked, void** out_frame, size_t* out_len) {
+    if (!mpool || !out_frame || !out_len) return -1;
+    if (payload_len > 0 && !payload) return -1;
     
-    /* 设置掩码标志和密钥 */
+    /* 分配内存 */
+    size_t total_len = ws_frame_header_len(payload_len, masked) + payload_len;
+    uint8_t* frame = (uint8_t*)vox_mpool_alloc(mpool, total_len);
+    if (!frame) return -1;
+    
+    size_t pos = ws_write_frame_header(frame, opcode, rsv1, payload_len, masked);
+    
+    /* 设置掩码密钥 */
     uint8_t mask_key[4] = {0};
     if (masked) {
-        frame[1] |= 0x80;
         vox_ws_generate_mask_key(mask_key);
         memcpy(frame + pos, mask_key, 4);
         pos += 4;
@@ -209,6 +287,23 @@ int vox_ws_build_frame(vox_mpool_t* mpool, uint8_t opcode, const void* payload,
     return 0;
 }
 
+/* 构建服务端帧到共享缓冲区 */
+int vox_ws_build_frame_bytes(vox_mpool_t* mpool, uint8_t opcode, const void* payload, size_t payload_len,
+                             vox_bytes_t* out) {
+    if (!mpool || !out) return -1;
+    if (payload_len > 0 && !payload) return -1;
+    
+    size_t header_len = ws_frame_header_len(payload_len, false);
+    uint8_t* frame = (uint8_t*)vox_bytes_alloc(mpool, header_len + payload_len, out);
+    if (!frame) return -1;
+    
+    ws_write_frame_header(frame, opcode, false, payload_len, false);
+    if (payload_len > 0) {
+        memcpy(frame + header_len, payload, payload_len);
+    }
+    return 0;
+}
+
 /* 验证关闭状态码 */
 static bool vox_ws_is_valid_close_code(uint16_t code) {
     /* RFC 6455: 有效范围 1000-4999 */
@@ -268,44 +363,226 @@ int vox_ws_build_close_frame(vox_mpool_t* mpool, uint16_t code, const char* reas
     return 0;
 }
 
-/* UTF-8 验证 */
-bool vox_ws_validate_utf8(const uint8_t* data, size_t len) {
-    if (!data && len > 0) return false;
-    
+/* ===== UTF-8 验证（RFC 3629：拒绝过长编码、代理区 U+D800-U+DFFF 与超过 U+10FFFF 的码点） ===== */
+
+/* 从 data[i] 开始的一个非 ASCII 字符的长度；无效或不完整返回 0 */
+static size_t vox_ws_utf8_char(const uint8_t* data, size_t len, size_t i) {
+    uint8_t b0 = data[i];
+    size_t n;
+    uint8_t lo = 0x80, hi = 0xBF; /* 第二个字节的范围 */
+
+    if (b0 >= 0xC2 && b0 <= 0xDF) {
+        n = 2;
+    } else if (b0 >= 0xE0 && b0 <= 0xEF) {
+        n = 3;
+        if (b0 == 0xE0) lo = 0xA0;        /* 过长编码 */
+        else if (b0 == 0xED) hi = 0x9F;   /* 代理区 */
+    } else if (b0 >= 0xF0 && b0 <= 0xF4) {
+        n = 4;
+        if (b0 == 0xF0) lo = 0x90;        /* 过长编码 */
+        else if (b0 == 0xF4) hi = 0x8F;   /* 超过 U+10FFFF */
+    } else {
+        return 0; /* 续字节、0xC0/0xC1 或 0xF5 以上 */
+    }
+
+    if (len - i < n) return 0;
+    if (data[i + 1] < lo || data[i + 1] > hi) return 0;
+    for (size_t j = 2; j < n; j++) {
+        if ((data[i + j] & 0xC0) != 0x80) return 0;
+    }
+    return n;
+}
+
+/* 从 i 开始的 ASCII 前缀结束位置（每次检查 16 或 8 字节） */
+static size_t vox_ws_utf8_skip_ascii(const uint8_t* data, size_t len, size_t i) {
+#if defined(VOX_WS_SSE2)
+    for (; i + 16 <= len; i += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(data + i))) != 0) break;
+    }
+#elif defined(VOX_WS_NEON)
+    for (; i + 16 <= len; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80) break;
+    }
+#endif
+    for (; i + 8 <= len; i += 8) {
+        uint64_t v;
+        memcpy(&v, data + i, 8);
+        if (v & 0x8080808080808080ULL) break;
+    }
+    while (i < len && data[i] < 0x80) i++;
+    return i;
+}
+
+static bool vox_ws_validate_utf8_scalar(const uint8_t* data, size_t len) {
     size_t i = 0;
     while (i < len) {
-        uint8_t byte = data[i];
-        size_t char_len;
-        
-        if ((byte & 0x80) == 0) {
-            /* 单字节字符 (0xxxxxxx) */
-            char_len = 1;
-        } else if ((byte & 0xE0) == 0xC0) {
-            /* 双字节字符 (110xxxxx 10xxxxxx) */
-            char_len = 2;
-        } else if ((byte & 0xF0) == 0xE0) {
-            /* 三字节字符 (1110xxxx 10xxxxxx 10xxxxxx) */
-            char_len = 3;
-        } else if ((byte & 0xF8) == 0xF0) {
-            /* 四字节字符 (11110xxx 10xxxxxx 10xxxxxx 10xxxxxx) */
-            char_len = 4;
-        } else {
-            return false; /* 无效的起始字节 */
-        }
-        
-        if (i + char_len > len) {
-            return false; /* 不完整的字符 */
+        if (data[i] < 0x80) {
+            i = vox_ws_utf8_skip_ascii(data, len, i);
+            continue;
         }
-        
-        /* 验证后续字节 */
-        for (size_t j = 1; j < char_len; j++) {
-            if ((data[i + j] & 0xC0) != 0x80) {
-                return false; /* 后续字节必须是 10xxxxxx */
-            }
-        }
-        
-        i += char_len;
+        size_t n = vox_ws_utf8_char(data, len, i);
+        if (n == 0) return false;
+        i += n;
     }
-    
     return true;
 }
+
+#if defined(VOX_WS_SSSE3) || defined(VOX_WS_NEON)
+
+/* 查表验证（Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"）：
+ * 用前一字节的高/低 4 位与当前字节的高 4 位查三张表，三者按位与非0即为错误；
+ * 3/4 字节序列的第 3/4 个字节单独由前 2/3 个字节判断。每次处理 16 字节，跨块携带前一块 */
+#define VOX_WS_U8_TOO_SHORT   (1 << 0)
+#define VOX_WS_U8_TOO_LONG    (1 << 1)
+#define VOX_WS_U8_OVERLONG_3  (1 << 2)
+#define VOX_WS_U8_TOO_LARGE   (1 << 3)
+#define VOX_WS_U8_SURROGATE   (1 << 4)
+#define VOX_WS_U8_OVERLONG_2  (1 << 5)
+#define VOX_WS_U8_TOO_LARGE_1000 (1 << 6)
+#define VOX_WS_U8_OVERLONG_4  (1 << 6)
+#define VOX_WS_U8_TWO_CONTS   (1 << 7)
+#define VOX_WS_U8_CARRY (VOX_WS_U8_TOO_SHORT | VOX_WS_U8_TOO_LONG | VOX_WS_U8_TWO_CONTS)
+
+static const uint8_t vox_ws_u8_byte1_high[16] = {
+    /* 0xxx：ASCII 后接续字节 */
+    VOX_WS_U8_TOO_LONG, VOX_WS_U8_TOO_LONG, VOX_WS_U8_TOO_LONG, VOX_WS_U8_TOO_LONG,
+    VOX_WS_U8_TOO_LONG, VOX_WS_U8_TOO_LONG, VOX_WS_U8_TOO_LONG, VOX_WS_U8_TOO_LONG,
+    /* 10xx：续字节 */
+    VOX_WS_U8_TWO_CONTS, VOX_WS_U8_TWO_CONTS, VOX_WS_U8_TWO_CONTS, VOX_WS_U8_TWO_CONTS,
+    /* 1100 / 1101：2 字节首字节 */
+    VOX_WS_U8_TOO_SHORT | VOX_WS_U8_OVERLONG_2,
+    VOX_WS_U8_TOO_SHORT,
+    /* 1110：3 字节首字节 */
+    VOX_WS_U8_TOO_SHORT | VOX_WS_U8_OVERLONG_3 | VOX_WS_U8_SURROGATE,
+    /* 1111：4 字节首字节 */
+    VOX_WS_U8_TOO_SHORT | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000 | VOX_WS_U8_OVERLONG_4
+};
+
+static const uint8_t vox_ws_u8_byte1_low[16] = {
+    VOX_WS_U8_CARRY | VOX_WS_U8_OVERLONG_3 | VOX_WS_U8_OVERLONG_2 | VOX_WS_U8_OVERLONG_4,
+    VOX_WS_U8_CARRY | VOX_WS_U8_OVERLONG_2,
+    VOX_WS_U8_CARRY,
+    VOX_WS_U8_CARRY,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000 | VOX_WS_U8_SURROGATE,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000,
+    VOX_WS_U8_CARRY | VOX_WS_U8_TOO_LARGE | VOX_WS_U8_TOO_LARGE_1000
+};
+
+static const uint8_t vox_ws_u8_byte2_high[16] = {
+    /* 0xxx：首字节后缺少续字节 */
+    VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT,
+    VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT,
+    /* 1000 */
+    VOX_WS_U8_TOO_LONG | VOX_WS_U8_OVERLONG_2 | VOX_WS_U8_TWO_CONTS | VOX_WS_U8_OVERLONG_3 |
+        VOX_WS_U8_TOO_LARGE_1000 | VOX_WS_U8_OVERLONG_4,
+    /* 1001 */
+    VOX_WS_U8_TOO_LONG | VOX_WS_U8_OVERLONG_2 | VOX_WS_U8_TWO_CONTS | VOX_WS_U8_OVERLONG_3 | VOX_WS_U8_TOO_LARGE,
+    /* 101x */
+    VOX_WS_U8_TOO_LONG | VOX_WS_U8_OVERLONG_2 | VOX_WS_U8_TWO_CONTS | VOX_WS_U8_SURROGATE | VOX_WS_U8_TOO_LARGE,
+    VOX_WS_U8_TOO_LONG | VOX_WS_U8_OVERLONG_2 | VOX_WS_U8_TWO_CONTS | VOX_WS_U8_SURROGATE | VOX_WS_U8_TOO_LARGE,
+    /* 11xx：首字节后接首字节 */
+    VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT, VOX_WS_U8_TOO_SHORT
+};
+
+/* 块末尾的不完整序列：最后 3 个字节分别不小于 0xF0/0xE0/0xC0 */
+static const uint8_t vox_ws_u8_incomplete_max[16] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+};
+
+#if defined(VOX_WS_SSSE3)
+typedef __m128i vox_ws_v16_t;
+#define VOX_WS_V_LOAD(p)        _mm_loadu_si128((const __m128i*)(p))
+#define VOX_WS_V_ZERO()         _mm_setzero_si128()
+#define VOX_WS_V_HIGH4(v)       _mm_and_si128(_mm_srli_epi16((v), 4), _mm_set1_epi8(0x0F))
+#define VOX_WS_V_LOW4(v)        _mm_and_si128((v), _mm_set1_epi8(0x0F))
+#define VOX_WS_V_LOOKUP(t, idx) _mm_shuffle_epi8(VOX_WS_V_LOAD(t), (idx))
+#define VOX_WS_V_PREV(cur, prev, n) _mm_alignr_epi8((cur), (prev), 16 - (n))
+#define VOX_WS_V_AND(a, b)      _mm_and_si128((a), (b))
+#define VOX_WS_V_OR(a, b)       _mm_or_si128((a), (b))
+#define VOX_WS_V_XOR(a, b)      _mm_xor_si128((a), (b))
+#define VOX_WS_V_SUBS(a, b)     _mm_subs_epu8((a), (b))
+#define VOX_WS_V_SET1(c)        _mm_set1_epi8((char)(c))
+#define VOX_WS_V_IS_ASCII(v)    (_mm_movemask_epi8(v) == 0)
+#define VOX_WS_V_ANY(v)         (_mm_movemask_epi8(_mm_cmpeq_epi8((v), _mm_setzero_si128())) != 0xFFFF)
+#else
+typedef uint8x16_t vox_ws_v16_t;
+#define VOX_WS_V_LOAD(p)        vld1q_u8((const uint8_t*)(p))
+#define VOX_WS_V_ZERO()         vdupq_n_u8(0)
+#define VOX_WS_V_HIGH4(v)       vshrq_n_u8((v), 4)
+#define VOX_WS_V_LOW4(v)        vandq_u8((v), vdupq_n_u8(0x0F))
+#define VOX_WS_V_LOOKUP(t, idx) vqtbl1q_u8(VOX_WS_V_LOAD(t), (idx))
+#define VOX_WS_V_PREV(cur, prev, n) vextq_u8((prev), (cur), 16 - (n))
+#define VOX_WS_V_AND(a, b)      vandq_u8((a), (b))
+#define VOX_WS_V_OR(a, b)       vorrq_u8((a), (b))
+#define VOX_WS_V_XOR(a, b)      veorq_u8((a), (b))
+#define VOX_WS_V_SUBS(a, b)     vqsubq_u8((a), (b))
+#define VOX_WS_V_SET1(c)        vdupq_n_u8((uint8_t)(c))
+#define VOX_WS_V_IS_ASCII(v)    (vmaxvq_u8(v) < 0x80)
+#define VOX_WS_V_ANY(v)         (vmaxvq_u8(v) != 0)
+#endif
+
+/* 当前块与前一块拼接后检查，返回错误位 */
+static inline vox_ws_v16_t vox_ws_utf8_check_block(vox_ws_v16_t cur, vox_ws_v16_t prev) {
+    vox_ws_v16_t prev1 = VOX_WS_V_PREV(cur, prev, 1);
+    vox_ws_v16_t sc = VOX_WS_V_AND(VOX_WS_V_AND(VOX_WS_V_LOOKUP(vox_ws_u8_byte1_high, VOX_WS_V_HIGH4(prev1)),
+                                                VOX_WS_V_LOOKUP(vox_ws_u8_byte1_low, VOX_WS_V_LOW4(prev1))),
+                                   VOX_WS_V_LOOKUP(vox_ws_u8_byte2_high, VOX_WS_V_HIGH4(cur)));
+    /* 前 2 个字节是 3/4 字节首字节、或前 3 个字节是 4 字节首字节时，当前字节必须是续字节 */
+    vox_ws_v16_t prev2 = VOX_WS_V_PREV(cur, prev, 2);
+    vox_ws_v16_t prev3 = VOX_WS_V_PREV(cur, prev, 3);
+    vox_ws_v16_t must23 = VOX_WS_V_OR(VOX_WS_V_SUBS(prev2, VOX_WS_V_SET1(0xE0 - 0x80)),
+                                      VOX_WS_V_SUBS(prev3, VOX_WS_V_SET1(0xF0 - 0x80)));
+    return VOX_WS_V_XOR(VOX_WS_V_AND(must23, VOX_WS_V_SET1(0x80)), sc);
+}
+
+static bool vox_ws_validate_utf8_simd(const uint8_t* data, size_t len) {
+    vox_ws_v16_t prev = VOX_WS_V_ZERO();
+    vox_ws_v16_t prev_incomplete = VOX_WS_V_ZERO();
+    vox_ws_v16_t error = VOX_WS_V_ZERO();
+    vox_ws_v16_t max_tail = VOX_WS_V_LOAD(vox_ws_u8_incomplete_max);
+    size_t i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        vox_ws_v16_t cur = VOX_WS_V_LOAD(data + i);
+        if (VOX_WS_V_IS_ASCII(cur)) {
+            /* ASCII 块：只需确认前一块没有以不完整的序列结尾 */
+            error = VOX_WS_V_OR(error, prev_incomplete);
+            prev_incomplete = VOX_WS_V_ZERO();
+        } else {
+            error = VOX_WS_V_OR(error, vox_ws_utf8_check_block(cur, prev));
+            prev_incomplete = VOX_WS_V_SUBS(cur, max_tail);
+        }
+        prev = cur;
+    }
+    if (i < len) {
+        /* 尾部补 0（ASCII）成整块：未结束的序列会被识别为 TOO_SHORT */
+        uint8_t tail[16] = {0};
+        memcpy(tail, data + i, len - i);
+        vox_ws_v16_t cur = VOX_WS_V_LOAD(tail);
+        error = VOX_WS_V_OR(error, vox_ws_utf8_check_block(cur, prev));
+    } else {
+        error = VOX_WS_V_OR(error, prev_incomplete);
+    }
+    return !VOX_WS_V_ANY(error);
+}
+
+#endif /* VOX_WS_SSSE3 || VOX_WS_NEON */
+
+/* UTF-8 验证：短数据与无查表指令的平台使用标量实现（含按 8/16 字节跳过 ASCII） */
+bool vox_ws_validate_utf8(const uint8_t* data, size_t len) {
+    if (!data) return len == 0;
+#if defined(VOX_WS_SSSE3) || defined(VOX_WS_NEON)
+    if (len >= 16) return vox_ws_validate_utf8_simd(data, len);
+#endif
+    return vox_ws_validate_utf8_scalar(data, len);
+}
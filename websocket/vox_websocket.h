@@ -9,6 +9,7 @@
 #include "../vox_os.h"
 #include "../vox_mpool.h"
 #include "../vox_string.h"
+#include "../vox_bytes.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -43,6 +44,7 @@ typedef enum {
 /* WebSocket 帧结构 */
 typedef struct {
     bool fin;                   /* FIN 标志 */
+    bool rsv1;                 /* RSV1 标志（permessage-deflate 压缩消息） */
     uint8_t opcode;            /* 操作码 */
     bool masked;               /* 是否掩码 */
     uint64_t payload_len;      /* 负载长度 */
@@ -115,6 +117,27 @@ int vox_ws_parser_parse_frame(vox_ws_parser_t* parser, vox_ws_frame_t* frame);
 int vox_ws_build_frame(vox_mpool_t* mpool, uint8_t opcode, const void* payload, 
                        size_t payload_len, bool masked, void** out_frame, size_t* out_len);
 
+/**
+ * 构建 WebSocket 帧，可设置 RSV1（permessage-deflate 压缩消息的第一帧）
+ * @param rsv1 是否设置 RSV1
+ * 其余参数同 vox_ws_build_frame
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ws_build_frame_ex(vox_mpool_t* mpool, uint8_t opcode, bool rsv1, const void* payload,
+                          size_t payload_len, bool masked, void** out_frame, size_t* out_len);
+
+/**
+ * 构建服务端（不掩码）WebSocket 帧到引用计数缓冲区，用于一次编码、多个连接共享发送
+ * @param mpool 内存池（缓冲区最后一次释放时归还，须比所有持有者活得久）
+ * @param opcode 操作码
+ * @param payload 负载数据
+ * @param payload_len 负载长度
+ * @param out 输出：完整帧（引用计数为1）
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ws_build_frame_bytes(vox_mpool_t* mpool, uint8_t opcode, const void* payload, size_t payload_len,
+                             vox_bytes_t* out);
+
 /**
  * 构建 WebSocket 关闭帧
  * @param mpool 内存池
@@ -130,6 +153,7 @@ int vox_ws_build_close_frame(vox_mpool_t* mpool, uint16_t code, const char* reas
 
 /**
  * 掩码/解掩码负载数据（就地操作）
+ * 对齐后按 16 字节（SSE2/NEON）或 32 字节（AVX2）整块异或，其它平台每次 8 字节
  * @param payload 负载数据
  * @param len 数据长度
  * @param mask_key 掩码密钥（4字节）
@@ -143,7 +167,8 @@ void vox_ws_mask_payload(uint8_t* payload, size_t len, const uint8_t mask_key[4]
 void vox_ws_generate_mask_key(uint8_t mask_key[4]);
 
 /**
- * 验证 UTF-8 编码
+ * 验证 UTF-8 编码（RFC 3629：拒绝过长编码、代理区码点与超过 U+10FFFF 的码点）
+ * 有 SSSE3/NEON 时按 16 字节查表验证，否则逐字符验证；两者都整块跳过 ASCII
  * @param data 数据指针
  * @param len 数据长度
  * @return 有效返回 true，否则返回 false
@@ -16,6 +16,7 @@ struct vox_ws_client {
     vox_tcp_t* tcp;                      /* TCP 连接（WS） */
     vox_tls_t* tls;                      /* TLS 连接（WSS） */
     vox_ws_parser_t* parser;             /* 帧解析器 */
+    vox_ws_deflate_t* deflate;           /* permessage-deflate 状态（未协商时为 NULL） */
     vox_ws_client_state_t state;         /* 客户端状态 */
     vox_ws_client_config_t config;       /* 配置 */
     vox_string_t* handshake_buffer;      /* 握手缓冲区 */
@@ -184,6 +185,8 @@ void vox_ws_client_destroy(vox_ws_client_t* client) {
         vox_string_destroy(client->handshake_buffer);
     }
     
+    vox_ws_deflate_destroy(client->deflate);
+    
     /* 销毁内存池 */
     if (client->owns_mpool && client->mpool) {
         vox_mpool_destroy(client->mpool);
@@ -272,10 +275,24 @@ static char* ws_calculate_accept(vox_mpool_t* mpool, const char* key) {
     return accept;
 }
 
+/* 压缩参数：解压上限不超过客户端的 max_message_size */
+static vox_ws_deflate_config_t ws_client_deflate_config(const vox_ws_client_t* client) {
+    vox_ws_deflate_config_t dcfg = client->config.compression;
+    size_t max_size = client->config.max_message_size;
+    if (max_size > 0 && (dcfg.max_message_size == 0 || dcfg.max_message_size > max_size)) {
+        dcfg.max_message_size = max_size;
+    }
+    return dcfg;
+}
+
 /* 发送握手 */
 static int ws_client_send_handshake(vox_ws_client_t* client) {
     if (!client) return -1;
     
+    /* 上一次连接协商的压缩状态不再有效 */
+    vox_ws_deflate_destroy(client->deflate);
+    client->deflate = NULL;
+    
     /* 生成 Key */
     client->ws_key = ws_generate_key(client->mpool);
     if (!client->ws_key) return -1;
@@ -294,6 +311,13 @@ static int ws_client_send_handshake(vox_ws_client_t* client) {
     vox_string_append(request, "Connection: Upgrade\r\n");
     vox_string_append_format(request, "Sec-WebSocket-Key: %s\r\n", client->ws_key);
     vox_string_append(request, "Sec-WebSocket-Version: 13\r\n");
+    if (client->config.enable_compression) {
+        vox_ws_deflate_config_t dcfg = ws_client_deflate_config(client);
+        char offer[128];
+        if (vox_ws_deflate_format_offer(&dcfg, offer, sizeof(offer)) > 0) {
+            vox_string_append_format(request, "Sec-WebSocket-Extensions: %s\r\n", offer);
+        }
+    }
     vox_string_append(request, "\r\n");
     
     const char* req_data = vox_string_cstr(request);
@@ -315,6 +339,29 @@ static int ws_client_send_handshake(vox_ws_client_t* client) {
     return ret;
 }
 
+/* 在响应头中查找字段（名称不区分大小写），返回去掉前后空白的值，*value_end 为值的结尾 */
+static const char* ws_client_find_header(const char* headers, const char* end, const char* name,
+                                         const char** value_end) {
+    size_t name_len = strlen(name);
+    const char* p = headers;
+    while (p < end) {
+        const char* line_end = p;
+        while (line_end < end && *line_end != '\r' && *line_end != '\n') line_end++;
+        if ((size_t)(line_end - p) > name_len && strncasecmp(p, name, name_len) == 0 && p[name_len] == ':') {
+            const char* v = p + name_len + 1;
+            while (v < line_end && (*v == ' ' || *v == '\t')) v++;
+            const char* e = line_end;
+            while (e > v && (e[-1] == ' ' || e[-1] == '\t')) e--;
+            *value_end = e;
+            return v;
+        }
+        p = line_end;
+        if (p < end && *p == '\r') p++;
+        if (p < end && *p == '\n') p++;
+    }
+    return NULL;
+}
+
 /* 处理握手响应 */
 static int ws_client_handle_handshake_response(vox_ws_client_t* client, const char* data, size_t len) {
     if (!client || !data || len == 0) return -1;
@@ -367,6 +414,18 @@ static int ws_client_handle_handshake_response(vox_ws_client_t* client, const ch
     
     if (!valid) return -1;
     
+    /* 服务端接受的扩展：只能是本端提议过的 permessage-deflate */
+    const char* ext_end = NULL;
+    const char* ext = ws_client_find_header(buf, end_marker, "Sec-WebSocket-Extensions", &ext_end);
+    if (ext) {
+        if (!client->config.enable_compression) return -1;
+        vox_ws_deflate_config_t dcfg = ws_client_deflate_config(client);
+        vox_ws_deflate_params_t params;
+        if (vox_ws_deflate_accept(&dcfg, ext, (size_t)(ext_end - ext), &params) != 0) return -1;
+        client->deflate = vox_ws_deflate_create(client->loop, client->mpool, &dcfg, &params, false);
+        if (!client->deflate) return -1;
+    }
+    
     /* 握手成功 */
     client->state = VOX_WS_CLIENT_OPEN;
     vox_string_destroy(client->handshake_buffer);
@@ -392,6 +451,13 @@ static int ws_client_handle_frame(vox_ws_client_t* client, const vox_ws_frame_t*
         return -1;
     }
     
+    /* RSV1 只允许出现在已协商压缩的数据帧上 */
+    bool is_data = frame->opcode == VOX_WS_OP_TEXT || frame->opcode == VOX_WS_OP_BINARY;
+    if (frame->rsv1 && (!client->deflate || !is_data)) {
+        vox_ws_client_close(client, VOX_WS_CLOSE_PROTOCOL_ERROR, "Unexpected RSV1");
+        return -1;
+    }
+    
     /* 复制负载 */
     uint8_t* payload = NULL;
     if (frame->payload_len > 0) {
@@ -400,22 +466,41 @@ static int ws_client_handle_frame(vox_ws_client_t* client, const vox_ws_frame_t*
         memcpy(payload, frame->payload, frame->payload_len);
     }
     
+    /* 解压压缩消息 */
+    const uint8_t* data = payload;
+    size_t data_len = frame->payload_len;
+    vox_string_t* inflated = NULL;
+    if (frame->rsv1) {
+        inflated = vox_string_create(client->mpool);
+        int ret = inflated ? vox_ws_deflate_decompress(client->deflate, payload, data_len, inflated) : -1;
+        if (ret != 0) {
+            if (inflated) vox_string_destroy(inflated);
+            if (payload) vox_mpool_free(client->mpool, payload);
+            vox_ws_client_close(client, ret == -2 ? VOX_WS_CLOSE_MESSAGE_TOO_BIG : VOX_WS_CLOSE_INVALID_DATA,
+                                "Invalid compressed message");
+            return -1;
+        }
+        data = (const uint8_t*)vox_string_data(inflated);
+        data_len = vox_string_length(inflated);
+    }
+    
     /* 处理不同类型的帧 */
     if (frame->opcode == VOX_WS_OP_TEXT) {
         /* 文本消息 */
-        if (!vox_ws_validate_utf8(payload, frame->payload_len)) {
+        if (!vox_ws_validate_utf8(data, data_len)) {
+            if (inflated) vox_string_destroy(inflated);
             vox_ws_client_close(client, VOX_WS_CLOSE_INVALID_DATA, "Invalid UTF-8");
             return -1;
         }
         
         if (client->config.on_message) {
-            client->config.on_message(client, payload, frame->payload_len,
+            client->config.on_message(client, data, data_len,
                                      VOX_WS_MSG_TEXT, client->config.user_data);
         }
     } else if (frame->opcode == VOX_WS_OP_BINARY) {
         /* 二进制消息 */
         if (client->config.on_message) {
-            client->config.on_message(client, payload, frame->payload_len,
+            client->config.on_message(client, data, data_len,
                                      VOX_WS_MSG_BINARY, client->config.user_data);
         }
     } else if (frame->opcode == VOX_WS_OP_CLOSE) {
@@ -484,6 +569,8 @@ static int ws_client_handle_frame(vox_ws_client_t* client, const vox_ws_frame_t*
     }
     /* PONG 帧忽略 */
     
+    if (inflated) vox_string_destroy(inflated);
+    if (payload) vox_mpool_free(client->mpool, payload);
     return frame_len;
 }
 
@@ -636,7 +723,8 @@ static void ws_client_on_tcp_read(vox_tcp_t* tcp, ssize_t nread, const void* buf
     vox_ws_client_t* client = (vox_ws_client_t*)tcp->handle.data;
     if (!client) return;
     
-    if (nread < 0) {
+    if (nread <= 0) {
+        /* 连接错误或对端关闭（nread 为 0） */
         if (client->config.on_error) {
             client->config.on_error(client, "Connection closed", client->config.user_data);
         }
@@ -646,8 +734,6 @@ static void ws_client_on_tcp_read(vox_tcp_t* tcp, ssize_t nread, const void* buf
         return;
     }
     
-    if (nread == 0) return;
-    
     /* 处理握手响应 */
     if (client->state == VOX_WS_CLIENT_HANDSHAKING) {
         int ret = ws_client_handle_handshake_response(client, (const char*)buf, (size_t)nread);
@@ -699,7 +785,8 @@ static void ws_client_on_tls_read(vox_tls_t* tls, ssize_t nread, const void* buf
     vox_ws_client_t* client = (vox_ws_client_t*)tls->handle.data;
     if (!client) return;
     
-    if (nread < 0) {
+    if (nread <= 0) {
+        /* 连接错误或对端关闭（nread 为 0） */
         if (client->config.on_error) {
             client->config.on_error(client, "Connection closed", client->config.user_data);
         }
@@ -709,8 +796,6 @@ static void ws_client_on_tls_read(vox_tls_t* tls, ssize_t nread, const void* buf
         return;
     }
     
-    if (nread == 0) return;
-    
     /* 处理握手响应 */
     if (client->state == VOX_WS_CLIENT_HANDSHAKING) {
         int ret = ws_client_handle_handshake_response(client, (const char*)buf, (size_t)nread);
@@ -755,16 +840,30 @@ static void ws_client_on_tls_read(vox_tls_t* tls, ssize_t nread, const void* buf
     }
 }
 
-/* 发送文本消息 */
-int vox_ws_client_send_text(vox_ws_client_t* client, const char* text, size_t len) {
-    if (!client || !text || len == 0) return -1;
-    if (client->state != VOX_WS_CLIENT_OPEN) return -1;
+/* 发送数据消息：已协商压缩时先压缩并设置 RSV1 */
+static int ws_client_send_message(vox_ws_client_t* client, uint8_t opcode, const void* data, size_t len) {
+    bool compressed = false;
+    vox_string_t* deflated = NULL;
+    if (client->deflate) {
+        deflated = vox_string_create(client->mpool);
+        if (!deflated) return -1;
+        int ret = vox_ws_deflate_compress(client->deflate, data, len, deflated);
+        if (ret < 0) {
+            vox_string_destroy(deflated);
+            return -1;
+        }
+        if (ret > 0) {
+            compressed = true;
+            data = vox_string_data(deflated);
+            len = vox_string_length(deflated);
+        }
+    }
     
     void* frame;
     size_t frame_len;
-    if (vox_ws_build_frame(client->mpool, VOX_WS_OP_TEXT, text, len, true, &frame, &frame_len) != 0) {
-        return -1;
-    }
+    int ret = vox_ws_build_frame_ex(client->mpool, opcode, compressed, data, len, true, &frame, &frame_len);
+    if (deflated) vox_string_destroy(deflated);
+    if (ret != 0) return -1;
     
     if (client->tcp) {
         return vox_tcp_write(client->tcp, frame, frame_len, NULL);
@@ -773,22 +872,18 @@ int vox_ws_client_send_text(vox_ws_client_t* client, const char* text, size_t le
     }
 }
 
+/* 发送文本消息 */
+int vox_ws_client_send_text(vox_ws_client_t* client, const char* text, size_t len) {
+    if (!client || !text || len == 0) return -1;
+    if (client->state != VOX_WS_CLIENT_OPEN) return -1;
+    return ws_client_send_message(client, VOX_WS_OP_TEXT, text, len);
+}
+
 /* 发送二进制消息 */
 int vox_ws_client_send_binary(vox_ws_client_t* client, const void* data, size_t len) {
     if (!client || !data || len == 0) return -1;
     if (client->state != VOX_WS_CLIENT_OPEN) return -1;
-    
-    void* frame;
-    size_t frame_len;
-    if (vox_ws_build_frame(client->mpool, VOX_WS_OP_BINARY, data, len, true, &frame, &frame_len) != 0) {
-        return -1;
-    }
-    
-    if (client->tcp) {
-        return vox_tcp_write(client->tcp, frame, frame_len, NULL);
-    } else {
-        return vox_tls_write(client->tls, frame, frame_len, NULL);
-    }
+    return ws_client_send_message(client, VOX_WS_OP_BINARY, data, len);
 }
 
 /* 发送 Ping */
@@ -7,6 +7,7 @@
 #define VOX_WEBSOCKET_CLIENT_H
 
 #include "vox_websocket.h"
+#include "vox_websocket_deflate.h"
 #include "../vox_loop.h"
 #include "../vox_tcp.h"
 #include "../vox_tls.h"
@@ -52,6 +53,8 @@ typedef struct {
     vox_ws_client_on_error_cb on_error;     /* 错误回调 */
     void* user_data;                        /* 用户数据 */
     size_t max_message_size;                /* 最大消息大小（0表示无限制） */
+    bool enable_compression;                /* 是否提议 permessage-deflate（RFC 7692，需要 zlib） */
+    vox_ws_deflate_config_t compression;    /* 压缩参数（全 0 使用默认值） */
 } vox_ws_client_config_t;
 
 /**
@@ -0,0 +1,672 @@
+/*
+ * vox_websocket_deflate.c - WebSocket permessage-deflate 扩展实现（RFC 7692）
+ * 保持上下文的方向使用连接内存池中的常驻 z_stream；
+ * 不保持上下文的方向每条消息从 loop 级池（通过 vox_loop 扩展数据挂载）借用一个 z_stream，用完重置放回
+ */
+
+#include "vox_websocket_deflate.h"
+#include "../vox_log.h"
+#include "../vox_list.h"
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef VOX_USE_ZLIB
+
+#include <zlib.h>
+
+#define VOX_WS_DEFLATE_DEFAULT_LEVEL         6
+#define VOX_WS_DEFLATE_DEFAULT_MEM_LEVEL     8
+#define VOX_WS_DEFLATE_MAX_WINDOW_BITS       15
+#define VOX_WS_DEFLATE_MIN_WINDOW_BITS       9    /* zlib 原始 deflate 不支持 8 位窗口 */
+#define VOX_WS_DEFLATE_DEFAULT_MIN_SIZE      32
+#define VOX_WS_DEFLATE_DEFAULT_MAX_MESSAGE   (16u * 1024 * 1024)
+#define VOX_WS_DEFLATE_DEFAULT_IDLE_STREAMS  16
+#define VOX_WS_DEFLATE_CHUNK                 16384
+
+/* ===== 协商 ===== */
+
+static void ws_deflate_config_load(vox_ws_deflate_config_t* c, const vox_ws_deflate_config_t* config) {
+    memset(c, 0, sizeof(*c));
+    if (config) *c = *config;
+    if (c->level <= 0 || c->level > 9) c->level = VOX_WS_DEFLATE_DEFAULT_LEVEL;
+    if (c->mem_level <= 0 || c->mem_level > 9) c->mem_level = VOX_WS_DEFLATE_DEFAULT_MEM_LEVEL;
+    if (c->server_max_window_bits <= 0 || c->server_max_window_bits > VOX_WS_DEFLATE_MAX_WINDOW_BITS) {
+        c->server_max_window_bits = VOX_WS_DEFLATE_MAX_WINDOW_BITS;
+    } else if (c->server_max_window_bits < VOX_WS_DEFLATE_MIN_WINDOW_BITS) {
+        c->server_max_window_bits = VOX_WS_DEFLATE_MIN_WINDOW_BITS;
+    }
+    if (c->client_max_window_bits <= 0 || c->client_max_window_bits > VOX_WS_DEFLATE_MAX_WINDOW_BITS) {
+        c->client_max_window_bits = VOX_WS_DEFLATE_MAX_WINDOW_BITS;
+    } else if (c->client_max_window_bits < VOX_WS_DEFLATE_MIN_WINDOW_BITS) {
+        c->client_max_window_bits = VOX_WS_DEFLATE_MIN_WINDOW_BITS;
+    }
+    if (c->min_size == 0) c->min_size = VOX_WS_DEFLATE_DEFAULT_MIN_SIZE;
+    if (c->max_message_size == 0) c->max_message_size = VOX_WS_DEFLATE_DEFAULT_MAX_MESSAGE;
+}
+
+/* 一个扩展元素中的 permessage-deflate 参数；窗口字段 0 表示未出现，-1 表示出现但没有值 */
+typedef struct {
+    bool server_no_context_takeover;
+    bool client_no_context_takeover;
+    int server_max_window_bits;
+    int client_max_window_bits;
+} ws_deflate_offer_t;
+
+static bool ws_is_tchar(char c) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return true;
+    return c != '\0' && strchr("!#$%&'*+-.^_`|~", c) != NULL;
+}
+
+static const char* ws_skip_ows(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    return p;
+}
+
+/* 读取一个 token，返回长度（0 表示没有 token） */
+static size_t ws_read_token(const char** p, const char* end) {
+    const char* s = *p;
+    while (*p < end && ws_is_tchar(**p)) (*p)++;
+    return (size_t)(*p - s);
+}
+
+static bool ws_token_is(const char* s, size_t len, const char* name) {
+    return len == strlen(name) && strncasecmp(s, name, len) == 0;
+}
+
+/* 窗口大小值：8-15 的十进制整数，不带前导零 */
+static int ws_parse_window_bits(const char* v, size_t len) {
+    if (len == 1 && v[0] >= '8' && v[0] <= '9') return v[0] - '0';
+    if (len == 2 && v[0] == '1' && v[1] >= '0' && v[1] <= '5') return 10 + (v[1] - '0');
+    return -1;
+}
+
+/*
+ * 解析一个扩展元素（到 ',' 或结尾为止），*pp 移到下一个元素
+ * @return 合法的 permessage-deflate 返回1，其它扩展返回0，语法错误或参数不合法返回-1
+ */
+static int ws_deflate_parse_element(const char** pp, const char* end, ws_deflate_offer_t* offer) {
+    memset(offer, 0, sizeof(*offer));
+    const char* p = ws_skip_ows(*pp, end);
+    const char* name = p;
+    size_t name_len = ws_read_token(&p, end);
+    int result = name_len == 0 ? -1 : (ws_token_is(name, name_len, VOX_WS_DEFLATE_EXTENSION) ? 1 : 0);
+
+    while (result >= 0) {
+        p = ws_skip_ows(p, end);
+        if (p >= end || *p == ',') break;
+        if (*p != ';') {
+            result = -1;
+            break;
+        }
+        p = ws_skip_ows(p + 1, end);
+        const char* pname = p;
+        size_t pname_len = ws_read_token(&p, end);
+        if (pname_len == 0) {
+            result = -1;
+            break;
+        }
+        p = ws_skip_ows(p, end);
+        const char* val = NULL;
+        size_t val_len = 0;
+        if (p < end && *p == '=') {
+            p = ws_skip_ows(p + 1, end);
+            if (p < end && *p == '"') {
+                val = ++p;
+                while (p < end && *p != '"') p++;
+                if (p >= end) {
+                    result = -1;
+                    break;
+                }
+                val_len = (size_t)(p - val);
+                p++;
+            } else {
+                val = p;
+                val_len = ws_read_token(&p, end);
+                if (val_len == 0) {
+                    result = -1;
+                    break;
+                }
+            }
+        }
+        if (result == 0) continue; /* 其它扩展的参数只检查语法 */
+
+        /* 重复参数、多余的值或未知参数都使整个提议无效 */
+        if (ws_token_is(pname, pname_len, "server_no_context_takeover")) {
+            if (val || offer->server_no_context_takeover) result = -1;
+            offer->server_no_context_takeover = true;
+        } else if (ws_token_is(pname, pname_len, "client_no_context_takeover")) {
+            if (val || offer->client_no_context_takeover) result = -1;
+            offer->client_no_context_takeover = true;
+        } else if (ws_token_is(pname, pname_len, "server_max_window_bits")) {
+            int bits = val ? ws_parse_window_bits(val, val_len) : -1;
+            if (bits < 0 || offer->server_max_window_bits != 0) result = -1;
+            offer->server_max_window_bits = bits;
+        } else if (ws_token_is(pname, pname_len, "client_max_window_bits")) {
+            int bits = val ? ws_parse_window_bits(val, val_len) : -1;
+            if ((val && bits < 0) || offer->client_max_window_bits != 0) result = -1;
+            offer->client_max_window_bits = bits;
+        } else {
+            result = -1;
+        }
+    }
+
+    /* 跳到下一个元素（引号内的逗号不算分隔符） */
+    while (p < end && *p != ',') {
+        if (*p == '"') {
+            p++;
+            while (p < end && *p != '"') p++;
+        }
+        if (p < end) p++;
+    }
+    if (p < end) p++;
+    *pp = p;
+    return result;
+}
+
+int vox_ws_deflate_negotiate(const vox_ws_deflate_config_t* config, const char* offers, size_t len,
+                             vox_ws_deflate_params_t* params) {
+    if (!offers || !params) return -1;
+    vox_ws_deflate_config_t cfg;
+    ws_deflate_config_load(&cfg, config);
+
+    const char* p = offers;
+    const char* end = offers + len;
+    while (p < end) {
+        ws_deflate_offer_t offer;
+        if (ws_deflate_parse_element(&p, end, &offer) != 1) continue;
+
+        /* 服务端压缩窗口：客户端要求的上限低于 zlib 支持的最小窗口时拒绝该提议 */
+        int server_bits = cfg.server_max_window_bits;
+        if (offer.server_max_window_bits > 0) {
+            if (offer.server_max_window_bits < VOX_WS_DEFLATE_MIN_WINDOW_BITS) continue;
+            if (offer.server_max_window_bits < server_bits) server_bits = offer.server_max_window_bits;
+        }
+        /* 客户端压缩窗口：只有提议中带 client_max_window_bits 时才能限制 */
+        int client_bits = VOX_WS_DEFLATE_MAX_WINDOW_BITS;
+        if (offer.client_max_window_bits != 0) {
+            client_bits = cfg.client_max_window_bits;
+            if (offer.client_max_window_bits > 0 && offer.client_max_window_bits < client_bits) {
+                client_bits = offer.client_max_window_bits;
+            }
+        }
+
+        params->server_no_context_takeover = offer.server_no_context_takeover || cfg.server_no_context_takeover;
+        params->client_no_context_takeover = offer.client_no_context_takeover || cfg.client_no_context_takeover;
+        params->server_max_window_bits = server_bits;
+        params->client_max_window_bits = client_bits;
+        return 0;
+    }
+    return -1;
+}
+
+/* 追加格式化文本，缓冲区不足返回-1 */
+static int ws_deflate_append(char* buf, size_t size, size_t* pos, const char* fmt, int value) {
+    int n = snprintf(buf + *pos, size - *pos, fmt, value);
+    if (n < 0 || (size_t)n >= size - *pos) return -1;
+    *pos += (size_t)n;
+    return 0;
+}
+
+int vox_ws_deflate_format_response(const vox_ws_deflate_params_t* params, char* buf, size_t size) {
+    if (!params || !buf || size == 0) return -1;
+    size_t pos = 0;
+    if (ws_deflate_append(buf, size, &pos, VOX_WS_DEFLATE_EXTENSION, 0) != 0) return -1;
+    if (params->server_no_context_takeover &&
+        ws_deflate_append(buf, size, &pos, "; server_no_context_takeover", 0) != 0) return -1;
+    if (params->client_no_context_takeover &&
+        ws_deflate_append(buf, size, &pos, "; client_no_context_takeover", 0) != 0) return -1;
+    if (params->server_max_window_bits < VOX_WS_DEFLATE_MAX_WINDOW_BITS &&
+        ws_deflate_append(buf, size, &pos, "; server_max_window_bits=%d", params->server_max_window_bits) != 0) return -1;
+    if (params->client_max_window_bits < VOX_WS_DEFLATE_MAX_WINDOW_BITS &&
+        ws_deflate_append(buf, size, &pos, "; client_max_window_bits=%d", params->client_max_window_bits) != 0) return -1;
+    return (int)pos;
+}
+
+int vox_ws_deflate_format_offer(const vox_ws_deflate_config_t* config, char* buf, size_t size) {
+    if (!buf || size == 0) return -1;
+    vox_ws_deflate_config_t cfg;
+    ws_deflate_config_load(&cfg, config);
+
+    size_t pos = 0;
+    if (ws_deflate_append(buf, size, &pos, VOX_WS_DEFLATE_EXTENSION, 0) != 0) return -1;
+    if (cfg.server_no_context_takeover &&
+        ws_deflate_append(buf, size, &pos, "; server_no_context_takeover", 0) != 0) return -1;
+    if (cfg.client_no_context_takeover &&
+        ws_deflate_append(buf, size, &pos, "; client_no_context_takeover", 0) != 0) return -1;
+    if (cfg.server_max_window_bits < VOX_WS_DEFLATE_MAX_WINDOW_BITS &&
+        ws_deflate_append(buf, size, &pos, "; server_max_window_bits=%d", cfg.server_max_window_bits) != 0) return -1;
+    /* 总是带上 client_max_window_bits，表示服务端可以限制本端的压缩窗口 */
+    if (cfg.client_max_window_bits < VOX_WS_DEFLATE_MAX_WINDOW_BITS) {
+        if (ws_deflate_append(buf, size, &pos, "; client_max_window_bits=%d", cfg.client_max_window_bits) != 0) return -1;
+    } else if (ws_deflate_append(buf, size, &pos, "; client_max_window_bits", 0) != 0) {
+        return -1;
+    }
+    return (int)pos;
+}
+
+int vox_ws_deflate_accept(const vox_ws_deflate_config_t* config, const char* value, size_t len,
+                          vox_ws_deflate_params_t* params) {
+    if (!value || !params) return -1;
+    vox_ws_deflate_config_t cfg;
+    ws_deflate_config_load(&cfg, config);
+
+    /* 只提议了一个扩展，响应中必须恰好是它 */
+    const char* p = value;
+    const char* end = value + len;
+    ws_deflate_offer_t resp;
+    if (ws_deflate_parse_element(&p, end, &resp) != 1) return -1;
+    if (ws_skip_ows(p, end) != end) return -1;
+
+    /* 服务端压缩窗口：不得超过本端要求的上限，缺省为 15 */
+    int server_bits = VOX_WS_DEFLATE_MAX_WINDOW_BITS;
+    if (resp.server_max_window_bits > 0) {
+        if (resp.server_max_window_bits > cfg.server_max_window_bits) return -1;
+        server_bits = resp.server_max_window_bits;
+    }
+    /* 客户端压缩窗口：服务端可以进一步缩小，但不能小于 zlib 支持的最小窗口 */
+    int client_bits = cfg.client_max_window_bits;
+    if (resp.client_max_window_bits < 0) return -1;
+    if (resp.client_max_window_bits > 0) {
+        if (resp.client_max_window_bits < VOX_WS_DEFLATE_MIN_WINDOW_BITS) return -1;
+        if (resp.client_max_window_bits < client_bits) client_bits = resp.client_max_window_bits;
+    }
+
+    params->server_no_context_takeover = resp.server_no_context_takeover;
+    params->client_no_context_takeover = resp.client_no_context_takeover || cfg.client_no_context_takeover;
+    params->server_max_window_bits = server_bits;
+    params->client_max_window_bits = client_bits;
+    return 0;
+}
+
+/* ===== z_stream 与 loop 级池 ===== */
+
+typedef struct {
+    vox_list_node_t node;
+    vox_mpool_t* mpool;     /* 本结构与 zlib 内部状态所在内存池 */
+    bool inflate;
+    int window_bits;
+    int level;              /* 解压流为 0 */
+    int mem_level;          /* 解压流为 0 */
+    z_stream zs;
+} ws_zstream_t;
+
+typedef struct {
+    vox_mpool_t* mpool;
+    vox_list_t idle;        /* 空闲 ws_zstream_t（已重置） */
+    vox_ws_deflate_pool_config_t config;
+    vox_ws_deflate_stats_t stats;
+} ws_deflate_pool_t;
+
+struct vox_ws_deflate {
+    vox_mpool_t* mpool;
+    ws_deflate_pool_t* pool;        /* loop 为 NULL 时没有池 */
+    vox_ws_deflate_config_t config;
+    int tx_window_bits;             /* 本端压缩窗口 */
+    int rx_window_bits;             /* 对端压缩窗口 */
+    bool tx_no_context_takeover;
+    bool rx_no_context_takeover;
+    ws_zstream_t* tx;               /* 常驻压缩流（保持上下文，或没有池时） */
+    ws_zstream_t* rx;               /* 常驻解压流 */
+};
+
+/* vox_loop 扩展数据 key */
+static const char ws_deflate_pool_key = 0;
+
+/* zlib 内部状态分配走内存池 */
+static voidpf ws_deflate_zalloc(voidpf opaque, uInt items, uInt size) {
+    return vox_mpool_alloc((vox_mpool_t*)opaque, (size_t)items * size);
+}
+
+static void ws_deflate_zfree(voidpf opaque, voidpf address) {
+    vox_mpool_free((vox_mpool_t*)opaque, address);
+}
+
+static ws_zstream_t* ws_zstream_create(vox_mpool_t* mpool, bool inflate, int window_bits,
+                                       int level, int mem_level) {
+    ws_zstream_t* s = (ws_zstream_t*)vox_mpool_alloc(mpool, sizeof(ws_zstream_t));
+    if (!s) return NULL;
+    memset(s, 0, sizeof(*s));
+    vox_list_node_init(&s->node);
+    s->mpool = mpool;
+    s->inflate = inflate;
+    s->window_bits = window_bits;
+    s->level = inflate ? 0 : level;
+    s->mem_level = inflate ? 0 : mem_level;
+    s->zs.zalloc = ws_deflate_zalloc;
+    s->zs.zfree = ws_deflate_zfree;
+    s->zs.opaque = mpool;
+    /* 负的 windowBits 表示原始 deflate 流（无 zlib 头尾） */
+    int ret = inflate ? inflateInit2(&s->zs, -window_bits)
+                      : deflateInit2(&s->zs, level, Z_DEFLATED, -window_bits, mem_level, Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK) {
+        VOX_LOG_ERROR("ws %s init failed: %d", inflate ? "inflate" : "deflate", ret);
+        vox_mpool_free(mpool, s);
+        return NULL;
+    }
+    return s;
+}
+
+static void ws_zstream_free(ws_zstream_t* s) {
+    if (s->inflate) {
+        inflateEnd(&s->zs);
+    } else {
+        deflateEnd(&s->zs);
+    }
+    vox_mpool_free(s->mpool, s);
+}
+
+static int ws_zstream_reset(ws_zstream_t* s) {
+    int ret = s->inflate ? inflateReset(&s->zs) : deflateReset(&s->zs);
+    return ret == Z_OK ? 0 : -1;
+}
+
+static void ws_deflate_pool_clear(ws_deflate_pool_t* pool) {
+    while (!vox_list_empty(&pool->idle)) {
+        ws_zstream_free(vox_container_of(vox_list_pop_front(&pool->idle), ws_zstream_t, node));
+    }
+}
+
+static void ws_deflate_pool_cleanup(vox_loop_t* loop, void* data) {
+    VOX_UNUSED(loop);
+    ws_deflate_pool_t* pool = (ws_deflate_pool_t*)data;
+    ws_deflate_pool_clear(pool);
+    vox_mpool_free(pool->mpool, pool);
+}
+
+static ws_deflate_pool_t* ws_deflate_pool_get(vox_loop_t* loop) {
+    if (!loop) return NULL;
+    ws_deflate_pool_t* pool = (ws_deflate_pool_t*)vox_loop_get_ext(loop, &ws_deflate_pool_key);
+    if (pool) return pool;
+
+    vox_mpool_t* mpool = vox_loop_get_mpool(loop);
+    pool = (ws_deflate_pool_t*)vox_mpool_alloc(mpool, sizeof(ws_deflate_pool_t));
+    if (!pool) return NULL;
+    memset(pool, 0, sizeof(*pool));
+    pool->mpool = mpool;
+    pool->config.max_idle_streams = VOX_WS_DEFLATE_DEFAULT_IDLE_STREAMS;
+    vox_list_init(&pool->idle);
+    if (vox_loop_set_ext(loop, &ws_deflate_pool_key, pool, ws_deflate_pool_cleanup) != 0) {
+        vox_mpool_free(mpool, pool);
+        return NULL;
+    }
+    return pool;
+}
+
+int vox_ws_deflate_configure_pool(vox_loop_t* loop, const vox_ws_deflate_pool_config_t* config) {
+    ws_deflate_pool_t* pool = ws_deflate_pool_get(loop);
+    if (!pool) return -1;
+    ws_deflate_pool_clear(pool);
+    memset(&pool->config, 0, sizeof(pool->config));
+    if (config) pool->config = *config;
+    if (pool->config.max_idle_streams == 0) pool->config.max_idle_streams = VOX_WS_DEFLATE_DEFAULT_IDLE_STREAMS;
+    return 0;
+}
+
+int vox_ws_deflate_get_stats(vox_loop_t* loop, vox_ws_deflate_stats_t* stats) {
+    if (!stats) return -1;
+    ws_deflate_pool_t* pool = ws_deflate_pool_get(loop);
+    if (!pool) return -1;
+    *stats = pool->stats;
+    stats->idle_streams = vox_list_size(&pool->idle);
+    return 0;
+}
+
+/* 取得一个方向的 z_stream：保持上下文（或没有池）时用常驻流，否则从池中借用 */
+static ws_zstream_t* ws_deflate_stream_get(vox_ws_deflate_t* d, bool inflate) {
+    ws_zstream_t** slot = inflate ? &d->rx : &d->tx;
+    if (*slot) return *slot;
+
+    int bits = inflate ? d->rx_window_bits : d->tx_window_bits;
+    int level = inflate ? 0 : d->config.level;
+    int mem_level = inflate ? 0 : d->config.mem_level;
+    bool no_takeover = inflate ? d->rx_no_context_takeover : d->tx_no_context_takeover;
+    ws_deflate_pool_t* pool = d->pool;
+
+    if (no_takeover && pool) {
+        vox_list_node_t* pos;
+        vox_list_for_each(pos, &pool->idle) {
+            ws_zstream_t* s = vox_container_of(pos, ws_zstream_t, node);
+            if (s->inflate == inflate && s->window_bits == bits &&
+                s->level == level && s->mem_level == mem_level) {
+                vox_list_remove(&pool->idle, pos);
+                pool->stats.streams_reused++;
+                return s;
+            }
+        }
+        ws_zstream_t* s = ws_zstream_create(pool->mpool, inflate, bits, level, mem_level);
+        if (s) pool->stats.streams_created++;
+        return s;
+    }
+
+    *slot = ws_zstream_create(d->mpool, inflate, bits, level, mem_level);
+    if (*slot && pool) pool->stats.streams_created++;
+    return *slot;
+}
+
+/* 一条消息处理完：不保持上下文时重置，借用的流放回池 */
+static void ws_deflate_stream_put(vox_ws_deflate_t* d, ws_zstream_t* s, bool inflate, bool failed) {
+    ws_zstream_t** slot = inflate ? &d->rx : &d->tx;
+    bool no_takeover = inflate ? d->rx_no_context_takeover : d->tx_no_context_takeover;
+
+    if (s == *slot) {
+        if (failed || (no_takeover && ws_zstream_reset(s) != 0)) {
+            ws_zstream_free(s);
+            *slot = NULL;
+        }
+        return;
+    }
+
+    ws_deflate_pool_t* pool = d->pool;
+    if (failed || ws_zstream_reset(s) != 0 || vox_list_size(&pool->idle) >= pool->config.max_idle_streams) {
+        ws_zstream_free(s);
+        return;
+    }
+    vox_list_push_front(&pool->idle, &s->node);
+}
+
+vox_ws_deflate_t* vox_ws_deflate_create(vox_loop_t* loop, vox_mpool_t* mpool, const vox_ws_deflate_config_t* config,
+                                        const vox_ws_deflate_params_t* params, bool is_server) {
+    if (!mpool || !params) return NULL;
+
+    int tx_bits = is_server ? params->server_max_window_bits : params->client_max_window_bits;
+    int rx_bits = is_server ? params->client_max_window_bits : params->server_max_window_bits;
+    if (tx_bits < VOX_WS_DEFLATE_MIN_WINDOW_BITS || tx_bits > VOX_WS_DEFLATE_MAX_WINDOW_BITS ||
+        rx_bits < 8 || rx_bits > VOX_WS_DEFLATE_MAX_WINDOW_BITS) {
+        return NULL;
+    }
+
+    vox_ws_deflate_t* d = (vox_ws_deflate_t*)vox_mpool_alloc(mpool, sizeof(vox_ws_deflate_t));
+    if (!d) return NULL;
+    memset(d, 0, sizeof(*d));
+    d->mpool = mpool;
+    d->pool = ws_deflate_pool_get(loop);
+    ws_deflate_config_load(&d->config, config);
+    d->tx_window_bits = tx_bits;
+    d->rx_window_bits = rx_bits;
+    d->tx_no_context_takeover = is_server ? params->server_no_context_takeover : params->client_no_context_takeover;
+    d->rx_no_context_takeover = is_server ? params->client_no_context_takeover : params->server_no_context_takeover;
+    return d;
+}
+
+void vox_ws_deflate_destroy(vox_ws_deflate_t* d) {
+    if (!d) return;
+    if (d->tx) ws_zstream_free(d->tx);
+    if (d->rx) ws_zstream_free(d->rx);
+    vox_mpool_free(d->mpool, d);
+}
+
+/* 压缩全部输入并以 Z_SYNC_FLUSH 结束 */
+static int ws_zstream_deflate(ws_zstream_t* s, const uint8_t* p, size_t len, vox_string_t* out) {
+    uint8_t buf[VOX_WS_DEFLATE_CHUNK];
+    do {
+        /* avail_in 为 uInt，按 1GB 分片喂入 */
+        size_t n = len > (1u << 30) ? (1u << 30) : len;
+        int flush = n == len ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+        s->zs.next_in = (Bytef*)p;
+        s->zs.avail_in = (uInt)n;
+        do {
+            s->zs.next_out = buf;
+            s->zs.avail_out = (uInt)sizeof(buf);
+            int ret = deflate(&s->zs, flush);
+            if (ret == Z_STREAM_ERROR) {
+                VOX_LOG_ERROR("ws deflate failed: %d", ret);
+                return -1;
+            }
+            size_t have = sizeof(buf) - s->zs.avail_out;
+            if (have > 0 && vox_string_append_data(out, buf, have) != 0) return -1;
+        } while (s->zs.avail_out == 0);
+        p += n;
+        len -= n;
+    } while (len > 0);
+    return 0;
+}
+
+/* 解压一段输入；遇到 BFINAL 块（流结束）返回1 */
+static int ws_zstream_inflate(ws_zstream_t* s, const uint8_t* p, size_t len, size_t limit, vox_string_t* out) {
+    uint8_t buf[VOX_WS_DEFLATE_CHUNK];
+    while (len > 0) {
+        size_t n = len > (1u << 30) ? (1u << 30) : len;
+        s->zs.next_in = (Bytef*)p;
+        s->zs.avail_in = (uInt)n;
+        for (;;) {
+            s->zs.next_out = buf;
+            s->zs.avail_out = (uInt)sizeof(buf);
+            int ret = inflate(&s->zs, Z_SYNC_FLUSH);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) return -1;
+            size_t have = sizeof(buf) - s->zs.avail_out;
+            if (have > 0) {
+                if (vox_string_length(out) + have > limit) return -2;
+                if (vox_string_append_data(out, buf, have) != 0) return -1;
+            }
+            if (ret == Z_STREAM_END) return 1;
+            if (s->zs.avail_out != 0) break; /* 输入已用完 */
+        }
+        p += n;
+        len -= n;
+    }
+    return 0;
+}
+
+int vox_ws_deflate_compress(vox_ws_deflate_t* d, const void* data, size_t len, vox_string_t* out) {
+    if (!d || !out || (len > 0 && !data)) return -1;
+    vox_string_clear(out);
+    if (len < d->config.min_size) return 0;
+
+    ws_zstream_t* s = ws_deflate_stream_get(d, false);
+    if (!s) return -1;
+    int ret = ws_zstream_deflate(s, (const uint8_t*)data, len, out);
+    ws_deflate_stream_put(d, s, false, ret != 0);
+    if (ret != 0) return -1;
+
+    /* Z_SYNC_FLUSH 以空的存储块 00 00 FF FF 结尾，发送时去掉（RFC 7692 7.2.1） */
+    size_t n = vox_string_length(out);
+    const uint8_t* z = (const uint8_t*)vox_string_data(out);
+    if (n < 4 || z[n - 4] != 0x00 || z[n - 3] != 0x00 || z[n - 2] != 0xFF || z[n - 1] != 0xFF) return -1;
+    n -= 4;
+
+    /* 不保持上下文时，没有变小的消息可以原样发送（保持上下文时对端窗口必须与本端一致） */
+    if (d->tx_no_context_takeover && n >= len) {
+        vox_string_clear(out);
+        return 0;
+    }
+    vox_string_remove(out, n, 4);
+    return 1;
+}
+
+int vox_ws_deflate_decompress(vox_ws_deflate_t* d, const void* data, size_t len, vox_string_t* out) {
+    if (!d || !out || (len > 0 && !data)) return -1;
+    static const uint8_t tail[4] = {0x00, 0x00, 0xFF, 0xFF};
+    vox_string_clear(out);
+
+    ws_zstream_t* s = ws_deflate_stream_get(d, true);
+    if (!s) return -1;
+    int ret = ws_zstream_inflate(s, (const uint8_t*)data, len, d->config.max_message_size, out);
+    if (ret == 0) {
+        ret = ws_zstream_inflate(s, tail, sizeof(tail), d->config.max_message_size, out);
+    }
+    if (ret == 1) {
+        /* 消息以 BFINAL 块结束：后续消息从新的流开始 */
+        ret = ws_zstream_reset(s);
+    }
+    ws_deflate_stream_put(d, s, true, ret != 0);
+    return ret;
+}
+
+#else /* !VOX_USE_ZLIB */
+
+int vox_ws_deflate_negotiate(const vox_ws_deflate_config_t* config, const char* offers, size_t len,
+                             vox_ws_deflate_params_t* params) {
+    VOX_UNUSED(config);
+    VOX_UNUSED(offers);
+    VOX_UNUSED(len);
+    VOX_UNUSED(params);
+    return -1;
+}
+
+int vox_ws_deflate_format_response(const vox_ws_deflate_params_t* params, char* buf, size_t size) {
+    VOX_UNUSED(params);
+    VOX_UNUSED(buf);
+    VOX_UNUSED(size);
+    return -1;
+}
+
+int vox_ws_deflate_format_offer(const vox_ws_deflate_config_t* config, char* buf, size_t size) {
+    VOX_UNUSED(config);
+    VOX_UNUSED(buf);
+    VOX_UNUSED(size);
+    return -1;
+}
+
+int vox_ws_deflate_accept(const vox_ws_deflate_config_t* config, const char* value, size_t len,
+                          vox_ws_deflate_params_t* params) {
+    VOX_UNUSED(config);
+    VOX_UNUSED(value);
+    VOX_UNUSED(len);
+    VOX_UNUSED(params);
+    return -1;
+}
+
+vox_ws_deflate_t* vox_ws_deflate_create(vox_loop_t* loop, vox_mpool_t* mpool, const vox_ws_deflate_config_t* config,
+                                        const vox_ws_deflate_params_t* params, bool is_server) {
+    VOX_UNUSED(loop);
+    VOX_UNUSED(mpool);
+    VOX_UNUSED(config);
+    VOX_UNUSED(params);
+    VOX_UNUSED(is_server);
+    return NULL;
+}
+
+void vox_ws_deflate_destroy(vox_ws_deflate_t* d) {
+    VOX_UNUSED(d);
+}
+
+int vox_ws_deflate_compress(vox_ws_deflate_t* d, const void* data, size_t len, vox_string_t* out) {
+    VOX_UNUSED(d);
+    VOX_UNUSED(data);
+    VOX_UNUSED(len);
+    VOX_UNUSED(out);
+    return -1;
+}
+
+int vox_ws_deflate_decompress(vox_ws_deflate_t* d, const void* data, size_t len, vox_string_t* out) {
+    VOX_UNUSED(d);
+    VOX_UNUSED(data);
+    VOX_UNUSED(len);
+    VOX_UNUSED(out);
+    return -1;
+}
+
+int vox_ws_deflate_configure_pool(vox_loop_t* loop, const vox_ws_deflate_pool_config_t* config) {
+    VOX_UNUSED(loop);
+    VOX_UNUSED(config);
+    return -1;
+}
+
+int vox_ws_deflate_get_stats(vox_loop_t* loop, vox_ws_deflate_stats_t* stats) {
+    VOX_UNUSED(loop);
+    VOX_UNUSED(stats);
+    return -1;
+}
+
+#endif /* VOX_USE_ZLIB */
@@ -0,0 +1,145 @@
+/*
+ * vox_websocket_deflate.h - WebSocket permessage-deflate 扩展（RFC 7692）
+ * - 协商 Sec-WebSocket-Extensions（上下文接管与窗口大小参数）
+ * - 按消息压缩/解压（去掉/补回 00 00 FF FF 尾部）
+ * - 不保持上下文的方向从 loop 级 z_stream 池借用压缩上下文，只在单条消息期间占用
+ *
+ * 每个方向的 zlib 内存约为：
+ *   压缩 (1 << (window_bits + 2)) + (1 << (mem_level + 9))，15/8 时约 256KB，10/5 时约 20KB
+ *   解压 (1 << window_bits) + 约 7KB
+ * 未编译 zlib（VOX_USE_ZLIB）时协商总是失败，连接按未压缩方式工作
+ */
+
+#ifndef VOX_WEBSOCKET_DEFLATE_H
+#define VOX_WEBSOCKET_DEFLATE_H
+
+#include "../vox_os.h"
+#include "../vox_mpool.h"
+#include "../vox_string.h"
+#include "../vox_loop.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 扩展名 */
+#define VOX_WS_DEFLATE_EXTENSION "permessage-deflate"
+
+/* 配置（数值字段 0 表示使用默认值） */
+typedef struct {
+    int level;                        /* 压缩级别 1-9，默认 6 */
+    int mem_level;                    /* zlib memLevel 1-9，默认 8 */
+    int server_max_window_bits;       /* 服务端压缩窗口上限 9-15，默认 15 */
+    int client_max_window_bits;       /* 客户端压缩窗口上限 9-15，默认 15 */
+    bool server_no_context_takeover;  /* 服务端每条消息重置压缩上下文 */
+    bool client_no_context_takeover;  /* 客户端每条消息重置压缩上下文 */
+    size_t min_size;                  /* 小于此长度的消息不压缩，默认 32 */
+    size_t max_message_size;          /* 解压后消息大小上限，默认 16MB */
+} vox_ws_deflate_config_t;
+
+/* 协商结果（双方共同遵守的参数） */
+typedef struct {
+    bool server_no_context_takeover;
+    bool client_no_context_takeover;
+    int server_max_window_bits;       /* 服务端发送消息使用的窗口（8-15） */
+    int client_max_window_bits;       /* 客户端发送消息使用的窗口（8-15） */
+} vox_ws_deflate_params_t;
+
+/* loop 级压缩上下文池配置（数值字段 0 表示使用默认值） */
+typedef struct {
+    uint32_t max_idle_streams;        /* 每个 loop 保留的空闲 z_stream 数，默认 16 */
+} vox_ws_deflate_pool_config_t;
+
+/* loop 级压缩上下文池统计 */
+typedef struct {
+    uint64_t streams_created;         /* deflateInit2/inflateInit2 次数（含连接常驻流） */
+    uint64_t streams_reused;          /* 从池中复用次数 */
+    size_t idle_streams;              /* 当前空闲流数量 */
+} vox_ws_deflate_stats_t;
+
+typedef struct vox_ws_deflate vox_ws_deflate_t;
+
+/**
+ * 服务端：从客户端的 Sec-WebSocket-Extensions 中选择第一个可接受的 permessage-deflate 提议
+ * @param config 服务端配置（NULL 表示默认配置）
+ * @param offers 请求头值（可含多个以逗号分隔的扩展）
+ * @param len 请求头值长度
+ * @param params 输出：协商结果
+ * @return 接受返回0，没有可接受的提议返回-1
+ */
+int vox_ws_deflate_negotiate(const vox_ws_deflate_config_t* config, const char* offers, size_t len,
+                             vox_ws_deflate_params_t* params);
+
+/**
+ * 服务端：生成响应的 Sec-WebSocket-Extensions 值
+ * @return 成功返回写入长度（不含 '\0'），缓冲区不足返回-1
+ */
+int vox_ws_deflate_format_response(const vox_ws_deflate_params_t* params, char* buf, size_t size);
+
+/**
+ * 客户端：生成请求的 Sec-WebSocket-Extensions 值
+ * @return 成功返回写入长度（不含 '\0'），缓冲区不足返回-1
+ */
+int vox_ws_deflate_format_offer(const vox_ws_deflate_config_t* config, char* buf, size_t size);
+
+/**
+ * 客户端：校验服务端响应的 Sec-WebSocket-Extensions 值
+ * @param config 客户端配置（与生成提议时相同）
+ * @param value 响应头值
+ * @param len 响应头值长度
+ * @param params 输出：协商结果
+ * @return 合法返回0，不合法（客户端必须断开连接）返回-1
+ */
+int vox_ws_deflate_accept(const vox_ws_deflate_config_t* config, const char* value, size_t len,
+                          vox_ws_deflate_params_t* params);
+
+/**
+ * 创建连接的压缩状态（z_stream 在首次收发压缩消息时才创建）
+ * @param loop 事件循环（用于共享上下文池，可以为 NULL）
+ * @param mpool 连接内存池（保持上下文的 z_stream 从这里分配）
+ * @param config 本端配置（NULL 表示默认配置）
+ * @param params 协商结果
+ * @param is_server 本端是否为服务端
+ * @return 成功返回压缩状态，失败（或未编译 zlib）返回 NULL
+ */
+vox_ws_deflate_t* vox_ws_deflate_create(vox_loop_t* loop, vox_mpool_t* mpool, const vox_ws_deflate_config_t* config,
+                                        const vox_ws_deflate_params_t* params, bool is_server);
+
+/**
+ * 销毁压缩状态
+ */
+void vox_ws_deflate_destroy(vox_ws_deflate_t* d);
+
+/**
+ * 压缩一条待发送的消息
+ * @param out 输出：压缩后的负载（会先清空；发送时需设置 RSV1）
+ * @return 已压缩返回1，消息应按未压缩方式发送返回0，失败返回-1
+ */
+int vox_ws_deflate_compress(vox_ws_deflate_t* d, const void* data, size_t len, vox_string_t* out);
+
+/**
+ * 解压一条收到的压缩消息（RSV1 置位的消息，分片时为拼接后的全部负载）
+ * @param out 输出：解压后的消息（会先清空）
+ * @return 成功返回0，数据无效返回-1，超过 max_message_size 返回-2
+ */
+int vox_ws_deflate_decompress(vox_ws_deflate_t* d, const void* data, size_t len, vox_string_t* out);
+
+/**
+ * 配置 loop 的压缩上下文池（会释放已有空闲流）
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ws_deflate_configure_pool(vox_loop_t* loop, const vox_ws_deflate_pool_config_t* config);
+
+/**
+ * 获取 loop 的压缩上下文池统计
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ws_deflate_get_stats(vox_loop_t* loop, vox_ws_deflate_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_WEBSOCKET_DEFLATE_H */
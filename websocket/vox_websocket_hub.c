@@ -0,0 +1,302 @@
+/*
+ * vox_websocket_hub.c - WebSocket 频道订阅与广播实现
+ */
+
+#include "vox_websocket_hub.h"
+#include "vox_websocket_internal.h"
+#include "../vox_htable.h"
+#include "../vox_vector.h"
+#include "../vox_log.h"
+#include <string.h>
+#include <stdint.h>
+
+#define VOX_WS_HUB_DEFAULT_MAX_PENDING (1024 * 1024)
+
+/* 频道 */
+typedef struct {
+    vox_list_t subs;                /* ws_hub_sub_t（channel_node） */
+    size_t name_len;
+    char name[1];                   /* 频道名（变长） */
+} ws_hub_channel_t;
+
+/* 连接在某个 hub 中的成员记录 */
+typedef struct {
+    vox_list_node_t conn_node;      /* 连接的 hub_members 链表 */
+    vox_list_node_t hub_node;       /* hub->members */
+    vox_ws_hub_t* hub;
+    vox_ws_connection_t* conn;
+    vox_list_t subs;                /* ws_hub_sub_t（member_node） */
+    vox_ws_hub_slow_policy_t slow_policy;
+    size_t max_pending_bytes;       /* 0 表示使用 hub 配置 */
+    bool aborting;                  /* 已列入本次发布后的断开列表 */
+} ws_hub_member_t;
+
+/* 一个订阅：同时挂在频道与成员上 */
+typedef struct {
+    vox_list_node_t channel_node;
+    vox_list_node_t member_node;
+    ws_hub_channel_t* channel;
+    ws_hub_member_t* member;
+} ws_hub_sub_t;
+
+struct vox_ws_hub {
+    vox_loop_t* loop;
+    vox_mpool_t* mpool;             /* 频道、成员与订阅（独立创建） */
+    vox_mpool_t* frame_mpool;       /* 共享帧：loop 内存池，帧可能在 hub 销毁后才写完 */
+    vox_htable_t* channels;         /* 频道名 -> ws_hub_channel_t */
+    vox_list_t members;             /* ws_hub_member_t（hub_node） */
+    vox_vector_t* aborts;           /* 发布期间超限待断开的成员 */
+    vox_ws_hub_config_t config;
+    vox_ws_hub_stats_t stats;
+};
+
+vox_ws_hub_t* vox_ws_hub_create(vox_loop_t* loop, const vox_ws_hub_config_t* config) {
+    if (!loop) return NULL;
+
+    vox_mpool_t* mpool = vox_mpool_create();
+    if (!mpool) return NULL;
+
+    vox_ws_hub_t* hub = (vox_ws_hub_t*)vox_mpool_alloc(mpool, sizeof(vox_ws_hub_t));
+    if (!hub) {
+        vox_mpool_destroy(mpool);
+        return NULL;
+    }
+    memset(hub, 0, sizeof(*hub));
+    hub->loop = loop;
+    hub->mpool = mpool;
+    hub->frame_mpool = vox_loop_get_mpool(loop);
+    vox_list_init(&hub->members);
+    if (config) hub->config = *config;
+    if (hub->config.max_pending_bytes == 0) hub->config.max_pending_bytes = VOX_WS_HUB_DEFAULT_MAX_PENDING;
+
+    hub->channels = vox_htable_create(mpool);
+    hub->aborts = vox_vector_create(mpool);
+    if (!hub->channels || !hub->aborts) {
+        vox_mpool_destroy(mpool);
+        return NULL;
+    }
+    return hub;
+}
+
+void vox_ws_hub_destroy(vox_ws_hub_t* hub) {
+    if (!hub) return;
+    /* 只需把成员记录从连接上摘下，其余随内存池释放 */
+    vox_list_node_t* pos;
+    vox_list_for_each(pos, &hub->members) {
+        ws_hub_member_t* m = vox_container_of(pos, ws_hub_member_t, hub_node);
+        vox_list_remove(vox_ws_connection_internal_hub_members(m->conn), &m->conn_node);
+    }
+    vox_mpool_destroy(hub->mpool);
+}
+
+/* 查找连接在此 hub 的成员记录 */
+static ws_hub_member_t* ws_hub_find_member(vox_ws_hub_t* hub, vox_ws_connection_t* conn) {
+    vox_list_node_t* pos;
+    vox_list_for_each(pos, vox_ws_connection_internal_hub_members(conn)) {
+        ws_hub_member_t* m = vox_container_of(pos, ws_hub_member_t, conn_node);
+        if (m->hub == hub) return m;
+    }
+    return NULL;
+}
+
+static ws_hub_member_t* ws_hub_get_member(vox_ws_hub_t* hub, vox_ws_connection_t* conn) {
+    ws_hub_member_t* m = ws_hub_find_member(hub, conn);
+    if (m) return m;
+
+    m = (ws_hub_member_t*)vox_mpool_alloc(hub->mpool, sizeof(ws_hub_member_t));
+    if (!m) return NULL;
+    memset(m, 0, sizeof(*m));
+    m->hub = hub;
+    m->conn = conn;
+    m->slow_policy = hub->config.slow_policy;
+    vox_list_init(&m->subs);
+    vox_list_push_back(vox_ws_connection_internal_hub_members(conn), &m->conn_node);
+    vox_list_push_back(&hub->members, &m->hub_node);
+    return m;
+}
+
+/* 删除订阅；频道没有订阅者时一并删除 */
+static void ws_hub_remove_sub(vox_ws_hub_t* hub, ws_hub_sub_t* sub) {
+    ws_hub_channel_t* ch = sub->channel;
+    vox_list_remove(&ch->subs, &sub->channel_node);
+    vox_list_remove(&sub->member->subs, &sub->member_node);
+    vox_mpool_free(hub->mpool, sub);
+    hub->stats.subscriptions--;
+
+    if (vox_list_empty(&ch->subs)) {
+        vox_htable_delete(hub->channels, ch->name, ch->name_len);
+        vox_mpool_free(hub->mpool, ch);
+    }
+}
+
+static void ws_hub_remove_member(vox_ws_hub_t* hub, ws_hub_member_t* m) {
+    while (!vox_list_empty(&m->subs)) {
+        ws_hub_remove_sub(hub, vox_container_of(vox_list_first(&m->subs), ws_hub_sub_t, member_node));
+    }
+    vox_list_remove(vox_ws_connection_internal_hub_members(m->conn), &m->conn_node);
+    vox_list_remove(&hub->members, &m->hub_node);
+    vox_mpool_free(hub->mpool, m);
+}
+
+int vox_ws_hub_subscribe(vox_ws_hub_t* hub, vox_ws_connection_t* conn, const char* channel) {
+    if (!hub || !conn || !channel) return -1;
+    if (!vox_ws_connection_internal_is_open(conn)) return -1;
+
+    size_t name_len = strlen(channel);
+    ws_hub_channel_t* ch = (ws_hub_channel_t*)vox_htable_get(hub->channels, channel, name_len);
+    ws_hub_member_t* m = ws_hub_get_member(hub, conn);
+    if (!m) return -1;
+
+    if (ch) {
+        vox_list_node_t* pos;
+        vox_list_for_each(pos, &m->subs) {
+            if (vox_container_of(pos, ws_hub_sub_t, member_node)->channel == ch) return 0;
+        }
+    } else {
+        ch = (ws_hub_channel_t*)vox_mpool_alloc(hub->mpool, sizeof(ws_hub_channel_t) + name_len);
+        if (!ch) return -1;
+        vox_list_init(&ch->subs);
+        ch->name_len = name_len;
+        memcpy(ch->name, channel, name_len + 1);
+        if (vox_htable_set(hub->channels, ch->name, name_len, ch) != 0) {
+            vox_mpool_free(hub->mpool, ch);
+            return -1;
+        }
+    }
+
+    ws_hub_sub_t* sub = (ws_hub_sub_t*)vox_mpool_alloc(hub->mpool, sizeof(ws_hub_sub_t));
+    if (!sub) {
+        if (vox_list_empty(&ch->subs)) {
+            vox_htable_delete(hub->channels, ch->name, name_len);
+            vox_mpool_free(hub->mpool, ch);
+        }
+        return -1;
+    }
+    sub->channel = ch;
+    sub->member = m;
+    vox_list_push_back(&ch->subs, &sub->channel_node);
+    vox_list_push_back(&m->subs, &sub->member_node);
+    hub->stats.subscriptions++;
+    return 0;
+}
+
+int vox_ws_hub_unsubscribe(vox_ws_hub_t* hub, vox_ws_connection_t* conn, const char* channel) {
+    if (!hub || !conn || !channel) return -1;
+    ws_hub_member_t* m = ws_hub_find_member(hub, conn);
+    if (!m) return -1;
+
+    size_t name_len = strlen(channel);
+    vox_list_node_t* pos;
+    vox_list_for_each(pos, &m->subs) {
+        ws_hub_sub_t* sub = vox_container_of(pos, ws_hub_sub_t, member_node);
+        if (sub->channel->name_len == name_len && memcmp(sub->channel->name, channel, name_len) == 0) {
+            ws_hub_remove_sub(hub, sub);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void vox_ws_hub_unsubscribe_all(vox_ws_hub_t* hub, vox_ws_connection_t* conn) {
+    if (!hub || !conn) return;
+    ws_hub_member_t* m = ws_hub_find_member(hub, conn);
+    if (!m) return;
+    while (!vox_list_empty(&m->subs)) {
+        ws_hub_remove_sub(hub, vox_container_of(vox_list_first(&m->subs), ws_hub_sub_t, member_node));
+    }
+}
+
+int vox_ws_hub_set_backpressure(vox_ws_hub_t* hub, vox_ws_connection_t* conn,
+                                vox_ws_hub_slow_policy_t policy, size_t max_pending_bytes) {
+    if (!hub || !conn) return -1;
+    if (!vox_ws_connection_internal_is_open(conn)) return -1;
+    ws_hub_member_t* m = ws_hub_get_member(hub, conn);
+    if (!m) return -1;
+    m->slow_policy = policy;
+    m->max_pending_bytes = max_pending_bytes;
+    return 0;
+}
+
+int vox_ws_hub_publish_frame(vox_ws_hub_t* hub, const char* channel, const vox_bytes_t* frame) {
+    if (!hub || !channel || !frame || frame->len == 0) return -1;
+    ws_hub_channel_t* ch = (ws_hub_channel_t*)vox_htable_get(hub->channels, channel, strlen(channel));
+    if (!ch) return 0;
+    hub->stats.messages_published++;
+
+    int sent = 0;
+    vox_list_node_t* pos;
+    vox_list_for_each(pos, &ch->subs) {
+        ws_hub_member_t* m = vox_container_of(pos, ws_hub_sub_t, channel_node)->member;
+        vox_ws_connection_t* conn = m->conn;
+        if (m->aborting || !vox_ws_connection_internal_is_open(conn)) continue;
+
+        size_t limit = m->max_pending_bytes ? m->max_pending_bytes : hub->config.max_pending_bytes;
+        size_t pending = vox_ws_connection_get_write_queue_size(conn);
+        if (pending > limit || frame->len > limit - pending) {
+            if (m->slow_policy == VOX_WS_HUB_SLOW_DISCONNECT) {
+                /* 断开会修改订阅链表，遍历结束后再处理 */
+                if (vox_vector_push(hub->aborts, m) == 0) m->aborting = true;
+            } else {
+                hub->stats.frames_dropped++;
+            }
+            continue;
+        }
+        if (vox_ws_connection_send_frame(conn, frame) == 0) {
+            hub->stats.frames_sent++;
+            sent++;
+        }
+    }
+
+    size_t n = vox_vector_size(hub->aborts);
+    for (size_t i = 0; i < n; i++) {
+        ws_hub_member_t* m = (ws_hub_member_t*)vox_vector_get(hub->aborts, i);
+        hub->stats.slow_disconnects++;
+        VOX_LOG_ERROR("ws hub: slow consumer disconnected (%zu bytes pending)",
+                      vox_ws_connection_get_write_queue_size(m->conn));
+        /* 关闭传输层时经 vox_ws_hub_internal_conn_closed 释放成员记录 */
+        vox_ws_connection_internal_abort(m->conn, "Slow consumer");
+    }
+    vox_vector_clear(hub->aborts);
+    return sent;
+}
+
+static int ws_hub_publish(vox_ws_hub_t* hub, const char* channel, uint8_t opcode, const void* data, size_t len) {
+    if (!hub || !channel || (len > 0 && !data)) return -1;
+    if (!vox_htable_get(hub->channels, channel, strlen(channel))) return 0;
+
+    vox_bytes_t frame = VOX_BYTES_NULL;
+    if (vox_ws_build_frame_bytes(hub->frame_mpool, opcode, data, len, &frame) != 0) return -1;
+    int ret = vox_ws_hub_publish_frame(hub, channel, &frame);
+    vox_bytes_release(&frame);
+    return ret;
+}
+
+int vox_ws_hub_publish_text(vox_ws_hub_t* hub, const char* channel, const char* text, size_t len) {
+    return ws_hub_publish(hub, channel, VOX_WS_OP_TEXT, text, len);
+}
+
+int vox_ws_hub_publish_binary(vox_ws_hub_t* hub, const char* channel, const void* data, size_t len) {
+    return ws_hub_publish(hub, channel, VOX_WS_OP_BINARY, data, len);
+}
+
+size_t vox_ws_hub_subscriber_count(vox_ws_hub_t* hub, const char* channel) {
+    if (!hub || !channel) return 0;
+    ws_hub_channel_t* ch = (ws_hub_channel_t*)vox_htable_get(hub->channels, channel, strlen(channel));
+    return ch ? vox_list_size(&ch->subs) : 0;
+}
+
+void vox_ws_hub_get_stats(vox_ws_hub_t* hub, vox_ws_hub_stats_t* stats) {
+    if (!hub || !stats) return;
+    *stats = hub->stats;
+    stats->channels = vox_htable_size(hub->channels);
+}
+
+/* ===== 内部接口 ===== */
+
+void vox_ws_hub_internal_conn_closed(vox_ws_connection_t* conn) {
+    vox_list_t* members = vox_ws_connection_internal_hub_members(conn);
+    while (!vox_list_empty(members)) {
+        ws_hub_member_t* m = vox_container_of(vox_list_first(members), ws_hub_member_t, conn_node);
+        ws_hub_remove_member(m->hub, m);
+    }
+}
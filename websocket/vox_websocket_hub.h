@@ -0,0 +1,115 @@
+/*
+ * vox_websocket_hub.h - WebSocket 频道订阅与广播
+ * - 连接按频道名订阅/退订，连接关闭时自动退出所有频道
+ * - 发布时帧只编码一次（vox_bytes_t 引用计数缓冲区），所有订阅者的写队列共享同一份数据
+ * - 慢消费者：连接未写完的字节数超过上限时，按策略丢弃本条消息或断开连接
+ * 只用于 vox_ws_server 的连接；hub 须在服务器销毁之前销毁，所有调用须在 loop 线程
+ */
+
+#ifndef VOX_WEBSOCKET_HUB_H
+#define VOX_WEBSOCKET_HUB_H
+
+#include "vox_websocket_server.h"
+#include "../vox_bytes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct vox_ws_hub vox_ws_hub_t;
+
+/* 慢消费者处理策略 */
+typedef enum {
+    VOX_WS_HUB_SLOW_DROP = 0,         /* 跳过本条消息 */
+    VOX_WS_HUB_SLOW_DISCONNECT        /* 断开连接（on_error 回调 "Slow consumer"） */
+} vox_ws_hub_slow_policy_t;
+
+/* hub 配置 */
+typedef struct {
+    size_t max_pending_bytes;         /* 连接未写完字节数上限，0 表示默认 1MB，SIZE_MAX 表示不限制 */
+    vox_ws_hub_slow_policy_t slow_policy; /* 超过上限时的处理 */
+} vox_ws_hub_config_t;
+
+/* hub 统计 */
+typedef struct {
+    size_t channels;                  /* 当前频道数 */
+    size_t subscriptions;             /* 当前订阅数 */
+    uint64_t messages_published;      /* 发布次数（有订阅者时） */
+    uint64_t frames_sent;             /* 排入连接写队列的帧数 */
+    uint64_t frames_dropped;          /* 因背压丢弃的帧数 */
+    uint64_t slow_disconnects;        /* 因背压断开的连接数 */
+} vox_ws_hub_stats_t;
+
+/**
+ * 创建 hub
+ * @param loop 事件循环（共享帧从其内存池分配，可在 hub 销毁后继续发送）
+ * @param config 配置（NULL 表示默认配置）
+ * @return 成功返回 hub 指针，失败返回 NULL
+ */
+vox_ws_hub_t* vox_ws_hub_create(vox_loop_t* loop, const vox_ws_hub_config_t* config);
+
+/**
+ * 销毁 hub（已排入写队列的帧照常发送）
+ */
+void vox_ws_hub_destroy(vox_ws_hub_t* hub);
+
+/**
+ * 订阅频道（已订阅时直接返回成功）
+ * @param conn 已完成握手的连接
+ * @param channel 频道名（以 '\0' 结尾）
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ws_hub_subscribe(vox_ws_hub_t* hub, vox_ws_connection_t* conn, const char* channel);
+
+/**
+ * 退订频道
+ * @return 成功返回0，未订阅返回-1
+ */
+int vox_ws_hub_unsubscribe(vox_ws_hub_t* hub, vox_ws_connection_t* conn, const char* channel);
+
+/**
+ * 退订连接在此 hub 的所有频道
+ */
+void vox_ws_hub_unsubscribe_all(vox_ws_hub_t* hub, vox_ws_connection_t* conn);
+
+/**
+ * 设置单个连接的背压策略（覆盖 hub 配置，连接尚未订阅时也可设置）
+ * @param max_pending_bytes 未写完字节数上限，0 表示使用 hub 配置
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ws_hub_set_backpressure(vox_ws_hub_t* hub, vox_ws_connection_t* conn,
+                                vox_ws_hub_slow_policy_t policy, size_t max_pending_bytes);
+
+/**
+ * 向频道发布文本消息（帧只编码一次）
+ * @return 成功返回排入写队列的连接数，失败返回-1
+ */
+int vox_ws_hub_publish_text(vox_ws_hub_t* hub, const char* channel, const char* text, size_t len);
+
+/**
+ * 向频道发布二进制消息（帧只编码一次）
+ * @return 成功返回排入写队列的连接数，失败返回-1
+ */
+int vox_ws_hub_publish_binary(vox_ws_hub_t* hub, const char* channel, const void* data, size_t len);
+
+/**
+ * 向频道发布预先编码的帧（vox_ws_build_frame_bytes），同一帧可发布到多个频道
+ * @return 成功返回排入写队列的连接数，失败返回-1
+ */
+int vox_ws_hub_publish_frame(vox_ws_hub_t* hub, const char* channel, const vox_bytes_t* frame);
+
+/**
+ * 频道当前订阅者数量
+ */
+size_t vox_ws_hub_subscriber_count(vox_ws_hub_t* hub, const char* channel);
+
+/**
+ * 获取统计
+ */
+void vox_ws_hub_get_stats(vox_ws_hub_t* hub, vox_ws_hub_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_WEBSOCKET_HUB_H */
@@ -0,0 +1,32 @@
+/*
+ * vox_websocket_internal.h - WebSocket 模块内部共享定义（非公开 API）
+ * 注意：仅供 websocket/ 目录下模块互相引用，避免对外暴露实现细节。
+ */
+
+#ifndef VOX_WEBSOCKET_INTERNAL_H
+#define VOX_WEBSOCKET_INTERNAL_H
+
+#include "../vox_list.h"
+#include "vox_websocket_server.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 连接上的 hub 成员记录链表（由 vox_websocket_hub.c 维护） */
+vox_list_t* vox_ws_connection_internal_hub_members(vox_ws_connection_t* conn);
+
+/* 连接是否处于 OPEN 状态 */
+bool vox_ws_connection_internal_is_open(const vox_ws_connection_t* conn);
+
+/* 立即关闭传输层（慢消费者等），先以 reason 调用 on_error */
+void vox_ws_connection_internal_abort(vox_ws_connection_t* conn, const char* reason);
+
+/* 连接传输层关闭时由服务器调用：退出所有 hub */
+void vox_ws_hub_internal_conn_closed(vox_ws_connection_t* conn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VOX_WEBSOCKET_INTERNAL_H */
@@ -3,6 +3,7 @@
  */
 
 #include "vox_websocket_server.h"
+#include "vox_websocket_internal.h"
 #include "../vox_crypto.h"
 #include "../vox_log.h"
 #include <string.h>
@@ -17,18 +18,31 @@ typedef enum {
 
 /* WebSocket 连接结构 */
 struct vox_ws_connection {
+    vox_list_node_t node;           /* 服务器的连接链表 */
     vox_ws_server_t* server;        /* 所属服务器 */
     vox_tcp_t* tcp;                 /* TCP 连接（WS） */
     vox_tls_t* tls;                 /* TLS 连接（WSS） */
     vox_mpool_t* mpool;             /* 内存池 */
     vox_ws_parser_t* parser;        /* 帧解析器 */
+    vox_ws_deflate_t* deflate;      /* permessage-deflate 状态（未协商时为 NULL） */
     vox_ws_conn_state_t state;      /* 连接状态 */
     vox_string_t* handshake_buffer; /* 握手缓冲区 */
     bool handshake_complete;        /* 握手是否完成 */
     bool close_sent;                /* 是否已发送关闭帧 */
     void* user_data;                /* 用户数据 */
+    vox_list_t write_queue;         /* 已提交未完成的写入（ws_write_req_t，按提交顺序完成） */
+    size_t write_queue_size;        /* 未完成写入的字节数 */
+    vox_list_t hub_members;         /* 所属 hub 的成员记录（vox_websocket_hub.c） */
 };
 
+/* 一次写入：帧归连接所有（frame）或共享（bytes），完成时释放 */
+typedef struct {
+    vox_list_node_t node;
+    void* frame;                    /* 连接内存池中的帧，NULL 表示使用 bytes */
+    vox_bytes_t bytes;              /* 共享帧 */
+    size_t len;
+} ws_write_req_t;
+
 /* WebSocket 服务器结构 */
 struct vox_ws_server {
     vox_loop_t* loop;               /* 事件循环 */
@@ -37,6 +51,7 @@ struct vox_ws_server {
     vox_tls_t* tls_listener;        /* TLS 监听器（WSS） */
     vox_ssl_context_t* ssl_ctx;     /* SSL 上下文 */
     vox_ws_server_config_t config;  /* 配置 */
+    vox_list_t conns;               /* 传输层未关闭的连接 */
     bool is_ssl;                    /* 是否使用 SSL */
     bool owns_mpool;                /* 是否拥有内存池 */
 };
@@ -73,16 +88,24 @@ vox_ws_server_t* vox_ws_server_create(const vox_ws_server_config_t* config) {
     server->ssl_ctx = config->ssl_ctx;
     server->config = *config;
     server->owns_mpool = true;
+    vox_list_init(&server->conns);
     
     return server;
 }
 
+static void ws_conn_close_transport(vox_ws_connection_t* conn);
+
 /* 销毁服务器 */
 void vox_ws_server_destroy(vox_ws_server_t* server) {
     if (!server) return;
     
     vox_ws_server_close(server);
     
+    /* 关闭仍打开的连接（连接结构随内存池释放） */
+    while (!vox_list_empty(&server->conns)) {
+        ws_conn_close_transport(vox_container_of(vox_list_first(&server->conns), vox_ws_connection_t, node));
+    }
+    
     /* 销毁内存池 */
     if (server->owns_mpool && server->mpool) {
         vox_mpool_destroy(server->mpool);
@@ -155,10 +178,92 @@ void vox_ws_server_close(vox_ws_server_t* server) {
 }
 
 /* TCP 连接回调 */
+/* 释放一个写入请求 */
+static void ws_write_req_free(vox_ws_connection_t* conn, ws_write_req_t* req) {
+    conn->write_queue_size -= req->len;
+    if (req->frame) {
+        vox_mpool_free(conn->mpool, req->frame);
+    } else {
+        vox_bytes_release(&req->bytes);
+    }
+    vox_mpool_free(conn->mpool, req);
+}
+
+/* 释放传输层未回调的写入（传输层已销毁） */
+static void ws_conn_drain_writes(vox_ws_connection_t* conn) {
+    while (!vox_list_empty(&conn->write_queue)) {
+        ws_write_req_free(conn, vox_container_of(vox_list_pop_front(&conn->write_queue), ws_write_req_t, node));
+    }
+}
+
+/* 写入完成（传输层按提交顺序回调，销毁时对未完成的写入以失败回调） */
+static void ws_on_write_done(vox_ws_connection_t* conn) {
+    if (!conn || vox_list_empty(&conn->write_queue)) return;
+    ws_write_req_free(conn, vox_container_of(vox_list_pop_front(&conn->write_queue), ws_write_req_t, node));
+}
+
+static void ws_on_tcp_write(vox_tcp_t* tcp, int status, void* user_data) {
+    VOX_UNUSED(tcp);
+    VOX_UNUSED(status);
+    ws_on_write_done((vox_ws_connection_t*)user_data);
+}
+
+static void ws_on_tls_write(vox_tls_t* tls, int status, void* user_data) {
+    VOX_UNUSED(tls);
+    VOX_UNUSED(status);
+    ws_on_write_done((vox_ws_connection_t*)user_data);
+}
+
+/* 提交写入：请求先入队，传输层可能在返回前同步回调 */
+static int ws_conn_submit(vox_ws_connection_t* conn, ws_write_req_t* req) {
+    const void* data = req->frame ? req->frame : (const void*)req->bytes.ptr;
+    vox_list_push_back(&conn->write_queue, &req->node);
+    conn->write_queue_size += req->len;
+    
+    int ret;
+    if (conn->tcp) {
+        ret = vox_tcp_write(conn->tcp, data, req->len, ws_on_tcp_write);
+    } else if (conn->tls) {
+        ret = vox_tls_write(conn->tls, data, req->len, ws_on_tls_write);
+    } else {
+        ret = -1;
+    }
+    if (ret != 0) {
+        /* 失败时不会回调，请求仍在队尾 */
+        vox_list_remove(&conn->write_queue, &req->node);
+        ws_write_req_free(conn, req);
+        return -1;
+    }
+    return 0;
+}
+
+/* 发送连接内存池中的帧（完成后释放） */
+static int ws_conn_write(vox_ws_connection_t* conn, void* frame, size_t len) {
+    ws_write_req_t* req = (ws_write_req_t*)vox_mpool_alloc(conn->mpool, sizeof(ws_write_req_t));
+    if (!req) {
+        vox_mpool_free(conn->mpool, frame);
+        return -1;
+    }
+    memset(req, 0, sizeof(*req));
+    req->frame = frame;
+    req->len = len;
+    return ws_conn_submit(conn, req);
+}
+
+/* 从服务器连接链表移除 */
+static void ws_conn_unlink(vox_ws_connection_t* conn) {
+    if (conn->node.next != &conn->node) {
+        vox_list_remove(&conn->server->conns, &conn->node);
+        vox_list_node_init(&conn->node);
+    }
+}
+
 /* 释放连接资源（parser、handshake_buffer、conn），不关闭 tcp/tls */
 static void ws_conn_free_resources(vox_ws_connection_t* conn) {
     if (!conn) return;
     vox_mpool_t* mpool = conn->mpool;
+    ws_conn_unlink(conn);
+    ws_conn_drain_writes(conn);
     if (conn->parser) {
         vox_ws_parser_destroy(conn->parser);
         vox_mpool_free(mpool, conn->parser);
@@ -166,9 +271,27 @@ static void ws_conn_free_resources(vox_ws_connection_t* conn) {
     if (conn->handshake_buffer) {
         vox_string_destroy(conn->handshake_buffer);
     }
+    vox_ws_deflate_destroy(conn->deflate);
     vox_mpool_free(mpool, conn);
 }
 
+/* 关闭传输层并释放压缩状态（连接结构随服务器内存池释放） */
+static void ws_conn_close_transport(vox_ws_connection_t* conn) {
+    if (conn->tcp) {
+        vox_tcp_destroy(conn->tcp);
+    } else if (conn->tls) {
+        vox_tls_destroy(conn->tls);
+    }
+    conn->tcp = NULL;
+    conn->tls = NULL;
+    conn->state = VOX_WS_CONN_CLOSED;
+    ws_conn_unlink(conn);
+    vox_ws_deflate_destroy(conn->deflate);
+    conn->deflate = NULL;
+    ws_conn_drain_writes(conn);
+    vox_ws_hub_internal_conn_closed(conn);
+}
+
 static void ws_on_tcp_connection(vox_tcp_t* server, int status, void* user_data) {
     (void)user_data;
     
@@ -186,6 +309,9 @@ static void ws_on_tcp_connection(vox_tcp_t* server, int status, void* user_data)
     conn->server = ws_server;
     conn->mpool = ws_server->mpool;
     conn->state = VOX_WS_CONN_HANDSHAKING;
+    vox_list_node_init(&conn->node);
+    vox_list_init(&conn->write_queue);
+    vox_list_init(&conn->hub_members);
     conn->parser = vox_ws_parser_create(conn->mpool);
     conn->handshake_buffer = vox_string_create(conn->mpool);
     
@@ -208,6 +334,7 @@ static void ws_on_tcp_connection(vox_tcp_t* server, int status, void* user_data)
     }
     
     conn->tcp->handle.data = conn;
+    vox_list_push_back(&ws_server->conns, &conn->node);
     vox_tcp_nodelay(conn->tcp, true);
     vox_tcp_read_start(conn->tcp, NULL, ws_on_tcp_read);
 }
@@ -230,6 +357,9 @@ static void ws_on_tls_connection(vox_tls_t* server, int status, void* user_data)
     conn->server = ws_server;
     conn->mpool = ws_server->mpool;
     conn->state = VOX_WS_CONN_HANDSHAKING;
+    vox_list_node_init(&conn->node);
+    vox_list_init(&conn->write_queue);
+    vox_list_init(&conn->hub_members);
     conn->parser = vox_ws_parser_create(conn->mpool);
     conn->handshake_buffer = vox_string_create(conn->mpool);
     
@@ -252,6 +382,7 @@ static void ws_on_tls_connection(vox_tls_t* server, int status, void* user_data)
     }
     
     conn->tls->handle.data = conn;
+    vox_list_push_back(&ws_server->conns, &conn->node);
     vox_tls_nodelay(conn->tls, true);
     
     /* 开始 TLS 握手 */
@@ -395,6 +526,24 @@ static int ws_handle_handshake(vox_ws_connection_t* conn, const char* data, size
     
     /* 注意：key 和 version 来自内存池，不需要 free */
     
+    /* 协商 permessage-deflate：没有可接受的提议时按未压缩方式继续 */
+    char extensions[128];
+    extensions[0] = '\0';
+    if (conn->server->config.enable_compression) {
+        const char* offers = ws_get_header(conn->mpool, buf, buf_len, "Sec-WebSocket-Extensions");
+        vox_ws_deflate_config_t dcfg = conn->server->config.compression;
+        size_t max_size = conn->server->config.max_message_size;
+        if (max_size > 0 && (dcfg.max_message_size == 0 || dcfg.max_message_size > max_size)) {
+            dcfg.max_message_size = max_size;
+        }
+        vox_ws_deflate_params_t params;
+        if (offers && vox_ws_deflate_negotiate(&dcfg, offers, strlen(offers), &params) == 0 &&
+            vox_ws_deflate_format_response(&params, extensions, sizeof(extensions)) > 0) {
+            conn->deflate = vox_ws_deflate_create(conn->server->loop, conn->mpool, &dcfg, &params, true);
+            if (!conn->deflate) extensions[0] = '\0';
+        }
+    }
+    
     /* 构建响应 */
     vox_string_t* response = vox_string_create(conn->mpool);
     if (!response) return -1;
@@ -404,6 +553,10 @@ static int ws_handle_handshake(vox_ws_connection_t* conn, const char* data, size
     vox_string_append(response, "Connection: Upgrade\r\n");
     vox_string_append(response, "Sec-WebSocket-Accept: ");
     vox_string_append(response, accept);
+    if (extensions[0] != '\0') {
+        vox_string_append(response, "\r\nSec-WebSocket-Extensions: ");
+        vox_string_append(response, extensions);
+    }
     vox_string_append(response, "\r\n\r\n");
     
     /* 发送响应 */
@@ -437,6 +590,13 @@ static int ws_handle_handshake(vox_ws_connection_t* conn, const char* data, size
 static int ws_handle_frame(vox_ws_connection_t* conn, const vox_ws_frame_t* frame, int frame_len) {
     if (!conn || !frame) return -1;
     
+    /* RSV1 只允许出现在已协商压缩的数据帧上 */
+    bool is_data = frame->opcode == VOX_WS_OP_TEXT || frame->opcode == VOX_WS_OP_BINARY;
+    if (frame->rsv1 && (!conn->deflate || !is_data)) {
+        vox_ws_connection_close(conn, VOX_WS_CLOSE_PROTOCOL_ERROR, "Unexpected RSV1");
+        return -1;
+    }
+    
     /* 复制并解掩码负载 */
     uint8_t* payload = NULL;
     if (frame->payload_len > 0) {
@@ -449,22 +609,41 @@ static int ws_handle_frame(vox_ws_connection_t* conn, const vox_ws_frame_t* fram
         }
     }
     
+    /* 解压压缩消息 */
+    const uint8_t* data = payload;
+    size_t data_len = frame->payload_len;
+    vox_string_t* inflated = NULL;
+    if (frame->rsv1) {
+        inflated = vox_string_create(conn->mpool);
+        int ret = inflated ? vox_ws_deflate_decompress(conn->deflate, payload, data_len, inflated) : -1;
+        if (ret != 0) {
+            if (inflated) vox_string_destroy(inflated);
+            if (payload) vox_mpool_free(conn->mpool, payload);
+            vox_ws_connection_close(conn, ret == -2 ? VOX_WS_CLOSE_MESSAGE_TOO_BIG : VOX_WS_CLOSE_INVALID_DATA,
+                                    "Invalid compressed message");
+            return -1;
+        }
+        data = (const uint8_t*)vox_string_data(inflated);
+        data_len = vox_string_length(inflated);
+    }
+    
     /* 处理不同类型的帧 */
     if (frame->opcode == VOX_WS_OP_TEXT) {
         /* 文本消息 */
-        if (!vox_ws_validate_utf8(payload, frame->payload_len)) {
+        if (!vox_ws_validate_utf8(data, data_len)) {
+            if (inflated) vox_string_destroy(inflated);
             vox_ws_connection_close(conn, VOX_WS_CLOSE_INVALID_DATA, "Invalid UTF-8");
             return -1;
         }
         
         if (conn->server->config.on_message) {
-            conn->server->config.on_message(conn, payload, frame->payload_len,
+            conn->server->config.on_message(conn, data, data_len,
                                            VOX_WS_MSG_TEXT, conn->server->config.user_data);
         }
     } else if (frame->opcode == VOX_WS_OP_BINARY) {
         /* 二进制消息 */
         if (conn->server->config.on_message) {
-            conn->server->config.on_message(conn, payload, frame->payload_len,
+            conn->server->config.on_message(conn, data, data_len,
                                            VOX_WS_MSG_BINARY, conn->server->config.user_data);
         }
     } else if (frame->opcode == VOX_WS_OP_CLOSE) {
@@ -524,15 +703,13 @@ static int ws_handle_frame(vox_ws_connection_t* conn, const vox_ws_frame_t* fram
         size_t pong_len;
         if (vox_ws_build_frame(conn->mpool, VOX_WS_OP_PONG, payload,
                               frame->payload_len, false, &pong_frame, &pong_len) == 0) {
-            if (conn->tcp) {
-                vox_tcp_write(conn->tcp, pong_frame, pong_len, NULL);
-            } else {
-                vox_tls_write(conn->tls, pong_frame, pong_len, NULL);
-            }
+            ws_conn_write(conn, pong_frame, pong_len);
         }
     }
     /* PONG 和 CONTINUATION 帧忽略或由解析器处理 */
     
+    if (inflated) vox_string_destroy(inflated);
+    if (payload) vox_mpool_free(conn->mpool, payload);
     return frame_len;
 }
 
@@ -543,29 +720,27 @@ static void ws_on_tcp_read(vox_tcp_t* tcp, ssize_t nread, const void* buf, void*
     vox_ws_connection_t* conn = (vox_ws_connection_t*)tcp->handle.data;
     if (!conn) return;
     
-    if (nread < 0) {
-        /* 连接错误或关闭 */
+    if (nread <= 0) {
+        /* 连接错误或对端关闭（nread 为 0） */
         if (conn->server->config.on_error) {
             conn->server->config.on_error(conn, "Connection closed", conn->server->config.user_data);
         }
-        vox_tcp_destroy(conn->tcp);
+        ws_conn_close_transport(conn);
         return;
     }
     
-    if (nread == 0) return;
-    
     /* 处理握手 */
     if (!conn->handshake_complete) {
         int ret = ws_handle_handshake(conn, (const char*)buf, (size_t)nread);
         if (ret < 0) {
-            vox_tcp_destroy(conn->tcp);
+            ws_conn_close_transport(conn);
         }
         return;
     }
     
     /* 解析帧 */
     if (vox_ws_parser_feed(conn->parser, buf, (size_t)nread) != 0) {
-        vox_tcp_destroy(conn->tcp);
+        ws_conn_close_transport(conn);
         return;
     }
     
@@ -574,7 +749,7 @@ static void ws_on_tcp_read(vox_tcp_t* tcp, ssize_t nread, const void* buf, void*
     int frame_len;
     while ((frame_len = vox_ws_parser_parse_frame(conn->parser, &frame)) > 0) {
         if (ws_handle_frame(conn, &frame, frame_len) < 0) {
-            vox_tcp_destroy(conn->tcp);
+            ws_conn_close_transport(conn);
             return;
         }
         
@@ -584,7 +759,7 @@ static void ws_on_tcp_read(vox_tcp_t* tcp, ssize_t nread, const void* buf, void*
     
     if (frame_len < 0) {
         /* 解析错误 */
-        vox_tcp_destroy(conn->tcp);
+        ws_conn_close_transport(conn);
     }
 }
 
@@ -595,29 +770,27 @@ static void ws_on_tls_read(vox_tls_t* tls, ssize_t nread, const void* buf, void*
     vox_ws_connection_t* conn = (vox_ws_connection_t*)tls->handle.data;
     if (!conn) return;
     
-    if (nread < 0) {
-        /* 连接错误或关闭 */
+    if (nread <= 0) {
+        /* 连接错误或对端关闭（nread 为 0） */
         if (conn->server->config.on_error) {
             conn->server->config.on_error(conn, "Connection closed", conn->server->config.user_data);
         }
-        vox_tls_destroy(conn->tls);
+        ws_conn_close_transport(conn);
         return;
     }
     
-    if (nread == 0) return;
-    
     /* 处理握手 */
     if (!conn->handshake_complete) {
         int ret = ws_handle_handshake(conn, (const char*)buf, (size_t)nread);
         if (ret < 0) {
-            vox_tls_destroy(conn->tls);
+            ws_conn_close_transport(conn);
         }
         return;
     }
     
     /* 解析帧 */
     if (vox_ws_parser_feed(conn->parser, buf, (size_t)nread) != 0) {
-        vox_tls_destroy(conn->tls);
+        ws_conn_close_transport(conn);
         return;
     }
     
@@ -626,7 +799,7 @@ static void ws_on_tls_read(vox_tls_t* tls, ssize_t nread, const void* buf, void*
     int frame_len;
     while ((frame_len = vox_ws_parser_parse_frame(conn->parser, &frame)) > 0) {
         if (ws_handle_frame(conn, &frame, frame_len) < 0) {
-            vox_tls_destroy(conn->tls);
+            ws_conn_close_transport(conn);
             return;
         }
         
@@ -636,44 +809,50 @@ static void ws_on_tls_read(vox_tls_t* tls, ssize_t nread, const void* buf, void*
     
     if (frame_len < 0) {
         /* 解析错误 */
-        vox_tls_destroy(conn->tls);
+        ws_conn_close_transport(conn);
     }
 }
 
-/* 发送文本消息 */
-int vox_ws_connection_send_text(vox_ws_connection_t* conn, const char* text, size_t len) {
-    if (!conn || !text || len == 0) return -1;
-    if (conn->state != VOX_WS_CONN_OPEN) return -1;
+/* 发送数据消息：已协商压缩时先压缩并设置 RSV1 */
+static int ws_conn_send_message(vox_ws_connection_t* conn, uint8_t opcode, const void* data, size_t len) {
+    bool compressed = false;
+    vox_string_t* deflated = NULL;
+    if (conn->deflate) {
+        deflated = vox_string_create(conn->mpool);
+        if (!deflated) return -1;
+        int ret = vox_ws_deflate_compress(conn->deflate, data, len, deflated);
+        if (ret < 0) {
+            vox_string_destroy(deflated);
+            return -1;
+        }
+        if (ret > 0) {
+            compressed = true;
+            data = vox_string_data(deflated);
+            len = vox_string_length(deflated);
+        }
+    }
     
     void* frame;
     size_t frame_len;
-    if (vox_ws_build_frame(conn->mpool, VOX_WS_OP_TEXT, text, len, false, &frame, &frame_len) != 0) {
-        return -1;
-    }
+    int ret = vox_ws_build_frame_ex(conn->mpool, opcode, compressed, data, len, false, &frame, &frame_len);
+    if (deflated) vox_string_destroy(deflated);
+    if (ret != 0) return -1;
     
-    if (conn->tcp) {
-        return vox_tcp_write(conn->tcp, frame, frame_len, NULL);
-    } else {
-        return vox_tls_write(conn->tls, frame, frame_len, NULL);
-    }
+    return ws_conn_write(conn, frame, frame_len);
+}
+
+/* 发送文本消息 */
+int vox_ws_connection_send_text(vox_ws_connection_t* conn, const char* text, size_t len) {
+    if (!conn || !text || len == 0) return -1;
+    if (conn->state != VOX_WS_CONN_OPEN) return -1;
+    return ws_conn_send_message(conn, VOX_WS_OP_TEXT, text, len);
 }
 
 /* 发送二进制消息 */
 int vox_ws_connection_send_binary(vox_ws_connection_t* conn, const void* data, size_t len) {
     if (!conn || !data || len == 0) return -1;
     if (conn->state != VOX_WS_CONN_OPEN) return -1;
-    
-    void* frame;
-    size_t frame_len;
-    if (vox_ws_build_frame(conn->mpool, VOX_WS_OP_BINARY, data, len, false, &frame, &frame_len) != 0) {
-        return -1;
-    }
-    
-    if (conn->tcp) {
-        return vox_tcp_write(conn->tcp, frame, frame_len, NULL);
-    } else {
-        return vox_tls_write(conn->tls, frame, frame_len, NULL);
-    }
+    return ws_conn_send_message(conn, VOX_WS_OP_BINARY, data, len);
 }
 
 /* 发送 Ping */
@@ -687,11 +866,25 @@ int vox_ws_connection_send_ping(vox_ws_connection_t* conn, const void* data, siz
         return -1;
     }
     
-    if (conn->tcp) {
-        return vox_tcp_write(conn->tcp, frame, frame_len, NULL);
-    } else {
-        return vox_tls_write(conn->tls, frame, frame_len, NULL);
-    }
+    return ws_conn_write(conn, frame, frame_len);
+}
+
+/* 发送预先编码的帧（共享缓冲区） */
+int vox_ws_connection_send_frame(vox_ws_connection_t* conn, const vox_bytes_t* frame) {
+    if (!conn || !frame || frame->len == 0) return -1;
+    if (conn->state != VOX_WS_CONN_OPEN) return -1;
+    
+    ws_write_req_t* req = (ws_write_req_t*)vox_mpool_alloc(conn->mpool, sizeof(ws_write_req_t));
+    if (!req) return -1;
+    memset(req, 0, sizeof(*req));
+    req->bytes = vox_bytes_retain(frame);
+    req->len = frame->len;
+    return ws_conn_submit(conn, req);
+}
+
+/* 未完成写入的字节数 */
+size_t vox_ws_connection_get_write_queue_size(vox_ws_connection_t* conn) {
+    return conn ? conn->write_queue_size : 0;
 }
 
 /* 关闭连接 */
@@ -708,11 +901,7 @@ int vox_ws_connection_close(vox_ws_connection_t* conn, uint16_t code, const char
         return -1;
     }
     
-    if (conn->tcp) {
-        return vox_tcp_write(conn->tcp, frame, frame_len, NULL);
-    } else {
-        return vox_tls_write(conn->tls, frame, frame_len, NULL);
-    }
+    return ws_conn_write(conn, frame, frame_len);
 }
 
 /* 获取用户数据 */
@@ -739,3 +928,21 @@ int vox_ws_connection_getpeername(vox_ws_connection_t* conn, vox_socket_addr_t*
     
     return -1;
 }
+
+/* ===== 内部接口（vox_websocket_internal.h） ===== */
+
+vox_list_t* vox_ws_connection_internal_hub_members(vox_ws_connection_t* conn) {
+    return &conn->hub_members;
+}
+
+bool vox_ws_connection_internal_is_open(const vox_ws_connection_t* conn) {
+    return conn->state == VOX_WS_CONN_OPEN;
+}
+
+void vox_ws_connection_internal_abort(vox_ws_connection_t* conn, const char* reason) {
+    if (conn->state == VOX_WS_CONN_CLOSED) return;
+    if (conn->server->config.on_error) {
+        conn->server->config.on_error(conn, reason, conn->server->config.user_data);
+    }
+    ws_conn_close_transport(conn);
+}
@@ -7,6 +7,7 @@
 #define VOX_WEBSOCKET_SERVER_H
 
 #include "vox_websocket.h"
+#include "vox_websocket_deflate.h"
 #include "../vox_loop.h"
 #include "../vox_tcp.h"
 #include "../vox_tls.h"
@@ -39,7 +40,8 @@ typedef struct {
     vox_ws_on_error_cb on_error;         /* 错误回调 */
     void* user_data;                     /* 用户数据 */
     size_t max_message_size;             /* 最大消息大小（0表示无限制） */
-    bool enable_compression;             /* 是否启用压缩（未实现） */
+    bool enable_compression;             /* 是否协商 permessage-deflate（RFC 7692，需要 zlib） */
+    vox_ws_deflate_config_t compression; /* 压缩参数（全 0 使用默认值） */
     const char* path;                    /* 可选：仅接受此 HTTP 路径的升级（如 "/mqtt"），NULL 表示接受任意路径 */
 } vox_ws_server_config_t;
 
@@ -51,7 +53,7 @@ typedef struct {
 vox_ws_server_t* vox_ws_server_create(const vox_ws_server_config_t* config);
 
 /**
- * 销毁 WebSocket 服务器
+ * 销毁 WebSocket 服务器（仍打开的连接直接关闭传输层，不回调 on_close）
  * @param server 服务器指针
  */
 void vox_ws_server_destroy(vox_ws_server_t* server);
@@ -109,6 +111,22 @@ int vox_ws_connection_send_binary(vox_ws_connection_t* conn, const void* data, s
  */
 int vox_ws_connection_send_ping(vox_ws_connection_t* conn, const void* data, size_t len);
 
+/**
+ * 发送预先编码的完整帧（如 vox_ws_build_frame_bytes 的结果），不复制数据
+ * 连接持有一个引用直到写入完成，同一帧可同时排入多个连接；不经过 permessage-deflate
+ * @param conn 连接指针
+ * @param frame 完整的服务端帧
+ * @return 成功返回0，失败返回-1
+ */
+int vox_ws_connection_send_frame(vox_ws_connection_t* conn, const vox_bytes_t* frame);
+
+/**
+ * 获取连接已提交但尚未写完的字节数（用于发送端背压）
+ * @param conn 连接指针
+ * @return 未完成写入的字节数
+ */
+size_t vox_ws_connection_get_write_queue_size(vox_ws_connection_t* conn);
+
 /**
  * 关闭连接
  * @param conn 连接指针